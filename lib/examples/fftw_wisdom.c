@@ -0,0 +1,193 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Generates the FFTW wisdom of the transforms used by the eNB and the UE, so that they do not have to plan them at
+ * startup. The wisdom is stored in the default wisdom file unless an output file is given.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+#define MAX_NOF_PRB_LIST 16
+
+char*    output_file_name = NULL;
+uint32_t nof_prb_list[MAX_NOF_PRB_LIST] = {6, 15, 25, 50, 75, 100};
+uint32_t nof_prb_list_len               = 6;
+
+// PRACH configuration indexes of the formats 0 to 3
+static const uint32_t prach_config_idx[] = {0, 16, 32, 48};
+
+void usage(char* prog)
+{
+  printf("Usage: %s [pov]\n", prog);
+  printf("\t-p comma separated list of number of PRB [Default 6,15,25,50,75,100]\n");
+  printf("\t-o output wisdom file [Default $SRSRAN_FFTW_WISDOM or ~/.srsran_fftwisdom]\n");
+  printf("\t-v srsran_verbose\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int   opt;
+  char* token;
+  while ((opt = getopt(argc, argv, "pov")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb_list_len = 0;
+        token            = strtok(argv[optind], ",");
+        while (token != NULL && nof_prb_list_len < MAX_NOF_PRB_LIST) {
+          nof_prb_list[nof_prb_list_len++] = (uint32_t)strtol(token, NULL, 10);
+          token                            = strtok(NULL, ",");
+        }
+        break;
+      case 'o':
+        output_file_name = argv[optind];
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static int plan_ofdm(uint32_t nof_prb, srsran_cp_t cp, cf_t* td_buffer, cf_t* fd_buffer)
+{
+  srsran_ofdm_t tx = {};
+  srsran_ofdm_t rx = {};
+
+  if (srsran_ofdm_tx_init(&tx, cp, fd_buffer, td_buffer, nof_prb)) {
+    ERROR("Error initiating OFDM Tx for %d PRB", nof_prb);
+    return SRSRAN_ERROR;
+  }
+  if (srsran_ofdm_rx_init(&rx, cp, td_buffer, fd_buffer, nof_prb)) {
+    ERROR("Error initiating OFDM Rx for %d PRB", nof_prb);
+    srsran_ofdm_tx_free(&tx);
+    return SRSRAN_ERROR;
+  }
+
+  srsran_ofdm_tx_free(&tx);
+  srsran_ofdm_rx_free(&rx);
+  return SRSRAN_SUCCESS;
+}
+
+static int plan_prach(uint32_t nof_prb)
+{
+  srsran_prach_t prach = {};
+  if (srsran_prach_init(&prach, srsran_symbol_sz(nof_prb))) {
+    ERROR("Error initiating PRACH for %d PRB", nof_prb);
+    return SRSRAN_ERROR;
+  }
+
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < sizeof(prach_config_idx) / sizeof(prach_config_idx[0]) && ret == SRSRAN_SUCCESS; i++) {
+    srsran_prach_cfg_t cfg = {};
+    cfg.config_idx         = prach_config_idx[i];
+    cfg.root_seq_idx       = 0;
+    cfg.zero_corr_zone     = 1;
+    cfg.freq_offset        = 0;
+    cfg.num_ra_preambles   = 64;
+    if (srsran_prach_set_cfg(&prach, &cfg, nof_prb)) {
+      ERROR("Error configuring PRACH config_idx=%d for %d PRB", cfg.config_idx, nof_prb);
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  srsran_prach_free(&prach);
+  return ret;
+}
+
+static int plan_dft_precoding(uint32_t nof_prb)
+{
+  srsran_dft_precoding_t tx = {};
+  srsran_dft_precoding_t rx = {};
+
+  if (srsran_dft_precoding_init_tx(&tx, nof_prb)) {
+    ERROR("Error initiating DFT precoding Tx for %d PRB", nof_prb);
+    return SRSRAN_ERROR;
+  }
+  if (srsran_dft_precoding_init_rx(&rx, nof_prb)) {
+    ERROR("Error initiating DFT precoding Rx for %d PRB", nof_prb);
+    srsran_dft_precoding_free(&tx);
+    return SRSRAN_ERROR;
+  }
+
+  srsran_dft_precoding_free(&tx);
+  srsran_dft_precoding_free(&rx);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  uint32_t max_prb = 0;
+  for (uint32_t i = 0; i < nof_prb_list_len; i++) {
+    if (!srsran_nofprb_isvalid(nof_prb_list[i])) {
+      ERROR("Invalid number of PRB %d", nof_prb_list[i]);
+      exit(-1);
+    }
+    max_prb = SRSRAN_MAX(max_prb, nof_prb_list[i]);
+  }
+
+  cf_t* td_buffer = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(max_prb));
+  cf_t* fd_buffer = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(max_prb, SRSRAN_CP_NORM));
+  if (!td_buffer || !fd_buffer) {
+    ERROR("Error allocating buffers");
+    exit(-1);
+  }
+
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < nof_prb_list_len && ret == SRSRAN_SUCCESS; i++) {
+    uint32_t nof_prb = nof_prb_list[i];
+    printf("Planning transforms for %d PRB...\n", nof_prb);
+    if (plan_ofdm(nof_prb, SRSRAN_CP_NORM, td_buffer, fd_buffer) ||
+        plan_ofdm(nof_prb, SRSRAN_CP_EXT, td_buffer, fd_buffer) || plan_prach(nof_prb) || plan_dft_precoding(nof_prb)) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  if (ret == SRSRAN_SUCCESS) {
+    srsran_dft_metrics_t metrics = {};
+    srsran_dft_get_metrics(&metrics);
+    printf("Requested %d plans, %d served from the plan cache, planning took %.1f ms\n",
+           metrics.nof_plans,
+           metrics.nof_cache_hits,
+           metrics.planning_time_s * 1e3);
+
+    if (srsran_dft_store_wisdom(output_file_name)) {
+      ERROR("Error storing FFTW wisdom");
+      ret = SRSRAN_ERROR;
+    } else {
+      printf("FFTW wisdom stored in %s\n", output_file_name ? output_file_name : "the default wisdom file");
+    }
+  }
+
+  free(td_buffer);
+  free(fd_buffer);
+  exit(ret == SRSRAN_SUCCESS ? 0 : -1);
+}
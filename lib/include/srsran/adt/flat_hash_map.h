@@ -0,0 +1,236 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_FLAT_HASH_MAP_H
+#define SRSRAN_FLAT_HASH_MAP_H
+
+#include "srsran/support/srsran_assert.h"
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Hash map for integer keys (e.g. TEIDs, IPv4 addresses) stored in a single contiguous array, with open addressing
+ * and linear probing. Lookups touch one or two cache lines, as opposed to the tree walk of a std::map.
+ * The table grows when the load factor exceeds 1/2. Erase uses backward shifting, so no tombstones are left behind.
+ * Mapped values must be default constructible. Insertions and erasures invalidate iterators.
+ */
+template <typename K, typename T>
+class flat_hash_map
+{
+  static_assert(std::is_integral<K>::value and std::is_unsigned<K>::value, "Map key must be an unsigned integer");
+
+  using obj_t = std::pair<K, T>;
+
+  template <typename Map, typename Obj>
+  class iter_impl
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = obj_t;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = Obj*;
+    using reference         = Obj&;
+
+    iter_impl() = default;
+    iter_impl(Map* map, size_t idx_) : ptr(map), idx(idx_)
+    {
+      if (idx < ptr->capacity() and not ptr->present[idx]) {
+        ++(*this);
+      }
+    }
+
+    iter_impl& operator++()
+    {
+      while (++idx < ptr->capacity() and not ptr->present[idx]) {
+      }
+      return *this;
+    }
+
+    Obj& operator*() const
+    {
+      srsran_assert(idx < ptr->capacity(), "Iterator out-of-bounds (%zd >= %zd)", idx, ptr->capacity());
+      return ptr->slots[idx];
+    }
+    Obj* operator->() const { return &**this; }
+
+    bool operator==(const iter_impl& other) const { return ptr == other.ptr and idx == other.idx; }
+    bool operator!=(const iter_impl& other) const { return not(*this == other); }
+
+  private:
+    Map*   ptr = nullptr;
+    size_t idx = 0;
+  };
+
+public:
+  using key_type       = K;
+  using mapped_type    = T;
+  using value_type     = obj_t;
+  using iterator       = iter_impl<flat_hash_map<K, T>, obj_t>;
+  using const_iterator = iter_impl<const flat_hash_map<K, T>, const obj_t>;
+
+  explicit flat_hash_map(size_t initial_capacity = 16) { rehash(initial_capacity); }
+
+  size_t size() const { return count; }
+  bool   empty() const { return count == 0; }
+  size_t capacity() const { return slots.size(); }
+
+  bool contains(K key) const { return find_idx(key) < capacity(); }
+
+  iterator find(K key) { return iterator(this, find_idx(key)); }
+  const_iterator find(K key) const { return const_iterator(this, find_idx(key)); }
+
+  /// Returns a pointer to the value mapped to key, or nullptr if the key is not present
+  T* find_value(K key)
+  {
+    size_t idx = find_idx(key);
+    return idx < capacity() ? &slots[idx].second : nullptr;
+  }
+  const T* find_value(K key) const
+  {
+    size_t idx = find_idx(key);
+    return idx < capacity() ? &slots[idx].second : nullptr;
+  }
+
+  /// Inserts (key, obj) if key is not yet present. Returns false otherwise
+  template <typename U>
+  bool insert(K key, U&& obj)
+  {
+    if (contains(key)) {
+      return false;
+    }
+    slots[insert_idx(key)].second = std::forward<U>(obj);
+    return true;
+  }
+
+  T& operator[](K key)
+  {
+    size_t idx = find_idx(key);
+    if (idx < capacity()) {
+      return slots[idx].second;
+    }
+    return slots[insert_idx(key)].second;
+  }
+
+  bool erase(K key)
+  {
+    size_t idx = find_idx(key);
+    if (idx >= capacity()) {
+      return false;
+    }
+    // Shift back the following entries of the probe chain that would become unreachable
+    size_t mask = capacity() - 1;
+    size_t next = (idx + 1) & mask;
+    while (present[next]) {
+      size_t home = hash(slots[next].first) & mask;
+      if (((next - home) & mask) >= ((next - idx) & mask)) {
+        slots[idx] = std::move(slots[next]);
+        idx        = next;
+      }
+      next = (next + 1) & mask;
+    }
+    slots[idx]   = obj_t{};
+    present[idx] = false;
+    count--;
+    return true;
+  }
+
+  void clear()
+  {
+    for (size_t idx = 0; idx < capacity(); ++idx) {
+      if (present[idx]) {
+        slots[idx]   = obj_t{};
+        present[idx] = false;
+      }
+    }
+    count = 0;
+  }
+
+  iterator       begin() { return iterator(this, 0); }
+  iterator       end() { return iterator(this, capacity()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, capacity()); }
+
+private:
+  static size_t hash(K key)
+  {
+    // Fibonacci hashing spreads sequential keys (e.g. TEIDs, UE IPs in network order) over the whole table
+    uint64_t h = static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ULL;
+    return static_cast<size_t>(h ^ (h >> 32U));
+  }
+
+  size_t find_idx(K key) const
+  {
+    size_t mask = capacity() - 1;
+    for (size_t idx = hash(key) & mask; present[idx]; idx = (idx + 1) & mask) {
+      if (slots[idx].first == key) {
+        return idx;
+      }
+    }
+    return capacity();
+  }
+
+  /// Reserves a slot for a key that is not present yet
+  size_t insert_idx(K key)
+  {
+    if (2 * (count + 1) > capacity()) {
+      rehash(2 * capacity());
+    }
+    size_t mask = capacity() - 1;
+    size_t idx  = hash(key) & mask;
+    while (present[idx]) {
+      idx = (idx + 1) & mask;
+    }
+    slots[idx].first = key;
+    present[idx]     = true;
+    count++;
+    return idx;
+  }
+
+  void rehash(size_t new_capacity)
+  {
+    size_t cap = 1;
+    while (cap < new_capacity) {
+      cap <<= 1U;
+    }
+    std::vector<obj_t>   old_slots(cap);
+    std::vector<uint8_t> old_present(cap, 0);
+    std::swap(old_slots, slots);
+    std::swap(old_present, present);
+    count = 0;
+    for (size_t idx = 0; idx < old_slots.size(); ++idx) {
+      if (old_present[idx]) {
+        slots[insert_idx(old_slots[idx].first)].second = std::move(old_slots[idx].second);
+      }
+    }
+  }
+
+  std::vector<obj_t>   slots;
+  std::vector<uint8_t> present;
+  size_t               count = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_FLAT_HASH_MAP_H
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_AES_H
+#define SRSRAN_AES_H
+
+#include "srsran/common/ssl.h"
+#include <cstdint>
+
+namespace srsran {
+
+/// AES implementations, ordered by increasing performance.
+enum class aes_impl_t { generic, aesni, vaes };
+
+const char* to_string(aes_impl_t impl);
+
+/******************************************************************************
+ * AES-128 context
+ *
+ * Holds the key schedule of a 128-bit key, so that it only needs to be
+ * computed once per key. Block encryption, CTR and CBC-MAC modes use the
+ * AES-NI instructions when the CPU supports them, processing several
+ * independent blocks in parallel in CTR mode (four 128-bit lanes per
+ * instruction with VAES), and fall back to mbedtls otherwise.
+ *****************************************************************************/
+class aes128_ctx
+{
+public:
+  aes128_ctx();
+  ~aes128_ctx();
+  aes128_ctx(const aes128_ctx& other);
+  aes128_ctx& operator=(const aes128_ctx& other);
+
+  /// Computes the key schedule of the given 16-byte key with the fastest implementation supported by the CPU.
+  void set_key(const uint8_t* key_);
+
+  /// Selects the implementation used by this context. Falls back to the best supported one if \c impl_ is not
+  /// supported by the CPU. Returns the selected implementation.
+  aes_impl_t set_impl(aes_impl_t impl_);
+  aes_impl_t get_impl() const { return impl; }
+
+  /// Encrypts a single 16-byte block.
+  void encrypt_block(const uint8_t* in, uint8_t* out) const;
+
+  /// Encrypts (or decrypts) \c len bytes in counter mode, starting with the given 16-byte counter block, which is
+  /// incremented as a 128-bit big-endian integer. Input and output may alias.
+  void ctr_crypt(const uint8_t* counter, const uint8_t* in, uint8_t* out, uint32_t len) const;
+
+  /// Runs CBC-MAC over \c nof_blocks full 16-byte blocks, updating the 16-byte chaining \c state.
+  void cbc_mac(uint8_t* state, const uint8_t* in, uint32_t nof_blocks) const;
+
+  /// Returns the fastest implementation supported by the CPU.
+  static aes_impl_t get_best_impl();
+
+private:
+  static const uint32_t nof_round_keys = 11;
+
+  alignas(16) uint8_t round_keys[nof_round_keys * 16] = {};
+  uint8_t             key[16]                         = {};
+  aes_impl_t          impl                            = aes_impl_t::generic;
+  mutable aes_context sw_ctx;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_AES_H
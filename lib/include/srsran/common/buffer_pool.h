@@ -25,6 +25,7 @@
 #include "byte_buffer.h"
 #include "srsran/adt/bounded_vector.h"
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <pthread.h>
 #include <stack>
@@ -34,6 +35,7 @@
 #include "srsran/adt/pool/fixed_size_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/srslog/srslog.h"
+#include "srsran/system/sys_metrics.h"
 
 namespace srsran {
 
@@ -166,23 +168,71 @@ private:
   uint32_t               capacity;
 };
 
-/// Type of global byte buffer pool
-using byte_buffer_pool = concurrent_fixed_memory_pool<sizeof(byte_buffer_t)>;
+/// Each byte_buffer_t pool block is prefixed with its size class, so that it can be returned to the right pool, and
+/// with the number of byte_buffer_slice references to the buffer.
+struct byte_buffer_block_header_t {
+  byte_buffer_size_class cls;
+  std::atomic<uint32_t>  nof_refs;
+};
+
+constexpr size_t byte_buffer_block_prefix_size = detail::max_alignment;
+static_assert(sizeof(byte_buffer_block_header_t) <= byte_buffer_block_prefix_size,
+              "The byte buffer block header does not fit in the block prefix");
+
+/// Returns the header of the pool block holding the given buffer. Every unique_byte_buffer_t is pool allocated.
+inline byte_buffer_block_header_t& get_byte_buffer_block_header(byte_buffer_t* buf)
+{
+  return *reinterpret_cast<byte_buffer_block_header_t*>(reinterpret_cast<uint8_t*>(buf) -
+                                                        byte_buffer_block_prefix_size);
+}
+
+/// Size of the pool blocks holding byte buffers of the given size class, i.e. the object followed by its storage.
+constexpr size_t byte_buffer_block_size(byte_buffer_size_class cls)
+{
+  return byte_buffer_block_prefix_size + sizeof(byte_buffer_t) + byte_buffer_t::headroom +
+         get_byte_buffer_payload_size(cls);
+}
+
+/// Type of global byte buffer pool. Backs the large size class, which is used by default.
+using byte_buffer_pool = concurrent_fixed_memory_pool<byte_buffer_block_size(byte_buffer_size_class::large)>;
+/// Pools backing the small and medium byte buffer size classes.
+using small_byte_buffer_pool  = concurrent_fixed_memory_pool<byte_buffer_block_size(byte_buffer_size_class::small)>;
+using medium_byte_buffer_pool = concurrent_fixed_memory_pool<byte_buffer_block_size(byte_buffer_size_class::medium)>;
+
+/// Function used to generate unique byte buffers of a given size class.
+unique_byte_buffer_t make_byte_buffer(byte_buffer_size_class cls) noexcept;
+
+/// Function used to generate unique byte buffers of the smallest size class that fits a payload of the given length.
+/// Meant for buffers whose final size is known upfront, e.g. copies of received PDUs that get queued.
+unique_byte_buffer_t make_sized_byte_buffer(uint32_t payload_len) noexcept;
+
+/// Makes sure that the buffer has at least the given tailroom, moving its content to a buffer of a larger size class
+/// if needed. The headroom and metadata of the buffer are preserved. Returns false if the buffer could not be grown.
+bool reserve_byte_buffer_tailroom(unique_byte_buffer_t& buf, uint32_t tailroom);
+
+/// Fills the usage of each byte buffer size class.
+void get_byte_buffer_pool_metrics(sys_metrics_t& metrics);
 
 /// Function used to generate unique byte buffers
 inline unique_byte_buffer_t make_byte_buffer() noexcept
 {
-  return std::unique_ptr<byte_buffer_t>(new (std::nothrow) byte_buffer_t());
+  return make_byte_buffer(byte_buffer_size_class::large);
 }
 
 inline unique_byte_buffer_t make_byte_buffer(uint32_t size, uint8_t value) noexcept
 {
-  return std::unique_ptr<byte_buffer_t>(new (std::nothrow) byte_buffer_t(size, value));
+  unique_byte_buffer_t buffer = make_byte_buffer(byte_buffer_size_class::large);
+  if (buffer != nullptr) {
+    srsran_always_assert(size <= buffer->get_tailroom(), "Byte buffer size %d exceeds capacity", size);
+    buffer->N_bytes = size;
+    std::fill(buffer->msg, buffer->msg + size, value);
+  }
+  return buffer;
 }
 
 inline unique_byte_buffer_t make_byte_buffer(const char* debug_ctxt) noexcept
 {
-  std::unique_ptr<byte_buffer_t> buffer(new (std::nothrow) byte_buffer_t());
+  unique_byte_buffer_t buffer = make_byte_buffer(byte_buffer_size_class::large);
   if (buffer == nullptr) {
     srslog::fetch_basic_logger("POOL").error("Failed to allocate byte buffer in %s", debug_ctxt);
   }
@@ -191,7 +241,7 @@ inline unique_byte_buffer_t make_byte_buffer(const char* debug_ctxt) noexcept
 
 inline unique_byte_buffer_t make_byte_buffer(const uint8_t* payload, uint32_t len, const char* debug_ctxt) noexcept
 {
-  std::unique_ptr<byte_buffer_t> buffer(new (std::nothrow) byte_buffer_t());
+  unique_byte_buffer_t buffer = make_sized_byte_buffer(len);
   if (buffer == nullptr) {
     srslog::fetch_basic_logger("POOL").error("Failed to allocate byte buffer in %s", debug_ctxt);
   } else {
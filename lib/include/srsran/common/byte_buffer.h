@@ -24,7 +24,10 @@
 
 #include "common.h"
 #include "srsran/adt/span.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 
 //#define SRSRAN_BUFFER_POOL_LOG_ENABLED
@@ -79,47 +82,128 @@ private:
 #endif
 };
 
+/// Per-buffer metadata carried along with the payload of a byte_buffer_t.
+struct byte_buffer_metadata_t {
+  uint32_t            pdcp_sn = 0;
+  buffer_latency_calc tp;
+};
+
+/******************************************************************************
+ * Byte buffer size classes
+ *
+ * Pooled byte buffers are allocated from one of several size classes. All
+ * classes provide the same headroom and only differ in payload capacity, so
+ * that queued small SDUs do not pin a maximum sized block each.
+ *****************************************************************************/
+enum class byte_buffer_size_class : uint8_t { small, medium, large, nof_classes };
+
+constexpr uint32_t nof_byte_buffer_size_classes = static_cast<uint32_t>(byte_buffer_size_class::nof_classes);
+
+/// Payload capacity (excluding headroom) of each byte buffer size class.
+constexpr uint32_t byte_buffer_small_payload_size  = 256;
+constexpr uint32_t byte_buffer_medium_payload_size = 2048;
+constexpr uint32_t byte_buffer_large_payload_size  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+
+constexpr uint32_t get_byte_buffer_payload_size(byte_buffer_size_class cls)
+{
+  return cls == byte_buffer_size_class::small
+             ? byte_buffer_small_payload_size
+             : (cls == byte_buffer_size_class::medium ? byte_buffer_medium_payload_size
+                                                      : byte_buffer_large_payload_size);
+}
+
+/// Returns the smallest size class whose payload capacity fits \c payload_len bytes.
+constexpr byte_buffer_size_class select_byte_buffer_size_class(uint32_t payload_len)
+{
+  return payload_len <= byte_buffer_small_payload_size
+             ? byte_buffer_size_class::small
+             : (payload_len <= byte_buffer_medium_payload_size ? byte_buffer_size_class::medium
+                                                               : byte_buffer_size_class::large);
+}
+
+const char* to_string(byte_buffer_size_class cls);
+
+namespace detail {
+
+/// Mirrors the members of byte_buffer_t, which is needed to derive its headroom inside the class definition.
+struct byte_buffer_header_t {
+  uint32_t               N_bytes;
+  uint32_t               buffer_size;
+  uint8_t*               msg;
+  byte_buffer_metadata_t md;
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
+  char debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN];
+#endif
+  uint8_t*                   buffer;
+  std::unique_ptr<uint8_t[]> owned_buffer;
+};
+
+} // namespace detail
+
+class byte_buffer_t;
+
+using unique_byte_buffer_t = std::unique_ptr<byte_buffer_t>;
+
 /******************************************************************************
  * Byte buffer
  *
  * Generic byte buffer with headroom to accommodate packet headers and custom
  * copy constructors & assignment operators for quick copying. Byte buffer
  * holds a next pointer to support linked lists.
+ *
+ * The storage is not part of the object. Pooled buffers keep it right after
+ * the object, in the same pool block, which is only as large as the size
+ * class requires. Buffers created as plain objects (e.g. on the stack) own a
+ * heap allocated storage of the large size class.
+ * The headroom is chosen such that the payload of pooled buffers starts at
+ * the same offset as LIBLTE_BYTE_MSG_STRUCT::msg, as the NAS code overlays
+ * both structs.
  *****************************************************************************/
 class byte_buffer_t
 {
 public:
-  using iterator       = uint8_t*;
-  using const_iterator = const uint8_t*;
+  using iterator          = uint8_t*;
+  using const_iterator    = const uint8_t*;
+  using buffer_metadata_t = byte_buffer_metadata_t;
+
+  /// Headroom of a freshly allocated or cleared buffer.
+  static constexpr uint32_t headroom =
+      sizeof(uint32_t) + SRSRAN_BUFFER_HEADER_OFFSET - sizeof(detail::byte_buffer_header_t);
 
   uint32_t N_bytes = 0;
-  uint8_t  buffer[SRSRAN_MAX_BUFFER_SIZE_BYTES];
-  uint8_t* msg = nullptr;
+  /// Usable size of the storage. Smaller than the one of the large size class for buffers of the small and medium
+  /// size classes.
+  uint32_t          buffer_size = headroom + byte_buffer_large_payload_size;
+  uint8_t*          msg         = nullptr;
+  buffer_metadata_t md;
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
   char debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN];
 #endif
+  /// Start of the storage, which is owned_buffer for buffers that do not come from the pools.
+  uint8_t*                   buffer = nullptr;
+  std::unique_ptr<uint8_t[]> owned_buffer;
 
-  struct buffer_metadata_t {
-    uint32_t            pdcp_sn = 0;
-    buffer_latency_calc tp;
-  } md;
-
-  byte_buffer_t() : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET])
+  byte_buffer_t() : owned_buffer(new uint8_t[headroom + byte_buffer_large_payload_size])
   {
+    buffer = owned_buffer.get();
+    msg    = &buffer[headroom];
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
     bzero(debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
 #endif
   }
-  explicit byte_buffer_t(uint32_t size) : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET]), N_bytes(size)
+  explicit byte_buffer_t(uint32_t size) : byte_buffer_t()
   {
-#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
-    bzero(debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
-#endif
+    srsran_always_assert(size <= byte_buffer_large_payload_size, "Byte buffer size %d exceeds capacity", size);
+    N_bytes = size;
   }
   byte_buffer_t(uint32_t size, uint8_t val) : byte_buffer_t(size) { std::fill(msg, msg + N_bytes, val); }
-  byte_buffer_t(const byte_buffer_t& buf) : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET]), md(buf.md), N_bytes(buf.N_bytes)
+  byte_buffer_t(const byte_buffer_t& buf) : byte_buffer_t()
   {
     // copy actual contents
+    srsran_always_assert(
+        buf.N_bytes <= byte_buffer_large_payload_size, "Byte buffer size %d exceeds capacity", buf.N_bytes);
+    N_bytes = buf.N_bytes;
+    md      = buf.md;
     memcpy(msg, buf.msg, N_bytes);
   }
 
@@ -128,7 +212,16 @@ public:
     // avoid self assignment
     if (&buf == this)
       return *this;
-    msg     = &buffer[buf.msg - &(*buf.buffer)];
+    uint32_t offset = buf.msg - buf.buffer;
+    if (offset + buf.N_bytes > buffer_size) {
+      // the source headroom does not fit in this buffer, fall back to the default one
+      offset = headroom;
+    }
+    srsran_always_assert(offset + buf.N_bytes <= buffer_size,
+                         "Byte buffer of %d bytes does not fit in a buffer of the %s size class",
+                         buf.N_bytes,
+                         to_string(get_size_class()));
+    msg     = &buffer[offset];
     N_bytes = buf.N_bytes;
     md      = buf.md;
     memcpy(msg, buf.msg, N_bytes);
@@ -137,13 +230,15 @@ public:
 
   void clear()
   {
-    msg     = &buffer[SRSRAN_BUFFER_HEADER_OFFSET];
+    msg     = &buffer[headroom];
     N_bytes = 0;
     md      = {};
   }
   uint32_t get_headroom() { return msg - buffer; }
   // Returns the remaining space from what is reported to be the length of msg
-  uint32_t                  get_tailroom() const { return (sizeof(buffer) - (msg - buffer) - N_bytes); }
+  uint32_t get_tailroom() const { return (buffer_size - (msg - buffer) - N_bytes); }
+  /// Returns the size class of the storage backing this buffer.
+  byte_buffer_size_class    get_size_class() const { return select_byte_buffer_size_class(buffer_size - headroom); }
   std::chrono::microseconds get_latency_us() const { return md.tp.get_latency_us(); }
 
   std::chrono::high_resolution_clock::time_point get_timestamp() const { return md.tp.get_timestamp(); }
@@ -152,8 +247,9 @@ public:
 
   void set_timestamp(std::chrono::high_resolution_clock::time_point tp_) { md.tp.set_timestamp(tp_); }
 
-  void append_bytes(uint8_t* buf, uint32_t size)
+  void append_bytes(const uint8_t* buf, uint32_t size)
   {
+    srsran_always_assert(size <= get_tailroom(), "Appending %d bytes exceeds the tailroom of %d", size, get_tailroom());
     memcpy(&msg[N_bytes], buf, size);
     N_bytes += size;
   }
@@ -169,13 +265,34 @@ public:
   iterator       end() { return msg + N_bytes; }
   const_iterator end() const { return msg + N_bytes; }
 
-  void* operator new(size_t sz);
-  void* operator new(size_t sz, const std::nothrow_t& nothrow_value) noexcept;
-  void* operator new[](size_t sz) = delete;
+  // Heap allocated buffers must come from the pools, see make_byte_buffer()
+  void* operator new(size_t sz)                                      = delete;
+  void* operator new(size_t sz, const std::nothrow_t& nothrow_value) = delete;
+  void* operator new[](size_t sz)                                    = delete;
   void  operator delete(void* ptr);
   void  operator delete[](void* ptr) = delete;
+
+private:
+  friend unique_byte_buffer_t make_byte_buffer(byte_buffer_size_class cls) noexcept;
+
+  /// Constructs a pooled buffer, whose storage of the given size class follows the object in its pool block.
+  explicit byte_buffer_t(byte_buffer_size_class cls) :
+    buffer_size(headroom + get_byte_buffer_payload_size(cls)), buffer(reinterpret_cast<uint8_t*>(this + 1))
+  {
+    msg = &buffer[headroom];
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
+    bzero(debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
+#endif
+  }
+
+  void* operator new(size_t sz, byte_buffer_size_class cls, const std::nothrow_t& nothrow_value) noexcept;
+  void  operator delete(void* ptr, byte_buffer_size_class cls, const std::nothrow_t& nothrow_value) noexcept;
 };
 
+static_assert(sizeof(byte_buffer_t) == sizeof(detail::byte_buffer_header_t), "byte_buffer_t header layout mismatch");
+static_assert(sizeof(byte_buffer_t) + byte_buffer_t::headroom == sizeof(uint32_t) + SRSRAN_BUFFER_HEADER_OFFSET,
+              "byte_buffer_t payload offset mismatch");
+
 struct bit_buffer_t {
   uint32_t N_bits = 0;
   uint8_t  buffer[SRSRAN_MAX_BUFFER_SIZE_BITS];
@@ -208,8 +325,6 @@ struct bit_buffer_t {
   uint32_t get_headroom() { return msg - buffer; }
 };
 
-using unique_byte_buffer_t = std::unique_ptr<byte_buffer_t>;
-
 ///
 /// Utilities to create a span out of a byte_buffer.
 ///
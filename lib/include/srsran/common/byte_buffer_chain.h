@@ -0,0 +1,205 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_BYTE_BUFFER_CHAIN_H
+#define SRSRAN_BYTE_BUFFER_CHAIN_H
+
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer.h"
+
+namespace srsran {
+
+/******************************************************************************
+ * Byte buffer slices and chains
+ *
+ * A slice is a view of a contiguous range of a pooled byte buffer, which it
+ * keeps alive through a reference count stored in the header of the buffer's
+ * pool block. Slices let the segments of one SDU be placed in several PDUs
+ * without copying the payload. A chain is an ordered list of slices forming a
+ * payload spread over several buffers. It is only gathered into contiguous
+ * memory when it is written out, e.g. into a MAC PDU.
+ *
+ * The reference counts are atomic, but a slice is meant to be owned by a
+ * single entity, e.g. one RLC bearer.
+ *****************************************************************************/
+
+class byte_buffer_slice
+{
+public:
+  byte_buffer_slice() = default;
+  /// Takes ownership of the buffer. The slice covers its whole payload.
+  explicit byte_buffer_slice(unique_byte_buffer_t buf_)
+  {
+    if (buf_ != nullptr) {
+      ptr = buf_->msg;
+      len = buf_->N_bytes;
+      buf = buf_.release();
+      get_byte_buffer_block_header(buf).nof_refs.store(1, std::memory_order_relaxed);
+    }
+  }
+  byte_buffer_slice(const byte_buffer_slice& other) : buf(other.buf), ptr(other.ptr), len(other.len) { add_ref(); }
+  byte_buffer_slice(byte_buffer_slice&& other) noexcept : buf(other.buf), ptr(other.ptr), len(other.len)
+  {
+    other.buf = nullptr;
+    other.ptr = nullptr;
+    other.len = 0;
+  }
+  byte_buffer_slice& operator=(const byte_buffer_slice& other)
+  {
+    if (this != &other) {
+      clear();
+      buf = other.buf;
+      ptr = other.ptr;
+      len = other.len;
+      add_ref();
+    }
+    return *this;
+  }
+  byte_buffer_slice& operator=(byte_buffer_slice&& other) noexcept
+  {
+    if (this != &other) {
+      clear();
+      std::swap(buf, other.buf);
+      std::swap(ptr, other.ptr);
+      std::swap(len, other.len);
+    }
+    return *this;
+  }
+  ~byte_buffer_slice() { clear(); }
+
+  const uint8_t* data() const { return ptr; }
+  uint32_t       size() const { return len; }
+  bool           empty() const { return len == 0; }
+
+  /// Metadata of the underlying buffer. Only valid while the slice holds a buffer.
+  const byte_buffer_metadata_t& md() const { return buf->md; }
+
+  /// Drops the first n bytes of the slice. The underlying buffer is kept until clear() is called.
+  void advance(uint32_t n)
+  {
+    n = std::min(n, len);
+    ptr += n;
+    len -= n;
+  }
+
+  /// Returns a slice of the first n bytes, which are dropped from this slice. Taking the whole slice moves it, which
+  /// saves the reference count update.
+  byte_buffer_slice take_front(uint32_t n)
+  {
+    if (n >= len) {
+      return std::move(*this);
+    }
+    byte_buffer_slice front(*this);
+    front.len = n;
+    advance(n);
+    return front;
+  }
+
+  void clear()
+  {
+    // The last reference cannot be shared concurrently, so the atomic decrement is only needed for shared buffers
+    if (buf != nullptr and (get_byte_buffer_block_header(buf).nof_refs.load(std::memory_order_acquire) == 1 or
+                            get_byte_buffer_block_header(buf).nof_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)) {
+      delete buf;
+    }
+    buf = nullptr;
+    ptr = nullptr;
+    len = 0;
+  }
+
+private:
+  void add_ref()
+  {
+    if (buf != nullptr) {
+      get_byte_buffer_block_header(buf).nof_refs.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  byte_buffer_t* buf = nullptr;
+  uint8_t*       ptr = nullptr;
+  uint32_t       len = 0;
+};
+
+/// Chain of up to MaxSlices slices, stored inline.
+template <size_t MaxSlices>
+class byte_buffer_chain
+{
+  using slice_list = bounded_vector<byte_buffer_slice, MaxSlices>;
+
+public:
+  using const_iterator = typename slice_list::const_iterator;
+
+  /// Appends a slice to the end of the chain. Empty slices are dropped. The chain must not be full.
+  void append(byte_buffer_slice slice)
+  {
+    if (slice.empty()) {
+      return;
+    }
+    srsran_assert(not full(), "Appending to a full byte_buffer_chain (%zd slices)", slices.size());
+    total_len += slice.size();
+    slices.push_back(std::move(slice));
+  }
+
+  uint32_t length() const { return total_len; }
+  bool     empty() const { return total_len == 0; }
+  bool     full() const { return slices.full(); }
+  size_t   nof_slices() const { return slices.size(); }
+
+  void clear()
+  {
+    slices.clear();
+    total_len = 0;
+  }
+
+  const_iterator begin() const { return slices.begin(); }
+  const_iterator end() const { return slices.end(); }
+
+  /// Copies up to len bytes, starting at the given offset of the chain, to dst. Returns the number of bytes copied.
+  uint32_t copy_to(uint8_t* dst, uint32_t offset, uint32_t len) const
+  {
+    uint32_t copied = 0;
+    for (const byte_buffer_slice& slice : slices) {
+      if (copied == len) {
+        break;
+      }
+      if (offset >= slice.size()) {
+        offset -= slice.size();
+        continue;
+      }
+      uint32_t n = std::min(slice.size() - offset, len - copied);
+      memcpy(dst + copied, slice.data() + offset, n);
+      copied += n;
+      offset = 0;
+    }
+    return copied;
+  }
+
+  uint32_t copy_to(uint8_t* dst) const { return copy_to(dst, 0, total_len); }
+
+private:
+  slice_list slices;
+  uint32_t   total_len = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_BYTE_BUFFER_CHAIN_H
@@ -27,6 +27,7 @@
 #ifndef SRSRAN_COMMON_HELPER_H
 #define SRSRAN_COMMON_HELPER_H
 
+#include "srsran/phy/dft/dft.h"
 #include "srsran/srslog/srslog.h"
 #include <fstream>
 #include <sstream>
@@ -72,6 +73,27 @@ inline void check_scaling_governor(const std::string& device_name)
   }
 }
 
+inline void log_dft_metrics(const std::string& service)
+{
+  srsran_dft_metrics_t metrics = {};
+  srsran_dft_get_metrics(&metrics);
+
+  srslog::fetch_basic_logger(service).info(
+      "DFT plans: requested=%d, cache_hits=%d, fftw_plans=%d, planning_time=%.1f ms, wisdom %s in %.1f ms",
+      metrics.nof_plans,
+      metrics.nof_cache_hits,
+      metrics.nof_fftw_plans,
+      metrics.planning_time_s * 1e3,
+      metrics.wisdom_loaded ? "loaded" : "not loaded",
+      metrics.wisdom_load_time_s * 1e3);
+
+  if (metrics.planning_time_s > 1.0) {
+    printf("WARNING: Planning the DFTs took %.1f s. Consider generating the FFTW wisdom with the fftw_wisdom tool to "
+           "speed up the startup.\n",
+           metrics.planning_time_s);
+  }
+}
+
 } // namespace srsran
 
 #endif // SRSRAN_COMMON_HELPER_H
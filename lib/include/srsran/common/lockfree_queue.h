@@ -0,0 +1,484 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         lockfree_queue.h
+ *  Description:  Bounded lock-free ring queues for inter-thread hand-offs.
+ *                spsc_queue supports one producer and one consumer, and
+ *                mpsc_queue any number of producers. Both are non-blocking.
+ *                blocking_queue adds futex-based blocking push/pop on top.
+ *****************************************************************************/
+
+#ifndef SRSRAN_LOCKFREE_QUEUE_H
+#define SRSRAN_LOCKFREE_QUEUE_H
+
+#include "srsran/adt/detail/type_storage.h"
+#include "srsran/adt/expected.h"
+#include "srsran/support/srsran_assert.h"
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <linux/futex.h>
+#include <memory>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace srsran {
+
+namespace detail {
+
+/// Size used to keep the producer and consumer state in different cache lines
+constexpr size_t lockfree_queue_align = 64;
+
+/**
+ * Futex-based event. Waiters sleep until the event is notified. Notifying only costs a fence and a load when there
+ * are no waiters, so it can be done after every push/pop.
+ * Waiting follows the pattern:
+ *   uint32_t ticket = ev.prepare_wait();
+ *   if (condition) { ev.cancel_wait(); } else { ev.wait(ticket); }
+ */
+class futex_event
+{
+public:
+  uint32_t prepare_wait()
+  {
+    nof_waiters.fetch_add(1, std::memory_order_seq_cst);
+    return seq.load(std::memory_order_seq_cst);
+  }
+
+  void cancel_wait() { nof_waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+  /// Waits for a notification posted after prepare_wait(). Returns false if the absolute (CLOCK_REALTIME) timeout
+  /// is reached first
+  bool wait(uint32_t ticket, const struct timespec* abstime = nullptr)
+  {
+    bool ret = true;
+    if (seq.load(std::memory_order_acquire) == ticket) {
+      int  op  = FUTEX_WAIT_BITSET_PRIVATE | (abstime != nullptr ? FUTEX_CLOCK_REALTIME : 0);
+      long res = syscall(
+          SYS_futex, reinterpret_cast<uint32_t*>(&seq), op, ticket, abstime, nullptr, FUTEX_BITSET_MATCH_ANY);
+      ret = not(res == -1 and errno == ETIMEDOUT);
+    }
+    nof_waiters.fetch_sub(1, std::memory_order_relaxed);
+    return ret;
+  }
+
+  void notify_all()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (nof_waiters.load(std::memory_order_relaxed) > 0) {
+      seq.fetch_add(1, std::memory_order_seq_cst);
+      syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+    }
+  }
+
+private:
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit integer");
+  std::atomic<uint32_t> seq         = {0};
+  std::atomic<int>      nof_waiters = {0};
+};
+
+} // namespace detail
+
+/**
+ * Bounded single-producer single-consumer ring queue. Each side only writes its own index, and keeps a cached copy of
+ * the other side's index to avoid sharing cache lines in the common case.
+ */
+template <typename T>
+class spsc_queue
+{
+public:
+  using value_type = T;
+
+  explicit spsc_queue(size_t capacity_) : cap(capacity_), buffer(new detail::type_storage<T>[capacity_])
+  {
+    srsran_assert(capacity_ > 0, "Invalid queue capacity");
+  }
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+  ~spsc_queue() { clear(); }
+
+  bool try_push(const T& obj)
+  {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (not has_space(t)) {
+      return false;
+    }
+    buffer[t % cap].emplace(obj);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  srsran::error_type<T> try_push(T&& obj)
+  {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (not has_space(t)) {
+      return std::move(obj);
+    }
+    buffer[t % cap].emplace(std::move(obj));
+    tail.store(t + 1, std::memory_order_release);
+    return {};
+  }
+
+  /// Called only from the consumer side
+  bool try_pop(T& obj)
+  {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h == cached_tail) {
+      cached_tail = tail.load(std::memory_order_acquire);
+      if (h == cached_tail) {
+        return false;
+      }
+    }
+    T& val = buffer[h % cap].get();
+    obj    = std::move(val);
+    val.~T();
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Called only from the consumer side
+  void clear()
+  {
+    T obj;
+    while (try_pop(obj)) {
+    }
+  }
+
+  size_t size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+  bool   empty() const { return size() == 0; }
+  bool   full() const { return size() >= cap; }
+  size_t capacity() const { return cap; }
+
+private:
+  /// Checks, from the producer side, whether there is room for pushing at position t
+  bool has_space(size_t t)
+  {
+    if (t - cached_head >= cap) {
+      cached_head = head.load(std::memory_order_acquire);
+      return t - cached_head < cap;
+    }
+    return true;
+  }
+
+  const size_t                               cap;
+  std::unique_ptr<detail::type_storage<T>[]> buffer;
+
+  // producer side
+  alignas(detail::lockfree_queue_align) std::atomic<size_t> tail = {0};
+  size_t cached_head                                           = 0;
+
+  // consumer side
+  alignas(detail::lockfree_queue_align) std::atomic<size_t> head = {0};
+  size_t cached_tail                                           = 0;
+};
+
+/**
+ * Bounded multi-producer ring queue. Each slot carries a sequence number that tells producers and consumers whether it
+ * is free (2*pos) or filled (2*pos + 1) for the current lap, so indexes are claimed with a single CAS and no lock is
+ * ever taken.
+ * Popping also claims slots with a CAS, which makes concurrent pops safe. This is used to drain a queue from a thread
+ * other than its consumer (e.g. when the queue is deactivated).
+ */
+template <typename T>
+class mpsc_queue
+{
+  struct cell_t {
+    std::atomic<size_t>     seq;
+    detail::type_storage<T> obj;
+  };
+
+public:
+  using value_type = T;
+
+  explicit mpsc_queue(size_t capacity_) : cap(capacity_), cells(new cell_t[capacity_])
+  {
+    srsran_assert(capacity_ > 0, "Invalid queue capacity");
+    for (size_t i = 0; i < cap; ++i) {
+      cells[i].seq.store(2 * i, std::memory_order_relaxed);
+    }
+  }
+  mpsc_queue(const mpsc_queue&) = delete;
+  mpsc_queue& operator=(const mpsc_queue&) = delete;
+  ~mpsc_queue() { clear(); }
+
+  bool try_push(const T& obj)
+  {
+    size_t  pos;
+    cell_t* cell = claim_push(pos);
+    if (cell == nullptr) {
+      return false;
+    }
+    cell->obj.emplace(obj);
+    cell->seq.store(2 * pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  srsran::error_type<T> try_push(T&& obj)
+  {
+    size_t  pos;
+    cell_t* cell = claim_push(pos);
+    if (cell == nullptr) {
+      return std::move(obj);
+    }
+    cell->obj.emplace(std::move(obj));
+    cell->seq.store(2 * pos + 1, std::memory_order_release);
+    return {};
+  }
+
+  bool try_pop(T& obj)
+  {
+    size_t pos = head.load(std::memory_order_relaxed);
+    for (;;) {
+      cell_t&   cell = cells[pos % cap];
+      size_t    seq  = cell.seq.load(std::memory_order_acquire);
+      ptrdiff_t dif  = (ptrdiff_t)seq - (ptrdiff_t)(2 * pos + 1);
+      if (dif == 0) {
+        if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          T& val = cell.obj.get();
+          obj    = std::move(val);
+          val.~T();
+          cell.seq.store(2 * (pos + cap), std::memory_order_release);
+          return true;
+        }
+      } else if (dif < 0) {
+        // empty
+        return false;
+      } else {
+        pos = head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void clear()
+  {
+    T obj;
+    while (try_pop(obj)) {
+    }
+  }
+
+  /// Number of claimed cells, which includes the ones still being written by a producer
+  size_t size() const
+  {
+    size_t t = tail.load(std::memory_order_acquire);
+    size_t h = head.load(std::memory_order_acquire);
+    return t > h ? t - h : 0;
+  }
+
+  /// Checks whether the next cell to pop is published yet, so that a cell claimed but still being written by a
+  /// producer counts as empty
+  bool empty() const
+  {
+    size_t pos = head.load(std::memory_order_acquire);
+    for (;;) {
+      if (cells[pos % cap].seq.load(std::memory_order_acquire) == 2 * pos + 1) {
+        return false;
+      }
+      size_t h = head.load(std::memory_order_acquire);
+      if (h == pos) {
+        return true;
+      }
+      pos = h;
+    }
+  }
+
+  /// Checks whether the next cell to push is released yet, so that a cell claimed but still being read by a consumer
+  /// counts as full
+  bool full() const
+  {
+    size_t pos = tail.load(std::memory_order_acquire);
+    for (;;) {
+      if (cells[pos % cap].seq.load(std::memory_order_acquire) == 2 * pos) {
+        return false;
+      }
+      size_t t = tail.load(std::memory_order_acquire);
+      if (t == pos) {
+        return true;
+      }
+      pos = t;
+    }
+  }
+
+  size_t capacity() const { return cap; }
+
+private:
+  /// Claims the cell for the next push. Returns nullptr if the queue is full
+  cell_t* claim_push(size_t& pos)
+  {
+    pos = tail.load(std::memory_order_relaxed);
+    for (;;) {
+      cell_t&   cell = cells[pos % cap];
+      size_t    seq  = cell.seq.load(std::memory_order_acquire);
+      ptrdiff_t dif  = (ptrdiff_t)seq - (ptrdiff_t)(2 * pos);
+      if (dif == 0) {
+        if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          return &cell;
+        }
+      } else if (dif < 0) {
+        // full
+        return nullptr;
+      } else {
+        pos = tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  const size_t              cap;
+  std::unique_ptr<cell_t[]> cells;
+  alignas(detail::lockfree_queue_align) std::atomic<size_t> tail = {0};
+  alignas(detail::lockfree_queue_align) std::atomic<size_t> head = {0};
+};
+
+/**
+ * Adds blocking push/pop to spsc_queue or mpsc_queue, with the same semantics as block_queue. Waiting threads sleep on
+ * a futex, and the non-blocking paths never enter the kernel unless a thread is waiting on the other side.
+ * @tparam Queue spsc_queue<T> or mpsc_queue<T>
+ */
+template <typename Queue>
+class blocking_queue
+{
+public:
+  using value_type = typename Queue::value_type;
+  using T          = value_type;
+
+  explicit blocking_queue(size_t capacity_) : q(capacity_) {}
+  ~blocking_queue() { stop(); }
+
+  /// Unlocks the threads waiting at push or pop. Any later push or blocking pop fails
+  void stop()
+  {
+    running.store(false, std::memory_order_seq_cst);
+    not_empty.notify_all();
+    not_full.notify_all();
+  }
+
+  bool push(const T& obj)
+  {
+    T tmp = obj;
+    return push(std::move(tmp));
+  }
+
+  bool push(T&& obj)
+  {
+    for (;;) {
+      if (not running.load(std::memory_order_relaxed)) {
+        return false;
+      }
+      if (try_push_(obj)) {
+        return true;
+      }
+      uint32_t ticket = not_full.prepare_wait();
+      if (not q.full() or not running.load(std::memory_order_relaxed)) {
+        not_full.cancel_wait();
+        continue;
+      }
+      not_full.wait(ticket);
+    }
+  }
+
+  bool try_push(const T& obj)
+  {
+    if (not running.load(std::memory_order_relaxed) or not q.try_push(obj)) {
+      return false;
+    }
+    not_empty.notify_all();
+    return true;
+  }
+
+  srsran::error_type<T> try_push(T&& obj)
+  {
+    if (not running.load(std::memory_order_relaxed)) {
+      return std::move(obj);
+    }
+    srsran::error_type<T> ret = q.try_push(std::move(obj));
+    if (ret.has_value()) {
+      not_empty.notify_all();
+    }
+    return ret;
+  }
+
+  bool try_pop(T& obj)
+  {
+    if (not q.try_pop(obj)) {
+      return false;
+    }
+    not_full.notify_all();
+    return true;
+  }
+
+  /// Blocks until an element is popped or the queue is stopped
+  bool pop(T& obj) { return timed_pop(obj, nullptr); }
+
+  T wait_pop()
+  {
+    T obj = T();
+    pop(obj);
+    return obj;
+  }
+
+  /// Blocks until an element is popped, the absolute timeout (CLOCK_REALTIME) is reached or the queue is stopped
+  bool timed_pop(T& obj, const struct timespec* abstime)
+  {
+    for (;;) {
+      if (try_pop(obj)) {
+        return true;
+      }
+      if (not running.load(std::memory_order_relaxed)) {
+        return false;
+      }
+      uint32_t ticket = not_empty.prepare_wait();
+      if (not q.empty() or not running.load(std::memory_order_relaxed)) {
+        not_empty.cancel_wait();
+        continue;
+      }
+      if (not not_empty.wait(ticket, abstime)) {
+        return try_pop(obj);
+      }
+    }
+  }
+
+  size_t size() const { return q.size(); }
+  bool   empty() const { return q.empty(); }
+  bool   full() const { return q.full(); }
+  size_t capacity() const { return q.capacity(); }
+
+private:
+  bool try_push_(T& obj)
+  {
+    srsran::error_type<T> ret = q.try_push(std::move(obj));
+    if (not ret.has_value()) {
+      obj = std::move(ret.error());
+      return false;
+    }
+    not_empty.notify_all();
+    return true;
+  }
+
+  Queue               q;
+  std::atomic<bool>   running = {true};
+  detail::futex_event not_empty;
+  detail::futex_event not_full;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_LOCKFREE_QUEUE_H
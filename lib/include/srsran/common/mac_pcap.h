@@ -24,23 +24,29 @@
 
 #include "srsran/common/common.h"
 #include "srsran/common/mac_pcap_base.h"
+#include "srsran/common/pcap_block_writer.h"
 #include "srsran/srsran.h"
 
 namespace srsran {
+/// MAC PCAP file writer. PDUs are serialized directly into the write blocks of a pcap_block_writer, without queueing
+/// PDU copies for the writer thread
 class mac_pcap : public mac_pcap_base
 {
 public:
   mac_pcap();
   ~mac_pcap();
-  uint32_t open(std::string filename, uint32_t ue_id = 0);
+  uint32_t open(std::string filename, uint32_t ue_id = 0, const pcap_writer_args_t& writer_args = {});
   uint32_t close();
 
+  pcap_writer_metrics_t get_metrics() const { return writer.get_metrics(); }
+
 private:
   void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  void push_pdu(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len) override;
 
-  FILE*       pcap_file = nullptr;
-  uint32_t    dlt       = 0; // The DLT used for the PCAP file
-  std::string filename;
+  pcap_block_writer writer;
+  uint32_t          dlt = 0; // The DLT used for the PCAP file
+  std::string       filename;
 };
 } // namespace srsran
 
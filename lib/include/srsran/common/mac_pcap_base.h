@@ -108,6 +108,10 @@ protected:
   virtual void write_pdu(pcap_pdu_t& pdu) = 0;
   void         run_thread() final;
 
+  /// Hands over a PDU, whose context is already filled, to the writer. Called from the PHY worker context.
+  /// By default, the payload is copied to a byte buffer that is queued for the writer thread
+  virtual void push_pdu(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len);
+
   std::mutex                              mutex;
   srslog::basic_logger&                   logger;
   std::atomic<bool>                       running = {false};
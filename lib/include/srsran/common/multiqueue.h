@@ -30,21 +30,26 @@
 
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/move_callback.h"
+#include "srsran/common/lockfree_queue.h"
 #include <algorithm>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <queue>
+#include <thread>
 #include <vector>
 
 namespace srsran {
 
 #define MULTIQUEUE_DEFAULT_CAPACITY (8192) // Default per-queue capacity
+#define MULTIQUEUE_INIT_TABLE_SIZE (16)    // Initial size of the table of queues seen by the consumer, it grows on demand
 
 /**
  * N-to-1 Message-Passing Broker that manages the creation, destruction of input ports, and popping of messages that
  * are pushed to these ports.
- * Each port provides a thread-safe push(...) / try_push(...) interface to enqueue messages
+ * Each port provides a thread-safe push(...) / try_push(...) interface to enqueue messages. Ports are lock-free
+ * MPSC ring queues, and the consumer sleeps on a futex when all of them are empty.
  * The class will pop from the several created ports in a round-robin fashion.
  * The popping() interface is not safe-thread. That means, that it is expected that only one thread will
  * be popping tasks.
@@ -63,31 +68,20 @@ class multiqueue_handler
     input_port_impl& operator=(input_port_impl&&) = delete;
     ~input_port_impl() { deactivate_blocking(); }
 
-    size_t capacity() const { return buffer.max_size(); }
-    size_t size() const
+    size_t capacity() const { return buffer.capacity(); }
+    size_t size() const { return buffer.size(); }
+    bool   empty() const { return buffer.empty(); }
+    bool   active() const { return active_.load(std::memory_order_acquire); }
+    void   set_active(bool val)
     {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return buffer.size();
-    }
-    bool active() const
-    {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return active_;
-    }
-    void set_active(bool val)
-    {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (val == active_) {
-        // no-op
-        return;
-      }
-      active_ = val;
-
-      if (not active_) {
+      if (val) {
+        // drop messages that raced with the last deactivation
         buffer.clear();
-        lock.unlock();
+      }
+      active_.store(val, std::memory_order_seq_cst);
+      if (not val) {
         // unlock blocked pushing threads
-        cv_full.notify_all();
+        not_full.notify_all();
       }
     }
 
@@ -95,24 +89,29 @@ class multiqueue_handler
     {
       set_active(false);
 
-      // wait for all the pushers to unlock
-      std::unique_lock<std::mutex> lock(q_mutex);
-      while (nof_waiting > 0) {
-        cv_exit.wait(lock);
+      // wait for all the pushers to leave, so that no message is pushed after the queue is cleared
+      while (nof_pushing.load(std::memory_order_seq_cst) > 0) {
+        std::this_thread::yield();
       }
+      buffer.clear();
     }
 
     template <typename T>
     void push(T&& o) noexcept
     {
-      push_(&o, true);
+      myobj obj(std::forward<T>(o));
+      push_(obj, true);
     }
 
-    bool try_push(const myobj& o) { return push_(&o, false); }
+    bool try_push(const myobj& o)
+    {
+      myobj obj(o);
+      return push_(obj, false);
+    }
 
     srsran::error_type<myobj> try_push(myobj&& o)
     {
-      if (push_(&o, false)) {
+      if (push_(o, false)) {
         return {};
       }
       return {std::move(o)};
@@ -120,65 +119,48 @@ class multiqueue_handler
 
     bool try_pop(myobj& obj)
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      return pop_(lock, obj);
-    }
-
-    bool try_pop(myobj& obj, bool& try_lock_success)
-    {
-      std::unique_lock<std::mutex> lock(q_mutex, std::try_to_lock);
-      try_lock_success = lock.owns_lock();
-      return try_lock_success ? pop_(lock, obj) : false;
+      if (not buffer.try_pop(obj)) {
+        return false;
+      }
+      not_full.notify_all();
+      return true;
     }
 
   private:
-    template <typename T>
-    bool push_(T* o, bool blocking) noexcept
+    /// Moves o into the queue. On failure, o is left with its original value
+    bool push_(myobj& o, bool blocking) noexcept
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (not blocking) {
-        // non-blocking case
-        if (not active_ or buffer.full()) {
-          return false;
+      nof_pushing.fetch_add(1, std::memory_order_seq_cst);
+      bool ret = false;
+      while (active_.load(std::memory_order_seq_cst)) {
+        srsran::error_type<myobj> res = buffer.try_push(std::move(o));
+        if (res.has_value()) {
+          ret = true;
+          break;
         }
-      } else {
-        // blocking case
-        while (active_ and buffer.full()) {
-          nof_waiting++;
-          cv_full.wait(lock);
-          nof_waiting--;
+        o = std::move(res.error());
+        if (not blocking) {
+          break;
         }
-        if (not active_) {
-          lock.unlock();
-          cv_exit.notify_one();
-          return false;
+        uint32_t ticket = not_full.prepare_wait();
+        if (not buffer.full() or not active_.load(std::memory_order_seq_cst)) {
+          not_full.cancel_wait();
+          continue;
         }
+        not_full.wait(ticket);
       }
-      buffer.push(std::forward<T>(*o));
-      return true;
-    }
-
-    bool pop_(std::unique_lock<std::mutex>& lock, myobj& obj)
-    {
-      if (buffer.empty()) {
-        return false;
+      nof_pushing.fetch_sub(1, std::memory_order_seq_cst);
+      if (ret) {
+        parent->not_empty.notify_all();
       }
-      obj = std::move(buffer.top());
-      buffer.pop();
-      if (nof_waiting > 0) {
-        lock.unlock();
-        cv_full.notify_one();
-      }
-      return true;
+      return ret;
     }
 
+    srsran::mpsc_queue<myobj>  buffer;
     multiqueue_handler<myobj>* parent = nullptr;
-
-    mutable std::mutex                 q_mutex;
-    srsran::dyn_circular_buffer<myobj> buffer;
-    std::condition_variable            cv_full, cv_exit;
-    bool                               active_     = true;
-    int                                nof_waiting = 0;
+    detail::futex_event        not_full;
+    std::atomic<bool>          active_     = {true};
+    std::atomic<int>           nof_pushing = {0};
   };
 
 public:
@@ -204,7 +186,7 @@ public:
     size_t size() { return impl->size(); }
     size_t capacity() { return impl->capacity(); }
     bool   active() const { return impl != nullptr and impl->active(); }
-    bool   empty() const { return impl->size() == 0; }
+    bool   empty() const { return impl->empty(); }
 
     bool operator==(const queue_handle& other) const { return impl == other.impl; }
     bool operator!=(const queue_handle& other) const { return impl != other.impl; }
@@ -223,19 +205,29 @@ public:
 
   explicit multiqueue_handler(uint32_t default_capacity_ = MULTIQUEUE_DEFAULT_CAPACITY) :
     default_capacity(default_capacity_)
-  {}
+  {
+    tables.emplace_back(new port_table(MULTIQUEUE_INIT_TABLE_SIZE));
+    table.store(tables.back().get(), std::memory_order_relaxed);
+  }
   ~multiqueue_handler() { stop(); }
 
   void stop()
   {
-    std::unique_lock<std::mutex> lock(mutex);
-    running = false;
+    std::lock_guard<std::mutex> lock(mutex);
+    running.store(false, std::memory_order_seq_cst);
     for (auto& q : queues) {
       // signal deactivation to pushing threads in a non-blocking way
       q.set_active(false);
     }
-    while (consumer_state) {
-      cv_exit.wait(lock);
+    // unlock the consumer and wait for it to leave
+    not_empty.notify_all();
+    for (;;) {
+      uint32_t ticket = consumer_left.prepare_wait();
+      if (not consumer_state.load(std::memory_order_seq_cst)) {
+        consumer_left.cancel_wait();
+        break;
+      }
+      consumer_left.wait(ticket);
     }
     for (auto& q : queues) {
       // ensure the queues are finished being deactivated
@@ -261,9 +253,20 @@ public:
 
     // check if there is a free queue of the required size
     if (qidx == queues.size()) {
-      // create new queue
+      // create new queue. The deque keeps the existing queues in place, so the consumer can keep popping from them
       queues.emplace_back(capacity_, this);
       qidx = queues.size() - 1; // update qidx to the last element
+
+      // a full table is replaced by a copy twice its size. The old table is kept, as the consumer may still read it
+      port_table* t = table.load(std::memory_order_relaxed);
+      if (qidx == t->size()) {
+        tables.emplace_back(new port_table(*t));
+        t = tables.back().get();
+        t->resize(2 * qidx);
+        table.store(t, std::memory_order_release);
+      }
+      (*t)[qidx] = &queues[qidx];
+      nof_queues_.store(queues.size(), std::memory_order_release);
     } else {
       queues[qidx].set_active(true);
     }
@@ -288,58 +291,74 @@ public:
 
   bool wait_pop(myobj* value)
   {
-    std::unique_lock<std::mutex> lock(mutex);
-    consumer_state = true;
-    while (running) {
+    bool ret = false;
+    consumer_state.store(true, std::memory_order_seq_cst);
+    while (running.load(std::memory_order_seq_cst)) {
       if (round_robin_pop_(value)) {
-        consumer_state = false;
-        return true;
+        ret = true;
+        break;
+      }
+      uint32_t ticket = not_empty.prepare_wait();
+      if (not all_empty_() or not running.load(std::memory_order_seq_cst)) {
+        not_empty.cancel_wait();
+        continue;
       }
-      lock.unlock();
-      std::this_thread::sleep_for(std::chrono::microseconds(100));
-      lock.lock();
+      not_empty.wait(ticket);
     }
-    consumer_state = false;
-    lock.unlock();
-    cv_exit.notify_one();
-    return false;
+    consumer_state.store(false, std::memory_order_seq_cst);
+    if (not running.load(std::memory_order_seq_cst)) {
+      // wake up stop(), which waits for the consumer to leave
+      consumer_left.notify_all();
+    }
+    return ret;
   }
 
-  bool try_pop(myobj* value)
-  {
-    std::unique_lock<std::mutex> lock(mutex);
-    return running and round_robin_pop_(value);
-  }
+  bool try_pop(myobj* value) { return running.load(std::memory_order_relaxed) and round_robin_pop_(value); }
 
 private:
   bool round_robin_pop_(myobj* value)
   {
     // Round-robin for all queues
-    auto     q_it  = queues.begin() + spin_idx;
-    uint32_t count = 0;
-    for (; count < queues.size(); ++count, ++q_it) {
-      if (q_it == queues.end()) {
-        q_it = queues.begin(); // wrap-around
-      }
-      bool try_lock_success = true;
-      if (q_it->try_pop(*value, try_lock_success)) {
-        spin_idx = (spin_idx + count + 1) % queues.size();
+    uint32_t nof_q = nof_queues_.load(std::memory_order_acquire);
+    if (nof_q == 0) {
+      return false;
+    }
+    const port_table& ptrs = *table.load(std::memory_order_acquire);
+    uint32_t          qidx = spin_idx % nof_q;
+    for (uint32_t count = 0; count < nof_q; ++count, qidx = (qidx + 1) % nof_q) {
+      if (ptrs[qidx]->active() and ptrs[qidx]->try_pop(*value)) {
+        spin_idx = qidx + 1;
         return true;
       }
-      if (not try_lock_success) {
-        // restart RR search, as there was a collision with a producer
-        count = 0;
-      }
     }
     return false;
   }
 
-  mutable std::mutex          mutex;
-  std::condition_variable     cv_exit;
-  uint32_t                    spin_idx = 0;
-  bool                        running = true, consumer_state = false;
-  std::deque<input_port_impl> queues;
-  uint32_t                    default_capacity = 0;
+  bool all_empty_() const
+  {
+    uint32_t          nof_q = nof_queues_.load(std::memory_order_acquire);
+    const port_table& ptrs  = *table.load(std::memory_order_acquire);
+    for (uint32_t qidx = 0; qidx < nof_q; ++qidx) {
+      if (not ptrs[qidx]->empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Pointers to the queues, read by the consumer without taking the mutex
+  using port_table = std::vector<input_port_impl*>;
+
+  mutable std::mutex                       mutex;
+  uint32_t                                 spin_idx = 0;
+  std::atomic<bool>                        running = {true}, consumer_state = {false};
+  std::deque<input_port_impl>              queues;
+  std::vector<std::unique_ptr<port_table>> tables; ///< Every table ever published, the last one is the current one
+  std::atomic<port_table*>                 table       = {nullptr};
+  std::atomic<uint32_t>                    nof_queues_ = {0};
+  detail::futex_event                      not_empty;
+  detail::futex_event                      consumer_left;
+  uint32_t                                 default_capacity = 0;
 };
 
 template <typename T>
@@ -24,6 +24,7 @@
 
 #include "srsran/common/common.h"
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_block_writer.h"
 #include <string>
 
 namespace srsran {
@@ -34,17 +35,22 @@ public:
   nas_pcap();
   ~nas_pcap();
   void     enable();
-  uint32_t open(std::string filename_, uint32_t ue_id = 0, srsran_rat_t rat_type = srsran_rat_t::lte);
+  uint32_t open(std::string               filename_,
+                uint32_t                  ue_id       = 0,
+                srsran_rat_t              rat_type    = srsran_rat_t::lte,
+                const pcap_writer_args_t& writer_args = {});
   void     close();
   void     write_nas(uint8_t* pdu, uint32_t pdu_len_bytes);
 
+  pcap_writer_metrics_t get_metrics() const { return writer.get_metrics(); }
+
 private:
-  bool        enable_write = false;
-  std::string filename;
-  FILE*       pcap_file            = nullptr;
-  uint32_t    ue_id                = 0;
-  int         emergency_handler_id = -1;
-  void        pack_and_write(uint8_t* pdu, uint32_t pdu_len_bytes);
+  bool              enable_write = false;
+  std::string       filename;
+  pcap_block_writer writer;
+  uint32_t          ue_id                = 0;
+  int               emergency_handler_id = -1;
+  void              pack_and_write(uint8_t* pdu, uint32_t pdu_len_bytes);
 };
 
 } // namespace srsran
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RX_SOCKET_HANDLER_H
 #define SRSRAN_RX_SOCKET_HANDLER_H
 
+#include "srsran/adt/span.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/multiqueue.h"
 #include "srsran/common/threads.h"
@@ -132,16 +133,17 @@ protected:
 };
 
 /**
- * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via a select
+ * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via epoll
  *               The user can register their own (socket fd, data handler) in this class via the
- *               add_socket_handler(fd, task) API or its other variants
+ *               add_socket_handler(fd, task) API or its other variants. Several instances can be used to
+ *               spread the reception of sockets bound to the same port with SO_REUSEPORT over multiple threads.
  */
 class socket_manager final : public thread, public socket_manager_itf
 {
   using recv_callback_t = socket_manager_itf::recv_callback_t;
 
 public:
-  socket_manager();
+  explicit socket_manager(const std::string& thread_name = "RXsockets");
   ~socket_manager() final;
 
   void stop();
@@ -154,21 +156,26 @@ public:
 private:
   const int thread_prio = 65;
 
-  // used to unlock select
+  // maximum number of ready fds handled per epoll_wait call
+  static const int max_events = 32;
+
+  // used to unlock epoll_wait
   struct ctrl_cmd_t {
-    enum class cmd_id_t { EXIT, NEW_FD, RM_FD };
+    enum class cmd_id_t { EXIT, RM_FD };
     cmd_id_t cmd;
     int      new_fd;
     bool     signal_rm_complete;
     ctrl_cmd_t() { bzero(this, sizeof(ctrl_cmd_t)); }
   };
-  std::map<int, recv_callback_t>::iterator remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd);
+  std::map<int, recv_callback_t>::iterator remove_socket_unprotected(int fd);
+  bool                                     handle_ctrl_cmd();
 
   // state
   std::mutex                     socket_mutex;
   std::map<int, recv_callback_t> active_sockets;
   std::atomic<bool>              running   = {false};
   int                            pipefd[2] = {-1, -1};
+  int                            epfd      = -1;
   std::vector<int>               rem_fd_tmp_list;
   std::condition_variable        rem_cvar;
 };
@@ -180,6 +187,18 @@ using sctp_recv_callback_t =
 /// Function signature for SDU byte buffers received from any sockaddr_in-based socket
 using recvfrom_callback_t = srsran::move_callback<void(srsran::unique_byte_buffer_t, const sockaddr_in&)>;
 
+/// Datagram received from a sockaddr_in-based socket, as part of a burst
+struct rx_datagram_t {
+  srsran::unique_byte_buffer_t pdu;
+  sockaddr_in                  from;
+};
+
+/// Function signature for bursts of SDU byte buffers received from any sockaddr_in-based socket
+using recvfrom_burst_callback_t = srsran::move_callback<void(srsran::span<rx_datagram_t>)>;
+
+/// Maximum number of datagrams read from a socket with a single recvmmsg call
+constexpr uint32_t max_rx_burst_size = 32;
+
 /**
  * Helper function that creates a callback that is called when a SCTP socket has data, and does the following tasks:
  * 1. receive SDU byte buffer from SCTP socket and associated metadata - sockaddr_in, sctp_sndrcvinfo, flags
@@ -195,11 +214,19 @@ socket_manager_itf::recv_callback_t
 make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, sctp_recv_callback_t rx_callback);
 
 /**
- * Similar to make_sctp_sdu_handler, but for any sockaddr_in-based socket type
+ * Similar to make_sctp_sdu_handler, but for any sockaddr_in-based datagram socket type. The socket is drained with
+ * recvmmsg, up to max_rx_burst_size datagrams at a time, and each burst is dispatched to the queue as a single task
  */
 socket_manager_itf::recv_callback_t
 make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback);
 
+/**
+ * Similar to make_sdu_handler, but the rx_callback is called once per burst of received datagrams
+ */
+socket_manager_itf::recv_callback_t make_sdu_burst_handler(srslog::basic_logger&      logger,
+                                                           srsran::task_queue_handle& queue,
+                                                           recvfrom_burst_callback_t  rx_callback);
+
 inline socket_manager& get_rx_io_manager()
 {
   static socket_manager io;
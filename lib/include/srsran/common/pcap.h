@@ -211,12 +211,24 @@ int LTE_PCAP_MAC_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned
 int LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned char* PDU, unsigned int length);
 int LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(MAC_Context_Info_t* context, uint8_t* PDU, unsigned int length);
 
+/* Pack the headers preceding a MAC PDU (UDP header + mac-context), returns the header length */
+int LTE_PCAP_MAC_UDP_PACK_HEADER(MAC_Context_Info_t* context,
+                                 unsigned int        pdu_length,
+                                 uint8_t*            buffer,
+                                 unsigned int        length);
+
 /* Write an individual NAS PDU (PCAP packet header + nas-context + nas-pdu) */
 int LTE_PCAP_NAS_WritePDU(FILE* fd, NAS_Context_Info_t* context, const unsigned char* PDU, unsigned int length);
 
 /* Write an individual RLC PDU (PCAP packet header + UDP header + rlc-context + rlc-pdu) */
 int LTE_PCAP_RLC_WritePDU(FILE* fd, RLC_Context_Info_t* context, const unsigned char* PDU, unsigned int length);
 
+/* Pack the headers preceding a RLC PDU (UDP header + rlc-context), returns the header length */
+int LTE_PCAP_RLC_PACK_HEADER(RLC_Context_Info_t* context,
+                             unsigned int        pdu_length,
+                             uint8_t*            buffer,
+                             unsigned int        length);
+
 /* Write an individual S1AP PDU (PCAP packet header + s1ap-context + s1ap-pdu) */
 int LTE_PCAP_S1AP_WritePDU(FILE* fd, S1AP_Context_Info_t* context, const unsigned char* PDU, unsigned int length);
 
@@ -227,6 +239,12 @@ int LTE_PCAP_NGAP_WritePDU(FILE* fd, NGAP_Context_Info_t* context, const unsigne
 int NR_PCAP_MAC_UDP_WritePDU(FILE* fd, mac_nr_context_info_t* context, const unsigned char* PDU, unsigned int length);
 int NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(mac_nr_context_info_t* context, uint8_t* buffer, unsigned int length);
 
+/* Pack the headers preceding a NR MAC PDU (UDP header + nr-mac-context), returns the header length */
+int NR_PCAP_MAC_UDP_PACK_HEADER(mac_nr_context_info_t* context,
+                                unsigned int           pdu_length,
+                                uint8_t*               buffer,
+                                unsigned int           length);
+
 #ifdef __cplusplus
 }
 #endif
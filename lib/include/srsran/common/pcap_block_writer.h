@@ -0,0 +1,151 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PCAP_BLOCK_WRITER_H
+#define SRSRAN_PCAP_BLOCK_WRITER_H
+
+#include "srsran/common/threads.h"
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/uio.h>
+#include <vector>
+
+namespace srsran {
+
+enum class pcap_format_t { pcap, pcapng };
+
+struct pcap_writer_args_t {
+  pcap_format_t format            = pcap_format_t::pcap;
+  uint32_t      block_size        = 128 * 1024; ///< Size of each pre-allocated write block in bytes
+  uint32_t      nof_blocks        = 8;          ///< Number of pre-allocated write blocks
+  uint64_t      max_file_size     = 0;          ///< Start a new file once this size in bytes is reached (0 disables)
+  uint32_t      rotation_period_s = 0;          ///< Start a new file once it is older than this period (0 disables)
+  uint32_t      flush_period_ms   = 100;        ///< Maximum time a partially filled block waits to be written
+};
+
+struct pcap_writer_metrics_t {
+  uint64_t nof_pdus         = 0; ///< Records serialized into the write blocks
+  uint64_t nof_bytes        = 0; ///< Captured bytes of the serialized records
+  uint64_t nof_dropped      = 0; ///< Records dropped because no write block was available
+  uint64_t nof_write_errors = 0; ///< Write blocks lost due to I/O errors
+  uint32_t nof_files        = 0; ///< Files opened so far, including the rotated ones
+};
+
+/**
+ * Asynchronous PCAP/PCAPNG file writer. Records are serialized by the calling threads directly into a ring of
+ * pre-allocated write blocks, without intermediate PDU copies, and the dedicated writer thread writes the filled blocks
+ * to the file with a single vectored write per batch.
+ * The calling threads never take a lock nor wait for I/O: each one reserves the space of its record in the current
+ * block with a compare-and-swap and serializes it concurrently with the others. The thread whose record does not fit
+ * seals the block and moves the ring on to the next one. If all write blocks are in use, the record is dropped and
+ * accounted for in the metrics.
+ * Partially filled blocks are written after flush_period_ms, and the files are optionally rotated by size or by age.
+ * Rotation happens at block boundaries, so a record is never split between two files.
+ */
+class pcap_block_writer : protected srsran::thread
+{
+public:
+  explicit pcap_block_writer(srslog::basic_logger& logger_);
+  pcap_block_writer(const pcap_block_writer&) = delete;
+  pcap_block_writer& operator=(const pcap_block_writer&) = delete;
+  ~pcap_block_writer();
+
+  /// Opens the first file, writes its header with the given DLT and starts the writer thread
+  bool open(const std::string& filename_, uint32_t dlt_, const pcap_writer_args_t& args_ = {});
+  /// Writes the pending records and closes the current file
+  void close();
+  bool is_open() const { return running.load(std::memory_order_relaxed); }
+
+  /**
+   * Serializes one record, made of a (possibly empty) context header followed by the PDU. Thread-safe.
+   * @return false if the writer is closed or the record had to be dropped
+   */
+  bool write_record(const uint8_t* header, uint32_t header_len, const uint8_t* pdu, uint32_t pdu_len);
+
+  pcap_writer_metrics_t get_metrics() const;
+
+  /// Name of the file a given rotation index is written to
+  std::string get_filename(uint32_t idx) const;
+
+private:
+  static const uint32_t snaplen = 65535;
+
+  /// Flag of the block state set once the block accepts no more records
+  static const uint32_t sealed_flag = 1U << 31U;
+
+  struct write_block {
+    std::unique_ptr<uint8_t[]> data;
+    /// Ring sequence number the block is serving (upper 32 bits), sealed flag and reserved bytes (lower 32 bits)
+    std::atomic<uint64_t> state{0};
+    /// Bytes of the reserved records that have been serialized already
+    std::atomic<uint32_t> committed{0};
+    /// Bytes to write, only accessed by the writer thread
+    uint32_t len = 0;
+  };
+
+  void         run_thread() override;
+  write_block* alloc_record(uint32_t record_len, uint8_t*& ptr);
+  bool         seal_block(uint32_t seq, uint64_t state);
+  void         seal_current_block();
+  bool         open_file(uint32_t idx);
+  bool         rotation_due(uint32_t next_block_len) const;
+  void         write_blocks(const std::vector<uint32_t>& block_idxs);
+  bool         write_iov(struct iovec* iov, int iovcnt);
+
+  srslog::basic_logger& logger;
+  pcap_writer_args_t    args;
+  std::string           filename;
+  uint32_t              dlt = 0;
+  std::atomic<bool>     running{false};
+
+  // Ring of write blocks, shared between the producers and the writer thread
+  std::unique_ptr<write_block[]> blocks;
+  std::atomic<uint32_t>          head{0};          ///< Sequence number of the block records are serialized into
+  std::atomic<uint32_t>          nof_producers{0}; ///< Calls to write_record() in progress
+
+  // Metrics, updated without synchronization between the counters
+  std::atomic<uint64_t> nof_pdus{0};
+  std::atomic<uint64_t> nof_bytes{0};
+  std::atomic<uint64_t> nof_dropped{0};
+  std::atomic<uint64_t> nof_write_errors{0};
+  std::atomic<uint32_t> nof_files{0};
+
+  // Wake-up of the writer thread, the producers only notify it when they seal a block
+  std::mutex              mutex;
+  std::condition_variable cvar;
+
+  // Writer thread state
+  uint32_t                              tail      = 0; ///< Sequence number of the next block to write
+  int                                   fd        = -1;
+  uint32_t                              file_idx  = 0;
+  uint64_t                              file_size = 0;
+  std::chrono::steady_clock::time_point file_start;
+  uint64_t                              last_nof_dropped = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PCAP_BLOCK_WRITER_H
@@ -0,0 +1,184 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         rcu.h
+ *  Description:  Read-copy-update style deferred reclamation. Readers enter
+ *                read-side sections without ever blocking, while writers
+ *                unpublish objects and retire them. Retired objects are only
+ *                deleted once all the read-side sections that could still
+ *                reference them have finished (grace period).
+ *****************************************************************************/
+
+#ifndef SRSRAN_RCU_H
+#define SRSRAN_RCU_H
+
+#include "srsran/adt/move_callback.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * RCU domain based on two reader counters, one per epoch parity. Readers increment the counter of the current epoch
+ * on entry and decrement it on exit. A grace period flips the epoch and waits for the counters of the previous epoch to
+ * drain, which only involves readers that were already inside a read-side section when the flip happened.
+ * To avoid all reader threads bouncing the same cache line, the counters are spread over several reader slots, and
+ * each thread always uses the same slot.
+ */
+class rcu_domain
+{
+public:
+  rcu_domain()                  = default;
+  rcu_domain(const rcu_domain&) = delete;
+  rcu_domain& operator=(const rcu_domain&) = delete;
+  ~rcu_domain() { synchronize(); }
+
+  /// Enters a read-side section. Never blocks. Returns the token that must be passed to read_unlock()
+  uint32_t read_lock()
+  {
+    uint32_t     slot_idx = this_thread_slot();
+    reader_slot& slot     = slots[slot_idx];
+    while (true) {
+      uint32_t parity = epoch.load(std::memory_order_relaxed) & 1U;
+      slot.count[parity].fetch_add(1, std::memory_order_seq_cst);
+      // If a grace period started meanwhile, it may have missed this reader. Retry with the new epoch
+      if ((epoch.load(std::memory_order_seq_cst) & 1U) == parity) {
+        return (slot_idx << 1U) | parity;
+      }
+      slot.count[parity].fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  /// Leaves the read-side section entered with the given token
+  void read_unlock(uint32_t token) { slots[token >> 1U].count[token & 1U].fetch_sub(1, std::memory_order_release); }
+
+  /// Defers the call of the deleter until all the ongoing read-side sections have finished. The object must already
+  /// be unreachable by new readers
+  void retire(move_callback<void()> deleter)
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    waiting.push_back(std::move(deleter));
+  }
+
+  /**
+   * Advances the grace periods without blocking, and calls the deleters of the retired objects whose grace period
+   * has elapsed. Meant to be called periodically by the writer.
+   * @return number of retired objects still waiting for their grace period
+   */
+  size_t reclaim()
+  {
+    std::vector<move_callback<void()> > expired;
+    size_t                              nof_pending;
+    {
+      std::lock_guard<std::mutex> lock(writer_mutex);
+      for (uint32_t i = 0; i < 2; ++i) {
+        if (gp_ongoing) {
+          if (nof_readers(prev_parity) > 0) {
+            break;
+          }
+          gp_ongoing = false;
+          expired.insert(expired.end(),
+                         std::make_move_iterator(in_grace.begin()),
+                         std::make_move_iterator(in_grace.end()));
+          in_grace.clear();
+        }
+        if (waiting.empty()) {
+          break;
+        }
+        // Start a new grace period for the objects retired so far
+        in_grace.swap(waiting);
+        prev_parity = epoch.fetch_add(1, std::memory_order_seq_cst) & 1U;
+        gp_ongoing  = true;
+      }
+      nof_pending = waiting.size() + in_grace.size();
+    }
+    for (auto& deleter : expired) {
+      deleter();
+    }
+    return nof_pending;
+  }
+
+  /// Blocks until the ongoing read-side sections have finished and all the objects retired so far have been deleted
+  void synchronize()
+  {
+    // An empty object forces a full grace period, even if nothing else was retired
+    retire([]() {});
+    while (reclaim() > 0) {
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  static constexpr uint32_t nof_reader_slots = 16;
+
+  struct alignas(64) reader_slot {
+    std::array<std::atomic<uint32_t>, 2> count = {};
+  };
+
+  static uint32_t this_thread_slot()
+  {
+    static std::atomic<uint32_t> next_slot{0};
+    static thread_local uint32_t slot = next_slot.fetch_add(1, std::memory_order_relaxed) % nof_reader_slots;
+    return slot;
+  }
+
+  uint32_t nof_readers(uint32_t parity) const
+  {
+    uint32_t count = 0;
+    for (const reader_slot& slot : slots) {
+      count += slot.count[parity].load(std::memory_order_seq_cst);
+    }
+    return count;
+  }
+
+  std::array<reader_slot, nof_reader_slots> slots;
+  std::atomic<uint32_t>                     epoch{0};
+
+  // writer-side state
+  std::mutex                          writer_mutex;
+  bool                                gp_ongoing  = false;
+  uint32_t                            prev_parity = 0;
+  std::vector<move_callback<void()> > waiting, in_grace;
+};
+
+/// Scoped read-side section of a RCU domain
+class rcu_read_guard
+{
+public:
+  explicit rcu_read_guard(rcu_domain& rcu_) : rcu(&rcu_), token(rcu_.read_lock()) {}
+  rcu_read_guard(const rcu_read_guard&) = delete;
+  rcu_read_guard(rcu_read_guard&&)      = delete;
+  rcu_read_guard& operator=(const rcu_read_guard&) = delete;
+  rcu_read_guard& operator=(rcu_read_guard&&) = delete;
+  ~rcu_read_guard() { rcu->read_unlock(token); }
+
+private:
+  rcu_domain* rcu;
+  uint32_t    token;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_RCU_H
@@ -23,6 +23,7 @@
 #define RLCPCAP_H
 
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_block_writer.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 #include <stdint.h>
 
@@ -31,31 +32,33 @@ namespace srsran {
 class rlc_pcap
 {
 public:
-  rlc_pcap() {}
+  rlc_pcap() : writer(srslog::fetch_basic_logger("RLC")) {}
   void enable(bool en);
-  void open(const char* filename, const rlc_config_t& config);
+  void open(const char* filename, const rlc_config_t& config, const pcap_writer_args_t& writer_args = {});
   void close();
 
+  pcap_writer_metrics_t get_metrics() const { return writer.get_metrics(); }
+
   void set_ue_id(uint16_t ue_id);
 
   void write_dl_ccch(uint8_t* pdu, uint32_t pdu_len_bytes);
   void write_ul_ccch(uint8_t* pdu, uint32_t pdu_len_bytes);
 
 private:
-  bool     enable_write = false;
-  FILE*    pcap_file    = nullptr;
-  uint32_t ue_id        = 0;
-  uint8_t  mode         = 0;
-  uint8_t  sn_length    = 0;
-  void     pack_and_write(uint8_t* pdu,
-                          uint32_t pdu_len_bytes,
-                          uint8_t  mode,
-                          uint8_t  direction,
-                          uint8_t  priority,
-                          uint8_t  seqnumberlength,
-                          uint16_t ueid,
-                          uint16_t channel_type,
-                          uint16_t channel_id);
+  bool              enable_write = false;
+  pcap_block_writer writer;
+  uint32_t          ue_id     = 0;
+  uint8_t           mode      = 0;
+  uint8_t           sn_length = 0;
+  void              pack_and_write(uint8_t* pdu,
+                                   uint32_t pdu_len_bytes,
+                                   uint8_t  mode,
+                                   uint8_t  direction,
+                                   uint8_t  priority,
+                                   uint8_t  seqnumberlength,
+                                   uint16_t ueid,
+                                   uint16_t channel_type,
+                                   uint16_t channel_id);
 };
 
 } // namespace srsran
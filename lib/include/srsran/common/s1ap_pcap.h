@@ -23,6 +23,7 @@
 #define SRSRAN_S1AP_PCAP_H
 
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_block_writer.h"
 #include <string>
 
 namespace srsran {
@@ -38,15 +39,17 @@ public:
   s1ap_pcap& operator=(s1ap_pcap&& other) = delete;
 
   void enable();
-  void open(const char* filename_);
+  void open(const char* filename_, const pcap_writer_args_t& writer_args = {});
   void close();
   void write_s1ap(uint8_t* pdu, uint32_t pdu_len_bytes);
 
+  pcap_writer_metrics_t get_metrics() const { return writer.get_metrics(); }
+
 private:
-  bool        enable_write = false;
-  std::string filename;
-  FILE*       pcap_file            = nullptr;
-  int         emergency_handler_id = -1;
+  bool              enable_write = false;
+  std::string       filename;
+  pcap_block_writer writer;
+  int               emergency_handler_id = -1;
 };
 
 } // namespace srsran
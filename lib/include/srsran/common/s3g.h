@@ -72,6 +72,19 @@ void s3g_deinitialize(S3G_STATE* state);
 
 void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
 
+/* Multi-buffer generation of Keystream.
+ * Runs nof_lanes independent SNOW 3G instances, lane i being initialized
+ * with the key k[i] and the IV iv[i] (four 32-bit words each, as in
+ * s3g_initialize) and producing n[i] 32-bit words into ks[i]. The lanes are
+ * processed in parallel, as many at a time as the SIMD width allows.
+ */
+
+void s3g_mb_generate_keystream(uint32_t               nof_lanes,
+                               const uint32_t* const* k,
+                               const uint32_t* const* iv,
+                               const uint32_t*        n,
+                               uint32_t* const*       ks);
+
 /* f8.
  * Input key: 128 bit Confidentiality Key.
  * Input count:32-bit Count, Frame dependent input.
@@ -101,4 +114,15 @@ void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
 
 uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir, uint8_t* data, uint64_t length);
 
+/* f9 evaluation.
+ * Input z: the 5 keystream words z_1 to z_5 of the integrity key and IV.
+ * Input data: length number of bits, input bit stream.
+ * Input length: 64 bit Length, i.e., the number of bits to be MAC'd.
+ * Output mac: 32 bit block used as MAC.
+ * Second half of f9, for keystreams already generated, e.g. by
+ * s3g_mb_generate_keystream.
+ */
+
+void s3g_f9_eval(const uint32_t z[5], const uint8_t* data, uint64_t length, uint8_t mac[4]);
+
 #endif // SRSRAN_S3G_H
\ No newline at end of file
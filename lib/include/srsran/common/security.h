@@ -26,6 +26,7 @@
  * Common security header - wraps ciphering/integrity check algorithms.
  *****************************************************************************/
 
+#include "srsran/common/aes.h"
 #include "srsran/common/common.h"
 #include "srsran/srslog/srslog.h"
 
@@ -253,6 +254,24 @@ uint8_t security_generate_res_star(const uint8_t* ck,
                                    const uint8_t* res,
                                    const size_t   res_len,
                                    uint8_t*       res_star);
+/******************************************************************************
+ * AES based algorithms context
+ *
+ * Precomputed state of the EEA2/EIA2 (and NEA2/NIA2) algorithms for a given
+ * key: the AES key schedule and the CMAC subkeys. Computing it once per key,
+ * instead of once per message, removes the key setup cost from the per-PDU
+ * path.
+ *****************************************************************************/
+struct security_aes_ctx_t {
+  aes128_ctx aes;
+  uint8_t    k1[16] = {};
+  uint8_t    k2[16] = {};
+  bool       is_set = false;
+};
+
+/// Sets the 16-byte key of the context, computing the key schedule and the CMAC subkeys.
+void security_aes_ctx_set_key(security_aes_ctx_t& ctx, const uint8_t* key);
+
 /******************************************************************************
  * Integrity Protection
  *****************************************************************************/
@@ -272,6 +291,14 @@ uint8_t security_128_eia2(const uint8_t* key,
                           uint32_t       msg_len,
                           uint8_t*       mac);
 
+uint8_t security_128_eia2(const security_aes_ctx_t& ctx,
+                          uint32_t                  count,
+                          uint32_t                  bearer,
+                          uint8_t                   direction,
+                          const uint8_t*            msg,
+                          uint32_t                  msg_len,
+                          uint8_t*                  mac);
+
 uint8_t security_128_eia3(const uint8_t* key,
                           uint32_t       count,
                           uint32_t       bearer,
@@ -301,6 +328,14 @@ uint8_t security_128_eea2(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out);
 
+uint8_t security_128_eea2(const security_aes_ctx_t& ctx,
+                          uint32_t                  count,
+                          uint8_t                   bearer,
+                          uint8_t                   direction,
+                          const uint8_t*            msg,
+                          uint32_t                  msg_len,
+                          uint8_t*                  msg_out);
+
 uint8_t security_128_eea3(uint8_t* key,
                           uint32_t count,
                           uint8_t  bearer,
@@ -309,6 +344,29 @@ uint8_t security_128_eea3(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out);
 
+/******************************************************************************
+ * Batch processing
+ *
+ * Ciphers or integrity protects several PDUs using the same key, e.g. all the
+ * PDUs of a UE in a TTI, in a single call. The keystream generators of the
+ * SNOW 3G and ZUC based algorithms are run for several PDUs in parallel SIMD
+ * lanes.
+ *****************************************************************************/
+struct security_pdu_t {
+  uint32_t       count;
+  uint8_t        bearer;
+  uint8_t        direction;
+  const uint8_t* msg;
+  uint32_t       msg_len;
+  /// Ciphered (or deciphered) message of msg_len bytes, which may alias msg, or 4-byte MAC for integrity algorithms.
+  uint8_t* out;
+};
+
+uint8_t security_128_eia1_batch(const uint8_t* key, const security_pdu_t* pdus, uint32_t nof_pdus);
+uint8_t security_128_eia3_batch(const uint8_t* key, const security_pdu_t* pdus, uint32_t nof_pdus);
+uint8_t security_128_eea1_batch(const uint8_t* key, const security_pdu_t* pdus, uint32_t nof_pdus);
+uint8_t security_128_eea3_batch(const uint8_t* key, const security_pdu_t* pdus, uint32_t nof_pdus);
+
 /******************************************************************************
  * Authentication
  *****************************************************************************/
@@ -139,6 +139,7 @@ public:
   }
   void                      defer_task(srsran::move_task_t func) { sched->defer_task(std::move(func)); }
   srsran::task_queue_handle make_task_queue() { return sched->make_task_queue(); }
+  srsran::task_queue_handle make_task_queue(uint32_t qsize) { return sched->make_task_queue(qsize); }
 
 private:
   task_scheduler* sched;
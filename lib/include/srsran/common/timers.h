@@ -32,6 +32,7 @@
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/adt/move_callback.h"
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <deque>
 #include <inttypes.h>
@@ -49,27 +50,34 @@ public:
 /**
  * Class that manages stack timers. It allows creation of unique_timers with different ids. Each unique_timer duration,
  * and callback can be set via the set(...) method. A timer can be started/stopped via run()/stop() methods.
- * The timers access/alteration is thread-safe. Just beware non-atomic uses of its getters.
+ * The timers access/alteration is thread-safe. Just beware non-atomic uses of its getters. A handler that is only
+ * accessed from one thread (a per-thread timer domain) can be created with thread_safe=false, which skips the mutex.
  * Internal Data structures:
  * - timer_list - std::deque that stores timer objects via push_back() to keep pointer/reference validity.
  *   The timer index in the timer_list matches the timer object id field.
  *   This deque will only grow in size. Erased timers are just tagged in the deque as empty, and can be reused for the
  *   creation of new timers. To avoid unnecessary runtime allocations, the user can set an initial capacity.
  * - free_list - intrusive forward linked list to keep track of the empty timers and speed up new timer creation.
- * - A large circular vector of size WHEEL_SIZE which works as a time wheel, storing and circularly indexing the
- *   currently running timers by their respective timeout value.
- *   For a number of running timers N, and uniform distribution of timeout values, the step_all() complexity
- *   should be O(N/WHEEL_SIZE). Thus, the performance should improve with a larger WHEEL_SIZE, at the expense of more
- *   used memory.
+ * - A hierarchical time wheel with NOF_LEVELS levels. Level 0 has WHEEL_SIZE slots of one tic each, and each higher
+ *   level has LEVEL_SIZE slots covering a whole turn of the level below. Running timers are placed in the lowest level
+ *   that can hold their timeout. When level 0 completes a turn, the next slot of level 1 is cascaded down, and so on.
+ *   Each step_all() only visits the timers that expire in that tic (plus the amortized cascading), independently of
+ *   the total number of running timers, and the wheel needs NOF_SLOTS (1280) list heads instead of one per tic.
+ * - expiring_list - the level 0 slot of the current tic, detached as a whole to expire its timers in one batch.
  */
 class timer_handler
 {
   using tic_diff_t                      = uint32_t;
   using tic_t                           = uint32_t;
   constexpr static uint32_t INVALID_ID  = std::numeric_limits<uint32_t>::max();
-  constexpr static size_t   WHEEL_SHIFT = 16U;
+  constexpr static size_t   WHEEL_SHIFT = 10U;
   constexpr static size_t   WHEEL_SIZE  = 1U << WHEEL_SHIFT;
   constexpr static size_t   WHEEL_MASK  = WHEEL_SIZE - 1U;
+  constexpr static size_t   LEVEL_SHIFT = 6U;
+  constexpr static size_t   LEVEL_SIZE  = 1U << LEVEL_SHIFT;
+  constexpr static size_t   LEVEL_MASK  = LEVEL_SIZE - 1U;
+  constexpr static size_t   NOF_LEVELS  = 5U; ///< 10 + 4 * 6 bits cover the whole 32-bit timeout range
+  constexpr static size_t   NOF_SLOTS   = WHEEL_SIZE + (NOF_LEVELS - 1) * LEVEL_SIZE;
 
   constexpr static uint64_t   STOPPED_FLAG       = 0U;
   constexpr static uint64_t   RUNNING_FLAG       = static_cast<uint64_t>(1U) << 63U;
@@ -91,6 +99,7 @@ class timer_handler
     timer_handler& parent;
     // writes protected by backend lock
     bool                                  allocated = false;
+    uint16_t                              slot      = 0; ///< wheel slot where the timer is stored while running
     std::atomic<uint64_t>                 state{0}; ///< read can be without lock, thus writes must be atomic
     srsran::move_callback<void(uint32_t)> callback;
 
@@ -119,7 +128,7 @@ class timer_handler
                     "Invalid timer duration=%" PRIu32 ">%" PRIu32,
                     duration_,
                     MAX_TIMER_DURATION);
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      auto lock = parent.lock_();
       set_(duration_);
     }
 
@@ -129,27 +138,27 @@ class timer_handler
                     "Invalid timer duration=%" PRIu32 ">%" PRIu32,
                     duration_,
                     MAX_TIMER_DURATION);
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      auto lock = parent.lock_();
       set_(duration_);
       callback = std::move(callback_);
     }
 
     void run()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      auto lock = parent.lock_();
       parent.start_run_(*this);
     }
 
     void stop()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      auto lock = parent.lock_();
       // does not call callback
       parent.stop_timer_(*this, false);
     }
 
     void deallocate()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      auto lock = parent.lock_();
       parent.dealloc_timer_(*this);
     }
 
@@ -232,9 +241,8 @@ public:
     timer_impl* handle = nullptr;
   };
 
-  explicit timer_handler(uint32_t capacity = 64)
+  explicit timer_handler(uint32_t capacity = 64, bool thread_safe_ = true) : thread_safe(thread_safe_)
   {
-    time_wheel.resize(WHEEL_SIZE);
     // Pre-reserve timers
     while (timer_list.size() < capacity) {
       timer_list.emplace_back(*this, timer_list.size());
@@ -248,36 +256,51 @@ public:
 
   void step_all()
   {
-    std::unique_lock<std::mutex> lock(mutex);
+    std::unique_lock<std::mutex> lock = lock_();
     uint32_t                     cur_time_local = cur_time.load(std::memory_order_relaxed) + 1;
-    auto&                        wheel_list     = time_wheel[cur_time_local & WHEEL_MASK];
-
-    for (auto it = wheel_list.begin(); it != wheel_list.end();) {
-      timer_impl& timer = timer_list[it->id];
-      ++it;
-      if (decode_timeout(timer.state.load(std::memory_order_relaxed)) == cur_time_local) {
-        // stop timer (callback has to see the timer has already expired)
-        stop_timer_(timer, true);
-
-        // Call callback if configured
-        if (not timer.callback.is_empty()) {
-          // unlock mutex. It can happen that the callback tries to run a timer too
+
+    // When level 0 completes a turn, bring down the timers of the next slot of the upper levels
+    if ((cur_time_local & WHEEL_MASK) == 0) {
+      for (size_t level = 1; level < NOF_LEVELS; ++level) {
+        size_t idx = level_index(level, cur_time_local);
+        cascade_(level_slot(level, idx));
+        if (idx != 0) {
+          break;
+        }
+      }
+    }
+
+    // Detach all the timers that expire in this tic. Timers started from the callbacks are relative to the new tic
+    expiring_list = std::move(wheel[cur_time_local & WHEEL_MASK]);
+    cur_time.store(cur_time_local, std::memory_order_relaxed);
+
+    // Callbacks may stop or restart the timers that are still pending, which removes them from the expiring list
+    while (not expiring_list.empty()) {
+      timer_impl& timer = expiring_list.front();
+
+      // stop timer (callback has to see the timer has already expired)
+      stop_timer_(timer, true);
+
+      // Call callback if configured
+      if (not timer.callback.is_empty()) {
+        // unlock mutex. It can happen that the callback tries to run a timer too
+        if (thread_safe) {
           lock.unlock();
+        }
 
-          timer.callback(timer.id);
+        timer.callback(timer.id);
 
-          // Lock again to keep protecting the wheel
+        // Lock again to keep protecting the wheel
+        if (thread_safe) {
           lock.lock();
         }
       }
     }
-
-    cur_time.fetch_add(1, std::memory_order_relaxed);
   }
 
   void stop_all()
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    auto lock = lock_();
     // does not call callback
     for (timer_impl& timer : timer_list) {
       stop_timer_(timer, false);
@@ -288,13 +311,13 @@ public:
 
   uint32_t nof_timers() const
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    auto lock = lock_();
     return timer_list.size() - nof_free_timers;
   }
 
   uint32_t nof_running_timers() const
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    auto lock = lock_();
     return nof_timers_running_;
   }
 
@@ -317,10 +340,21 @@ public:
   static size_t get_wheel_size() { return WHEEL_SIZE; }
 
 private:
+  std::unique_lock<std::mutex> lock_() const
+  {
+    return thread_safe ? std::unique_lock<std::mutex>(mutex) : std::unique_lock<std::mutex>(mutex, std::defer_lock);
+  }
+
+  static size_t level_index(size_t level, tic_t timeout)
+  {
+    return (timeout >> (WHEEL_SHIFT + (level - 1) * LEVEL_SHIFT)) & LEVEL_MASK;
+  }
+  static size_t level_slot(size_t level, size_t idx) { return WHEEL_SIZE + (level - 1) * LEVEL_SIZE + idx; }
+
   timer_impl& alloc_timer()
   {
-    std::lock_guard<std::mutex> lock(mutex);
-    timer_impl*                 t;
+    auto        lock = lock_();
+    timer_impl* t;
     if (not free_list.empty()) {
       t = &free_list.front();
       srsran_assert(not t->allocated, "Invalid timer id=%d state", t->id);
@@ -350,29 +384,54 @@ private:
     // leave id unchanged.
   }
 
+  /// Places a timer in the lowest wheel level that covers its timeout, relative to the next tic
+  void insert_timer_(timer_impl& timer, tic_t timeout)
+  {
+    tic_diff_t delta = timeout - (cur_time.load(std::memory_order_relaxed) + 1);
+    size_t     slot  = timeout & WHEEL_MASK;
+    for (size_t level = 1; level < NOF_LEVELS; ++level) {
+      if (delta < (1U << (WHEEL_SHIFT + (level - 1) * LEVEL_SHIFT))) {
+        break;
+      }
+      slot = level_slot(level, level_index(level, timeout));
+    }
+    wheel[slot].push_front(&timer);
+    timer.slot = slot;
+  }
+
+  /// Returns the list a running timer is linked in. The timers that time out in the current tic are in expiring_list
+  intrusive_double_linked_list<timer_impl>& timer_list_of_(const timer_impl& timer)
+  {
+    tic_t timeout = decode_timeout(timer.state.load(std::memory_order_relaxed));
+    return timeout == cur_time.load(std::memory_order_relaxed) ? expiring_list : wheel[timer.slot];
+  }
+
+  /// Moves the timers of an upper level slot to the lower levels
+  void cascade_(size_t slot)
+  {
+    while (not wheel[slot].empty()) {
+      timer_impl& timer = wheel[slot].front();
+      wheel[slot].pop_front();
+      insert_timer_(timer, decode_timeout(timer.state.load(std::memory_order_relaxed)));
+    }
+  }
+
   void start_run_(timer_impl& timer, uint32_t duration_ = 0)
   {
     uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
     duration_                = duration_ == 0 ? decode_duration(timer_old_state) : duration_;
-    uint32_t new_timeout     = cur_time.load(std::memory_order_relaxed) + duration_;
-    size_t   new_wheel_pos   = new_timeout & WHEEL_MASK;
-
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    bool     was_running = decode_is_running(timer_old_state);
-    if (was_running and (old_timeout & WHEEL_MASK) == new_wheel_pos) {
-      // If no change in timer wheel position. Just update absolute timeout
-      timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
-      return;
-    }
+    // A timer that was never set expires in the next tic, as timeouts in the current tic are taken as already expiring
+    duration_            = std::max(duration_, 1U);
+    uint32_t new_timeout = cur_time.load(std::memory_order_relaxed) + duration_;
 
     // Stop timer if it was running, removing it from wheel in the process
-    if (was_running) {
-      time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
+    if (decode_is_running(timer_old_state)) {
+      timer_list_of_(timer).pop(&timer);
       nof_timers_running_--;
     }
 
     // Insert timer in wheel
-    time_wheel[new_wheel_pos].push_front(&timer);
+    insert_timer_(timer, new_timeout);
     timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
     nof_timers_running_++;
   }
@@ -386,21 +445,22 @@ private:
     }
 
     // If already running, need to disconnect it from previous wheel
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
-    uint64_t new_state =
-        encode_state(expiry ? EXPIRED_FLAG : STOPPED_FLAG, decode_duration(timer_old_state), old_timeout);
+    timer_list_of_(timer).pop(&timer);
+    uint64_t new_state = encode_state(
+        expiry ? EXPIRED_FLAG : STOPPED_FLAG, decode_duration(timer_old_state), decode_timeout(timer_old_state));
     timer.state.store(new_state, std::memory_order_relaxed);
     nof_timers_running_--;
   }
 
+  const bool         thread_safe;
   std::atomic<tic_t> cur_time{0};
   size_t             nof_timers_running_ = 0, nof_free_timers = 0;
   // using a deque to maintain reference validity on emplace_back. Also, this deque will only grow.
-  std::deque<timer_impl>                                         timer_list;
-  srsran::intrusive_forward_list<timer_impl>                     free_list;
-  std::vector<srsran::intrusive_double_linked_list<timer_impl> > time_wheel;
-  mutable std::mutex                                             mutex; // Protect priority queue
+  std::deque<timer_impl>                                                  timer_list;
+  srsran::intrusive_forward_list<timer_impl>                              free_list;
+  std::array<srsran::intrusive_double_linked_list<timer_impl>, NOF_SLOTS> wheel;
+  srsran::intrusive_double_linked_list<timer_impl>                        expiring_list;
+  mutable std::mutex                                                      mutex; // Protect wheel
 };
 
 using unique_timer = timer_handler::unique_timer;
@@ -22,6 +22,8 @@
 #ifndef SRSRAN_ZUC_H
 #define SRSRAN_ZUC_H
 
+#include <stdint.h>
+
 typedef unsigned char u8;
 typedef unsigned int  u32;
 
@@ -56,4 +58,16 @@ typedef struct {
 void zuc_initialize(zuc_state_t* state, const u8* k, u8* iv);
 void zuc_generate_keystream(zuc_state_t* state, int key_stream_len, u32* p_keystream);
 
+/* Multi-buffer keystream generation.
+ * Runs nof_lanes independent ZUC instances, lane i being initialized with the
+ * key k[i] and the IV iv[i] and producing key_stream_len[i] 32-bit words into
+ * p_keystream[i]. The lanes are processed in parallel, as many at a time as
+ * the SIMD width allows.
+ */
+void zuc_mb_generate_keystream(uint32_t         nof_lanes,
+                               const u8* const* k,
+                               const u8* const* iv,
+                               const uint32_t*  key_stream_len,
+                               u32* const*      p_keystream);
+
 #endif // SRSRAN_ZUC_H
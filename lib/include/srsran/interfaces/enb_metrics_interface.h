@@ -30,6 +30,7 @@
 #include "srsenb/hdr/stack/rrc/rrc_metrics.h"
 #include "srsenb/hdr/stack/s1ap/s1ap_metrics.h"
 #include "srsran/common/metrics_hub.h"
+#include "srsran/common/pcap_block_writer.h"
 #include "srsran/radio/radio_metrics.h"
 #include "srsran/rlc/rlc_metrics.h"
 #include "srsran/system/sys_metrics.h"
@@ -46,17 +47,24 @@ struct pdcp_metrics_t {
   std::vector<srsran::pdcp_metrics_t> ues;
 };
 
+struct pcap_metrics_t {
+  srsran::pcap_writer_metrics_t mac;
+  srsran::pcap_writer_metrics_t s1ap;
+};
+
 struct stack_metrics_t {
   mac_metrics_t  mac;
   rrc_metrics_t  rrc;
   rlc_metrics_t  rlc;
   pdcp_metrics_t pdcp;
   s1ap_metrics_t s1ap;
+  pcap_metrics_t pcap;
 };
 
 struct enb_metrics_t {
   srsran::rf_metrics_t       rf;
   std::vector<phy_metrics_t> phy;
+  phy_sched_metrics_t        phy_sched;
   stack_metrics_t            stack;
   stack_metrics_t            nr_stack;
   srsran::sys_metrics_t      sys;
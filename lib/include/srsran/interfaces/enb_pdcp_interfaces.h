@@ -22,6 +22,7 @@
 #include "srsran/common/byte_buffer.h"
 #include "srsran/interfaces/pdcp_interface_types.h"
 #include <map>
+#include <vector>
 
 #ifndef SRSRAN_ENB_PDCP_INTERFACES_H
 #define SRSRAN_ENB_PDCP_INTERFACES_H
@@ -34,6 +35,15 @@ class pdcp_interface_gtpu
 public:
   virtual void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn = -1) = 0;
   virtual std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) = 0;
+
+  /* Writes a burst of SDUs of the same bearer. The SDUs are consumed and the vector is left empty. */
+  virtual void write_sdu_batch(uint16_t rnti, uint32_t lcid, std::vector<srsran::unique_byte_buffer_t>& sdus)
+  {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(rnti, lcid, std::move(sdu));
+    }
+    sdus.clear();
+  }
 };
 
 // PDCP interface for RRC
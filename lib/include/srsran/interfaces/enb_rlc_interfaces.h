@@ -46,11 +46,12 @@ class rlc_interface_pdcp
 public:
   /* PDCP calls RLC to push an RLC SDU. SDU gets placed into the RLC buffer and MAC pulls
    * RLC PDUs according to TB size. */
-  virtual void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) = 0;
-  virtual void discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t sn)                    = 0;
-  virtual bool rb_is_um(uint16_t rnti, uint32_t lcid)                                    = 0;
-  virtual bool sdu_queue_is_full(uint16_t rnti, uint32_t lcid)                           = 0;
-  virtual bool is_suspended(uint16_t rnti, uint32_t lcid)                                = 0;
+  virtual void     write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) = 0;
+  virtual void     discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t sn)                    = 0;
+  virtual bool     rb_is_um(uint16_t rnti, uint32_t lcid)                                    = 0;
+  virtual bool     sdu_queue_is_full(uint16_t rnti, uint32_t lcid)                           = 0;
+  virtual uint32_t sdu_queue_free_space(uint16_t rnti, uint32_t lcid)                        = 0;
+  virtual bool     is_suspended(uint16_t rnti, uint32_t lcid)                                = 0;
 };
 
 // RLC interface for RRC
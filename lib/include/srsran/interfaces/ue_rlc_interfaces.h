@@ -61,6 +61,9 @@ public:
   ///< Allow PDCP to query SDU queue status
   virtual bool sdu_queue_is_full(uint32_t lcid) = 0;
 
+  ///< Number of SDUs that can still be written before the SDU queue is full
+  virtual uint32_t sdu_queue_free_space(uint32_t lcid) = 0;
+
   virtual bool is_suspended(const uint32_t lcid) = 0;
 };
 
@@ -29,8 +29,12 @@
 #include "rlf.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace srsran {
 
@@ -39,7 +43,8 @@ class channel
 public:
   struct args_t {
     // General
-    bool enable = false;
+    bool     enable      = false;
+    uint32_t nof_threads = 1; ///< Threads processing the RF channels in parallel, including the calling thread
 
     // AWGN options
     bool  awgn_enable            = false;
@@ -76,18 +81,36 @@ public:
   void run(cf_t* in[SRSRAN_MAX_CHANNELS], cf_t* out[SRSRAN_MAX_CHANNELS], uint32_t len, const srsran_timestamp_t& t);
 
 private:
+  void run_channel(uint32_t i, cf_t* in, cf_t* out, uint32_t len, const srsran_timestamp_t& t);
+  void run_worker(uint32_t worker_idx);
+
+  // Each RF channel owns its own models and buffers, so that the channels can be processed concurrently
   srslog::basic_logger&    logger;
-  float                    hst_init_phase              = 0.0f;
-  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS] = {};
-  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]  = {};
-  srsran_channel_awgn_t*   awgn                        = nullptr;
-  srsran_channel_hst_t*    hst                         = nullptr;
-  srsran_channel_rlf_t*    rlf                         = nullptr;
-  cf_t*                    buffer_in                   = nullptr;
-  cf_t*                    buffer_out                  = nullptr;
-  uint32_t                 nof_channels                = 0;
-  uint32_t                 current_srate               = 0;
-  args_t                   args                        = {};
+  float                    hst_init_phase                  = 0.0f;
+  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS]     = {};
+  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]      = {};
+  srsran_channel_awgn_t*   awgn[SRSRAN_MAX_CHANNELS]       = {};
+  srsran_channel_hst_t*    hst[SRSRAN_MAX_CHANNELS]        = {};
+  srsran_channel_rlf_t*    rlf                             = nullptr;
+  cf_t*                    buffer_in[SRSRAN_MAX_CHANNELS]  = {};
+  cf_t*                    buffer_out[SRSRAN_MAX_CHANNELS] = {};
+  uint32_t                 nof_channels                    = 0;
+  uint32_t                 current_srate                   = 0;
+  args_t                   args                            = {};
+
+  // Worker threads, thread k processes the channels k, k + nof_threads, ... and the calling thread is thread 0
+  uint32_t                 nof_threads = 1;
+  std::vector<std::thread> workers;
+  std::mutex               mutex;
+  std::condition_variable  cvar_start;
+  std::condition_variable  cvar_done;
+  bool                     quit        = false;
+  uint64_t                 job_count   = 0;
+  uint32_t                 nof_pending = 0;
+  cf_t**                   job_in      = nullptr;
+  cf_t**                   job_out     = nullptr;
+  uint32_t                 job_len     = 0;
+  srsran_timestamp_t       job_time    = {};
 };
 
 typedef std::unique_ptr<channel> channel_ptr;
@@ -31,6 +31,9 @@
 #define SRSRAN_CHANNEL_FADING_MAXTAPS 9
 #define SRSRAN_CHANNEL_FADING_NTERMS 16
 
+// Number of times the taps are updated during a period of the maximum doppler frequency
+#define SRSRAN_CHANNEL_FADING_UPDATES_PER_CYCLE 100
+
 typedef enum {
   srsran_channel_fading_model_none = 0,
   srsran_channel_fading_model_epa,
@@ -45,14 +48,14 @@ typedef struct {
   float                         doppler; // Maximum doppler: 5, 70, 300
 
   // Internal tap parametrisation
-  uint32_t N;          // FFT size
-  uint32_t path_delay; // Path delay
-  uint32_t state_len;  // Length of the impulse response saved in the state
+  uint32_t N;             // FFT size
+  uint32_t path_delay;    // Path delay
+  double   update_period; // Time between tap updates in seconds
 
   float coeff_alpha[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS]; // Angle of arrival
   float coeff_a[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase
   float coeff_b[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase
-  cf_t* h_tap[SRSRAN_CHANNEL_FADING_MAXTAPS]; // Static tap signal in frequency domain
+  cf_t* h_tap[SRSRAN_CHANNEL_FADING_MAXTAPS]; // Static tap signal in frequency domain, FFT shifted
 
   // Utils
   srsran_dft_plan_t fft;             // DFT to frequency domain
@@ -63,7 +66,9 @@ typedef struct {
   float             sin_table[1024]; // Table of sinus values
 
   // State variables
-  cf_t* state; // To save impulse response of the filter
+  cf_t*  state;       // Last N input samples, for the overlap-save convolution
+  bool   taps_valid;  // Set once the taps have been generated
+  double last_update; // Time of the last tap update
 } srsran_channel_fading_t;
 
 #ifdef __cplusplus
@@ -24,6 +24,7 @@
 
 #include "srsran/config.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /**********************************************************************************************
  *  File:         dft.h
@@ -40,6 +41,10 @@
  *                norm   - Normalizes output (by sqrt(len) for complex, len for real).
  *                dc     - Handles insertion and removal of null DC carrier internally.
  *
+ *                Plans of the same transform share a single FFTW plan. FFTW wisdom is loaded
+ *                at start-up from $SRSRAN_FFTW_WISDOM or ~/.srsran_fftwisdom, and stored
+ *                back at exit if new wisdom was gathered.
+ *
  *  Reference:
  *********************************************************************************************/
 
@@ -67,6 +72,15 @@ typedef struct SRSRAN_API {
   srsran_dft_mode_t mode;    // Complex/Real
 } srsran_dft_plan_t;
 
+typedef struct SRSRAN_API {
+  uint32_t nof_plans;          // Plans and replans requested
+  uint32_t nof_cache_hits;     // Requests served by an FFTW plan already in use
+  uint32_t nof_fftw_plans;     // FFTW plans currently in use
+  double   planning_time_s;    // Time spent creating FFTW plans
+  bool     wisdom_loaded;      // Whether FFTW wisdom was loaded
+  double   wisdom_load_time_s; // Time spent loading FFTW wisdom
+} srsran_dft_metrics_t;
+
 SRSRAN_API int srsran_dft_plan(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir, srsran_dft_mode_t type);
 
 SRSRAN_API int srsran_dft_plan_c(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir);
@@ -124,6 +138,16 @@ SRSRAN_API void srsran_dft_run_guru_c(srsran_dft_plan_t* plan);
 
 SRSRAN_API void srsran_dft_run_r(srsran_dft_plan_t* plan, const float* in, float* out);
 
+/* FFTW wisdom and plan metrics. A NULL filename selects the default wisdom file */
+
+SRSRAN_API int srsran_dft_load_wisdom(const char* filename);
+
+SRSRAN_API int srsran_dft_store_wisdom(const char* filename);
+
+SRSRAN_API void srsran_dft_get_metrics(srsran_dft_metrics_t* metrics);
+
+SRSRAN_API void srsran_dft_exit();
+
 #ifdef __cplusplus
 }
 #endif
@@ -299,6 +299,75 @@ inline static simd_type_t simd_rb_shift_256(simd_type_t v, const int l)
   return _mm256_blendv_epi8(hi, low, _mm256_set1_epi32(0x00FF00FF));
 }
 
+#else
+#ifdef WINIMP_IS_AVX512_8
+
+#ifndef LV_HAVE_AVX512
+#error "Selected AVX512 window decoder but instruction set not supported"
+#endif
+
+#include <immintrin.h>
+
+#define WINIMP avx512_8
+#define nof_blocks 64
+
+#define llr_t int8_t
+
+// The systematic and parity streams are only 32-byte aligned (see rm_turbo.c), so use unaligned accesses
+#define simd_type_t __m512i
+#define simd_load(x) _mm512_loadu_si512((const void*)(x))
+#define simd_store(x, y) _mm512_storeu_si512((void*)(x), y)
+#define simd_add _mm512_adds_epi8
+#define simd_sub _mm512_subs_epi8
+#define simd_max _mm512_max_epi8
+#define simd_set1 _mm512_set1_epi8
+#define simd_insert simd_insert_512
+#define simd_shuffle(v, move) move(v)
+#define move_right simd_move_right_512
+#define move_left simd_move_left_512
+#define simd_rb_shift simd_rb_shift_512
+
+#define INF 0
+
+#define normalize_max
+#define normalize_period 1
+#define win_overlap_len 40
+#define use_saturated_add
+#define divide_output 1
+
+/* There are no byte insert or cross-lane byte shuffle instructions in AVX512BW. These are only used twice per window
+ * pass, so they go through memory. */
+inline static simd_type_t simd_insert_512(simd_type_t v, llr_t x, const int pos)
+{
+  llr_t tmp[nof_blocks] __attribute__((aligned(64)));
+  _mm512_store_si512((void*)tmp, v);
+  tmp[pos] = x;
+  return _mm512_load_si512((const void*)tmp);
+}
+
+inline static simd_type_t simd_move_right_512(simd_type_t v)
+{
+  llr_t tmp[nof_blocks + 1] __attribute__((aligned(64)));
+  _mm512_store_si512((void*)tmp, v);
+  tmp[nof_blocks] = tmp[nof_blocks - 1];
+  return _mm512_loadu_si512((const void*)&tmp[1]);
+}
+
+inline static simd_type_t simd_move_left_512(simd_type_t v)
+{
+  llr_t tmp[nof_blocks + 64] __attribute__((aligned(64)));
+  _mm512_store_si512((void*)&tmp[64], v);
+  tmp[63] = tmp[64];
+  return _mm512_loadu_si512((const void*)&tmp[63]);
+}
+
+inline static simd_type_t simd_rb_shift_512(simd_type_t v, const int l)
+{
+  __m512i low = _mm512_srai_epi16(_mm512_slli_epi16(v, 8), l + 8);
+  __m512i hi  = _mm512_srai_epi16(v, l);
+  return _mm512_mask_blend_epi8(0x5555555555555555ULL, hi, low);
+}
+
 #else
 #ifdef WINIMP_IS_NEON16
 #include <arm_neon.h>
@@ -407,6 +476,7 @@ inline static uint8x16_t v_load_s8(int i15,
 #endif
 #endif
 #endif
+#endif
 
 typedef struct SRSRAN_API {
   uint32_t max_long_cb;
@@ -880,6 +950,15 @@ void MAKE_FUNC(dec)(void* hh, llr_t* input, llr_t* app, llr_t* parity, llr_t* ou
 void MAKE_FUNC(
     extract_input)(llr_t* input, llr_t* systematic, llr_t* app2, llr_t* parity_0, llr_t* parity_1, uint32_t long_cb)
 {
+#ifdef WINIMP_IS_AVX512_8
+  for (uint32_t i = 0; i < long_sb; i++) {
+    for (uint32_t b = 0; b < nof_blocks; b++) {
+      systematic[nof_blocks * i + b] = input[3 * (i + b * long_sb)];
+      parity_0[nof_blocks * i + b]   = input[3 * (i + b * long_sb) + 1];
+      parity_1[nof_blocks * i + b]   = input[3 * (i + b * long_sb) + 2];
+    }
+  }
+#else
   simd_type_t* systPtr    = (simd_type_t*)systematic;
   simd_type_t* parity0Ptr = (simd_type_t*)parity_0;
   simd_type_t* parity1Ptr = (simd_type_t*)parity_1;
@@ -912,6 +991,7 @@ void MAKE_FUNC(
     simd_store(parity0Ptr++, parity0);
     simd_store(parity1Ptr++, parity1);
   }
+#endif /* WINIMP_IS_AVX512_8 */
 
   for (int i = long_cb; i < long_cb + 3; i++) {
     systematic[i] = input[3 * long_cb + 2 * (i - long_cb)];
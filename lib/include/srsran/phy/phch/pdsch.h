@@ -94,6 +94,9 @@ SRSRAN_API void srsran_pdsch_free(srsran_pdsch_t* q);
 /* These functions modify the state of the object and may take some time */
 SRSRAN_API int srsran_pdsch_enable_coworker(srsran_pdsch_t* q);
 
+/* Decodes the code blocks of both codewords, including the one of the coworker, with a pool of nof_threads threads */
+SRSRAN_API int srsran_pdsch_set_cb_threads(srsran_pdsch_t* q, uint32_t nof_threads);
+
 SRSRAN_API int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell);
 
 /* These functions do not modify the state and run in real-time */
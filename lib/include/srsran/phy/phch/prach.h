@@ -47,6 +47,9 @@
 // Short PRACH ZC sequence sequence length
 #define SRSRAN_PRACH_N_ZC_SHORT 139
 
+// Number of root sequences correlated with a single batched IFFT during detection
+#define SRSRAN_PRACH_DETECT_BATCH 16
+
 /** Generation and detection of RACH signals for uplink.
  *  Currently only supports preamble formats 0-3.
  *  Does not currently support high speed flag.
@@ -102,6 +105,11 @@ typedef struct SRSRAN_API {
   srsran_dft_plan_t zc_fft;
   srsran_dft_plan_t zc_ifft;
 
+  // Batched IFFT of the correlation spectra of SRSRAN_PRACH_DETECT_BATCH roots
+  srsran_dft_plan_t zc_ifft_batch;
+  cf_t*             batch_spec;
+  cf_t*             batch_corr;
+
   cf_t* signal_fft;
   float detect_factor;
 
@@ -234,6 +242,27 @@ SRSRAN_API int srsran_prach_detect_offset(srsran_prach_t* p,
                                           float*          peak_to_avg,
                                           uint32_t*       ind_len);
 
+/**
+ * Transforms the received PRACH signal and extracts the bins of the preamble into p->prach_bins, which can then be
+ * searched with srsran_prach_detect_roots().
+ */
+SRSRAN_API int srsran_prach_extract_bins(srsran_prach_t* p, uint32_t freq_offset, cf_t* signal, uint32_t sig_len);
+
+/**
+ * Searches the preamble bins for the preambles of the roots in [root_begin, root_end). Preamble indices are reported
+ * as in srsran_prach_detect_offset(), so that the searches of disjoint root ranges, each running on its own object with
+ * the same configuration, can be merged in root order. Successive cancellation is not applied.
+ * @param bins Preamble bins obtained from srsran_prach_extract_bins(), possibly on another object
+ */
+SRSRAN_API int srsran_prach_detect_roots(srsran_prach_t* p,
+                                         const cf_t*     bins,
+                                         uint32_t        root_begin,
+                                         uint32_t        root_end,
+                                         uint32_t*       indices,
+                                         float*          t_offsets,
+                                         float*          peak_to_avg,
+                                         uint32_t*       ind_len);
+
 SRSRAN_API void srsran_prach_set_detect_factor(srsran_prach_t* p, float factor);
 
 SRSRAN_API int srsran_prach_free(srsran_prach_t* p);
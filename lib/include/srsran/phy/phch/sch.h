@@ -71,6 +71,9 @@ typedef struct SRSRAN_API {
 
   srsran_uci_cqi_pusch_t uci_cqi;
 
+  // Optional code block decoder pool, see srsran_sch_set_cb_threads()
+  void* cb_pool_ptr;
+
 } srsran_sch_t;
 
 SRSRAN_API int srsran_sch_init(srsran_sch_t* q);
@@ -81,6 +84,33 @@ SRSRAN_API void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations)
 
 SRSRAN_API float srsran_sch_last_noi(srsran_sch_t* q);
 
+/**
+ * @brief Sets the number of threads used for decoding the code blocks of a transport block
+ *
+ * When more than one thread is selected, the code blocks of every decoded transport block are distributed among a pool
+ * of decoder contexts, each with its own turbo decoder, and joined before the transport block CRC check. The calling
+ * thread takes part in the decoding, so nof_threads - 1 auxiliary threads are created. Setting 0 or 1 threads restores
+ * the serial decoder.
+ *
+ * @param q SCH object
+ * @param nof_threads Total number of threads decoding code blocks, including the calling thread
+ * @return SRSRAN_SUCCESS if the pool is created successfully, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_sch_set_cb_threads(srsran_sch_t* q, uint32_t nof_threads);
+
+/**
+ * @brief Makes q decode its code blocks through the code block decoder pool of src, releasing its own pool if any
+ *
+ * Transport blocks of several SCH objects, for instance the codewords or carriers of one subframe, can then be
+ * decoded concurrently by the same auxiliary threads. The pool is freed once no object uses it. If src has no pool, q
+ * falls back to the serial decoder.
+ *
+ * @param q SCH object
+ * @param src SCH object owning the pool, configured with srsran_sch_set_cb_threads()
+ * @return SRSRAN_SUCCESS, SRSRAN_ERROR_INVALID_INPUTS if any of the objects is NULL
+ */
+SRSRAN_API int srsran_sch_share_cb_threads(srsran_sch_t* q, srsran_sch_t* src);
+
 SRSRAN_API int srsran_dlsch_encode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, uint8_t* data, uint8_t* e_bits);
 
 SRSRAN_API int srsran_dlsch_encode2(srsran_sch_t*       q,
@@ -76,6 +76,9 @@ typedef struct SRSRAN_API {
   /// LDPC Rate matcher
   srsran_ldpc_rm_t tx_rm;
   srsran_ldpc_rm_t rx_rm;
+
+  /// Optional code block decoder pool, created when srsran_sch_nr_args_t::nof_cb_threads is greater than one
+  void* cb_pool_ptr;
 } srsran_sch_nr_t;
 
 /**
@@ -85,7 +88,8 @@ typedef struct SRSRAN_API {
   bool     disable_simd;
   bool     decoder_use_flooded;
   float    decoder_scaling_factor;
-  uint32_t max_nof_iter; ///< Maximum number of LDPC iterations
+  uint32_t max_nof_iter;   ///< Maximum number of LDPC iterations
+  uint32_t nof_cb_threads; ///< Number of threads decoding code blocks in parallel, set to 0 or 1 for serial decoding
 } srsran_sch_nr_args_t;
 
 /**
@@ -145,6 +149,12 @@ SRSRAN_API int srsran_sch_nr_init_tx(srsran_sch_nr_t* q, const srsran_sch_nr_arg
 
 /**
  * @brief Initialises an SCH object as receiver
+ *
+ * @remark If args->nof_cb_threads is greater than one, the code blocks of every decoded transport block are distributed
+ * among nof_cb_threads workers (the calling thread included). Each worker owns an LDPC decoder for every lifting size
+ * of both base graphs, all created here (in sch_nr_cb_pool_init) so that no decoder is created while decoding. The
+ * decoded data is identical to the serial decoding.
+ *
  * @param q Points ats the SCH object
  * @param args Provides static configuration arguments
  * @return SRSRAN_SUCCESS if the initialization is successful, SRSRAN_ERROR otherwise
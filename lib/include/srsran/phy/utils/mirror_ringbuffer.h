@@ -0,0 +1,112 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         mirror_ringbuffer.h
+ *
+ *  Description:  Single-producer single-consumer ring buffer whose memory is
+ *                mapped twice, back to back, in the address space. Any range
+ *                of up to capacity bytes starting inside the buffer is
+ *                contiguous, so readers and writers work in place through the
+ *                reserve/commit functions and never split a copy at the wrap.
+ *
+ *                The read and write positions are only modified by their
+ *                owner and shared through atomic loads and stores. The mutex
+ *                and condition variable are only used when one side has to
+ *                wait for the other.
+ *
+ *                Unlike srsran_ringbuffer_t, a timeout of 0 does not wait at
+ *                all: use a negative timeout to wait forever.
+ *****************************************************************************/
+
+#ifndef SRSRAN_MIRROR_RINGBUFFER_H
+#define SRSRAN_MIRROR_RINGBUFFER_H
+
+#include "srsran/config.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+  uint8_t*        buffer;      // capacity bytes, followed by their mirror
+  uint32_t        capacity;    // multiple of the page size
+  uint64_t        wpm;         // total number of bytes committed by the writer
+  uint64_t        rpm;         // total number of bytes committed by the reader
+  bool            active;      // cleared by srsran_mirror_ringbuffer_stop()
+  int             nof_waiting; // number of sides blocked in the condition variable
+  pthread_mutex_t mutex;
+  pthread_cond_t  cvar;
+} srsran_mirror_ringbuffer_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// the capacity is rounded up to a multiple of the page size
+SRSRAN_API int srsran_mirror_ringbuffer_init(srsran_mirror_ringbuffer_t* q, uint32_t capacity);
+
+SRSRAN_API void srsran_mirror_ringbuffer_free(srsran_mirror_ringbuffer_t* q);
+
+// empties the buffer, must not be called while the reader or the writer are using it
+SRSRAN_API void srsran_mirror_ringbuffer_reset(srsran_mirror_ringbuffer_t* q);
+
+// number of bytes ready to be read
+SRSRAN_API uint32_t srsran_mirror_ringbuffer_status(srsran_mirror_ringbuffer_t* q);
+
+// number of bytes that can be written
+SRSRAN_API uint32_t srsran_mirror_ringbuffer_space(srsran_mirror_ringbuffer_t* q);
+
+/* Returns a pointer to nof_bytes of contiguous free space, waiting for it for timeout_ms milliseconds. A timeout_ms of
+ * 0 is non-blocking and -1 waits forever. Returns NULL on timeout or if the buffer was stopped. */
+SRSRAN_API void* srsran_mirror_ringbuffer_write_reserve(srsran_mirror_ringbuffer_t* q,
+                                                        uint32_t                    nof_bytes,
+                                                        int32_t                     timeout_ms);
+
+// makes the first nof_bytes of the reserved space available to the reader
+SRSRAN_API void srsran_mirror_ringbuffer_write_commit(srsran_mirror_ringbuffer_t* q, uint32_t nof_bytes);
+
+/* Returns a pointer to nof_bytes of contiguous data, waiting for them for timeout_ms milliseconds. A timeout_ms of 0 is
+ * non-blocking and -1 waits forever. Returns NULL on timeout or if the buffer was stopped. */
+SRSRAN_API void* srsran_mirror_ringbuffer_read_reserve(srsran_mirror_ringbuffer_t* q,
+                                                       uint32_t                    nof_bytes,
+                                                       int32_t                     timeout_ms);
+
+// hands the first nof_bytes of the reserved data back to the writer
+SRSRAN_API void srsran_mirror_ringbuffer_read_commit(srsran_mirror_ringbuffer_t* q, uint32_t nof_bytes);
+
+/* Copies nof_bytes into the buffer, or zeros if ptr is NULL, with the timeout semantics of write_reserve. Returns
+ * nof_bytes, SRSRAN_ERROR_TIMEOUT on timeout or 0 if the buffer was stopped. */
+SRSRAN_API int
+srsran_mirror_ringbuffer_write(srsran_mirror_ringbuffer_t* q, const void* ptr, uint32_t nof_bytes, int32_t timeout_ms);
+
+/* Copies nof_bytes out of the buffer, with the timeout semantics of read_reserve. Returns nof_bytes,
+ * SRSRAN_ERROR_TIMEOUT on timeout or 0 if the buffer was stopped. */
+SRSRAN_API int
+srsran_mirror_ringbuffer_read(srsran_mirror_ringbuffer_t* q, void* ptr, uint32_t nof_bytes, int32_t timeout_ms);
+
+// wakes up and rejects any waiting or further reserve call
+SRSRAN_API void srsran_mirror_ringbuffer_stop(srsran_mirror_ringbuffer_t* q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_MIRROR_RINGBUFFER_H
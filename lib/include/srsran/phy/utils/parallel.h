@@ -0,0 +1,91 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         parallel.h
+ *
+ *  Description:  Fork-join execution of independent tasks on a fixed set of
+ *                threads. The calling thread takes part in the execution as
+ *                worker 0, the remaining workers are persistent threads. Runs
+ *                may be issued concurrently from several threads, in which
+ *                case the auxiliary threads pull the tasks of all of them. An
+ *                auxiliary worker index is only used by one thread at a time,
+ *                so it can be used for selecting per-thread resources
+ *                (decoders, buffers); worker 0 refers to the thread that
+ *                issued the run.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_PARALLEL_H
+#define SRSRAN_PARALLEL_H
+
+#include "srsran/config.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Task callback
+ * @param arg User argument given to srsran_parallel_for_run()
+ * @param worker_idx Index of the worker executing the task, between 0 and nof_threads - 1
+ * @param task_idx Index of the task, between 0 and nof_tasks - 1
+ */
+typedef void (*srsran_parallel_task_t)(void* arg, uint32_t worker_idx, uint32_t task_idx);
+
+typedef struct SRSRAN_API {
+  uint32_t nof_threads; ///< Total number of workers, including the calling thread
+  void*    workers;     ///< Auxiliary threads context
+
+  /* Runs with tasks not taken yet, in issuing order. Protected by mutex, cvar wakes up the auxiliary threads */
+  void*           jobs;
+  pthread_mutex_t mutex;
+  pthread_cond_t  cvar;
+  bool            quit;
+} srsran_parallel_for_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Creates nof_threads - 1 auxiliary threads. With 0 or 1 threads, all tasks are executed by the calling thread.
+ * @return SRSRAN_SUCCESS if all threads are created, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_parallel_for_init(srsran_parallel_for_t* q, uint32_t nof_threads);
+
+SRSRAN_API void srsran_parallel_for_free(srsran_parallel_for_t* q);
+
+/**
+ * @brief Executes task for every index in [0, nof_tasks) and returns once all of them have finished
+ *
+ * Tasks are pulled in increasing index order by the calling thread and the auxiliary threads. It can be called
+ * concurrently for the same object, the auxiliary threads serve the runs in the order they were issued and every
+ * calling thread executes tasks of its own run only.
+ */
+SRSRAN_API void
+srsran_parallel_for_run(srsran_parallel_for_t* q, uint32_t nof_tasks, srsran_parallel_task_t task, void* arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_PARALLEL_H
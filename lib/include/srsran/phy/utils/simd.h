@@ -1297,6 +1297,110 @@ static inline simd_i_t srsran_simd_i_and(simd_i_t a, simd_i_t b)
 #endif /* LV_HAVE_AVX512 */
 }
 
+static inline simd_i_t srsran_simd_i_or(simd_i_t a, simd_i_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_or_si512(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_or_si256(a, b);
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_or_si128(a, b);
+#else
+#ifdef HAVE_NEON
+  return vorrq_s32(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_i_t srsran_simd_i_xor(simd_i_t a, simd_i_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_xor_si512(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_xor_si256(a, b);
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_xor_si128(a, b);
+#else
+#ifdef HAVE_NEON
+  return veorq_s32(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+/* Logical shift left of each 32-bit element */
+static inline simd_i_t srsran_simd_i_sll(simd_i_t a, int shift)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_slli_epi32(a, shift);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_slli_epi32(a, shift);
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_slli_epi32(a, shift);
+#else
+#ifdef HAVE_NEON
+  return vreinterpretq_s32_u32(vshlq_u32(vreinterpretq_u32_s32(a), vdupq_n_s32(shift)));
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+/* Logical shift right of each 32-bit element */
+static inline simd_i_t srsran_simd_i_srl(simd_i_t a, int shift)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_srli_epi32(a, shift);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_srli_epi32(a, shift);
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_srli_epi32(a, shift);
+#else
+#ifdef HAVE_NEON
+  return vreinterpretq_s32_u32(vshlq_u32(vreinterpretq_u32_s32(a), vdupq_n_s32(-shift)));
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+/* Loads table[idx[i]] into each element i */
+static inline simd_i_t srsran_simd_i_gather(const int* table, simd_i_t idx)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_i32gather_epi32(idx, table, 4);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_i32gather_epi32(table, idx, 4);
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_set_epi32(table[_mm_extract_epi32(idx, 3)],
+                       table[_mm_extract_epi32(idx, 2)],
+                       table[_mm_extract_epi32(idx, 1)],
+                       table[_mm_extract_epi32(idx, 0)]);
+#else
+#ifdef HAVE_NEON
+  int32x4_t r = vdupq_n_s32(table[vgetq_lane_s32(idx, 0)]);
+  r           = vsetq_lane_s32(table[vgetq_lane_s32(idx, 1)], r, 1);
+  r           = vsetq_lane_s32(table[vgetq_lane_s32(idx, 2)], r, 2);
+  return vsetq_lane_s32(table[vgetq_lane_s32(idx, 3)], r, 3);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
 static inline simd_sel_t srsran_simd_f_max(simd_f_t a, simd_f_t b)
 {
 #ifdef LV_HAVE_AVX512
@@ -365,6 +365,44 @@ SRSRAN_API void srsran_vec_interleave(const cf_t* x, const cf_t* y, cf_t* z, con
 
 SRSRAN_API void srsran_vec_interleave_add(const cf_t* x, const cf_t* y, cf_t* z, const int len);
 
+/**
+ * @brief Interleaves nof_x complex vectors sample by sample and scales them, i.e. z[i * nof_x + c] = x[c][i] * h
+ *
+ * @param x is the array of nof_x input complex vectors, of len samples each
+ * @param nof_x is the number of input vectors
+ * @param h is the scaling factor
+ * @param z is the destination vector of len * nof_x samples
+ * @param len is the number of samples of every input vector
+ */
+SRSRAN_API void
+srsran_vec_interleave_sc_prod_cfc(cf_t* const* x, const uint32_t nof_x, const float h, cf_t* z, const uint32_t len);
+
+/**
+ * @brief Deinterleaves nof_z complex vectors sample by sample and scales them, i.e. z[c][i] = x[i * nof_z + c] * h.
+ * The vectors of z that are NULL are skipped
+ */
+SRSRAN_API void
+srsran_vec_deinterleave_sc_prod_cfc(const cf_t* x, const uint32_t nof_z, const float h, cf_t** z, const uint32_t len);
+
+/**
+ * @brief Interleaves nof_x complex vectors sample by sample into complex shorts, like srsran_vec_convert_fi
+ */
+SRSRAN_API void srsran_vec_interleave_convert_cs(cf_t* const*   x,
+                                                 const uint32_t nof_x,
+                                                 const float    scale,
+                                                 int16_t*       z,
+                                                 const uint32_t len);
+
+/**
+ * @brief Deinterleaves nof_z complex vectors sample by sample out of complex shorts, like srsran_vec_convert_if. The
+ * vectors of z that are NULL are skipped
+ */
+SRSRAN_API void srsran_vec_deinterleave_convert_sc(const int16_t* x,
+                                                   const uint32_t nof_z,
+                                                   const float    scale,
+                                                   cf_t**         z,
+                                                   const uint32_t len);
+
 SRSRAN_API cf_t srsran_vec_gen_sine(cf_t amplitude, float freq, cf_t* z, int len);
 
 SRSRAN_API void srsran_vec_apply_cfo(const cf_t* x, float cfo, cf_t* z, int len);
@@ -132,6 +132,18 @@ SRSRAN_API void srsran_vec_interleave_simd(const cf_t* x, const cf_t* y, cf_t* z
 
 SRSRAN_API void srsran_vec_interleave_add_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len);
 
+SRSRAN_API void
+srsran_vec_interleave_sc_prod_cfc_simd(cf_t* const* x, const int nof_x, const float h, cf_t* z, const int len);
+
+SRSRAN_API void
+srsran_vec_deinterleave_sc_prod_cfc_simd(const cf_t* x, const int nof_z, const float h, cf_t** z, const int len);
+
+SRSRAN_API void
+srsran_vec_interleave_convert_cs_simd(cf_t* const* x, const int nof_x, const float scale, int16_t* z, const int len);
+
+SRSRAN_API void
+srsran_vec_deinterleave_convert_sc_simd(const int16_t* x, const int nof_z, const float scale, cf_t** z, const int len);
+
 SRSRAN_API cf_t srsran_vec_gen_sine_simd(cf_t amplitude, float freq, cf_t* z, int len);
 
 SRSRAN_API void srsran_vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t* z, int len);
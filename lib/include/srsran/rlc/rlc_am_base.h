@@ -87,7 +87,8 @@ public:
 
   void discard_sdu(uint32_t discard_sn) final;
 
-  bool sdu_queue_is_full() final;
+  bool     sdu_queue_is_full() final;
+  uint32_t sdu_queue_free_space() final;
 
   /****************************************************************************
    * MAC interface
@@ -150,6 +151,7 @@ public:
 
     int              write_sdu(unique_byte_buffer_t sdu);
     bool             sdu_queue_is_full();
+    uint32_t         sdu_queue_free_space();
     virtual void     discard_sdu(uint32_t pdcp_sn);
     virtual uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes) = 0;
 
@@ -26,7 +26,10 @@
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_chain.h"
+#include "srsran/rlc/rlc_common.h"
 #include <array>
+#include <deque>
 #include <list>
 #include <vector>
 
@@ -125,10 +128,10 @@ public:
   using iterator       = typename list_type::iterator;
   using const_iterator = typename list_type::const_iterator;
 
-  const uint32_t       rlc_sn     = invalid_rlc_sn;
-  uint32_t             retx_count = 0;
-  HeaderType           header     = {};
-  unique_byte_buffer_t buf        = nullptr;
+  const uint32_t                    rlc_sn     = invalid_rlc_sn;
+  uint32_t                          retx_count = 0;
+  HeaderType                        header     = {};
+  byte_buffer_chain<RLC_MAX_SLICES> data; ///< SDU segments carried by the PDU, referenced in the SDU buffers
 
   explicit rlc_amd_tx_pdu(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
   rlc_amd_tx_pdu(const rlc_amd_tx_pdu&)           = delete;
@@ -257,6 +260,281 @@ private:
   srsran::static_circular_map<uint32_t, T, WINDOW_SIZE> window;
 };
 
+template <typename SegmentType>
+class rlc_am_rx_segment_list;
+
+/// Pool of the nodes that hold the received segments of RLC AM PDUs. The nodes are recycled through a free list, so
+/// memory is only allocated when the number of buffered segments reaches a new maximum. SegmentType must have a
+/// unique_byte_buffer_t "buf", which is released when its node returns to the pool.
+template <typename SegmentType>
+class rlc_am_rx_segment_pool
+{
+public:
+  struct node {
+    uint32_t    so      = 0;
+    uint32_t    len     = 0;
+    bool        last    = false;
+    SegmentType segment = {};
+
+  private:
+    friend class rlc_am_rx_segment_pool<SegmentType>;
+    friend class rlc_am_rx_segment_list<SegmentType>;
+    node*                                next        = nullptr;
+    rlc_am_rx_segment_pool<SegmentType>* parent_pool = nullptr;
+  };
+
+  /// Segment nodes allocated up front, enough for a few resegmented PDUs in flight
+  const static size_t default_initial_size = 16;
+
+  explicit rlc_am_rx_segment_pool(size_t initial_size = default_initial_size)
+  {
+    for (size_t i = 0; i < initial_size; ++i) {
+      deallocate(new_node());
+    }
+  }
+  rlc_am_rx_segment_pool(const rlc_am_rx_segment_pool&) = delete;
+  rlc_am_rx_segment_pool(rlc_am_rx_segment_pool&&)      = delete;
+  rlc_am_rx_segment_pool& operator=(const rlc_am_rx_segment_pool&) = delete;
+  rlc_am_rx_segment_pool& operator=(rlc_am_rx_segment_pool&&) = delete;
+
+  node* allocate()
+  {
+    if (free_list == nullptr) {
+      return new_node();
+    }
+    node* n   = free_list;
+    free_list = n->next;
+    n->next   = nullptr;
+    nof_free_nodes--;
+    return n;
+  }
+  void deallocate(node* n)
+  {
+    n->segment.buf.reset();
+    n->next   = free_list;
+    free_list = n;
+    nof_free_nodes++;
+  }
+
+  size_t capacity() const { return nodes.size(); }
+  size_t nof_free() const { return nof_free_nodes; }
+
+private:
+  node* new_node()
+  {
+    nodes.emplace_back();
+    nodes.back().parent_pool = this;
+    return &nodes.back();
+  }
+
+  std::deque<node> nodes; ///< Storage of the nodes. A deque keeps their addresses stable as it grows
+  node*            free_list      = nullptr;
+  size_t           nof_free_nodes = 0;
+};
+
+/**
+ * Received segments of a RLC AM PDU (LTE) or SDU (NR), sorted by segment offset (SO). Each insertion merges the byte
+ * intervals of the stored segments to keep track of the reception state, i.e. the number of bytes received without
+ * gaps from SO=0 and whether the last segment is present. Segments whose bytes are all covered by the segments
+ * before them are dropped, but partially overlapping segments are kept as received: readers walking the list must skip
+ * the bytes of each segment that precede the end of the previous ones. The nodes are taken from a
+ * rlc_am_rx_segment_pool and return to it when removed.
+ */
+template <typename SegmentType>
+class rlc_am_rx_segment_list
+{
+  using node_t = typename rlc_am_rx_segment_pool<SegmentType>::node;
+
+  template <typename U, typename NodeType>
+  class iterator_impl
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = U;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = U*;
+    using reference         = U&;
+
+    explicit iterator_impl(NodeType* n_ = nullptr) : n(n_) {}
+    iterator_impl& operator++()
+    {
+      n = n->next;
+      return *this;
+    }
+    iterator_impl operator++(int)
+    {
+      iterator_impl ret = *this;
+      n                 = n->next;
+      return ret;
+    }
+    reference operator*() const { return n->segment; }
+    pointer   operator->() const { return &n->segment; }
+
+    bool operator==(const iterator_impl& other) const { return n == other.n; }
+    bool operator!=(const iterator_impl& other) const { return n != other.n; }
+
+  private:
+    NodeType* n;
+  };
+
+public:
+  using iterator       = iterator_impl<SegmentType, node_t>;
+  using const_iterator = iterator_impl<const SegmentType, const node_t>;
+
+  rlc_am_rx_segment_list()                              = default;
+  rlc_am_rx_segment_list(const rlc_am_rx_segment_list&) = delete;
+  rlc_am_rx_segment_list(rlc_am_rx_segment_list&& other) noexcept { *this = std::move(other); }
+  rlc_am_rx_segment_list& operator=(const rlc_am_rx_segment_list&) = delete;
+  rlc_am_rx_segment_list& operator=(rlc_am_rx_segment_list&& other) noexcept
+  {
+    if (this != &other) {
+      clear();
+      head                = other.head;
+      tail                = other.tail;
+      count               = other.count;
+      rx_contiguous       = other.rx_contiguous;
+      rx_gap              = other.rx_gap;
+      last_rx             = other.last_rx;
+      total_len           = other.total_len;
+      other.head          = nullptr;
+      other.tail          = nullptr;
+      other.count         = 0;
+      other.rx_contiguous = 0;
+      other.rx_gap        = false;
+      other.last_rx       = false;
+      other.total_len     = 0;
+    }
+    return *this;
+  }
+  ~rlc_am_rx_segment_list() { clear(); }
+
+  /// Stores a segment of len bytes at offset so. A segment with the same SO as a stored one replaces it if it is
+  /// longer, and is dropped otherwise. Returns false if the segment was dropped.
+  bool insert(rlc_am_rx_segment_pool<SegmentType>& pool, uint32_t so, uint32_t len, bool last, SegmentType segment)
+  {
+    node_t* prev = nullptr;
+    node_t* it   = head;
+    while (it != nullptr && it->so < so) {
+      prev = it;
+      it   = it->next;
+    }
+    if (it != nullptr && it->so == so) {
+      if (it->len >= len) {
+        return false;
+      }
+      it->len     = len;
+      it->last    = last;
+      it->segment = std::move(segment);
+    } else {
+      node_t* n  = pool.allocate();
+      n->so      = so;
+      n->len     = len;
+      n->last    = last;
+      n->segment = std::move(segment);
+      n->next    = it;
+      if (prev == nullptr) {
+        head = n;
+      } else {
+        prev->next = n;
+      }
+      count++;
+    }
+    merge_intervals();
+    return true;
+  }
+
+  /// All bytes in [so, so + len) are already stored
+  bool covers(uint32_t so, uint32_t len) const
+  {
+    uint32_t covered_end = so;
+    for (const node_t* it = head; it != nullptr && it->so <= covered_end; it = it->next) {
+      covered_end = std::max(covered_end, it->so + it->len);
+    }
+    return covered_end >= so + len;
+  }
+
+  /// Number of bytes received without gaps from SO=0
+  uint32_t nof_contiguous_bytes() const { return rx_contiguous; }
+  /// Some bytes are missing before the last stored segment
+  bool has_gap() const { return rx_gap; }
+  /// All bytes up to the end of the last segment have been received
+  bool fully_received() const { return last_rx && not rx_gap && rx_contiguous >= total_len; }
+
+  bool   empty() const { return head == nullptr; }
+  size_t size() const { return count; }
+
+  SegmentType&       front() { return head->segment; }
+  const SegmentType& front() const { return head->segment; }
+  SegmentType&       back() { return tail->segment; }
+  const SegmentType& back() const { return tail->segment; }
+
+  iterator       begin() { return iterator(head); }
+  iterator       end() { return iterator(nullptr); }
+  const_iterator begin() const { return const_iterator(head); }
+  const_iterator end() const { return const_iterator(nullptr); }
+
+  void clear()
+  {
+    while (head != nullptr) {
+      node_t* n = head;
+      head      = n->next;
+      n->parent_pool->deallocate(n);
+    }
+    tail          = nullptr;
+    count         = 0;
+    rx_contiguous = 0;
+    rx_gap        = false;
+    last_rx       = false;
+    total_len     = 0;
+  }
+
+private:
+  // Walks the segments in SO order, dropping the ones that are covered by the segments before them, and updates the
+  // reception state
+  void merge_intervals()
+  {
+    uint32_t covered_end = 0;
+    node_t*  prev        = nullptr;
+    rx_contiguous        = 0;
+    rx_gap               = false;
+    last_rx              = false;
+    total_len            = 0;
+    for (node_t* it = head; it != nullptr;) {
+      uint32_t seg_end = it->so + it->len;
+      if (prev != nullptr && seg_end <= covered_end) {
+        node_t* next = it->next;
+        prev->next   = next;
+        it->parent_pool->deallocate(it);
+        count--;
+        it = next;
+        continue;
+      }
+      if (it->so > covered_end) {
+        rx_gap = true;
+      }
+      covered_end = std::max(covered_end, seg_end);
+      if (not rx_gap) {
+        rx_contiguous = covered_end;
+      }
+      if (it->last) {
+        last_rx   = true;
+        total_len = seg_end;
+      }
+      prev = it;
+      it   = it->next;
+    }
+    tail = prev;
+  }
+
+  node_t*  head          = nullptr;
+  node_t*  tail          = nullptr;
+  size_t   count         = 0;
+  uint32_t rx_contiguous = 0;
+  bool     rx_gap        = false;
+  bool     last_rx       = false;
+  uint32_t total_len     = 0;
+};
+
 template <typename HeaderType>
 struct buffered_pdcp_pdu_list {
 public:
@@ -26,6 +26,7 @@
 #include "srsran/adt/circular_array.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_chain.h"
 #include "srsran/common/common.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/timeout.h"
@@ -113,8 +114,8 @@ private:
 
   rlc_am_config_t cfg = {};
 
-  // TX SDU buffers
-  unique_byte_buffer_t tx_sdu;
+  // TX SDU buffers. The part of the SDU that has not been sent yet, which shares its buffer with the Tx window
+  byte_buffer_slice tx_sdu;
 
   /****************************************************************************
    * State variables and counters
@@ -189,7 +190,7 @@ private:
   bool inside_rx_window(const int16_t sn);
   void debug_state();
   void print_rx_segments();
-  bool add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu* segment);
+  bool add_segment_and_check(rlc_amd_rx_pdu_segments_t& pdu, rlc_amd_rx_pdu segment);
   void reset_status();
 
   rlc_am*           parent = nullptr;
@@ -220,9 +221,10 @@ private:
   // Mutex to protect members
   std::mutex mutex;
 
-  // Rx windows
-  rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE> rx_window;
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>        rx_segments;
+  // Rx windows. The segments of each SN are stored in nodes of the segment pool, which must outlive them
+  rlc_am_rx_segment_pool<rlc_amd_rx_pdu>                                        rx_segment_pool;
+  rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE>                          rx_window;
+  static_circular_map<uint32_t, rlc_amd_rx_pdu_segments_t, RLC_AM_WINDOW_SIZE> rx_segments;
 
   bool              poll_received = false;
   std::atomic<bool> do_status     = {false}; // light-weight access from Tx entity
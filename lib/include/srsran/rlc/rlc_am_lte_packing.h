@@ -43,9 +43,7 @@ struct rlc_amd_rx_pdu {
   explicit rlc_amd_rx_pdu(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
 };
 
-struct rlc_amd_rx_pdu_segments_t {
-  std::list<rlc_amd_rx_pdu> segments;
-};
+using rlc_amd_rx_pdu_segments_t = rlc_am_rx_segment_list<rlc_amd_rx_pdu>;
 
 /****************************************************************************
  * Header pack/unpack helper functions
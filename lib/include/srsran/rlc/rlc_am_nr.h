@@ -34,6 +34,7 @@
 #include <mutex>
 #include <pthread.h>
 #include <queue>
+#include <set>
 
 namespace srsran {
 
@@ -252,7 +253,7 @@ public:
   bool inside_rx_window(uint32_t sn) const;
   bool valid_ack_sn(uint32_t sn) const;
   void write_to_upper_layers(uint32_t lcid, unique_byte_buffer_t sdu);
-  void insert_received_segment(rlc_amd_rx_pdu_nr segment, rlc_amd_rx_sdu_nr_t::segment_list_t& segment_list) const;
+  void insert_received_segment(rlc_amd_rx_pdu_nr segment, rlc_amd_rx_sdu_nr_t::segment_list_t& segment_list);
   /**
    * @brief update_segment_inventory This function updates the flags has_gap and fully_received of an SDU
    * according to the current inventory of received SDU segments
@@ -279,7 +280,8 @@ private:
   uint32_t mod_nr = cardinality(rlc_am_nr_sn_size_t());
   uint32_t rx_mod_base_nr(uint32_t sn) const;
 
-  // RX Window
+  // RX Window. The segments of the SDUs are stored in nodes of the segment pool, which must outlive them
+  rlc_am_rx_segment_pool<rlc_amd_rx_pdu_nr>                  rx_segment_pool;
   std::unique_ptr<rlc_ringbuffer_base<rlc_amd_rx_sdu_nr_t> > rx_window;
 
   // Mutexes
@@ -24,7 +24,7 @@
 
 #include "srsran/common/string_helpers.h"
 #include "srsran/rlc/rlc_am_base.h"
-#include <set>
+#include "srsran/rlc/rlc_am_data_structs.h"
 
 namespace srsran {
 
@@ -63,17 +63,13 @@ struct rlc_amd_rx_pdu_nr {
   explicit rlc_amd_rx_pdu_nr(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
 };
 
-struct rlc_amd_rx_pdu_nr_cmp {
-  bool operator()(const rlc_amd_rx_pdu_nr& a, const rlc_amd_rx_pdu_nr& b) const { return a.header.so < b.header.so; }
-};
-
 struct rlc_amd_rx_sdu_nr_t {
   uint32_t             rlc_sn         = 0;
   bool                 fully_received = false;
   bool                 has_gap        = false;
   unique_byte_buffer_t buf;
-  using segment_list_t = std::set<rlc_amd_rx_pdu_nr, rlc_amd_rx_pdu_nr_cmp>;
-  segment_list_t segments;
+  using segment_list_t = rlc_am_rx_segment_list<rlc_amd_rx_pdu_nr>;
+  segment_list_t segments; ///< Received segments sorted by SO, released once the SDU is reassembled
 
   rlc_amd_rx_sdu_nr_t() = default;
   explicit rlc_amd_rx_sdu_nr_t(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
@@ -42,6 +42,7 @@ namespace srsran {
 #define RLC_AM_WINDOW_SIZE 512
 #define RLC_MAX_SDU_SIZE ((1 << 11) - 1) // Length of LI field is 11bits
 #define RLC_AM_MIN_DATA_PDU_SIZE (3)     // AMD PDU with 10 bit SN (length of LI field is 11 bits) (No LI)
+#define RLC_MAX_SLICES (16)              // SDU slices of a LTE AM/UM PDU, further SDUs are copied into the last one
 
 #define RLC_AM_NR_TYP_NACKS 512  // Expected number of NACKs in status PDU before expanding space by alloc
 #define RLC_AM_NR_MAX_NACKS 2048 // Maximum number of NACKs in status PDU
@@ -286,9 +287,10 @@ public:
   virtual void                 reset_metrics() = 0;
 
   // PDCP interface
-  virtual void write_sdu(unique_byte_buffer_t sdu) = 0;
-  virtual void discard_sdu(uint32_t discard_sn)    = 0;
-  virtual bool sdu_queue_is_full()                 = 0;
+  virtual void     write_sdu(unique_byte_buffer_t sdu) = 0;
+  virtual void     discard_sdu(uint32_t discard_sn)    = 0;
+  virtual bool     sdu_queue_is_full()                 = 0;
+  virtual uint32_t sdu_queue_free_space()              = 0;
 
   // MAC interface
   virtual bool     has_data() = 0;
@@ -57,8 +57,9 @@ public:
 
   // PDCP interface
   void write_sdu(unique_byte_buffer_t sdu) override;
-  void discard_sdu(uint32_t discard_sn) override;
-  bool sdu_queue_is_full() override;
+  void     discard_sdu(uint32_t discard_sn) override;
+  bool     sdu_queue_is_full() override;
+  uint32_t sdu_queue_free_space() override;
 
   // MAC interface
   bool     has_data() override;
@@ -61,8 +61,9 @@ public:
 
   // PDCP interface
   void write_sdu(unique_byte_buffer_t sdu);
-  void discard_sdu(uint32_t discard_sn);
-  bool sdu_queue_is_full();
+  void     discard_sdu(uint32_t discard_sn);
+  bool     sdu_queue_is_full();
+  uint32_t sdu_queue_free_space();
 
   // MAC interface
   bool     has_data();
@@ -94,6 +95,7 @@ protected:
     void             write_sdu(unique_byte_buffer_t sdu);
     void             discard_sdu(uint32_t discard_sn);
     bool             sdu_queue_is_full();
+    uint32_t         sdu_queue_free_space();
     int              try_write_sdu(unique_byte_buffer_t sdu);
     void             reset_metrics();
     bool             has_data();
@@ -110,9 +112,8 @@ protected:
 
     rlc_config_t cfg = {};
 
-    // TX SDU buffers
-    byte_buffer_queue    tx_sdu_queue;
-    unique_byte_buffer_t tx_sdu;
+    // TX SDU buffers. The SDU being segmented is kept by the subclasses
+    byte_buffer_queue tx_sdu_queue;
 
     // Mutexes
     std::mutex mutex;
@@ -122,11 +123,13 @@ protected:
     srsran::rolling_average<double> mean_pdu_latency_us;
 #endif
 
-    virtual uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes) = 0;
+    virtual uint32_t build_pdu(uint8_t* payload, uint32_t nof_bytes) = 0;
 
     // helper functions
-    virtual void debug_state() = 0;
-    virtual void reset()       = 0;
+    virtual bool has_tx_sdu()   = 0;
+    virtual void clear_tx_sdu() = 0;
+    virtual void debug_state()  = 0;
+    virtual void reset()        = 0;
   };
 
   // Receiver sub-class base
@@ -23,6 +23,7 @@
 #define SRSRAN_RLC_UM_LTE_H
 
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_chain.h"
 #include "srsran/common/common.h"
 #include "srsran/rlc/rlc_um_base.h"
 #include "srsran/upper/byte_buffer_queue.h"
@@ -57,13 +58,19 @@ private:
     rlc_um_lte_tx(rlc_um_base* parent_);
 
     bool     configure(const rlc_config_t& cfg, std::string rb_name);
-    uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
+    uint32_t build_pdu(uint8_t* payload, uint32_t nof_bytes);
     void     discard_sdu(uint32_t discard_sn);
     uint32_t get_buffer_state();
     bool     sdu_queue_is_full();
 
   private:
     void reset();
+    bool has_tx_sdu() final { return not tx_sdu.empty(); }
+    void clear_tx_sdu() final { tx_sdu.clear(); }
+
+    // The part of the SDU that has not been sent yet and the SDU segments of the PDU being built, which share its buffer
+    byte_buffer_slice                 tx_sdu;
+    byte_buffer_chain<RLC_MAX_SLICES> tx_pdu_data;
 
     /****************************************************************************
      * State variables and counters
@@ -128,6 +135,7 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
                                  rlc_umd_sn_size_t     sn_size,
                                  rlc_umd_pdu_header_t* header);
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu);
+void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t** payload);
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header);
 bool     rlc_um_start_aligned(uint8_t fi);
@@ -61,12 +61,17 @@ private:
     rlc_um_nr_tx(rlc_um_base* parent_);
 
     bool     configure(const rlc_config_t& cfg, std::string rb_name);
-    uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
+    uint32_t build_pdu(uint8_t* payload, uint32_t nof_bytes);
     void     discard_sdu(uint32_t discard_sn);
     uint32_t get_buffer_state();
 
   private:
     void reset();
+    bool has_tx_sdu() final { return tx_sdu != nullptr; }
+    void clear_tx_sdu() final { tx_sdu.reset(); }
+
+    // The part of the SDU that has not been sent yet
+    unique_byte_buffer_t tx_sdu;
 
     uint32_t TX_Next = 0; // send state as defined in TS 38.322 v15.3 Section 7
                           // It holds the value of the SN to be assigned for the next newly generated UMD PDU with
@@ -115,6 +120,9 @@ private:
     uint32_t UM_Window_Size = 0;
     uint32_t mod            = 0; // Rx counter modulus
 
+    // RX SDU buffers
+    unique_byte_buffer_t rx_sdu;
+
     // Rx window
     typedef struct {
       std::map<uint32_t, rlc_umd_pdu_nr_t> segments; // Map of segments with SO as key
@@ -27,7 +27,17 @@
 
 namespace srsran {
 
-constexpr uint32_t metrics_max_supported_cpu = 32u;
+constexpr uint32_t metrics_max_supported_cpu            = 32u;
+constexpr uint32_t metrics_max_byte_buffer_size_classes = 3u;
+
+/// Usage of the pool backing one byte buffer size class.
+struct byte_buffer_pool_class_metrics_t {
+  uint32_t payload_size       = 0;
+  uint32_t block_size         = 0;
+  uint32_t nof_used           = 0;
+  uint32_t max_used           = 0;
+  uint32_t nof_alloc_failures = 0;
+};
 
 /// Metrics of cpu usage, memory consumption and number of thread used by the process.
 struct sys_metrics_t {
@@ -39,6 +49,8 @@ struct sys_metrics_t {
   float                                        system_mem            = 0.f;
   uint32_t                                     cpu_count             = 0;
   std::array<float, metrics_max_supported_cpu> cpu_load              = {};
+  /// Byte buffer pool usage, indexed by size class.
+  std::array<byte_buffer_pool_class_metrics_t, metrics_max_byte_buffer_size_classes> buffer_pool = {};
 };
 
 } // namespace srsran
@@ -81,6 +81,12 @@ public:
 
   bool is_full() { return queue.full(); }
 
+  uint32_t free_space()
+  {
+    uint32_t max_size = (uint32_t)queue.max_size(), cur_size = size();
+    return max_size > cur_size ? max_size - cur_size : 0;
+  }
+
   template <typename F>
   bool apply_first(const F& func)
   {
@@ -27,9 +27,16 @@
 #include "srsran/interfaces/ue_pdcp_interfaces.h"
 #include "srsran/upper/pdcp_entity_lte.h"
 #include <set>
+#include <vector>
 
 namespace srsran {
 
+/// SDU tagged with the LCID of its bearer, for the batch interface.
+struct pdcp_sdu_t {
+  uint32_t             lcid;
+  unique_byte_buffer_t sdu;
+};
+
 class pdcp : public srsue::pdcp_interface_rlc, public srsue::pdcp_interface_rrc
 {
 public:
@@ -48,6 +55,8 @@ public:
   void set_enabled(uint32_t lcid, bool enabled) override;
   void write_sdu(uint32_t lcid, unique_byte_buffer_t sdu, int sn = -1) override;
   void write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu);
+  void write_sdu_batch(uint32_t lcid, std::vector<unique_byte_buffer_t>& sdus);
+  void write_sdu_batch(std::vector<pdcp_sdu_t>& sdus);
   int  add_bearer(uint32_t lcid, const pdcp_config_t& cnfg) override;
   void add_bearer_mrb(uint32_t lcid, const pdcp_config_t& cnfg);
   void del_bearer(uint32_t lcid) override;
@@ -92,6 +101,9 @@ private:
   std::mutex         cache_mutex;
   std::set<uint32_t> valid_lcids_cached;
 
+  // SDUs of the bearer being processed by the mixed bearer batch interface
+  std::vector<unique_byte_buffer_t> batch_sdus;
+
   bool valid_lcid(uint32_t lcid);
   bool valid_mch_lcid(uint32_t lcid);
 
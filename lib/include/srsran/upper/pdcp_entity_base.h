@@ -23,6 +23,7 @@
 #define SRSRAN_PDCP_ENTITY_BASE_H
 
 #include "srsran/adt/accumulators.h"
+#include "srsran/adt/span.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/interfaces_common.h"
@@ -120,6 +121,9 @@ public:
 
   // GW/SDAP/RRC interface
   virtual void write_sdu(unique_byte_buffer_t sdu, int sn = -1) = 0;
+  // Writes a burst of SDUs in a single pass, so that ciphering and integrity protection can be applied to all of them
+  // at once. The SDUs are moved out of the span.
+  virtual void write_sdu_batch(span<unique_byte_buffer_t> sdus);
 
   // RLC interface
   virtual void write_pdu(unique_byte_buffer_t pdu)               = 0;
@@ -169,12 +173,21 @@ protected:
 
   srsran::as_security_config_t sec_cfg = {};
 
+  // Key schedules of the AES based algorithms, precomputed from sec_cfg once per key
+  srsran::security_aes_ctx_t int_aes_ctx;
+  srsran::security_aes_ctx_t enc_aes_ctx;
+
   // Security functions
   void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
   bool integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
   void cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* ct);
   void cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t count, uint8_t* msg);
 
+  // Batched security functions, in TX direction. The COUNT, message and output of each PDU must be filled in by the
+  // caller, the bearer and direction are taken from the bearer config.
+  void integrity_generate_batch(security_pdu_t* pdus, uint32_t nof_pdus);
+  void cipher_encrypt_batch(security_pdu_t* pdus, uint32_t nof_pdus);
+
   // Common packing functions
   bool            is_control_pdu(const unique_byte_buffer_t& pdu);
   pdcp_pdu_type_t get_control_pdu_type(const unique_byte_buffer_t& pdu);
@@ -182,7 +195,7 @@ protected:
   void            discard_data_header(const unique_byte_buffer_t& pdu);
   void            write_data_header(const srsran::unique_byte_buffer_t& sdu, uint32_t count);
   void            extract_mac(const unique_byte_buffer_t& pdu, uint8_t* mac);
-  void            append_mac(const unique_byte_buffer_t& sdu, uint8_t* mac);
+  void            append_mac(unique_byte_buffer_t& sdu, uint8_t* mac);
 
   // Metrics helpers
   pdcp_bearer_metrics_t           metrics = {};
@@ -126,6 +126,7 @@ public:
 
   // GW/RRC interface
   void write_sdu(unique_byte_buffer_t sdu, int sn = -1) override;
+  void write_sdu_batch(span<unique_byte_buffer_t> sdus) override;
 
   // RLC interface
   void write_pdu(unique_byte_buffer_t pdu) override;
@@ -166,6 +167,22 @@ private:
   uint32_t reordering_window = 0;
   uint32_t maximum_pdcp_sn   = 0;
 
+  // TX helpers, shared by the single SDU and batch paths
+  struct tx_pdu_info_t {
+    uint32_t sn;
+    uint32_t count;
+    bool     do_integrity;
+    bool     do_encryption;
+    uint8_t  mac[4];
+  };
+  bool tx_allowed();
+  bool prepare_tx_pdu(unique_byte_buffer_t& sdu, int upper_sn, tx_pdu_info_t& info);
+  void send_tx_pdu(unique_byte_buffer_t sdu, const tx_pdu_info_t& info);
+
+  // Scratch buffers of the batch TX path, kept across calls to avoid reallocations
+  std::vector<tx_pdu_info_t>  tx_batch_info;
+  std::vector<security_pdu_t> tx_batch_sec;
+
   // PDU handlers
   void handle_control_pdu(srsran::unique_byte_buffer_t pdu);
   void handle_srb_pdu(srsran::unique_byte_buffer_t pdu);
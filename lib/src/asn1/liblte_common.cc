@@ -134,6 +134,21 @@ void liblte_unpack(uint8_t* bytes, uint32_t n_bytes, uint8_t* bits)
   }
 }
 
+/*********************************************************************
+    Name: liblte_reset_byte_msg
+
+    Description: Clears the length and payload of a byte message,
+                 leaving the header region untouched as it may hold
+                 the metadata of an overlaid byte_buffer_t. The whole
+                 LIBLTE_MAX_MSG_SIZE_BYTES payload is cleared, so an
+                 overlaid byte_buffer_t must be of the large size class
+*********************************************************************/
+void liblte_reset_byte_msg(LIBLTE_BYTE_MSG_STRUCT* msg)
+{
+  msg->N_bytes = 0;
+  memset(msg->msg, 0, sizeof(msg->msg));
+}
+
 /*********************************************************************
     Name: liblte_align_up
 
@@ -4444,7 +4444,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_security_protected_nas_msg(LIBLTE_BYTE_MSG_STR
                                                              uint32                  count,
                                                              LIBLTE_BYTE_MSG_STRUCT* sec_msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = sec_msg->msg;
   uint32            i;
@@ -4491,7 +4491,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_attach_accept_msg(LIBLTE_MME_ATTACH_ACCEPT_MSG
                                                     uint32                               count,
                                                     LIBLTE_BYTE_MSG_STRUCT*              msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -4766,7 +4766,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_attach_complete_msg(LIBLTE_MME_ATTACH_COMPLETE
                                                       uint32                                 count,
                                                       LIBLTE_BYTE_MSG_STRUCT*                msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -4842,7 +4842,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_attach_complete_msg(LIBLTE_BYTE_MSG_STRUCT*
 LIBLTE_ERROR_ENUM liblte_mme_pack_attach_reject_msg(LIBLTE_MME_ATTACH_REJECT_MSG_STRUCT* attach_rej,
                                                     LIBLTE_BYTE_MSG_STRUCT*              msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -4937,7 +4937,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_attach_reject_msg(LIBLTE_BYTE_MSG_STRUCT*
 LIBLTE_ERROR_ENUM liblte_mme_pack_attach_request_msg(LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT* attach_req,
                                                      LIBLTE_BYTE_MSG_STRUCT*               msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   return liblte_mme_pack_attach_request_msg(attach_req, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, msg);
 }
 
@@ -4946,7 +4946,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_attach_request_msg(LIBLTE_MME_ATTACH_REQUEST_M
                                                      uint32                                count,
                                                      LIBLTE_BYTE_MSG_STRUCT*               msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -5306,7 +5306,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_attach_request_msg(LIBLTE_BYTE_MSG_STRUCT*
 LIBLTE_ERROR_ENUM liblte_mme_pack_authentication_failure_msg(LIBLTE_MME_AUTHENTICATION_FAILURE_MSG_STRUCT* auth_fail,
                                                              LIBLTE_BYTE_MSG_STRUCT*                       msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -5386,7 +5386,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_authentication_failure_msg(LIBLTE_BYTE_MSG_S
 LIBLTE_ERROR_ENUM liblte_mme_pack_authentication_reject_msg(LIBLTE_MME_AUTHENTICATION_REJECT_MSG_STRUCT* auth_reject,
                                                             LIBLTE_BYTE_MSG_STRUCT*                      msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -5443,7 +5443,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_authentication_reject_msg(LIBLTE_BYTE_MSG_ST
 LIBLTE_ERROR_ENUM liblte_mme_pack_authentication_request_msg(LIBLTE_MME_AUTHENTICATION_REQUEST_MSG_STRUCT* auth_req,
                                                              LIBLTE_BYTE_MSG_STRUCT*                       msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -5523,7 +5523,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_authentication_response_msg(LIBLTE_MME_AUTHENT
                                                               uint32                  count,
                                                               LIBLTE_BYTE_MSG_STRUCT* msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -5614,7 +5614,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_detach_accept_msg(LIBLTE_MME_DETACH_ACCEPT_MSG
                                                     uint32                               count,
                                                     LIBLTE_BYTE_MSG_STRUCT*              msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -5686,7 +5686,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_detach_request_msg(LIBLTE_MME_DETACH_REQUEST_M
                                                      uint32                                count,
                                                      LIBLTE_BYTE_MSG_STRUCT*               msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -5776,7 +5776,7 @@ liblte_mme_pack_downlink_nas_transport_msg(LIBLTE_MME_DOWNLINK_NAS_TRANSPORT_MSG
                                            uint32                                        count,
                                            LIBLTE_BYTE_MSG_STRUCT*                       msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -5855,7 +5855,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_emm_information_msg(LIBLTE_MME_EMM_INFORMATION
                                                       uint32                                 count,
                                                       LIBLTE_BYTE_MSG_STRUCT*                msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -6007,7 +6007,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_emm_status_msg(LIBLTE_MME_EMM_STATUS_MSG_STRUC
                                                  uint32                            count,
                                                  LIBLTE_BYTE_MSG_STRUCT*           msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -6092,7 +6092,7 @@ liblte_mme_pack_extended_service_request_msg(LIBLTE_MME_EXTENDED_SERVICE_REQUEST
                                              uint32                                          count,
                                              LIBLTE_BYTE_MSG_STRUCT*                         msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -6231,7 +6231,7 @@ liblte_mme_pack_guti_reallocation_command_msg(LIBLTE_MME_GUTI_REALLOCATION_COMMA
                                               uint32                                           count,
                                               LIBLTE_BYTE_MSG_STRUCT*                          msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -6327,7 +6327,7 @@ liblte_mme_pack_guti_reallocation_complete_msg(LIBLTE_MME_GUTI_REALLOCATION_COMP
                                                uint32                                            count,
                                                LIBLTE_BYTE_MSG_STRUCT*                           msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -6398,7 +6398,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_guti_reallocation_complete_msg(
 LIBLTE_ERROR_ENUM liblte_mme_pack_identity_request_msg(LIBLTE_MME_ID_REQUEST_MSG_STRUCT* id_req,
                                                        LIBLTE_BYTE_MSG_STRUCT*           msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -6466,7 +6466,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_identity_response_msg(LIBLTE_MME_ID_RESPONSE_M
                                                         uint32                             count,
                                                         LIBLTE_BYTE_MSG_STRUCT*            msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -6545,7 +6545,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_security_mode_command_msg(LIBLTE_MME_SECURITY_
                                                             uint32                                       count,
                                                             LIBLTE_BYTE_MSG_STRUCT*                      msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -6687,7 +6687,7 @@ liblte_mme_pack_security_mode_complete_msg(LIBLTE_MME_SECURITY_MODE_COMPLETE_MSG
                                            uint32                                        count,
                                            LIBLTE_BYTE_MSG_STRUCT*                       msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -6775,7 +6775,7 @@ liblte_mme_unpack_security_mode_complete_msg(LIBLTE_BYTE_MSG_STRUCT*
 LIBLTE_ERROR_ENUM liblte_mme_pack_security_mode_reject_msg(LIBLTE_MME_SECURITY_MODE_REJECT_MSG_STRUCT* sec_mode_rej,
                                                            LIBLTE_BYTE_MSG_STRUCT*                     msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -6840,7 +6840,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_service_reject_msg(LIBLTE_MME_SERVICE_REJECT_M
                                                      uint32                                count,
                                                      LIBLTE_BYTE_MSG_STRUCT*               msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -6949,7 +6949,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_service_reject_msg(LIBLTE_BYTE_MSG_STRUCT*
 LIBLTE_ERROR_ENUM liblte_mme_pack_service_request_msg(LIBLTE_MME_SERVICE_REQUEST_MSG_STRUCT* service_req,
                                                       LIBLTE_BYTE_MSG_STRUCT*                msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -7009,7 +7009,7 @@ liblte_mme_pack_tracking_area_update_accept_msg(LIBLTE_MME_TRACKING_AREA_UPDATE_
                                                 uint32                                             count,
                                                 LIBLTE_BYTE_MSG_STRUCT*                            msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -7390,7 +7390,7 @@ liblte_mme_pack_tracking_area_update_reject_msg(LIBLTE_MME_TRACKING_AREA_UPDATE_
                                                 uint32                                             count,
                                                 LIBLTE_BYTE_MSG_STRUCT*                            msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -7495,7 +7495,7 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_uplink_nas_transport_msg(LIBLTE_MME_UPLINK_NAS
                                                            uint32                                      count,
                                                            LIBLTE_BYTE_MSG_STRUCT*                     msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -9162,7 +9162,7 @@ srsran_mme_pack_esm_information_request_msg(LIBLTE_MME_ESM_INFORMATION_REQUEST_M
                                             uint32                                         count,
                                             LIBLTE_BYTE_MSG_STRUCT*                        msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -9213,7 +9213,7 @@ LIBLTE_ERROR_ENUM
 liblte_mme_pack_esm_information_request_msg(LIBLTE_MME_ESM_INFORMATION_REQUEST_MSG_STRUCT* esm_info_req,
                                             LIBLTE_BYTE_MSG_STRUCT*                        msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -9288,7 +9288,7 @@ liblte_mme_pack_esm_information_response_msg(LIBLTE_MME_ESM_INFORMATION_RESPONSE
                                              uint32                                          count,
                                              LIBLTE_BYTE_MSG_STRUCT*                         msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -9447,7 +9447,7 @@ liblte_mme_unpack_esm_information_response_msg(LIBLTE_BYTE_MSG_STRUCT*
 LIBLTE_ERROR_ENUM liblte_mme_pack_esm_status_msg(LIBLTE_MME_ESM_STATUS_MSG_STRUCT* esm_status,
                                                  LIBLTE_BYTE_MSG_STRUCT*           msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -9888,7 +9888,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_modify_eps_bearer_context_request_msg(
 LIBLTE_ERROR_ENUM liblte_mme_pack_notification_msg(LIBLTE_MME_NOTIFICATION_MSG_STRUCT* notification,
                                                    LIBLTE_BYTE_MSG_STRUCT*             msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -9955,7 +9955,7 @@ LIBLTE_ERROR_ENUM
 liblte_mme_pack_pdn_connectivity_reject_msg(LIBLTE_MME_PDN_CONNECTIVITY_REJECT_MSG_STRUCT* pdn_con_rej,
                                             LIBLTE_BYTE_MSG_STRUCT*                        msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -10055,7 +10055,7 @@ LIBLTE_ERROR_ENUM
 liblte_mme_pack_pdn_connectivity_request_msg(LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT* pdn_con_req,
                                              LIBLTE_BYTE_MSG_STRUCT*                         msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -10191,7 +10191,7 @@ liblte_mme_unpack_pdn_connectivity_request_msg(LIBLTE_BYTE_MSG_STRUCT*
 LIBLTE_ERROR_ENUM liblte_mme_pack_pdn_disconnect_reject_msg(LIBLTE_MME_PDN_DISCONNECT_REJECT_MSG_STRUCT* pdn_discon_rej,
                                                             LIBLTE_BYTE_MSG_STRUCT*                      msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -10275,7 +10275,7 @@ LIBLTE_ERROR_ENUM
 liblte_mme_pack_pdn_disconnect_request_msg(LIBLTE_MME_PDN_DISCONNECT_REQUEST_MSG_STRUCT* pdn_discon_req,
                                            LIBLTE_BYTE_MSG_STRUCT*                       msg)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -10353,7 +10353,7 @@ liblte_mme_unpack_pdn_disconnect_request_msg(LIBLTE_BYTE_MSG_STRUCT*
 LIBLTE_ERROR_ENUM
 liblte_mme_pack_activate_test_mode_complete_msg(LIBLTE_BYTE_MSG_STRUCT* msg, uint8 sec_hdr_type, uint32 count)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -10392,7 +10392,7 @@ liblte_mme_pack_activate_test_mode_complete_msg(LIBLTE_BYTE_MSG_STRUCT* msg, uin
 LIBLTE_ERROR_ENUM
 liblte_mme_pack_close_ue_test_loop_complete_msg(LIBLTE_BYTE_MSG_STRUCT* msg, uint8 sec_hdr_type, uint32 count)
 {
-  bzero(msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+  liblte_reset_byte_msg(msg);
   LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
   uint8*            msg_ptr = msg->msg;
 
@@ -0,0 +1,400 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/aes.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define AES_HAVE_X86_INTRINSICS
+#include <immintrin.h>
+#endif
+
+namespace srsran {
+
+const char* to_string(aes_impl_t impl)
+{
+  switch (impl) {
+    case aes_impl_t::generic:
+      return "generic";
+    case aes_impl_t::aesni:
+      return "AES-NI";
+    case aes_impl_t::vaes:
+      return "VAES";
+    default:
+      break;
+  }
+  return "invalid";
+}
+
+namespace {
+
+/// Number of blocks encrypted in parallel in CTR mode, to hide the latency of the AES rounds.
+const uint32_t ctr_nof_parallel_blocks = 4;
+
+/// Writes \c nof_blocks consecutive counter blocks, starting at the 128-bit big-endian counter (hi, lo).
+void fill_ctr_blocks(uint64_t& hi, uint64_t& lo, uint8_t* blocks, uint32_t nof_blocks)
+{
+  for (uint32_t i = 0; i < nof_blocks; ++i) {
+    for (uint32_t j = 0; j < 8; ++j) {
+      blocks[16 * i + j]     = (uint8_t)(hi >> (56 - 8 * j));
+      blocks[16 * i + 8 + j] = (uint8_t)(lo >> (56 - 8 * j));
+    }
+    if (++lo == 0) {
+      ++hi;
+    }
+  }
+}
+
+void load_ctr(const uint8_t* counter, uint64_t& hi, uint64_t& lo)
+{
+  hi = 0;
+  lo = 0;
+  for (uint32_t j = 0; j < 8; ++j) {
+    hi = (hi << 8) | counter[j];
+    lo = (lo << 8) | counter[8 + j];
+  }
+}
+
+void xor_bytes(const uint8_t* a, const uint8_t* b, uint8_t* out, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; ++i) {
+    out[i] = a[i] ^ b[i];
+  }
+}
+
+#ifdef AES_HAVE_X86_INTRINSICS
+
+#define AES_TARGET_AESNI __attribute__((target("aes,sse4.1")))
+#define AES_TARGET_VAES __attribute__((target("aes,sse4.1,avx512f,avx512bw,vaes")))
+
+AES_TARGET_AESNI inline __m128i aesni_expand_step(__m128i key, __m128i keygened)
+{
+  keygened = _mm_shuffle_epi32(keygened, _MM_SHUFFLE(3, 3, 3, 3));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, keygened);
+}
+
+#define AESNI_EXPAND(k, rcon) aesni_expand_step(k, _mm_aeskeygenassist_si128(k, rcon))
+
+AES_TARGET_AESNI void aesni_key_expansion(const uint8_t* key, uint8_t* round_keys)
+{
+  __m128i* rk = (__m128i*)round_keys;
+  rk[0]       = _mm_loadu_si128((const __m128i*)key);
+  rk[1]       = AESNI_EXPAND(rk[0], 0x01);
+  rk[2]       = AESNI_EXPAND(rk[1], 0x02);
+  rk[3]       = AESNI_EXPAND(rk[2], 0x04);
+  rk[4]       = AESNI_EXPAND(rk[3], 0x08);
+  rk[5]       = AESNI_EXPAND(rk[4], 0x10);
+  rk[6]       = AESNI_EXPAND(rk[5], 0x20);
+  rk[7]       = AESNI_EXPAND(rk[6], 0x40);
+  rk[8]       = AESNI_EXPAND(rk[7], 0x80);
+  rk[9]       = AESNI_EXPAND(rk[8], 0x1b);
+  rk[10]      = AESNI_EXPAND(rk[9], 0x36);
+}
+
+AES_TARGET_AESNI inline __m128i aesni_encrypt(const __m128i* rk, __m128i b)
+{
+  b = _mm_xor_si128(b, rk[0]);
+  for (uint32_t r = 1; r < 10; ++r) {
+    b = _mm_aesenc_si128(b, rk[r]);
+  }
+  return _mm_aesenclast_si128(b, rk[10]);
+}
+
+AES_TARGET_AESNI void aesni_encrypt_block(const uint8_t* round_keys, const uint8_t* in, uint8_t* out)
+{
+  __m128i b = aesni_encrypt((const __m128i*)round_keys, _mm_loadu_si128((const __m128i*)in));
+  _mm_storeu_si128((__m128i*)out, b);
+}
+
+AES_TARGET_AESNI void
+aesni_ctr_crypt(const uint8_t* round_keys, uint64_t& hi, uint64_t& lo, const uint8_t* in, uint8_t* out, uint32_t len)
+{
+  const __m128i* rk = (const __m128i*)round_keys;
+  alignas(16) uint8_t ctr[16 * ctr_nof_parallel_blocks];
+
+  // Byte reversal of a 128-bit lane, turning the little-endian (lo, hi) counter into a big-endian counter block
+  const __m128i bswap = _mm_set_epi64x(0x0001020304050607, 0x08090a0b0c0d0e0f);
+  const __m128i one   = _mm_set_epi64x(0, 1);
+
+  while (len >= 16 * ctr_nof_parallel_blocks) {
+    __m128i c0, c1, c2, c3;
+    if (lo <= UINT64_MAX - ctr_nof_parallel_blocks) {
+      // The lower half of the counter does not wrap, so the blocks are computed with 64-bit additions
+      c0 = _mm_set_epi64x((long long)hi, (long long)lo);
+      c1 = _mm_add_epi64(c0, one);
+      c2 = _mm_add_epi64(c1, one);
+      c3 = _mm_add_epi64(c2, one);
+      c0 = _mm_shuffle_epi8(c0, bswap);
+      c1 = _mm_shuffle_epi8(c1, bswap);
+      c2 = _mm_shuffle_epi8(c2, bswap);
+      c3 = _mm_shuffle_epi8(c3, bswap);
+      lo += ctr_nof_parallel_blocks;
+    } else {
+      fill_ctr_blocks(hi, lo, ctr, ctr_nof_parallel_blocks);
+      c0 = _mm_load_si128((const __m128i*)&ctr[0]);
+      c1 = _mm_load_si128((const __m128i*)&ctr[16]);
+      c2 = _mm_load_si128((const __m128i*)&ctr[32]);
+      c3 = _mm_load_si128((const __m128i*)&ctr[48]);
+    }
+    __m128i b0 = _mm_xor_si128(c0, rk[0]);
+    __m128i b1 = _mm_xor_si128(c1, rk[0]);
+    __m128i b2 = _mm_xor_si128(c2, rk[0]);
+    __m128i b3 = _mm_xor_si128(c3, rk[0]);
+    for (uint32_t r = 1; r < 10; ++r) {
+      b0 = _mm_aesenc_si128(b0, rk[r]);
+      b1 = _mm_aesenc_si128(b1, rk[r]);
+      b2 = _mm_aesenc_si128(b2, rk[r]);
+      b3 = _mm_aesenc_si128(b3, rk[r]);
+    }
+    b0 = _mm_aesenclast_si128(b0, rk[10]);
+    b1 = _mm_aesenclast_si128(b1, rk[10]);
+    b2 = _mm_aesenclast_si128(b2, rk[10]);
+    b3 = _mm_aesenclast_si128(b3, rk[10]);
+    _mm_storeu_si128((__m128i*)&out[0], _mm_xor_si128(b0, _mm_loadu_si128((const __m128i*)&in[0])));
+    _mm_storeu_si128((__m128i*)&out[16], _mm_xor_si128(b1, _mm_loadu_si128((const __m128i*)&in[16])));
+    _mm_storeu_si128((__m128i*)&out[32], _mm_xor_si128(b2, _mm_loadu_si128((const __m128i*)&in[32])));
+    _mm_storeu_si128((__m128i*)&out[48], _mm_xor_si128(b3, _mm_loadu_si128((const __m128i*)&in[48])));
+    in += 16 * ctr_nof_parallel_blocks;
+    out += 16 * ctr_nof_parallel_blocks;
+    len -= 16 * ctr_nof_parallel_blocks;
+  }
+
+  while (len > 0) {
+    fill_ctr_blocks(hi, lo, ctr, 1);
+    __m128i ks = aesni_encrypt(rk, _mm_load_si128((const __m128i*)ctr));
+    if (len >= 16) {
+      _mm_storeu_si128((__m128i*)out, _mm_xor_si128(ks, _mm_loadu_si128((const __m128i*)in)));
+      in += 16;
+      out += 16;
+      len -= 16;
+    } else {
+      _mm_store_si128((__m128i*)ctr, ks);
+      xor_bytes(in, ctr, out, len);
+      len = 0;
+    }
+  }
+}
+
+AES_TARGET_VAES void
+vaes_ctr_crypt(const uint8_t* round_keys, uint64_t& hi, uint64_t& lo, const uint8_t* in, uint8_t* out, uint32_t len)
+{
+  // Each 512-bit register holds 4 counter blocks, and 4 registers are processed in parallel
+  const uint32_t      nof_blocks = 16;
+  alignas(64) uint8_t ctr[16 * nof_blocks];
+  alignas(64) uint8_t rk_lanes[64 * 11];
+  __m512i             rk[11];
+  for (uint32_t r = 0; r < 11; ++r) {
+    for (uint32_t lane = 0; lane < 4; ++lane) {
+      memcpy(&rk_lanes[64 * r + 16 * lane], &round_keys[16 * r], 16);
+    }
+    rk[r] = _mm512_load_si512(&rk_lanes[64 * r]);
+  }
+
+  const __m512i bswap = _mm512_set_epi64(0x0001020304050607,
+                                         0x08090a0b0c0d0e0f,
+                                         0x0001020304050607,
+                                         0x08090a0b0c0d0e0f,
+                                         0x0001020304050607,
+                                         0x08090a0b0c0d0e0f,
+                                         0x0001020304050607,
+                                         0x08090a0b0c0d0e0f);
+  const __m512i four  = _mm512_set_epi64(0, 4, 0, 4, 0, 4, 0, 4);
+
+  while (len >= 16 * nof_blocks) {
+    __m512i c0, c1, c2, c3;
+    if (lo <= UINT64_MAX - nof_blocks) {
+      long long h = (long long)hi, l = (long long)lo;
+      c0          = _mm512_add_epi64(_mm512_set_epi64(h, l, h, l, h, l, h, l), _mm512_set_epi64(0, 3, 0, 2, 0, 1, 0, 0));
+      c1          = _mm512_add_epi64(c0, four);
+      c2          = _mm512_add_epi64(c1, four);
+      c3          = _mm512_add_epi64(c2, four);
+      c0          = _mm512_shuffle_epi8(c0, bswap);
+      c1          = _mm512_shuffle_epi8(c1, bswap);
+      c2          = _mm512_shuffle_epi8(c2, bswap);
+      c3          = _mm512_shuffle_epi8(c3, bswap);
+      lo += nof_blocks;
+    } else {
+      fill_ctr_blocks(hi, lo, ctr, nof_blocks);
+      c0 = _mm512_load_si512(&ctr[0]);
+      c1 = _mm512_load_si512(&ctr[64]);
+      c2 = _mm512_load_si512(&ctr[128]);
+      c3 = _mm512_load_si512(&ctr[192]);
+    }
+    __m512i b0 = _mm512_xor_si512(c0, rk[0]);
+    __m512i b1 = _mm512_xor_si512(c1, rk[0]);
+    __m512i b2 = _mm512_xor_si512(c2, rk[0]);
+    __m512i b3 = _mm512_xor_si512(c3, rk[0]);
+    for (uint32_t r = 1; r < 10; ++r) {
+      b0 = _mm512_aesenc_epi128(b0, rk[r]);
+      b1 = _mm512_aesenc_epi128(b1, rk[r]);
+      b2 = _mm512_aesenc_epi128(b2, rk[r]);
+      b3 = _mm512_aesenc_epi128(b3, rk[r]);
+    }
+    b0 = _mm512_aesenclast_epi128(b0, rk[10]);
+    b1 = _mm512_aesenclast_epi128(b1, rk[10]);
+    b2 = _mm512_aesenclast_epi128(b2, rk[10]);
+    b3 = _mm512_aesenclast_epi128(b3, rk[10]);
+    _mm512_storeu_si512(&out[0], _mm512_xor_si512(b0, _mm512_loadu_si512(&in[0])));
+    _mm512_storeu_si512(&out[64], _mm512_xor_si512(b1, _mm512_loadu_si512(&in[64])));
+    _mm512_storeu_si512(&out[128], _mm512_xor_si512(b2, _mm512_loadu_si512(&in[128])));
+    _mm512_storeu_si512(&out[192], _mm512_xor_si512(b3, _mm512_loadu_si512(&in[192])));
+    in += 16 * nof_blocks;
+    out += 16 * nof_blocks;
+    len -= 16 * nof_blocks;
+  }
+
+  // Remainder is handled by the 128-bit path
+  aesni_ctr_crypt(round_keys, hi, lo, in, out, len);
+}
+
+AES_TARGET_AESNI void aesni_cbc_mac(const uint8_t* round_keys, uint8_t* state, const uint8_t* in, uint32_t nof_blocks)
+{
+  const __m128i* rk = (const __m128i*)round_keys;
+  __m128i        t  = _mm_loadu_si128((const __m128i*)state);
+  for (uint32_t i = 0; i < nof_blocks; ++i) {
+    t = aesni_encrypt(rk, _mm_xor_si128(t, _mm_loadu_si128((const __m128i*)&in[16 * i])));
+  }
+  _mm_storeu_si128((__m128i*)state, t);
+}
+
+#endif // AES_HAVE_X86_INTRINSICS
+
+} // namespace
+
+aes128_ctx::aes128_ctx()
+{
+  aes_init(&sw_ctx);
+}
+
+aes128_ctx::~aes128_ctx()
+{
+  aes_free(&sw_ctx);
+}
+
+aes128_ctx::aes128_ctx(const aes128_ctx& other)
+{
+  aes_init(&sw_ctx);
+  *this = other;
+}
+
+aes128_ctx& aes128_ctx::operator=(const aes128_ctx& other)
+{
+  if (this != &other) {
+    // The mbedtls context may hold pointers into itself, so the key schedule is recomputed instead of copied
+    set_key(other.key);
+    set_impl(other.impl);
+  }
+  return *this;
+}
+
+aes_impl_t aes128_ctx::get_best_impl()
+{
+#ifdef AES_HAVE_X86_INTRINSICS
+  static const aes_impl_t best = __builtin_cpu_supports("vaes") && __builtin_cpu_supports("avx512f") &&
+                                         __builtin_cpu_supports("avx512bw")
+                                     ? aes_impl_t::vaes
+                                     : (__builtin_cpu_supports("aes") && __builtin_cpu_supports("sse4.1")
+                                            ? aes_impl_t::aesni
+                                            : aes_impl_t::generic);
+  return best;
+#else
+  return aes_impl_t::generic;
+#endif
+}
+
+void aes128_ctx::set_key(const uint8_t* key_)
+{
+  memcpy(key, key_, sizeof(key));
+  aes_setkey_enc(&sw_ctx, key, 128);
+#ifdef AES_HAVE_X86_INTRINSICS
+  if (get_best_impl() != aes_impl_t::generic) {
+    aesni_key_expansion(key, round_keys);
+  }
+#endif
+  impl = get_best_impl();
+}
+
+aes_impl_t aes128_ctx::set_impl(aes_impl_t impl_)
+{
+  impl = (impl_ <= get_best_impl()) ? impl_ : get_best_impl();
+  return impl;
+}
+
+void aes128_ctx::encrypt_block(const uint8_t* in, uint8_t* out) const
+{
+#ifdef AES_HAVE_X86_INTRINSICS
+  if (impl != aes_impl_t::generic) {
+    aesni_encrypt_block(round_keys, in, out);
+    return;
+  }
+#endif
+  aes_crypt_ecb(&sw_ctx, AES_ENCRYPT, in, out);
+}
+
+void aes128_ctx::ctr_crypt(const uint8_t* counter, const uint8_t* in, uint8_t* out, uint32_t len) const
+{
+  uint64_t hi = 0, lo = 0;
+  load_ctr(counter, hi, lo);
+
+#ifdef AES_HAVE_X86_INTRINSICS
+  if (impl == aes_impl_t::vaes) {
+    vaes_ctr_crypt(round_keys, hi, lo, in, out, len);
+    return;
+  }
+  if (impl == aes_impl_t::aesni) {
+    aesni_ctr_crypt(round_keys, hi, lo, in, out, len);
+    return;
+  }
+#endif
+
+  uint8_t ctr[16];
+  uint8_t ks[16];
+  while (len > 0) {
+    uint32_t n = len < 16 ? len : 16;
+    fill_ctr_blocks(hi, lo, ctr, 1);
+    aes_crypt_ecb(&sw_ctx, AES_ENCRYPT, ctr, ks);
+    xor_bytes(in, ks, out, n);
+    in += n;
+    out += n;
+    len -= n;
+  }
+}
+
+void aes128_ctx::cbc_mac(uint8_t* state, const uint8_t* in, uint32_t nof_blocks) const
+{
+#ifdef AES_HAVE_X86_INTRINSICS
+  if (impl != aes_impl_t::generic) {
+    aesni_cbc_mac(round_keys, state, in, nof_blocks);
+    return;
+  }
+#endif
+
+  uint8_t tmp[16];
+  for (uint32_t i = 0; i < nof_blocks; ++i) {
+    xor_bytes(state, &in[16 * i], tmp, 16);
+    aes_crypt_ecb(&sw_ctx, AES_ENCRYPT, tmp, state);
+  }
+}
+
+} // namespace srsran
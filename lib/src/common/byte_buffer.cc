@@ -21,28 +21,153 @@
 
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/buffer_pool.h"
+#include <atomic>
 
 namespace srsran {
 
-void* byte_buffer_t::operator new(size_t sz, const std::nothrow_t& nothrow_value) noexcept
+constexpr uint32_t byte_buffer_t::headroom;
+
+static_assert(nof_byte_buffer_size_classes <= metrics_max_byte_buffer_size_classes,
+              "Not enough room for byte buffer pool metrics");
+
+namespace {
+
+/// Usage counters of each byte buffer size class.
+struct byte_buffer_class_counters {
+  std::atomic<uint32_t> nof_used{0};
+  std::atomic<uint32_t> max_used{0};
+  std::atomic<uint32_t> nof_alloc_failures{0};
+};
+
+std::array<byte_buffer_class_counters, nof_byte_buffer_size_classes> class_counters;
+
+/// Returns a pointer to the byte_buffer_t stored in the given pool block, after tagging the block with its size class.
+void* tag_byte_buffer_block(void* block, byte_buffer_size_class cls)
 {
-  assert(sz == sizeof(byte_buffer_t));
-  return byte_buffer_pool::get_instance()->allocate_node(sz);
+  byte_buffer_class_counters& c = class_counters[static_cast<uint32_t>(cls)];
+  if (block == nullptr) {
+    c.nof_alloc_failures.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  uint32_t nof_used = c.nof_used.fetch_add(1, std::memory_order_relaxed) + 1;
+  uint32_t max_used = c.max_used.load(std::memory_order_relaxed);
+  while (nof_used > max_used and not c.max_used.compare_exchange_weak(max_used, nof_used, std::memory_order_relaxed)) {
+  }
+  byte_buffer_block_header_t* header = new (block) byte_buffer_block_header_t;
+  header->cls                        = cls;
+  header->nof_refs.store(0, std::memory_order_relaxed);
+  return static_cast<uint8_t*>(block) + byte_buffer_block_prefix_size;
 }
 
-void* byte_buffer_t::operator new(size_t sz)
+void* allocate_byte_buffer_block(byte_buffer_size_class cls)
 {
-  assert(sz == sizeof(byte_buffer_t));
-  void* ptr = byte_buffer_pool::get_instance()->allocate_node(sz);
-  if (ptr == nullptr) {
-    throw std::bad_alloc();
+  switch (cls) {
+    case byte_buffer_size_class::small:
+      return tag_byte_buffer_block(
+          small_byte_buffer_pool::get_instance()->allocate_node(small_byte_buffer_pool::BLOCK_SIZE), cls);
+    case byte_buffer_size_class::medium:
+      return tag_byte_buffer_block(
+          medium_byte_buffer_pool::get_instance()->allocate_node(medium_byte_buffer_pool::BLOCK_SIZE), cls);
+    default:
+      break;
   }
-  return ptr;
+  return tag_byte_buffer_block(byte_buffer_pool::get_instance()->allocate_node(byte_buffer_pool::BLOCK_SIZE),
+                               byte_buffer_size_class::large);
+}
+
+void deallocate_byte_buffer_block(void* ptr)
+{
+  void*                  block = static_cast<uint8_t*>(ptr) - byte_buffer_block_prefix_size;
+  byte_buffer_size_class cls   = static_cast<byte_buffer_block_header_t*>(block)->cls;
+  class_counters[static_cast<uint32_t>(cls)].nof_used.fetch_sub(1, std::memory_order_relaxed);
+  switch (cls) {
+    case byte_buffer_size_class::small:
+      small_byte_buffer_pool::get_instance()->deallocate_node(block);
+      break;
+    case byte_buffer_size_class::medium:
+      medium_byte_buffer_pool::get_instance()->deallocate_node(block);
+      break;
+    default:
+      byte_buffer_pool::get_instance()->deallocate_node(block);
+      break;
+  }
+}
+
+} // namespace
+
+const char* to_string(byte_buffer_size_class cls)
+{
+  switch (cls) {
+    case byte_buffer_size_class::small:
+      return "small";
+    case byte_buffer_size_class::medium:
+      return "medium";
+    case byte_buffer_size_class::large:
+      return "large";
+    default:
+      break;
+  }
+  return "invalid";
+}
+
+void* byte_buffer_t::operator new(size_t sz, byte_buffer_size_class cls, const std::nothrow_t& nothrow_value) noexcept
+{
+  assert(sz == sizeof(byte_buffer_t));
+  return allocate_byte_buffer_block(cls);
 }
 
 void byte_buffer_t::operator delete(void* ptr)
 {
-  byte_buffer_pool::get_instance()->deallocate_node(ptr);
+  deallocate_byte_buffer_block(ptr);
+}
+
+void byte_buffer_t::operator delete(void* ptr, byte_buffer_size_class cls, const std::nothrow_t& nothrow_value) noexcept
+{
+  deallocate_byte_buffer_block(ptr);
+}
+
+unique_byte_buffer_t make_byte_buffer(byte_buffer_size_class cls) noexcept
+{
+  return std::unique_ptr<byte_buffer_t>(new (cls, std::nothrow) byte_buffer_t(cls));
+}
+
+unique_byte_buffer_t make_sized_byte_buffer(uint32_t payload_len) noexcept
+{
+  return make_byte_buffer(select_byte_buffer_size_class(payload_len));
+}
+
+bool reserve_byte_buffer_tailroom(unique_byte_buffer_t& buf, uint32_t tailroom)
+{
+  if (buf->get_tailroom() >= tailroom) {
+    return true;
+  }
+  uint32_t required = buf->get_headroom() + buf->N_bytes + tailroom;
+  if (required > byte_buffer_t::headroom + byte_buffer_large_payload_size) {
+    return false;
+  }
+  byte_buffer_size_class cls = select_byte_buffer_size_class(required > byte_buffer_t::headroom
+                                                                 ? required - byte_buffer_t::headroom
+                                                                 : 0);
+  unique_byte_buffer_t   grown = make_byte_buffer(cls);
+  if (grown == nullptr) {
+    return false;
+  }
+  // the assignment preserves the headroom of the original buffer
+  *grown = *buf;
+  buf    = std::move(grown);
+  return true;
+}
+
+void get_byte_buffer_pool_metrics(sys_metrics_t& metrics)
+{
+  for (uint32_t i = 0; i != nof_byte_buffer_size_classes; ++i) {
+    byte_buffer_pool_class_metrics_t& m = metrics.buffer_pool[i];
+    m.payload_size                      = get_byte_buffer_payload_size(static_cast<byte_buffer_size_class>(i));
+    m.block_size                        = byte_buffer_block_size(static_cast<byte_buffer_size_class>(i));
+    m.nof_used                          = class_counters[i].nof_used.load(std::memory_order_relaxed);
+    m.max_used                          = class_counters[i].max_used.load(std::memory_order_relaxed);
+    m.nof_alloc_failures                = class_counters[i].nof_alloc_failures.load(std::memory_order_relaxed);
+  }
 }
 
 } // namespace srsran
@@ -22,27 +22,27 @@
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/threads.h"
+#include <cinttypes>
 
 namespace srsran {
-mac_pcap::mac_pcap() : mac_pcap_base() {}
+mac_pcap::mac_pcap() : mac_pcap_base(), writer(logger) {}
 
 mac_pcap::~mac_pcap()
 {
   close();
 }
 
-uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_)
+uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_, const pcap_writer_args_t& writer_args)
 {
   std::lock_guard<std::mutex> lock(mutex);
-  if (pcap_file != nullptr) {
+  if (writer.is_open()) {
     logger.error("PCAP writer for %s already running. Close first.", filename_.c_str());
     return SRSRAN_ERROR;
   }
 
   // set UDP DLT
-  dlt       = UDP_DLT;
-  pcap_file = DLT_PCAP_Open(dlt, filename_.c_str());
-  if (pcap_file == nullptr) {
+  dlt = UDP_DLT;
+  if (not writer.open(filename_, dlt, writer_args)) {
     logger.error("Couldn't open %s to write PCAP", filename_.c_str());
     return SRSRAN_ERROR;
   }
@@ -51,35 +51,26 @@ uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_)
   ue_id    = ue_id_;
   running  = true;
 
-  // start writer thread
-  start();
-
   return SRSRAN_SUCCESS;
 }
 
 uint32_t mac_pcap::close()
 {
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    if (running == false || pcap_file == nullptr) {
-      return SRSRAN_ERROR;
-    }
-
-    // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+  std::lock_guard<std::mutex> lock(mutex);
+  if (not writer.is_open()) {
+    return SRSRAN_ERROR;
   }
+  running = false;
 
-  wait_thread_finish();
-
-  // close file handle
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    srsran::console("Saving MAC PCAP (DLT=%d) to %s\n", dlt, filename.c_str());
-    DLT_PCAP_Close(pcap_file);
-    pcap_file = nullptr;
-  }
+  // write the pending PDUs and close the file
+  writer.close();
+  pcap_writer_metrics_t metrics = writer.get_metrics();
+  srsran::console("Saving MAC PCAP (DLT=%d) to %s (%" PRIu64 " PDUs, %" PRIu64 " dropped, %d files)\n",
+                  dlt,
+                  filename.c_str(),
+                  metrics.nof_pdus,
+                  metrics.nof_dropped,
+                  metrics.nof_files);
 
   return SRSRAN_SUCCESS;
 }
@@ -87,17 +78,27 @@ uint32_t mac_pcap::close()
 void mac_pcap::write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu)
 {
   if (pdu.pdu != nullptr) {
-    switch (pdu.rat) {
-      case srsran_rat_t::lte:
-        LTE_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      case srsran_rat_t::nr:
-        NR_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context_nr, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      default:
-        logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
-    }
+    push_pdu(pdu, pdu.pdu->msg, pdu.pdu->N_bytes);
+  }
+}
+
+void mac_pcap::push_pdu(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len)
+{
+  uint8_t header[PCAP_CONTEXT_HEADER_MAX];
+  int     header_len = 0;
+  switch (pdu.rat) {
+    case srsran_rat_t::lte:
+      header_len = LTE_PCAP_MAC_UDP_PACK_HEADER(&pdu.context, payload_len, header, sizeof(header));
+      break;
+    case srsran_rat_t::nr:
+      header_len = NR_PCAP_MAC_UDP_PACK_HEADER(&pdu.context_nr, payload_len, header, sizeof(header));
+      break;
+    default:
+      logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
+      return;
   }
+  // drops are accounted for in the writer metrics and reported by the writer thread
+  writer.write_record(header, header_len, payload, payload_len);
 }
 
-} // namespace srsran
\ No newline at end of file
+} // namespace srsran
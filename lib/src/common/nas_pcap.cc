@@ -33,7 +33,7 @@ static void emergency_cleanup_handler(void* data)
   reinterpret_cast<nas_pcap*>(data)->close();
 }
 
-nas_pcap::nas_pcap()
+nas_pcap::nas_pcap() : writer(srslog::fetch_basic_logger("NAS"))
 {
   emergency_handler_id = add_emergency_cleanup_handler(emergency_cleanup_handler, this);
 }
@@ -50,15 +50,11 @@ void nas_pcap::enable()
   enable_write = true;
 }
 
-uint32_t nas_pcap::open(std::string filename_, uint32_t ue_id_, srsran_rat_t rat_type)
+uint32_t
+nas_pcap::open(std::string filename_, uint32_t ue_id_, srsran_rat_t rat_type, const pcap_writer_args_t& writer_args)
 {
   filename = filename_;
-  if (rat_type == srsran_rat_t::nr) {
-    pcap_file = DLT_PCAP_Open(NAS_5G_DLT, filename.c_str());
-  } else {
-    pcap_file = DLT_PCAP_Open(NAS_LTE_DLT, filename.c_str());
-  }
-  if (pcap_file == nullptr) {
+  if (not writer.open(filename, rat_type == srsran_rat_t::nr ? NAS_5G_DLT : NAS_LTE_DLT, writer_args)) {
     return SRSRAN_ERROR;
   }
   ue_id        = ue_id_;
@@ -69,16 +65,14 @@ uint32_t nas_pcap::open(std::string filename_, uint32_t ue_id_, srsran_rat_t rat
 void nas_pcap::close()
 {
   fprintf(stdout, "Saving NAS PCAP file (DLT=%d) to %s \n", NAS_LTE_DLT, filename.c_str());
-  DLT_PCAP_Close(pcap_file);
-  pcap_file = nullptr;
+  writer.close();
 }
 
 void nas_pcap::write_nas(uint8_t* pdu, uint32_t pdu_len_bytes)
 {
   if (enable_write) {
-    NAS_Context_Info_t context;
     if (pdu) {
-      LTE_PCAP_NAS_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      writer.write_record(nullptr, 0, pdu, pdu_len_bytes);
     }
   }
 }
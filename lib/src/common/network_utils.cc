@@ -22,6 +22,7 @@
 #include "srsran/common/network_utils.h"
 
 #include <netinet/sctp.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h> // for the pipe
@@ -395,11 +396,18 @@ bool unique_socket::sctp_set_init_msg_opts(int max_init_attempts, int max_init_t
  *                 Rx Multisocket Handler
  **************************************************************/
 
-socket_manager::socket_manager() : thread("RXsockets"), socket_manager_itf(srslog::fetch_basic_logger("COMN"))
+socket_manager::socket_manager(const std::string& thread_name) :
+  thread(thread_name), socket_manager_itf(srslog::fetch_basic_logger("COMN"))
 {
   // register control pipe fd
   int fd = pipe(pipefd);
   srsran_assert(fd != -1, "Failed to open control pipe");
+  epfd = epoll_create1(EPOLL_CLOEXEC);
+  srsran_assert(epfd != -1, "Failed to create epoll instance");
+  epoll_event ev = {};
+  ev.events      = EPOLLIN;
+  ev.data.fd     = pipefd[0];
+  srsran_assert(epoll_ctl(epfd, EPOLL_CTL_ADD, pipefd[0], &ev) != -1, "Failed to register control pipe");
   start(thread_prio);
 }
 
@@ -431,6 +439,10 @@ void socket_manager::stop()
     pipefd[1] = -1;
     rxSockDebug("closed.");
   }
+  if (epfd >= 0) {
+    close(epfd);
+    epfd = -1;
+  }
 }
 
 bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
@@ -445,16 +457,15 @@ bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
     return false;
   }
 
-  active_sockets.insert(std::make_pair(fd, std::move(handler)));
-
-  // this unlocks the reading thread to add new connections
-  ctrl_cmd_t msg;
-  msg.cmd    = ctrl_cmd_t::cmd_id_t::NEW_FD;
-  msg.new_fd = fd;
-  if (write(pipefd[1], &msg, sizeof(msg)) != sizeof(msg)) {
-    rxSockError("while writing to control pipe");
+  // epoll_wait picks up the new fd without the need to unlock it
+  epoll_event ev = {};
+  ev.events      = EPOLLIN;
+  ev.data.fd     = fd;
+  if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+    rxSockError("Failed to register fd=%d in epoll: %s", fd, strerror(errno));
     return false;
   }
+  active_sockets.insert(std::make_pair(fd, std::move(handler)));
 
   rxSockDebug("socket fd=%d has been registered.", fd);
   return true;
@@ -495,97 +506,89 @@ bool socket_manager::remove_socket(int fd)
   return result;
 }
 
-std::map<int, socket_manager::recv_callback_t>::iterator
-socket_manager::remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd)
+std::map<int, socket_manager::recv_callback_t>::iterator socket_manager::remove_socket_unprotected(int fd)
 {
   if (fd < 0) {
     rxSockError("fd to be removed is not valid");
     return active_sockets.end();
   }
   auto it = active_sockets.find(fd);
-  it      = active_sockets.erase(it);
-  FD_CLR(fd, total_fd_set);
-  // assumes ordering
-  *max_fd = (active_sockets.empty()) ? pipefd[0] : std::max(pipefd[0], active_sockets.rbegin()->first);
+  if (it == active_sockets.end()) {
+    return it;
+  }
+  it = active_sockets.erase(it);
+  // the fd may have been already closed, in which case it was removed from the epoll set by the kernel
+  epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
   rxSockDebug("Socket fd=%d has been successfully removed", fd);
   return it;
 }
 
+bool socket_manager::handle_ctrl_cmd()
+{
+  ctrl_cmd_t msg;
+  ssize_t    nrd = read(pipefd[0], &msg, sizeof(msg));
+  if (nrd <= 0) {
+    rxSockError("Unable to read control message.");
+    return true;
+  }
+  switch (msg.cmd) {
+    case ctrl_cmd_t::cmd_id_t::EXIT:
+      running = false;
+      return false;
+    case ctrl_cmd_t::cmd_id_t::RM_FD:
+      remove_socket_unprotected(msg.new_fd);
+      if (msg.signal_rm_complete) {
+        rem_fd_tmp_list.push_back(msg.new_fd);
+        rem_cvar.notify_one();
+      }
+      break;
+    default:
+      rxSockError("ctrl message command %d is not valid", (int)msg.cmd);
+  }
+  return true;
+}
+
 void socket_manager::run_thread()
 {
   running = true;
-  fd_set total_fd_set, read_fd_set;
-  FD_ZERO(&total_fd_set);
-  int max_fd = 0;
-
-  FD_SET(pipefd[0], &total_fd_set);
-  max_fd = std::max(pipefd[0], max_fd);
+  epoll_event events[max_events];
 
   while (running.load(std::memory_order_relaxed)) {
-    memcpy(&read_fd_set, &total_fd_set, sizeof(total_fd_set));
-    int n = select(max_fd + 1, &read_fd_set, nullptr, nullptr, nullptr);
+    int n = epoll_wait(epfd, events, max_events, -1);
 
-    // handle select return
+    // handle epoll_wait return
     if (n == -1) {
-      rxSockError("Error from select(%d,...). Number of rx sockets: %d", max_fd + 1, (int)active_sockets.size() + 1);
-      continue;
-    }
-    if (n == 0) {
-      rxSockDebug("No data from select.");
+      if (errno != EINTR) {
+        rxSockError("Error from epoll_wait. Number of rx sockets: %d", (int)active_sockets.size() + 1);
+      }
       continue;
     }
 
     // Shared state area
     std::lock_guard<std::mutex> lock(socket_mutex);
 
-    // call read callback for all SCTP/TCP/UDP connections
-    for (auto handler_it = active_sockets.begin(); handler_it != active_sockets.end();) {
-      int              fd       = handler_it->first;
-      recv_callback_t& callback = handler_it->second;
-      if (not FD_ISSET(fd, &read_fd_set)) {
-        ++handler_it;
+    // call read callback for all SCTP/TCP/UDP connections with data, and handle ctrl messages last
+    bool has_ctrl_cmd = false;
+    for (int i = 0; i < n; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == pipefd[0]) {
+        has_ctrl_cmd = true;
+        continue;
+      }
+      auto handler_it = active_sockets.find(fd);
+      if (handler_it == active_sockets.end()) {
+        // removed while handling a previous event
         continue;
       }
-      bool socket_valid = callback(fd);
+      bool socket_valid = handler_it->second(fd);
       if (not socket_valid) {
         rxSockInfo("The socket fd=%d has been closed by peer", fd);
-        handler_it = remove_socket_unprotected(fd, &total_fd_set, &max_fd);
-      } else {
-        ++handler_it;
+        remove_socket_unprotected(fd);
       }
     }
 
-    // handle ctrl messages
-    if (FD_ISSET(pipefd[0], &read_fd_set)) {
-      ctrl_cmd_t msg;
-      ssize_t    nrd = read(pipefd[0], &msg, sizeof(msg));
-      if (nrd <= 0) {
-        rxSockError("Unable to read control message.");
-        continue;
-      }
-      switch (msg.cmd) {
-        case ctrl_cmd_t::cmd_id_t::EXIT:
-          running = false;
-          return;
-        case ctrl_cmd_t::cmd_id_t::NEW_FD:
-          if (msg.new_fd >= 0) {
-            FD_SET(msg.new_fd, &total_fd_set);
-            max_fd = std::max(max_fd, msg.new_fd);
-          } else {
-            rxSockError("added fd is not valid");
-          }
-          break;
-        case ctrl_cmd_t::cmd_id_t::RM_FD:
-          remove_socket_unprotected(msg.new_fd, &total_fd_set, &max_fd);
-          if (msg.signal_rm_complete) {
-            rem_fd_tmp_list.push_back(msg.new_fd);
-            rem_cvar.notify_one();
-          }
-          rxSockDebug("Socket fd=%d has been successfully removed", msg.new_fd);
-          break;
-        default:
-          rxSockError("ctrl message command %d is not valid", (int)msg.cmd);
-      }
+    if (has_ctrl_cmd and not handle_ctrl_cmd()) {
+      return;
     }
   }
 }
@@ -649,50 +652,125 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 }
 
 /**
- * Description: Functor for the case the received data is
- * in the form of unique_byte_buffer, and a recvfrom(...) call is used
+ * Description: Functor for the case the received data is in the form of unique_byte_buffers. The socket is drained
+ * with recvmmsg(...) into pool-allocated buffers, and every burst of datagrams is dispatched as a single task
  */
-class recvfrom_pdu_task
+class recvmmsg_pdu_task
 {
 public:
-  using callback_t = recvfrom_callback_t;
-  explicit recvfrom_pdu_task(srslog::basic_logger& logger, srsran::task_queue_handle& queue_, callback_t func_) :
-    logger(logger), queue(queue_), func(std::move(func_))
+  explicit recvmmsg_pdu_task(srslog::basic_logger& logger, srsran::task_queue_handle& queue_) :
+    logger(logger), queue(queue_)
   {}
 
-  bool operator()(int fd)
+  /// Reads up to max_rx_burst_size datagrams from the socket. Returns the number of received datagrams.
+  uint32_t recv_burst(int fd, std::vector<rx_datagram_t>& burst)
   {
-    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-    if (pdu == nullptr) {
+    // Allocate the buffers for the whole burst, reusing the ones that were not filled in the last call
+    uint32_t nof_bufs = 0;
+    for (; nof_bufs < max_rx_burst_size; ++nof_bufs) {
+      if (bufs[nof_bufs] == nullptr) {
+        bufs[nof_bufs] = srsran::make_byte_buffer();
+        if (bufs[nof_bufs] == nullptr) {
+          break;
+        }
+      }
+      iovs[nof_bufs].iov_base            = bufs[nof_bufs]->msg;
+      iovs[nof_bufs].iov_len             = bufs[nof_bufs]->get_tailroom();
+      msgs[nof_bufs].msg_hdr             = {};
+      msgs[nof_bufs].msg_hdr.msg_name    = &from[nof_bufs];
+      msgs[nof_bufs].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      msgs[nof_bufs].msg_hdr.msg_iov     = &iovs[nof_bufs];
+      msgs[nof_bufs].msg_hdr.msg_iovlen  = 1;
+    }
+    if (nof_bufs == 0) {
       logger.error("Unable to allocate byte buffer");
-      return true;
+      return 0;
     }
-    sockaddr_in from    = {};
-    socklen_t   fromlen = sizeof(from);
 
-    ssize_t n_recv = recvfrom(fd, pdu->msg, pdu->get_tailroom(), 0, (struct sockaddr*)&from, &fromlen);
+    int n_recv = recvmmsg(fd, msgs.data(), nof_bufs, MSG_DONTWAIT, nullptr);
     if (n_recv == -1 and errno != EAGAIN) {
       logger.error("Error reading from socket: %s", strerror(errno));
-      return true;
+      return 0;
     }
     if (n_recv == -1 and errno == EAGAIN) {
       logger.debug("Socket timeout reached");
+      return 0;
+    }
+
+    burst.resize(n_recv);
+    for (int i = 0; i < n_recv; ++i) {
+      bufs[i]->N_bytes = msgs[i].msg_len;
+      burst[i].pdu     = std::move(bufs[i]);
+      burst[i].from    = from[i];
+    }
+    return n_recv;
+  }
+
+protected:
+  srslog::basic_logger&      logger;
+  srsran::task_queue_handle& queue;
+
+private:
+  std::array<srsran::unique_byte_buffer_t, max_rx_burst_size> bufs;
+  std::array<mmsghdr, max_rx_burst_size>                      msgs;
+  std::array<iovec, max_rx_burst_size>                        iovs;
+  std::array<sockaddr_in, max_rx_burst_size>                  from;
+};
+
+class recvfrom_pdu_task : public recvmmsg_pdu_task
+{
+public:
+  using callback_t = recvfrom_callback_t;
+  explicit recvfrom_pdu_task(srslog::basic_logger& logger, srsran::task_queue_handle& queue_, callback_t func_) :
+    recvmmsg_pdu_task(logger, queue_), func(std::move(func_))
+  {}
+
+  bool operator()(int fd)
+  {
+    std::vector<rx_datagram_t> burst;
+    if (recv_burst(fd, burst) == 0) {
       return true;
     }
 
-    pdu->N_bytes = static_cast<uint32_t>(n_recv);
+    // Defer handling of received packets to provided queue
+    queue.push(std::bind(
+        [this](std::vector<rx_datagram_t>& sdus) {
+          for (rx_datagram_t& sdu : sdus) {
+            func(std::move(sdu.pdu), sdu.from);
+          }
+        },
+        std::move(burst)));
 
-    // Defer handling of received packet to provided queue
-    queue.push(
-        std::bind([this, from](srsran::unique_byte_buffer_t& sdu) { func(std::move(sdu), from); }, std::move(pdu)));
+    return true;
+  }
+
+private:
+  callback_t func;
+};
+
+class recvfrom_burst_task : public recvmmsg_pdu_task
+{
+public:
+  using callback_t = recvfrom_burst_callback_t;
+  explicit recvfrom_burst_task(srslog::basic_logger& logger, srsran::task_queue_handle& queue_, callback_t func_) :
+    recvmmsg_pdu_task(logger, queue_), func(std::move(func_))
+  {}
+
+  bool operator()(int fd)
+  {
+    std::vector<rx_datagram_t> burst;
+    if (recv_burst(fd, burst) == 0) {
+      return true;
+    }
+
+    // Defer handling of received packets to provided queue
+    queue.push(std::bind([this](std::vector<rx_datagram_t>& sdus) { func(sdus); }, std::move(burst)));
 
     return true;
   }
 
 private:
-  srslog::basic_logger&      logger;
-  srsran::task_queue_handle& queue;
-  callback_t                 func;
+  callback_t func;
 };
 
 socket_manager_itf::recv_callback_t
@@ -701,4 +779,11 @@ make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue,
   return socket_manager_itf::recv_callback_t(recvfrom_pdu_task(logger, queue, std::move(rx_callback)));
 }
 
+socket_manager_itf::recv_callback_t make_sdu_burst_handler(srslog::basic_logger&      logger,
+                                                           srsran::task_queue_handle& queue,
+                                                           recvfrom_burst_callback_t  rx_callback)
+{
+  return socket_manager_itf::recv_callback_t(recvfrom_burst_task(logger, queue, std::move(rx_callback)));
+}
+
 } // namespace srsran
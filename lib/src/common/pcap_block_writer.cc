@@ -0,0 +1,466 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap_block_writer.h"
+#include "srsran/common/pcap.h"
+#include <cinttypes>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+
+namespace srsran {
+
+// PCAPNG block types and sizes
+static const uint32_t pcapng_shb_type       = 0x0a0d0d0a;
+static const uint32_t pcapng_idb_type       = 0x00000001;
+static const uint32_t pcapng_epb_type       = 0x00000006;
+static const uint32_t pcapng_byte_order     = 0x1a2b3c4d;
+static const uint32_t pcapng_shb_len        = 28;
+static const uint32_t pcapng_idb_len        = 20;
+static const uint32_t pcapng_epb_header_len = 28;
+
+/// Maximum number of write blocks passed to a single writev() call
+static const int max_iov_per_write = 64;
+
+static uint8_t* put_u16(uint8_t* ptr, uint16_t value)
+{
+  memcpy(ptr, &value, sizeof(value));
+  return ptr + sizeof(value);
+}
+
+static uint8_t* put_u32(uint8_t* ptr, uint32_t value)
+{
+  memcpy(ptr, &value, sizeof(value));
+  return ptr + sizeof(value);
+}
+
+/// Size of a record in the file, given the number of captured bytes
+static uint32_t record_len(pcap_format_t format, uint32_t cap_len)
+{
+  if (format == pcap_format_t::pcapng) {
+    // EPB header, packet data padded to 32 bits and trailing block length
+    return pcapng_epb_header_len + ((cap_len + 3U) & ~3U) + sizeof(uint32_t);
+  }
+  return sizeof(pcaprec_hdr_t) + cap_len;
+}
+
+static uint64_t make_block_state(uint32_t seq, uint32_t len)
+{
+  return ((uint64_t)seq << 32U) | len;
+}
+
+pcap_block_writer::pcap_block_writer(srslog::basic_logger& logger_) : thread("PCAP_WRITER"), logger(logger_) {}
+
+pcap_block_writer::~pcap_block_writer()
+{
+  close();
+}
+
+bool pcap_block_writer::open(const std::string& filename_, uint32_t dlt_, const pcap_writer_args_t& args_)
+{
+  if (running) {
+    logger.error("PCAP writer for %s already running. Close first.", filename_.c_str());
+    return false;
+  }
+  if (args_.block_size == 0 or args_.block_size >= sealed_flag or args_.nof_blocks == 0) {
+    logger.error(
+        "Invalid PCAP writer configuration (block_size=%d, nof_blocks=%d)", args_.block_size, args_.nof_blocks);
+    return false;
+  }
+  filename = filename_;
+  dlt      = dlt_;
+  args     = args_;
+
+  // Allocate all write blocks upfront, so that producers never allocate. Block i serves the sequence number i first
+  blocks.reset(new write_block[args.nof_blocks]);
+  for (uint32_t i = 0; i < args.nof_blocks; ++i) {
+    blocks[i].data.reset(new uint8_t[args.block_size]);
+    blocks[i].state.store(make_block_state(i, 0), std::memory_order_relaxed);
+  }
+  head             = 0;
+  tail             = 0;
+  nof_pdus         = 0;
+  nof_bytes        = 0;
+  nof_dropped      = 0;
+  nof_write_errors = 0;
+  nof_files        = 0;
+  last_nof_dropped = 0;
+
+  if (not open_file(0)) {
+    return false;
+  }
+
+  running = true;
+  start();
+  return true;
+}
+
+void pcap_block_writer::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  cvar.notify_one();
+  wait_thread_finish();
+
+  ::close(fd);
+  fd = -1;
+}
+
+bool pcap_block_writer::write_record(const uint8_t* header, uint32_t header_len, const uint8_t* pdu, uint32_t pdu_len)
+{
+  // Sequentially consistent with close(): either the record is rejected here, or the writer thread waits for it
+  nof_producers.fetch_add(1);
+  if (not running.load()) {
+    nof_producers.fetch_sub(1, std::memory_order_release);
+    return false;
+  }
+  struct timeval t;
+  gettimeofday(&t, nullptr);
+  uint32_t cap_len = header_len + pdu_len;
+  uint32_t rec_len = record_len(args.format, cap_len);
+
+  uint8_t*     ptr   = nullptr;
+  write_block* block = alloc_record(rec_len, ptr);
+  if (block == nullptr) {
+    nof_dropped.fetch_add(1, std::memory_order_relaxed);
+    nof_producers.fetch_sub(1, std::memory_order_release);
+    return false;
+  }
+
+  if (args.format == pcap_format_t::pcapng) {
+    uint64_t ts_us = (uint64_t)t.tv_sec * 1000000U + t.tv_usec;
+    ptr            = put_u32(ptr, pcapng_epb_type);
+    ptr            = put_u32(ptr, rec_len);
+    ptr            = put_u32(ptr, 0); // interface ID
+    ptr            = put_u32(ptr, (uint32_t)(ts_us >> 32U));
+    ptr            = put_u32(ptr, (uint32_t)ts_us);
+    ptr            = put_u32(ptr, cap_len);
+    ptr            = put_u32(ptr, cap_len);
+  } else {
+    pcaprec_hdr_t rec_header = {(unsigned int)t.tv_sec, (unsigned int)t.tv_usec, cap_len, cap_len};
+    memcpy(ptr, &rec_header, sizeof(rec_header));
+    ptr += sizeof(rec_header);
+  }
+  if (header_len > 0) {
+    memcpy(ptr, header, header_len);
+    ptr += header_len;
+  }
+  if (pdu_len > 0) {
+    memcpy(ptr, pdu, pdu_len);
+    ptr += pdu_len;
+  }
+  if (args.format == pcap_format_t::pcapng) {
+    uint32_t padding = rec_len - pcapng_epb_header_len - cap_len - sizeof(uint32_t);
+    memset(ptr, 0, padding);
+    put_u32(ptr + padding, rec_len);
+  }
+
+  // Hand the record over to the writer thread
+  block->committed.fetch_add(rec_len, std::memory_order_release);
+
+  nof_pdus.fetch_add(1, std::memory_order_relaxed);
+  nof_bytes.fetch_add(cap_len, std::memory_order_relaxed);
+  nof_producers.fetch_sub(1, std::memory_order_release);
+  return true;
+}
+
+pcap_writer_metrics_t pcap_block_writer::get_metrics() const
+{
+  pcap_writer_metrics_t metrics;
+  metrics.nof_pdus         = nof_pdus.load(std::memory_order_relaxed);
+  metrics.nof_bytes        = nof_bytes.load(std::memory_order_relaxed);
+  metrics.nof_dropped      = nof_dropped.load(std::memory_order_relaxed);
+  metrics.nof_write_errors = nof_write_errors.load(std::memory_order_relaxed);
+  metrics.nof_files        = nof_files.load(std::memory_order_relaxed);
+  return metrics;
+}
+
+std::string pcap_block_writer::get_filename(uint32_t idx) const
+{
+  if (idx == 0) {
+    return filename;
+  }
+  // Rotated files get the index appended to the base name, e.g. enb_mac_1.pcap
+  size_t dot_pos   = filename.find_last_of('.');
+  size_t slash_pos = filename.find_last_of('/');
+  if (dot_pos == std::string::npos or (slash_pos != std::string::npos and dot_pos < slash_pos)) {
+    return filename + "_" + std::to_string(idx);
+  }
+  return filename.substr(0, dot_pos) + "_" + std::to_string(idx) + filename.substr(dot_pos);
+}
+
+/// Reserves space for a record in the current write block, returning the block and the record position in it
+pcap_block_writer::write_block* pcap_block_writer::alloc_record(uint32_t rec_len, uint8_t*& ptr)
+{
+  if (rec_len > args.block_size) {
+    return nullptr;
+  }
+  while (true) {
+    uint32_t     seq   = head.load(std::memory_order_acquire);
+    write_block& block = blocks[seq % args.nof_blocks];
+    uint64_t     state = block.state.load(std::memory_order_acquire);
+    if ((uint32_t)(state >> 32U) != seq) {
+      // The block has not been written since it served seq - nof_blocks, unless the head has moved on meanwhile
+      if (head.load(std::memory_order_acquire) == seq) {
+        return nullptr;
+      }
+      continue;
+    }
+    uint32_t len = (uint32_t)state;
+    if ((len & sealed_flag) != 0) {
+      // The thread that sealed the block is about to move the head
+      std::this_thread::yield();
+      continue;
+    }
+    if (len + rec_len > args.block_size) {
+      // The record does not fit, hand the block over to the writer thread and retry with the next one
+      if (seal_block(seq, state)) {
+        cvar.notify_one();
+      }
+      continue;
+    }
+    if (block.state.compare_exchange_weak(state, state + rec_len, std::memory_order_acquire)) {
+      ptr = block.data.get() + len;
+      return &block;
+    }
+  }
+}
+
+/// Stops the block serving seq from accepting records and moves the head to the next block
+bool pcap_block_writer::seal_block(uint32_t seq, uint64_t state)
+{
+  write_block& block = blocks[seq % args.nof_blocks];
+  if (not block.state.compare_exchange_strong(state, state | sealed_flag, std::memory_order_relaxed)) {
+    return false;
+  }
+  // Only the thread that sealed the current block moves the head
+  head.store(seq + 1, std::memory_order_release);
+  return true;
+}
+
+/// Seals the current block if it holds any record, so that the writer thread can write it
+void pcap_block_writer::seal_current_block()
+{
+  while (true) {
+    uint32_t seq   = head.load(std::memory_order_acquire);
+    uint64_t state = blocks[seq % args.nof_blocks].state.load(std::memory_order_acquire);
+    if ((uint32_t)(state >> 32U) != seq or (uint32_t)state == 0 or ((uint32_t)state & sealed_flag) != 0) {
+      // Not yet released, empty, or being sealed by a producer
+      return;
+    }
+    if (seal_block(seq, state)) {
+      return;
+    }
+  }
+}
+
+void pcap_block_writer::run_thread()
+{
+  std::vector<uint32_t> pending;
+  pending.reserve(args.nof_blocks);
+
+  bool stop = false;
+  while (not stop) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cvar.wait_for(lock, std::chrono::milliseconds(args.flush_period_ms), [this]() {
+        return head.load(std::memory_order_relaxed) != tail or not running.load(std::memory_order_relaxed);
+      });
+    }
+    stop = not running.load();
+    if (stop) {
+      // No record is reserved after this point, wait for the ones in flight
+      while (nof_producers.load() > 0) {
+        std::this_thread::yield();
+      }
+    }
+    // Partially filled blocks are written when no full block is pending, and on close
+    if (head.load(std::memory_order_acquire) == tail or stop) {
+      seal_current_block();
+    }
+
+    // Collect the sealed blocks whose records have all been serialized, in ring order
+    uint32_t end_seq = head.load(std::memory_order_acquire);
+    uint32_t seq     = tail;
+    for (; seq != end_seq; ++seq) {
+      write_block& block = blocks[seq % args.nof_blocks];
+      uint32_t     len   = (uint32_t)block.state.load(std::memory_order_relaxed) & ~sealed_flag;
+      if (block.committed.load(std::memory_order_acquire) != len) {
+        break;
+      }
+      block.len = len;
+      pending.push_back(seq % args.nof_blocks);
+    }
+    if (pending.empty()) {
+      if (seq != end_seq) {
+        // The oldest block still has records being serialized
+        std::this_thread::yield();
+      }
+      continue;
+    }
+
+    uint64_t dropped = nof_dropped.load(std::memory_order_relaxed);
+    if (dropped > last_nof_dropped) {
+      logger.warning("Dropped %" PRIu64 " PDUs in PCAP %s. All write blocks in use.",
+                     dropped - last_nof_dropped,
+                     filename.c_str());
+      last_nof_dropped = dropped;
+    }
+    write_blocks(pending);
+
+    // Release the written blocks to the producers, each one now serves the sequence number nof_blocks ahead
+    for (uint32_t idx : pending) {
+      write_block& block = blocks[idx];
+      block.committed.store(0, std::memory_order_relaxed);
+      block.state.store(make_block_state(tail + args.nof_blocks, 0), std::memory_order_release);
+      tail++;
+    }
+    pending.clear();
+  }
+}
+
+bool pcap_block_writer::open_file(uint32_t idx)
+{
+  std::string name   = get_filename(idx);
+  int         new_fd = ::open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (new_fd < 0) {
+    logger.error("Couldn't open %s to write PCAP: %s", name.c_str(), strerror(errno));
+    return false;
+  }
+
+  uint8_t  header[pcapng_shb_len + pcapng_idb_len];
+  uint32_t header_len;
+  if (args.format == pcap_format_t::pcapng) {
+    // Section header block, with unspecified section length
+    uint8_t* ptr = put_u32(header, pcapng_shb_type);
+    ptr          = put_u32(ptr, pcapng_shb_len);
+    ptr          = put_u32(ptr, pcapng_byte_order);
+    ptr          = put_u16(ptr, 1);
+    ptr          = put_u16(ptr, 0);
+    ptr          = put_u32(ptr, 0xffffffff);
+    ptr          = put_u32(ptr, 0xffffffff);
+    ptr          = put_u32(ptr, pcapng_shb_len);
+    // Interface description block, with the default microsecond timestamp resolution
+    ptr        = put_u32(ptr, pcapng_idb_type);
+    ptr        = put_u32(ptr, pcapng_idb_len);
+    ptr        = put_u16(ptr, (uint16_t)dlt);
+    ptr        = put_u16(ptr, 0);
+    ptr        = put_u32(ptr, snaplen);
+    ptr        = put_u32(ptr, pcapng_idb_len);
+    header_len = ptr - header;
+  } else {
+    pcap_hdr_t file_header = {0xa1b2c3d4, 2, 4, 0, 0, snaplen, dlt};
+    memcpy(header, &file_header, sizeof(file_header));
+    header_len = sizeof(file_header);
+  }
+  if (::write(new_fd, header, header_len) != (ssize_t)header_len) {
+    logger.error("Couldn't write PCAP header to %s: %s", name.c_str(), strerror(errno));
+    ::close(new_fd);
+    return false;
+  }
+
+  if (fd >= 0) {
+    ::close(fd);
+  }
+  fd         = new_fd;
+  file_idx   = idx;
+  file_size  = 0;
+  file_start = std::chrono::steady_clock::now();
+
+  nof_files.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool pcap_block_writer::rotation_due(uint32_t next_block_len) const
+{
+  if (file_size == 0) {
+    return false;
+  }
+  if (args.max_file_size > 0 and file_size + next_block_len > args.max_file_size) {
+    return true;
+  }
+  return args.rotation_period_s > 0 and
+         std::chrono::steady_clock::now() - file_start >= std::chrono::seconds(args.rotation_period_s);
+}
+
+void pcap_block_writer::write_blocks(const std::vector<uint32_t>& block_idxs)
+{
+  size_t i = 0;
+  while (i < block_idxs.size()) {
+    if (rotation_due(blocks[block_idxs[i]].len)) {
+      // On failure, keep writing to the current file
+      open_file(file_idx + 1);
+    }
+
+    // Gather as many blocks as fit in the current file into a single write
+    struct iovec iov[max_iov_per_write];
+    int          iovcnt    = 0;
+    uint64_t     batch_len = 0;
+    do {
+      const write_block& block = blocks[block_idxs[i++]];
+      iov[iovcnt].iov_base     = block.data.get();
+      iov[iovcnt].iov_len      = block.len;
+      iovcnt++;
+      batch_len += block.len;
+    } while (i < block_idxs.size() and iovcnt < max_iov_per_write and
+             (args.max_file_size == 0 or file_size + batch_len + blocks[block_idxs[i]].len <= args.max_file_size));
+
+    if (not write_iov(iov, iovcnt)) {
+      logger.error("Error writing PCAP file %s: %s", get_filename(file_idx).c_str(), strerror(errno));
+      nof_write_errors.fetch_add(iovcnt, std::memory_order_relaxed);
+    }
+  }
+}
+
+bool pcap_block_writer::write_iov(struct iovec* iov, int iovcnt)
+{
+  while (iovcnt > 0) {
+    ssize_t n = ::writev(fd, iov, iovcnt);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    file_size += n;
+    // Skip what was written, in case of a partial write
+    while (iovcnt > 0 and (size_t)n >= iov->iov_len) {
+      n -= iov->iov_len;
+      iov++;
+      iovcnt--;
+    }
+    if (iovcnt > 0) {
+      iov->iov_base = (uint8_t*)iov->iov_base + n;
+      iov->iov_len -= n;
+    }
+  }
+  return true;
+}
+
+} // namespace srsran
@@ -33,7 +33,7 @@ static void emergency_cleanup_handler(void* data)
   reinterpret_cast<s1ap_pcap*>(data)->close();
 }
 
-s1ap_pcap::s1ap_pcap()
+s1ap_pcap::s1ap_pcap() : writer(srslog::fetch_basic_logger("S1AP"))
 {
   emergency_handler_id = add_emergency_cleanup_handler(emergency_cleanup_handler, this);
 }
@@ -49,11 +49,10 @@ void s1ap_pcap::enable()
 {
   enable_write = true;
 }
-void s1ap_pcap::open(const char* filename_)
+void s1ap_pcap::open(const char* filename_, const pcap_writer_args_t& writer_args)
 {
   filename     = filename_;
-  pcap_file    = DLT_PCAP_Open(S1AP_LTE_DLT, filename.c_str());
-  enable_write = true;
+  enable_write = writer.open(filename, S1AP_LTE_DLT, writer_args);
 }
 void s1ap_pcap::close()
 {
@@ -61,15 +60,15 @@ void s1ap_pcap::close()
     return;
   }
   fprintf(stdout, "Saving S1AP PCAP file (DLT=%d) to %s\n", S1AP_LTE_DLT, filename.c_str());
-  DLT_PCAP_Close(pcap_file);
+  enable_write = false;
+  writer.close();
 }
 
 void s1ap_pcap::write_s1ap(uint8_t* pdu, uint32_t pdu_len_bytes)
 {
   if (enable_write) {
-    S1AP_Context_Info_t context;
     if (pdu) {
-      LTE_PCAP_S1AP_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      writer.write_record(nullptr, 0, pdu, pdu_len_bytes);
     }
   }
 }
@@ -20,6 +20,11 @@
  */
 
 #include "srsran/common/s3g.h"
+#include "srsran/phy/utils/simd.h"
+
+#ifdef __PCLMUL__
+#include <immintrin.h>
+#endif
 
 /* S-box SQ */
 static const uint8_t SQ[256] = {
@@ -280,6 +285,26 @@ uint32_t s3g_s2(uint32_t w)
   return ((((uint32_t)r0) << 24) | (((uint32_t)r1) << 16) | (((uint32_t)r2) << 8) | (((uint32_t)r3)));
 }
 
+/* MULalpha and DIValpha, tabulated since each of them takes hundreds of
+ * multiplications by x. */
+typedef struct {
+  uint32_t mul_alpha[256];
+  uint32_t div_alpha[256];
+} s3g_alpha_tables_t;
+
+static const s3g_alpha_tables_t* s3g_get_alpha_tables()
+{
+  static const s3g_alpha_tables_t tables = []() {
+    s3g_alpha_tables_t t = {};
+    for (uint32_t c = 0; c < 256; c++) {
+      t.mul_alpha[c] = s3g_mul_alpha((uint8_t)c);
+      t.div_alpha[c] = s3g_div_alpha((uint8_t)c);
+    }
+    return t;
+  }();
+  return &tables;
+}
+
 /*********************************************************************
     Name: s3g_clock_lfsr
 
@@ -291,9 +316,11 @@ uint32_t s3g_s2(uint32_t w)
 *********************************************************************/
 void s3g_clock_lfsr(S3G_STATE* state, uint32_t f)
 {
-  uint32_t v = (((state->lfsr[0] << 8) & 0xffffff00) ^ (s3g_mul_alpha((uint8_t)((state->lfsr[0] >> 24) & 0xff))) ^
-                (state->lfsr[2]) ^ ((state->lfsr[11] >> 8) & 0x00ffffff) ^
-                (s3g_div_alpha((uint8_t)((state->lfsr[11]) & 0xff))) ^ (f));
+  const s3g_alpha_tables_t* alpha = s3g_get_alpha_tables();
+
+  uint32_t v = (((state->lfsr[0] << 8) & 0xffffff00) ^ (alpha->mul_alpha[(state->lfsr[0] >> 24) & 0xff]) ^
+                (state->lfsr[2]) ^ ((state->lfsr[11] >> 8) & 0x00ffffff) ^ (alpha->div_alpha[state->lfsr[11] & 0xff]) ^
+                (f));
   uint8_t  i;
 
   for (i = 0; i < 15; i++) {
@@ -408,6 +435,180 @@ void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks)
   }
 }
 
+#if SRSRAN_SIMD_I_SIZE
+
+/* S1 and S2 as T-tables, one per input byte, so that they can be gathered.
+ * Also holds MULalpha and DIValpha for the same reason. */
+typedef struct {
+  int32_t s1[4][256];
+  int32_t s2[4][256];
+  int32_t mul_alpha[256];
+  int32_t div_alpha[256];
+} s3g_mb_tables_t;
+
+/* Contribution of the substituted byte y at position pos (0 being the MSB)
+ * to the MixColumn output of S1/S2, with m = MULx(y, c). */
+static uint32_t s3g_mb_mix_column(uint32_t pos, uint8_t y, uint8_t c)
+{
+  uint8_t m = s3g_mul_x(y, c);
+  uint8_t r[4];
+  r[pos]           = m;
+  r[(pos + 1) % 4] = m ^ y;
+  r[(pos + 2) % 4] = y;
+  r[(pos + 3) % 4] = y;
+  return ((uint32_t)r[0] << 24) | ((uint32_t)r[1] << 16) | ((uint32_t)r[2] << 8) | (uint32_t)r[3];
+}
+
+static const s3g_mb_tables_t* s3g_mb_get_tables()
+{
+  static const s3g_mb_tables_t tables = []() {
+    s3g_mb_tables_t           t     = {};
+    const s3g_alpha_tables_t* alpha = s3g_get_alpha_tables();
+    for (uint32_t x = 0; x < 256; x++) {
+      for (uint32_t pos = 0; pos < 4; pos++) {
+        t.s1[pos][x] = (int32_t)s3g_mb_mix_column(pos, S[x], 0x1b);
+        t.s2[pos][x] = (int32_t)s3g_mb_mix_column(pos, SQ[x], 0x69);
+      }
+      t.mul_alpha[x] = (int32_t)alpha->mul_alpha[x];
+      t.div_alpha[x] = (int32_t)alpha->div_alpha[x];
+    }
+    return t;
+  }();
+  return &tables;
+}
+
+static inline simd_i_t s3g_mb_sbox(const int32_t table[4][256], simd_i_t w)
+{
+  simd_i_t mask = srsran_simd_i_set1(0xff);
+  simd_i_t b0   = srsran_simd_i_srl(w, 24);
+  simd_i_t b1   = srsran_simd_i_and(srsran_simd_i_srl(w, 16), mask);
+  simd_i_t b2   = srsran_simd_i_and(srsran_simd_i_srl(w, 8), mask);
+  simd_i_t b3   = srsran_simd_i_and(w, mask);
+  simd_i_t r    = srsran_simd_i_xor(srsran_simd_i_gather(table[0], b0), srsran_simd_i_gather(table[1], b1));
+  r             = srsran_simd_i_xor(r, srsran_simd_i_gather(table[2], b2));
+  return srsran_simd_i_xor(r, srsran_simd_i_gather(table[3], b3));
+}
+
+/* The LFSR of all the lanes is kept as a circular buffer whose element s_0 is
+ * at lfsr[i % 16], so that clocking it does not move any data. */
+#define S3G_MB_S(k) lfsr[(i + (k)) & 15]
+
+static inline simd_i_t s3g_mb_clock_fsm(const s3g_mb_tables_t* t, const simd_i_t* lfsr, uint32_t i, simd_i_t* fsm)
+{
+  simd_i_t f = srsran_simd_i_xor(srsran_simd_i_add(S3G_MB_S(15), fsm[0]), fsm[1]);
+  simd_i_t r = srsran_simd_i_add(fsm[1], srsran_simd_i_xor(fsm[2], S3G_MB_S(5)));
+  fsm[2]     = s3g_mb_sbox(t->s2, fsm[1]);
+  fsm[1]     = s3g_mb_sbox(t->s1, fsm[0]);
+  fsm[0]     = r;
+  return f;
+}
+
+static inline void s3g_mb_clock_lfsr(const s3g_mb_tables_t* t, simd_i_t* lfsr, uint32_t i, simd_i_t f)
+{
+  simd_i_t v = srsran_simd_i_xor(srsran_simd_i_sll(S3G_MB_S(0), 8),
+                                 srsran_simd_i_gather(t->mul_alpha, srsran_simd_i_srl(S3G_MB_S(0), 24)));
+  v          = srsran_simd_i_xor(v, S3G_MB_S(2));
+  v          = srsran_simd_i_xor(v, srsran_simd_i_srl(S3G_MB_S(11), 8));
+  v          = srsran_simd_i_xor(
+      v, srsran_simd_i_gather(t->div_alpha, srsran_simd_i_and(S3G_MB_S(11), srsran_simd_i_set1(0xff))));
+  /* the new s_15 replaces s_0 */
+  S3G_MB_S(0) = srsran_simd_i_xor(v, f);
+}
+
+#undef S3G_MB_S
+
+#endif /* SRSRAN_SIMD_I_SIZE */
+
+/*********************************************************************
+    Name: s3g_mb_generate_keystream
+
+    Description: Multi-buffer generation of Keystream.
+
+    Document Reference: Specification of the 3GPP Confidentiality and
+                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
+                            Section 4.1 and Section 4.2
+*********************************************************************/
+void s3g_mb_generate_keystream(uint32_t               nof_lanes,
+                               const uint32_t* const* k,
+                               const uint32_t* const* iv,
+                               const uint32_t*        n,
+                               uint32_t* const*       ks)
+{
+#if SRSRAN_SIMD_I_SIZE
+  const s3g_mb_tables_t* t = s3g_mb_get_tables();
+
+  for (uint32_t first = 0; first < nof_lanes; first += SRSRAN_SIMD_I_SIZE) {
+    uint32_t nof_active = nof_lanes - first < SRSRAN_SIMD_I_SIZE ? nof_lanes - first : SRSRAN_SIMD_I_SIZE;
+
+    // Load the key and IV of each lane, unused lanes replicate the first one
+    srsran_simd_aligned int buf[16][SRSRAN_SIMD_I_SIZE];
+    uint32_t                max_len = 0;
+    for (uint32_t l = 0; l < SRSRAN_SIMD_I_SIZE; l++) {
+      uint32_t        lane = first + (l < nof_active ? l : 0);
+      const uint32_t* kl   = k[lane];
+      const uint32_t* ivl  = iv[lane];
+      buf[15][l]           = (int)(kl[3] ^ ivl[0]);
+      buf[14][l]           = (int)kl[2];
+      buf[13][l]           = (int)kl[1];
+      buf[12][l]           = (int)(kl[0] ^ ivl[1]);
+      buf[11][l]           = (int)(kl[3] ^ 0xffffffff);
+      buf[10][l]           = (int)(kl[2] ^ 0xffffffff ^ ivl[2]);
+      buf[9][l]            = (int)(kl[1] ^ 0xffffffff ^ ivl[3]);
+      buf[8][l]            = (int)(kl[0] ^ 0xffffffff);
+      buf[7][l]            = (int)kl[3];
+      buf[6][l]            = (int)kl[2];
+      buf[5][l]            = (int)kl[1];
+      buf[4][l]            = (int)kl[0];
+      buf[3][l]            = (int)(kl[3] ^ 0xffffffff);
+      buf[2][l]            = (int)(kl[2] ^ 0xffffffff);
+      buf[1][l]            = (int)(kl[1] ^ 0xffffffff);
+      buf[0][l]            = (int)(kl[0] ^ 0xffffffff);
+      if (n[lane] > max_len) {
+        max_len = n[lane];
+      }
+    }
+    simd_i_t lfsr[16];
+    for (uint32_t j = 0; j < 16; j++) {
+      lfsr[j] = srsran_simd_i_load(buf[j]);
+    }
+    simd_i_t fsm[3] = {srsran_simd_i_set1(0), srsran_simd_i_set1(0), srsran_simd_i_set1(0)};
+
+    // Initialization
+    for (uint32_t i = 0; i < 32; i++) {
+      s3g_mb_clock_lfsr(t, lfsr, i, s3g_mb_clock_fsm(t, lfsr, i, fsm));
+    }
+
+    // Clock FSM once and discard the output, then clock LFSR in keystream mode once
+    s3g_mb_clock_fsm(t, lfsr, 0, fsm);
+    s3g_mb_clock_lfsr(t, lfsr, 0, srsran_simd_i_set1(0));
+
+    // Keystream, 16 words at a time, transposed from the lanes into the output of each lane
+    for (uint32_t m = 0; m < max_len; m += 16) {
+      for (uint32_t i = 1; i <= 16; i++) {
+        simd_i_t f = s3g_mb_clock_fsm(t, lfsr, i, fsm);
+        srsran_simd_i_store(buf[i - 1], srsran_simd_i_xor(f, lfsr[i & 15]));
+        s3g_mb_clock_lfsr(t, lfsr, i, srsran_simd_i_set1(0));
+      }
+      for (uint32_t l = 0; l < nof_active; l++) {
+        for (uint32_t j = 0; j < 16 && m + j < n[first + l]; j++) {
+          ks[first + l][m + j] = (uint32_t)buf[j][l];
+        }
+      }
+    }
+  }
+#else  /* SRSRAN_SIMD_I_SIZE */
+  for (uint32_t l = 0; l < nof_lanes; l++) {
+    S3G_STATE state;
+    uint32_t  kl[4], ivl[4];
+    memcpy(kl, k[l], sizeof(kl));
+    memcpy(ivl, iv[l], sizeof(ivl));
+    s3g_initialize(&state, kl, ivl);
+    s3g_generate_keystream(&state, n[l], ks[l]);
+    s3g_deinitialize(&state);
+  }
+#endif /* SRSRAN_SIMD_I_SIZE */
+}
+
 /* MUL64x.
  * Input V: a 64-bit input.
  * Input c: a 64-bit input.
@@ -451,14 +652,28 @@ uint64_t s3g_MUL64xPOW(uint64_t V, uint8_t i, uint64_t c)
  */
 uint64_t s3g_MUL64(uint64_t V, uint64_t P, uint64_t c)
 {
+#ifdef __PCLMUL__
+  /* Carry-less product, then reduction of the upper half with x^64 = c.
+     As c has degree 4, two folds are enough. */
+  __m128i  prod = _mm_clmulepi64_si128(_mm_cvtsi64_si128(V), _mm_cvtsi64_si128(P), 0x00);
+  __m128i  poly = _mm_cvtsi64_si128(c);
+  __m128i  fold = _mm_clmulepi64_si128(_mm_unpackhi_epi64(prod, prod), poly, 0x00);
+  uint64_t res  = _mm_cvtsi128_si64(prod) ^ _mm_cvtsi128_si64(fold);
+  fold          = _mm_clmulepi64_si128(_mm_unpackhi_epi64(fold, fold), poly, 0x00);
+  return res ^ _mm_cvtsi128_si64(fold);
+#else  /* __PCLMUL__ */
   uint64_t result = 0;
   int      i      = 0;
 
+  /* V is multiplied by x once per bit of P, instead of computing
+     MUL64xPOW(V, i, c) from scratch for each of them. */
   for (i = 0; i < 64; i++) {
     if ((P >> i) & 0x1)
-      result ^= s3g_MUL64xPOW(V, i, c);
+      result ^= V;
+    V = s3g_MUL64x(V, c);
   }
   return result;
+#endif /* __PCLMUL__ */
 }
 
 /* mask8bit.
@@ -484,18 +699,11 @@ uint8_t mask8bit(int n)
 uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir, uint8_t* data, uint64_t length)
 {
   uint32_t       K[4], IV[4], z[5];
-  uint32_t       i        = 0, D;
+  uint32_t       i        = 0;
   static uint8_t MAC_I[4] = {0, 0, 0, 0}; /* static memory for the result */
-  uint64_t       EVAL;
-  uint64_t       V;
-  uint64_t       P;
-  uint64_t       Q;
-  uint64_t       c;
   S3G_STATE      state, *state_ptr;
 
-  uint64_t M_D_2;
-  int      rem_bits = 0;
-  state_ptr         = &state;
+  state_ptr = &state;
   /* Load the Integrity Key for SNOW3G initialization as in section 4.4. */
   for (i = 0; i < 4; i++)
     K[3 - i] = (key[4 * i] << 24) ^ (key[4 * i + 1] << 16) ^ (key[4 * i + 2] << 8) ^ (key[4 * i + 3]);
@@ -513,6 +721,30 @@ uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir
   s3g_initialize(state_ptr, K, IV);
   s3g_generate_keystream(state_ptr, 5, z);
   s3g_deinitialize(state_ptr);
+  s3g_f9_eval(z, data, length, MAC_I);
+
+  return MAC_I;
+}
+
+/* f9 evaluation.
+ * Input z: the 5 keystream words z_1 to z_5 of the integrity key and IV.
+ * Input data: length number of bits, input bit stream.
+ * Input length: 64 bit Length, i.e., the number of bits to be MAC'd.
+ * Output mac: 32 bit block used as MAC.
+ * See section 4.4.
+ */
+void s3g_f9_eval(const uint32_t z[5], const uint8_t* data, uint64_t length, uint8_t mac[4])
+{
+  uint32_t i = 0, D;
+  uint64_t EVAL;
+  uint64_t V;
+  uint64_t P;
+  uint64_t Q;
+  uint64_t c;
+
+  uint64_t M_D_2;
+  int      rem_bits = 0;
+
   P = (uint64_t)z[0] << 32 | (uint64_t)z[1];
   Q = (uint64_t)z[2] << 32 | (uint64_t)z[3];
 
@@ -560,9 +792,7 @@ uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir
      which forgot to XOR z[5] */
   for (i = 0; i < 4; i++)
     /*
-    MAC_I[i] = (mac32 >> (8*(3-i))) & 0xff;
+    mac[i] = (mac32 >> (8*(3-i))) & 0xff;
     */
-    MAC_I[i] = ((EVAL >> (56 - (i * 8))) ^ (z[4] >> (24 - (i * 8)))) & 0xff;
-
-  return MAC_I;
-}
\ No newline at end of file
+    mac[i] = ((EVAL >> (56 - (i * 8))) ^ (z[4] >> (24 - (i * 8)))) & 0xff;
+}
@@ -24,8 +24,15 @@
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/s3g.h"
 #include "srsran/common/ssl.h"
+#include "srsran/common/zuc.h"
 #include "srsran/config.h"
+#include <algorithm>
 #include <arpa/inet.h>
+#include <numeric>
+#ifdef __PCLMUL__
+#include <immintrin.h>
+#endif
+#include <vector>
 
 #define FC_EPS_K_ASME_DERIVATION 0x10
 #define FC_EPS_K_ENB_DERIVATION 0x11
@@ -804,6 +811,34 @@ int kdf_common(const uint8_t                  fc,
 
   return SRSRAN_SUCCESS;
 }
+/******************************************************************************
+ * AES based algorithms context
+ *****************************************************************************/
+void security_aes_ctx_set_key(security_aes_ctx_t& ctx, const uint8_t* key)
+{
+  ctx.aes.set_key(key);
+
+  // CMAC subkey generation (RFC 4493, section 2.3)
+  uint8_t const_zero[16] = {};
+  uint8_t L[16];
+  ctx.aes.encrypt_block(const_zero, L);
+  for (uint32_t i = 0; i < 15; i++) {
+    ctx.k1[i] = (L[i] << 1) | ((L[i + 1] >> 7) & 0x01);
+  }
+  ctx.k1[15] = L[15] << 1;
+  if (L[0] & 0x80) {
+    ctx.k1[15] ^= 0x87;
+  }
+  for (uint32_t i = 0; i < 15; i++) {
+    ctx.k2[i] = (ctx.k1[i] << 1) | ((ctx.k1[i + 1] >> 7) & 0x01);
+  }
+  ctx.k2[15] = ctx.k1[15] << 1;
+  if (ctx.k1[0] & 0x80) {
+    ctx.k2[15] ^= 0x87;
+  }
+  ctx.is_set = true;
+}
+
 /******************************************************************************
  * Integrity Protection
  *****************************************************************************/
@@ -827,7 +862,61 @@ uint8_t security_128_eia2(const uint8_t* key,
                           uint32_t       msg_len,
                           uint8_t*       mac)
 {
-  return liblte_security_128_eia2(key, count, bearer, direction, msg, msg_len, mac);
+  if (key == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  security_aes_ctx_t ctx;
+  security_aes_ctx_set_key(ctx, key);
+  return security_128_eia2(ctx, count, bearer, direction, msg, msg_len, mac);
+}
+
+uint8_t security_128_eia2(const security_aes_ctx_t& ctx,
+                          uint32_t                  count,
+                          uint32_t                  bearer,
+                          uint8_t                   direction,
+                          const uint8_t*            msg,
+                          uint32_t                  msg_len,
+                          uint8_t*                  mac)
+{
+  if (!ctx.is_set || (msg == nullptr && msg_len > 0) || mac == nullptr) {
+    return SRSRAN_ERROR;
+  }
+
+  // The CMAC input is the 8-byte COUNT|BEARER|DIRECTION prefix followed by the message (TS 33.401, Annex B.2.3)
+  uint32_t total_len  = msg_len + 8;
+  uint32_t nof_blocks = (total_len + 15) / 16;
+  uint8_t  first[16]  = {};
+  first[0]            = (count >> 24) & 0xFF;
+  first[1]            = (count >> 16) & 0xFF;
+  first[2]            = (count >> 8) & 0xFF;
+  first[3]            = count & 0xFF;
+  first[4]            = (bearer << 3) | (direction << 2);
+  memcpy(&first[8], msg, std::min(msg_len, 8u));
+
+  uint8_t T[16] = {};
+  if (nof_blocks > 1) {
+    ctx.aes.cbc_mac(T, first, 1);
+    ctx.aes.cbc_mac(T, &msg[8], nof_blocks - 2);
+  }
+
+  // Last block, padded and XORed with the corresponding subkey (RFC 4493)
+  uint32_t       last_offset = 16 * (nof_blocks - 1);
+  uint32_t       last_len    = total_len - last_offset;
+  const uint8_t* last_ptr    = nof_blocks > 1 ? &msg[last_offset - 8] : first;
+  const uint8_t* subkey      = ctx.k1;
+  uint8_t        last[16]    = {};
+  memcpy(last, last_ptr, last_len);
+  if (last_len < 16) {
+    last[last_len] = 0x80;
+    subkey         = ctx.k2;
+  }
+  for (uint32_t i = 0; i < 16; i++) {
+    last[i] ^= subkey[i];
+  }
+  ctx.aes.cbc_mac(T, last, 1);
+
+  memcpy(mac, T, 4);
+  return SRSRAN_SUCCESS;
 }
 
 uint8_t security_128_eia3(const uint8_t* key,
@@ -871,7 +960,36 @@ uint8_t security_128_eea2(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out)
 {
-  return liblte_security_encryption_eea2(key, count, bearer, direction, msg, msg_len * 8, msg_out);
+  if (key == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  security_aes_ctx_t ctx;
+  security_aes_ctx_set_key(ctx, key);
+  return security_128_eea2(ctx, count, bearer, direction, msg, msg_len, msg_out);
+}
+
+uint8_t security_128_eea2(const security_aes_ctx_t& ctx,
+                          uint32_t                  count,
+                          uint8_t                   bearer,
+                          uint8_t                   direction,
+                          const uint8_t*            msg,
+                          uint32_t                  msg_len,
+                          uint8_t*                  msg_out)
+{
+  if (!ctx.is_set || msg == nullptr || msg_out == nullptr) {
+    return SRSRAN_ERROR;
+  }
+
+  // Initial counter block (TS 33.401, Annex B.1.3)
+  uint8_t nonce_cnt[16] = {};
+  nonce_cnt[0]          = (count >> 24) & 0xFF;
+  nonce_cnt[1]          = (count >> 16) & 0xFF;
+  nonce_cnt[2]          = (count >> 8) & 0xFF;
+  nonce_cnt[3]          = count & 0xFF;
+  nonce_cnt[4]          = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
+
+  ctx.aes.ctr_crypt(nonce_cnt, msg, msg_out, msg_len);
+  return SRSRAN_SUCCESS;
 }
 
 uint8_t security_128_eea3(uint8_t* key,
@@ -885,6 +1003,289 @@ uint8_t security_128_eea3(uint8_t* key,
   return liblte_security_encryption_eea3(key, count, bearer, direction, msg, msg_len * 8, msg_out);
 }
 
+/******************************************************************************
+ * Batch processing
+ *****************************************************************************/
+
+namespace {
+
+/// Maximum number of PDUs whose keystreams are generated in the same multi-buffer call.
+const uint32_t batch_max_lanes = 16;
+
+/// PDUs of a batch sharing a multi-buffer keystream generator call.
+struct keystream_group_t {
+  uint32_t              nof_lanes = 0;
+  const security_pdu_t* pdu[batch_max_lanes];
+  uint32_t              len[batch_max_lanes];
+  uint32_t*             ks[batch_max_lanes];
+  std::vector<uint32_t> buffer;
+};
+
+bool is_valid_batch(const uint8_t* key, const security_pdu_t* pdus, uint32_t nof_pdus)
+{
+  if (key == nullptr || (pdus == nullptr && nof_pdus > 0)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    if ((pdus[i].msg == nullptr && pdus[i].msg_len > 0) || pdus[i].out == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Splits the batch in groups of up to batch_max_lanes PDUs and calls process_group for each of them, with the
+/// keystream buffers of nof_ks_words(msg_len) words already allocated. PDUs are grouped by length, so that all the
+/// lanes of a keystream generator call run for a similar number of words.
+template <typename KsLenFunc, typename GroupFunc>
+void process_batch(const security_pdu_t* pdus, uint32_t nof_pdus, KsLenFunc nof_ks_words, GroupFunc process_group)
+{
+  std::vector<uint32_t> order(nof_pdus);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+      order.begin(), order.end(), [pdus](uint32_t a, uint32_t b) { return pdus[a].msg_len < pdus[b].msg_len; });
+
+  keystream_group_t group;
+  for (uint32_t first = 0; first < nof_pdus; first += batch_max_lanes) {
+    group.nof_lanes    = std::min(batch_max_lanes, nof_pdus - first);
+    uint32_t total_len = 0;
+    for (uint32_t l = 0; l < group.nof_lanes; l++) {
+      group.pdu[l] = &pdus[order[first + l]];
+      group.len[l] = nof_ks_words(group.pdu[l]->msg_len);
+      total_len += group.len[l];
+    }
+    group.buffer.resize(total_len);
+    for (uint32_t l = 0, offset = 0; l < group.nof_lanes; offset += group.len[l], l++) {
+      group.ks[l] = &group.buffer[offset];
+    }
+    process_group(group);
+  }
+}
+
+/// XORs len bytes with a keystream of 32-bit words, whose most significant byte comes first.
+void xor_keystream(const uint32_t* ks, const uint8_t* in, uint8_t* out, uint32_t len)
+{
+  uint32_t nof_words = len / 4;
+  for (uint32_t i = 0; i < nof_words; i++) {
+    uint32_t word;
+    memcpy(&word, &in[4 * i], sizeof(word));
+    word ^= htonl(ks[i]);
+    memcpy(&out[4 * i], &word, sizeof(word));
+  }
+  for (uint32_t i = 4 * nof_words; i < len; i++) {
+    out[i] = in[i] ^ (uint8_t)(ks[i / 4] >> (24 - 8 * (i % 4)));
+  }
+}
+
+/// Loads the 128-bit SNOW 3G key as in the EEA1/EIA1 specifications.
+void s3g_load_key(const uint8_t* key, uint32_t* k)
+{
+  for (uint32_t i = 0; i < 4; i++) {
+    k[3 - i] = ((uint32_t)key[4 * i] << 24) | ((uint32_t)key[4 * i + 1] << 16) | ((uint32_t)key[4 * i + 2] << 8) |
+               (uint32_t)key[4 * i + 3];
+  }
+}
+
+/// Returns the keystream word starting at bit i.
+uint32_t eia3_get_word(const uint32_t* ks, uint32_t i)
+{
+  uint32_t j = i % 32;
+  return j == 0 ? ks[i / 32] : (ks[i / 32] << j) | (ks[i / 32 + 1] >> (32 - j));
+}
+
+#ifdef __PCLMUL__
+uint32_t reverse_bits(uint32_t x)
+{
+  x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+  x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+  x = ((x >> 4) & 0x0f0f0f0f) | ((x & 0x0f0f0f0f) << 4);
+  return __builtin_bswap32(x);
+}
+#endif // __PCLMUL__
+
+/// Computes the 128-EIA3 MAC of a message of len_bits bits from its nof_ks_words keystream words, 32 message bits at a
+/// time instead of bit by bit.
+uint32_t eia3_mac(const uint32_t* ks, uint32_t nof_ks_words, const uint8_t* msg, uint32_t len_bits)
+{
+  uint32_t T = 0;
+  for (uint32_t w = 0; 32 * w < len_bits; w++) {
+    uint32_t m = 0;
+    for (uint32_t b = 0; b < 4 && 32 * w + 8 * b < len_bits; b++) {
+      m |= (uint32_t)msg[4 * w + b] << (24 - 8 * b);
+    }
+    if (len_bits - 32 * w < 32) {
+      m &= ~0u << (32 - (len_bits - 32 * w));
+    }
+    // The keystream word of the message bit j, the MSB of m being j = 0, is bits [32, 64) of window << j
+    uint64_t window = ((uint64_t)ks[w] << 32) | ks[w + 1];
+#ifdef __PCLMUL__
+    // XORing them for all the set bits is a carry-less multiplication by m with its bits reversed
+    __m128i prod = _mm_clmulepi64_si128(_mm_cvtsi64_si128(window), _mm_cvtsi32_si128(reverse_bits(m)), 0x00);
+    T ^= (uint32_t)((uint64_t)_mm_cvtsi128_si64(prod) >> 32);
+#else  // __PCLMUL__
+    while (m != 0) {
+      uint32_t j = __builtin_clz(m);
+      T ^= (uint32_t)(window >> (32 - j));
+      m &= ~(0x80000000u >> j);
+    }
+#endif // __PCLMUL__
+  }
+  T ^= eia3_get_word(ks, len_bits);
+  return T ^ ks[nof_ks_words - 1];
+}
+
+uint32_t eia1_nof_ks_words(uint32_t msg_len)
+{
+  return 5;
+}
+
+uint32_t eia3_nof_ks_words(uint32_t msg_len)
+{
+  return (msg_len * 8 + 64 + 31) / 32;
+}
+
+uint32_t eea_nof_ks_words(uint32_t msg_len)
+{
+  return (msg_len + 3) / 4;
+}
+
+} // namespace
+
+uint8_t security_128_eia1_batch(const uint8_t* key, const security_pdu_t* pdus, uint32_t nof_pdus)
+{
+  if (!is_valid_batch(key, pdus, nof_pdus)) {
+    return SRSRAN_ERROR;
+  }
+  uint32_t k[4];
+  s3g_load_key(key, k);
+
+  process_batch(pdus, nof_pdus, eia1_nof_ks_words, [&k](keystream_group_t& group) {
+    uint32_t        iv[batch_max_lanes][4];
+    const uint32_t* keys[batch_max_lanes];
+    const uint32_t* ivs[batch_max_lanes];
+    for (uint32_t l = 0; l < group.nof_lanes; l++) {
+      // IV of f9 with FRESH = BEARER << 27 (TS 33.401, Annex B.2.2)
+      const security_pdu_t& pdu   = *group.pdu[l];
+      uint32_t              fresh = (uint32_t)pdu.bearer << 27;
+      iv[l][3]                    = pdu.count;
+      iv[l][2]                    = fresh;
+      iv[l][1]                    = pdu.count ^ ((uint32_t)pdu.direction << 31);
+      iv[l][0]                    = fresh ^ ((uint32_t)pdu.direction << 15);
+      keys[l]                     = k;
+      ivs[l]                      = iv[l];
+    }
+    s3g_mb_generate_keystream(group.nof_lanes, keys, ivs, group.len, group.ks);
+    for (uint32_t l = 0; l < group.nof_lanes; l++) {
+      s3g_f9_eval(group.ks[l], group.pdu[l]->msg, (uint64_t)group.pdu[l]->msg_len * 8, group.pdu[l]->out);
+    }
+  });
+  return SRSRAN_SUCCESS;
+}
+
+uint8_t security_128_eia3_batch(const uint8_t* key, const security_pdu_t* pdus, uint32_t nof_pdus)
+{
+  if (!is_valid_batch(key, pdus, nof_pdus)) {
+    return SRSRAN_ERROR;
+  }
+
+  process_batch(pdus, nof_pdus, eia3_nof_ks_words, [key](keystream_group_t& group) {
+    uint8_t        iv[batch_max_lanes][16];
+    const uint8_t* keys[batch_max_lanes];
+    const uint8_t* ivs[batch_max_lanes];
+    for (uint32_t l = 0; l < group.nof_lanes; l++) {
+      // TS 33.401, Annex B.2.3
+      const security_pdu_t& pdu = *group.pdu[l];
+      uint8_t*              v   = iv[l];
+      memset(v, 0, 16);
+      v[0]    = (pdu.count >> 24) & 0xFF;
+      v[1]    = (pdu.count >> 16) & 0xFF;
+      v[2]    = (pdu.count >> 8) & 0xFF;
+      v[3]    = pdu.count & 0xFF;
+      v[4]    = (pdu.bearer << 3) & 0xF8;
+      v[8]    = v[0] ^ ((pdu.direction & 1) << 7);
+      v[9]    = v[1];
+      v[10]   = v[2];
+      v[11]   = v[3];
+      v[12]   = v[4];
+      v[14]   = (pdu.direction & 1) << 7;
+      keys[l] = key;
+      ivs[l]  = iv[l];
+    }
+    zuc_mb_generate_keystream(group.nof_lanes, keys, ivs, group.len, group.ks);
+    for (uint32_t l = 0; l < group.nof_lanes; l++) {
+      const security_pdu_t& pdu = *group.pdu[l];
+      uint32_t              mac = eia3_mac(group.ks[l], group.len[l], pdu.msg, pdu.msg_len * 8);
+      pdu.out[0]                = (mac >> 24) & 0xFF;
+      pdu.out[1]                = (mac >> 16) & 0xFF;
+      pdu.out[2]                = (mac >> 8) & 0xFF;
+      pdu.out[3]                = mac & 0xFF;
+    }
+  });
+  return SRSRAN_SUCCESS;
+}
+
+uint8_t security_128_eea1_batch(const uint8_t* key, const security_pdu_t* pdus, uint32_t nof_pdus)
+{
+  if (!is_valid_batch(key, pdus, nof_pdus)) {
+    return SRSRAN_ERROR;
+  }
+  uint32_t k[4];
+  s3g_load_key(key, k);
+
+  process_batch(pdus, nof_pdus, eea_nof_ks_words, [&k](keystream_group_t& group) {
+    uint32_t        iv[batch_max_lanes][4];
+    const uint32_t* keys[batch_max_lanes];
+    const uint32_t* ivs[batch_max_lanes];
+    for (uint32_t l = 0; l < group.nof_lanes; l++) {
+      // TS 33.401, Annex B.1.2
+      const security_pdu_t& pdu = *group.pdu[l];
+      iv[l][3]                  = pdu.count;
+      iv[l][2]                  = ((pdu.bearer & 0x1F) << 27) | ((pdu.direction & 0x01) << 26);
+      iv[l][1]                  = iv[l][3];
+      iv[l][0]                  = iv[l][2];
+      keys[l]                   = k;
+      ivs[l]                    = iv[l];
+    }
+    s3g_mb_generate_keystream(group.nof_lanes, keys, ivs, group.len, group.ks);
+    for (uint32_t l = 0; l < group.nof_lanes; l++) {
+      xor_keystream(group.ks[l], group.pdu[l]->msg, group.pdu[l]->out, group.pdu[l]->msg_len);
+    }
+  });
+  return SRSRAN_SUCCESS;
+}
+
+uint8_t security_128_eea3_batch(const uint8_t* key, const security_pdu_t* pdus, uint32_t nof_pdus)
+{
+  if (!is_valid_batch(key, pdus, nof_pdus)) {
+    return SRSRAN_ERROR;
+  }
+
+  process_batch(pdus, nof_pdus, eea_nof_ks_words, [key](keystream_group_t& group) {
+    uint8_t        iv[batch_max_lanes][16];
+    const uint8_t* keys[batch_max_lanes];
+    const uint8_t* ivs[batch_max_lanes];
+    for (uint32_t l = 0; l < group.nof_lanes; l++) {
+      // TS 33.401, Annex B.1.4
+      const security_pdu_t& pdu = *group.pdu[l];
+      uint8_t*              v   = iv[l];
+      memset(v, 0, 16);
+      v[0] = (pdu.count >> 24) & 0xFF;
+      v[1] = (pdu.count >> 16) & 0xFF;
+      v[2] = (pdu.count >> 8) & 0xFF;
+      v[3] = pdu.count & 0xFF;
+      v[4] = ((pdu.bearer & 0x1F) << 3) | ((pdu.direction & 0x01) << 2);
+      memcpy(&v[8], &v[0], 8);
+      keys[l] = key;
+      ivs[l]  = iv[l];
+    }
+    zuc_mb_generate_keystream(group.nof_lanes, keys, ivs, group.len, group.ks);
+    for (uint32_t l = 0; l < group.nof_lanes; l++) {
+      xor_keystream(group.ks[l], group.pdu[l]->msg, group.pdu[l]->out, group.pdu[l]->msg_len);
+    }
+  });
+  return SRSRAN_SUCCESS;
+}
+
 /******************************************************************************
  * Authentication
  *****************************************************************************/
@@ -30,6 +30,7 @@
 ---------------------------------------------------------*/
 
 #include "srsran/common/zuc.h"
+#include "srsran/phy/utils/simd.h"
 
 #define MAKEU32(a, b, c, d) (((u32)(a) << 24) | ((u32)(b) << 16) | ((u32)(c) << 8) | ((u32)(d)))
 #define MulByPow2(x, k) ((((x) << k) | ((x) >> (31 - k))) & 0x7FFFFFFF)
@@ -252,3 +253,176 @@ void zuc_generate_keystream(zuc_state_t* state, int key_stream_len, u32* p_keyst
     LFSRWithWorkMode(state);
   }
 }
+
+#if SRSRAN_SIMD_I_SIZE
+
+/* S-boxes expanded to 32-bit words and shifted to their position in R1/R2, so that they can be gathered */
+typedef struct {
+  int32_t s0_24[256];
+  int32_t s1_16[256];
+  int32_t s0_8[256];
+  int32_t s1_0[256];
+} zuc_mb_sbox_t;
+
+static const zuc_mb_sbox_t* zuc_mb_get_sbox()
+{
+  static const zuc_mb_sbox_t sbox = []() {
+    zuc_mb_sbox_t t = {};
+    for (u32 i = 0; i < 256; i++) {
+      t.s0_24[i] = (int32_t)((u32)S0[i] << 24);
+      t.s1_16[i] = (int32_t)((u32)S1[i] << 16);
+      t.s0_8[i]  = (int32_t)((u32)S0[i] << 8);
+      t.s1_0[i]  = (int32_t)S1[i];
+    }
+    return t;
+  }();
+  return &sbox;
+}
+
+/* c = a + b mod (2^31 – 1), on every lane */
+static inline simd_i_t zuc_mb_addm(simd_i_t a, simd_i_t b)
+{
+  simd_i_t c = srsran_simd_i_add(a, b);
+  return srsran_simd_i_add(srsran_simd_i_and(c, srsran_simd_i_set1(0x7FFFFFFF)), srsran_simd_i_srl(c, 31));
+}
+
+static inline simd_i_t zuc_mb_mul_by_pow2(simd_i_t x, int k)
+{
+  return srsran_simd_i_and(srsran_simd_i_or(srsran_simd_i_sll(x, k), srsran_simd_i_srl(x, 31 - k)),
+                           srsran_simd_i_set1(0x7FFFFFFF));
+}
+
+static inline simd_i_t zuc_mb_rot(simd_i_t x, int k)
+{
+  return srsran_simd_i_or(srsran_simd_i_sll(x, k), srsran_simd_i_srl(x, 32 - k));
+}
+
+static inline simd_i_t zuc_mb_l1(simd_i_t x)
+{
+  simd_i_t r = srsran_simd_i_xor(x, zuc_mb_rot(x, 2));
+  r          = srsran_simd_i_xor(r, zuc_mb_rot(x, 10));
+  r          = srsran_simd_i_xor(r, zuc_mb_rot(x, 18));
+  return srsran_simd_i_xor(r, zuc_mb_rot(x, 24));
+}
+
+static inline simd_i_t zuc_mb_l2(simd_i_t x)
+{
+  simd_i_t r = srsran_simd_i_xor(x, zuc_mb_rot(x, 8));
+  r          = srsran_simd_i_xor(r, zuc_mb_rot(x, 14));
+  r          = srsran_simd_i_xor(r, zuc_mb_rot(x, 22));
+  return srsran_simd_i_xor(r, zuc_mb_rot(x, 30));
+}
+
+static inline simd_i_t zuc_mb_sbox(const zuc_mb_sbox_t* t, simd_i_t x)
+{
+  simd_i_t mask = srsran_simd_i_set1(0xFF);
+  simd_i_t b0   = srsran_simd_i_srl(x, 24);
+  simd_i_t b1   = srsran_simd_i_and(srsran_simd_i_srl(x, 16), mask);
+  simd_i_t b2   = srsran_simd_i_and(srsran_simd_i_srl(x, 8), mask);
+  simd_i_t b3   = srsran_simd_i_and(x, mask);
+  simd_i_t r    = srsran_simd_i_or(srsran_simd_i_gather(t->s0_24, b0), srsran_simd_i_gather(t->s1_16, b1));
+  r             = srsran_simd_i_or(r, srsran_simd_i_gather(t->s0_8, b2));
+  return srsran_simd_i_or(r, srsran_simd_i_gather(t->s1_0, b3));
+}
+
+/* Clocks all the lanes once: BitReorganization, F and LFSR update. The LFSR is kept as a circular buffer whose
+ * element s_0 is at lfsr[i % 16], so that clocking it does not move any data. Returns the keystream word W ^ X3, which
+ * is only meaningful in work mode. */
+static inline simd_i_t
+zuc_mb_clock(const zuc_mb_sbox_t* t, simd_i_t* lfsr, u32 i, simd_i_t* r1, simd_i_t* r2, bool init_mode)
+{
+#define ZUC_MB_S(k) lfsr[(i + (k)) & 15]
+  simd_i_t lo16 = srsran_simd_i_set1(0xFFFF);
+
+  /* BitReorganization */
+  simd_i_t x0 = srsran_simd_i_or(srsran_simd_i_sll(srsran_simd_i_and(ZUC_MB_S(15), srsran_simd_i_set1(0x7FFF8000)), 1),
+                                 srsran_simd_i_and(ZUC_MB_S(14), lo16));
+  simd_i_t x1 = srsran_simd_i_or(srsran_simd_i_sll(ZUC_MB_S(11), 16), srsran_simd_i_srl(ZUC_MB_S(9), 15));
+  simd_i_t x2 = srsran_simd_i_or(srsran_simd_i_sll(ZUC_MB_S(7), 16), srsran_simd_i_srl(ZUC_MB_S(5), 15));
+  simd_i_t x3 = srsran_simd_i_or(srsran_simd_i_sll(ZUC_MB_S(2), 16), srsran_simd_i_srl(ZUC_MB_S(0), 15));
+
+  /* F */
+  simd_i_t w  = srsran_simd_i_add(srsran_simd_i_xor(x0, *r1), *r2);
+  simd_i_t w1 = srsran_simd_i_add(*r1, x1);
+  simd_i_t w2 = srsran_simd_i_xor(*r2, x2);
+  simd_i_t u  = zuc_mb_l1(srsran_simd_i_or(srsran_simd_i_sll(w1, 16), srsran_simd_i_srl(w2, 16)));
+  simd_i_t v  = zuc_mb_l2(srsran_simd_i_or(srsran_simd_i_sll(w2, 16), srsran_simd_i_srl(w1, 16)));
+  *r1         = zuc_mb_sbox(t, u);
+  *r2         = zuc_mb_sbox(t, v);
+
+  /* LFSR, the new s_15 replaces s_0 */
+  simd_i_t f = ZUC_MB_S(0);
+  f          = zuc_mb_addm(f, zuc_mb_mul_by_pow2(ZUC_MB_S(0), 8));
+  f          = zuc_mb_addm(f, zuc_mb_mul_by_pow2(ZUC_MB_S(4), 20));
+  f          = zuc_mb_addm(f, zuc_mb_mul_by_pow2(ZUC_MB_S(10), 21));
+  f          = zuc_mb_addm(f, zuc_mb_mul_by_pow2(ZUC_MB_S(13), 17));
+  f          = zuc_mb_addm(f, zuc_mb_mul_by_pow2(ZUC_MB_S(15), 15));
+  if (init_mode) {
+    f = zuc_mb_addm(f, srsran_simd_i_srl(w, 1));
+  }
+  ZUC_MB_S(0) = f;
+#undef ZUC_MB_S
+
+  return srsran_simd_i_xor(w, x3);
+}
+
+#endif /* SRSRAN_SIMD_I_SIZE */
+
+void zuc_mb_generate_keystream(uint32_t         nof_lanes,
+                               const u8* const* k,
+                               const u8* const* iv,
+                               const uint32_t*  key_stream_len,
+                               u32* const*      p_keystream)
+{
+#if SRSRAN_SIMD_I_SIZE
+  const zuc_mb_sbox_t* t = zuc_mb_get_sbox();
+
+  for (uint32_t first = 0; first < nof_lanes; first += SRSRAN_SIMD_I_SIZE) {
+    uint32_t nof_active = nof_lanes - first < SRSRAN_SIMD_I_SIZE ? nof_lanes - first : SRSRAN_SIMD_I_SIZE;
+
+    /* expand key, unused lanes replicate the first one */
+    srsran_simd_aligned int buf[16][SRSRAN_SIMD_I_SIZE];
+    uint32_t                max_len = 0;
+    for (uint32_t l = 0; l < SRSRAN_SIMD_I_SIZE; l++) {
+      uint32_t lane = first + (l < nof_active ? l : 0);
+      for (uint32_t j = 0; j < 16; j++) {
+        buf[j][l] = (int)MAKEU31(k[lane][j], EK_d[j], iv[lane][j]);
+      }
+      if (key_stream_len[lane] > max_len) {
+        max_len = key_stream_len[lane];
+      }
+    }
+    simd_i_t lfsr[16];
+    for (uint32_t j = 0; j < 16; j++) {
+      lfsr[j] = srsran_simd_i_load(buf[j]);
+    }
+    simd_i_t r1 = srsran_simd_i_set1(0);
+    simd_i_t r2 = srsran_simd_i_set1(0);
+
+    /* initialization, then discard the output of the first clock in work mode */
+    for (u32 i = 0; i < 32; i++) {
+      zuc_mb_clock(t, lfsr, i, &r1, &r2, true);
+    }
+    zuc_mb_clock(t, lfsr, 0, &r1, &r2, false);
+
+    /* keystream, 16 words at a time, transposed from the lanes into the output of each lane */
+    for (uint32_t n = 0; n < max_len; n += 16) {
+      for (u32 i = 0; i < 16; i++) {
+        srsran_simd_i_store(buf[i], zuc_mb_clock(t, lfsr, i + 1, &r1, &r2, false));
+      }
+      for (uint32_t l = 0; l < nof_active; l++) {
+        uint32_t len = key_stream_len[first + l];
+        for (uint32_t i = 0; i < 16 && n + i < len; i++) {
+          p_keystream[first + l][n + i] = (u32)buf[i][l];
+        }
+      }
+    }
+  }
+#else  /* SRSRAN_SIMD_I_SIZE */
+  for (uint32_t l = 0; l < nof_lanes; l++) {
+    zuc_state_t state;
+    zuc_initialize(&state, k[l], (u8*)iv[l]);
+    zuc_generate_keystream(&state, key_stream_len[l], p_keystream[l]);
+  }
+#endif /* SRSRAN_SIMD_I_SIZE */
+}
@@ -21,6 +21,7 @@
 
 #include "srsran/upper/pdcp.h"
 #include "srsran/upper/pdcp_entity_nr.h"
+#include <algorithm>
 
 namespace srsran {
 
@@ -108,6 +109,30 @@ void pdcp::write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu)
   }
 }
 
+void pdcp::write_sdu_batch(uint32_t lcid, std::vector<unique_byte_buffer_t>& sdus)
+{
+  if (valid_lcid(lcid)) {
+    pdcp_array.at(lcid)->write_sdu_batch(sdus);
+  } else {
+    logger.warning("LCID %d doesn't exist. Deallocating %zd SDUs", lcid, sdus.size());
+  }
+  sdus.clear();
+}
+
+void pdcp::write_sdu_batch(std::vector<pdcp_sdu_t>& sdus)
+{
+  // Group the SDUs by bearer, keeping their order within each bearer, and process each group in a single pass
+  std::stable_sort(sdus.begin(), sdus.end(), [](const pdcp_sdu_t& a, const pdcp_sdu_t& b) { return a.lcid < b.lcid; });
+  for (auto it = sdus.begin(); it != sdus.end();) {
+    uint32_t lcid = it->lcid;
+    for (; it != sdus.end() and it->lcid == lcid; ++it) {
+      batch_sdus.push_back(std::move(it->sdu));
+    }
+    write_sdu_batch(lcid, batch_sdus);
+  }
+  sdus.clear();
+}
+
 int pdcp::add_bearer(uint32_t lcid, const pdcp_config_t& cfg)
 {
   if (valid_lcid(lcid)) {
@@ -36,6 +36,18 @@ void pdcp_entity_base::config_security(const as_security_config_t& sec_cfg_)
 {
   sec_cfg = sec_cfg_;
 
+  // Precompute the AES key schedules, so that they are not derived for every PDU
+  int_aes_ctx.is_set = false;
+  enc_aes_ctx.is_set = false;
+  if (sec_cfg.integ_algo == INTEGRITY_ALGORITHM_ID_128_EIA2) {
+    const as_key_t& k_int = is_srb() ? sec_cfg.k_rrc_int : sec_cfg.k_up_int;
+    security_aes_ctx_set_key(int_aes_ctx, &k_int[16]);
+  }
+  if (sec_cfg.cipher_algo == CIPHERING_ALGORITHM_ID_128_EEA2) {
+    const as_key_t& k_enc = is_srb() ? sec_cfg.k_rrc_enc : sec_cfg.k_up_enc;
+    security_aes_ctx_set_key(enc_aes_ctx, &k_enc[16]);
+  }
+
   logger.info("Configuring security with %s and %s",
               integrity_algorithm_id_text[sec_cfg.integ_algo],
               ciphering_algorithm_id_text[sec_cfg.cipher_algo]);
@@ -67,7 +79,7 @@ void pdcp_entity_base::integrity_generate(uint8_t* msg, uint32_t msg_len, uint32
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
+      security_128_eia2(int_aes_ctx, count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
@@ -105,7 +117,7 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
+      security_128_eia2(int_aes_ctx, count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
@@ -162,8 +174,8 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
       memcpy(ct, ct_tmp, msg_len);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
+      // CTR mode can operate in place, no need for an intermediate buffer
+      security_128_eea2(enc_aes_ctx, count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
       security_128_eea3(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
@@ -202,8 +214,7 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
       memcpy(msg, msg_tmp, ct_len);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
+      security_128_eea2(enc_aes_ctx, count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
       security_128_eea3(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
@@ -215,6 +226,86 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
   logger.debug(msg, ct_len, "Cipher decrypt output msg");
 }
 
+void pdcp_entity_base::integrity_generate_batch(security_pdu_t* pdus, uint32_t nof_pdus)
+{
+  uint8_t* k_int = is_srb() ? sec_cfg.k_rrc_int.data() : sec_cfg.k_up_int.data();
+
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    pdus[i].bearer    = cfg.bearer_id - 1;
+    pdus[i].direction = cfg.tx_direction;
+  }
+
+  switch (sec_cfg.integ_algo) {
+    case INTEGRITY_ALGORITHM_ID_EIA0:
+      break;
+    case INTEGRITY_ALGORITHM_ID_128_EIA1:
+      security_128_eia1_batch(&k_int[16], pdus, nof_pdus);
+      break;
+    case INTEGRITY_ALGORITHM_ID_128_EIA2:
+      // The AES key schedule is already shared by all the PDUs, process them one by one
+      for (uint32_t i = 0; i < nof_pdus; i++) {
+        const security_pdu_t& p = pdus[i];
+        security_128_eia2(int_aes_ctx, p.count, p.bearer, p.direction, p.msg, p.msg_len, p.out);
+      }
+      break;
+    case INTEGRITY_ALGORITHM_ID_128_EIA3:
+      security_128_eia3_batch(&k_int[16], pdus, nof_pdus);
+      break;
+    default:
+      break;
+  }
+
+  logger.debug("Integrity gen batch: %" PRIu32 " PDUs, Bearer ID %d, Direction %s",
+               nof_pdus,
+               cfg.bearer_id,
+               (cfg.tx_direction == SECURITY_DIRECTION_DOWNLINK ? "Downlink" : "Uplink"));
+}
+
+void pdcp_entity_base::cipher_encrypt_batch(security_pdu_t* pdus, uint32_t nof_pdus)
+{
+  uint8_t* k_enc = is_srb() ? sec_cfg.k_rrc_enc.data() : sec_cfg.k_up_enc.data();
+
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    pdus[i].bearer    = cfg.bearer_id - 1;
+    pdus[i].direction = cfg.tx_direction;
+  }
+
+  switch (sec_cfg.cipher_algo) {
+    case CIPHERING_ALGORITHM_ID_EEA0:
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA1:
+      security_128_eea1_batch(&k_enc[16], pdus, nof_pdus);
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA2:
+      for (uint32_t i = 0; i < nof_pdus; i++) {
+        const security_pdu_t& p = pdus[i];
+        security_128_eea2(enc_aes_ctx, p.count, p.bearer, p.direction, p.msg, p.msg_len, p.out);
+      }
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA3:
+      security_128_eea3_batch(&k_enc[16], pdus, nof_pdus);
+      break;
+    default:
+      break;
+  }
+
+  logger.debug("Cipher encrypt batch: %" PRIu32 " PDUs, Bearer ID %d, Direction %s",
+               nof_pdus,
+               cfg.bearer_id,
+               cfg.tx_direction == SECURITY_DIRECTION_DOWNLINK ? "Downlink" : "Uplink");
+}
+
+/****************************************************************************
+ * Batch interface
+ ***************************************************************************/
+void pdcp_entity_base::write_sdu_batch(span<unique_byte_buffer_t> sdus)
+{
+  // Entities without a batched TX path process the SDUs one by one
+  for (unique_byte_buffer_t& sdu : sdus) {
+    write_sdu(std::move(sdu));
+  }
+}
+
 /****************************************************************************
  * Common pack functions
  ***************************************************************************/
@@ -318,10 +409,10 @@ void pdcp_entity_base::extract_mac(const unique_byte_buffer_t& pdu, uint8_t* mac
   pdu->N_bytes -= 4;
 }
 
-void pdcp_entity_base::append_mac(const unique_byte_buffer_t& sdu, uint8_t* mac)
+void pdcp_entity_base::append_mac(unique_byte_buffer_t& sdu, uint8_t* mac)
 {
-  // Check enough space for MAC
-  if (sdu->N_bytes + 4 > sdu->get_tailroom()) {
+  // Check enough space for MAC, moving the SDU to a larger buffer if needed
+  if (not reserve_byte_buffer_tailroom(sdu, 4)) {
     logger.error("Not enough space to add MAC-I");
     return;
   }
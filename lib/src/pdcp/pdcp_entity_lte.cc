@@ -145,21 +145,112 @@ void pdcp_entity_lte::reset()
 // GW/RRC interface
 void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
 {
-  if (!active) {
-    logger.warning("Dropping %s SDU due to inactive bearer", rb_name.c_str());
+  if (not tx_allowed()) {
     return;
   }
 
-  if (rlc->is_suspended(lcid)) {
-    logger.warning("Trying to send SDU while re-establishment is in progress. Dropping SDU. LCID=%d", lcid);
+  if (rlc->sdu_queue_is_full(lcid)) {
+    logger.info(sdu->msg, sdu->N_bytes, "Dropping %s SDU due to full queue", rb_name.c_str());
     return;
   }
 
-  if (rlc->sdu_queue_is_full(lcid)) {
-    logger.info(sdu->msg, sdu->N_bytes, "Dropping %s SDU due to full queue", rb_name.c_str());
+  tx_pdu_info_t info;
+  if (not prepare_tx_pdu(sdu, upper_sn, info)) {
+    return;
+  }
+
+  // Append MAC (SRBs only)
+  if (info.do_integrity) {
+    integrity_generate(sdu->msg, sdu->N_bytes, info.count, info.mac);
+  }
+
+  if (is_srb()) {
+    append_mac(sdu, info.mac);
+  }
+
+  if (info.do_encryption) {
+    cipher_encrypt(
+        &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, info.count, &sdu->msg[cfg.hdr_len_bytes]);
+  }
+
+  send_tx_pdu(std::move(sdu), info);
+}
+
+void pdcp_entity_lte::write_sdu_batch(span<unique_byte_buffer_t> sdus)
+{
+  if (not tx_allowed()) {
+    for (unique_byte_buffer_t& sdu : sdus) {
+      sdu.reset();
+    }
     return;
   }
 
+  // None of the PDUs reaches RLC before the whole batch is processed, so query its free space once and drop the
+  // SDUs that do not fit before they consume a SN or get stored for retransmission
+  uint32_t nof_free = rlc->sdu_queue_free_space(lcid);
+
+  // Assign SNs and write the headers, compacting the accepted SDUs at the front of the span
+  tx_batch_info.resize(sdus.size());
+  uint32_t nof_sdus = 0;
+  for (unique_byte_buffer_t& sdu : sdus) {
+    if (nof_sdus == nof_free) {
+      logger.info(sdu->msg, sdu->N_bytes, "Dropping %s SDU due to full queue", rb_name.c_str());
+      continue;
+    }
+    if (prepare_tx_pdu(sdu, -1, tx_batch_info[nof_sdus])) {
+      sdus[nof_sdus++] = std::move(sdu);
+    }
+  }
+  for (uint32_t i = nof_sdus; i < sdus.size(); i++) {
+    sdus[i].reset(); // dropped SDUs
+  }
+
+  // Integrity protect all SRB PDUs at once, then append the MACs
+  if (is_srb()) {
+    tx_batch_sec.clear();
+    for (uint32_t i = 0; i < nof_sdus; i++) {
+      tx_pdu_info_t& info = tx_batch_info[i];
+      if (info.do_integrity) {
+        tx_batch_sec.push_back({info.count, 0, 0, sdus[i]->msg, sdus[i]->N_bytes, info.mac});
+      }
+    }
+    integrity_generate_batch(tx_batch_sec.data(), tx_batch_sec.size());
+    for (uint32_t i = 0; i < nof_sdus; i++) {
+      append_mac(sdus[i], tx_batch_info[i].mac);
+    }
+  }
+
+  // Cipher all PDUs at once, in place after the header
+  tx_batch_sec.clear();
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    if (tx_batch_info[i].do_encryption) {
+      uint8_t* payload = &sdus[i]->msg[cfg.hdr_len_bytes];
+      tx_batch_sec.push_back({tx_batch_info[i].count, 0, 0, payload, sdus[i]->N_bytes - cfg.hdr_len_bytes, payload});
+    }
+  }
+  cipher_encrypt_batch(tx_batch_sec.data(), tx_batch_sec.size());
+
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    send_tx_pdu(std::move(sdus[i]), tx_batch_info[i]);
+  }
+}
+
+bool pdcp_entity_lte::tx_allowed()
+{
+  if (!active) {
+    logger.warning("Dropping %s SDU due to inactive bearer", rb_name.c_str());
+    return false;
+  }
+
+  if (rlc->is_suspended(lcid)) {
+    logger.warning("Trying to send SDU while re-establishment is in progress. Dropping SDU. LCID=%d", lcid);
+    return false;
+  }
+  return true;
+}
+
+bool pdcp_entity_lte::prepare_tx_pdu(unique_byte_buffer_t& sdu, int upper_sn, tx_pdu_info_t& info)
+{
   // Get COUNT to be used with this packet
   uint32_t used_sn;
   if (upper_sn == -1) {
@@ -179,7 +270,7 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     if (not store_sdu(used_sn, sdu)) {
       // Could not store the SDU, discarding
       logger.warning("Could not store SDU. Discarding SN=%d", used_sn);
-      return;
+      return false;
     }
   }
   // check for pending security config in transmit direction
@@ -191,41 +282,35 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
 
   write_data_header(sdu, tx_count);
 
-  // Append MAC (SRBs only)
-  uint8_t mac[4]       = {};
-  bool    do_integrity = integrity_direction == DIRECTION_TX || integrity_direction == DIRECTION_TXRX;
-  if (do_integrity && is_srb()) {
-    integrity_generate(sdu->msg, sdu->N_bytes, tx_count, mac);
-  }
-
-  if (is_srb()) {
-    append_mac(sdu, mac);
-  }
+  info.sn            = used_sn;
+  info.count         = tx_count;
+  info.do_integrity  = is_srb() && (integrity_direction == DIRECTION_TX || integrity_direction == DIRECTION_TXRX);
+  info.do_encryption = encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX;
+  memset(info.mac, 0, sizeof(info.mac));
 
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
-    cipher_encrypt(
-        &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
+  // Increment NEXT_PDCP_TX_SN and TX_HFN (only update variables if SN was not provided by upper layers)
+  if (upper_sn == -1) {
+    st.next_pdcp_tx_sn++;
+    if (st.next_pdcp_tx_sn > maximum_pdcp_sn) {
+      st.tx_hfn++;
+      st.next_pdcp_tx_sn = 0;
+    }
   }
+  return true;
+}
 
+void pdcp_entity_lte::send_tx_pdu(unique_byte_buffer_t sdu, const tx_pdu_info_t& info)
+{
   logger.info(sdu->msg,
               sdu->N_bytes,
               "TX %s PDU, SN=%d, integrity=%s, encryption=%s",
               rb_name.c_str(),
-              used_sn,
+              info.sn,
               srsran_direction_text[integrity_direction],
               srsran_direction_text[encryption_direction]);
 
   // Set SDU metadata for RLC AM
-  sdu->md.pdcp_sn = used_sn;
-
-  // Increment NEXT_PDCP_TX_SN and TX_HFN (only update variables if SN was not provided by upper layers)
-  if (upper_sn == -1) {
-    st.next_pdcp_tx_sn++;
-    if (st.next_pdcp_tx_sn > maximum_pdcp_sn) {
-      st.tx_hfn++;
-      st.next_pdcp_tx_sn = 0;
-    }
-  }
+  sdu->md.pdcp_sn = info.sn;
 
   // Pass PDU to lower layers
   metrics.num_tx_pdus++;
@@ -902,8 +987,8 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
     }
   }
 
-  // Allocate buffer and exit on error
-  srsran::unique_byte_buffer_t tmp = make_byte_buffer();
+  // Allocate a buffer sized for the SDU, as it may be held for long, and exit on error
+  srsran::unique_byte_buffer_t tmp = make_sized_byte_buffer(sdu->N_bytes);
   if (tmp == nullptr) {
     return false;
   }
@@ -170,16 +170,12 @@ static inline void generate_taps(srsran_channel_fading_t* q, float time)
     cf_t a = get_doppler_dispersion(q, time, q->doppler, q->coeff_alpha[i], q->coeff_a[i], q->coeff_b[i]);
 
     if (i) {
-      // Copy tap frequency response
+      // Add scaled tap frequency response, already FFT shifted
       srsran_vec_sc_prod_ccc(q->h_tap[i], a, q->temp, q->N);
-
-      // Add to frequency response, shifts FFT at same time
-      srsran_vec_sum_ccc(q->h_freq, &q->temp[q->N / 2], q->h_freq, q->N / 2);
-      srsran_vec_sum_ccc(&q->h_freq[q->N / 2], q->temp, &q->h_freq[q->N / 2], q->N / 2);
+      srsran_vec_sum_ccc(q->h_freq, q->temp, q->h_freq, q->N);
     } else {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][q->N / 2], a, q->h_freq, q->N / 2);
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][0], a, &q->h_freq[q->N / 2], q->N / 2);
+      // Copy scaled tap frequency response, already FFT shifted
+      srsran_vec_sc_prod_ccc(q->h_tap[i], a, q->h_freq, q->N);
     }
   }
   // at this stage, q->h_freq should contain the frequency response
@@ -187,12 +183,12 @@ static inline void generate_taps(srsran_channel_fading_t* q, float time)
 
 static inline void filter_segment(srsran_channel_fading_t* q, const cf_t* input, cf_t* output, uint32_t nsamples)
 {
-  // Fill Input vector
-  srsran_vec_cf_copy(q->temp, input, nsamples);
-  srsran_vec_cf_zero(&q->temp[nsamples], q->N - nsamples);
+  // Slide the input window and append the new samples
+  memmove(q->state, &q->state[nsamples], sizeof(cf_t) * (q->N - nsamples));
+  srsran_vec_cf_copy(&q->state[q->N - nsamples], input, nsamples);
 
   // Do FFT
-  srsran_dft_run_c_zerocopy(&q->fft, q->temp, q->y_freq);
+  srsran_dft_run_c_zerocopy(&q->fft, q->state, q->y_freq);
 
   // Apply channel
   srsran_vec_prod_ccc(q->y_freq, q->h_freq, q->y_freq, q->N);
@@ -200,15 +196,8 @@ static inline void filter_segment(srsran_channel_fading_t* q, const cf_t* input,
   // Do iFFT
   srsran_dft_run_c_zerocopy(&q->ifft, q->y_freq, q->temp);
 
-  // Add state
-  srsran_vec_sum_ccc(q->temp, q->state, q->temp, q->state_len);
-
-  // Copy the first nsamples into the output
-  srsran_vec_cf_copy(output, q->temp, nsamples);
-
-  // Copy the rest of the samples into the state
-  q->state_len = q->N - nsamples;
-  srsran_vec_cf_copy(q->state, &q->temp[nsamples], q->state_len);
+  // The last nsamples are free of circular convolution aliasing, copy them into the output
+  srsran_vec_cf_copy(output, &q->temp[q->N - nsamples], nsamples);
 }
 
 int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const char* model, uint32_t seed)
@@ -230,7 +219,13 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
         (uint32_t)round(log2(excess_tap_delay_ns[q->model][nof_taps[q->model] - 1] * 1e-9 * srate)) + 3;
     q->N          = SRSRAN_MAX(1U << fft_min_pow, (uint32_t)(srate / (15e3f * 4.0f)));
     q->path_delay = q->N / 4;
-    q->state_len  = 0;
+    q->taps_valid = false;
+
+    // Update the taps several times per doppler period, a static channel only needs them once
+    q->update_period = INFINITY;
+    if (q->doppler > 0.0f) {
+      q->update_period = 1.0 / (q->doppler * SRSRAN_CHANNEL_FADING_UPDATES_PER_CYCLE);
+    }
 
     // Initialise random number
     srsran_random_t* random = srsran_random_init(seed);
@@ -250,6 +245,13 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
       // Generate tap frequency response
       generate_tap(
           excess_tap_delay_ns[q->model][i], relative_power_db[q->model][i], q->srate, q->h_tap[i], q->N, q->path_delay);
+
+      // Shift FFT once, so that the taps are combined without shifting
+      for (uint32_t k = 0; k < q->N / 2; k++) {
+        cf_t tmp                  = q->h_tap[i][k];
+        q->h_tap[i][k]            = q->h_tap[i][k + q->N / 2];
+        q->h_tap[i][k + q->N / 2] = tmp;
+      }
     }
 
     // Generate sine Table
@@ -293,7 +295,7 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
 
     q->state = srsran_vec_cf_malloc(q->N);
     if (!q->state) {
-      fprintf(stderr, "Error: allocating y_freq\n");
+      fprintf(stderr, "Error: allocating state\n");
       goto clean_exit;
     }
     srsran_vec_cf_zero(q->state, q->N);
@@ -345,8 +347,12 @@ double srsran_channel_fading_execute(srsran_channel_fading_t* q,
 
   if (q) {
     while (counter < nsamples) {
-      // Generate taps
-      generate_taps(q, (float)init_time);
+      // Generate taps only once per update period, the segments in between share the same frequency response
+      if (!q->taps_valid || fabs(init_time - q->last_update) >= q->update_period) {
+        generate_taps(q, (float)init_time);
+        q->taps_valid  = true;
+        q->last_update = init_time;
+      }
 
       // Do not process more than N/2 samples
       uint32_t n = SRSRAN_MIN(q->N / 2, nsamples - counter);
@@ -0,0 +1,150 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/channel/channel.h"
+#include "srsran/phy/utils/vector.h"
+#include <chrono>
+#include <unistd.h>
+#include <vector>
+
+static std::string model        = "";
+static uint32_t    nof_channels = 4;
+static uint32_t    nof_threads  = 0;
+static uint32_t    duration_ms  = 100;
+static uint32_t    srate        = (uint32_t)23.04e6;
+static bool        awgn_enable  = false;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [mcTtsah]\n", prog);
+  printf("\t-m Channel model, e.g. epa5, eva70, etu300 [Default epa5, eva70 and etu300]\n");
+  printf("\t-c Number of channels: [Default %d]\n", nof_channels);
+  printf("\t-T Number of threads: [Default 1 and number of channels]\n");
+  printf("\t-t Simulation time in ms: [Default %d]\n", duration_ms);
+  printf("\t-s Sampling rate in Hz: [Default %d]\n", srate);
+  printf("\t-a Enable AWGN: [Default %s]\n", awgn_enable ? "enabled" : "disabled");
+}
+
+static int parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "m:c:T:t:s:ah")) != -1) {
+    switch (opt) {
+      case 'm':
+        model = optarg;
+        break;
+      case 'c':
+        nof_channels = (uint32_t)strtol(optarg, nullptr, 10);
+        break;
+      case 'T':
+        nof_threads = (uint32_t)strtol(optarg, nullptr, 10);
+        break;
+      case 't':
+        duration_ms = (uint32_t)strtol(optarg, nullptr, 10);
+        break;
+      case 's':
+        srate = (uint32_t)strtof(optarg, nullptr);
+        break;
+      case 'a':
+        awgn_enable = true;
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+  if (nof_channels == 0 || nof_channels > SRSRAN_MAX_CHANNELS) {
+    fprintf(stderr, "Error: invalid number of channels %d\n", nof_channels);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// Runs the channel emulator for the configured duration and returns the aggregated throughput in samples per second
+static double run_benchmark(const std::string& fading_model, uint32_t threads)
+{
+  srsran::channel::args_t args;
+  args.enable        = true;
+  args.nof_threads   = threads;
+  args.fading_enable = true;
+  args.fading_model  = fading_model;
+  args.awgn_enable   = awgn_enable;
+
+  srsran::channel channel(args, nof_channels, srslog::fetch_basic_logger("CHAN"));
+  channel.set_srate(srate);
+
+  uint32_t sf_len                       = srate / 1000;
+  cf_t*    buffers[SRSRAN_MAX_CHANNELS] = {};
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    buffers[i] = srsran_vec_cf_malloc(sf_len);
+    srsran_vec_gen_sine(1.0f, 0.01f * (i + 1), buffers[i], sf_len);
+  }
+
+  srsran_timestamp_t                    t     = {};
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < duration_ms; i++) {
+    srsran_timestamp_init(&t, i / 1000, (double)(i % 1000) / 1000.0);
+    channel.run(buffers, buffers, sf_len, t);
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    free(buffers[i]);
+  }
+
+  return (double)duration_ms * sf_len * nof_channels / elapsed.count();
+}
+
+int main(int argc, char** argv)
+{
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  srslog::fetch_basic_logger("CHAN").set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  std::vector<std::string> models = {"epa5", "eva70", "etu300"};
+  if (not model.empty()) {
+    models = {model};
+  }
+  std::vector<uint32_t> threads = {1, nof_channels};
+  if (nof_threads != 0 || nof_channels == 1) {
+    threads = {nof_threads != 0 ? nof_threads : 1};
+  }
+
+  printf("-- Channel emulator benchmark. srate=%.2fMHz; channels=%d; duration=%dms\n",
+         (double)srate / 1e6,
+         nof_channels,
+         duration_ms);
+  for (const std::string& m : models) {
+    for (uint32_t n : threads) {
+      double sps = run_benchmark(m, n);
+      printf("model=%-7s threads=%d: %6.1f MSps (%.2f x real time)\n",
+             m.c_str(),
+             n,
+             sps / 1e6,
+             sps / ((double)srate * nof_channels));
+    }
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -21,10 +21,15 @@
 
 #include "srsran/srsran.h"
 #include <complex.h>
+#include <fcntl.h>
 #include <fftw3.h>
+#include <limits.h>
 #include <math.h>
 #include <pwd.h>
 #include <string.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "srsran/phy/dft/dft.h"
@@ -35,8 +40,19 @@
 
 #define FFTW_WISDOM_FILE "%s/.srsran_fftwisdom"
 
+// Environment variable overriding the wisdom file location, e.g. to use a file pre-generated with fftw_wisdom
+#define FFTW_WISDOM_ENV "SRSRAN_FFTW_WISDOM"
+
+// FFTW plans are only shared between arrays with the same alignment modulo the largest SIMD alignment
+#define DFT_PLAN_ALIGNMENT 64
+
 static int get_fftw_wisdom_file(char* full_path, uint32_t n)
 {
+  const char* env_path = getenv(FFTW_WISDOM_ENV);
+  if (env_path != NULL && env_path[0] != '\0') {
+    return snprintf(full_path, n, "%s", env_path);
+  }
+
   const char* homedir = NULL;
   if ((homedir = getenv("HOME")) == NULL) {
     homedir = getpwuid(getuid())->pw_dir;
@@ -53,56 +69,282 @@ static int get_fftw_wisdom_file(char* full_path, uint32_t n)
 
 static pthread_mutex_t fft_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-// This function is called in the beggining of any executable where it is linked
-__attribute__((constructor)) static void srsran_dft_load()
+typedef enum { DFT_PLAN_C = 0, DFT_PLAN_R, DFT_PLAN_GURU_C } dft_plan_kind_t;
+
+// Parameters identifying an FFTW plan. All the fields are int, without padding, so keys can be compared with memcmp()
+typedef struct {
+  int kind;
+  int size;
+  int sign;
+  int istride;
+  int ostride;
+  int how_many;
+  int idist;
+  int odist;
+  int in_place;
+  int in_align;
+  int out_align;
+} dft_plan_key_t;
+
+// In-memory plan registry: DFT plans of the same transform share a single FFTW plan, executed with their own arrays
+typedef struct dft_plan_entry_s {
+  dft_plan_key_t           key;
+  void*                    p;
+  uint32_t                 nof_users;
+  struct dft_plan_entry_s* next;
+} dft_plan_entry_t;
+
+static dft_plan_entry_t*    plan_registry = NULL;
+static srsran_dft_metrics_t dft_metrics;
+static char*                loaded_wisdom = NULL;  // Wisdom as loaded or last stored, to skip redundant stores
+static bool                 wisdom_dirty  = false; // Whether FFTW planned since the wisdom was loaded or stored
+
+static double dft_elapsed_s(const struct timespec* t_start)
+{
+  struct timespec t_end;
+  clock_gettime(CLOCK_MONOTONIC, &t_end);
+  return (double)(t_end.tv_sec - t_start->tv_sec) + (double)(t_end.tv_nsec - t_start->tv_nsec) * 1e-9;
+}
+
+static void dft_plan_key_init(dft_plan_key_t* key, dft_plan_kind_t kind, int size, int sign, void* in, void* out)
+{
+  bzero(key, sizeof(dft_plan_key_t));
+  key->kind      = kind;
+  key->size      = size;
+  key->sign      = sign;
+  key->istride   = 1;
+  key->ostride   = 1;
+  key->how_many  = 1;
+  key->idist     = 1;
+  key->odist     = 1;
+  key->in_place  = (in == out);
+  key->in_align  = (int)((uintptr_t)in % DFT_PLAN_ALIGNMENT);
+  key->out_align = (int)((uintptr_t)out % DFT_PLAN_ALIGNMENT);
+}
+
+// Returns the FFTW plan of a transform, which is only created if no other DFT plan uses it. Requires fft_mutex
+static void* dft_plan_acquire(const dft_plan_key_t* key, void* in, void* out)
+{
+  dft_metrics.nof_plans++;
+  for (dft_plan_entry_t* e = plan_registry; e != NULL; e = e->next) {
+    if (memcmp(&e->key, key, sizeof(dft_plan_key_t)) == 0) {
+      e->nof_users++;
+      dft_metrics.nof_cache_hits++;
+      return e->p;
+    }
+  }
+
+  struct timespec t_start;
+  clock_gettime(CLOCK_MONOTONIC, &t_start);
+  void* p = NULL;
+  switch (key->kind) {
+    case DFT_PLAN_C:
+      p = fftwf_plan_dft_1d(key->size, in, out, key->sign, FFTW_TYPE);
+      break;
+    case DFT_PLAN_R:
+      p = fftwf_plan_r2r_1d(key->size, in, out, (fftwf_r2r_kind)key->sign, FFTW_TYPE);
+      break;
+    case DFT_PLAN_GURU_C: {
+      const fftwf_iodim iodim        = {key->size, key->istride, key->ostride};
+      const fftwf_iodim howmany_dims = {key->how_many, key->idist, key->odist};
+      p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in, out, key->sign, FFTW_TYPE);
+      break;
+    }
+  }
+  dft_metrics.planning_time_s += dft_elapsed_s(&t_start);
+  wisdom_dirty = true;
+  if (p == NULL) {
+    return NULL;
+  }
+
+  dft_plan_entry_t* entry = calloc(1, sizeof(dft_plan_entry_t));
+  if (entry == NULL) {
+    fftwf_destroy_plan(p);
+    return NULL;
+  }
+  entry->key       = *key;
+  entry->p         = p;
+  entry->nof_users = 1;
+  entry->next      = plan_registry;
+  plan_registry    = entry;
+  dft_metrics.nof_fftw_plans++;
+
+  return p;
+}
+
+// Releases a plan returned by dft_plan_acquire(), destroying it once it has no users. Requires fft_mutex
+static void dft_plan_release(void* p)
+{
+  for (dft_plan_entry_t** e = &plan_registry; *e != NULL; e = &(*e)->next) {
+    if ((*e)->p == p) {
+      dft_plan_entry_t* entry = *e;
+      if (--entry->nof_users == 0) {
+        *e = entry->next;
+        fftwf_destroy_plan(entry->p);
+        free(entry);
+        dft_metrics.nof_fftw_plans--;
+      }
+      return;
+    }
+  }
+}
+
+int srsran_dft_load_wisdom(const char* filename)
 {
 #ifdef FFTW_WISDOM_FILE
-  char full_path[256];
-  get_fftw_wisdom_file(full_path, sizeof(full_path));
-  // lockf needs a file descriptor open for writing, so this must be r+
-  FILE* fd = fopen(full_path, "r+");
-  if (fd == NULL) {
-    return;
+  char full_path[PATH_MAX];
+  if (filename == NULL) {
+    int n = get_fftw_wisdom_file(full_path, sizeof(full_path));
+    if (n < 0 || n >= (int)sizeof(full_path)) {
+      fprintf(stderr, "Error: FFTW wisdom file path is too long\n");
+      return SRSRAN_ERROR;
+    }
+    filename = full_path;
   }
-  if (lockf(fileno(fd), F_LOCK, 0) == -1) {
-    perror("lockf()");
-    fclose(fd);
-    return;
+
+  struct timespec t_start;
+  clock_gettime(CLOCK_MONOTONIC, &t_start);
+
+  // The wisdom file is always replaced atomically, so it can be read without locking
+  FILE* fd = fopen(filename, "r");
+  if (fd == NULL) {
+    return SRSRAN_ERROR;
   }
-  fftwf_import_wisdom_from_file(fd);
-  if (lockf(fileno(fd), F_ULOCK, 0) == -1) {
-    perror("u-lockf()");
-    fclose(fd);
-    return;
+  pthread_mutex_lock(&fft_mutex);
+  int imported = fftwf_import_wisdom_from_file(fd);
+  if (imported) {
+    free(loaded_wisdom);
+    loaded_wisdom             = fftwf_export_wisdom_to_string();
+    dft_metrics.wisdom_loaded = true;
   }
+  dft_metrics.wisdom_load_time_s += dft_elapsed_s(&t_start);
+  pthread_mutex_unlock(&fft_mutex);
   fclose(fd);
+
+  return imported ? SRSRAN_SUCCESS : SRSRAN_ERROR;
 #else
   printf("Warning: FFTW Wisdom file not defined\n");
+  return SRSRAN_ERROR;
 #endif
 }
 
-// This function is called in the ending of any executable where it is linked
-__attribute__((destructor)) void srsran_dft_exit()
+int srsran_dft_store_wisdom(const char* filename)
 {
 #ifdef FFTW_WISDOM_FILE
-  char full_path[256];
-  get_fftw_wisdom_file(full_path, sizeof(full_path));
-  FILE* fd = fopen(full_path, "w");
-  if (fd == NULL) {
-    return;
+  char full_path[PATH_MAX];
+  bool is_default = (filename == NULL);
+  if (is_default) {
+    int n = get_fftw_wisdom_file(full_path, sizeof(full_path));
+    if (n < 0 || n >= (int)sizeof(full_path)) {
+      fprintf(stderr, "Error: FFTW wisdom file path is too long\n");
+      return SRSRAN_ERROR;
+    }
+    filename = full_path;
   }
-  if (lockf(fileno(fd), F_LOCK, 0) == -1) {
-    perror("lockf()");
-    fclose(fd);
-    return;
+
+  // Paths of the lock file and of the temporary file that replaces the wisdom file
+  char lock_path[PATH_MAX];
+  char tmp_path[PATH_MAX];
+  int  lock_len = snprintf(lock_path, sizeof(lock_path), "%s.lock", filename);
+  int  tmp_len  = snprintf(tmp_path, sizeof(tmp_path), "%s.XXXXXX", filename);
+  if (lock_len < 0 || lock_len >= (int)sizeof(lock_path) || tmp_len < 0 || tmp_len >= (int)sizeof(tmp_path)) {
+    fprintf(stderr, "Error: FFTW wisdom file path is too long\n");
+    return SRSRAN_ERROR;
+  }
+
+  int ret = SRSRAN_ERROR;
+  pthread_mutex_lock(&fft_mutex);
+
+  // Skip storing the default wisdom file if no wisdom was gathered since it was loaded or stored
+  bool unchanged = is_default && !wisdom_dirty;
+  if (is_default && !unchanged && loaded_wisdom != NULL) {
+    char* wisdom = fftwf_export_wisdom_to_string();
+    unchanged    = (wisdom != NULL) && (strcmp(wisdom, loaded_wisdom) == 0);
+    free(wisdom);
+  }
+  if (unchanged) {
+    pthread_mutex_unlock(&fft_mutex);
+    return SRSRAN_SUCCESS;
   }
-  fftwf_export_wisdom_to_file(fd);
-  if (lockf(fileno(fd), F_ULOCK, 0) == -1) {
-    perror("u-lockf()");
+
+  // Serialize the stores of concurrent processes, each one merging its wisdom with the one already stored
+  int lock_fd = open(lock_path, O_RDWR | O_CREAT, 0644);
+  if (lock_fd < 0) {
+    perror("open()");
+    pthread_mutex_unlock(&fft_mutex);
+    return SRSRAN_ERROR;
+  }
+  if (flock(lock_fd, LOCK_EX) < 0) {
+    perror("flock()");
+    close(lock_fd);
+    pthread_mutex_unlock(&fft_mutex);
+    return SRSRAN_ERROR;
+  }
+  FILE* fd = fopen(filename, "r");
+  if (fd != NULL) {
+    fftwf_import_wisdom_from_file(fd);
     fclose(fd);
+  }
+
+  // Write a temporary file and rename it, so that readers never see a partially written wisdom file
+  int tmp_fd = mkstemp(tmp_path);
+  if (tmp_fd < 0) {
+    perror("mkstemp()");
+  } else {
+    fchmod(tmp_fd, 0644);
+    FILE* tmp = fdopen(tmp_fd, "w");
+    if (tmp == NULL) {
+      close(tmp_fd);
+    } else {
+      fftwf_export_wisdom_to_file(tmp);
+      bool written = (fflush(tmp) == 0) && (fsync(fileno(tmp)) == 0);
+      written      = (fclose(tmp) == 0) && written;
+      if (written && rename(tmp_path, filename) == 0) {
+        if (is_default) {
+          free(loaded_wisdom);
+          loaded_wisdom = fftwf_export_wisdom_to_string();
+          wisdom_dirty  = false;
+        }
+        ret = SRSRAN_SUCCESS;
+      }
+    }
+    if (ret != SRSRAN_SUCCESS) {
+      perror("Error storing FFTW wisdom");
+      unlink(tmp_path);
+    }
+  }
+
+  flock(lock_fd, LOCK_UN);
+  close(lock_fd);
+  pthread_mutex_unlock(&fft_mutex);
+
+  return ret;
+#else
+  return SRSRAN_ERROR;
+#endif
+}
+
+void srsran_dft_get_metrics(srsran_dft_metrics_t* metrics)
+{
+  if (metrics == NULL) {
     return;
   }
-  fclose(fd);
+  pthread_mutex_lock(&fft_mutex);
+  *metrics = dft_metrics;
+  pthread_mutex_unlock(&fft_mutex);
+}
+
+// This function is called in the beggining of any executable where it is linked
+__attribute__((constructor)) static void srsran_dft_load()
+{
+  srsran_dft_load_wisdom(NULL);
+}
+
+// This function is called in the ending of any executable where it is linked
+__attribute__((destructor)) void srsran_dft_exit()
+{
+#ifdef FFTW_WISDOM_FILE
+  srsran_dft_store_wisdom(NULL);
 #endif
   fftwf_cleanup();
 }
@@ -153,15 +395,22 @@ int srsran_dft_replan_guru_c(srsran_dft_plan_t* plan,
 {
   int sign = (plan->forward) ? FFTW_FORWARD : FFTW_BACKWARD;
 
-  const fftwf_iodim iodim        = {new_dft_points, istride, ostride};
-  const fftwf_iodim howmany_dims = {how_many, idist, odist};
+  dft_plan_key_t key;
+  dft_plan_key_init(&key, DFT_PLAN_GURU_C, new_dft_points, sign, in_buffer, out_buffer);
+  key.istride  = istride;
+  key.ostride  = ostride;
+  key.how_many = how_many;
+  key.idist    = idist;
+  key.odist    = odist;
 
   pthread_mutex_lock(&fft_mutex);
 
-  /* Destroy current plan */
-  fftwf_destroy_plan(plan->p);
+  /* Release current plan */
+  if (plan->p) {
+    dft_plan_release(plan->p);
+  }
 
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  plan->p = dft_plan_acquire(&key, in_buffer, out_buffer);
 
   pthread_mutex_unlock(&fft_mutex);
 
@@ -170,6 +419,8 @@ int srsran_dft_replan_guru_c(srsran_dft_plan_t* plan,
   }
   plan->size      = new_dft_points;
   plan->init_size = plan->size;
+  plan->in        = in_buffer;
+  plan->out       = out_buffer;
 
   return 0;
 }
@@ -183,12 +434,15 @@ int srsran_dft_replan_c(srsran_dft_plan_t* plan, const int new_dft_points)
     return 0;
   }
 
+  dft_plan_key_t key;
+  dft_plan_key_init(&key, DFT_PLAN_C, new_dft_points, sign, plan->in, plan->out);
+
   pthread_mutex_lock(&fft_mutex);
   if (plan->p) {
-    fftwf_destroy_plan(plan->p);
+    dft_plan_release(plan->p);
     plan->p = NULL;
   }
-  plan->p = fftwf_plan_dft_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  plan->p = dft_plan_acquire(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -211,12 +465,17 @@ int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
 {
   int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
 
-  const fftwf_iodim iodim        = {dft_points, istride, ostride};
-  const fftwf_iodim howmany_dims = {how_many, idist, odist};
+  dft_plan_key_t key;
+  dft_plan_key_init(&key, DFT_PLAN_GURU_C, dft_points, sign, in_buffer, out_buffer);
+  key.istride  = istride;
+  key.ostride  = ostride;
+  key.how_many = how_many;
+  key.idist    = idist;
+  key.odist    = odist;
 
   pthread_mutex_lock(&fft_mutex);
 
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  plan->p = dft_plan_acquire(&key, in_buffer, out_buffer);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -225,6 +484,8 @@ int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
 
   plan->size      = dft_points;
   plan->init_size = plan->size;
+  plan->in        = in_buffer;
+  plan->out       = out_buffer;
   plan->mode      = SRSRAN_DFT_COMPLEX;
   plan->dir       = dir;
   plan->forward   = (dir == SRSRAN_DFT_FORWARD) ? true : false;
@@ -241,11 +502,12 @@ int srsran_dft_plan_c(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_
 {
   allocate(plan, sizeof(fftwf_complex), sizeof(fftwf_complex), dft_points);
 
-  pthread_mutex_lock(&fft_mutex);
-
-  int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
-  plan->p  = fftwf_plan_dft_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  int            sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
+  dft_plan_key_t key;
+  dft_plan_key_init(&key, DFT_PLAN_C, dft_points, sign, plan->in, plan->out);
 
+  pthread_mutex_lock(&fft_mutex);
+  plan->p = dft_plan_acquire(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -269,12 +531,15 @@ int srsran_dft_replan_r(srsran_dft_plan_t* plan, const int new_dft_points)
 {
   int sign = (plan->dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
 
+  dft_plan_key_t key;
+  dft_plan_key_init(&key, DFT_PLAN_R, new_dft_points, sign, plan->in, plan->out);
+
   pthread_mutex_lock(&fft_mutex);
   if (plan->p) {
-    fftwf_destroy_plan(plan->p);
+    dft_plan_release(plan->p);
     plan->p = NULL;
   }
-  plan->p = fftwf_plan_r2r_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  plan->p = dft_plan_acquire(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -289,8 +554,11 @@ int srsran_dft_plan_r(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_
   allocate(plan, sizeof(float), sizeof(float), dft_points);
   int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
 
+  dft_plan_key_t key;
+  dft_plan_key_init(&key, DFT_PLAN_R, dft_points, sign, plan->in, plan->out);
+
   pthread_mutex_lock(&fft_mutex);
-  plan->p = fftwf_plan_r2r_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  plan->p = dft_plan_acquire(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -372,7 +640,7 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
   fftwf_complex* f_out = plan->out;
 
   copy_pre((uint8_t*)plan->in, (uint8_t*)in, sizeof(cf_t), plan->size, plan->forward, plan->mirror, plan->dc);
-  fftwf_execute(plan->p);
+  fftwf_execute_dft(plan->p, plan->in, plan->out);
   if (plan->norm) {
     norm = 1.0 / sqrtf(plan->size);
     srsran_vec_sc_prod_cfc(f_out, norm, f_out, plan->size);
@@ -388,7 +656,7 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
 void srsran_dft_run_guru_c(srsran_dft_plan_t* plan)
 {
   if (plan->is_guru == true) {
-    fftwf_execute(plan->p);
+    fftwf_execute_dft(plan->p, plan->in, plan->out);
   } else {
     ERROR("srsran_dft_run_guru_c: the selected plan is not guru!");
   }
@@ -402,7 +670,7 @@ void srsran_dft_run_r(srsran_dft_plan_t* plan, const float* in, float* out)
   float* f_out = plan->out;
 
   memcpy(plan->in, in, sizeof(float) * plan->size);
-  fftwf_execute(plan->p);
+  fftwf_execute_r2r(plan->p, plan->in, plan->out);
   if (plan->norm) {
     norm = 1.0 / plan->size;
     srsran_vec_sc_prod_fff(f_out, norm, f_out, plan->size);
@@ -430,7 +698,7 @@ void srsran_dft_plan_free(srsran_dft_plan_t* plan)
       fftwf_free(plan->out);
   }
   if (plan->p)
-    fftwf_destroy_plan(plan->p);
+    dft_plan_release(plan->p);
   pthread_mutex_unlock(&fft_mutex);
   bzero(plan, sizeof(srsran_dft_plan_t));
 }
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/dft/dft.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/support/srsran_test.h"
+#include <complex.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define DFT_SIZE 1536
+
+// Plans of the same transform share one FFTW plan, which keeps working after any of its users is freed
+static int test_plan_sharing()
+{
+  srsran_dft_metrics_t before = {};
+  srsran_dft_metrics_t after  = {};
+  srsran_dft_get_metrics(&before);
+
+  srsran_dft_plan_t plan_a = {};
+  srsran_dft_plan_t plan_b = {};
+  srsran_dft_plan_t plan_c = {};
+  TESTASSERT(srsran_dft_plan_c(&plan_a, DFT_SIZE, SRSRAN_DFT_FORWARD) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_dft_plan_c(&plan_b, DFT_SIZE, SRSRAN_DFT_FORWARD) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_dft_plan_c(&plan_c, DFT_SIZE, SRSRAN_DFT_BACKWARD) == SRSRAN_SUCCESS);
+  TESTASSERT(plan_a.p == plan_b.p);
+  TESTASSERT(plan_a.p != plan_c.p);
+
+  srsran_dft_get_metrics(&after);
+  TESTASSERT(after.nof_plans == before.nof_plans + 3);
+  TESTASSERT(after.nof_cache_hits == before.nof_cache_hits + 1);
+  TESTASSERT(after.nof_fftw_plans == before.nof_fftw_plans + 2);
+
+  cf_t* in    = srsran_vec_cf_malloc(DFT_SIZE);
+  cf_t* out_a = srsran_vec_cf_malloc(DFT_SIZE);
+  cf_t* out_b = srsran_vec_cf_malloc(DFT_SIZE);
+  TESTASSERT(in != NULL && out_a != NULL && out_b != NULL);
+  for (uint32_t i = 0; i < DFT_SIZE; i++) {
+    in[i] = cexpf(_Complex_I * 2.0f * (float)M_PI * 7.0f * (float)i / DFT_SIZE);
+  }
+
+  // A complex exponential transforms into a single bin
+  srsran_dft_run_c(&plan_a, in, out_a);
+  TESTASSERT(cabsf(out_a[7] - DFT_SIZE) < 1e-2f * DFT_SIZE);
+  TESTASSERT(srsran_vec_avg_power_cf(out_a, DFT_SIZE) < 1.01f * DFT_SIZE);
+
+  srsran_dft_plan_free(&plan_a);
+  srsran_dft_run_c(&plan_b, in, out_b);
+  TESTASSERT(srsran_vec_avg_power_cf(out_b, DFT_SIZE) > 0.99f * DFT_SIZE);
+  TESTASSERT(cabsf(out_b[7] - DFT_SIZE) < 1e-2f * DFT_SIZE);
+
+  srsran_dft_plan_free(&plan_b);
+  srsran_dft_plan_free(&plan_c);
+  srsran_dft_get_metrics(&after);
+  TESTASSERT(after.nof_fftw_plans == before.nof_fftw_plans);
+
+  free(in);
+  free(out_a);
+  free(out_b);
+  return SRSRAN_SUCCESS;
+}
+
+// Guru plans are only shared between buffers with the same layout
+static int test_guru_sharing()
+{
+  cf_t* buffer_a = srsran_vec_cf_malloc(2 * DFT_SIZE);
+  cf_t* buffer_b = srsran_vec_cf_malloc(2 * DFT_SIZE);
+  TESTASSERT(buffer_a != NULL && buffer_b != NULL);
+
+  srsran_dft_plan_t in_place_a  = {};
+  srsran_dft_plan_t in_place_b  = {};
+  srsran_dft_plan_t out_place_c = {};
+  TESTASSERT(srsran_dft_plan_guru_c(
+                 &in_place_a, DFT_SIZE, SRSRAN_DFT_FORWARD, buffer_a, buffer_a, 1, 1, 2, DFT_SIZE, DFT_SIZE) == 0);
+  TESTASSERT(srsran_dft_plan_guru_c(
+                 &in_place_b, DFT_SIZE, SRSRAN_DFT_FORWARD, buffer_b, buffer_b, 1, 1, 2, DFT_SIZE, DFT_SIZE) == 0);
+  TESTASSERT(srsran_dft_plan_guru_c(
+                 &out_place_c, DFT_SIZE, SRSRAN_DFT_FORWARD, buffer_a, buffer_b, 1, 1, 2, DFT_SIZE, DFT_SIZE) == 0);
+  TESTASSERT(in_place_a.p == in_place_b.p);
+  TESTASSERT(in_place_a.p != out_place_c.p);
+
+  // Each plan transforms its own buffers
+  srsran_vec_cf_zero(buffer_a, 2 * DFT_SIZE);
+  srsran_vec_cf_zero(buffer_b, 2 * DFT_SIZE);
+  buffer_b[0]        = 1.0f;
+  buffer_b[DFT_SIZE] = 2.0f;
+  srsran_dft_run_guru_c(&in_place_b);
+  TESTASSERT(srsran_vec_avg_power_cf(buffer_a, 2 * DFT_SIZE) == 0.0f);
+  TESTASSERT(cabsf(buffer_b[DFT_SIZE - 1] - 1.0f) < 1e-4f);
+  TESTASSERT(cabsf(buffer_b[2 * DFT_SIZE - 1] - 2.0f) < 1e-4f);
+
+  srsran_dft_plan_free(&in_place_a);
+  srsran_dft_plan_free(&in_place_b);
+  srsran_dft_plan_free(&out_place_c);
+  free(buffer_a);
+  free(buffer_b);
+  return SRSRAN_SUCCESS;
+}
+
+// Stored wisdom is written atomically and can be loaded back
+static int test_wisdom_store_load()
+{
+  char filename[64];
+  snprintf(filename, sizeof(filename), "dft_plan_cache_test_%d.wisdom", getpid());
+
+  srsran_dft_plan_t plan = {};
+  TESTASSERT(srsran_dft_plan_c(&plan, 1200, SRSRAN_DFT_FORWARD) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_dft_store_wisdom(filename) == SRSRAN_SUCCESS);
+  TESTASSERT(access(filename, R_OK) == 0);
+  TESTASSERT(srsran_dft_load_wisdom(filename) == SRSRAN_SUCCESS);
+
+  srsran_dft_metrics_t metrics = {};
+  srsran_dft_get_metrics(&metrics);
+  TESTASSERT(metrics.wisdom_loaded);
+
+  srsran_dft_plan_free(&plan);
+  remove(filename);
+  char lock_filename[sizeof(filename) + 8];
+  snprintf(lock_filename, sizeof(lock_filename), "%s.lock", filename);
+  remove(lock_filename);
+  return SRSRAN_SUCCESS;
+}
+
+// Paths that do not fit, once the lock or temporary file suffixes are appended, are rejected instead of truncated
+static int test_wisdom_long_path()
+{
+  char filename[PATH_MAX];
+  memset(filename, 'a', sizeof(filename) - 2);
+  filename[sizeof(filename) - 2] = '\0';
+
+  TESTASSERT(srsran_dft_store_wisdom(filename) == SRSRAN_ERROR);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  TESTASSERT(test_plan_sharing() == SRSRAN_SUCCESS);
+  TESTASSERT(test_guru_sharing() == SRSRAN_SUCCESS);
+  TESTASSERT(test_wisdom_store_load() == SRSRAN_SUCCESS);
+  TESTASSERT(test_wisdom_long_path() == SRSRAN_SUCCESS);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,294 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file ldpc_cb_parallel_test.c
+ * \brief Benchmark of the NR shared channel LDPC code block decoding against the number of decoder threads.
+ *
+ * A transport block filling the carrier is randomly generated, encoded and sent over an AWGN channel. The received
+ * LLR are then decoded several times for each number of code block decoder threads, from 1 up to the given maximum.
+ * The test fails if any decoding does not match the transmitted data, or if the decoded data or the average number
+ * of iterations differ from the single thread decoding.
+ *
+ * Synopsis: **ldpc_cb_parallel_test [options]**
+ *
+ * Options:
+ *  - **-P \<number\>** Number of carrier PRB (Default 273).
+ *  - **-m \<number\>** MCS index (Default 27).
+ *  - **-s \<number\>** SNR in dB (Default 20 dB).
+ *  - **-R \<number\>** Number of decoded transport blocks for each number of threads (Default 10).
+ *  - **-T \<number\>** Maximum number of code block decoder threads (Default 4).
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/phch/ra_nr.h"
+#include "srsran/phy/phch/sch_nr.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+static srsran_carrier_nr_t carrier     = SRSRAN_DEFAULT_CARRIER_NR;
+static uint32_t            mcs         = 27;  /*!< \brief MCS index. */
+static float               snr         = 20;  /*!< \brief Signal-to-Noise Ratio [dB]. */
+static uint32_t            nof_reps    = 10;  /*!< \brief Number of decoded transport blocks per number of threads. */
+static uint32_t            max_threads = 4;   /*!< \brief Maximum number of code block decoder threads. */
+static srsran_sch_cfg_nr_t pdsch_cfg   = {};
+
+/*!
+ * \brief Prints test help when wrong parameter is passed as input.
+ */
+static void usage(char* prog)
+{
+  printf("Usage: %s [-PX] [-mX] [-sX] [-RX] [-TX]\n", prog);
+  printf("\t-P Number of carrier PRB [Default %d]\n", carrier.nof_prb);
+  printf("\t-m MCS index [Default %d]\n", mcs);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr);
+  printf("\t-R Number of decoded transport blocks for each number of threads [Default %d]\n", nof_reps);
+  printf("\t-T Maximum number of code block decoder threads [Default %d]\n", max_threads);
+}
+
+/*!
+ * \brief Parses the input line.
+ */
+static int parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "P:m:s:R:T:")) != -1) {
+    switch (opt) {
+      case 'P':
+        carrier.nof_prb = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'm':
+        mcs = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        snr = strtof(optarg, NULL);
+        break;
+      case 'R':
+        nof_reps = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'T':
+        max_threads = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                    ret           = SRSRAN_ERROR;
+  srsran_sch_nr_t        sch_nr_tx     = {};
+  srsran_sch_nr_t        sch_nr_rx     = {};
+  srsran_softbuffer_tx_t softbuffer_tx = {};
+  srsran_softbuffer_rx_t softbuffer_rx = {};
+  srsran_random_t        rand_gen      = srsran_random_init(1234);
+
+  uint8_t* data_tx  = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR / 8);
+  uint8_t* data_rx  = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR / 8);
+  uint8_t* data_ref = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR / 8);
+  uint8_t* encoded  = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
+  float*   symbols  = srsran_vec_f_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
+  int8_t*  llr      = srsran_vec_i8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
+
+  carrier.nof_prb             = 273;
+  pdsch_cfg.sch_cfg.mcs_table = srsran_mcs_table_64qam;
+
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  if (data_tx == NULL || data_rx == NULL || data_ref == NULL || encoded == NULL || symbols == NULL || llr == NULL) {
+    goto clean_exit;
+  }
+
+  srsran_sch_nr_args_t args   = {};
+  args.decoder_scaling_factor = 0.8;
+  args.max_nof_iter           = 10;
+  if (srsran_sch_nr_init_tx(&sch_nr_tx, &args) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating SCH NR for Tx");
+    goto clean_exit;
+  }
+
+  if (srsran_sch_nr_set_carrier(&sch_nr_tx, &carrier) < SRSRAN_SUCCESS) {
+    ERROR("Error setting SCH NR carrier");
+    goto clean_exit;
+  }
+
+  if (srsran_softbuffer_tx_init_guru(&softbuffer_tx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
+      SRSRAN_SUCCESS) {
+    ERROR("Error init soft-buffer");
+    goto clean_exit;
+  }
+
+  if (srsran_softbuffer_rx_init_guru(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
+      SRSRAN_SUCCESS) {
+    ERROR("Error init soft-buffer");
+    goto clean_exit;
+  }
+
+  // Allocate the whole carrier
+  pdsch_cfg.grant.S                                = 1;
+  pdsch_cfg.grant.L                                = 13;
+  pdsch_cfg.grant.nof_layers                       = carrier.max_mimo_layers;
+  pdsch_cfg.grant.dci_format                       = srsran_dci_format_nr_1_0;
+  pdsch_cfg.grant.nof_dmrs_cdm_groups_without_data = 1;
+  for (uint32_t n = 0; n < SRSRAN_MAX_PRB_NR; n++) {
+    pdsch_cfg.grant.prb_idx[n] = (n < carrier.nof_prb);
+  }
+
+  srsran_sch_tb_t tb = {};
+  if (srsran_ra_nr_fill_tb(&pdsch_cfg, &pdsch_cfg.grant, mcs, &tb) < SRSRAN_SUCCESS) {
+    ERROR("Error filing tb");
+    goto clean_exit;
+  }
+
+  srsran_sch_nr_tb_info_t cfg = {};
+  if (srsran_sch_nr_fill_tb_info(&carrier, &pdsch_cfg.sch_cfg, &tb, &cfg) < SRSRAN_SUCCESS) {
+    ERROR("Error filing tb info");
+    goto clean_exit;
+  }
+
+  for (uint32_t i = 0; i < tb.tbs / 8; i++) {
+    data_tx[i] = (uint8_t)srsran_random_uniform_int_dist(rand_gen, 0, UINT8_MAX);
+  }
+
+  tb.softbuffer.tx = &softbuffer_tx;
+  if (srsran_dlsch_nr_encode(&sch_nr_tx, &pdsch_cfg.sch_cfg, &tb, data_tx, encoded) < SRSRAN_SUCCESS) {
+    ERROR("Error encoding");
+    goto clean_exit;
+  }
+
+  // 2-PAM modulation over AWGN, LLR are scaled and saturated to 8 bit
+  for (uint32_t i = 0; i < tb.nof_bits; i++) {
+    symbols[i] = encoded[i] ? -1.0f : +1.0f;
+  }
+  srsran_ch_awgn_f(symbols, symbols, powf(10.0f, -snr / 10.0f), tb.nof_bits);
+  for (uint32_t i = 0; i < tb.nof_bits; i++) {
+    llr[i] = (int8_t)SRSRAN_MAX(SRSRAN_MIN(roundf(symbols[i] * 16.0f), 127.0f), -127.0f);
+  }
+
+  printf("Test LDPC code block parallel decoding:\n");
+  printf("  PRB=%d; MCS=%d; TBS=%d; BG=%d; Z=%d; C=%d; SNR=%.1f dB\n",
+         carrier.nof_prb,
+         mcs,
+         tb.tbs,
+         cfg.bg == BG1 ? 1 : 2,
+         cfg.Z,
+         cfg.C,
+         snr);
+
+  float avg_iter_ref = 0.0f;
+  for (uint32_t nof_threads = 1; nof_threads <= max_threads; nof_threads++) {
+    args.nof_cb_threads = nof_threads;
+    if (srsran_sch_nr_init_rx(&sch_nr_rx, &args) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating SCH NR for Rx");
+      goto clean_exit;
+    }
+
+    if (srsran_sch_nr_set_carrier(&sch_nr_rx, &carrier) < SRSRAN_SUCCESS) {
+      ERROR("Error setting SCH NR carrier");
+      goto clean_exit;
+    }
+
+    tb.softbuffer.rx           = &softbuffer_rx;
+    srsran_sch_tb_res_nr_t res = {};
+    res.payload                = data_rx;
+
+    double elapsed_time = 0.0;
+    for (uint32_t rep = 0; rep < nof_reps; rep++) {
+      struct timeval t[3];
+      srsran_softbuffer_rx_reset(&softbuffer_rx);
+
+      gettimeofday(&t[1], NULL);
+      if (srsran_dlsch_nr_decode(&sch_nr_rx, &pdsch_cfg.sch_cfg, &tb, llr, &res) < SRSRAN_SUCCESS) {
+        ERROR("Error decoding");
+        goto clean_exit;
+      }
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      elapsed_time += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+      if (!res.crc || memcmp(data_tx, data_rx, tb.tbs / 8) != 0) {
+        ERROR("Failed to decode transport block; threads=%d; rep=%d;", nof_threads, rep);
+        goto clean_exit;
+      }
+    }
+
+    // The first decoding is the reference for all the others
+    if (nof_threads == 1) {
+      srsran_vec_u8_copy(data_ref, data_rx, tb.tbs / 8);
+      avg_iter_ref = res.avg_iter;
+    } else if (memcmp(data_ref, data_rx, tb.tbs / 8) != 0 || res.avg_iter != avg_iter_ref) {
+      ERROR("Parallel decoding output differs from serial; threads=%d;", nof_threads);
+      goto clean_exit;
+    }
+
+    printf("  threads=%d; avg_iter=%.2f; %e CB/s; %e bit/s (information)\n",
+           nof_threads,
+           res.avg_iter,
+           nof_reps * cfg.C / elapsed_time,
+           nof_reps * tb.tbs / elapsed_time);
+
+    srsran_sch_nr_free(&sch_nr_rx);
+    SRSRAN_MEM_ZERO(&sch_nr_rx, srsran_sch_nr_t, 1);
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(rand_gen);
+  srsran_sch_nr_free(&sch_nr_tx);
+  srsran_sch_nr_free(&sch_nr_rx);
+  srsran_softbuffer_tx_free(&softbuffer_tx);
+  srsran_softbuffer_rx_free(&softbuffer_rx);
+  if (data_tx) {
+    free(data_tx);
+  }
+  if (data_rx) {
+    free(data_rx);
+  }
+  if (data_ref) {
+    free(data_ref);
+  }
+  if (encoded) {
+    free(encoded);
+  }
+  if (symbols) {
+    free(symbols);
+  }
+  if (llr) {
+    free(llr);
+  }
+
+  return ret;
+}
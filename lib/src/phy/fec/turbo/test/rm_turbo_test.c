@@ -33,6 +33,7 @@
 uint32_t nof_e_bits = 0;
 uint32_t rv_idx     = 0;
 uint32_t cb_idx     = 0;
+bool     test_decode = false;
 
 uint8_t systematic[6148], parity[2 * 6148];
 uint8_t systematic_bytes[6148 / 8 + 1], parity_bytes[2 * 6148 / 8 + 1];
@@ -45,15 +46,19 @@ float   buff_f[BUFFSZ];
 float   bits_f[3 * 6144 + 12];
 short   bits2_s[3 * 6144 + 12];
 
+// Sub-block decoder input, each of the three streams is padded to long_cb + 32
+#define DEC_BUFFSZ (3 * (6144 + 32) + 12)
+
 void usage(char* prog)
 {
-  printf("Usage: %s -c cb_idx -e nof_e_bits [-i rv_idx]\n", prog);
+  printf("Usage: %s -c cb_idx -e nof_e_bits [-i rv_idx] [-d]\n", prog);
+  printf("\t-d Rate match and decode every code block size with the turbo decoder\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "cei")) != -1) {
+  while ((opt = getopt(argc, argv, "ceid")) != -1) {
     switch (opt) {
       case 'c':
         cb_idx = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -64,17 +69,92 @@ void parse_args(int argc, char** argv)
       case 'i':
         rv_idx = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'd':
+        test_decode = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
     }
   }
-  if (nof_e_bits == 0) {
+  if (nof_e_bits == 0 && !test_decode) {
     usage(argv[0]);
     exit(-1);
   }
 }
 
+/* Decodes every code block size from noise-free rate matched LLRs, with both the 16-bit and the 8-bit decoders. The
+ * rate matching RX writes the decoder input with the sub-block deinterleaver the decoder selects for each size, which
+ * includes the 64 sub-block one of the AVX512 decoder */
+static int decode_all_cb_sizes()
+{
+  static uint8_t data_tx[SRSRAN_TCOD_MAX_LEN_CB], data_rx[SRSRAN_TCOD_MAX_LEN_CB];
+  static uint8_t data_rx_bytes[SRSRAN_TCOD_MAX_LEN_CB_BYTES + 1];
+  static uint8_t e_bits[3 * 6144 + 12];
+  static int16_t llr_s[3 * 6144 + 12], dec_s[DEC_BUFFSZ];
+  static int8_t  llr_c[3 * 6144 + 12], dec_c[DEC_BUFFSZ];
+  srsran_tcod_t  tcod;
+  srsran_tdec_t  tdec;
+  int            ret = SRSRAN_ERROR;
+
+  if (srsran_tcod_init(&tcod, SRSRAN_TCOD_MAX_LEN_CB)) {
+    ERROR("Error initiating turbo coder");
+    return SRSRAN_ERROR;
+  }
+  if (srsran_tdec_init(&tdec, SRSRAN_TCOD_MAX_LEN_CB)) {
+    ERROR("Error initiating turbo decoder");
+    srsran_tcod_free(&tcod);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t idx = 0; idx < SRSRAN_NOF_TC_CB_SIZES; idx++) {
+    uint32_t long_cb     = (uint32_t)srsran_cbsegm_cbsize(idx);
+    uint32_t long_cb_enc = 3 * long_cb + 12;
+
+    for (uint32_t i = 0; i < long_cb; i++) {
+      data_tx[i] = rand() % 2;
+    }
+    srsran_tcod_encode(&tcod, data_tx, bits, long_cb);
+    bzero(buff_b, BUFFSZ * sizeof(uint8_t));
+    srsran_rm_turbo_tx(buff_b, BUFFSZ, bits, long_cb_enc, e_bits, long_cb_enc, 0);
+    for (uint32_t i = 0; i < long_cb_enc; i++) {
+      llr_s[i] = e_bits[i] ? 100 : -100;
+      llr_c[i] = e_bits[i] ? 20 : -20;
+    }
+
+    for (uint32_t is_8bit = 0; is_8bit < 2; is_8bit++) {
+      if (is_8bit) {
+        srsran_vec_i8_zero(dec_c, DEC_BUFFSZ);
+        srsran_rm_turbo_rx_lut_8bit(llr_c, dec_c, long_cb_enc, idx, 0);
+      } else {
+        srsran_vec_i16_zero(dec_s, DEC_BUFFSZ);
+        srsran_rm_turbo_rx_lut(llr_s, dec_s, long_cb_enc, idx, 0);
+      }
+      srsran_tdec_new_cb(&tdec, long_cb);
+      for (uint32_t iter = 0; iter < 4; iter++) {
+        if (is_8bit) {
+          srsran_tdec_iteration_8bit(&tdec, dec_c, data_rx_bytes);
+        } else {
+          srsran_tdec_iteration(&tdec, dec_s, data_rx_bytes);
+        }
+      }
+      srsran_bit_unpack_vector(data_rx_bytes, data_rx, long_cb);
+      uint32_t errors = srsran_bit_diff(data_tx, data_rx, long_cb);
+      if (errors != 0) {
+        printf("Error decoding cb_idx=%3d (long_cb=%d, %d-bit): %d errors\n", idx, long_cb, is_8bit ? 8 : 16, errors);
+        goto clean_exit;
+      }
+    }
+  }
+  printf("OK decoding %d code block sizes\n", SRSRAN_NOF_TC_CB_SIZES);
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_tdec_free(&tdec);
+  srsran_tcod_free(&tcod);
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   int      i;
@@ -86,6 +166,12 @@ int main(int argc, char** argv)
 
   srsran_rm_turbo_gentables();
 
+  if (test_decode) {
+    int ret = decode_all_cb_sizes();
+    srsran_rm_turbo_free_tables();
+    return ret;
+  }
+
   rm_bits_s = srsran_vec_i16_malloc(nof_e_bits);
   if (!rm_bits_s) {
     perror("malloc");
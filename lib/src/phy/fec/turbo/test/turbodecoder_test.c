@@ -45,6 +45,7 @@ int nof_iterations  = MAX_ITERATIONS;
 int test_known_data = 0;
 int test_errors     = 0;
 int nof_repetitions = 1;
+int benchmark       = 0;
 
 srsran_tdec_impl_type_t tdec_type;
 
@@ -54,7 +55,7 @@ srsran_tdec_impl_type_t tdec_type;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [kcinNledts]\n", prog);
+  printf("Usage: %s [kcinNledtsb]\n", prog);
   printf("\t-k Test with known data (ignores frame_length) [Default disabled]\n");
   printf("\t-c nof_cb in parallel [Default %d]\n", nof_cb);
   printf("\t-i nof_iterations [Default %d]\n", nof_iterations);
@@ -65,12 +66,13 @@ void usage(char* prog)
   printf("\t-d Decoder implementation type: 0: Generic, 1: SSE, 2: SSE-window\n");
   printf("\t-t test: check errors on exit [Default disabled]\n");
   printf("\t-s seed [Default 0=time]\n");
+  printf("\t-b benchmark: compare all the available implementations with early stop [Default disabled]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "kcinNledts")) != -1) {
+  while ((opt = getopt(argc, argv, "kcinNledtsb")) != -1) {
     switch (opt) {
       case 'c':
         nof_cb = (int)strtol(argv[optind], NULL, 10);
@@ -105,6 +107,9 @@ void parse_args(int argc, char** argv)
       case 'v':
         increase_srsran_verbose_level();
         break;
+      case 'b':
+        benchmark = 1;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -112,6 +117,107 @@ void parse_args(int argc, char** argv)
   }
 }
 
+static const char* tdec_impl_names[SRSRAN_TDEC_NOF_IMP] =
+    {"auto", "generic", "sse", "sse-window", "neon-window", "avx-window", "sse8-window", "avx8-window", "avx512-8-window"};
+
+/* Runs every implementation over the same frames, stopping each frame as soon as it decodes correctly, as done by the
+ * CRC check in the PHY. Reports the throughput, the average number of iterations and the BER side by side. */
+static int run_benchmark(srsran_random_t random_gen)
+{
+  uint32_t       coded_length = 3 * frame_length + SRSRAN_TCOD_TOTALTAIL;
+  uint32_t       llr_stride   = SRSRAN_CEIL(coded_length, 64) * 64; // keeps every frame aligned for the SIMD loads
+  uint32_t       max_iter     = nof_iterations > 0 ? nof_iterations : MAX_ITERATIONS;
+  float          esno_db      = (ebno_db < 100.0 ? ebno_db : 5.0f) + srsran_convert_power_to_dB(1.0f / 3.0f);
+  float          var          = srsran_convert_dB_to_power(-esno_db);
+  srsran_tcod_t  tcod;
+  struct timeval tdata[3];
+
+  uint8_t* data_tx = srsran_vec_u8_malloc(frame_length * nof_frames);
+  uint8_t* data_rx = srsran_vec_u8_malloc(frame_length);
+  uint8_t* bytes   = srsran_vec_u8_malloc(frame_length / 8 + 1);
+  uint8_t* symbols = srsran_vec_u8_malloc(coded_length);
+  float*   llr     = srsran_vec_f_malloc(coded_length);
+  int16_t* llr_s   = srsran_vec_i16_malloc(llr_stride * nof_frames);
+  int8_t*  llr_c   = srsran_vec_i8_malloc(llr_stride * nof_frames);
+  if (!data_tx || !data_rx || !bytes || !symbols || !llr || !llr_s || !llr_c || srsran_tcod_init(&tcod, frame_length)) {
+    ERROR("Error allocating benchmark buffers");
+    return SRSRAN_ERROR;
+  }
+
+  // Same noisy frames for all the implementations. 8-bit decoders take LLRs with a smaller scale
+  for (uint32_t f = 0; f < nof_frames; f++) {
+    for (uint32_t j = 0; j < frame_length; j++) {
+      data_tx[f * frame_length + j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    srsran_tcod_encode(&tcod, &data_tx[f * frame_length], symbols, frame_length);
+    for (uint32_t j = 0; j < coded_length; j++) {
+      llr[j] = symbols[j] ? 1 : -1;
+    }
+    srsran_ch_awgn_f(llr, llr, var, coded_length);
+    for (uint32_t j = 0; j < coded_length; j++) {
+      llr_s[f * llr_stride + j] = (int16_t)(100 * llr[j]);
+      llr_c[f * llr_stride + j] = (int8_t)SRSRAN_MAX(-127.0f, SRSRAN_MIN(127.0f, 8 * llr[j]));
+    }
+  }
+
+  printf("%-16s %6s %10s %10s %10s\n", "Implementation", "LLR", "Mbps", "Avg iter", "BER");
+  for (int type = SRSRAN_TDEC_GENERIC; type < SRSRAN_TDEC_NOF_IMP; type++) {
+    srsran_tdec_t tdec;
+    if (srsran_tdec_init_manual(&tdec, frame_length, (srsran_tdec_impl_type_t)type)) {
+      continue;
+    }
+    srsran_tdec_force_not_sb(&tdec);
+    bool     is_8bit    = type >= SRSRAN_TDEC_SSE8_WINDOW;
+    uint32_t nof_blocks = is_8bit ? tdec.nof_blocks8[0] : tdec.nof_blocks16[0];
+
+    // Windowed decoders split the CB in sub-blocks, which must be long enough to fit the window overlap
+    if (nof_blocks > 1 && (frame_length % nof_blocks || frame_length / nof_blocks < 40)) {
+      printf("%-16s %4d-bit   not supported for this frame length\n", tdec_impl_names[type], is_8bit ? 8 : 16);
+      srsran_tdec_free(&tdec);
+      continue;
+    }
+
+    uint64_t total_usec = 0, total_iter = 0, errors = 0;
+    for (uint32_t f = 0; f < nof_frames; f++) {
+      uint8_t* tx   = &data_tx[f * frame_length];
+      uint32_t iter = 0;
+      srsran_tdec_new_cb(&tdec, frame_length);
+      gettimeofday(&tdata[1], NULL);
+      do {
+        if (is_8bit) {
+          srsran_tdec_iteration_8bit(&tdec, &llr_c[f * llr_stride], bytes);
+        } else {
+          srsran_tdec_iteration(&tdec, &llr_s[f * llr_stride], bytes);
+        }
+        srsran_bit_unpack_vector(bytes, data_rx, frame_length);
+        iter++;
+      } while (iter < max_iter && srsran_bit_diff(tx, data_rx, frame_length) != 0);
+      gettimeofday(&tdata[2], NULL);
+      get_time_interval(tdata);
+      total_usec += tdata[0].tv_sec * 1000000 + tdata[0].tv_usec;
+      total_iter += iter;
+      errors += srsran_bit_diff(tx, data_rx, frame_length);
+    }
+    printf("%-16s %4d-bit %10.1f %10.2f %10.2e\n",
+           tdec_impl_names[type],
+           is_8bit ? 8 : 16,
+           (float)frame_length * nof_frames / SRSRAN_MAX(total_usec, 1),
+           (float)total_iter / nof_frames,
+           (float)errors / (frame_length * nof_frames));
+    srsran_tdec_free(&tdec);
+  }
+
+  free(data_tx);
+  free(data_rx);
+  free(bytes);
+  free(symbols);
+  free(llr);
+  free(llr_s);
+  free(llr_c);
+  srsran_tcod_free(&tcod);
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srsran_random_t random_gen = srsran_random_init(0);
@@ -153,6 +259,12 @@ int main(int argc, char** argv)
     printf("  EbNo: %.2f\n", ebno_db);
   }
 
+  if (benchmark) {
+    int ret = run_benchmark(random_gen);
+    srsran_random_free(random_gen);
+    exit(ret);
+  }
+
   data_tx = srsran_vec_u8_malloc(frame_length);
   if (!data_tx) {
     perror("malloc");
@@ -97,6 +97,18 @@ srsran_tdec_8bit_impl_t avx8_win_impl = {tdec_winavx8_init,
                                          tdec_winavx8_decision_byte};
 #endif
 
+/* AVX512 window implementation */
+#ifdef LV_HAVE_AVX512
+#define WINIMP_IS_AVX512_8
+#include "srsran/phy/fec/turbo/turbodecoder_win.h"
+#undef WINIMP_IS_AVX512_8
+srsran_tdec_8bit_impl_t avx512_8_win_impl = {tdec_winavx512_8_init,
+                                             tdec_winavx512_8_free,
+                                             tdec_winavx512_8_dec,
+                                             tdec_winavx512_8_extract_input,
+                                             tdec_winavx512_8_decision_byte};
+#endif
+
 #ifdef HAVE_NEON
 #define WINIMP_IS_NEON16
 #include "srsran/phy/fec/turbo/turbodecoder_win.h"
@@ -114,6 +126,7 @@ srsran_tdec_16bit_impl_t arm16_win_impl = {tdec_winarm16_init,
 #define AUTO_16_AVXWIN 2
 #define AUTO_8_SSEWIN 0
 #define AUTO_8_AVXWIN 1
+#define AUTO_8_AVX512WIN 2
 #define AUTO_16_GEN 0
 #define AUTO_16_NEONWIN 1
 
@@ -134,6 +147,8 @@ int srsran_tdec_init(srsran_tdec_t* h, uint32_t max_long_cb)
 uint32_t interleaver_idx(uint32_t nof_subblocks)
 {
   switch (nof_subblocks) {
+    case 64:
+      return 4;
     case 32:
       return 3;
     case 16:
@@ -147,6 +162,13 @@ uint32_t interleaver_idx(uint32_t nof_subblocks)
   }
 }
 
+/* Sub-block interleavers are only used for the CB lengths that are a multiple of the number of sub-blocks. The others
+ * get the plain interleaver, which also avoids dividing by zero when the CB is shorter than the number of sub-blocks */
+static void tdec_gen_interl(srsran_tc_interl_t* interl, uint32_t long_cb, uint32_t nof_subblocks)
+{
+  srsran_tc_interl_LTE_gen_interl(interl, long_cb, (long_cb % nof_subblocks) ? 1 : nof_subblocks);
+}
+
 /* Initializes the turbo decoder object */
 int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_impl_type_t dec_type)
 {
@@ -195,6 +217,12 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
       h->current_llr_type = SRSRAN_TDEC_8;
       break;
 #endif /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_AVX512
+    case SRSRAN_TDEC_AVX512_8_WINDOW:
+      h->dec8[0]          = &avx512_8_win_impl;
+      h->current_llr_type = SRSRAN_TDEC_8;
+      break;
+#endif /* LV_HAVE_AVX512 */
     default:
       ERROR("Error decoder %d not supported", dec_type);
       goto clean_and_exit;
@@ -255,6 +283,9 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
     h->dec16[AUTO_16_AVXWIN] = &avx16_win_impl;
     h->dec8[AUTO_8_AVXWIN]   = &avx8_win_impl;
 #endif /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_AVX512
+    h->dec8[AUTO_8_AVX512WIN] = &avx512_8_win_impl;
+#endif /* LV_HAVE_AVX512 */
 #else  /* HAVE_NEON | LV_HAVE_SSE */
     h->dec16[AUTO_16_SSE]    = &gen_impl;
     h->dec16[AUTO_16_SSEWIN] = &gen_impl;
@@ -275,13 +306,13 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
       }
     }
 
-    // Compute 1 interleaver for each possible nof_subblocks (1, 8, 16 or 32)
-    for (int s = 0; s < 4; s++) {
+    // Compute 1 interleaver for each possible nof_subblocks (1, 8, 16, 32 or 64)
+    for (int s = 0; s < SRSRAN_TDEC_NOF_INTERLEAVERS; s++) {
       for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
         if (srsran_tc_interl_init(&h->interleaver[s][i], srsran_cbsegm_cbsize(i)) < 0) {
           goto clean_and_exit;
         }
-        srsran_tc_interl_LTE_gen_interl(&h->interleaver[s][i], srsran_cbsegm_cbsize(i), s ? (8 << (s - 1)) : 1);
+        tdec_gen_interl(&h->interleaver[s][i], srsran_cbsegm_cbsize(i), s ? (8 << (s - 1)) : 1);
       }
     }
   } else {
@@ -301,8 +332,7 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
       if (srsran_tc_interl_init(&h->interleaver[interleaver_idx(nof_subblocks)][i], srsran_cbsegm_cbsize(i)) < 0) {
         goto clean_and_exit;
       }
-      srsran_tc_interl_LTE_gen_interl(
-          &h->interleaver[interleaver_idx(nof_subblocks)][i], srsran_cbsegm_cbsize(i), nof_subblocks);
+      tdec_gen_interl(&h->interleaver[interleaver_idx(nof_subblocks)][i], srsran_cbsegm_cbsize(i), nof_subblocks);
     }
   }
 
@@ -353,7 +383,7 @@ void srsran_tdec_free(srsran_tdec_t* h)
       h->dec16[td]->tdec_free(h->dec16_hdlr[td]);
     }
   }
-  for (int s = 0; s < 4; s++) {
+  for (int s = 0; s < SRSRAN_TDEC_NOF_INTERLEAVERS; s++) {
     for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
       srsran_tc_interl_free(&h->interleaver[s][i]);
     }
@@ -409,8 +439,13 @@ static int tdec_sb_idx(uint32_t long_cb)
 
 uint32_t srsran_tdec_autoimp_get_subblocks_8bit(uint32_t long_cb)
 {
+#ifdef LV_HAVE_AVX512
+  if (!(long_cb % 64) && long_cb > 4096) {
+    return 64;
+  } else
+#endif
 #ifdef LV_HAVE_AVX2
-  if (!(long_cb % 32) && long_cb > 2048) {
+      if (!(long_cb % 32) && long_cb > 2048) {
     return 32;
   } else
 #endif
@@ -427,6 +462,8 @@ static int tdec_sb_idx_8(uint32_t long_cb)
 {
   uint32_t nof_sb = srsran_tdec_autoimp_get_subblocks_8bit(long_cb);
   switch (nof_sb) {
+    case 64:
+      return AUTO_8_AVX512WIN;
     case 32:
       return AUTO_8_AVXWIN;
     case 16:
@@ -470,7 +507,8 @@ static void tdec_iteration_8(srsran_tdec_t* h, int8_t* input)
       h->current_inter_idx = interleaver_idx(h->nof_blocks16[h->current_dec]);
     }
   } else {
-    h->current_dec = 0;
+    h->current_dec       = 0;
+    h->current_inter_idx = interleaver_idx(h->current_llr_type == SRSRAN_TDEC_8 ? h->nof_blocks8[0] : h->nof_blocks16[0]);
   }
 
   if (h->current_llr_type == SRSRAN_TDEC_16) {
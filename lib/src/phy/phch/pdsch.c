@@ -389,6 +389,9 @@ int srsran_pdsch_enable_coworker(srsran_pdsch_t* q)
       goto clean;
     }
 
+    // Both codewords decode their code blocks through the same pool
+    srsran_sch_share_cb_threads(&h->dl_sch, &q->dl_sch);
+
     if (sem_init(&h->start, 0, 0)) {
       ERROR("Creating semaphore");
       ret = SRSRAN_ERROR;
@@ -409,6 +412,24 @@ clean:
   return ret;
 }
 
+int srsran_pdsch_set_cb_threads(srsran_pdsch_t* q, uint32_t nof_threads)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (srsran_sch_set_cb_threads(&q->dl_sch, nof_threads)) {
+    return SRSRAN_ERROR;
+  }
+
+  srsran_pdsch_coworker_t* h = (srsran_pdsch_coworker_t*)q->coworker_ptr;
+  if (h) {
+    srsran_sch_share_cb_threads(&h->dl_sch, &q->dl_sch);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_pdsch_free(srsran_pdsch_t* q)
 {
   srsran_pdsch_disable_coworker(q);
@@ -902,6 +923,7 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
             h->tb_idx                = tb_idx;
             h->ack                   = &data[tb_idx].crc;
             h->dl_sch.max_iterations = q->dl_sch.max_iterations;
+            h->dl_sch.llr_is_8bit    = q->dl_sch.llr_is_8bit;
             h->started               = true;
             sem_post(&h->start);
 
@@ -583,6 +583,26 @@ int srsran_prach_init(srsran_prach_t* p, uint32_t max_N_ifft_ul)
     srsran_dft_plan_set_mirror(&p->zc_ifft, false);
     srsran_dft_plan_set_norm(&p->zc_ifft, false);
 
+    p->batch_spec = srsran_vec_cf_malloc(SRSRAN_PRACH_DETECT_BATCH * SRSRAN_PRACH_N_ZC_LONG);
+    p->batch_corr = srsran_vec_cf_malloc(SRSRAN_PRACH_DETECT_BATCH * SRSRAN_PRACH_N_ZC_LONG);
+    if (!p->batch_spec || !p->batch_corr) {
+      ERROR("Error allocating memory");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_dft_plan_guru_c(&p->zc_ifft_batch,
+                               SRSRAN_PRACH_N_ZC_LONG,
+                               SRSRAN_DFT_BACKWARD,
+                               p->batch_spec,
+                               p->batch_corr,
+                               1,
+                               1,
+                               SRSRAN_PRACH_DETECT_BATCH,
+                               SRSRAN_PRACH_N_ZC_LONG,
+                               SRSRAN_PRACH_N_ZC_LONG)) {
+      ERROR("Error creating DFT plan");
+      return SRSRAN_ERROR;
+    }
+
     uint32_t fft_size_alloc = max_N_ifft_ul * DELTA_F / DELTA_F_RA;
 
     p->ifft_in  = srsran_vec_cf_malloc(fft_size_alloc);
@@ -687,6 +707,19 @@ int srsran_prach_set_cell_(srsran_prach_t*      p,
         return SRSRAN_ERROR;
       }
     }
+    if (p->zc_ifft_batch.size != p->N_zc) {
+      if (srsran_dft_replan_guru_c(&p->zc_ifft_batch,
+                                   p->N_zc,
+                                   p->batch_spec,
+                                   p->batch_corr,
+                                   1,
+                                   1,
+                                   SRSRAN_PRACH_DETECT_BATCH,
+                                   p->N_zc,
+                                   p->N_zc)) {
+        return SRSRAN_ERROR;
+      }
+    }
 
     // Generate our 64 sequences
     p->N_roots = 0;
@@ -866,97 +899,149 @@ void srsran_prach_calculate_correction_array(srsran_prach_t* p, cf_t* corr_freq)
   }
 }
 
-// This function carries out the main processing on the incomming PRACH signal
-int srsran_prach_process(srsran_prach_t* p,
-                         cf_t*           signal,
-                         uint32_t*       indices,
-                         float*          t_offsets,
-                         float*          peak_to_avg,
-                         uint32_t*       n_indices,
-                         int             cancellation_idx,
-                         uint32_t        begin,
-                         uint32_t        sig_len)
+// Correlates the preamble bins with nof_roots consecutive roots, transforming all the correlations with a single IFFT
+static void prach_correlate_roots(srsran_prach_t* p, uint32_t root_begin, uint32_t nof_roots)
 {
-  float max_to_cancel = 0;
-  cancellation_idx    = -1;
-  int max_idx         = 0;
-  srsran_vec_cf_zero(p->cross, p->N_zc);
-  srsran_vec_cf_zero(p->corr_freq, p->N_zc);
-  for (int i = 0; i < p->num_ra_preambles; i++) {
-    cf_t* root_spec = get_precoded_dft(p, p->root_seqs_idx[i]);
-
-    srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, p->corr_spec, p->N_zc);
-
-    srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
-    if (p->successive_cancellation) {
-      srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
+  for (uint32_t r = 0; r < nof_roots; r++) {
+    cf_t* root_spec = get_precoded_dft(p, p->root_seqs_idx[root_begin + r]);
+    srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, &p->batch_spec[r * p->N_zc], p->N_zc);
+  }
+  if (nof_roots == SRSRAN_PRACH_DETECT_BATCH) {
+    srsran_dft_run_guru_c(&p->zc_ifft_batch);
+  } else {
+    for (uint32_t r = 0; r < nof_roots; r++) {
+      srsran_dft_run(&p->zc_ifft, &p->batch_spec[r * p->N_zc], &p->batch_corr[r * p->N_zc]);
     }
-    srsran_dft_run(&p->zc_ifft, p->corr_spec, p->corr_spec);
+  }
+}
 
-    srsran_vec_abs_square_cf(p->corr_spec, p->corr, p->N_zc);
+// Searches the correlation of root i for preambles
+static void prach_search_root(srsran_prach_t* p,
+                              uint32_t        i,
+                              const cf_t*     corr_spec,
+                              const cf_t*     corr_td,
+                              uint32_t*       indices,
+                              float*          t_offsets,
+                              float*          peak_to_avg,
+                              uint32_t*       n_indices,
+                              int*            cancellation_idx,
+                              float*          max_to_cancel)
+{
+  srsran_vec_prod_conj_ccc(corr_spec, &corr_spec[1], p->cross, p->N_zc - 1);
+  if (p->successive_cancellation) {
+    srsran_vec_cf_copy(p->corr_freq, corr_spec, p->N_zc);
+  }
 
-    float corr_ave = srsran_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
+  srsran_vec_abs_square_cf(corr_td, p->corr, p->N_zc);
 
-    uint32_t winsize = 0;
-    if (p->N_cs != 0) {
-      winsize = p->N_cs;
-    } else {
-      winsize = p->N_zc;
-    }
-    uint32_t n_wins = p->N_zc / winsize;
+  float corr_ave = srsran_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
 
-    float max_peak = 0;
-    for (int j = 0; j < n_wins; j++) {
-      uint32_t start = (p->N_zc - (j * p->N_cs)) % p->N_zc;
-      uint32_t end   = start + winsize;
-      if (end > p->deadzone) {
-        end -= p->deadzone;
-      }
-      start += p->deadzone;
-      p->peak_values[j] = 0;
-      for (int k = start; k < end; k++) {
-        if (p->corr[k] > p->peak_values[j]) {
-          p->peak_values[j]  = p->corr[k];
-          p->peak_offsets[j] = k - start;
-          if (p->peak_values[j] > max_peak) {
-            max_peak = p->peak_values[j];
-            max_idx  = k;
-          }
+  uint32_t winsize = 0;
+  if (p->N_cs != 0) {
+    winsize = p->N_cs;
+  } else {
+    winsize = p->N_zc;
+  }
+  uint32_t n_wins = p->N_zc / winsize;
+
+  float max_peak = 0;
+  for (int j = 0; j < n_wins; j++) {
+    uint32_t start = (p->N_zc - (j * p->N_cs)) % p->N_zc;
+    uint32_t end   = start + winsize;
+    if (end > p->deadzone) {
+      end -= p->deadzone;
+    }
+    start += p->deadzone;
+    p->peak_values[j] = 0;
+    for (int k = start; k < end; k++) {
+      if (p->corr[k] > p->peak_values[j]) {
+        p->peak_values[j]  = p->corr[k];
+        p->peak_offsets[j] = k - start;
+        if (p->peak_values[j] > max_peak) {
+          max_peak = p->peak_values[j];
         }
       }
     }
-    if (max_peak > (p->detect_factor * corr_ave)) {
-      for (int j = 0; j < n_wins; j++) {
-        if (p->peak_values[j] > p->detect_factor * corr_ave) {
-          if (indices) {
-            if (p->successive_cancellation) {
-              if (max_peak > max_to_cancel) {
-                cancellation_idx       = (i * n_wins) + j;
-                max_to_cancel          = max_peak;
-                p->prach_cancel.idx    = cancellation_idx;
-                p->prach_cancel.factor = (sqrt(max_peak / (p->N_zc * p->N_zc)));
-                srsran_prach_calculate_correction_array(p, p->corr_freq);
-              }
-              if (srsran_prach_have_stored(((i * n_wins) + j), indices, *n_indices)) {
-                break;
-              }
+  }
+  if (max_peak > (p->detect_factor * corr_ave)) {
+    for (int j = 0; j < n_wins; j++) {
+      if (p->peak_values[j] > p->detect_factor * corr_ave) {
+        if (indices) {
+          if (p->successive_cancellation) {
+            if (max_peak > *max_to_cancel) {
+              *cancellation_idx      = (i * n_wins) + j;
+              *max_to_cancel         = max_peak;
+              p->prach_cancel.idx    = *cancellation_idx;
+              p->prach_cancel.factor = (sqrt(max_peak / (p->N_zc * p->N_zc)));
+              srsran_prach_calculate_correction_array(p, p->corr_freq);
+            }
+            if (srsran_prach_have_stored(((i * n_wins) + j), indices, *n_indices)) {
+              break;
             }
-            indices[*n_indices] = (i * n_wins) + j;
-          }
-          if (peak_to_avg) {
-            peak_to_avg[*n_indices] = p->peak_values[j] / corr_ave;
-          }
-          if (t_offsets) {
-            // saves the PRACH offset in seconds to t_offsets, time domain or freq domain base calc
-            t_offsets[*n_indices] = (p->freq_domain_offset_calc)
-                                        ? (srsran_prach_calculate_time_offset_secs(p, p->cross))
-                                        : (srsran_prach_get_offset_secs(p, j));
           }
-          (*n_indices)++;
+          indices[*n_indices] = (i * n_wins) + j;
         }
+        if (peak_to_avg) {
+          peak_to_avg[*n_indices] = p->peak_values[j] / corr_ave;
+        }
+        if (t_offsets) {
+          // saves the PRACH offset in seconds to t_offsets, time domain or freq domain base calc
+          t_offsets[*n_indices] = (p->freq_domain_offset_calc)
+                                      ? (srsran_prach_calculate_time_offset_secs(p, p->cross))
+                                      : (srsran_prach_get_offset_secs(p, j));
+        }
+        (*n_indices)++;
       }
     }
   }
+}
+
+// Searches the roots in [root_begin, root_end) for preambles, in batches of SRSRAN_PRACH_DETECT_BATCH roots
+static void prach_search_roots(srsran_prach_t* p,
+                               uint32_t        root_begin,
+                               uint32_t        root_end,
+                               uint32_t*       indices,
+                               float*          t_offsets,
+                               float*          peak_to_avg,
+                               uint32_t*       n_indices,
+                               int*            cancellation_idx,
+                               float*          max_to_cancel)
+{
+  srsran_vec_cf_zero(p->cross, p->N_zc);
+  srsran_vec_cf_zero(p->corr_freq, p->N_zc);
+  for (uint32_t i = root_begin; i < root_end; i += SRSRAN_PRACH_DETECT_BATCH) {
+    uint32_t nof_roots = SRSRAN_MIN(SRSRAN_PRACH_DETECT_BATCH, root_end - i);
+    prach_correlate_roots(p, i, nof_roots);
+    for (uint32_t r = 0; r < nof_roots; r++) {
+      prach_search_root(p,
+                        i + r,
+                        &p->batch_spec[r * p->N_zc],
+                        &p->batch_corr[r * p->N_zc],
+                        indices,
+                        t_offsets,
+                        peak_to_avg,
+                        n_indices,
+                        cancellation_idx,
+                        max_to_cancel);
+    }
+  }
+}
+
+// This function carries out the main processing on the incomming PRACH signal
+int srsran_prach_process(srsran_prach_t* p,
+                         cf_t*           signal,
+                         uint32_t*       indices,
+                         float*          t_offsets,
+                         float*          peak_to_avg,
+                         uint32_t*       n_indices,
+                         int             cancellation_idx,
+                         uint32_t        begin,
+                         uint32_t        sig_len)
+{
+  float max_to_cancel = 0;
+  cancellation_idx    = -1;
+  prach_search_roots(
+      p, 0, p->num_ra_preambles, indices, t_offsets, peak_to_avg, n_indices, &cancellation_idx, &max_to_cancel);
   if (cancellation_idx != -1) {
     // if a peak has been found, this applies cancellation, if many found, subtracts strongest
     srsran_prach_cancellation(p);
@@ -966,6 +1051,61 @@ int srsran_prach_process(srsran_prach_t* p,
   return 0;
 }
 
+// Index of the first bin of the preamble in the transformed PRACH signal
+static uint32_t prach_bins_begin(srsran_prach_t* p, uint32_t freq_offset)
+{
+  uint32_t N_rb_ul = srsran_nof_prb(p->N_ifft_ul);
+  uint32_t k_0     = freq_offset * N_RB_SC - N_rb_ul * N_RB_SC / 2 + p->N_ifft_ul / 2;
+  uint32_t K       = DELTA_F / DELTA_F_RA;
+  return PHI + (K * k_0) + (p->is_nr ? 0 : (K / 2));
+}
+
+int srsran_prach_extract_bins(srsran_prach_t* p, uint32_t freq_offset, cf_t* signal, uint32_t sig_len)
+{
+  if (p == NULL || signal == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (sig_len < p->N_ifft_prach) {
+    ERROR("srsran_prach_extract_bins: Signal length is %d and should be %d", sig_len, p->N_ifft_prach);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // FFT incoming signal
+  srsran_dft_run(&p->fft, signal, p->signal_fft);
+
+  // Extract bins of interest
+  memcpy(p->prach_bins, &p->signal_fft[prach_bins_begin(p, freq_offset)], p->N_zc * sizeof(cf_t));
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_prach_detect_roots(srsran_prach_t* p,
+                              const cf_t*     bins,
+                              uint32_t        root_begin,
+                              uint32_t        root_end,
+                              uint32_t*       indices,
+                              float*          t_offsets,
+                              float*          peak_to_avg,
+                              uint32_t*       n_indices)
+{
+  if (p == NULL || bins == NULL || indices == NULL || n_indices == NULL || root_begin > root_end ||
+      root_end > p->num_ra_preambles) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (bins != p->prach_bins) {
+    srsran_vec_cf_copy(p->prach_bins, bins, p->N_zc);
+  }
+
+  int   cancellation_idx = -1;
+  float max_to_cancel    = 0;
+  *n_indices             = 0;
+  prach_search_roots(
+      p, root_begin, root_end, indices, t_offsets, peak_to_avg, n_indices, &cancellation_idx, &max_to_cancel);
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_prach_detect_offset(srsran_prach_t* p,
                                uint32_t        freq_offset,
                                cf_t*           signal,
@@ -984,19 +1124,13 @@ int srsran_prach_detect_offset(srsran_prach_t* p,
     int cancellation_idx = -2;
     bzero(&p->prach_cancel, sizeof(srsran_prach_cancellation_t));
 
-    // FFT incoming signal
-    srsran_dft_run(&p->fft, signal, p->signal_fft);
+    // FFT incoming signal and extract bins of interest
+    srsran_prach_extract_bins(p, freq_offset, signal, sig_len);
 
     *n_indices = 0;
 
-    // Extract bins of interest
-    uint32_t N_rb_ul = srsran_nof_prb(p->N_ifft_ul);
-    uint32_t k_0     = freq_offset * N_RB_SC - N_rb_ul * N_RB_SC / 2 + p->N_ifft_ul / 2;
-    uint32_t K       = DELTA_F / DELTA_F_RA;
-    uint32_t begin   = PHI + (K * k_0) + (p->is_nr ? 0 : (K / 2));
-
-    memcpy(p->prach_bins, &p->signal_fft[begin], p->N_zc * sizeof(cf_t));
-    int loops = (p->successive_cancellation) ? SUCCESSIVE_CANCELLATION_ITS : 1;
+    uint32_t begin = prach_bins_begin(p, freq_offset);
+    int      loops = (p->successive_cancellation) ? SUCCESSIVE_CANCELLATION_ITS : 1;
     // if successive cancellation is enabled, we perform the entire search process p->num_ra_preambles times, removing
     // the highest power PRACH preamble each time.
     for (int l = 0; l < loops; l++) {
@@ -1024,6 +1158,9 @@ int srsran_prach_free(srsran_prach_t* p)
   srsran_dft_plan_free(&p->fft);
   srsran_dft_plan_free(&p->zc_fft);
   srsran_dft_plan_free(&p->zc_ifft);
+  srsran_dft_plan_free(&p->zc_ifft_batch);
+  free(p->batch_spec);
+  free(p->batch_corr);
 
   if (p->signal_fft) {
     free(p->signal_fft);
@@ -21,6 +21,7 @@
 
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/parallel.h"
 #include "srsran/phy/utils/vector.h"
 #include "srsran/srsran.h"
 #include <assert.h>
@@ -137,6 +138,8 @@ uint32_t srsran_sch_find_Ioffset_cqi(float beta)
 
 #define SCH_MAX_G_BITS (SRSRAN_MAX_PRB * 12 * 12 * 12)
 
+static void sch_cb_pool_free(srsran_sch_t* q);
+
 int srsran_sch_init(srsran_sch_t* q)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -200,6 +203,7 @@ clean:
 
 void srsran_sch_free(srsran_sch_t* q)
 {
+  sch_cb_pool_free(q);
   srsran_rm_turbo_free_tables();
 
   if (q->cb_in) {
@@ -368,108 +372,379 @@ static int encode_tb(srsran_sch_t*           q,
   return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0);
 }
 
-bool decode_tb_cb(srsran_sch_t*           q,
-                  srsran_softbuffer_rx_t* softbuffer,
-                  srsran_cbsegm_t*        cb_segm,
-                  uint32_t                Qm,
-                  uint32_t                rv,
-                  uint32_t                nof_e_bits,
-                  void*                   e_bits,
-                  uint8_t*                data)
+/**
+ * Decodes a single code block of a transport block. Code blocks with the CRC already passed in a previous transmission
+ * are restored from the softbuffer.
+ *
+ * @param q SCH object, only common configuration is read
+ * @param decoder Turbo decoder used for this code block
+ * @param crc_cb Code block CRC instance
+ * @param crc_tb Transport block CRC instance, used when there is a single code block
+ * @param cb_data Destination of the decoded code block, it must have room for the whole code block including its CRC
+ * @return The number of iterations, SRSRAN_ERROR if rate matching fails
+ */
+static int decode_cb(srsran_sch_t*           q,
+                     srsran_tdec_t*          decoder,
+                     srsran_crc_t*           crc_cb,
+                     srsran_crc_t*           crc_tb,
+                     srsran_softbuffer_rx_t* softbuffer,
+                     srsran_cbsegm_t*        cb_segm,
+                     uint32_t                Qm,
+                     uint32_t                rv,
+                     uint32_t                nof_e_bits,
+                     void*                   e_bits,
+                     uint32_t                cb_idx,
+                     uint8_t*                cb_data)
 {
   int8_t*  e_bits_b = e_bits;
   int16_t* e_bits_s = e_bits;
 
-  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
-    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
-    return false;
+  uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+  uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+
+  /* Do not process blocks with CRC Ok */
+  if (softbuffer->cb_crc[cb_idx]) {
+    // Copy decoded data from previous transmissions
+    memcpy(cb_data, softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+    return 0;
   }
 
-  q->avg_iterations = 0;
+  uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
 
-  for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
-    /* Do not process blocks with CRC Ok */
-    if (softbuffer->cb_crc[cb_idx] == false) {
-      uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+  uint32_t Gp    = nof_e_bits / Qm;
+  uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
+  uint32_t n_e   = Qm * (Gp / cb_segm->C);
 
-      uint32_t rlen  = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      uint32_t Gp    = nof_e_bits / Qm;
-      uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
-      uint32_t n_e   = Qm * (Gp / cb_segm->C);
+  uint32_t rp   = cb_idx * n_e;
+  uint32_t n_e2 = n_e;
 
-      uint32_t rp   = cb_idx * n_e;
-      uint32_t n_e2 = n_e;
+  if (cb_idx > cb_segm->C - gamma) {
+    n_e2 = n_e + Qm;
+    rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
+  }
 
-      if (cb_idx > cb_segm->C - gamma) {
-        n_e2 = n_e + Qm;
-        rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
-      }
+  if (q->llr_is_8bit) {
+    if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
+  } else {
+    if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
+  }
 
-      if (q->llr_is_8bit) {
-        if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
-      } else {
-        if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
+  srsran_tdec_new_cb(decoder, cb_len);
+
+  // Run iterations and use CRC for early stopping
+  bool     early_stop = false;
+  uint32_t cb_noi     = 0;
+  do {
+    if (q->llr_is_8bit) {
+      srsran_tdec_iteration_8bit(decoder, (int8_t*)softbuffer->buffer_f[cb_idx], cb_data);
+    } else {
+      srsran_tdec_iteration(decoder, softbuffer->buffer_f[cb_idx], cb_data);
+    }
+    cb_noi++;
+
+    uint32_t      len_crc;
+    srsran_crc_t* crc_ptr;
+
+    if (cb_segm->C > 1) {
+      len_crc = cb_len;
+      crc_ptr = crc_cb;
+    } else {
+      len_crc = cb_segm->tbs + 24;
+      crc_ptr = crc_tb;
+    }
+
+    // CRC is OK and ran the minimum number of iterations
+    if (!srsran_crc_checksum_byte(crc_ptr, cb_data, len_crc) && (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
+      softbuffer->cb_crc[cb_idx] = true;
+      early_stop                 = true;
+
+      // CRC is error and exceeded maximum iterations for this CB.
+      // Early stop the whole transport block.
+    }
+
+  } while (cb_noi < q->max_iterations && !early_stop);
+
+  INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
+       cb_idx,
+       rp,
+       n_e2,
+       cb_len,
+       early_stop ? "OK" : "KO",
+       rlen,
+       cb_noi,
+       q->max_iterations);
+
+  return (int)cb_noi;
+}
+
+/* Code block decoder context of an auxiliary worker. Every context owns its decoder, CRC instances and a code block
+ * sized output buffer, so that the CRC bits of one code block never overwrite the beginning of the next one in the
+ * transport block buffer. The calling thread uses the decoder, CRC instances and code block buffer of its own SCH
+ * object instead. */
+typedef struct {
+  srsran_tdec_t decoder;
+  srsran_crc_t  crc_cb;
+  srsran_crc_t  crc_tb;
+  uint8_t*      cb_out;
+} sch_cb_worker_t;
+
+/* Code block decoder pool. It can be shared by several SCH objects, for example all the transport blocks of a
+ * subframe, which decode through the same auxiliary threads. The last SCH object releasing it frees it. */
+typedef struct {
+  srsran_parallel_for_t parallel;
+  sch_cb_worker_t*      workers;
+  uint32_t              nof_workers;
+  uint32_t              nof_users;
+} sch_cb_pool_t;
+
+/* Transport block being decoded by the pool, it lives in the stack of the decoding thread */
+typedef struct {
+  sch_cb_pool_t*          pool;
+  srsran_sch_t*           q;
+  srsran_softbuffer_rx_t* softbuffer;
+  srsran_cbsegm_t*        cb_segm;
+  uint32_t                Qm;
+  uint32_t                rv;
+  uint32_t                nof_e_bits;
+  void*                   e_bits;
+  uint8_t*                data;
+  uint32_t                nof_iterations;
+  bool                    error;
+} sch_cb_job_t;
+
+static void sch_cb_pool_task(void* arg, uint32_t worker_idx, uint32_t cb_idx)
+{
+  sch_cb_job_t*    job     = (sch_cb_job_t*)arg;
+  srsran_sch_t*    q       = job->q;
+  srsran_cbsegm_t* cb_segm = job->cb_segm;
+
+  // The encoder never runs concurrently with the decoder of the same object, so its code block buffer is free
+  srsran_tdec_t* decoder = &q->decoder;
+  srsran_crc_t*  crc_cb  = &q->crc_cb;
+  srsran_crc_t*  crc_tb  = &q->crc_tb;
+  uint8_t*       cb_out  = q->cb_in;
+  if (worker_idx > 0) {
+    sch_cb_worker_t* w = &job->pool->workers[worker_idx - 1];
+    decoder            = &w->decoder;
+    crc_cb             = &w->crc_cb;
+    crc_tb             = &w->crc_tb;
+    cb_out             = w->cb_out;
+  }
+
+  int n = decode_cb(q,
+                    decoder,
+                    crc_cb,
+                    crc_tb,
+                    job->softbuffer,
+                    cb_segm,
+                    job->Qm,
+                    job->rv,
+                    job->nof_e_bits,
+                    job->e_bits,
+                    cb_idx,
+                    cb_out);
+  if (n < SRSRAN_SUCCESS) {
+    __atomic_store_n(&job->error, true, __ATOMIC_RELAXED);
+    return;
+  }
+  __atomic_fetch_add(&job->nof_iterations, (uint32_t)n, __ATOMIC_RELAXED);
+
+  uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+  uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+  memcpy(&job->data[cb_idx * rlen / 8], cb_out, rlen / 8 * sizeof(uint8_t));
+}
+
+static void sch_cb_pool_free(srsran_sch_t* q)
+{
+  sch_cb_pool_t* pool = (sch_cb_pool_t*)q->cb_pool_ptr;
+  if (pool == NULL) {
+    return;
+  }
+  q->cb_pool_ptr = NULL;
+
+  // Other objects still decode through it
+  if (__atomic_sub_fetch(&pool->nof_users, 1, __ATOMIC_ACQ_REL) > 0) {
+    return;
+  }
+
+  // Stop threads before releasing their decoders
+  srsran_parallel_for_free(&pool->parallel);
+
+  if (pool->workers) {
+    for (uint32_t i = 0; i < pool->nof_workers; i++) {
+      srsran_tdec_free(&pool->workers[i].decoder);
+      if (pool->workers[i].cb_out) {
+        free(pool->workers[i].cb_out);
       }
+    }
+    free(pool->workers);
+  }
+  free(pool);
+}
 
-      srsran_tdec_new_cb(&q->decoder, cb_len);
+int srsran_sch_set_cb_threads(srsran_sch_t* q, uint32_t nof_threads)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-      // Run iterations and use CRC for early stopping
-      bool     early_stop = false;
-      uint32_t cb_noi     = 0;
-      do {
-        if (q->llr_is_8bit) {
-          srsran_tdec_iteration_8bit(&q->decoder, (int8_t*)softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        } else {
-          srsran_tdec_iteration(&q->decoder, softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        }
-        q->avg_iterations++;
-        cb_noi++;
+  sch_cb_pool_free(q);
 
-        uint32_t      len_crc;
-        srsran_crc_t* crc_ptr;
+  if (nof_threads <= 1) {
+    return SRSRAN_SUCCESS;
+  }
 
-        if (cb_segm->C > 1) {
-          len_crc = cb_len;
-          crc_ptr = &q->crc_cb;
-        } else {
-          len_crc = cb_segm->tbs + 24;
-          crc_ptr = &q->crc_tb;
-        }
+  sch_cb_pool_t* pool = calloc(1, sizeof(sch_cb_pool_t));
+  if (pool == NULL) {
+    ERROR("Allocating code block decoder pool");
+    return SRSRAN_ERROR;
+  }
+  pool->nof_users = 1;
+  q->cb_pool_ptr  = pool;
+
+  // The calling thread decodes with the object own decoder, only the auxiliary threads need a context
+  pool->workers = calloc(nof_threads - 1, sizeof(sch_cb_worker_t));
+  if (pool->workers == NULL) {
+    ERROR("Allocating code block decoder contexts");
+    goto clean;
+  }
 
-        // CRC is OK and ran the minimum number of iterations
-        if (!srsran_crc_checksum_byte(crc_ptr, &data[cb_idx * rlen / 8], len_crc) &&
-            (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
-          softbuffer->cb_crc[cb_idx] = true;
-          early_stop                 = true;
+  for (uint32_t i = 0; i < nof_threads - 1; i++) {
+    sch_cb_worker_t* w = &pool->workers[i];
 
-          // CRC is error and exceeded maximum iterations for this CB.
-          // Early stop the whole transport block.
-        }
+    // Count the context before initialising it, so that it is released if any of the steps below fails
+    pool->nof_workers++;
 
-      } while (cb_noi < q->max_iterations && !early_stop);
+    if (srsran_crc_init(&w->crc_tb, SRSRAN_LTE_CRC24A, 24)) {
+      ERROR("Error initiating CRC");
+      goto clean;
+    }
+    if (srsran_crc_init(&w->crc_cb, SRSRAN_LTE_CRC24B, 24)) {
+      ERROR("Error initiating CRC");
+      goto clean;
+    }
+    if (srsran_tdec_init(&w->decoder, SRSRAN_TCOD_MAX_LEN_CB)) {
+      ERROR("Error initiating Turbo Decoder");
+      goto clean;
+    }
+    w->cb_out = srsran_vec_u8_malloc((SRSRAN_TCOD_MAX_LEN_CB + 8) / 8);
+    if (w->cb_out == NULL) {
+      goto clean;
+    }
+  }
 
-      INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
-           cb_idx,
-           rp,
-           n_e2,
-           cb_len,
-           early_stop ? "OK" : "KO",
-           rlen,
-           cb_noi,
-           q->max_iterations);
+  if (srsran_parallel_for_init(&pool->parallel, nof_threads)) {
+    ERROR("Creating code block decoder threads");
+    goto clean;
+  }
 
-    } else {
-      // Copy decoded data from previous transmissions
+  return SRSRAN_SUCCESS;
+
+clean:
+  sch_cb_pool_free(q);
+  return SRSRAN_ERROR;
+}
+
+int srsran_sch_share_cb_threads(srsran_sch_t* q, srsran_sch_t* src)
+{
+  if (q == NULL || src == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  sch_cb_pool_t* pool = (sch_cb_pool_t*)src->cb_pool_ptr;
+  if (pool == q->cb_pool_ptr) {
+    return SRSRAN_SUCCESS;
+  }
+
+  sch_cb_pool_free(q);
+
+  if (pool != NULL) {
+    __atomic_add_fetch(&pool->nof_users, 1, __ATOMIC_RELAXED);
+    q->cb_pool_ptr = pool;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static bool decode_tb_cb_parallel(sch_cb_pool_t*          pool,
+                                  srsran_sch_t*           q,
+                                  srsran_softbuffer_rx_t* softbuffer,
+                                  srsran_cbsegm_t*        cb_segm,
+                                  uint32_t                Qm,
+                                  uint32_t                rv,
+                                  uint32_t                nof_e_bits,
+                                  void*                   e_bits,
+                                  uint8_t*                data,
+                                  uint32_t*               nof_iterations)
+{
+  sch_cb_job_t job = {};
+  job.pool         = pool;
+  job.q            = q;
+  job.softbuffer   = softbuffer;
+  job.cb_segm      = cb_segm;
+  job.Qm           = Qm;
+  job.rv           = rv;
+  job.nof_e_bits   = nof_e_bits;
+  job.e_bits       = e_bits;
+  job.data         = data;
+
+  // Returns once all code blocks are decoded, before any transport block check. Other transport blocks sharing the
+  // pool may be decoded at the same time, the auxiliary threads serve them in order
+  srsran_parallel_for_run(&pool->parallel, cb_segm->C, sch_cb_pool_task, &job);
+
+  *nof_iterations += job.nof_iterations;
+
+  return !job.error;
+}
+
+bool decode_tb_cb(srsran_sch_t*           q,
+                  srsran_softbuffer_rx_t* softbuffer,
+                  srsran_cbsegm_t*        cb_segm,
+                  uint32_t                Qm,
+                  uint32_t                rv,
+                  uint32_t                nof_e_bits,
+                  void*                   e_bits,
+                  uint8_t*                data)
+{
+  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
+    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
+    return false;
+  }
+
+  uint32_t nof_iterations = 0;
+
+  sch_cb_pool_t* pool = (sch_cb_pool_t*)q->cb_pool_ptr;
+  if (pool != NULL && cb_segm->C > 1) {
+    if (!decode_tb_cb_parallel(pool, q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data, &nof_iterations)) {
+      return false;
+    }
+  } else {
+    for (uint32_t cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
       uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
       uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+
+      int n = decode_cb(q,
+                        &q->decoder,
+                        &q->crc_cb,
+                        &q->crc_tb,
+                        softbuffer,
+                        cb_segm,
+                        Qm,
+                        rv,
+                        nof_e_bits,
+                        e_bits,
+                        cb_idx,
+                        &data[cb_idx * rlen / 8]);
+      if (n < SRSRAN_SUCCESS) {
+        return false;
+      }
+      nof_iterations += (uint32_t)n;
     }
   }
 
@@ -489,7 +764,7 @@ bool decode_tb_cb(srsran_sch_t*           q,
     }
   }
 
-  q->avg_iterations /= (float)cb_segm->C;
+  q->avg_iterations = (float)nof_iterations / (float)cb_segm->C;
   return softbuffer->tb_crc;
 }
 
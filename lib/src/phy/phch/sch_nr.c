@@ -27,6 +27,7 @@
 #include "srsran/phy/phch/ra_nr.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/parallel.h"
 #include "srsran/phy/utils/vector.h"
 
 #define SCH_INFO_TX(...) INFO("SCH Tx: " __VA_ARGS__)
@@ -216,6 +217,296 @@ static inline int sch_nr_init_common(srsran_sch_nr_t* q)
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * @brief Code block selected for decoding in a transport block
+ */
+typedef struct {
+  int8_t*  input; ///< Points to the first received LLR of the code block
+  uint32_t E;     ///< Rate matching output sequence number of bits
+  uint32_t r;     ///< Code block index
+} sch_nr_cb_task_t;
+
+/**
+ * @brief Code block decoder context, one for each parallel worker. Every context owns its rate matcher, CRC instances,
+ * temporal buffer and the LDPC decoders of every base graph and lifting size.
+ */
+typedef struct {
+  srsran_ldpc_decoder_t* decoder_bg1[MAX_LIFTSIZE + 1];
+  srsran_ldpc_decoder_t* decoder_bg2[MAX_LIFTSIZE + 1];
+  srsran_ldpc_rm_t       rx_rm;
+  srsran_crc_t           crc_tb_24;
+  srsran_crc_t           crc_tb_16;
+  srsran_crc_t           crc_cb;
+  uint8_t*               temp_cb;
+  uint32_t               nof_iter_sum;
+  bool                   error;
+} sch_nr_cb_worker_t;
+
+typedef struct {
+  srsran_parallel_for_t      parallel;
+  sch_nr_cb_worker_t*        workers;
+  uint32_t                   nof_workers;
+  srsran_ldpc_decoder_args_t decoder_args; ///< Decoder type and parameters, BG and lifting size are set on creation
+
+  // Transport block being decoded
+  const srsran_sch_nr_tb_info_t* cfg;
+  const srsran_sch_tb_t*         tb;
+  const sch_nr_cb_task_t*        tasks;
+} sch_nr_cb_pool_t;
+
+static inline srsran_crc_t*
+sch_nr_select_crc(const srsran_sch_nr_tb_info_t* cfg, srsran_crc_t* crc_cb, srsran_crc_t* crc_16, srsran_crc_t* crc_24)
+{
+  // Select CB or TB early stop CRC
+  if (cfg->L_cb) {
+    return crc_cb;
+  }
+  return (cfg->L_tb == 16) ? crc_16 : crc_24;
+}
+
+/**
+ * @brief Rate dematches and decodes a single code block, it stores the code block CRC result in the soft-buffer and
+ * packs the data if the CRC matches
+ * @return The number of decoder iterations if no error occurs, SRSRAN_ERROR code otherwise
+ */
+static int sch_nr_decode_cb(srsran_ldpc_rm_t*              rx_rm,
+                            srsran_ldpc_decoder_t*         decoder,
+                            srsran_crc_t*                  crc,
+                            uint8_t*                       temp_cb,
+                            const srsran_sch_nr_tb_info_t* cfg,
+                            const srsran_sch_tb_t*         tb,
+                            const sch_nr_cb_task_t*        task)
+{
+  uint32_t r         = task->r;
+  int8_t*  rm_buffer = (int8_t*)tb->softbuffer.tx->buffer_b[r];
+
+  // LDPC Rate matching
+  SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
+              r,
+              task->E,
+              cfg->F,
+              cfg->bg == BG1 ? 1 : 2,
+              cfg->Z,
+              tb->rv,
+              cfg->Qm,
+              cfg->Nref);
+  int n_llr =
+      srsran_ldpc_rm_rx_c(rx_rm, task->input, rm_buffer, task->E, cfg->F, cfg->bg, cfg->Z, tb->rv, tb->mod, cfg->Nref);
+  if (n_llr < SRSRAN_SUCCESS) {
+    ERROR("Error in LDPC rate mateching");
+    return SRSRAN_ERROR;
+  }
+
+  // Decode. if CRC=KO, then ret=0
+  int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, temp_cb, n_llr, crc);
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error decoding CB");
+    return SRSRAN_ERROR;
+  }
+
+  // Compute number of iterations
+  uint32_t n_iter_cb = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
+
+  // Check if CB is all zeros
+  uint32_t cb_len = cfg->Kp - cfg->L_cb;
+
+  tb->softbuffer.rx->cb_crc[r] = (ret != 0);
+  SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg->C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
+
+  // CB Debug trace
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+    DEBUG("CB %d/%d:", r, cfg->C);
+    srsran_vec_fprint_hex(stdout, temp_cb, cb_len);
+  }
+
+  // Pack only if CRC is match
+  if (tb->softbuffer.rx->cb_crc[r]) {
+    srsran_bit_pack_vector(temp_cb, tb->softbuffer.rx->data[r], cb_len);
+  }
+
+  return (int)n_iter_cb;
+}
+
+static int
+sch_nr_cb_worker_decoder_init(sch_nr_cb_pool_t* pool, sch_nr_cb_worker_t* w, srsran_basegraph_t bg, uint32_t Z)
+{
+  srsran_ldpc_decoder_t* d = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
+  if (d == NULL) {
+    ERROR("Error: calloc");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(d, srsran_ldpc_decoder_t, 1);
+
+  srsran_ldpc_decoder_args_t decoder_args = pool->decoder_args;
+  decoder_args.bg                         = bg;
+  decoder_args.ls                         = Z;
+  if (srsran_ldpc_decoder_init(d, &decoder_args) < SRSRAN_SUCCESS) {
+    ERROR("Error: initialising BG%d LDPC decoder for ls=%d", bg == BG1 ? 1 : 2, Z);
+    free(d);
+    return SRSRAN_ERROR;
+  }
+
+  if (bg == BG1) {
+    w->decoder_bg1[Z] = d;
+  } else {
+    w->decoder_bg2[Z] = d;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static void sch_nr_cb_pool_task(void* arg, uint32_t worker_idx, uint32_t task_idx)
+{
+  sch_nr_cb_pool_t*              pool = (sch_nr_cb_pool_t*)arg;
+  sch_nr_cb_worker_t*            w    = &pool->workers[worker_idx];
+  const srsran_sch_nr_tb_info_t* cfg  = pool->cfg;
+
+  srsran_ldpc_decoder_t* decoder = (cfg->bg == BG1) ? w->decoder_bg1[cfg->Z] : w->decoder_bg2[cfg->Z];
+  if (decoder == NULL) {
+    ERROR("Error: no BG%d LDPC decoder for ls=%d", cfg->bg == BG1 ? 1 : 2, cfg->Z);
+    w->error = true;
+    return;
+  }
+
+  srsran_crc_t* crc = sch_nr_select_crc(cfg, &w->crc_cb, &w->crc_tb_16, &w->crc_tb_24);
+
+  int n = sch_nr_decode_cb(&w->rx_rm, decoder, crc, w->temp_cb, cfg, pool->tb, &pool->tasks[task_idx]);
+  if (n < SRSRAN_SUCCESS) {
+    w->error = true;
+    return;
+  }
+  w->nof_iter_sum += (uint32_t)n;
+}
+
+static void sch_nr_cb_pool_free(srsran_sch_nr_t* q)
+{
+  sch_nr_cb_pool_t* pool = (sch_nr_cb_pool_t*)q->cb_pool_ptr;
+  if (pool == NULL) {
+    return;
+  }
+
+  // Stop threads before releasing their decoders
+  srsran_parallel_for_free(&pool->parallel);
+
+  if (pool->workers) {
+    for (uint32_t i = 0; i < pool->nof_workers; i++) {
+      sch_nr_cb_worker_t* w = &pool->workers[i];
+      for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
+        if (w->decoder_bg1[ls]) {
+          srsran_ldpc_decoder_free(w->decoder_bg1[ls]);
+          free(w->decoder_bg1[ls]);
+        }
+        if (w->decoder_bg2[ls]) {
+          srsran_ldpc_decoder_free(w->decoder_bg2[ls]);
+          free(w->decoder_bg2[ls]);
+        }
+      }
+      srsran_ldpc_rm_rx_free_c(&w->rx_rm);
+      if (w->temp_cb) {
+        free(w->temp_cb);
+      }
+    }
+    free(pool->workers);
+  }
+  free(pool);
+
+  q->cb_pool_ptr = NULL;
+}
+
+static int sch_nr_cb_pool_init(srsran_sch_nr_t* q, const srsran_ldpc_decoder_args_t* decoder_args, uint32_t nof_threads)
+{
+  sch_nr_cb_pool_t* pool = SRSRAN_MEM_ALLOC(sch_nr_cb_pool_t, 1);
+  if (pool == NULL) {
+    ERROR("Error: allocating code block decoder pool");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(pool, sch_nr_cb_pool_t, 1);
+  pool->decoder_args = *decoder_args;
+  q->cb_pool_ptr     = pool;
+
+  pool->workers = SRSRAN_MEM_ALLOC(sch_nr_cb_worker_t, nof_threads);
+  if (pool->workers == NULL) {
+    ERROR("Error: allocating code block decoder contexts");
+    goto clean;
+  }
+  SRSRAN_MEM_ZERO(pool->workers, sch_nr_cb_worker_t, nof_threads);
+
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    sch_nr_cb_worker_t* w = &pool->workers[i];
+
+    // Count the context before initialising it, so that it is released if any of the steps below fails
+    pool->nof_workers++;
+
+    if (srsran_crc_init(&w->crc_tb_24, SRSRAN_LTE_CRC24A, 24) < SRSRAN_SUCCESS ||
+        srsran_crc_init(&w->crc_cb, SRSRAN_LTE_CRC24B, 24) < SRSRAN_SUCCESS ||
+        srsran_crc_init(&w->crc_tb_16, SRSRAN_LTE_CRC16, 16) < SRSRAN_SUCCESS) {
+      ERROR("Error: initialising CRC");
+      goto clean;
+    }
+
+    if (srsran_ldpc_rm_rx_init_c(&w->rx_rm) < SRSRAN_SUCCESS) {
+      ERROR("Error: initialising Rx LDPC Rate matching");
+      goto clean;
+    }
+
+    w->temp_cb = srsran_vec_u8_malloc(SRSRAN_LDPC_MAX_LEN_CB * 8);
+    if (w->temp_cb == NULL) {
+      goto clean;
+    }
+
+    // Create the decoders of every valid lifting size upfront, as the serial path does
+    for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
+      if (get_ls_index(ls) == VOID_LIFTSIZE) {
+        continue;
+      }
+      if (sch_nr_cb_worker_decoder_init(pool, w, BG1, ls) < SRSRAN_SUCCESS ||
+          sch_nr_cb_worker_decoder_init(pool, w, BG2, ls) < SRSRAN_SUCCESS) {
+        goto clean;
+      }
+    }
+  }
+
+  if (srsran_parallel_for_init(&pool->parallel, nof_threads) < SRSRAN_SUCCESS) {
+    ERROR("Error: creating code block decoder threads");
+    goto clean;
+  }
+
+  return SRSRAN_SUCCESS;
+
+clean:
+  sch_nr_cb_pool_free(q);
+  return SRSRAN_ERROR;
+}
+
+static int sch_nr_decode_cb_parallel(sch_nr_cb_pool_t*              pool,
+                                     const srsran_sch_nr_tb_info_t* cfg,
+                                     const srsran_sch_tb_t*         tb,
+                                     const sch_nr_cb_task_t*        tasks,
+                                     uint32_t                       nof_tasks,
+                                     uint32_t*                      nof_iter_sum)
+{
+  pool->cfg   = cfg;
+  pool->tb    = tb;
+  pool->tasks = tasks;
+
+  for (uint32_t i = 0; i < pool->nof_workers; i++) {
+    pool->workers[i].nof_iter_sum = 0;
+    pool->workers[i].error        = false;
+  }
+
+  // Every code block writes its own soft-buffer entries, so the result does not depend on the task order
+  srsran_parallel_for_run(&pool->parallel, nof_tasks, sch_nr_cb_pool_task, pool);
+
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < pool->nof_workers; i++) {
+    *nof_iter_sum += pool->workers[i].nof_iter_sum;
+    if (pool->workers[i].error) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  return ret;
+}
+
 int srsran_sch_nr_init_tx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
 {
   int ret = sch_nr_init_common(q);
@@ -356,6 +647,17 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     return SRSRAN_ERROR;
   }
 
+  if (args->nof_cb_threads > 1 && q->cb_pool_ptr == NULL) {
+    srsran_ldpc_decoder_args_t decoder_args = {};
+    decoder_args.type                       = decoder_type;
+    decoder_args.scaling_fctr               = scaling_factor;
+    decoder_args.max_nof_iter               = args->max_nof_iter;
+    if (sch_nr_cb_pool_init(q, &decoder_args, args->nof_cb_threads) < SRSRAN_SUCCESS) {
+      ERROR("Error: initialising code block decoder pool");
+      return SRSRAN_ERROR;
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -377,6 +679,8 @@ void srsran_sch_nr_free(srsran_sch_nr_t* q)
     return;
   }
 
+  sch_nr_cb_pool_free(q);
+
   if (q->temp_cb) {
     free(q->temp_cb);
   }
@@ -607,8 +911,10 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
   uint32_t cb_ok = 0;
   res->crc       = false;
 
-  // For each code block...
-  uint32_t j = 0;
+  // Select the code blocks that need decoding...
+  sch_nr_cb_task_t tasks[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];
+  uint32_t         nof_tasks = 0;
+  uint32_t         j         = 0;
   for (uint32_t r = 0; r < cfg.C; r++) {
     bool    decoded   = tb->softbuffer.rx->cb_crc[r];
     int8_t* rm_buffer = (int8_t*)tb->softbuffer.tx->buffer_b[r];
@@ -637,60 +943,38 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
       continue;
     }
 
-    // LDPC Rate matching
-    SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
-                r,
-                E,
-                cfg.F,
-                cfg.bg == BG1 ? 1 : 2,
-                cfg.Z,
-                tb->rv,
-                cfg.Qm,
-                cfg.Nref);
-    int n_llr =
-        srsran_ldpc_rm_rx_c(&q->rx_rm, input_ptr, rm_buffer, E, cfg.F, cfg.bg, cfg.Z, tb->rv, tb->mod, cfg.Nref);
-    if (n_llr < SRSRAN_SUCCESS) {
-      ERROR("Error in LDPC rate mateching");
-      return SRSRAN_ERROR;
-    }
+    tasks[nof_tasks].input = input_ptr;
+    tasks[nof_tasks].E     = E;
+    tasks[nof_tasks].r     = r;
+    nof_tasks++;
 
-    // Select CB or TB early stop CRC
-    srsran_crc_t* crc = (cfg.L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
-    if (cfg.L_cb) {
-      crc = &q->crc_cb;
-    }
+    input_ptr += E;
+  }
 
-    // Decode. if CRC=KO, then ret=0
-    int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, q->temp_cb, n_llr, crc);
-    if (ret < SRSRAN_SUCCESS) {
-      ERROR("Error decoding CB");
+  // ... and decode them, either in the code block decoder pool or in the calling thread
+  sch_nr_cb_pool_t* pool = (sch_nr_cb_pool_t*)q->cb_pool_ptr;
+  if (pool != NULL && nof_tasks > 1) {
+    if (sch_nr_decode_cb_parallel(pool, &cfg, tb, tasks, nof_tasks, &nof_iter_sum) < SRSRAN_SUCCESS) {
       return SRSRAN_ERROR;
     }
-
-    // Compute number of iterations
-    uint32_t n_iter_cb = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
-    nof_iter_sum += n_iter_cb;
-
-    // Check if CB is all zeros
-    uint32_t cb_len = cfg.Kp - cfg.L_cb;
-
-    tb->softbuffer.rx->cb_crc[r] = (ret != 0);
-    SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg.C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
-
-    // CB Debug trace
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-      DEBUG("CB %d/%d:", r, cfg.C);
-      srsran_vec_fprint_hex(stdout, q->temp_cb, cb_len);
+  } else {
+    srsran_crc_t* crc = sch_nr_select_crc(&cfg, &q->crc_cb, &q->crc_tb_16, &q->crc_tb_24);
+    for (uint32_t i = 0; i < nof_tasks; i++) {
+      int n = sch_nr_decode_cb(&q->rx_rm, decoder, crc, q->temp_cb, &cfg, tb, &tasks[i]);
+      if (n < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+      nof_iter_sum += (uint32_t)n;
     }
+  }
 
-    // Pack and count CRC OK only if CRC is match
-    if (tb->softbuffer.rx->cb_crc[r]) {
-      srsran_bit_pack_vector(q->temp_cb, tb->softbuffer.rx->data[r], cb_len);
+  // Count CRC OK
+  for (uint32_t i = 0; i < nof_tasks; i++) {
+    if (tb->softbuffer.rx->cb_crc[tasks[i].r]) {
       cb_ok++;
     }
-
-    input_ptr += E;
   }
+
   // Set average number of iterations
   res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
 
@@ -50,6 +50,7 @@ static uint16_t    rnti                         = 1234;
 static uint32_t    nof_rx_antennas              = 1;
 static bool        tb_cw_swap                   = false;
 static bool        enable_coworker              = false;
+static uint32_t    cb_threads                   = 1;
 static uint32_t    pmi                          = 0;
 static char*       input_file                   = NULL;
 static int         M                            = 1;
@@ -76,6 +77,7 @@ void usage(char* prog)
   printf("\t-p pmi (multiplex only)  [Default %d]\n", pmi);
   printf("\t-w Swap Transport Blocks\n");
   printf("\t-j Enable PDSCH decoder coworker\n");
+  printf("\t-T number of code block decoder threads [Default %d]\n", cb_threads);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
   printf("\t-q Enable/Disable 256QAM modulation (default %s)\n", enable_256qam ? "enabled" : "disabled");
 }
@@ -83,7 +85,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxj")) != -1) {
+  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxjT")) != -1) {
     switch (opt) {
       case 'f':
         input_file = argv[optind];
@@ -136,6 +138,9 @@ void parse_args(int argc, char** argv)
       case 'j':
         enable_coworker = true;
         break;
+      case 'T':
+        cb_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -485,6 +490,10 @@ int main(int argc, char** argv)
   if (enable_coworker) {
     srsran_pdsch_enable_coworker(&pdsch_rx);
   }
+  if (srsran_pdsch_set_cb_threads(&pdsch_rx, cb_threads)) {
+    ERROR("Error creating code block decoder threads");
+    goto quit;
+  }
 
   for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
     pdsch_cfg.softbuffers.rx[i] = softbuffers_rx[i];
@@ -29,14 +29,15 @@
 
 static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
 
-static uint32_t            n_prb     = 0;  // Set to 0 for steering
-static uint32_t            mcs       = 30; // Set to 30 for steering
-static uint32_t            rv        = 4;  // Set to 30 for steering
-static srsran_sch_cfg_nr_t pdsch_cfg = {};
+static uint32_t            n_prb      = 0;  // Set to 0 for steering
+static uint32_t            mcs        = 30; // Set to 30 for steering
+static uint32_t            rv         = 4;  // Set to 30 for steering
+static uint32_t            cb_threads = 1;
+static srsran_sch_cfg_nr_t pdsch_cfg  = {};
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [prTL] \n", prog);
+  printf("Usage: %s [prTLt] \n", prog);
   printf("\t-P Number of carrier PRB [Default %d]\n", carrier.nof_prb);
   printf("\t-p Number of grant PRB, set to 0 for steering [Default %d]\n", n_prb);
   printf("\t-r Redundancy version, set to 4 or higher for steering [Default %d]\n", rv);
@@ -44,13 +45,14 @@ static void usage(char* prog)
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table));
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
+  printf("\t-t Number of code block decoder threads [Default %d]\n", cb_threads);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "PpmTLvr")) != -1) {
+  while ((opt = getopt(argc, argv, "PpmTLtvr")) != -1) {
     switch (opt) {
       case 'P':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -70,6 +72,9 @@ int parse_args(int argc, char** argv)
       case 'L':
         carrier.max_mimo_layers = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 't':
+        cb_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -110,6 +115,7 @@ int main(int argc, char** argv)
   args.decoder_use_flooded    = false;
   args.decoder_scaling_factor = 0.8;
   args.max_nof_iter           = 20;
+  args.nof_cb_threads         = cb_threads;
   if (srsran_sch_nr_init_tx(&sch_nr_tx, &args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating SCH NR for Tx");
     goto clean_exit;
@@ -0,0 +1,231 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Streams subframes between a ZMQ transmitter and receiver pair for 1 to N channels, either with one socket pair per
+ * channel or with all channels interleaved in a single stream, and prints the achieved sample rate per channel. The
+ * samples go through the same conversion (gain, format) as in the ZMQ RF device, without its real time pacing.
+ */
+
+#include "rf_zmq_imp_trx.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <zmq.h>
+
+#define MAX_CHANNELS (8)
+
+static double          srate_msps       = 23.04;
+static uint32_t        nof_sf           = 1000;
+static uint32_t        max_nof_channels = 4;
+static rf_zmq_format_t sample_format    = ZMQ_TYPE_FC32;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [sncf]\n", prog);
+  printf("\t-s base sampling rate in Msps, subframes are 1 ms long [Default %.2f]\n", srate_msps);
+  printf("\t-n number of subframes [Default %d]\n", nof_sf);
+  printf("\t-c maximum number of channels, up to %d [Default %d]\n", MAX_CHANNELS, max_nof_channels);
+  printf("\t-f transport sample format, fc32 or sc16 [Default fc32]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "sncf")) != -1) {
+    switch (opt) {
+      case 's':
+        srate_msps = strtod(argv[optind], NULL);
+        break;
+      case 'n':
+        nof_sf = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        max_nof_channels = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        sample_format = strcmp(argv[optind], "sc16") ? ZMQ_TYPE_FC32 : ZMQ_TYPE_SC16;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (max_nof_channels == 0 || max_nof_channels > MAX_CHANNELS) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+typedef struct {
+  rf_zmq_tx_t tx[MAX_CHANNELS];
+  rf_zmq_rx_t rx[MAX_CHANNELS];
+  cf_t*       tx_buffers[MAX_CHANNELS];
+  cf_t*       rx_buffers[MAX_CHANNELS];
+  uint32_t    nof_streams;
+  uint32_t    stream_nof_channels;
+  uint32_t    sf_len;
+  int         tx_ret;
+} bench_t;
+
+static void* tx_thread(void* arg)
+{
+  bench_t* q = (bench_t*)arg;
+
+  for (uint32_t sf = 0; sf < nof_sf; sf++) {
+    // Tag every channel of the subframe, so that the receiver can check the stream and channel order
+    for (uint32_t c = 0; c < q->nof_streams * q->stream_nof_channels; c++) {
+      q->tx_buffers[c][0] = (float)(sf % 256) / 256.0f + _Complex_I * (float)c / 16.0f;
+    }
+    for (uint32_t s = 0; s < q->nof_streams; s++) {
+      cf_t** buffers = &q->tx_buffers[s * q->stream_nof_channels];
+      if (rf_zmq_tx_baseband(&q->tx[s], buffers, q->sf_len, 1, 1.0f) != q->sf_len) {
+        q->tx_ret = SRSRAN_ERROR;
+        return NULL;
+      }
+    }
+  }
+  return NULL;
+}
+
+static int run(uint32_t nof_channels, bool interleaved)
+{
+  int      ret = SRSRAN_ERROR;
+  bench_t* q   = calloc(1, sizeof(bench_t));
+  void*    ctx = zmq_ctx_new();
+  if (q == NULL || ctx == NULL) {
+    return SRSRAN_ERROR;
+  }
+  q->nof_streams         = interleaved ? 1 : nof_channels;
+  q->stream_nof_channels = interleaved ? nof_channels : 1;
+  q->sf_len              = (uint32_t)(srate_msps * 1000);
+
+  rf_zmq_opts_t tx_opts = {};
+  rf_zmq_opts_t rx_opts = {};
+  tx_opts.id            = "bench_tx";
+  tx_opts.socket_type   = ZMQ_REP;
+  tx_opts.sample_format = sample_format;
+  tx_opts.nof_channels  = q->stream_nof_channels;
+  rx_opts.id            = "bench_rx";
+  rx_opts.socket_type   = ZMQ_REQ;
+  rx_opts.sample_format = sample_format;
+  rx_opts.nof_channels  = q->stream_nof_channels;
+  // Short timeouts, so that the receivers stop soon after the last subframe
+  tx_opts.trx_timeout_ms = 100;
+  rx_opts.trx_timeout_ms = 100;
+
+  for (uint32_t s = 0; s < q->nof_streams; s++) {
+    char addr[64];
+    snprintf(addr, sizeof(addr), "inproc://rf_zmq_benchmark_%d", s);
+    if (rf_zmq_tx_open(&q->tx[s], tx_opts, ctx, addr) != SRSRAN_SUCCESS ||
+        rf_zmq_rx_open(&q->rx[s], rx_opts, ctx, addr) != SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error opening stream %d\n", s);
+      goto clean_exit;
+    }
+  }
+  for (uint32_t c = 0; c < nof_channels; c++) {
+    q->tx_buffers[c] = srsran_vec_cf_malloc(q->sf_len);
+    q->rx_buffers[c] = srsran_vec_cf_malloc(q->sf_len);
+    if (q->tx_buffers[c] == NULL || q->rx_buffers[c] == NULL) {
+      goto clean_exit;
+    }
+    srsran_vec_cf_zero(q->tx_buffers[c], q->sf_len);
+  }
+
+  struct timeval t[3];
+  pthread_t      thread;
+  uint32_t       nof_errors = 0;
+  gettimeofday(&t[1], NULL);
+  if (pthread_create(&thread, NULL, tx_thread, q)) {
+    goto clean_exit;
+  }
+  for (uint32_t sf = 0; sf < nof_sf; sf++) {
+    for (uint32_t s = 0; s < q->nof_streams; s++) {
+      cf_t** buffers = &q->rx_buffers[s * q->stream_nof_channels];
+      int    n       = SRSRAN_ERROR_TIMEOUT;
+      while (n == SRSRAN_ERROR_TIMEOUT) {
+        n = rf_zmq_rx_baseband(&q->rx[s], buffers, q->sf_len, 1, 1.0f);
+      }
+      if (n != q->sf_len) {
+        nof_errors++;
+      }
+    }
+    for (uint32_t c = 0; c < nof_channels; c++) {
+      cf_t expected = (float)(sf % 256) / 256.0f + _Complex_I * (float)c / 16.0f;
+      if (cabsf(q->rx_buffers[c][0] - expected) > 1e-3f) {
+        nof_errors++;
+      }
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  pthread_join(thread, NULL);
+  get_time_interval(t);
+
+  double elapsed_us = t[0].tv_sec * 1e6 + t[0].tv_usec;
+  double rate_msps  = elapsed_us > 0 ? (double)nof_sf * q->sf_len / elapsed_us : 0;
+  printf("%s, %d channels: %8.1f Msps per channel, %6.1fx real time\n",
+         interleaved ? "interleaved" : "ports      ",
+         nof_channels,
+         rate_msps,
+         rate_msps / srate_msps);
+
+  if (nof_errors == 0 && q->tx_ret == SRSRAN_SUCCESS) {
+    ret = SRSRAN_SUCCESS;
+  } else {
+    fprintf(stderr, "Error: %d corrupted subframes\n", nof_errors);
+  }
+
+clean_exit:
+  for (uint32_t s = 0; s < q->nof_streams; s++) {
+    rf_zmq_rx_close(&q->rx[s]);
+    rf_zmq_tx_close(&q->tx[s]);
+  }
+  zmq_ctx_destroy(ctx);
+  for (uint32_t s = 0; s < q->nof_streams; s++) {
+    rf_zmq_tx_free(&q->tx[s]);
+  }
+  for (uint32_t c = 0; c < nof_channels; c++) {
+    free(q->tx_buffers[c]);
+    free(q->rx_buffers[c]);
+  }
+  free(q);
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  printf("%.2f Msps, %d subframes, %s samples\n", srate_msps, nof_sf, sample_format == ZMQ_TYPE_SC16 ? "sc16" : "fc32");
+  for (uint32_t nof_channels = 1; nof_channels <= max_nof_channels; nof_channels++) {
+    if (run(nof_channels, false) != SRSRAN_SUCCESS || run(nof_channels, true) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
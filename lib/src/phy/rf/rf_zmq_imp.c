@@ -47,6 +47,7 @@ typedef struct {
   uint32_t tx_freq_mhz[SRSRAN_MAX_CHANNELS];
   uint32_t rx_freq_mhz[SRSRAN_MAX_CHANNELS];
   bool     tx_off;
+  bool     interleaved; // all channels are carried by the sockets of the first channel
   char     id[RF_PARAM_LEN];
 
   // Server
@@ -54,10 +55,6 @@ typedef struct {
   rf_zmq_tx_t transmitter[SRSRAN_MAX_CHANNELS];
   rf_zmq_rx_t receiver[SRSRAN_MAX_CHANNELS];
 
-  // Various sample buffers
-  cf_t* buffer_decimation[SRSRAN_MAX_CHANNELS];
-  cf_t* buffer_tx;
-
   // Rx timestamp
   uint64_t next_rx_ts;
 
@@ -288,6 +285,13 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
           goto clean_exit;
         }
       }
+
+      // interleaved
+      if (parse_string(args, "interleaved", -1, tmp) == SRSRAN_SUCCESS) {
+        handler->interleaved = (strncmp(tmp, "true", RF_PARAM_LEN) == 0 || strncmp(tmp, "yes", RF_PARAM_LEN) == 0);
+      }
+      rx_opts.nof_channels = handler->interleaved ? nof_channels : 1;
+      tx_opts.nof_channels = handler->interleaved ? nof_channels : 1;
     } else {
       fprintf(stderr,
               "[zmq] Error: No device 'args' option has been set. Please make sure to set this option to be able to "
@@ -347,6 +351,14 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
         rx_opts.log_trx_timeout = true;
       }
 
+      // With interleaved channels the sockets of the first channel carry all of them, the other channels only keep
+      // their frequency for the port mapping
+      if (handler->interleaved && i > 0) {
+        handler->transmitter[i].frequency_mhz = tx_opts.frequency_mhz;
+        handler->receiver[i].frequency_mhz    = rx_opts.frequency_mhz;
+        continue;
+      }
+
       // initialize transmitter
       if (strlen(tx_port) != 0) {
         if (rf_zmq_tx_open(&handler->transmitter[i], tx_opts, handler->context, tx_port) != SRSRAN_SUCCESS) {
@@ -374,21 +386,6 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
       }
     }
 
-    // Create decimation and overflow buffer
-    for (uint32_t i = 0; i < handler->nof_channels; i++) {
-      handler->buffer_decimation[i] = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-      if (!handler->buffer_decimation[i]) {
-        fprintf(stderr, "Error: allocating decimation buffer\n");
-        goto clean_exit;
-      }
-    }
-
-    handler->buffer_tx = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-    if (!handler->buffer_tx) {
-      fprintf(stderr, "Error: allocating tx buffer\n");
-      goto clean_exit;
-    }
-
     ret = SRSRAN_SUCCESS;
 
   clean_exit:
@@ -414,14 +411,9 @@ int rf_zmq_close(void* h)
     zmq_ctx_destroy(handler->context);
   }
 
-  for (uint32_t i = 0; i < handler->nof_channels; i++) {
-    if (handler->buffer_decimation[i]) {
-      free(handler->buffer_decimation[i]);
-    }
-  }
-
-  if (handler->buffer_tx) {
-    free(handler->buffer_tx);
+  // ZMQ may reference the transmitted samples until its context is destroyed
+  for (int i = 0; i < handler->nof_channels; i++) {
+    rf_zmq_tx_free(&handler->transmitter[i]);
   }
 
   pthread_mutex_destroy(&handler->tx_config_mutex);
@@ -720,106 +712,56 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
       }
     }
 
-    // copy from rx buffer as many samples as requested into provided buffer
-    bool    completed                  = false;
-    int32_t count[SRSRAN_MAX_CHANNELS] = {};
-    while (!completed) {
-      uint32_t completed_count = 0;
-
-      // Iterate channels
-      for (uint32_t i = 0; i < handler->nof_channels; i++) {
-        cf_t* ptr = (decim_factor != 1 || buffers[i] == NULL) ? handler->buffer_decimation[i] : buffers[i];
+    // Load the gain
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
 
-        // Completed condition
-        if (count[i] < nsamples_baserate && rf_zmq_rx_is_running(&handler->receiver[i])) {
-          // Keep receiving
-          int32_t n = rf_zmq_rx_baseband(&handler->receiver[i], &ptr[count[i]], nsamples_baserate);
+    // Each stream carries stream_nof_channels consecutive channels, the conversion writes them into their buffers
+    uint32_t nof_streams         = handler->interleaved ? 1 : handler->nof_channels;
+    uint32_t stream_nof_channels = handler->nof_channels / nof_streams;
+    for (uint32_t s = 0; s < nof_streams; s++) {
+      rf_zmq_rx_t* receiver = &handler->receiver[s];
+      int32_t      n        = SRSRAN_ERROR_TIMEOUT;
+      while (n == SRSRAN_ERROR_TIMEOUT && rf_zmq_rx_is_running(receiver)) {
+        n = rf_zmq_rx_baseband(receiver, &buffers[s * stream_nof_channels], nsamples, decim_factor, scale);
 #if ZMQ_MONITOR
-          // handle socket events
-          int event = rf_zmq_rx_get_monitor_event(handler->receiver[i].socket_monitor, NULL, NULL);
-          if (event != -1) {
-            printf("event=0x%X\n", event);
-            switch (event) {
-              case ZMQ_EVENT_CONNECTED:
-                handler->receiver[i].tx_connected = true;
-                break;
-              case ZMQ_EVENT_CLOSED:
-                handler->receiver[i].tx_connected = false;
-                break;
-              default:
-                break;
-            }
+        // handle socket events
+        int event = rf_zmq_rx_get_monitor_event(receiver->socket_monitor, NULL, NULL);
+        if (event != -1) {
+          printf("event=0x%X\n", event);
+          switch (event) {
+            case ZMQ_EVENT_CONNECTED:
+              receiver->tx_connected = true;
+              break;
+            case ZMQ_EVENT_CLOSED:
+              receiver->tx_connected = false;
+              break;
+            default:
+              break;
           }
+        }
 #endif // ZMQ_MONITOR
-          if (n > SRSRAN_SUCCESS) {
-            // No error
-            count[i] += n;
-          } else if (n == SRSRAN_ERROR_TIMEOUT) {
-            if (handler->receiver[i].log_trx_timeout) {
-              fprintf(stderr, "Error: timeout receiving samples after %dms\n", handler->receiver[i].trx_timeout_ms);
-            }
-            // Other end disconnected, either keep going, or fail
-            if (handler->receiver[i].fail_on_disconnect) {
-              goto clean_exit;
-            }
-          } else if (n < SRSRAN_SUCCESS) {
-            // Other error, exit
-            fprintf(stderr, "Error: receiving data.\n");
+        if (n == SRSRAN_ERROR_TIMEOUT) {
+          if (receiver->log_trx_timeout) {
+            fprintf(stderr, "Error: timeout receiving samples after %dms\n", receiver->trx_timeout_ms);
+          }
+          // Other end disconnected, either keep going, or fail
+          if (receiver->fail_on_disconnect) {
             goto clean_exit;
           }
-        } else {
-          // Completed, count it
-          completed_count++;
+        } else if (n < SRSRAN_SUCCESS && rf_zmq_rx_is_running(receiver)) {
+          // Other error, exit
+          fprintf(stderr, "Error: receiving data.\n");
+          goto clean_exit;
         }
       }
-
-      // Check if all channels are completed
-      completed = (completed_count == handler->nof_channels);
     }
     rf_zmq_info(handler->id,
                 " - read %d samples. %d samples available\n",
-                NBYTES2NSAMPLES(nbytes),
-                NBYTES2NSAMPLES(srsran_ringbuffer_status(&handler->receiver[0].ringbuffer)));
-
-    // decimate if needed
-    if (decim_factor != 1) {
-      for (uint32_t c = 0; c < handler->nof_channels; c++) {
-        // skip if buffer is not available
-        if (buffers[c]) {
-          cf_t* dst = buffers[c];
-          cf_t* ptr = handler->buffer_decimation[c];
-
-          for (uint32_t i = 0, n = 0; i < nsamples; i++) {
-            // Averaging decimation
-            cf_t avg = 0.0f;
-            for (int j = 0; j < decim_factor; j++, n++) {
-              avg += ptr[n];
-            }
-            dst[i] = avg; // divide by decim_factor later via scale
-          }
-
-          rf_zmq_info(handler->id,
-                      "  - re-adjust bytes due to %dx decimation %d --> %d samples)\n",
-                      decim_factor,
-                      nsamples_baserate,
-                      nsamples);
-        }
-      }
-    }
-
-    // Set gain
-    pthread_mutex_lock(&handler->rx_gain_mutex);
-    float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
-    pthread_mutex_unlock(&handler->rx_gain_mutex);
-    // scale shall also incorporate decim_factor
-    if (decim_factor > 0) {
-      scale = scale / decim_factor;
-    }
-    for (uint32_t c = 0; c < handler->nof_channels; c++) {
-      if (buffers[c]) {
-        srsran_vec_sc_prod_cfc(buffers[c], scale, buffers[c], nsamples);
-      }
-    }
+                nsamples_baserate,
+                srsran_mirror_ringbuffer_status(&handler->receiver[0].ringbuffer) /
+                    rf_zmq_frame_size(handler->receiver[0].sample_format, handler->receiver[0].nof_channels));
 
     // update rx time
     update_ts(handler, &handler->next_rx_ts, nsamples_baserate, "rx");
@@ -938,51 +880,29 @@ int rf_zmq_send_timed_multi(void*  h,
       }
     }
 
-    // Send base-band samples
-    for (int i = 0; i < handler->nof_channels; i++) {
-      if (buffers[i] != NULL) {
-        // Select buffer pointer depending on interpolation
-        cf_t* buf = (decim_factor != 1) ? handler->buffer_tx : buffers[i];
-
-        // Interpolate if required
-        if (decim_factor != 1) {
-          rf_zmq_info(handler->id,
-                      "  - re-adjust bytes due to %dx interpolation %d --> %d samples)\n",
-                      decim_factor,
-                      nsamples,
-                      nsamples_baseband);
-
-          int   n   = 0;
-          cf_t* src = buffers[i];
-          for (int k = 0; k < nsamples; k++) {
-            // perform zero order hold
-            for (int j = 0; j < decim_factor; j++, n++) {
-              buf[n] = src[k];
-            }
-          }
-
-          if (nsamples_baseband != n) {
-            fprintf(stderr,
-                    "Number of tx samples (%d) does not match with number of interpolated samples (%d)\n",
-                    nsamples_baseband,
-                    n);
-            goto clean_exit;
-          }
-        }
+    // Send base-band samples, each stream carries stream_nof_channels consecutive channels
+    uint32_t nof_streams         = handler->interleaved ? 1 : handler->nof_channels;
+    uint32_t stream_nof_channels = handler->nof_channels / nof_streams;
+    for (uint32_t s = 0; s < nof_streams; s++) {
+      cf_t** stream_buffers = &buffers[s * stream_nof_channels];
+      bool   is_zeros       = true;
+      for (uint32_t c = 0; c < stream_nof_channels; c++) {
+        is_zeros &= (stream_buffers[c] == NULL);
+      }
 
-        // Scale according to current gain
-        srsran_vec_sc_prod_cfc(buf, tx_gain, buf, nsamples_baseband);
+      if (decim_factor != 1) {
+        rf_zmq_info(handler->id,
+                    "  - re-adjust bytes due to %dx interpolation %d --> %d samples)\n",
+                    decim_factor,
+                    nsamples,
+                    nsamples_baseband);
+      }
 
-        // Finally, transmit baseband
-        int n = rf_zmq_tx_baseband(&handler->transmitter[i], buf, nsamples_baseband);
-        if (n == SRSRAN_ERROR) {
-          goto clean_exit;
-        }
-      } else {
-        int n = rf_zmq_tx_zeros(&handler->transmitter[i], nsamples_baseband);
-        if (n == SRSRAN_ERROR) {
-          goto clean_exit;
-        }
+      // Interpolate, scale according to current gain and transmit in a single pass
+      int n = is_zeros ? rf_zmq_tx_zeros(&handler->transmitter[s], nsamples_baseband)
+                       : rf_zmq_tx_baseband(&handler->transmitter[s], stream_buffers, nsamples, decim_factor, tx_gain);
+      if (n == SRSRAN_ERROR) {
+        goto clean_exit;
       }
     }
   }
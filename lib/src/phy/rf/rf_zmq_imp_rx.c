@@ -26,17 +26,33 @@
 #include <string.h>
 #include <zmq.h>
 
+// A trx_timeout_ms of 0 waits forever, as with the legacy ring buffer, whereas the mirror ring buffer does not wait
+static int32_t rf_zmq_rx_ringbuffer_timeout(rf_zmq_rx_t* q)
+{
+  return q->trx_timeout_ms == 0 ? -1 : (int32_t)q->trx_timeout_ms;
+}
+
 static void* rf_zmq_async_rx_thread(void* h)
 {
-  rf_zmq_rx_t* q = (rf_zmq_rx_t*)h;
+  rf_zmq_rx_t* q         = (rf_zmq_rx_t*)h;
+  uint32_t     max_bytes = ZMQ_MAX_BUFFER_SIZE * q->nof_channels;
 
   while (q->sock && rf_zmq_rx_is_running(q)) {
     int     nbytes = 0;
     int     n      = SRSRAN_ERROR;
     uint8_t dummy  = 0xFF;
+    void*   ptr    = NULL;
 
     rf_zmq_info(q->id, "-- ASYNC RX wait...\n");
 
+    // Reserve room for the largest message before requesting it, it is received directly into the ring buffer
+    while (ptr == NULL && rf_zmq_rx_is_running(q)) {
+      ptr = srsran_mirror_ringbuffer_write_reserve(&q->ringbuffer, max_bytes, rf_zmq_rx_ringbuffer_timeout(q));
+      if (ptr == NULL && q->log_trx_timeout && rf_zmq_rx_is_running(q)) {
+        fprintf(stderr, "Error: timeout writing samples to ringbuffer after %dms\n", q->trx_timeout_ms);
+      }
+    }
+
     // Send request if socket type is REQUEST
     if (q->socket_type == ZMQ_REQ) {
       while (n < 0 && rf_zmq_rx_is_running(q)) {
@@ -54,16 +70,16 @@ static void* rf_zmq_async_rx_thread(void* h)
 
     // Receive baseband
     for (n = (n < 0) ? 0 : -1; n < 0 && rf_zmq_rx_is_running(q);) {
-      n = zmq_recv(q->sock, q->temp_buffer, ZMQ_MAX_BUFFER_SIZE, 0);
+      n = zmq_recv(q->sock, ptr, max_bytes, 0);
       if (n == -1) {
         if (rf_zmq_handle_error(q->id, "asynchronous rx baseband receive")) {
           return NULL;
         }
 
-      } else if (n > ZMQ_MAX_BUFFER_SIZE) {
+      } else if (n > max_bytes) {
         fprintf(stderr,
-                "[zmq] Error: receiver expected <= %zu bytes and received %d at channel %d.\n",
-                ZMQ_MAX_BUFFER_SIZE,
+                "[zmq] Error: receiver expected <= %d bytes and received %d at channel %d.\n",
+                max_bytes,
                 n,
                 0);
         return NULL;
@@ -72,26 +88,15 @@ static void* rf_zmq_async_rx_thread(void* h)
       }
     }
 
-    // Write received data in buffer
+    // Make the received data available
     if (nbytes > 0) {
-      n = -1;
-
-      // Try to write in ring buffer
-      while (n < 0 && rf_zmq_rx_is_running(q)) {
-        n = srsran_ringbuffer_write_timed(&q->ringbuffer, q->temp_buffer, nbytes, q->trx_timeout_ms);
-        if (n == SRSRAN_ERROR_TIMEOUT && q->log_trx_timeout) {
-          fprintf(stderr, "Error: timeout writing samples to ringbuffer after %dms\n", q->trx_timeout_ms);
-        }
-      }
-
-      // Check write
-      if (nbytes == n) {
-        rf_zmq_info(q->id,
-                    "   - received %d baseband samples (%d B). %d samples available.\n",
-                    NBYTES2NSAMPLES(n),
-                    n,
-                    NBYTES2NSAMPLES(srsran_ringbuffer_status(&q->ringbuffer)));
-      }
+      srsran_mirror_ringbuffer_write_commit(&q->ringbuffer, nbytes);
+      rf_zmq_info(q->id,
+                  "   - received %d baseband samples (%d B). %d samples available.\n",
+                  nbytes / rf_zmq_frame_size(q->sample_format, q->nof_channels),
+                  nbytes,
+                  srsran_mirror_ringbuffer_status(&q->ringbuffer) /
+                      rf_zmq_frame_size(q->sample_format, q->nof_channels));
     }
   }
 
@@ -118,6 +123,7 @@ int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
     }
     q->socket_type        = opts.socket_type;
     q->sample_format      = opts.sample_format;
+    q->nof_channels       = SRSRAN_MAX(opts.nof_channels, 1);
     q->frequency_mhz      = opts.frequency_mhz;
     q->fail_on_disconnect = opts.fail_on_disconnect;
     q->sample_offset      = opts.sample_offset;
@@ -172,21 +178,21 @@ int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       }
     }
 
-    if (srsran_ringbuffer_init(&q->ringbuffer, ZMQ_MAX_BUFFER_SIZE)) {
+    // Twice the largest message, so that a message can be received while the previous one is read
+    if (srsran_mirror_ringbuffer_init(&q->ringbuffer, 2 * ZMQ_MAX_BUFFER_SIZE * q->nof_channels)) {
       fprintf(stderr, "Error: initiating ringbuffer\n");
       goto clean_exit;
     }
 
-    q->temp_buffer = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-    if (!q->temp_buffer) {
-      fprintf(stderr, "Error: allocating rx buffer\n");
-      goto clean_exit;
-    }
-
-    q->temp_buffer_convert = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-    if (!q->temp_buffer_convert) {
-      fprintf(stderr, "Error: allocating rx buffer\n");
-      goto clean_exit;
+    // If the read needs to be delayed, start with zeros
+    if (q->sample_offset > 0) {
+      uint32_t nbytes = q->sample_offset * rf_zmq_frame_size(q->sample_format, q->nof_channels);
+      if (nbytes > ZMQ_MAX_BUFFER_SIZE * q->nof_channels ||
+          srsran_mirror_ringbuffer_write(&q->ringbuffer, NULL, nbytes, 0) != nbytes) {
+        fprintf(stderr, "Error: rx offset of %d samples is too large\n", q->sample_offset);
+        goto clean_exit;
+      }
+      q->sample_offset = 0;
     }
 
     if (pthread_mutex_init(&q->mutex, NULL)) {
@@ -207,47 +213,124 @@ clean_exit:
   return ret;
 }
 
-int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
+/* Read one channel out of the frames, stride values apart, averaging decim_factor consecutive samples. They are inlined
+ * with a constant decim_factor at the base rate, where the loop reduces to a strided copy */
+static inline void rf_zmq_rx_read_fc32(const float* in,
+                                       uint32_t     stride,
+                                       uint32_t     decim_factor,
+                                       float        scale,
+                                       float*       out,
+                                       uint32_t     nsamples)
 {
-  void*    dst_buffer = buffer;
-  uint32_t sample_sz  = sizeof(cf_t);
-  if (q->sample_format != ZMQ_TYPE_FC32) {
-    dst_buffer = q->temp_buffer_convert;
-    sample_sz  = 2 * sizeof(short);
+  for (uint32_t i = 0; i < nsamples; i++) {
+    float re = 0.0f;
+    float im = 0.0f;
+    for (uint32_t j = 0; j < decim_factor; j++, in += stride) {
+      re += in[0];
+      im += in[1];
+    }
+    out[2 * i]     = re * scale;
+    out[2 * i + 1] = im * scale;
   }
+}
 
-  // If the read needs to be delayed
-  while (q->sample_offset > 0) {
-    uint32_t n_offset = SRSRAN_MIN(q->sample_offset, NBYTES2NSAMPLES(ZMQ_MAX_BUFFER_SIZE));
-    srsran_vec_zero(q->temp_buffer, n_offset);
-    int n = srsran_ringbuffer_write(&q->ringbuffer, q->temp_buffer, (int)(n_offset * sample_sz));
-    if (n < SRSRAN_SUCCESS) {
-      return n;
+static inline void rf_zmq_rx_read_sc16(const int16_t* in,
+                                       uint32_t       stride,
+                                       uint32_t       decim_factor,
+                                       float          scale,
+                                       float*         out,
+                                       uint32_t       nsamples)
+{
+  for (uint32_t i = 0; i < nsamples; i++) {
+    float re = 0.0f;
+    float im = 0.0f;
+    for (uint32_t j = 0; j < decim_factor; j++, in += stride) {
+      re += (float)in[0];
+      im += (float)in[1];
     }
-    q->sample_offset -= n_offset;
+    out[2 * i]     = re * scale;
+    out[2 * i + 1] = im * scale;
   }
+}
+
+// Fills the channel buffers from the received samples, in the transport format
+static void rf_zmq_rx_convert(rf_zmq_rx_t* q,
+                              const void*  src,
+                              cf_t**       buffers,
+                              uint32_t     nsamples,
+                              uint32_t     decim_factor,
+                              float        scale)
+{
+  uint32_t nof_channels = q->nof_channels;
+  bool     sc16         = q->sample_format == ZMQ_TYPE_SC16;
+
+  // scale shall also incorporate decim_factor and the sample format
+  scale /= (float)decim_factor;
+  if (sc16) {
+    scale /= INT16_MAX;
+  }
+
+  // A single channel at the base rate maps onto the vector kernels
+  if (nof_channels == 1 && decim_factor == 1) {
+    if (buffers[0] != NULL && sc16) {
+      srsran_vec_convert_if((const int16_t*)src, 1.0f / scale, (float*)buffers[0], 2 * nsamples);
+    } else if (buffers[0] != NULL) {
+      srsran_vec_sc_prod_cfc((const cf_t*)src, scale, buffers[0], nsamples);
+    }
+    return;
+  }
+
+  // Several channels at the base rate are deinterleaved by the vector kernels, which skip the missing buffers
+  if (decim_factor == 1) {
+    if (sc16) {
+      srsran_vec_deinterleave_convert_sc((const int16_t*)src, nof_channels, 1.0f / scale, buffers, nsamples);
+    } else {
+      srsran_vec_deinterleave_sc_prod_cfc((const cf_t*)src, nof_channels, scale, buffers, nsamples);
+    }
+    return;
+  }
+
+  // Otherwise, channel by channel, each one strided over its slot of the frames
+  uint32_t stride = 2 * nof_channels;
+  for (uint32_t c = 0; c < nof_channels; c++) {
+    float* out = (float*)buffers[c];
+    if (out == NULL) {
+      continue;
+    }
+    if (sc16) {
+      rf_zmq_rx_read_sc16((const int16_t*)src + 2 * c, stride, decim_factor, scale, out, nsamples);
+    } else {
+      rf_zmq_rx_read_fc32((const float*)src + 2 * c, stride, decim_factor, scale, out, nsamples);
+    }
+  }
+}
+
+int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t** buffers, uint32_t nsamples, uint32_t decim_factor, float scale)
+{
+  uint32_t frame_size = rf_zmq_frame_size(q->sample_format, q->nof_channels);
+  uint32_t max_frames = ZMQ_MAX_BUFFER_SIZE * q->nof_channels / frame_size;
 
   // If the read needs to be advanced
   while (q->sample_offset < 0) {
-    uint32_t n_offset = SRSRAN_MIN(-q->sample_offset, NBYTES2NSAMPLES(ZMQ_MAX_BUFFER_SIZE));
-    int      n =
-        srsran_ringbuffer_read_timed(&q->ringbuffer, q->temp_buffer, (int)(n_offset * sample_sz), q->trx_timeout_ms);
-    if (n < SRSRAN_SUCCESS) {
-      return n;
+    uint32_t n_offset = SRSRAN_MIN(-q->sample_offset, max_frames);
+    if (srsran_mirror_ringbuffer_read_reserve(&q->ringbuffer, n_offset * frame_size, rf_zmq_rx_ringbuffer_timeout(q)) ==
+        NULL) {
+      return rf_zmq_rx_is_running(q) ? SRSRAN_ERROR_TIMEOUT : SRSRAN_ERROR;
     }
+    srsran_mirror_ringbuffer_read_commit(&q->ringbuffer, n_offset * frame_size);
     q->sample_offset += n_offset;
   }
 
-  int n = srsran_ringbuffer_read_timed(&q->ringbuffer, dst_buffer, sample_sz * nsamples, q->trx_timeout_ms);
-  if (n < 0) {
-    return n;
-  }
-
-  if (q->sample_format == ZMQ_TYPE_SC16) {
-    srsran_vec_convert_if(dst_buffer, INT16_MAX, (float*)buffer, 2 * nsamples);
+  // Convert in place, straight out of the ring buffer
+  uint32_t    nbytes = nsamples * decim_factor * frame_size;
+  const void* src    = srsran_mirror_ringbuffer_read_reserve(&q->ringbuffer, nbytes, rf_zmq_rx_ringbuffer_timeout(q));
+  if (src == NULL) {
+    return rf_zmq_rx_is_running(q) ? SRSRAN_ERROR_TIMEOUT : SRSRAN_ERROR;
   }
+  rf_zmq_rx_convert(q, src, buffers, nsamples, decim_factor, scale);
+  srsran_mirror_ringbuffer_read_commit(&q->ringbuffer, nbytes);
 
-  return n;
+  return (int)nsamples;
 }
 
 bool rf_zmq_rx_match_freq(rf_zmq_rx_t* q, uint32_t freq_hz)
@@ -267,6 +350,11 @@ void rf_zmq_rx_close(rf_zmq_rx_t* q)
   q->running = false;
   pthread_mutex_unlock(&q->mutex);
 
+  // Wake up the thread if it waits for room in the ring buffer
+  if (q->ringbuffer.buffer) {
+    srsran_mirror_ringbuffer_stop(&q->ringbuffer);
+  }
+
   if (q->thread) {
     pthread_join(q->thread, NULL);
     pthread_detach(q->thread);
@@ -274,15 +362,7 @@ void rf_zmq_rx_close(rf_zmq_rx_t* q)
 
   pthread_mutex_destroy(&q->mutex);
 
-  srsran_ringbuffer_free(&q->ringbuffer);
-
-  if (q->temp_buffer) {
-    free(q->temp_buffer);
-  }
-
-  if (q->temp_buffer_convert) {
-    free(q->temp_buffer_convert);
-  }
+  srsran_mirror_ringbuffer_free(&q->ringbuffer);
 
   if (q->sock) {
     zmq_close(q->sock);
@@ -23,7 +23,7 @@
 #define SRSRAN_RF_ZMQ_IMP_TRX_H
 
 #include <pthread.h>
-#include <srsran/phy/utils/ringbuffer.h>
+#include <srsran/phy/utils/mirror_ringbuffer.h>
 #include <stdbool.h>
 
 /* Definitions */
@@ -37,50 +37,61 @@
 #define ZMQ_ID_STRLEN 16
 #define ZMQ_MAX_GAIN_DB (30.0f)
 #define ZMQ_MIN_GAIN_DB (0.0f)
+#define ZMQ_TX_MAX_MSGS (16) // messages handed to ZMQ without copy and not released yet
 
 typedef enum { ZMQ_TYPE_FC32 = 0, ZMQ_TYPE_SC16 } rf_zmq_format_t;
 
 typedef struct {
-  char            id[ZMQ_ID_STRLEN];
-  uint32_t        socket_type;
-  rf_zmq_format_t sample_format;
-  void*           sock;
-  uint64_t        nsamples;
-  bool            running;
-  pthread_mutex_t mutex;
-  cf_t*           zeros;
-  void*           temp_buffer_convert;
-  uint32_t        frequency_mhz;
-  int32_t         sample_offset;
+  uint32_t nbytes;
+  bool     released; ///< set by ZMQ once it no longer reads the message data
+} rf_zmq_tx_msg_t;
+
+typedef struct {
+  char                       id[ZMQ_ID_STRLEN];
+  uint32_t                   socket_type;
+  rf_zmq_format_t            sample_format;
+  uint32_t                   nof_channels; ///< channels interleaved in the stream
+  void*                      sock;
+  uint64_t                   nsamples;
+  bool                       running;
+  pthread_mutex_t            mutex;
+  void*                      zeros;
+  void*                      temp_buffer_convert;
+  srsran_mirror_ringbuffer_t ringbuffer; ///< backs the messages sent without copy
+  rf_zmq_tx_msg_t            msgs[ZMQ_TX_MAX_MSGS];
+  uint32_t                   msgs_head;
+  uint32_t                   nof_msgs;
+  uint32_t                   frequency_mhz;
+  int32_t                    sample_offset;
 } rf_zmq_tx_t;
 
 typedef struct {
   char            id[ZMQ_ID_STRLEN];
   uint32_t        socket_type;
   rf_zmq_format_t sample_format;
+  uint32_t        nof_channels; ///< channels interleaved in the stream
   void*           sock;
 #if ZMQ_MONITOR
   void* socket_monitor;
   bool  tx_connected;
 #endif
-  uint64_t            nsamples;
-  bool                running;
-  pthread_t           thread;
-  pthread_mutex_t     mutex;
-  srsran_ringbuffer_t ringbuffer;
-  cf_t*               temp_buffer;
-  void*               temp_buffer_convert;
-  uint32_t            frequency_mhz;
-  bool                fail_on_disconnect;
-  uint32_t            trx_timeout_ms;
-  bool                log_trx_timeout;
-  int32_t             sample_offset;
+  uint64_t                   nsamples;
+  bool                       running;
+  pthread_t                  thread;
+  pthread_mutex_t            mutex;
+  srsran_mirror_ringbuffer_t ringbuffer; ///< the messages are received directly into it
+  uint32_t                   frequency_mhz;
+  bool                       fail_on_disconnect;
+  uint32_t                   trx_timeout_ms;
+  bool                       log_trx_timeout;
+  int32_t                    sample_offset;
 } rf_zmq_rx_t;
 
 typedef struct {
   const char*     id;
   uint32_t        socket_type;
   rf_zmq_format_t sample_format;
+  uint32_t        nof_channels; ///< channels interleaved in the stream, 1 for one socket per channel
   uint32_t        frequency_mhz;
   bool            fail_on_disconnect;
   uint32_t        trx_timeout_ms;
@@ -91,6 +102,12 @@ typedef struct {
 /*
  * Common functions
  */
+// Size in bytes of one sample of every channel of a stream
+static inline uint32_t rf_zmq_frame_size(rf_zmq_format_t sample_format, uint32_t nof_channels)
+{
+  return nof_channels * (sample_format == ZMQ_TYPE_SC16 ? 2 * sizeof(int16_t) : sizeof(cf_t));
+}
+
 SRSRAN_API void rf_zmq_info(char* id, const char* format, ...);
 
 SRSRAN_API void rf_zmq_error(char* id, const char* format, ...);
@@ -104,7 +121,11 @@ SRSRAN_API int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx,
 
 SRSRAN_API int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts);
 
-SRSRAN_API int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples);
+/* Applies the gain, repeats every sample interp_factor times and interleaves the nof_channels buffers, in a single pass
+ * into the transmitted message. NULL buffers are sent as zeros. nsamples is given at the radio rate. Returns the number
+ * of samples sent at the base rate or SRSRAN_ERROR. */
+SRSRAN_API int
+rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t** buffers, uint32_t nsamples, uint32_t interp_factor, float scale);
 
 SRSRAN_API int rf_zmq_tx_get_nsamples(rf_zmq_tx_t* q);
 
@@ -114,6 +135,9 @@ SRSRAN_API bool rf_zmq_tx_match_freq(rf_zmq_tx_t* q, uint32_t freq_hz);
 
 SRSRAN_API void rf_zmq_tx_close(rf_zmq_tx_t* q);
 
+// releases the message buffers, once the ZMQ context is destroyed and no longer references them
+SRSRAN_API void rf_zmq_tx_free(rf_zmq_tx_t* q);
+
 SRSRAN_API bool rf_zmq_tx_is_running(rf_zmq_tx_t* q);
 
 /*
@@ -121,7 +145,11 @@ SRSRAN_API bool rf_zmq_tx_is_running(rf_zmq_tx_t* q);
  */
 SRSRAN_API int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock_args);
 
-SRSRAN_API int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples);
+/* Receives nsamples at the radio rate and, in a single pass out of the receive buffer, deinterleaves the nof_channels
+ * buffers, averages every decim_factor samples and applies the gain. NULL buffers are skipped. Returns nsamples,
+ * SRSRAN_ERROR_TIMEOUT or SRSRAN_ERROR. */
+SRSRAN_API int
+rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t** buffers, uint32_t nsamples, uint32_t decim_factor, float scale);
 
 SRSRAN_API bool rf_zmq_rx_match_freq(rf_zmq_rx_t* q, uint32_t freq_hz);
 
@@ -21,7 +21,9 @@
 
 #include "rf_zmq_imp_trx.h"
 #include <inttypes.h>
+#include <math.h>
 #include <srsran/config.h>
+#include <srsran/phy/common/phy_common.h>
 #include <srsran/phy/utils/vector.h>
 #include <stdlib.h>
 #include <string.h>
@@ -47,6 +49,7 @@ int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
     }
     q->socket_type   = opts.socket_type;
     q->sample_format = opts.sample_format;
+    q->nof_channels  = SRSRAN_MAX(opts.nof_channels, 1);
     q->frequency_mhz = opts.frequency_mhz;
     q->sample_offset = opts.sample_offset;
 
@@ -82,18 +85,24 @@ int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       goto clean_exit;
     }
 
-    q->temp_buffer_convert = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
+    // Sized for the largest message, holding ZMQ_MAX_BUFFER_SIZE bytes of each channel
+    q->temp_buffer_convert = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE * q->nof_channels);
     if (!q->temp_buffer_convert) {
       fprintf(stderr, "Error: allocating rx buffer\n");
       goto clean_exit;
     }
 
-    q->zeros = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
+    q->zeros = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE * q->nof_channels);
     if (!q->zeros) {
       fprintf(stderr, "Error: allocating zeros\n");
       goto clean_exit;
     }
-    bzero(q->zeros, ZMQ_MAX_BUFFER_SIZE);
+    bzero(q->zeros, ZMQ_MAX_BUFFER_SIZE * q->nof_channels);
+
+    if (srsran_mirror_ringbuffer_init(&q->ringbuffer, 2 * ZMQ_MAX_BUFFER_SIZE * q->nof_channels)) {
+      fprintf(stderr, "Error: initiating ringbuffer\n");
+      goto clean_exit;
+    }
 
     q->running = true;
 
@@ -104,9 +113,75 @@ clean_exit:
   return ret;
 }
 
-static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
+// Called by ZMQ, possibly from its I/O thread, when it no longer needs a message sent without copy
+static void rf_zmq_tx_msg_free(void* data, void* hint)
+{
+  rf_zmq_tx_msg_t* msg = (rf_zmq_tx_msg_t*)hint;
+  __atomic_store_n(&msg->released, true, __ATOMIC_RELEASE);
+}
+
+// Gives the space of the released messages back to the ring buffer. ZMQ may release them out of order (i.e. a PUB
+// socket drops a message on high water mark), so the space is reclaimed in sending order
+static void rf_zmq_tx_reclaim(rf_zmq_tx_t* q)
+{
+  while (q->nof_msgs > 0) {
+    rf_zmq_tx_msg_t* msg = &q->msgs[q->msgs_head];
+    if (!__atomic_load_n(&msg->released, __ATOMIC_ACQUIRE)) {
+      break;
+    }
+    srsran_mirror_ringbuffer_read_commit(&q->ringbuffer, msg->nbytes);
+    q->msgs_head = (q->msgs_head + 1) % ZMQ_TX_MAX_MSGS;
+    q->nof_msgs--;
+  }
+}
+
+// Returns space for nbytes in the ring buffer, or the conversion buffer if ZMQ still holds too much of the ring
+static void* rf_zmq_tx_reserve(rf_zmq_tx_t* q, uint32_t nbytes)
+{
+  rf_zmq_tx_reclaim(q);
+
+  void* ptr = NULL;
+  if (q->nof_msgs < ZMQ_TX_MAX_MSGS) {
+    ptr = srsran_mirror_ringbuffer_write_reserve(&q->ringbuffer, nbytes, 0);
+  }
+  return ptr ? ptr : q->temp_buffer_convert;
+}
+
+// Sends nbytes from buf. Messages reserved in the ring buffer are handed to ZMQ without copy
+static int rf_zmq_tx_send_msg(rf_zmq_tx_t* q, void* buf, uint32_t nbytes)
 {
-  int n = SRSRAN_ERROR;
+  uint8_t* ring_ptr = &q->ringbuffer.buffer[q->ringbuffer.wpm % q->ringbuffer.capacity];
+  if ((uint8_t*)buf < ring_ptr || (uint8_t*)buf + nbytes > ring_ptr + q->ringbuffer.capacity) {
+    return zmq_send(q->sock, buf, (size_t)nbytes, 0);
+  }
+
+  // The message may start after the reserved address, if its first samples were dropped
+  rf_zmq_tx_msg_t* msg = &q->msgs[(q->msgs_head + q->nof_msgs) % ZMQ_TX_MAX_MSGS];
+  msg->nbytes          = (uint32_t)((uint8_t*)buf + nbytes - ring_ptr);
+  msg->released        = false;
+
+  zmq_msg_t zmq_msg;
+  if (zmq_msg_init_data(&zmq_msg, buf, (size_t)nbytes, rf_zmq_tx_msg_free, msg) < 0) {
+    return SRSRAN_ERROR;
+  }
+  int n = zmq_msg_send(&zmq_msg, q->sock, 0);
+  if (n < 0) {
+    // Not sent, closing the message releases it right away
+    zmq_msg_close(&zmq_msg);
+    return n;
+  }
+
+  // ZMQ owns the data until it calls rf_zmq_tx_msg_free()
+  srsran_mirror_ringbuffer_write_commit(&q->ringbuffer, msg->nbytes);
+  q->nof_msgs++;
+  return n;
+}
+
+// Sends nsamples of every channel of the stream, already in the transport format
+static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, void* buffer, uint32_t nsamples)
+{
+  int      n      = SRSRAN_ERROR;
+  uint32_t nbytes = nsamples * rf_zmq_frame_size(q->sample_format, q->nof_channels);
 
   while (n < 0 && q->running) {
     // Receive Transmit request is socket type is REPLY
@@ -121,34 +196,24 @@ static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
       } else {
         // Tx request received successful
         rf_zmq_info(q->id, " - tx request received\n");
-        rf_zmq_info(q->id, " - sending %d samples (%d B)\n", nsamples, NSAMPLES2NBYTES(nsamples));
+        rf_zmq_info(q->id, " - sending %d samples (%d B)\n", nsamples, nbytes);
       }
     } else {
       n = 1;
     }
 
-    // convert samples if necessary
-    void*    buf       = (buffer) ? buffer : q->zeros;
-    uint32_t sample_sz = sizeof(cf_t);
-
-    if (q->sample_format == ZMQ_TYPE_SC16) {
-      buf       = q->temp_buffer_convert;
-      sample_sz = 2 * sizeof(short);
-      srsran_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
-    }
-
     // Send base-band if request was received
     if (n > 0) {
-      n = zmq_send(q->sock, buf, (size_t)sample_sz * nsamples, 0);
+      n = rf_zmq_tx_send_msg(q, buffer, nbytes);
       if (n < 0) {
         if (rf_zmq_handle_error(q->id, "tx baseband send")) {
           n = SRSRAN_ERROR;
           goto clean_exit;
         }
-      } else if (n != NSAMPLES2NBYTES(nsamples)) {
+      } else if (n != nbytes) {
         rf_zmq_error(q->id,
                      "[zmq] Error: transmitter expected %d bytes and sent %d. %s.\n",
-                     NSAMPLES2NBYTES(nsamples),
+                     nbytes,
                      n,
                      strerror(zmq_errno()));
         n = SRSRAN_ERROR;
@@ -167,6 +232,93 @@ clean_exit:
   return n;
 }
 
+/* Write one channel into its slot of the frames, stride values apart, holding each sample for interp_factor frames.
+ * They are inlined with a constant interp_factor at the base rate, where the loop reduces to a strided copy */
+static inline void rf_zmq_tx_write_fc32(const float* in,
+                                        uint32_t     nsamples,
+                                        uint32_t     interp_factor,
+                                        float        scale,
+                                        float*       out,
+                                        uint32_t     stride)
+{
+  for (uint32_t i = 0; i < nsamples; i++) {
+    float re = in[2 * i] * scale;
+    float im = in[2 * i + 1] * scale;
+    for (uint32_t j = 0; j < interp_factor; j++, out += stride) {
+      out[0] = re;
+      out[1] = im;
+    }
+  }
+}
+
+static inline void rf_zmq_tx_write_sc16(const float* in,
+                                        uint32_t     nsamples,
+                                        uint32_t     interp_factor,
+                                        float        scale,
+                                        int16_t*     out,
+                                        uint32_t     stride)
+{
+  for (uint32_t i = 0; i < nsamples; i++) {
+    int16_t re = (int16_t)lrintf(in[2 * i] * scale);
+    int16_t im = (int16_t)lrintf(in[2 * i + 1] * scale);
+    for (uint32_t j = 0; j < interp_factor; j++, out += stride) {
+      out[0] = re;
+      out[1] = im;
+    }
+  }
+}
+
+// Fills dst with the interleaved, scaled and interpolated channels, in the transport format
+static void rf_zmq_tx_convert(rf_zmq_tx_t* q,
+                              cf_t**       buffers,
+                              uint32_t     nsamples,
+                              uint32_t     interp_factor,
+                              float        scale,
+                              void*        dst)
+{
+  uint32_t nof_channels = q->nof_channels;
+  bool     sc16         = q->sample_format == ZMQ_TYPE_SC16;
+  if (sc16) {
+    scale *= INT16_MAX;
+  }
+
+  // A single channel at the base rate maps onto the vector kernels
+  if (nof_channels == 1 && interp_factor == 1 && buffers[0] != NULL) {
+    if (sc16) {
+      srsran_vec_convert_fi((const float*)buffers[0], scale, (int16_t*)dst, 2 * nsamples);
+    } else {
+      srsran_vec_sc_prod_cfc(buffers[0], scale, (cf_t*)dst, nsamples);
+    }
+    return;
+  }
+
+  // Missing channels read from the zeros, which are at least nsamples long
+  cf_t* in[SRSRAN_MAX_CHANNELS] = {};
+  for (uint32_t c = 0; c < nof_channels; c++) {
+    in[c] = buffers[c] ? buffers[c] : (cf_t*)q->zeros;
+  }
+
+  // Several channels at the base rate are interleaved by the vector kernels
+  if (interp_factor == 1) {
+    if (sc16) {
+      srsran_vec_interleave_convert_cs(in, nof_channels, scale, (int16_t*)dst, nsamples);
+    } else {
+      srsran_vec_interleave_sc_prod_cfc(in, nof_channels, scale, (cf_t*)dst, nsamples);
+    }
+    return;
+  }
+
+  // Otherwise, channel by channel, each one strided over its slot of the frames
+  uint32_t stride = 2 * nof_channels;
+  for (uint32_t c = 0; c < nof_channels; c++) {
+    if (sc16) {
+      rf_zmq_tx_write_sc16((const float*)in[c], nsamples, interp_factor, scale, (int16_t*)dst + 2 * c, stride);
+    } else {
+      rf_zmq_tx_write_fc32((const float*)in[c], nsamples, interp_factor, scale, (float*)dst + 2 * c, stride);
+    }
+  }
+}
+
 int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
 {
   pthread_mutex_lock(&q->mutex);
@@ -183,26 +335,30 @@ int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
   return (int)nsamples;
 }
 
-int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
+int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t** buffers, uint32_t nsamples, uint32_t interp_factor, float scale)
 {
-  int n;
+  int n = SRSRAN_SUCCESS;
 
   pthread_mutex_lock(&q->mutex);
 
+  uint32_t frame_size        = rf_zmq_frame_size(q->sample_format, q->nof_channels);
+  uint32_t nsamples_baserate = nsamples * interp_factor;
+  uint8_t* buf               = rf_zmq_tx_reserve(q, nsamples_baserate * frame_size);
+  rf_zmq_tx_convert(q, buffers, nsamples, interp_factor, scale, buf);
+
   if (q->sample_offset > 0) {
     _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)q->sample_offset);
     q->sample_offset = 0;
   } else if (q->sample_offset < 0) {
-    n = SRSRAN_MIN(-q->sample_offset, nsamples);
-    buffer += n;
-    nsamples -= n;
+    n = SRSRAN_MIN(-q->sample_offset, nsamples_baserate);
+    buf += n * frame_size;
+    nsamples_baserate -= n;
     q->sample_offset += n;
-    if (nsamples == 0) {
-      return n;
-    }
   }
 
-  n = _rf_zmq_tx_baseband(q, buffer, nsamples);
+  if (nsamples_baserate > 0) {
+    n = _rf_zmq_tx_baseband(q, buf, nsamples_baserate);
+  }
 
   pthread_mutex_unlock(&q->mutex);
 
@@ -260,6 +416,11 @@ void rf_zmq_tx_close(rf_zmq_tx_t* q)
   }
 }
 
+void rf_zmq_tx_free(rf_zmq_tx_t* q)
+{
+  srsran_mirror_ringbuffer_free(&q->ringbuffer);
+}
+
 bool rf_zmq_tx_is_running(rf_zmq_tx_t* q)
 {
   if (!q) {
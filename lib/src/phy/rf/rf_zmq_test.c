@@ -315,5 +315,13 @@ int main()
     return -1;
   }
 
+  // 4 trx radios interleaved in a single stream per direction, with timed tx and decimation 23.04e6 <-> 1.92e6
+  if (run_test("tx_port=tcp://*:5554,rx_port=ipc://dl0,id=ue,base_srate=23.04e6,interleaved=true",
+               "rx_port=tcp://localhost:5554,tx_port=ipc://dl0,id=enb,base_srate=23.04e6,interleaved=true",
+               true) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Interleaved multi TRx radio test with timed tx and decimation failed!\n");
+    return -1;
+  }
+
   return SRSRAN_SUCCESS;
 }
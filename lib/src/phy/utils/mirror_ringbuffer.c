@@ -0,0 +1,274 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/mirror_ringbuffer.h"
+#include "srsran/phy/utils/vector.h"
+
+// Creates an anonymous file of the given size, which is only referenced by the returned descriptor
+static int create_backing_file(uint32_t size)
+{
+#ifdef MFD_CLOEXEC
+  int fd = memfd_create("srsran_ringbuffer", MFD_CLOEXEC);
+#else
+  char path[] = "/dev/shm/srsran_ringbuffer_XXXXXX";
+  int  fd     = mkstemp(path);
+  if (fd >= 0) {
+    unlink(path);
+  }
+#endif
+  if (fd < 0) {
+    ERROR("Error creating ring buffer backing file: %s", strerror(errno));
+    return SRSRAN_ERROR;
+  }
+  if (ftruncate(fd, size) < 0) {
+    ERROR("Error sizing ring buffer backing file: %s", strerror(errno));
+    close(fd);
+    return SRSRAN_ERROR;
+  }
+  return fd;
+}
+
+// Maps the same size bytes twice, back to back. Returns NULL on error
+static uint8_t* map_mirrored(uint32_t size)
+{
+  int fd = create_backing_file(size);
+  if (fd < 0) {
+    return NULL;
+  }
+
+  // Reserve the address range first, so that both views can be placed at fixed addresses
+  uint8_t* base = mmap(NULL, 2 * (size_t)size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    ERROR("Error reserving ring buffer address range: %s", strerror(errno));
+    close(fd);
+    return NULL;
+  }
+  if (mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+      mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+    ERROR("Error mapping ring buffer: %s", strerror(errno));
+    munmap(base, 2 * (size_t)size);
+    close(fd);
+    return NULL;
+  }
+
+  // The mappings keep the file alive
+  close(fd);
+  return base;
+}
+
+int srsran_mirror_ringbuffer_init(srsran_mirror_ringbuffer_t* q, uint32_t capacity)
+{
+  if (q == NULL || capacity == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  bzero(q, sizeof(srsran_mirror_ringbuffer_t));
+
+  uint32_t page_size = (uint32_t)sysconf(_SC_PAGESIZE);
+  q->capacity        = SRSRAN_CEIL(capacity, page_size) * page_size;
+  q->buffer          = map_mirrored(q->capacity);
+  if (q->buffer == NULL) {
+    q->capacity = 0;
+    return SRSRAN_ERROR;
+  }
+  q->active = true;
+  pthread_mutex_init(&q->mutex, NULL);
+  pthread_cond_init(&q->cvar, NULL);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_mirror_ringbuffer_free(srsran_mirror_ringbuffer_t* q)
+{
+  if (q == NULL || q->buffer == NULL) {
+    return;
+  }
+  srsran_mirror_ringbuffer_stop(q);
+  munmap(q->buffer, 2 * (size_t)q->capacity);
+  q->buffer = NULL;
+  pthread_mutex_destroy(&q->mutex);
+  pthread_cond_destroy(&q->cvar);
+}
+
+void srsran_mirror_ringbuffer_reset(srsran_mirror_ringbuffer_t* q)
+{
+  __atomic_store_n(&q->wpm, 0, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&q->rpm, 0, __ATOMIC_SEQ_CST);
+}
+
+uint32_t srsran_mirror_ringbuffer_status(srsran_mirror_ringbuffer_t* q)
+{
+  // Sequentially consistent, as required by the handshake in wait_for()
+  uint64_t rpm = __atomic_load_n(&q->rpm, __ATOMIC_SEQ_CST);
+  uint64_t wpm = __atomic_load_n(&q->wpm, __ATOMIC_SEQ_CST);
+  return (uint32_t)(wpm - rpm);
+}
+
+uint32_t srsran_mirror_ringbuffer_space(srsran_mirror_ringbuffer_t* q)
+{
+  return q->capacity - srsran_mirror_ringbuffer_status(q);
+}
+
+static bool is_active(srsran_mirror_ringbuffer_t* q)
+{
+  return __atomic_load_n(&q->active, __ATOMIC_ACQUIRE);
+}
+
+static bool can_write(srsran_mirror_ringbuffer_t* q, uint32_t nof_bytes)
+{
+  return srsran_mirror_ringbuffer_space(q) >= nof_bytes;
+}
+
+static bool can_read(srsran_mirror_ringbuffer_t* q, uint32_t nof_bytes)
+{
+  return srsran_mirror_ringbuffer_status(q) >= nof_bytes;
+}
+
+/* Slow path of the reserve functions. The waiting side announces itself in nof_waiting before loading the positions
+ * again, and the other side loads nof_waiting after storing its position. All four accesses are sequentially
+ * consistent, so either the waiter sees the new position or the committer sees the waiter and signals it under the
+ * mutex. A positive timeout_ms bounds the wait and a negative one waits forever. The callers never get here with 0,
+ * which means non-blocking (not wait forever, as in srsran_ringbuffer_t). */
+static bool wait_for(srsran_mirror_ringbuffer_t* q,
+                     bool (*ready)(srsran_mirror_ringbuffer_t*, uint32_t),
+                     uint32_t nof_bytes,
+                     int32_t  timeout_ms)
+{
+  struct timespec towait = {0, 0};
+  if (timeout_ms > 0) {
+    clock_gettime(CLOCK_REALTIME, &towait);
+    long nsec = towait.tv_nsec + (timeout_ms % 1000L) * 1000000L;
+    towait.tv_sec += timeout_ms / 1000L + nsec / 1000000000L;
+    towait.tv_nsec = nsec % 1000000000L;
+  }
+
+  int ret = 0;
+  pthread_mutex_lock(&q->mutex);
+  __atomic_add_fetch(&q->nof_waiting, 1, __ATOMIC_SEQ_CST);
+  while (!ready(q, nof_bytes) && is_active(q) && ret == 0) {
+    if (timeout_ms > 0) {
+      ret = pthread_cond_timedwait(&q->cvar, &q->mutex, &towait);
+    } else {
+      pthread_cond_wait(&q->cvar, &q->mutex);
+    }
+  }
+  __atomic_sub_fetch(&q->nof_waiting, 1, __ATOMIC_SEQ_CST);
+  pthread_mutex_unlock(&q->mutex);
+
+  return is_active(q) && ready(q, nof_bytes);
+}
+
+static void notify(srsran_mirror_ringbuffer_t* q)
+{
+  if (__atomic_load_n(&q->nof_waiting, __ATOMIC_SEQ_CST) > 0) {
+    pthread_mutex_lock(&q->mutex);
+    pthread_cond_broadcast(&q->cvar);
+    pthread_mutex_unlock(&q->mutex);
+  }
+}
+
+void* srsran_mirror_ringbuffer_write_reserve(srsran_mirror_ringbuffer_t* q, uint32_t nof_bytes, int32_t timeout_ms)
+{
+  if (q == NULL || q->buffer == NULL || nof_bytes > q->capacity) {
+    ERROR("Invalid inputs");
+    return NULL;
+  }
+  if (!is_active(q)) {
+    return NULL;
+  }
+  if (!can_write(q, nof_bytes) && (timeout_ms == 0 || !wait_for(q, can_write, nof_bytes, timeout_ms))) {
+    return NULL;
+  }
+  // Only the writer modifies wpm
+  return &q->buffer[q->wpm % q->capacity];
+}
+
+void srsran_mirror_ringbuffer_write_commit(srsran_mirror_ringbuffer_t* q, uint32_t nof_bytes)
+{
+  __atomic_store_n(&q->wpm, q->wpm + nof_bytes, __ATOMIC_SEQ_CST);
+  notify(q);
+}
+
+void* srsran_mirror_ringbuffer_read_reserve(srsran_mirror_ringbuffer_t* q, uint32_t nof_bytes, int32_t timeout_ms)
+{
+  if (q == NULL || q->buffer == NULL || nof_bytes > q->capacity) {
+    ERROR("Invalid inputs");
+    return NULL;
+  }
+  if (!is_active(q)) {
+    return NULL;
+  }
+  if (!can_read(q, nof_bytes) && (timeout_ms == 0 || !wait_for(q, can_read, nof_bytes, timeout_ms))) {
+    return NULL;
+  }
+  // Only the reader modifies rpm
+  return &q->buffer[q->rpm % q->capacity];
+}
+
+void srsran_mirror_ringbuffer_read_commit(srsran_mirror_ringbuffer_t* q, uint32_t nof_bytes)
+{
+  __atomic_store_n(&q->rpm, q->rpm + nof_bytes, __ATOMIC_SEQ_CST);
+  notify(q);
+}
+
+int srsran_mirror_ringbuffer_write(srsran_mirror_ringbuffer_t* q,
+                                   const void*                 ptr,
+                                   uint32_t                    nof_bytes,
+                                   int32_t                     timeout_ms)
+{
+  uint8_t* dst = srsran_mirror_ringbuffer_write_reserve(q, nof_bytes, timeout_ms);
+  if (dst == NULL) {
+    return (q != NULL && q->buffer != NULL && is_active(q)) ? SRSRAN_ERROR_TIMEOUT : SRSRAN_SUCCESS;
+  }
+  if (ptr != NULL) {
+    memcpy(dst, ptr, nof_bytes);
+  } else {
+    memset(dst, 0, nof_bytes);
+  }
+  srsran_mirror_ringbuffer_write_commit(q, nof_bytes);
+  return (int)nof_bytes;
+}
+
+int srsran_mirror_ringbuffer_read(srsran_mirror_ringbuffer_t* q, void* ptr, uint32_t nof_bytes, int32_t timeout_ms)
+{
+  uint8_t* src = srsran_mirror_ringbuffer_read_reserve(q, nof_bytes, timeout_ms);
+  if (src == NULL) {
+    return (q != NULL && q->buffer != NULL && is_active(q)) ? SRSRAN_ERROR_TIMEOUT : SRSRAN_SUCCESS;
+  }
+  memcpy(ptr, src, nof_bytes);
+  srsran_mirror_ringbuffer_read_commit(q, nof_bytes);
+  return (int)nof_bytes;
+}
+
+void srsran_mirror_ringbuffer_stop(srsran_mirror_ringbuffer_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  __atomic_store_n(&q->active, false, __ATOMIC_SEQ_CST);
+  pthread_cond_broadcast(&q->cvar);
+  pthread_mutex_unlock(&q->mutex);
+}
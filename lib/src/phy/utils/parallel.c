@@ -0,0 +1,221 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/parallel.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+  pthread_t              pthread;
+  srsran_parallel_for_t* q;
+  uint32_t               idx;
+  bool                   started;
+} parallel_worker_t;
+
+/* One run, allocated in the stack of the issuing thread. It stays in the job list of the object until all its tasks
+ * have been taken, and the issuing thread waits for the last one of them to finish before returning. */
+typedef struct parallel_job_s {
+  srsran_parallel_task_t task;
+  void*                  task_arg;
+  uint32_t               nof_tasks;
+  uint32_t               next_task;
+  uint32_t               nof_finished;
+  pthread_cond_t         finished;
+  struct parallel_job_s* next;
+} parallel_job_t;
+
+// Takes the next task of job, unlinking it once all its tasks are taken. It shall be called with the mutex locked
+static uint32_t parallel_job_take(srsran_parallel_for_t* q, parallel_job_t* job)
+{
+  uint32_t task_idx = job->next_task++;
+  if (job->next_task == job->nof_tasks) {
+    parallel_job_t** it = (parallel_job_t**)&q->jobs;
+    while (*it != job) {
+      it = &(*it)->next;
+    }
+    *it = job->next;
+  }
+  return task_idx;
+}
+
+// Executes task_idx of job and signals the issuing thread if it was the last one
+static void parallel_job_execute(srsran_parallel_for_t* q, parallel_job_t* job, uint32_t worker_idx, uint32_t task_idx)
+{
+  job->task(job->task_arg, worker_idx, task_idx);
+
+  pthread_mutex_lock(&q->mutex);
+  if (++job->nof_finished == job->nof_tasks) {
+    pthread_cond_signal(&job->finished);
+  }
+  pthread_mutex_unlock(&q->mutex);
+}
+
+static void* parallel_for_thread(void* arg)
+{
+  parallel_worker_t*     w = (parallel_worker_t*)arg;
+  srsran_parallel_for_t* q = w->q;
+
+  pthread_mutex_lock(&q->mutex);
+  while (!q->quit) {
+    parallel_job_t* job = (parallel_job_t*)q->jobs;
+    if (job == NULL) {
+      /* Wait for next job */
+      pthread_cond_wait(&q->cvar, &q->mutex);
+      continue;
+    }
+    uint32_t task_idx = parallel_job_take(q, job);
+    pthread_mutex_unlock(&q->mutex);
+
+    parallel_job_execute(q, job, w->idx, task_idx);
+
+    pthread_mutex_lock(&q->mutex);
+  }
+  pthread_mutex_unlock(&q->mutex);
+
+  return NULL;
+}
+
+int srsran_parallel_for_init(srsran_parallel_for_t* q, uint32_t nof_threads)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  memset(q, 0, sizeof(srsran_parallel_for_t));
+
+  if (pthread_mutex_init(&q->mutex, NULL)) {
+    ERROR("Creating mutex");
+    return SRSRAN_ERROR;
+  }
+  if (pthread_cond_init(&q->cvar, NULL)) {
+    ERROR("Creating condition variable");
+    pthread_mutex_destroy(&q->mutex);
+    return SRSRAN_ERROR;
+  }
+  q->nof_threads = 1;
+
+  if (nof_threads <= 1) {
+    return SRSRAN_SUCCESS;
+  }
+
+  parallel_worker_t* workers = calloc(nof_threads - 1, sizeof(parallel_worker_t));
+  if (workers == NULL) {
+    ERROR("Allocating parallel workers");
+    srsran_parallel_for_free(q);
+    return SRSRAN_ERROR;
+  }
+  q->workers = workers;
+
+  for (uint32_t i = 0; i < nof_threads - 1; i++) {
+    parallel_worker_t* w = &workers[i];
+    w->q                 = q;
+    w->idx               = i + 1;
+
+    if (pthread_create(&w->pthread, NULL, parallel_for_thread, (void*)w)) {
+      ERROR("Creating parallel worker thread");
+      srsran_parallel_for_free(q);
+      return SRSRAN_ERROR;
+    }
+    w->started = true;
+    q->nof_threads++;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_parallel_for_free(srsran_parallel_for_t* q)
+{
+  // Ignore objects that were not initialised
+  if (q == NULL || q->nof_threads == 0) {
+    return;
+  }
+
+  parallel_worker_t* workers = (parallel_worker_t*)q->workers;
+  if (workers) {
+    /* Stop threads */
+    pthread_mutex_lock(&q->mutex);
+    q->quit = true;
+    pthread_cond_broadcast(&q->cvar);
+    pthread_mutex_unlock(&q->mutex);
+    for (uint32_t i = 0; i < q->nof_threads - 1; i++) {
+      if (workers[i].started) {
+        pthread_join(workers[i].pthread, NULL);
+      }
+    }
+    free(workers);
+  }
+
+  pthread_cond_destroy(&q->cvar);
+  pthread_mutex_destroy(&q->mutex);
+  memset(q, 0, sizeof(srsran_parallel_for_t));
+}
+
+void srsran_parallel_for_run(srsran_parallel_for_t* q, uint32_t nof_tasks, srsran_parallel_task_t task, void* arg)
+{
+  if (q == NULL || task == NULL || nof_tasks == 0) {
+    return;
+  }
+
+  parallel_job_t job = {};
+  job.task           = task;
+  job.task_arg       = arg;
+  job.nof_tasks      = nof_tasks;
+  pthread_cond_init(&job.finished, NULL);
+
+  // With a single task or no auxiliary threads, nobody else takes tasks from the job and it is not listed
+  bool shared = q->nof_threads > 1 && nof_tasks > 1;
+
+  pthread_mutex_lock(&q->mutex);
+  if (shared) {
+    // Append the job, so that runs issued earlier are served first
+    parallel_job_t** it = (parallel_job_t**)&q->jobs;
+    while (*it != NULL) {
+      it = &(*it)->next;
+    }
+    *it = &job;
+
+    // Do not wake up more threads than tasks
+    uint32_t nof_helpers = SRSRAN_MIN(q->nof_threads, nof_tasks) - 1;
+    for (uint32_t i = 0; i < nof_helpers; i++) {
+      pthread_cond_signal(&q->cvar);
+    }
+  }
+
+  // The calling thread executes the tasks of its own run only
+  while (job.next_task < job.nof_tasks) {
+    uint32_t task_idx = shared ? parallel_job_take(q, &job) : job.next_task++;
+    pthread_mutex_unlock(&q->mutex);
+
+    parallel_job_execute(q, &job, 0, task_idx);
+
+    pthread_mutex_lock(&q->mutex);
+  }
+
+  // Join
+  while (job.nof_finished < job.nof_tasks) {
+    pthread_cond_wait(&job.finished, &q->mutex);
+  }
+  pthread_mutex_unlock(&q->mutex);
+
+  pthread_cond_destroy(&job.finished);
+}
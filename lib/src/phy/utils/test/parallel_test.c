@@ -0,0 +1,147 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/parallel.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/support/srsran_test.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_TASKS 256
+#define MAX_THREADS 8
+
+typedef struct {
+  uint32_t count[MAX_TASKS];
+  uint32_t worker[MAX_TASKS];
+  uint32_t nof_threads;
+  pthread_t caller;
+  bool      wrong_caller;
+} test_args_t;
+
+static void test_task(void* arg, uint32_t worker_idx, uint32_t task_idx)
+{
+  test_args_t* args = (test_args_t*)arg;
+  args->count[task_idx]++;
+  args->worker[task_idx] = worker_idx;
+
+  // Worker 0 is always the thread that issued the run
+  if (worker_idx == 0 && !pthread_equal(pthread_self(), args->caller)) {
+    args->wrong_caller = true;
+  }
+}
+
+static int test_parallel_for(uint32_t nof_threads, uint32_t nof_tasks, uint32_t nof_repetitions)
+{
+  srsran_parallel_for_t parallel;
+  TESTASSERT(srsran_parallel_for_init(&parallel, nof_threads) == SRSRAN_SUCCESS);
+  TESTASSERT(parallel.nof_threads == SRSRAN_MAX(nof_threads, 1));
+
+  test_args_t args = {};
+  args.caller      = pthread_self();
+  for (uint32_t n = 0; n < nof_repetitions; n++) {
+    srsran_parallel_for_run(&parallel, nof_tasks, test_task, &args);
+
+    // Every task shall be executed exactly once per run, by a valid worker
+    TESTASSERT(!args.wrong_caller);
+    for (uint32_t i = 0; i < nof_tasks; i++) {
+      TESTASSERT(args.count[i] == n + 1);
+      TESTASSERT(args.worker[i] < parallel.nof_threads);
+    }
+  }
+
+  // Tasks out of range are never touched
+  for (uint32_t i = nof_tasks; i < MAX_TASKS; i++) {
+    TESTASSERT(args.count[i] == 0);
+  }
+
+  srsran_parallel_for_free(&parallel);
+  return SRSRAN_SUCCESS;
+}
+
+typedef struct {
+  srsran_parallel_for_t* parallel;
+  test_args_t            args;
+  uint32_t               nof_tasks;
+  uint32_t               nof_repetitions;
+} concurrent_caller_t;
+
+static void* concurrent_caller(void* arg)
+{
+  concurrent_caller_t* c = (concurrent_caller_t*)arg;
+  c->args.caller         = pthread_self();
+  for (uint32_t n = 0; n < c->nof_repetitions; n++) {
+    srsran_parallel_for_run(c->parallel, c->nof_tasks, test_task, &c->args);
+  }
+  return NULL;
+}
+
+// Several threads issue runs on the same object at the same time, each of them shall only see its own tasks
+static int test_parallel_for_concurrent(uint32_t nof_threads, uint32_t nof_callers, uint32_t nof_tasks)
+{
+  srsran_parallel_for_t parallel;
+  TESTASSERT(srsran_parallel_for_init(&parallel, nof_threads) == SRSRAN_SUCCESS);
+
+  concurrent_caller_t callers[MAX_THREADS] = {};
+  pthread_t           threads[MAX_THREADS];
+  for (uint32_t i = 0; i < nof_callers; i++) {
+    callers[i].parallel        = &parallel;
+    callers[i].nof_tasks       = nof_tasks;
+    callers[i].nof_repetitions = 100;
+    TESTASSERT(pthread_create(&threads[i], NULL, concurrent_caller, &callers[i]) == 0);
+  }
+
+  for (uint32_t i = 0; i < nof_callers; i++) {
+    TESTASSERT(pthread_join(threads[i], NULL) == 0);
+    TESTASSERT(!callers[i].args.wrong_caller);
+    for (uint32_t j = 0; j < MAX_TASKS; j++) {
+      TESTASSERT(callers[i].args.count[j] == (j < nof_tasks ? callers[i].nof_repetitions : 0));
+    }
+  }
+
+  srsran_parallel_for_free(&parallel);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  const uint32_t nof_tasks_list[] = {1, 2, 7, 64, MAX_TASKS};
+
+  for (uint32_t nof_threads = 0; nof_threads <= MAX_THREADS; nof_threads++) {
+    for (uint32_t i = 0; i < sizeof(nof_tasks_list) / sizeof(nof_tasks_list[0]); i++) {
+      if (test_parallel_for(nof_threads, nof_tasks_list[i], 20) < SRSRAN_SUCCESS) {
+        printf("Failed nof_threads=%d; nof_tasks=%d;\n", nof_threads, nof_tasks_list[i]);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  for (uint32_t nof_callers = 2; nof_callers <= 4; nof_callers++) {
+    if (test_parallel_for_concurrent(4, nof_callers, 64) < SRSRAN_SUCCESS) {
+      printf("Failed concurrent runs nof_callers=%d;\n", nof_callers);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
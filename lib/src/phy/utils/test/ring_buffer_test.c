@@ -30,6 +30,7 @@
 #include <time.h>
 #include <unistd.h>
 
+#include "srsran/phy/utils/mirror_ringbuffer.h"
 #include "srsran/phy/utils/ringbuffer.h"
 #include "srsran/phy/utils/vector.h"
 
@@ -41,6 +42,14 @@ struct thread_args_t {
   int                  res;
 };
 
+struct mirror_thread_args_t {
+  int                         len;
+  uint8_t*                    in;
+  uint8_t*                    out;
+  srsran_mirror_ringbuffer_t* buf;
+  int                         res;
+};
+
 int N = 200;
 int M = 10;
 
@@ -151,6 +160,109 @@ int threaded_blocking_test(struct thread_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
+int test_mirror_wrap_read_write(srsran_mirror_ringbuffer_t* q, uint8_t* in, uint8_t* out, int len)
+{
+  // Move the positions so that the next block straddles the end of the buffer
+  uint32_t offset = q->capacity - len / 2;
+  TESTASSERT(srsran_mirror_ringbuffer_write(q, NULL, offset, 0) == offset);
+  TESTASSERT(srsran_mirror_ringbuffer_read_reserve(q, offset, 0) != NULL);
+  srsran_mirror_ringbuffer_read_commit(q, offset);
+
+  uint8_t* wptr = srsran_mirror_ringbuffer_write_reserve(q, len, 0);
+  TESTASSERT(wptr == q->buffer + offset);
+  memcpy(wptr, in, len);
+  srsran_mirror_ringbuffer_write_commit(q, len);
+  TESTASSERT(srsran_mirror_ringbuffer_status(q) == len);
+
+  // The second half of the block was written through the mirror into the start of the buffer
+  TESTASSERT(!memcmp(q->buffer, &in[len / 2], len - len / 2));
+
+  uint8_t* rptr = srsran_mirror_ringbuffer_read_reserve(q, len, 0);
+  TESTASSERT(rptr == wptr);
+  TESTASSERT(!memcmp(rptr, in, len));
+  srsran_mirror_ringbuffer_read_commit(q, len);
+
+  // Copying reads and writes across the wrap
+  for (int i = 0; i < 3; i++) {
+    TESTASSERT(srsran_mirror_ringbuffer_write(q, in, len, 0) == len);
+    TESTASSERT(srsran_mirror_ringbuffer_read(q, out, len, 0) == len);
+    TESTASSERT(!memcmp(in, out, len));
+  }
+  TESTASSERT(srsran_mirror_ringbuffer_status(q) == 0);
+  return 0;
+}
+
+int test_mirror_timeout(srsran_mirror_ringbuffer_t* q, uint8_t* in, uint8_t* out, int len)
+{
+  TESTASSERT(srsran_mirror_ringbuffer_read_reserve(q, len, 0) == NULL);
+  TESTASSERT(srsran_mirror_ringbuffer_read(q, out, len, 10) == SRSRAN_ERROR_TIMEOUT);
+
+  // Fill the buffer, the next write must overflow
+  TESTASSERT(srsran_mirror_ringbuffer_write(q, NULL, q->capacity, 0) == q->capacity);
+  TESTASSERT(srsran_mirror_ringbuffer_space(q) == 0);
+  TESTASSERT(srsran_mirror_ringbuffer_write_reserve(q, 1, 0) == NULL);
+  TESTASSERT(srsran_mirror_ringbuffer_write(q, in, len, 10) == SRSRAN_ERROR_TIMEOUT);
+  return 0;
+}
+
+void* mirror_write_thread(void* args_)
+{
+  struct mirror_thread_args_t* args = (struct mirror_thread_args_t*)args_;
+  for (int i = 0; i < M; i++) {
+    uint8_t* ptr = srsran_mirror_ringbuffer_write_reserve(args->buf, args->len, -1);
+    if (ptr == NULL) {
+      args->res = SRSRAN_ERROR;
+      return NULL;
+    }
+    memcpy(ptr, args->in, args->len);
+    srsran_mirror_ringbuffer_write_commit(args->buf, args->len);
+  }
+  return NULL;
+}
+
+void* mirror_read_thread(void* args_)
+{
+  struct mirror_thread_args_t* args = (struct mirror_thread_args_t*)args_;
+  for (int i = 0; i < M; i++) {
+    uint8_t* ptr = srsran_mirror_ringbuffer_read_reserve(args->buf, args->len, -1);
+    if (ptr == NULL) {
+      args->res = SRSRAN_ERROR;
+      return NULL;
+    }
+    memcpy(&args->out[args->len * i], ptr, args->len);
+    srsran_mirror_ringbuffer_read_commit(args->buf, args->len);
+  }
+  return NULL;
+}
+
+int mirror_threaded_blocking_test(struct mirror_thread_args_t* args)
+{
+  // The buffer holds all the blocks, so start the reader first to make it wait for the writer
+  pthread_t threads[2];
+  if (pthread_create(&threads[0], NULL, mirror_read_thread, args)) {
+    fprintf(stderr, "Error creating thread\n");
+    return SRSRAN_ERROR;
+  }
+  usleep(10000);
+  if (pthread_create(&threads[1], NULL, mirror_write_thread, args)) {
+    fprintf(stderr, "Error creating thread\n");
+    return SRSRAN_ERROR;
+  }
+
+  for (int i = 0; i < 2; i++) {
+    if (pthread_join(threads[i], NULL)) {
+      fprintf(stderr, "Error joining thread\n");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  for (int i = 0; i < M; i++) {
+    TESTASSERT(!memcmp(args->in, &args->out[args->len * i], args->len));
+  }
+
+  return args->res;
+}
+
 int main(int argc, char** argv)
 {
   int ret = SRSRAN_SUCCESS;
@@ -192,6 +304,33 @@ int main(int argc, char** argv)
   }
   srsran_ringbuffer_stop(&ring_buf);
   srsran_ringbuffer_free(&ring_buf);
+
+  srsran_mirror_ringbuffer_t mirror_buf;
+  if (srsran_mirror_ringbuffer_init(&mirror_buf, N) < SRSRAN_SUCCESS) {
+    printf("Error initialising mirrored ringbuffer\n");
+    ret = SRSRAN_ERROR;
+  } else {
+    if (test_mirror_wrap_read_write(&mirror_buf, in, out, N) < 0) {
+      printf("Mirrored read write test failed\n");
+      ret = SRSRAN_ERROR;
+    }
+    bzero(out, N * 10);
+    srsran_mirror_ringbuffer_reset(&mirror_buf);
+
+    if (test_mirror_timeout(&mirror_buf, in, out, N) < 0) {
+      printf("Mirrored ringbuffer timeout test failed\n");
+      ret = SRSRAN_ERROR;
+    }
+    bzero(out, N * 10);
+    srsran_mirror_ringbuffer_reset(&mirror_buf);
+
+    struct mirror_thread_args_t mirror_in = {N, in, out, &mirror_buf, SRSRAN_SUCCESS};
+    if (mirror_threaded_blocking_test(&mirror_in)) {
+      printf("Error in multithreaded blocking mirrored ringbuffer test\n");
+      ret = SRSRAN_ERROR;
+    }
+    srsran_mirror_ringbuffer_free(&mirror_buf);
+  }
   free(in);
   free(out);
   printf("Done\n");
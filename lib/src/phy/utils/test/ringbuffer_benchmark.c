@@ -0,0 +1,205 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Streams blocks of one millisecond of samples from a producer thread to a consumer thread, through the legacy
+ * srsran_ringbuffer_t (copy in, copy out) and through srsran_mirror_ringbuffer_t (copy in, samples consumed in place).
+ * Prints the achieved rate and how far above real time it is. Only the data integrity is asserted.
+ */
+
+#include "srsran/support/srsran_test.h"
+#include <complex.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/mirror_ringbuffer.h"
+#include "srsran/phy/utils/ringbuffer.h"
+#include "srsran/phy/utils/vector.h"
+
+static double   srate_msps = 122.88;
+static uint32_t nof_blocks = 2000;
+static uint32_t nof_slots  = 4;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [snb]\n", prog);
+  printf("\t-s sampling rate in Msps, blocks are 1 ms long [Default %.2f]\n", srate_msps);
+  printf("\t-n number of blocks [Default %d]\n", nof_blocks);
+  printf("\t-b buffer size in blocks [Default %d]\n", nof_slots);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "snb")) != -1) {
+    switch (opt) {
+      case 's':
+        srate_msps = strtod(argv[optind], NULL);
+        break;
+      case 'n':
+        nof_blocks = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'b':
+        nof_slots = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+typedef struct {
+  srsran_ringbuffer_t        legacy;
+  srsran_mirror_ringbuffer_t mirror;
+  bool                       use_mirror;
+  uint32_t                   block_len; // in bytes
+  cf_t*                      tx_block;
+  cf_t*                      rx_block;
+  uint32_t                   nof_errors;
+  float                      checksum;
+} bench_args_t;
+
+// Tags the block with its index, so that the consumer can detect lost, repeated or torn blocks
+static void tag_block(cf_t* block, uint32_t nof_samples, uint32_t idx)
+{
+  block[0]               = (float)idx;
+  block[nof_samples - 1] = (float)idx;
+}
+
+static bool check_block(const cf_t* block, uint32_t nof_samples, uint32_t idx)
+{
+  return block[0] == (float)idx && block[nof_samples - 1] == (float)idx;
+}
+
+static void* producer(void* arg)
+{
+  bench_args_t* args        = (bench_args_t*)arg;
+  uint32_t      nof_samples = args->block_len / sizeof(cf_t);
+
+  for (uint32_t i = 0; i < nof_blocks; i++) {
+    tag_block(args->tx_block, nof_samples, i);
+    if (args->use_mirror) {
+      srsran_mirror_ringbuffer_write(&args->mirror, args->tx_block, args->block_len, -1);
+    } else {
+      srsran_ringbuffer_write_block(&args->legacy, args->tx_block, args->block_len);
+    }
+  }
+  return NULL;
+}
+
+static void* consumer(void* arg)
+{
+  bench_args_t* args        = (bench_args_t*)arg;
+  uint32_t      nof_samples = args->block_len / sizeof(cf_t);
+
+  for (uint32_t i = 0; i < nof_blocks; i++) {
+    const cf_t* block = NULL;
+    if (args->use_mirror) {
+      block = srsran_mirror_ringbuffer_read_reserve(&args->mirror, args->block_len, -1);
+    } else if (srsran_ringbuffer_read(&args->legacy, args->rx_block, args->block_len) == args->block_len) {
+      block = args->rx_block;
+    }
+    if (block == NULL || !check_block(block, nof_samples, i)) {
+      args->nof_errors++;
+    }
+    if (block == NULL) {
+      continue;
+    }
+    // Touch the samples, as a receiver would
+    args->checksum += crealf(srsran_vec_acc_cc(block, nof_samples));
+    if (args->use_mirror) {
+      srsran_mirror_ringbuffer_read_commit(&args->mirror, args->block_len);
+    }
+  }
+  return NULL;
+}
+
+static int run(bench_args_t* args, const char* name)
+{
+  struct timeval t[3];
+  pthread_t      threads[2];
+
+  gettimeofday(&t[1], NULL);
+  TESTASSERT(pthread_create(&threads[0], NULL, consumer, args) == 0);
+  TESTASSERT(pthread_create(&threads[1], NULL, producer, args) == 0);
+  TESTASSERT(pthread_join(threads[1], NULL) == 0);
+  TESTASSERT(pthread_join(threads[0], NULL) == 0);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  double elapsed_us  = t[0].tv_sec * 1e6 + t[0].tv_usec;
+  double nof_samples = (double)nof_blocks * args->block_len / sizeof(cf_t);
+  double rate_msps   = elapsed_us > 0 ? nof_samples / elapsed_us : 0;
+  printf("%-7s: %8.1f Msps, %6.1fx real time, %6.2f us/block\n",
+         name,
+         rate_msps,
+         rate_msps / srate_msps,
+         elapsed_us / nof_blocks);
+
+  TESTASSERT(args->nof_errors == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  uint32_t nof_samples = (uint32_t)(srate_msps * 1000);
+  if (nof_samples < 2 || nof_slots == 0) {
+    usage(argv[0]);
+    return SRSRAN_ERROR;
+  }
+
+  bench_args_t args;
+  bzero(&args, sizeof(bench_args_t));
+  args.block_len = nof_samples * sizeof(cf_t);
+  args.tx_block  = srsran_vec_cf_malloc(nof_samples);
+  args.rx_block  = srsran_vec_cf_malloc(nof_samples);
+  TESTASSERT(args.tx_block != NULL && args.rx_block != NULL);
+  for (uint32_t i = 0; i < nof_samples; i++) {
+    args.tx_block[i] = (float)(i % 1024) / 1024.0f;
+  }
+  TESTASSERT(srsran_ringbuffer_init(&args.legacy, args.block_len * nof_slots) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_mirror_ringbuffer_init(&args.mirror, args.block_len * nof_slots) == SRSRAN_SUCCESS);
+
+  printf("%.2f Msps, %d blocks of %d samples, buffer of %d blocks\n", srate_msps, nof_blocks, nof_samples, nof_slots);
+
+  args.use_mirror = false;
+  TESTASSERT(run(&args, "legacy") == SRSRAN_SUCCESS);
+  args.use_mirror = true;
+  TESTASSERT(run(&args, "mirror") == SRSRAN_SUCCESS);
+
+  srsran_ringbuffer_stop(&args.legacy);
+  srsran_ringbuffer_free(&args.legacy);
+  srsran_mirror_ringbuffer_free(&args.mirror);
+  free(args.tx_block);
+  free(args.rx_block);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
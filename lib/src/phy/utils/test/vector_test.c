@@ -54,7 +54,7 @@ static srsran_random_t random_h = NULL;
     bzero(&end, sizeof(end));                                                                                          \
     float mse    = 0.0f;                                                                                               \
     bool  passed = false;                                                                                              \
-    strncpy(func_name, #X, 32);                                                                                        \
+    strncpy(func_name, #X, 64);                                                                                        \
     CODE;                                                                                                              \
     passed = (mse < MAX_MSE);                                                                                          \
     printf("%32s (%5d) ... %7.1f MSamp/s ... %3s Passed (%.6f)\n",                                                     \
@@ -502,6 +502,83 @@ TEST(
     free(x);
     free(z);)
 
+TEST(
+    srsran_vec_interleave_sc_prod_cfc, cf_t * x[3]; cf_t* z = srsran_vec_cf_malloc(3 * block_size); float h = 0.5f;
+
+    for (int c = 0; c < 3; c++) {
+      x[c] = srsran_vec_cf_malloc(block_size);
+      for (int i = 0; i < block_size; i++) { x[c][i] = RANDOM_CF(); }
+    }
+
+    TEST_CALL(srsran_vec_interleave_sc_prod_cfc(x, 3, h, z, block_size))
+
+        for (int c = 0; c < 3; c++) {
+          for (int i = 0; i < block_size; i++) { mse += squared_error(x[c][i] * h, z[i * 3 + c]); }
+          free(x[c]);
+        } mse /= block_size;
+
+    free(z);)
+
+TEST(
+    srsran_vec_deinterleave_sc_prod_cfc, cf_t * z[3]; cf_t* x = srsran_vec_cf_malloc(3 * block_size); float h = 0.5f;
+
+    for (int i = 0; i < 3 * block_size; i++) { x[i] = RANDOM_CF(); } for (int c = 0; c < 3; c++) {
+      z[c] = srsran_vec_cf_malloc(block_size);
+    }
+
+    TEST_CALL(srsran_vec_deinterleave_sc_prod_cfc(x, 3, h, z, block_size))
+
+        for (int c = 0; c < 3; c++) {
+          for (int i = 0; i < block_size; i++) { mse += squared_error(x[i * 3 + c] * h, z[c][i]); }
+          free(z[c]);
+        } mse /= block_size;
+
+    free(x);)
+
+TEST(
+    srsran_vec_interleave_convert_cs, cf_t * x[3]; int16_t* z = srsran_vec_i16_malloc(6 * block_size);
+    float scale = 1000.0f;
+
+    for (int c = 0; c < 3; c++) {
+      x[c] = srsran_vec_cf_malloc(block_size);
+      for (int i = 0; i < block_size; i++) { x[c][i] = RANDOM_CF(); }
+    }
+
+    TEST_CALL(srsran_vec_interleave_convert_cs(x, 3, scale, z, block_size))
+
+        for (int c = 0; c < 3; c++) {
+          for (int i = 0; i < block_size; i++) {
+            double err_re = fabsf(lrintf(crealf(x[c][i]) * scale) - (float)z[2 * (i * 3 + c)]);
+            double err_im = fabsf(lrintf(cimagf(x[c][i]) * scale) - (float)z[2 * (i * 3 + c) + 1]);
+            if (SRSRAN_MAX(err_re, err_im) > mse) {
+              mse = SRSRAN_MAX(err_re, err_im);
+            }
+          }
+          free(x[c]);
+        }
+
+    free(z);)
+
+TEST(
+    srsran_vec_deinterleave_convert_sc, cf_t * z[3]; int16_t* x = srsran_vec_i16_malloc(6 * block_size);
+    float scale = 1000.0f;
+
+    for (int i = 0; i < 6 * block_size; i++) { x[i] = RANDOM_S(); } for (int c = 0; c < 3; c++) {
+      z[c] = srsran_vec_cf_malloc(block_size);
+    }
+
+    TEST_CALL(srsran_vec_deinterleave_convert_sc(x, 3, scale, z, block_size))
+
+        for (int c = 0; c < 3; c++) {
+          for (int i = 0; i < block_size; i++) {
+            cf_t gold = ((float)x[2 * (i * 3 + c)] + I * (float)x[2 * (i * 3 + c) + 1]) / scale;
+            mse += squared_error(gold, z[c][i]);
+          }
+          free(z[c]);
+        } mse /= block_size;
+
+    free(x);)
+
 TEST(
     srsran_vec_prod_fff, MALLOC(float, x); MALLOC(float, y); MALLOC(float, z);
 
@@ -879,7 +956,7 @@ TEST(
 
 int main(int argc, char** argv)
 {
-  char     func_names[MAX_FUNCTIONS][32];
+  char     func_names[MAX_FUNCTIONS][64];
   double   timmings[MAX_FUNCTIONS][MAX_BLOCKS];
   uint32_t sizes[32];
   uint32_t size_count = 0;
@@ -963,6 +1040,22 @@ int main(int argc, char** argv)
         test_srsran_vec_convert_if(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_interleave_sc_prod_cfc(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
+    passed[func_count][size_count] =
+        test_srsran_vec_deinterleave_sc_prod_cfc(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
+    passed[func_count][size_count] =
+        test_srsran_vec_interleave_convert_cs(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
+    passed[func_count][size_count] =
+        test_srsran_vec_deinterleave_convert_sc(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_prod_fff(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
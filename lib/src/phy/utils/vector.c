@@ -847,6 +847,38 @@ void srsran_vec_interleave_add(const cf_t* x, const cf_t* y, cf_t* z, const int
   srsran_vec_interleave_add_simd(x, y, z, len);
 }
 
+void srsran_vec_interleave_sc_prod_cfc(cf_t* const* x, const uint32_t nof_x, const float h, cf_t* z, const uint32_t len)
+{
+  srsran_vec_interleave_sc_prod_cfc_simd(x, nof_x, h, z, len);
+}
+
+void srsran_vec_deinterleave_sc_prod_cfc(const cf_t*    x,
+                                         const uint32_t nof_z,
+                                         const float    h,
+                                         cf_t**         z,
+                                         const uint32_t len)
+{
+  srsran_vec_deinterleave_sc_prod_cfc_simd(x, nof_z, h, z, len);
+}
+
+void srsran_vec_interleave_convert_cs(cf_t* const*   x,
+                                      const uint32_t nof_x,
+                                      const float    scale,
+                                      int16_t*       z,
+                                      const uint32_t len)
+{
+  srsran_vec_interleave_convert_cs_simd(x, nof_x, scale, z, len);
+}
+
+void srsran_vec_deinterleave_convert_sc(const int16_t* x,
+                                        const uint32_t nof_z,
+                                        const float    scale,
+                                        cf_t**         z,
+                                        const uint32_t len)
+{
+  srsran_vec_deinterleave_convert_sc_simd(x, nof_z, scale, z, len);
+}
+
 cf_t srsran_vec_gen_sine(cf_t amplitude, float freq, cf_t* z, int len)
 {
   return srsran_vec_gen_sine_simd(amplitude, freq, z, len);
@@ -1673,6 +1673,197 @@ void srsran_vec_interleave_add_simd(const cf_t* x, const cf_t* y, cf_t* z, const
   }
 }
 
+void srsran_vec_interleave_sc_prod_cfc_simd(cf_t* const* x, const int nof_x, const float h, cf_t* z, const int len)
+{
+  // Channels in pairs, the second one of the last pair might not exist
+  for (int c = 0; c < nof_x; c += 2) {
+    const cf_t* x0 = x[c];
+    const cf_t* x1 = (c + 1 < nof_x) ? x[c + 1] : NULL;
+    cf_t*       f  = &z[c];
+    int         i  = 0;
+
+#ifdef LV_HAVE_SSE
+    // Two samples of each channel at a time, a pair of channels fills 128 bits of two consecutive frames
+    __m128 s = _mm_set1_ps(h);
+    if (x1 != NULL) {
+      for (; i < len - 1; i += 2, f += 2 * nof_x) {
+        __m128 a = _mm_mul_ps(_mm_loadu_ps((float*)&x0[i]), s);
+        __m128 b = _mm_mul_ps(_mm_loadu_ps((float*)&x1[i]), s);
+        _mm_storeu_ps((float*)&f[0], _mm_movelh_ps(a, b));
+        _mm_storeu_ps((float*)&f[nof_x], _mm_movehl_ps(b, a));
+      }
+    } else {
+      for (; i < len - 1; i += 2, f += 2 * nof_x) {
+        __m128 a = _mm_mul_ps(_mm_loadu_ps((float*)&x0[i]), s);
+        _mm_storel_pi((__m64*)&f[0], a);
+        _mm_storeh_pi((__m64*)&f[nof_x], a);
+      }
+    }
+#endif /* LV_HAVE_SSE */
+
+    for (; i < len; i++, f += nof_x) {
+      f[0] = x0[i] * h;
+      if (x1 != NULL) {
+        f[1] = x1[i] * h;
+      }
+    }
+  }
+}
+
+void srsran_vec_deinterleave_sc_prod_cfc_simd(const cf_t* x, const int nof_z, const float h, cf_t** z, const int len)
+{
+  // Channel by channel, reading a pair of channels at once is slower as it writes two streams
+  for (int c = 0; c < nof_z; c++) {
+    cf_t*       z0 = z[c];
+    const cf_t* f  = &x[c];
+    int         i  = 0;
+
+    if (z0 == NULL) {
+      continue;
+    }
+
+#ifdef LV_HAVE_SSE
+    // Four consecutive frames at a time, a channel takes 64 bits of each frame
+    __m128 s = _mm_set1_ps(h);
+    for (; i < len - 3; i += 4, f += 4 * nof_z) {
+      __m128 a = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (__m64*)&f[0]), (__m64*)&f[nof_z]);
+      __m128 b = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (__m64*)&f[2 * nof_z]), (__m64*)&f[3 * nof_z]);
+      _mm_storeu_ps((float*)&z0[i], _mm_mul_ps(a, s));
+      _mm_storeu_ps((float*)&z0[i + 2], _mm_mul_ps(b, s));
+    }
+#endif /* LV_HAVE_SSE */
+
+    for (; i < len; i++, f += nof_z) {
+      z0[i] = f[0] * h;
+    }
+  }
+}
+
+void srsran_vec_interleave_convert_cs_simd(cf_t* const* x,
+                                           const int    nof_x,
+                                           const float  scale,
+                                           int16_t*     z,
+                                           const int    len)
+{
+  const int stride = 2 * nof_x;
+
+  // Channels in pairs, the second one of the last pair might not exist
+  for (int c = 0; c < nof_x; c += 2) {
+    const cf_t* x0 = x[c];
+    const cf_t* x1 = (c + 1 < nof_x) ? x[c + 1] : NULL;
+    int16_t*    f  = &z[2 * c];
+    int         i  = 0;
+
+#ifdef LV_HAVE_SSE
+    // Four samples of each channel at a time. A complex short is handled as a 32 bit word, so a pair of channels
+    // fills 64 bits of four consecutive frames
+    __m128 s = _mm_set1_ps(scale);
+    if (x1 != NULL) {
+      for (; i < len - 3; i += 4, f += 4 * stride) {
+        __m128i a0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps((float*)&x0[i]), s));
+        __m128i a1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps((float*)&x0[i + 2]), s));
+        __m128i b0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps((float*)&x1[i]), s));
+        __m128i b1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps((float*)&x1[i + 2]), s));
+        __m128i a  = _mm_packs_epi32(a0, a1);
+        __m128i b  = _mm_packs_epi32(b0, b1);
+        __m128i lo = _mm_unpacklo_epi32(a, b);
+        __m128i hi = _mm_unpackhi_epi32(a, b);
+        _mm_storel_epi64((__m128i*)&f[0], lo);
+        _mm_storeh_pi((__m64*)&f[stride], _mm_castsi128_ps(lo));
+        _mm_storel_epi64((__m128i*)&f[2 * stride], hi);
+        _mm_storeh_pi((__m64*)&f[3 * stride], _mm_castsi128_ps(hi));
+      }
+    } else {
+      for (; i < len - 3; i += 4, f += 4 * stride) {
+        __m128i a0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps((float*)&x0[i]), s));
+        __m128i a1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps((float*)&x0[i + 2]), s));
+        __m128i a  = _mm_packs_epi32(a0, a1);
+        for (int k = 0; k < 4; k++, a = _mm_srli_si128(a, 4)) {
+          int32_t w = _mm_cvtsi128_si32(a);
+          memcpy(&f[k * stride], &w, sizeof(int32_t));
+        }
+      }
+    }
+#endif /* LV_HAVE_SSE */
+
+    for (; i < len; i++, f += stride) {
+      f[0] = (int16_t)lrintf(__real__ x0[i] * scale);
+      f[1] = (int16_t)lrintf(__imag__ x0[i] * scale);
+      if (x1 != NULL) {
+        f[2] = (int16_t)lrintf(__real__ x1[i] * scale);
+        f[3] = (int16_t)lrintf(__imag__ x1[i] * scale);
+      }
+    }
+  }
+}
+
+void srsran_vec_deinterleave_convert_sc_simd(const int16_t* x,
+                                             const int      nof_z,
+                                             const float    scale,
+                                             cf_t**         z,
+                                             const int      len)
+{
+  const float gain   = 1.0f / scale;
+  const int   stride = 2 * nof_z;
+
+  // Channels in pairs, the second one of the last pair might not exist
+  for (int c = 0; c < nof_z; c += 2) {
+    cf_t*          z0 = z[c];
+    cf_t*          z1 = (c + 1 < nof_z) ? z[c + 1] : NULL;
+    const int16_t* f  = &x[2 * c];
+    int            i  = 0;
+
+#ifdef LV_HAVE_SSE
+    // Four consecutive frames at a time. A complex short is handled as a 32 bit word, so a pair of channels takes 64
+    // bits of each frame
+    __m128 s = _mm_set1_ps(gain);
+    if (c + 1 < nof_z) {
+      for (; i < len - 3; i += 4, f += 4 * stride) {
+        __m128i r0 = _mm_unpacklo_epi32(_mm_loadl_epi64((__m128i*)&f[0]), _mm_loadl_epi64((__m128i*)&f[stride]));
+        __m128i r1 =
+            _mm_unpacklo_epi32(_mm_loadl_epi64((__m128i*)&f[2 * stride]), _mm_loadl_epi64((__m128i*)&f[3 * stride]));
+        __m128i a = _mm_unpacklo_epi64(r0, r1);
+        __m128i b = _mm_unpackhi_epi64(r0, r1);
+        if (z0 != NULL) {
+          __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+          __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16);
+          _mm_storeu_ps((float*)&z0[i], _mm_mul_ps(_mm_cvtepi32_ps(lo), s));
+          _mm_storeu_ps((float*)&z0[i + 2], _mm_mul_ps(_mm_cvtepi32_ps(hi), s));
+        }
+        if (z1 != NULL) {
+          __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(b, b), 16);
+          __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(b, b), 16);
+          _mm_storeu_ps((float*)&z1[i], _mm_mul_ps(_mm_cvtepi32_ps(lo), s));
+          _mm_storeu_ps((float*)&z1[i + 2], _mm_mul_ps(_mm_cvtepi32_ps(hi), s));
+        }
+      }
+    } else if (z0 != NULL) {
+      for (; i < len - 3; i += 4, f += 4 * stride) {
+        __m128i r0 = _mm_unpacklo_epi32(_mm_cvtsi32_si128(*(int32_t*)&f[0]), _mm_cvtsi32_si128(*(int32_t*)&f[stride]));
+        __m128i r1 = _mm_unpacklo_epi32(_mm_cvtsi32_si128(*(int32_t*)&f[2 * stride]),
+                                        _mm_cvtsi32_si128(*(int32_t*)&f[3 * stride]));
+        __m128i a  = _mm_unpacklo_epi64(r0, r1);
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16);
+        _mm_storeu_ps((float*)&z0[i], _mm_mul_ps(_mm_cvtepi32_ps(lo), s));
+        _mm_storeu_ps((float*)&z0[i + 2], _mm_mul_ps(_mm_cvtepi32_ps(hi), s));
+      }
+    }
+#endif /* LV_HAVE_SSE */
+
+    for (; i < len; i++, f += stride) {
+      if (z0 != NULL) {
+        __real__ z0[i] = (float)f[0] * gain;
+        __imag__ z0[i] = (float)f[1] * gain;
+      }
+      if (z1 != NULL) {
+        __real__ z1[i] = (float)f[2] * gain;
+        __imag__ z1[i] = (float)f[3] * gain;
+      }
+    }
+  }
+}
+
 cf_t srsran_vec_gen_sine_simd(cf_t amplitude, float freq, cf_t* z, int len)
 {
   const float TWOPI = 2.0f * (float)M_PI;
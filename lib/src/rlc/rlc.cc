@@ -243,6 +243,17 @@ bool rlc::sdu_queue_is_full(uint32_t lcid)
   return false;
 }
 
+uint32_t rlc::sdu_queue_free_space(uint32_t lcid)
+{
+  if (valid_lcid(lcid)) {
+    return rlc_array.at(lcid)->sdu_queue_free_space();
+  } else if (valid_lcid_mrb(lcid)) {
+    return rlc_array_mrb.at(lcid)->sdu_queue_free_space();
+  }
+  logger.warning("RLC LCID %d doesn't exist. Ignoring queue check", lcid);
+  return 0;
+}
+
 /*******************************************************************************
   MAC interface (mostly called from PHY workers, lock needs to be hold)
 *******************************************************************************/
@@ -155,6 +155,11 @@ bool rlc_am::sdu_queue_is_full()
   return tx_base->sdu_queue_is_full();
 }
 
+uint32_t rlc_am::sdu_queue_free_space()
+{
+  return tx_base->sdu_queue_free_space();
+}
+
 /****************************************************************************
  * MAC interface
  ***************************************************************************/
@@ -293,6 +298,11 @@ bool rlc_am::rlc_am_base_tx::sdu_queue_is_full()
   return tx_sdu_queue.is_full();
 }
 
+uint32_t rlc_am::rlc_am_base_tx::sdu_queue_free_space()
+{
+  return tx_sdu_queue.free_space();
+}
+
 void rlc_am::rlc_am_base_tx::set_bsr_callback(bsr_callback_t callback)
 {
   bsr_callback = callback;
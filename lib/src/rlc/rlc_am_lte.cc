@@ -143,10 +143,10 @@ void rlc_am_lte_tx::empty_queue_nolock()
   }
 
   // deallocate SDU that is currently processed
-  if (tx_sdu != nullptr) {
-    undelivered_sdu_info_queue.clear_pdcp_sdu(tx_sdu->md.pdcp_sn);
+  if (not tx_sdu.empty()) {
+    undelivered_sdu_info_queue.clear_pdcp_sdu(tx_sdu.md().pdcp_sn);
   }
-  tx_sdu.reset();
+  tx_sdu.clear();
 }
 
 void rlc_am_lte_tx::reestablish()
@@ -166,7 +166,7 @@ bool rlc_am_lte_tx::has_data()
 {
   return (((do_status() && not status_prohibit_timer.is_running())) || // if we have a status PDU to transmit
           (not retx_queue.empty()) ||                                  // if we have a retransmission
-          (tx_sdu != nullptr) ||                                       // if we are currently transmitting a SDU
+          (not tx_sdu.empty()) ||                                      // if we are currently transmitting a SDU
           (tx_sdu_queue.get_n_sdus() != 0)); // or if there is a SDU queued up for transmission
 }
 
@@ -254,9 +254,9 @@ void rlc_am_lte_tx::get_buffer_state_nolock(uint32_t& n_bytes_newtx, uint32_t& n
   if (not window_full()) {
     n_sdus = tx_sdu_queue.get_n_sdus();
     n_bytes_newtx += tx_sdu_queue.size_bytes();
-    if (tx_sdu != NULL) {
+    if (not tx_sdu.empty()) {
       n_sdus++;
-      n_bytes_newtx += tx_sdu->N_bytes;
+      n_bytes_newtx += tx_sdu.size();
     }
   }
 
@@ -360,7 +360,7 @@ void rlc_am_lte_tx::retransmit_pdu(uint32_t sn)
   rlc_amd_retx_lte_t& retx = retx_queue.push();
   retx.is_segment          = false;
   retx.so_start            = 0;
-  retx.so_end              = pdu.buf->N_bytes;
+  retx.so_end              = pdu.data.length();
   retx.sn                  = pdu.rlc_sn;
 }
 
@@ -491,7 +491,7 @@ int rlc_am_lte_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   // Set poll bit
   pdu_without_poll++;
-  byte_without_poll += (tx_window[retx.sn].buf->N_bytes + rlc_am_packed_length(&new_header));
+  byte_without_poll += (tx_window[retx.sn].data.length() + rlc_am_packed_length(&new_header));
   RlcInfo("pdu_without_poll: %d", pdu_without_poll);
   RlcInfo("byte_without_poll: %d", byte_without_poll);
   if (poll_required()) {
@@ -508,32 +508,32 @@ int rlc_am_lte_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&new_header, &ptr);
-  memcpy(ptr, tx_window[retx.sn].buf->msg, tx_window[retx.sn].buf->N_bytes);
+  ptr += tx_window[retx.sn].data.copy_to(ptr);
 
   retx_queue.pop();
 
   RlcHexInfo(payload,
-             tx_window[retx.sn].buf->N_bytes,
+             ptr - payload,
              "Tx PDU SN=%d (%d B) (attempt %d/%d)",
              retx.sn,
-             tx_window[retx.sn].buf->N_bytes,
+             tx_window[retx.sn].data.length(),
              tx_window[retx.sn].retx_count + 1,
              cfg.max_retx_thresh);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "Tx PDU - %s", new_header);
 
   debug_state();
-  return (ptr - payload) + tx_window[retx.sn].buf->N_bytes;
+  return ptr - payload;
 }
 
 int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_retx_lte_t retx)
 {
-  if (tx_window[retx.sn].buf == NULL) {
-    RlcError("In build_segment: retx.sn=%d has null buffer", retx.sn);
+  if (tx_window[retx.sn].data.empty()) {
+    RlcError("In build_segment: retx.sn=%d has no data", retx.sn);
     return 0;
   }
   if (!retx.is_segment) {
     retx.so_start = 0;
-    retx.so_end   = tx_window[retx.sn].buf->N_bytes;
+    retx.so_end   = tx_window[retx.sn].data.length();
   }
 
   // Construct new header
@@ -541,7 +541,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   rlc_amd_pdu_header_t old_header = tx_window[retx.sn].header;
 
   pdu_without_poll++;
-  byte_without_poll += (tx_window[retx.sn].buf->N_bytes + rlc_am_packed_length(&new_header));
+  byte_without_poll += (tx_window[retx.sn].data.length() + rlc_am_packed_length(&new_header));
   RlcInfo("pdu_without_poll: %d, byte_without_poll: %d", pdu_without_poll, byte_without_poll);
 
   new_header.dc   = RLC_DC_FIELD_DATA_PDU;
@@ -641,7 +641,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   srsran_expect(head_len + (retx.so_end - retx.so_start) <= nof_bytes, "The provided buffer was overflown.");
 
   // Update retx_queue
-  if (tx_window[retx.sn].buf->N_bytes == retx.so_end) {
+  if (tx_window[retx.sn].data.length() == retx.so_end) {
     retx_queue.pop();
     new_header.lsf = 1;
     if (rlc_am_end_aligned(old_header.fi)) {
@@ -666,12 +666,10 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
     }
   }
 
-  // Write header and pdu
+  // Write header and gather the segment into the PDU
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&new_header, &ptr);
-  uint8_t* data = &tx_window[retx.sn].buf->msg[retx.so_start];
-  uint32_t len  = retx.so_end - retx.so_start;
-  memcpy(ptr, data, len);
+  uint32_t len = tx_window[retx.sn].data.copy_to(ptr, retx.so_start, retx.so_end - retx.so_start);
 
   debug_state();
   int pdu_len = (ptr - payload) + len;
@@ -698,7 +696,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
 
 int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  if (tx_sdu == NULL && tx_sdu_queue.is_empty()) {
+  if (tx_sdu.empty() && tx_sdu_queue.is_empty()) {
     RlcInfo("No data available to be sent");
     return 0;
   }
@@ -716,23 +714,6 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
     return 0;
   }
 
-  unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-  if (pdu == NULL) {
-#ifdef RLC_AM_BUFFER_DEBUG
-    srsran::console("Fatal Error: Could not allocate PDU in build_data_pdu()\n");
-    srsran::console("tx_window size: %zd PDUs\n", tx_window.size());
-    srsran::console("vt_a = %d, vt_ms = %d, vt_s = %d, poll_sn = %d\n", vt_a, vt_ms, vt_s, poll_sn);
-    srsran::console("retx_queue size: %zd PDUs\n", retx_queue.size());
-    std::map<uint32_t, rlc_amd_tx_pdu>::iterator txit;
-    for (txit = tx_window.begin(); txit != tx_window.end(); txit++) {
-      srsran::console("tx_window - SN=%d\n", txit->first);
-    }
-    exit(-1);
-#else
-    RlcError("Fatal Error: Couldn't allocate PDU in build_data_pdu().");
-    return 0;
-#endif
-  }
   rlc_amd_pdu_header_t header = {};
   header.dc                   = RLC_DC_FIELD_DATA_PDU;
   header.fi                   = RLC_FI_FIELD_START_AND_END_ALIGNED;
@@ -747,40 +728,38 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   // NOTE: from now on, we can't return from this function anymore before increasing vt_s
   rlc_amd_tx_pdu_lte& tx_pdu = tx_window.add_pdu(header.sn);
 
+  // The PDU only references the SDU segments it carries. Its size is kept within what a byte buffer can hold, as the
+  // receiving side stores each PDU in one.
   uint32_t head_len  = rlc_am_packed_length(&header);
   uint32_t to_move   = 0;
   uint32_t last_li   = 0;
-  uint32_t pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
-  uint8_t* pdu_ptr   = pdu->msg;
+  uint32_t pdu_space = SRSRAN_MIN(nof_bytes, byte_buffer_large_payload_size);
 
   RlcDebug("Building PDU - pdu_space: %d, head_len: %d ", pdu_space, head_len);
 
   // Check for SDU segment
-  if (tx_sdu != nullptr) {
-    to_move = ((pdu_space - head_len) >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : pdu_space - head_len;
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+  if (not tx_sdu.empty()) {
+    // The last segment of the SDU takes the slice over, read its metadata beforehand
+    uint32_t pdcp_sn = tx_sdu.md().pdcp_sn;
+    to_move          = ((pdu_space - head_len) >= tx_sdu.size()) ? tx_sdu.size() : pdu_space - head_len;
+    tx_pdu.data.append(tx_sdu.take_front(to_move));
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (undelivered_sdu_info_queue.has_pdcp_sn(tx_sdu->md.pdcp_sn)) {
-      pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[tx_sdu->md.pdcp_sn];
+    if (undelivered_sdu_info_queue.has_pdcp_sn(pdcp_sn)) {
+      pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[pdcp_sn];
       segment_pool.make_segment(tx_pdu, pdcp_pdu);
-      if (tx_sdu->N_bytes == 0) {
+      if (tx_sdu.empty()) {
         pdcp_pdu.fully_txed = true;
       }
     } else {
       // PDCP SNs for the RLC SDU has been removed from the queue
-      RlcWarning("Couldn't find PDCP_SN=%d in SDU info queue (segment)", tx_sdu->md.pdcp_sn);
+      RlcWarning("Couldn't find PDCP_SN=%d in SDU info queue (segment)", pdcp_sn);
     }
 
-    if (tx_sdu->N_bytes == 0) {
+    if (tx_sdu.empty()) {
       RlcDebug("Complete SDU scheduled for tx.");
-      tx_sdu.reset();
     }
     if (pdu_space > to_move) {
-      pdu_space -= SRSRAN_MIN(to_move, pdu->get_tailroom());
+      pdu_space -= to_move;
     } else {
       pdu_space = 0;
     }
@@ -793,16 +772,27 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
              header.sn);
   }
 
+  // Once a single slice is left, the SDU segments are copied into a buffer owned by the PDU, which becomes its last
+  // slice. Small SDUs thus do not end the PDU early.
+  unique_byte_buffer_t tail_sdus;
+
   // Pull SDUs from queue
   while (pdu_space > head_len && tx_sdu_queue.get_n_sdus() > 0 && header.N_li < MAX_SDUS_PER_PDU) {
     if (not segment_pool.has_segments()) {
       RlcInfo("Can't build a PDU segment - No segment resources available");
-      if (pdu_ptr != pdu->msg) {
+      if (not tx_pdu.data.empty()) {
         break; // continue with the segments created up to this point
       }
       tx_window.remove_pdu(tx_pdu.rlc_sn);
       return 0;
     }
+    if (tail_sdus == nullptr && tx_pdu.data.nof_slices() + 1 >= RLC_MAX_SLICES) {
+      tail_sdus = make_byte_buffer();
+      if (tail_sdus == nullptr) {
+        RlcInfo("Can't build a PDU segment - No buffer available for the last SDU segments");
+        break; // continue with the segments created up to this point
+      }
+    }
     if (last_li > 0) {
       header.li[header.N_li] = last_li;
       header.N_li++;
@@ -815,42 +805,43 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
       break;
     }
 
+    unique_byte_buffer_t sdu;
     do {
-      tx_sdu = tx_sdu_queue.read();
-    } while (tx_sdu == nullptr && tx_sdu_queue.size() != 0);
-    if (tx_sdu == nullptr) {
+      sdu = tx_sdu_queue.read();
+    } while (sdu == nullptr && tx_sdu_queue.size() != 0);
+    if (sdu == nullptr) {
       if (header.N_li > 0) {
         header.N_li--;
       }
       break;
     }
+    uint32_t pdcp_sn = sdu->md.pdcp_sn;
+    tx_sdu           = byte_buffer_slice(std::move(sdu));
 
     // store sdu info
-    if (undelivered_sdu_info_queue.has_pdcp_sn(tx_sdu->md.pdcp_sn)) {
-      RlcWarning("PDCP_SN=%d already marked as undelivered", tx_sdu->md.pdcp_sn);
+    if (undelivered_sdu_info_queue.has_pdcp_sn(pdcp_sn)) {
+      RlcWarning("PDCP_SN=%d already marked as undelivered", pdcp_sn);
     } else {
-      RlcDebug("marking pdcp_sn=%d as undelivered (queue_len=%ld)",
-               tx_sdu->md.pdcp_sn,
-               undelivered_sdu_info_queue.nof_sdus());
-      undelivered_sdu_info_queue.add_pdcp_sdu(tx_sdu->md.pdcp_sn);
+      RlcDebug("marking pdcp_sn=%d as undelivered (queue_len=%ld)", pdcp_sn, undelivered_sdu_info_queue.nof_sdus());
+      undelivered_sdu_info_queue.add_pdcp_sdu(pdcp_sn);
     }
-    pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[tx_sdu->md.pdcp_sn];
+    pdcp_pdu_info_lte& pdcp_pdu = undelivered_sdu_info_queue[pdcp_sn];
 
-    to_move = ((pdu_space - head_len) >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : pdu_space - head_len;
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
+    to_move = ((pdu_space - head_len) >= tx_sdu.size()) ? tx_sdu.size() : pdu_space - head_len;
+    if (tail_sdus != nullptr) {
+      byte_buffer_slice segment = tx_sdu.take_front(to_move);
+      tail_sdus->append_bytes(segment.data(), segment.size());
+    } else {
+      tx_pdu.data.append(tx_sdu.take_front(to_move));
+    }
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
     segment_pool.make_segment(tx_pdu, pdcp_pdu);
-    if (tx_sdu->N_bytes == 0) {
+    if (tx_sdu.empty()) {
       pdcp_pdu.fully_txed = true;
     }
 
-    if (tx_sdu->N_bytes == 0) {
-      RlcDebug("Complete SDU scheduled for tx. PDCP SN=%d", tx_sdu->md.pdcp_sn);
-      tx_sdu.reset();
+    if (tx_sdu.empty()) {
+      RlcDebug("Complete SDU scheduled for tx. PDCP SN=%d", pdcp_sn);
     }
     if (pdu_space > to_move) {
       pdu_space -= to_move;
@@ -860,19 +851,22 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 
     RlcDebug("Building PDU - added SDU segment (len:%d) - pdu_space: %d, head_len: %d ", to_move, pdu_space, head_len);
   }
+  if (tail_sdus != nullptr) {
+    tx_pdu.data.append(byte_buffer_slice(std::move(tail_sdus)));
+  }
 
   // Make sure, at least one SDU (segment) has been added until this point
-  if (pdu->N_bytes == 0) {
+  if (tx_pdu.data.empty()) {
     RlcError("Generated empty RLC PDU.");
   }
 
-  if (tx_sdu != NULL) {
+  if (not tx_sdu.empty()) {
     header.fi |= RLC_FI_FIELD_NOT_END_ALIGNED; // Last byte does not correspond to last byte of SDU
   }
 
   // Set Poll bit
   pdu_without_poll++;
-  byte_without_poll += (pdu->N_bytes + head_len);
+  byte_without_poll += (tx_pdu.data.length() + head_len);
   RlcDebug("pdu_without_poll: %d", pdu_without_poll);
   RlcDebug("byte_without_poll: %d", byte_without_poll);
   if (poll_required()) {
@@ -889,15 +883,13 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   // Update Tx window
   vt_s = (vt_s + 1) % MOD;
 
-  // Write final header and TX
-  tx_pdu.buf                      = std::move(pdu);
-  tx_pdu.header                   = header;
-  const byte_buffer_t* buffer_ptr = tx_pdu.buf.get();
+  // Write final header and gather the SDU segments into the MAC PDU, the only copy of the payload
+  tx_pdu.header = header;
 
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&header, &ptr);
-  memcpy(ptr, buffer_ptr->msg, buffer_ptr->N_bytes);
-  int total_len = (ptr - payload) + buffer_ptr->N_bytes;
+  ptr += tx_pdu.data.copy_to(ptr);
+  int total_len = ptr - payload;
   RlcHexInfo(payload, total_len, "Tx PDU SN=%d (%d B)", header.sn, total_len);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "%s", header);
   debug_state();
@@ -970,24 +962,24 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
             retx.sn         = i;
             retx.is_segment = false;
             retx.so_start   = 0;
-            retx.so_end     = pdu.buf->N_bytes;
+            retx.so_end     = pdu.data.length();
 
             if (status.nacks[j].has_so) {
               // sanity check
-              if (status.nacks[j].so_start >= pdu.buf->N_bytes) {
+              if (status.nacks[j].so_start >= pdu.data.length()) {
                 // print error but try to send original PDU again
-                RlcInfo("SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.buf->N_bytes);
+                RlcInfo("SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.data.length());
                 status.nacks[j].so_start = 0;
               }
 
               // check for special SO_end value
               if (status.nacks[j].so_end == 0x7FFF) {
-                status.nacks[j].so_end = pdu.buf->N_bytes;
+                status.nacks[j].so_end = pdu.data.length();
               } else {
                 retx.so_end = status.nacks[j].so_end + 1;
               }
 
-              if (status.nacks[j].so_start < pdu.buf->N_bytes && status.nacks[j].so_end <= pdu.buf->N_bytes) {
+              if (status.nacks[j].so_start < pdu.data.length() && status.nacks[j].so_end <= pdu.data.length()) {
                 retx.is_segment = true;
                 retx.so_start   = status.nacks[j].so_start;
               } else {
@@ -995,7 +987,7 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
                            i,
                            status.nacks[j].so_start,
                            status.nacks[j].so_end,
-                           pdu.buf->N_bytes);
+                           pdu.data.length());
               }
             }
           } else {
@@ -1093,8 +1085,8 @@ int rlc_am_lte_tx::required_buffer_size(const rlc_amd_retx_lte_t& retx)
 {
   if (!retx.is_segment) {
     if (tx_window.has_sn(retx.sn)) {
-      if (tx_window[retx.sn].buf) {
-        return rlc_am_packed_length(&tx_window[retx.sn].header) + tx_window[retx.sn].buf->N_bytes;
+      if (not tx_window[retx.sn].data.empty()) {
+        return rlc_am_packed_length(&tx_window[retx.sn].header) + tx_window[retx.sn].data.length();
       } else {
         RlcWarning("retx.sn=%d has null ptr in required_buffer_size()", retx.sn);
         return -1;
@@ -1293,7 +1285,7 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
 
   // Write to rx window
   rlc_amd_rx_pdu& pdu = rx_window.add_pdu(header.sn);
-  pdu.buf             = srsran::make_byte_buffer();
+  pdu.buf             = srsran::make_sized_byte_buffer(nof_bytes);
   if (pdu.buf == NULL) {
 #ifdef RLC_AM_BUFFER_DEBUG
     srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu().\n");
@@ -1369,8 +1361,6 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
 
 void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-
   RlcHexInfo(payload,
              nof_bytes,
              "Rx data PDU segment of SN=%d (%d B), SO=%d, N_li=%d",
@@ -1391,7 +1381,7 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
   }
 
   rlc_amd_rx_pdu segment;
-  segment.buf = srsran::make_byte_buffer();
+  segment.buf = srsran::make_sized_byte_buffer(nof_bytes);
   if (segment.buf == NULL) {
 #ifdef RLC_AM_BUFFER_DEBUG
     srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu_segment().\n");
@@ -1412,24 +1402,21 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
   segment.header       = header;
 
   // Check if we already have a segment from the same PDU
-  it = rx_segments.find(header.sn);
-  if (rx_segments.end() != it) {
+  if (rx_segments.contains(header.sn)) {
     if (header.p) {
       RlcInfo("Status packet requested through polling bit");
       do_status = true;
     }
 
     // Add segment to PDU list and check for complete
-    // NOTE: MAY MOVE. Preference would be to capture by value, and then move; but header is stack allocated
-    if (add_segment_and_check(&it->second, &segment)) {
-      rx_segments.erase(it);
+    if (add_segment_and_check(rx_segments[header.sn], std::move(segment))) {
+      rx_segments.erase(header.sn);
     }
 
   } else {
-    // Create new PDU segment list and write to rx_segments
-    rlc_amd_rx_pdu_segments_t pdu;
-    pdu.segments.push_back(std::move(segment));
-    rx_segments[header.sn] = std::move(pdu);
+    // Create new PDU segment list in the slot of the SN. Any list left there belongs to an SN outside the window
+    rx_segments.overwrite(header.sn, rlc_amd_rx_pdu_segments_t());
+    rx_segments[header.sn].insert(rx_segment_pool, header.so, nof_bytes, header.lsf, std::move(segment));
 
     // Update vr_h
     if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
@@ -1490,7 +1477,7 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
       }
 
       if (rx_sdu->get_tailroom() >= len) {
-        if ((rx_window[vr_r].buf->msg - rx_window[vr_r].buf->buffer) + len < SRSRAN_MAX_BUFFER_SIZE_BYTES) {
+        if (rx_window[vr_r].buf->get_headroom() + len <= rx_window[vr_r].buf->buffer_size) {
           if (rx_window[vr_r].buf->N_bytes < len) {
             RlcError("Dropping corrupted SN=%d", vr_r);
             rx_sdu.reset();
@@ -1585,19 +1572,16 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
     // Move the rx_window
     RlcDebug("Erasing SN=%d.", vr_r);
     // also erase any segments of this SN
-    std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-    it = rx_segments.find(vr_r);
-    if (rx_segments.end() != it) {
+    if (rx_segments.contains(vr_r)) {
       RlcDebug("Erasing segments of SN=%d", vr_r);
-      std::list<rlc_amd_rx_pdu>::iterator segit;
-      for (segit = it->second.segments.begin(); segit != it->second.segments.end(); ++segit) {
+      for (const rlc_amd_rx_pdu& segment : rx_segments[vr_r]) {
         RlcDebug(" Erasing segment of SN=%d SO=%d Len=%d N_li=%d",
-                 segit->header.sn,
-                 segit->header.so,
-                 segit->buf->N_bytes,
-                 segit->header.N_li);
+                 segment.header.sn,
+                 segment.header.so,
+                 segment.buf->N_bytes,
+                 segment.header.N_li);
       }
-      it->second.segments.clear();
+      rx_segments.erase(vr_r);
     }
     rx_window.remove_pdu(vr_r);
     vr_r  = (vr_r + 1) % MOD;
@@ -1733,72 +1717,27 @@ int rlc_am_lte_rx::get_status_pdu_length()
 
 void rlc_am_lte_rx::print_rx_segments()
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-  std::stringstream                                       ss;
+  std::stringstream ss;
   ss << "rx_segments:" << std::endl;
-  for (it = rx_segments.begin(); it != rx_segments.end(); it++) {
-    std::list<rlc_amd_rx_pdu>::iterator segit;
-    for (segit = it->second.segments.begin(); segit != it->second.segments.end(); segit++) {
-      ss << "    SN=" << segit->header.sn << " SO:" << segit->header.so << " N:" << segit->buf->N_bytes
-         << " N_li: " << segit->header.N_li << std::endl;
+  for (const auto& pdu : rx_segments) {
+    for (const rlc_amd_rx_pdu& segment : pdu.second) {
+      ss << "    SN=" << segment.header.sn << " SO:" << segment.header.so << " N:" << segment.buf->N_bytes
+         << " N_li: " << segment.header.N_li << std::endl;
     }
   }
   RlcDebug("%s", ss.str().c_str());
 }
 
-// NOTE: Preference would be to capture by value, and then move; but header is stack allocated
-bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu* segment)
+bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t& pdu, rlc_amd_rx_pdu segment)
 {
-  // Find segment insertion point in the list of segments
-  auto it1 = pdu->segments.begin();
-  while (it1 != pdu->segments.end() && (*it1).header.so < segment->header.so) {
-    // Increment iterator
-    it1++;
-  }
-
-  // Check if the insertion point was found
-  if (it1 != pdu->segments.end()) {
-    // Found insertion point
-    rlc_amd_rx_pdu& s = *it1;
-    if (s.header.so == segment->header.so) {
-      // Same Segment offset
-      if (segment->buf->N_bytes > s.buf->N_bytes) {
-        // replace if the new one is bigger
-        s = std::move(*segment);
-      } else {
-        // Ignore otherwise
-      }
-    } else if (s.header.so > segment->header.so) {
-      pdu->segments.insert(it1, std::move(*segment));
-    }
-  } else {
-    // Either the new segment is the latest or the only one, push back
-    pdu->segments.push_back(std::move(*segment));
-  }
+  // Insert the segment sorted by SO. Segments fully overlapped by previous ones are dropped
+  uint32_t so  = segment.header.so;
+  uint32_t len = segment.buf->N_bytes;
+  bool     lsf = segment.header.lsf;
+  pdu.insert(rx_segment_pool, so, len, lsf, std::move(segment));
 
   // Check for complete
-  uint32_t                            so = 0;
-  std::list<rlc_amd_rx_pdu>::iterator it, tmpit;
-  for (it = pdu->segments.begin(); it != pdu->segments.end(); /* Do not increment */) {
-    // Check that there is no gap between last segment and current; overlap allowed
-    if (so < it->header.so) {
-      // return
-      return false;
-    }
-
-    // Check if segment is overlapped
-    if (it->header.so + it->buf->N_bytes <= so) {
-      // completely overlapped with previous segments, erase
-      it = pdu->segments.erase(it); // Returns next iterator
-    } else {
-      // Update segment offset it shall not go backwards
-      so = SRSRAN_MAX(so, it->header.so + it->buf->N_bytes);
-      it++; // Increments iterator
-    }
-  }
-
-  // Check for last segment flag available
-  if (!pdu->segments.back().header.lsf) {
+  if (not pdu.fully_received()) {
     return false;
   }
 
@@ -1808,23 +1747,24 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
   header.rf   = 0;
   header.p    = 0;
   header.fi   = RLC_FI_FIELD_START_AND_END_ALIGNED;
-  header.sn   = pdu->segments.front().header.sn;
+  header.sn   = pdu.front().header.sn;
   header.lsf  = 0;
   header.so   = 0;
   header.N_li = 0;
 
   // Reconstruct fi field
-  header.fi |= (pdu->segments.front().header.fi & RLC_FI_FIELD_NOT_START_ALIGNED);
-  header.fi |= (pdu->segments.back().header.fi & RLC_FI_FIELD_NOT_END_ALIGNED);
+  header.fi |= (pdu.front().header.fi & RLC_FI_FIELD_NOT_START_ALIGNED);
+  header.fi |= (pdu.back().header.fi & RLC_FI_FIELD_NOT_END_ALIGNED);
 
-  RlcDebug("Starting header reconstruction of %zd segments", pdu->segments.size());
+  RlcDebug("Starting header reconstruction of %zd segments", pdu.size());
 
   // Reconstruct li fields
   uint16_t count          = 0;
   uint16_t carryover      = 0;
   uint16_t consumed_bytes = 0; // rolling sum of all allocated LIs during segment reconstruction
 
-  for (it = pdu->segments.begin(); it != pdu->segments.end(); ++it) {
+  rlc_amd_rx_pdu_segments_t::iterator it, tmpit;
+  for (it = pdu.begin(); it != pdu.end(); ++it) {
     RlcDebug(" Handling %d PDU segments", it->header.N_li);
     for (uint32_t i = 0; i < it->header.N_li; i++) {
       // variable marks total offset of each _processed_ LI of this segment
@@ -1880,7 +1820,7 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
     }
 
     tmpit = it;
-    if (rlc_am_end_aligned(it->header.fi) && ++tmpit != pdu->segments.end()) {
+    if (rlc_am_end_aligned(it->header.fi) && ++tmpit != pdu.end()) {
       RlcDebug("Header is end-aligned, overwrite header.li[%d]=%d", header.N_li, carryover);
       header.li[header.N_li] = carryover;
       header.N_li++;
@@ -1893,7 +1833,7 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
     header.p |= it->header.p;
   }
 
-  RlcDebug("Finished header reconstruction of %zd segments", pdu->segments.size());
+  RlcDebug("Finished header reconstruction of %zd segments", pdu.size());
 
   // Copy data
   unique_byte_buffer_t full_pdu = srsran::make_byte_buffer();
@@ -1906,7 +1846,7 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
     return false;
 #endif
   }
-  for (it = pdu->segments.begin(); it != pdu->segments.end(); it++) {
+  for (it = pdu.begin(); it != pdu.end(); it++) {
     // By default, the segment is not copied. It could be it is fully overlapped with previous segments
     uint32_t overlap = 0;
     uint32_t n       = 0;
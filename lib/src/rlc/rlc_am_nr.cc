@@ -1473,27 +1473,17 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
     return;
   }
 
-  // Section 5.2.3.2.2, discard segments with overlapping bytes
-  if (rx_window->has_sn(header.sn) && header.si != rlc_nr_si_field_t::full_sdu) {
-    for (const auto& segm : (*rx_window)[header.sn].segments) {
-      uint32_t segm_last_byte = segm.header.so + segm.buf->N_bytes - 1;
-      uint32_t pdu_last_byte  = header.so + nof_bytes - hdr_len - 1;
-      if ((header.so >= segm.header.so && header.so <= segm_last_byte) ||
-          (pdu_last_byte >= segm.header.so && pdu_last_byte <= segm_last_byte)) {
-        RlcInfo("Got SDU segment with duplicate bytes. Discarding.");
-        RlcInfo("Discarded SDU segment. SN=%d, SO=%d, last_byte=%d, payload=%d",
-                header.sn,
-                header.so,
-                header.so + (nof_bytes - hdr_len),
-                (nof_bytes - hdr_len));
-        RlcInfo("Overlaping with SDU segment with SN=%d, SO=%d, last_byte=%d, payload=%d",
-                header.sn,
-                segm.header.so,
-                segm_last_byte,
-                segm.buf->N_bytes);
-        return;
-      }
-    }
+  // Section 5.2.3.2.2, discard segments whose bytes have all been received before. The duplicate bytes of partially
+  // overlapping segments are skipped when the SDU is reassembled
+  if (rx_window->has_sn(header.sn) && header.si != rlc_nr_si_field_t::full_sdu &&
+      (*rx_window)[header.sn].segments.covers(header.so, nof_bytes - hdr_len)) {
+    RlcInfo("Got SDU segment with duplicate bytes. Discarding.");
+    RlcInfo("Discarded SDU segment. SN=%d, SO=%d, last_byte=%d, payload=%d",
+            header.sn,
+            header.so,
+            header.so + (nof_bytes - hdr_len),
+            (nof_bytes - hdr_len));
+    return;
   }
 
   // Write to rx window either full SDU or SDU segment
@@ -1706,11 +1696,19 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
       rx_window->remove_pdu(header.sn);
       return SRSRAN_ERROR;
     }
-    // Assemble SDU from segments
+    if (rx_sdu.segments.nof_contiguous_bytes() > rx_sdu.buf->get_tailroom()) {
+      RlcError("SDU of %d B does not fit in a buffer. SN=%d.", rx_sdu.segments.nof_contiguous_bytes(), header.sn);
+      rx_window->remove_pdu(header.sn);
+      return SRSRAN_ERROR;
+    }
+    // Assemble SDU from segments, copying only the bytes beyond the ones already taken from previous segments
     for (const auto& it : rx_sdu.segments) {
-      memcpy(&rx_sdu.buf->msg[rx_sdu.buf->N_bytes], it.buf->msg, it.buf->N_bytes);
-      rx_sdu.buf->N_bytes += it.buf->N_bytes;
+      uint32_t overlap = rx_sdu.buf->N_bytes - it.header.so;
+      memcpy(&rx_sdu.buf->msg[rx_sdu.buf->N_bytes], &it.buf->msg[overlap], it.buf->N_bytes - overlap);
+      rx_sdu.buf->N_bytes += it.buf->N_bytes - overlap;
     }
+    // Return the segments to the pool, they are not needed once the SDU is complete
+    rx_sdu.segments.clear();
   }
   return SRSRAN_SUCCESS;
 }
@@ -1752,7 +1750,7 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
         uint32_t last_so         = 0;
         bool     last_segment_rx = false;
         for (auto segm = (*rx_window)[i].segments.begin(); segm != (*rx_window)[i].segments.end(); segm++) {
-          if (segm->header.so != last_so) {
+          if (segm->header.so > last_so) {
             // Some bytes were not received
             rlc_status_nack_t nack;
             nack.nack_sn  = i;
@@ -1788,7 +1786,8 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
           if (segm->header.si == rlc_nr_si_field_t::last_segment) {
             last_segment_rx = true;
           }
-          last_so = segm->header.so + segm->buf->N_bytes;
+          // Segments may overlap, the next missing byte is the furthest end so far
+          last_so = std::max(last_so, segm->header.so + segm->buf->N_bytes);
         } // Segment loop
         if (not last_segment_rx) {
           rlc_status_nack_t nack;
@@ -1925,40 +1924,20 @@ void rlc_am_nr_rx::write_to_upper_layers(uint32_t lcid, unique_byte_buffer_t sdu
 /*
  * Segment Helpers
  */
-void rlc_am_nr_rx::insert_received_segment(rlc_amd_rx_pdu_nr                                   segment,
-                                           std::set<rlc_amd_rx_pdu_nr, rlc_amd_rx_pdu_nr_cmp>& segment_list) const
+void rlc_am_nr_rx::insert_received_segment(rlc_amd_rx_pdu_nr                      segment,
+                                           rlc_amd_rx_sdu_nr_t::segment_list_t& segment_list)
 {
-  segment_list.insert(std::move(segment));
+  uint32_t so   = segment.header.so;
+  uint32_t len  = segment.buf->N_bytes;
+  bool     last = segment.header.si == rlc_nr_si_field_t::last_segment;
+  segment_list.insert(rx_segment_pool, so, len, last, std::move(segment));
 }
 
 void rlc_am_nr_rx::update_segment_inventory(rlc_amd_rx_sdu_nr_t& rx_sdu) const
 {
-  if (rx_sdu.segments.empty()) {
-    rx_sdu.fully_received = false;
-    rx_sdu.has_gap        = false;
-    return;
-  }
-
-  // Check for gaps and if all segments have been received
-  uint32_t next_byte = 0;
-  for (const auto& it : rx_sdu.segments) {
-    if (it.header.so != next_byte) {
-      // Found gap: set flags and return
-      rx_sdu.has_gap        = true;
-      rx_sdu.fully_received = false;
-      return;
-    }
-    if (it.header.si == rlc_nr_si_field_t::last_segment) {
-      // Reached last segment without any gaps: set flags and return
-      rx_sdu.has_gap        = false;
-      rx_sdu.fully_received = true;
-      return;
-    }
-    next_byte += it.buf->N_bytes;
-  }
-  // No gaps, but last segment not yet received
-  rx_sdu.has_gap        = false;
-  rx_sdu.fully_received = false;
+  // The segment list keeps track of the received byte intervals on every insertion
+  rx_sdu.has_gap        = rx_sdu.segments.has_gap();
+  rx_sdu.fully_received = rx_sdu.segments.fully_received();
 }
 
 /*
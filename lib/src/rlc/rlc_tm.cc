@@ -117,6 +117,11 @@ bool rlc_tm::sdu_queue_is_full()
   return ul_queue.is_full();
 }
 
+uint32_t rlc_tm::sdu_queue_free_space()
+{
+  return ul_queue.free_space();
+}
+
 // MAC interface
 bool rlc_tm::has_data()
 {
@@ -123,6 +123,11 @@ bool rlc_um_base::sdu_queue_is_full()
   return tx->sdu_queue_is_full();
 }
 
+uint32_t rlc_um_base::sdu_queue_free_space()
+{
+  return tx->sdu_queue_free_space();
+}
+
 /****************************************************************************
  * MAC interface
  ***************************************************************************/
@@ -259,12 +264,12 @@ void rlc_um_base::rlc_um_base_tx::empty_queue()
   }
 
   // deallocate SDU that is currently processed
-  tx_sdu.reset();
+  clear_tx_sdu();
 }
 
 bool rlc_um_base::rlc_um_base_tx::has_data()
 {
-  return (tx_sdu != nullptr || !tx_sdu_queue.is_empty());
+  return (has_tx_sdu() || !tx_sdu_queue.is_empty());
 }
 
 void rlc_um_base::rlc_um_base_tx::set_bsr_callback(bsr_callback_t callback)
@@ -326,25 +331,23 @@ bool rlc_um_base::rlc_um_base_tx::sdu_queue_is_full()
   return tx_sdu_queue.is_full();
 }
 
+uint32_t rlc_um_base::rlc_um_base_tx::sdu_queue_free_space()
+{
+  return tx_sdu_queue.free_space();
+}
+
 uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  unique_byte_buffer_t pdu;
   {
     std::lock_guard<std::mutex> lock(mutex);
     RlcDebug("MAC opportunity - %d bytes", nof_bytes);
 
-    if (tx_sdu == nullptr && tx_sdu_queue.is_empty()) {
+    if (not has_tx_sdu() && tx_sdu_queue.is_empty()) {
       RlcInfo("No data available to be sent");
       return 0;
     }
-
-    pdu = make_byte_buffer();
-    if (!pdu || pdu->N_bytes != 0) {
-      RlcError("Failed to allocate PDU buffer");
-      return 0;
-    }
   }
-  return build_data_pdu(std::move(pdu), payload, nof_bytes);
+  return build_pdu(payload, nof_bytes);
 }
 
 } // namespace srsran
@@ -84,9 +84,9 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::get_buffer_state()
   // Bytes needed for tx SDUs
   uint32_t n_sdus  = tx_sdu_queue.size();
   uint32_t n_bytes = tx_sdu_queue.size_bytes();
-  if (tx_sdu) {
+  if (not tx_sdu.empty()) {
     n_sdus++;
-    n_bytes += tx_sdu->N_bytes;
+    n_bytes += tx_sdu.size();
   }
 
   // Room needed for header extensions? (integer rounding)
@@ -121,7 +121,7 @@ bool rlc_um_lte::rlc_um_lte_tx::configure(const rlc_config_t& cnfg_, std::string
   return true;
 }
 
-uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
+uint32_t rlc_um_lte::rlc_um_lte_tx::build_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
   rlc_umd_pdu_header_t        header = {};
@@ -132,10 +132,10 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
 
   uint32_t to_move = 0;
   uint32_t last_li = 0;
-  uint8_t* pdu_ptr = pdu->msg;
 
+  // The PDU size is kept within what a byte buffer can hold, as the receiving side stores each PDU in one
   int head_len  = rlc_um_packed_length(&header);
-  int pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
+  int pdu_space = SRSRAN_MIN(nof_bytes, byte_buffer_large_payload_size);
 
   if (pdu_space <= head_len + 1) {
     RlcInfo("Cannot build a PDU - %d bytes available, %d bytes required for header", nof_bytes, head_len);
@@ -143,19 +143,16 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
   }
 
   // Check for SDU segment
-  if (tx_sdu) {
+  if (not tx_sdu.empty()) {
     uint32_t space = pdu_space - head_len;
-    to_move        = space >= tx_sdu->N_bytes ? tx_sdu->N_bytes : space;
-    RlcDebug("adding remainder of SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
-    last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
+    to_move        = space >= tx_sdu.size() ? tx_sdu.size() : space;
+    RlcDebug("adding remainder of SDU segment - %d bytes of %d remaining", to_move, tx_sdu.size());
+    // The last segment of the SDU takes the slice over, its metadata is read from the segment
+    byte_buffer_slice segment = tx_sdu.take_front(to_move);
+    last_li                   = to_move;
+    if (tx_sdu.empty()) {
 #ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
+      auto latency_us = segment.md().tp.get_latency_us().count();
       mean_pdu_latency_us.push(latency_us);
       RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
                (uint64_t)latency_us,
@@ -163,15 +160,26 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
 #else
       RlcDebug("%s Complete SDU scheduled for tx.", rb_name.c_str());
 #endif
-      tx_sdu.reset();
     }
-    pdu_space -= SRSRAN_MIN(to_move, pdu->get_tailroom());
+    tx_pdu_data.append(std::move(segment));
+    pdu_space -= to_move;
     header.fi |= RLC_FI_FIELD_NOT_START_ALIGNED; // First byte does not correspond to first byte of SDU
   }
 
+  // Once a single slice is left, the SDU segments are copied into a buffer of their own, which becomes the last slice.
+  // Small SDUs thus do not end the PDU early.
+  unique_byte_buffer_t tail_sdus;
+
   // Pull SDUs from queue
   while (pdu_space > head_len + 1 && tx_sdu_queue.size() > 0) {
     RlcDebug("pdu_space=%d, head_len=%d", pdu_space, head_len);
+    if (tail_sdus == nullptr && tx_pdu_data.nof_slices() + 1 >= RLC_MAX_SLICES) {
+      tail_sdus = make_byte_buffer();
+      if (tail_sdus == nullptr) {
+        RlcInfo("Cannot add more SDUs to the PDU - No buffer available for the last SDU segments");
+        break;
+      }
+    }
     if (last_li > 0) {
       header.li[header.N_li++] = last_li;
     }
@@ -182,18 +190,15 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
       header.N_li--;
       break;
     }
-    tx_sdu  = tx_sdu_queue.read();
-    to_move = (space >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : space;
-    RlcDebug("adding new SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
-    last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
+    tx_sdu  = byte_buffer_slice(tx_sdu_queue.read());
+    to_move = (space >= tx_sdu.size()) ? tx_sdu.size() : space;
+    RlcDebug("adding new SDU segment - %d bytes of %d remaining", to_move, tx_sdu.size());
+    // The last segment of the SDU takes the slice over, its metadata is read from the segment
+    byte_buffer_slice segment = tx_sdu.take_front(to_move);
+    last_li                   = to_move;
+    if (tx_sdu.empty()) {
 #ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
+      auto latency_us = segment.md().tp.get_latency_us().count();
       mean_pdu_latency_us.push(latency_us);
       RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
                (uint64_t)latency_us,
@@ -201,12 +206,19 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
 #else
       RlcDebug("Complete SDU scheduled for tx.");
 #endif
-      tx_sdu.reset();
+    }
+    if (tail_sdus != nullptr) {
+      tail_sdus->append_bytes(segment.data(), segment.size());
+    } else {
+      tx_pdu_data.append(std::move(segment));
     }
     pdu_space -= to_move;
   }
+  if (tail_sdus != nullptr) {
+    tx_pdu_data.append(byte_buffer_slice(std::move(tail_sdus)));
+  }
 
-  if (tx_sdu) {
+  if (not tx_sdu.empty()) {
     header.fi |= RLC_FI_FIELD_NOT_END_ALIGNED; // Last byte does not correspond to last byte of SDU
   }
 
@@ -214,15 +226,18 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
   header.sn = vt_us;
   vt_us     = (vt_us + 1) % cfg.um.tx_mod;
 
-  // Add header and TX
-  rlc_um_write_data_pdu_header(&header, pdu.get());
-  memcpy(payload, pdu->msg, pdu->N_bytes);
+  // Add header and gather the SDU segments into the MAC PDU, the only copy of the payload
+  uint8_t* ptr = payload;
+  rlc_um_write_data_pdu_header(&header, &ptr);
+  ptr += tx_pdu_data.copy_to(ptr);
+  tx_pdu_data.clear();
+  uint32_t pdu_len = ptr - payload;
 
-  RlcHexInfo(payload, pdu->N_bytes, "Tx PDU SN=%d (%d B)", header.sn, pdu->N_bytes);
+  RlcHexInfo(payload, pdu_len, "Tx PDU SN=%d (%d B)", header.sn, pdu_len);
 
   debug_state();
 
-  return pdu->N_bytes;
+  return pdu_len;
 }
 
 void rlc_um_lte::rlc_um_lte_tx::debug_state()
@@ -321,7 +336,7 @@ void rlc_um_lte::rlc_um_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_b
 
   // Write to rx window
   rlc_umd_pdu_t pdu = {};
-  pdu.buf           = make_byte_buffer();
+  pdu.buf           = make_sized_byte_buffer(nof_bytes);
   if (!pdu.buf) {
     RlcError("Discarding packet: no space in buffer pool");
     return;
@@ -761,12 +776,20 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
 
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu)
 {
-  uint32_t i;
-  uint8_t  ext = (header->N_li > 0) ? 1 : 0;
   // Make room for the header
   uint32_t len = rlc_um_packed_length(header);
   pdu->msg -= len;
   uint8_t* ptr = pdu->msg;
+  rlc_um_write_data_pdu_header(header, &ptr);
+  pdu->N_bytes += ptr - pdu->msg;
+}
+
+// Write header to pointer & move pointer
+void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, uint8_t** payload)
+{
+  uint32_t i;
+  uint8_t  ext = (header->N_li > 0) ? 1 : 0;
+  uint8_t* ptr = *payload;
 
   // Fixed part
   if (header->sn_size == rlc_umd_sn_size_t::size5bits) {
@@ -806,7 +829,7 @@ void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* p
   if (header->N_li % 2 == 1)
     ptr++;
 
-  pdu->N_bytes += ptr - pdu->msg;
+  *payload = ptr;
 }
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header)
@@ -136,7 +136,7 @@ bool rlc_um_nr::rlc_um_nr_tx::configure(const rlc_config_t& cnfg_, std::string r
   return true;
 }
 
-uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
+uint32_t rlc_um_nr::rlc_um_nr_tx::build_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   // Sanity check (we need at least 2B for a SDU)
   if (nof_bytes < 2) {
@@ -144,6 +144,12 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
     return 0;
   }
 
+  unique_byte_buffer_t pdu = make_byte_buffer();
+  if (!pdu || pdu->N_bytes != 0) {
+    RlcError("Failed to allocate PDU buffer");
+    return 0;
+  }
+
   std::lock_guard<std::mutex> lock(mutex);
   rlc_um_nr_pdu_header_t      header = {};
   header.si                          = rlc_nr_si_field_t::full_sdu;
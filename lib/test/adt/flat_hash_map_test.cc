@@ -0,0 +1,114 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/flat_hash_map.h"
+#include "srsran/common/test_common.h"
+#include <map>
+#include <random>
+
+namespace srsran {
+
+void test_flat_hash_map()
+{
+  flat_hash_map<uint32_t, std::string> mymap;
+  TESTASSERT(mymap.size() == 0 and mymap.empty());
+  TESTASSERT(mymap.begin() == mymap.end());
+
+  TESTASSERT(not mymap.contains(0));
+  TESTASSERT(mymap.insert(0, "obj0"));
+  TESTASSERT(mymap.contains(0) and mymap[0] == "obj0");
+  TESTASSERT(mymap.size() == 1 and not mymap.empty());
+  TESTASSERT(mymap.begin() != mymap.end());
+
+  TESTASSERT(not mymap.insert(0, "obj0"));
+  TESTASSERT(mymap.insert(1, "obj1"));
+  TESTASSERT(mymap.contains(0) and mymap.contains(1) and mymap[1] == "obj1");
+  TESTASSERT(mymap.size() == 2);
+
+  TESTASSERT(mymap.find(1) != mymap.end());
+  TESTASSERT(mymap.find(1)->first == 1);
+  TESTASSERT(mymap.find(1)->second == "obj1");
+  TESTASSERT(mymap.find(2) == mymap.end());
+  TESTASSERT(mymap.find_value(2) == nullptr);
+  TESTASSERT(*mymap.find_value(0) == "obj0");
+
+  // TEST: iteration
+  uint32_t count = 0;
+  for (const std::pair<uint32_t, std::string>& obj : mymap) {
+    TESTASSERT(obj.second == "obj" + std::to_string(obj.first));
+    count++;
+  }
+  TESTASSERT(count == 2);
+
+  TESTASSERT(mymap.erase(0));
+  TESTASSERT(not mymap.erase(0));
+  TESTASSERT(mymap.erase(1));
+  TESTASSERT(mymap.size() == 0 and mymap.empty());
+
+  mymap[5] = "obj5";
+  TESTASSERT(mymap.size() == 1 and mymap.contains(5));
+  mymap.clear();
+  TESTASSERT(mymap.size() == 0 and mymap.empty() and not mymap.contains(5));
+}
+
+/// Compares the map against std::map under random insertions and erasures, to cover growth and backward shifting
+void test_flat_hash_map_random()
+{
+  flat_hash_map<uint32_t, uint32_t> mymap(4);
+  std::map<uint32_t, uint32_t>      refmap;
+  std::mt19937                      rgen(0);
+
+  for (uint32_t i = 0; i < 20000; ++i) {
+    // Small key range to force collisions and re-insertions of erased keys
+    uint32_t key = rgen() % 512;
+    if (rgen() % 3 == 0) {
+      TESTASSERT(mymap.erase(key) == (refmap.erase(key) > 0));
+    } else {
+      TESTASSERT(mymap.insert(key, i) == refmap.insert(std::make_pair(key, i)).second);
+    }
+    TESTASSERT(mymap.size() == refmap.size());
+  }
+  for (uint32_t key = 0; key < 512; ++key) {
+    auto it = refmap.find(key);
+    if (it == refmap.end()) {
+      TESTASSERT(not mymap.contains(key));
+    } else {
+      TESTASSERT(mymap.contains(key) and mymap[key] == it->second);
+    }
+  }
+  TESTASSERT(mymap.capacity() >= 2 * mymap.size());
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_flat_hash_map();
+  srsran::test_flat_hash_map_random();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,281 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/liblte_common.h"
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace srsran;
+
+static_assert(offsetof(LIBLTE_BYTE_MSG_STRUCT, msg) == sizeof(byte_buffer_t) + byte_buffer_t::headroom,
+              "liblte buffer and byte buffer payloads misaligned");
+static_assert(byte_buffer_large_payload_size == LIBLTE_MAX_MSG_SIZE_BYTES,
+              "liblte buffers must fit in byte buffers of the large size class");
+
+/// Number of buffers held at the same time in the footprint benchmark.
+#define NOF_QUEUED_SDUS 2000
+
+uint64_t get_pool_footprint()
+{
+  sys_metrics_t metrics = {};
+  get_byte_buffer_pool_metrics(metrics);
+  uint64_t footprint = 0;
+  for (uint32_t i = 0; i != nof_byte_buffer_size_classes; ++i) {
+    footprint += (uint64_t)metrics.buffer_pool[i].nof_used * metrics.buffer_pool[i].block_size;
+  }
+  return footprint;
+}
+
+int test_size_class_selection()
+{
+  TESTASSERT(select_byte_buffer_size_class(0) == byte_buffer_size_class::small);
+  TESTASSERT(select_byte_buffer_size_class(byte_buffer_small_payload_size) == byte_buffer_size_class::small);
+  TESTASSERT(select_byte_buffer_size_class(byte_buffer_small_payload_size + 1) == byte_buffer_size_class::medium);
+  TESTASSERT(select_byte_buffer_size_class(byte_buffer_medium_payload_size) == byte_buffer_size_class::medium);
+  TESTASSERT(select_byte_buffer_size_class(byte_buffer_medium_payload_size + 1) == byte_buffer_size_class::large);
+  TESTASSERT(select_byte_buffer_size_class(byte_buffer_large_payload_size + 1) == byte_buffer_size_class::large);
+
+  TESTASSERT(byte_buffer_block_size(byte_buffer_size_class::small) <
+             byte_buffer_block_size(byte_buffer_size_class::medium));
+  TESTASSERT(byte_buffer_block_size(byte_buffer_size_class::medium) <
+             byte_buffer_block_size(byte_buffer_size_class::large));
+  return SRSRAN_SUCCESS;
+}
+
+int test_sized_buffer()
+{
+  uint8_t payload[100];
+  for (uint32_t i = 0; i < sizeof(payload); ++i) {
+    payload[i] = i;
+  }
+
+  // Default buffers keep the maximum capacity
+  unique_byte_buffer_t large = make_byte_buffer();
+  TESTASSERT(large != nullptr);
+  TESTASSERT(large->get_size_class() == byte_buffer_size_class::large);
+  TESTASSERT(large->get_headroom() == byte_buffer_t::headroom);
+  TESTASSERT(large->get_tailroom() == byte_buffer_large_payload_size);
+
+  // Sized buffers provide the same headroom and a reduced tailroom
+  unique_byte_buffer_t small = make_byte_buffer(payload, sizeof(payload), __FUNCTION__);
+  TESTASSERT(small != nullptr);
+  TESTASSERT(small->get_size_class() == byte_buffer_size_class::small);
+  TESTASSERT(small->get_headroom() == byte_buffer_t::headroom);
+  TESTASSERT(small->N_bytes == sizeof(payload));
+  TESTASSERT(small->get_tailroom() == byte_buffer_small_payload_size - sizeof(payload));
+  TESTASSERT(memcmp(small->msg, payload, sizeof(payload)) == 0);
+
+  // Prepending a header uses the headroom
+  small->msg -= 2;
+  small->N_bytes += 2;
+  small->msg[0]      = 0xab;
+  small->msg[1]      = 0xcd;
+  small->md.pdcp_sn  = 7;
+  uint32_t headroom  = small->get_headroom();
+  uint32_t orig_size = small->N_bytes;
+
+  // Growing the buffer preserves headroom, content and metadata
+  TESTASSERT(reserve_byte_buffer_tailroom(small, byte_buffer_small_payload_size));
+  TESTASSERT(small->get_size_class() == byte_buffer_size_class::medium);
+  TESTASSERT(small->get_headroom() == headroom);
+  TESTASSERT(small->N_bytes == orig_size);
+  TESTASSERT(small->md.pdcp_sn == 7);
+  TESTASSERT(small->msg[0] == 0xab and small->msg[1] == 0xcd);
+  TESTASSERT(memcmp(small->msg + 2, payload, sizeof(payload)) == 0);
+  TESTASSERT(small->get_tailroom() >= byte_buffer_small_payload_size);
+
+  // No reallocation when there is enough tailroom
+  byte_buffer_t* ptr = small.get();
+  TESTASSERT(reserve_byte_buffer_tailroom(small, 4));
+  TESTASSERT(small.get() == ptr);
+
+  // Growing beyond the largest class fails and leaves the buffer untouched
+  TESTASSERT(not reserve_byte_buffer_tailroom(small, byte_buffer_large_payload_size + 1));
+  TESTASSERT(small.get() == ptr);
+
+  // Copy assignment falls back to the default headroom when the source one does not fit
+  unique_byte_buffer_t tiny = make_byte_buffer(byte_buffer_size_class::small);
+  TESTASSERT(tiny != nullptr);
+  large->msg += byte_buffer_small_payload_size;
+  large->N_bytes = byte_buffer_small_payload_size;
+  *tiny          = *large;
+  TESTASSERT(tiny->get_headroom() == byte_buffer_t::headroom);
+  TESTASSERT(tiny->N_bytes == byte_buffer_small_payload_size);
+  TESTASSERT(tiny->get_tailroom() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_buffer_storage()
+{
+  // The storage of pooled buffers lies within their pool block
+  for (uint32_t i = 0; i != nof_byte_buffer_size_classes; ++i) {
+    byte_buffer_size_class cls = static_cast<byte_buffer_size_class>(i);
+    unique_byte_buffer_t   buf = make_byte_buffer(cls);
+    TESTASSERT(buf != nullptr);
+    TESTASSERT(buf->get_size_class() == cls);
+    uint8_t* block_end =
+        reinterpret_cast<uint8_t*>(buf.get()) - byte_buffer_block_prefix_size + byte_buffer_block_size(cls);
+    TESTASSERT(buf->buffer == reinterpret_cast<uint8_t*>(buf.get() + 1));
+    TESTASSERT(buf->msg + buf->get_tailroom() == block_end);
+    // The NAS code overlays liblte messages on large buffers
+    TESTASSERT(cls != byte_buffer_size_class::large or
+               reinterpret_cast<LIBLTE_BYTE_MSG_STRUCT*>(buf.get())->msg == buf->msg);
+  }
+
+  // Plain objects own a storage of the large size class, also when copied from a pooled buffer
+  uint8_t payload[byte_buffer_small_payload_size / 2];
+  for (uint32_t i = 0; i < sizeof(payload); ++i) {
+    payload[i] = i;
+  }
+  unique_byte_buffer_t small = make_byte_buffer(byte_buffer_size_class::small);
+  TESTASSERT(small != nullptr);
+  small->append_bytes(payload, sizeof(payload));
+  byte_buffer_t copy(*small);
+  TESTASSERT(copy.get_size_class() == byte_buffer_size_class::large);
+  TESTASSERT(copy.buffer != small->buffer);
+  TESTASSERT(copy.N_bytes == small->N_bytes);
+  TESTASSERT(memcmp(copy.msg, small->msg, small->N_bytes) == 0);
+  TESTASSERT(copy.get_tailroom() == byte_buffer_large_payload_size - small->N_bytes);
+
+  byte_buffer_t assigned;
+  assigned = copy;
+  TESTASSERT(assigned.N_bytes == copy.N_bytes);
+  TESTASSERT(memcmp(assigned.msg, copy.msg, copy.N_bytes) == 0);
+
+  // Content that fits is accepted into a small buffer up to its last byte
+  copy.N_bytes = byte_buffer_small_payload_size;
+  *small       = copy;
+  TESTASSERT(small->N_bytes == byte_buffer_small_payload_size);
+  TESTASSERT(small->get_tailroom() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_pool_metrics()
+{
+  sys_metrics_t before = {};
+  get_byte_buffer_pool_metrics(before);
+  {
+    unique_byte_buffer_t a = make_sized_byte_buffer(40);
+    unique_byte_buffer_t b = make_sized_byte_buffer(1500);
+    unique_byte_buffer_t c = make_byte_buffer();
+    TESTASSERT(a != nullptr and b != nullptr and c != nullptr);
+
+    sys_metrics_t during = {};
+    get_byte_buffer_pool_metrics(during);
+    for (uint32_t i = 0; i != nof_byte_buffer_size_classes; ++i) {
+      TESTASSERT(during.buffer_pool[i].nof_used == before.buffer_pool[i].nof_used + 1);
+      TESTASSERT(during.buffer_pool[i].max_used >= during.buffer_pool[i].nof_used);
+      TESTASSERT(during.buffer_pool[i].payload_size ==
+                 get_byte_buffer_payload_size(static_cast<byte_buffer_size_class>(i)));
+    }
+  }
+  sys_metrics_t after = {};
+  get_byte_buffer_pool_metrics(after);
+  for (uint32_t i = 0; i != nof_byte_buffer_size_classes; ++i) {
+    TESTASSERT(after.buffer_pool[i].nof_used == before.buffer_pool[i].nof_used);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// Generates the SDU sizes of a traffic mix of TCP ACKs, VoIP frames, signalling and full-size IP packets.
+std::vector<uint32_t> make_mixed_traffic(uint32_t nof_sdus)
+{
+  std::mt19937                            rgen(1234);
+  std::uniform_int_distribution<uint32_t> type_dist(0, 99);
+  std::vector<uint32_t>                   sizes(nof_sdus);
+  for (uint32_t& sz : sizes) {
+    uint32_t type = type_dist(rgen);
+    if (type < 45) {
+      sz = std::uniform_int_distribution<uint32_t>(40, 80)(rgen);
+    } else if (type < 65) {
+      sz = std::uniform_int_distribution<uint32_t>(60, 250)(rgen);
+    } else if (type < 75) {
+      sz = std::uniform_int_distribution<uint32_t>(300, 1200)(rgen);
+    } else {
+      sz = std::uniform_int_distribution<uint32_t>(1300, 1500)(rgen);
+    }
+  }
+  return sizes;
+}
+
+/// Holds a queue of SDUs with a mixed traffic profile, as the PDCP undelivered SDU queue or an RLC rx window would,
+/// and reports the pool memory held with and without size classes.
+int test_mixed_traffic_footprint()
+{
+  std::vector<uint32_t> sizes = make_mixed_traffic(NOF_QUEUED_SDUS);
+  uint8_t               payload[1500];
+  for (uint32_t i = 0; i < sizeof(payload); ++i) {
+    payload[i] = i;
+  }
+
+  uint64_t footprint[2] = {};
+  double   elapsed_us[2] = {};
+  for (uint32_t sized = 0; sized < 2; ++sized) {
+    uint64_t                          base = get_pool_footprint();
+    std::vector<unique_byte_buffer_t> queue;
+    queue.reserve(sizes.size());
+
+    auto t_start = std::chrono::high_resolution_clock::now();
+    for (uint32_t sz : sizes) {
+      unique_byte_buffer_t buf = sized ? make_sized_byte_buffer(sz) : make_byte_buffer();
+      TESTASSERT(buf != nullptr);
+      memcpy(buf->msg, payload, sz);
+      buf->N_bytes = sz;
+      queue.push_back(std::move(buf));
+    }
+    auto t_end = std::chrono::high_resolution_clock::now();
+
+    footprint[sized]  = get_pool_footprint() - base;
+    elapsed_us[sized] = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start).count() / 1000.0;
+
+    for (uint32_t i = 0; i < sizes.size(); ++i) {
+      TESTASSERT(queue[i]->N_bytes == sizes[i]);
+      TESTASSERT(memcmp(queue[i]->msg, payload, sizes[i]) == 0);
+    }
+  }
+
+  printf("Mixed traffic footprint for %d queued SDUs:\n", NOF_QUEUED_SDUS);
+  printf("  single class: %7.1f kB (%.1f us to fill)\n", footprint[0] / 1024.0, elapsed_us[0]);
+  printf("  size classes: %7.1f kB (%.1f us to fill)\n", footprint[1] / 1024.0, elapsed_us[1]);
+  TESTASSERT(footprint[0] == (uint64_t)NOF_QUEUED_SDUS * byte_buffer_block_size(byte_buffer_size_class::large));
+  TESTASSERT(footprint[1] < footprint[0]);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(test_size_class_selection() == SRSRAN_SUCCESS);
+  TESTASSERT(test_sized_buffer() == SRSRAN_SUCCESS);
+  TESTASSERT(test_buffer_storage() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pool_metrics() == SRSRAN_SUCCESS);
+  TESTASSERT(test_mixed_traffic_footprint() == SRSRAN_SUCCESS);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
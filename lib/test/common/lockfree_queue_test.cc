@@ -0,0 +1,178 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/lockfree_queue.h"
+#include "srsran/common/test_common.h"
+#include <memory>
+#include <sys/time.h>
+#include <thread>
+#include <vector>
+
+using namespace srsran;
+
+template <typename Queue>
+int test_fifo_order()
+{
+  Queue q(5);
+  TESTASSERT(q.empty() and q.capacity() == 5);
+
+  // Wrap around the ring a few times
+  int val = 0;
+  for (int lap = 0; lap < 3; ++lap) {
+    for (int i = 0; i < 5; ++i) {
+      TESTASSERT(q.try_push(lap * 5 + i));
+    }
+    TESTASSERT(q.full() and q.size() == 5);
+    TESTASSERT(not q.try_push(-1));
+    for (int i = 0; i < 5; ++i) {
+      TESTASSERT(q.try_pop(val));
+      TESTASSERT(val == lap * 5 + i);
+    }
+    TESTASSERT(q.empty());
+    TESTASSERT(not q.try_pop(val));
+  }
+  return SRSRAN_SUCCESS;
+}
+
+template <typename Queue>
+int test_move_only()
+{
+  Queue q(1);
+  TESTASSERT(q.try_push(std::unique_ptr<int>(new int{1})).has_value());
+
+  // a failed push gives the object back
+  auto ret = q.try_push(std::unique_ptr<int>(new int{2}));
+  TESTASSERT(ret.is_error());
+  TESTASSERT(ret.error() != nullptr and *ret.error() == 2);
+
+  std::unique_ptr<int> p;
+  TESTASSERT(q.try_pop(p));
+  TESTASSERT(*p == 1);
+  TESTASSERT(q.try_push(std::move(ret.error())).has_value());
+  TESTASSERT(q.try_pop(p));
+  TESTASSERT(*p == 2);
+  return SRSRAN_SUCCESS;
+}
+
+int test_spsc_threads()
+{
+  const int                        N = 100000;
+  blocking_queue<spsc_queue<int> > q(16);
+
+  std::thread producer([&q]() {
+    for (int i = 0; i < N; ++i) {
+      q.push(i);
+    }
+  });
+  int  val = 0;
+  bool ok  = true;
+  for (int i = 0; i < N; ++i) {
+    q.pop(val);
+    ok &= (val == i);
+  }
+  producer.join();
+  TESTASSERT(ok);
+  TESTASSERT(q.empty());
+  return SRSRAN_SUCCESS;
+}
+
+int test_mpsc_threads()
+{
+  const int                        nof_producers = 4, N = 50000;
+  blocking_queue<mpsc_queue<int> > q(64);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&q, p]() {
+      for (int i = 0; i < N; ++i) {
+        q.push(p * N + i);
+      }
+    });
+  }
+
+  // the order of each producer must be preserved
+  std::vector<int> last(nof_producers, -1);
+  int64_t          sum = 0;
+  bool             ok  = true;
+  for (int i = 0; i < nof_producers * N; ++i) {
+    int v = 0;
+    q.pop(v);
+    ok &= (v % N > last[v / N]);
+    last[v / N] = v % N;
+    sum += v;
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  int64_t M = nof_producers * N;
+  TESTASSERT(ok);
+  TESTASSERT(sum == M * (M - 1) / 2);
+  TESTASSERT(q.empty());
+  return SRSRAN_SUCCESS;
+}
+
+int test_blocking_stop()
+{
+  blocking_queue<mpsc_queue<int> > q(2);
+
+  // timed_pop times out on an empty queue
+  struct timeval  now;
+  struct timespec abstime;
+  gettimeofday(&now, nullptr);
+  abstime.tv_sec  = now.tv_sec;
+  abstime.tv_nsec = now.tv_usec * 1000 + 10000000;
+  if (abstime.tv_nsec >= 1000000000) {
+    abstime.tv_sec++;
+    abstime.tv_nsec -= 1000000000;
+  }
+  int val = 0;
+  TESTASSERT(not q.timed_pop(val, &abstime));
+
+  // blocked producer and consumer are released by stop()
+  TESTASSERT(q.push(1) and q.push(2));
+  bool        push_ret = true;
+  std::thread producer([&q, &push_ret]() { push_ret = q.push(3); });
+  usleep(10000);
+  q.stop();
+  producer.join();
+  TESTASSERT(not push_ret);
+
+  // queued elements can still be drained, but blocking pops no longer wait
+  TESTASSERT(q.pop(val) and val == 1);
+  TESTASSERT(q.pop(val) and val == 2);
+  TESTASSERT(not q.pop(val));
+  TESTASSERT(not q.push(4));
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_fifo_order<spsc_queue<int> >() == SRSRAN_SUCCESS);
+  TESTASSERT(test_fifo_order<mpsc_queue<int> >() == SRSRAN_SUCCESS);
+  TESTASSERT(test_fifo_order<blocking_queue<mpsc_queue<int> > >() == SRSRAN_SUCCESS);
+  TESTASSERT(test_move_only<spsc_queue<std::unique_ptr<int> > >() == SRSRAN_SUCCESS);
+  TESTASSERT(test_move_only<mpsc_queue<std::unique_ptr<int> > >() == SRSRAN_SUCCESS);
+  TESTASSERT(test_spsc_threads() == SRSRAN_SUCCESS);
+  TESTASSERT(test_mpsc_threads() == SRSRAN_SUCCESS);
+  TESTASSERT(test_blocking_stop() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
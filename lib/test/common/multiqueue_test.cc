@@ -306,6 +306,49 @@ int test_multiqueue_threading4()
   return 0;
 }
 
+int test_multiqueue_many_queues()
+{
+  std::cout << "\n===== TEST multiqueue many queues test: start =====\n";
+
+  const int                      nof_queues = 3 * MULTIQUEUE_INIT_TABLE_SIZE + 1;
+  multiqueue_handler<int>        multiqueue(4);
+  std::vector<queue_handle<int>> qids;
+  std::vector<int>               popped;
+
+  // the consumer pops while the table of queues grows
+  std::thread t([&multiqueue, &popped]() {
+    int number = 0;
+    while (multiqueue.wait_pop(&number)) {
+      popped.push_back(number);
+    }
+  });
+
+  for (int i = 0; i < nof_queues; ++i) {
+    qids.push_back(multiqueue.add_queue());
+    TESTASSERT(qids.back().active());
+    qids.back().push(i);
+  }
+  TESTASSERT(multiqueue.nof_queues() == (uint32_t)nof_queues);
+  while (std::any_of(qids.begin(), qids.end(), [](const queue_handle<int>& q) { return not q.empty(); })) {
+    usleep(100);
+  }
+
+  // stop() returns once the blocked consumer leaves
+  multiqueue.stop();
+  t.join();
+
+  TESTASSERT(popped.size() == (size_t)nof_queues);
+  std::sort(popped.begin(), popped.end());
+  for (int i = 0; i < nof_queues; ++i) {
+    TESTASSERT(popped[i] == i);
+  }
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===========================================\n";
+
+  return 0;
+}
+
 int test_task_thread_pool()
 {
   std::cout << "\n====== TEST task thread pool test 1: start ======\n";
@@ -499,6 +542,7 @@ int main()
   TESTASSERT(test_multiqueue_threading2() == 0);
   TESTASSERT(test_multiqueue_threading3() == 0);
   TESTASSERT(test_multiqueue_threading4() == 0);
+  TESTASSERT(test_multiqueue_many_queues() == 0);
 
   TESTASSERT(test_task_thread_pool() == 0);
   TESTASSERT(test_task_thread_pool2() == 0);
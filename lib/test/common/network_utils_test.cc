@@ -130,6 +130,68 @@ int test_socket_handler()
   return 0;
 }
 
+int test_udp_burst_handler()
+{
+  auto& logger = srslog::fetch_basic_logger("S1AP", false);
+
+  srsran::unique_socket  server_socket, server_socket2, client_socket;
+  srsran::socket_manager sockhandler;
+  using namespace srsran::net_utils;
+
+  TESTASSERT(server_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(server_socket.bind_addr("127.0.0.1", 0));
+  TESTASSERT(server_socket2.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(server_socket2.bind_addr("127.0.0.1", 0));
+  TESTASSERT(client_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+
+  // register a burst handler and a single PDU handler, both receiving from the same client
+  std::atomic<int>  counter = {0}, counter2 = {0};
+  std::atomic<bool> in_order = {true};
+  auto              burst_handler = [&](srsran::span<srsran::rx_datagram_t> burst) {
+    for (srsran::rx_datagram_t& datagram : burst) {
+      in_order = in_order and datagram.pdu->N_bytes == 4 and datagram.pdu->msg[0] == (uint8_t)counter;
+      counter++;
+    }
+  };
+  auto pdu_handler = [&](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+    in_order = in_order and pdu->msg[0] == (uint8_t)counter2;
+    counter2++;
+  };
+  rx_thread_tester rx_tester;
+  TESTASSERT(sockhandler.add_socket_handler(
+      server_socket.fd(), srsran::make_sdu_burst_handler(logger, rx_tester.task_queue, burst_handler)));
+  TESTASSERT(sockhandler.add_socket_handler(server_socket2.fd(),
+                                            srsran::make_sdu_handler(logger, rx_tester.task_queue, pdu_handler)));
+
+  // send more datagrams than fit in a single burst
+  const int nof_counts = 3 * srsran::max_rx_burst_size + 5;
+  for (const srsran::unique_socket* server : {&server_socket, &server_socket2}) {
+    sockaddr_in server_addrin = {};
+    socklen_t   socklen       = sizeof(server_addrin);
+    TESTASSERT(getsockname(server->fd(), (struct sockaddr*)&server_addrin, &socklen) == 0);
+    for (int i = 0; i < nof_counts; ++i) {
+      uint8_t buf[4] = {(uint8_t)i};
+      TESTASSERT(sendto(client_socket.fd(), buf, sizeof(buf), 0, (struct sockaddr*)&server_addrin, socklen) == 4);
+    }
+  }
+
+  uint32_t time_elapsed = 0;
+  while (counter != nof_counts or counter2 != nof_counts) {
+    usleep(100);
+    time_elapsed += 100;
+    if (time_elapsed > 3000000) {
+      // too much time has passed
+      return -1;
+    }
+  }
+  TESTASSERT(in_order);
+
+  TESTASSERT(sockhandler.remove_socket(server_socket.fd()));
+  TESTASSERT(sockhandler.remove_socket(server_socket2.fd()));
+  TESTASSERT(not sockhandler.remove_socket(server_socket2.fd()));
+  return SRSRAN_SUCCESS;
+}
+
 int test_sctp_bind_error()
 {
   srsran::unique_socket sock;
@@ -157,6 +219,7 @@ int main()
   srslog::init();
 
   TESTASSERT(test_socket_handler() == 0);
+  TESTASSERT(test_udp_burst_handler() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
 
   return 0;
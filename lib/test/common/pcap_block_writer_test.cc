@@ -0,0 +1,297 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap.h"
+#include "srsran/common/pcap_block_writer.h"
+#include "srsran/common/test_common.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+using namespace srsran;
+
+static const uint32_t test_dlt = UDP_DLT;
+
+static std::vector<uint8_t> read_file(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static uint32_t get_u32(const uint8_t* ptr)
+{
+  uint32_t value;
+  memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+/// Writes records made of a 2-byte context header followed by a PDU whose bytes are all equal to the sequence number
+static void write_records(pcap_block_writer& writer, uint32_t first_sn, uint32_t nof_records)
+{
+  const uint8_t header[2] = {0xaa, 0xbb};
+  uint8_t       pdu[64];
+  for (uint32_t sn = first_sn; sn < first_sn + nof_records; ++sn) {
+    uint32_t pdu_len = 1 + sn % sizeof(pdu);
+    memset(pdu, sn, pdu_len);
+    TESTASSERT(writer.write_record(header, sizeof(header), pdu, pdu_len));
+  }
+}
+
+/// Checks the captured bytes of a record written by write_records()
+static bool check_record(const uint8_t* data, uint32_t cap_len, uint32_t sn)
+{
+  uint32_t pdu_len = 1 + sn % 64;
+  if (cap_len != 2 + pdu_len or data[0] != 0xaa or data[1] != 0xbb) {
+    return false;
+  }
+  for (uint32_t i = 0; i < pdu_len; ++i) {
+    if (data[2 + i] != (uint8_t)sn) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Parses a classic PCAP file and checks its records, starting with the sequence number "sn"
+static int check_pcap_file(const std::string& filename, uint32_t& sn)
+{
+  std::vector<uint8_t> file = read_file(filename);
+  TESTASSERT(file.size() >= sizeof(pcap_hdr_t));
+  pcap_hdr_t file_header;
+  memcpy(&file_header, file.data(), sizeof(file_header));
+  TESTASSERT(file_header.magic_number == 0xa1b2c3d4);
+  TESTASSERT(file_header.version_major == 2 and file_header.version_minor == 4);
+  TESTASSERT(file_header.network == test_dlt);
+
+  size_t offset = sizeof(pcap_hdr_t);
+  while (offset < file.size()) {
+    pcaprec_hdr_t rec_header;
+    TESTASSERT(offset + sizeof(rec_header) <= file.size());
+    memcpy(&rec_header, &file[offset], sizeof(rec_header));
+    offset += sizeof(rec_header);
+    TESTASSERT(rec_header.incl_len == rec_header.orig_len);
+    TESTASSERT(offset + rec_header.incl_len <= file.size());
+    TESTASSERT(check_record(&file[offset], rec_header.incl_len, sn++));
+    offset += rec_header.incl_len;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_pcap_format()
+{
+  const std::string  filename = "pcap_block_writer_test.pcap";
+  pcap_block_writer  writer(srslog::fetch_basic_logger("PCAP"));
+  pcap_writer_args_t args;
+  args.block_size      = 4096;
+  args.nof_blocks      = 4;
+  args.flush_period_ms = 10;
+
+  TESTASSERT(writer.open(filename, test_dlt, args));
+  TESTASSERT(writer.is_open());
+  write_records(writer, 0, 200);
+  writer.close();
+  TESTASSERT(not writer.is_open());
+
+  pcap_writer_metrics_t metrics = writer.get_metrics();
+  TESTASSERT(metrics.nof_pdus == 200 and metrics.nof_dropped == 0 and metrics.nof_files == 1);
+
+  uint32_t sn = 0;
+  TESTASSERT(check_pcap_file(filename, sn) == SRSRAN_SUCCESS);
+  TESTASSERT(sn == 200);
+  remove(filename.c_str());
+  return SRSRAN_SUCCESS;
+}
+
+int test_pcapng_format()
+{
+  const std::string  filename = "pcap_block_writer_test.pcapng";
+  pcap_block_writer  writer(srslog::fetch_basic_logger("PCAP"));
+  pcap_writer_args_t args;
+  args.format          = pcap_format_t::pcapng;
+  args.block_size      = 8192;
+  args.nof_blocks      = 4;
+  args.flush_period_ms = 10;
+
+  TESTASSERT(writer.open(filename, test_dlt, args));
+  write_records(writer, 0, 200);
+  writer.close();
+
+  std::vector<uint8_t> file = read_file(filename);
+  TESTASSERT(file.size() >= 48);
+  // Section header block, followed by the interface description block
+  TESTASSERT(get_u32(&file[0]) == 0x0a0d0d0a and get_u32(&file[4]) == 28 and get_u32(&file[8]) == 0x1a2b3c4d);
+  TESTASSERT(get_u32(&file[24]) == 28);
+  TESTASSERT(get_u32(&file[28]) == 1 and get_u32(&file[32]) == 20);
+  TESTASSERT((get_u32(&file[36]) & 0xffffU) == test_dlt and get_u32(&file[40]) == 65535);
+  TESTASSERT(get_u32(&file[44]) == 20);
+
+  // Enhanced packet blocks
+  size_t   offset = 48;
+  uint32_t sn     = 0;
+  while (offset < file.size()) {
+    TESTASSERT(offset + 32 <= file.size());
+    uint32_t block_len = get_u32(&file[offset + 4]);
+    uint32_t cap_len   = get_u32(&file[offset + 20]);
+    TESTASSERT(get_u32(&file[offset]) == 6);
+    TESTASSERT(block_len % 4 == 0 and block_len == 32 + ((cap_len + 3) & ~3U));
+    TESTASSERT(offset + block_len <= file.size());
+    TESTASSERT(get_u32(&file[offset + 8]) == 0 and get_u32(&file[offset + 24]) == cap_len);
+    TESTASSERT(get_u32(&file[offset + block_len - 4]) == block_len);
+    TESTASSERT(check_record(&file[offset + 28], cap_len, sn++));
+    offset += block_len;
+  }
+  TESTASSERT(sn == 200);
+  remove(filename.c_str());
+  return SRSRAN_SUCCESS;
+}
+
+int test_size_rotation()
+{
+  const std::string  filename = "pcap_block_writer_test_rotation.pcap";
+  pcap_block_writer  writer(srslog::fetch_basic_logger("PCAP"));
+  pcap_writer_args_t args;
+  args.block_size      = 512;
+  args.nof_blocks      = 128;
+  args.max_file_size   = 2048;
+  args.flush_period_ms = 10;
+
+  TESTASSERT(writer.open(filename, test_dlt, args));
+  TESTASSERT(writer.get_filename(0) == filename);
+  TESTASSERT(writer.get_filename(2) == "pcap_block_writer_test_rotation_2.pcap");
+  write_records(writer, 0, 500);
+  writer.close();
+
+  // Records are spread over several files, in order, and no file exceeds the maximum size
+  pcap_writer_metrics_t metrics = writer.get_metrics();
+  TESTASSERT(metrics.nof_pdus == 500 and metrics.nof_dropped == 0 and metrics.nof_files > 1);
+  uint32_t sn = 0;
+  for (uint32_t i = 0; i < metrics.nof_files; ++i) {
+    std::string name = writer.get_filename(i);
+    TESTASSERT(read_file(name).size() <= sizeof(pcap_hdr_t) + args.max_file_size);
+    TESTASSERT(check_pcap_file(name, sn) == SRSRAN_SUCCESS);
+    remove(name.c_str());
+  }
+  TESTASSERT(sn == 500);
+  return SRSRAN_SUCCESS;
+}
+
+int test_concurrent_producers()
+{
+  const std::string  filename      = "pcap_block_writer_test_concurrent.pcap";
+  const uint32_t     nof_threads   = 4;
+  const uint32_t     nof_records   = 5000;
+  const uint32_t     max_record_sz = sizeof(pcaprec_hdr_t) + 2 + 64;
+  pcap_block_writer  writer(srslog::fetch_basic_logger("PCAP"));
+  pcap_writer_args_t args;
+  args.block_size = 4096;
+  // Enough blocks to hold every record, so that none is dropped however slow the writer thread is
+  args.nof_blocks      = nof_threads * nof_records * max_record_sz / args.block_size + 1;
+  args.flush_period_ms = 10;
+
+  TESTASSERT(writer.open(filename, test_dlt, args));
+  std::vector<std::thread> producers;
+  for (uint32_t id = 0; id < nof_threads; ++id) {
+    producers.emplace_back([&writer, id, nof_records]() {
+      const uint8_t header[2] = {(uint8_t)id, 0xbb};
+      uint8_t       pdu[64];
+      for (uint32_t sn = 0; sn < nof_records; ++sn) {
+        uint32_t pdu_len = 1 + sn % sizeof(pdu);
+        memset(pdu, sn, pdu_len);
+        writer.write_record(header, sizeof(header), pdu, pdu_len);
+      }
+    });
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  writer.close();
+
+  pcap_writer_metrics_t metrics = writer.get_metrics();
+  TESTASSERT(metrics.nof_pdus == nof_threads * nof_records and metrics.nof_dropped == 0);
+
+  // Records of different producers are interleaved, but those of each producer are complete and in order
+  std::vector<uint8_t>  file = read_file(filename);
+  std::vector<uint32_t> next_sn(nof_threads, 0);
+  size_t                offset = sizeof(pcap_hdr_t);
+  while (offset < file.size()) {
+    pcaprec_hdr_t rec_header;
+    TESTASSERT(offset + sizeof(rec_header) <= file.size());
+    memcpy(&rec_header, &file[offset], sizeof(rec_header));
+    offset += sizeof(rec_header);
+    TESTASSERT(offset + rec_header.incl_len <= file.size() and rec_header.incl_len > 2);
+    uint32_t id = file[offset];
+    TESTASSERT(id < nof_threads and file[offset + 1] == 0xbb);
+    uint32_t sn = next_sn[id]++;
+    TESTASSERT(rec_header.incl_len == 3 + sn % 64);
+    for (uint32_t i = 2; i < rec_header.incl_len; ++i) {
+      TESTASSERT(file[offset + i] == (uint8_t)sn);
+    }
+    offset += rec_header.incl_len;
+  }
+  for (uint32_t id = 0; id < nof_threads; ++id) {
+    TESTASSERT(next_sn[id] == nof_records);
+  }
+  remove(filename.c_str());
+  return SRSRAN_SUCCESS;
+}
+
+int test_drops()
+{
+  const std::string  filename = "pcap_block_writer_test_drops.pcap";
+  pcap_block_writer  writer(srslog::fetch_basic_logger("PCAP"));
+  pcap_writer_args_t args;
+  args.block_size = 256;
+  args.nof_blocks = 2;
+
+  // Records are rejected while the writer is closed
+  uint8_t pdu[512] = {};
+  TESTASSERT(not writer.write_record(nullptr, 0, pdu, 10));
+
+  // Records that do not fit in a write block are dropped
+  TESTASSERT(writer.open(filename, test_dlt, args));
+  TESTASSERT(writer.write_record(nullptr, 0, pdu, 100));
+  TESTASSERT(not writer.write_record(nullptr, 0, pdu, sizeof(pdu)));
+  writer.close();
+  TESTASSERT(not writer.write_record(nullptr, 0, pdu, 10));
+
+  pcap_writer_metrics_t metrics = writer.get_metrics();
+  TESTASSERT(metrics.nof_pdus == 1 and metrics.nof_bytes == 100 and metrics.nof_dropped == 1);
+  TESTASSERT(read_file(filename).size() == sizeof(pcap_hdr_t) + sizeof(pcaprec_hdr_t) + 100);
+  remove(filename.c_str());
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_pcap_format() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pcapng_format() == SRSRAN_SUCCESS);
+  TESTASSERT(test_size_rotation() == SRSRAN_SUCCESS);
+  TESTASSERT(test_concurrent_producers() == SRSRAN_SUCCESS);
+  TESTASSERT(test_drops() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
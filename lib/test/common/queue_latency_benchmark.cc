@@ -0,0 +1,179 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/block_queue.h"
+#include "srsran/common/lockfree_queue.h"
+#include "srsran/common/multiqueue.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <getopt.h>
+#include <thread>
+#include <vector>
+
+using namespace srsran;
+
+static uint32_t nof_msgs       = 100000;
+static uint32_t nof_producers  = 1;
+static uint32_t push_period_ns = 1000;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [npt]\n", prog);
+  printf("\t-n number of messages per producer [Default %d]\n", nof_msgs);
+  printf("\t-p number of producer threads [Default %d]\n", nof_producers);
+  printf("\t-t time between pushes of a producer in ns [Default %d]\n", push_period_ns);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:p:t:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_msgs = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'p':
+        nof_producers = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 't':
+        push_period_ns = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+using bench_clock = std::chrono::steady_clock;
+
+static int64_t now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now().time_since_epoch()).count();
+}
+
+/// Spins until the given time, so that producers push at a fixed rate without sleeping
+static void spin_until(int64_t t_ns)
+{
+  while (now_ns() < t_ns) {
+  }
+}
+
+/**
+ * Each producer pushes its own timestamp, and the consumer stores the push-to-pop delay of every message.
+ * @param push function that pushes a timestamp from a producer thread
+ * @param pop blocking pop run by the consumer thread
+ */
+void benchmark(const char*                          name,
+               uint32_t                             producers,
+               const std::function<void(int64_t)>&  push,
+               const std::function<bool(int64_t&)>& pop)
+{
+  uint32_t             total = producers * nof_msgs;
+  std::vector<int64_t> delays;
+  delays.reserve(total);
+
+  std::thread consumer([&]() {
+    int64_t ts = 0;
+    for (uint32_t i = 0; i < total and pop(ts); ++i) {
+      delays.push_back(now_ns() - ts);
+    }
+  });
+  std::vector<std::thread> threads;
+  for (uint32_t p = 0; p < producers; ++p) {
+    threads.emplace_back([&push]() {
+      int64_t t_next = now_ns();
+      for (uint32_t i = 0; i < nof_msgs; ++i) {
+        t_next += push_period_ns;
+        spin_until(t_next);
+        push(now_ns());
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  consumer.join();
+  TESTASSERT(delays.size() == total);
+
+  std::sort(delays.begin(), delays.end());
+  auto percentile = [&delays](double p) {
+    return delays[std::min(delays.size() - 1, (size_t)(p * delays.size() / 100.0))] / 1000.0;
+  };
+  printf("%-24s %2d producer(s): p50=%7.2f us, p99=%7.2f us, p99.9=%8.2f us, max=%8.2f us\n",
+         name,
+         producers,
+         percentile(50),
+         percentile(99),
+         percentile(99.9),
+         delays.back() / 1000.0);
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  const uint32_t capacity = 1024;
+
+  {
+    block_queue<int64_t> q(capacity);
+    benchmark(
+        "block_queue",
+        nof_producers,
+        [&q](int64_t ts) { q.push(ts); },
+        [&q](int64_t& ts) {
+          ts = q.wait_pop();
+          return true;
+        });
+  }
+
+  if (nof_producers == 1) {
+    blocking_queue<spsc_queue<int64_t> > q(capacity);
+    benchmark(
+        "blocking spsc_queue",
+        1,
+        [&q](int64_t ts) { q.push(ts); },
+        [&q](int64_t& ts) { return q.pop(ts); });
+  }
+
+  {
+    blocking_queue<mpsc_queue<int64_t> > q(capacity);
+    benchmark(
+        "blocking mpsc_queue",
+        nof_producers,
+        [&q](int64_t ts) { q.push(ts); },
+        [&q](int64_t& ts) { return q.pop(ts); });
+  }
+
+  {
+    multiqueue_handler<int64_t>               mq(capacity);
+    multiqueue_handler<int64_t>::queue_handle qh = mq.add_queue();
+    benchmark(
+        "multiqueue_handler",
+        nof_producers,
+        [&qh](int64_t ts) { qh.push(ts); },
+        [&mq](int64_t& ts) { return mq.wait_pop(&ts); });
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/rcu.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+#include <vector>
+
+using namespace srsran;
+
+int test_deferred_reclaim()
+{
+  rcu_domain rcu;
+  int        nof_deleted = 0;
+
+  // Without readers, the grace period elapses right away
+  rcu.retire([&nof_deleted]() { nof_deleted++; });
+  TESTASSERT(rcu.reclaim() == 0 and nof_deleted == 1);
+
+  // An ongoing read-side section delays the deletion, even across several reclaim attempts
+  uint32_t token = rcu.read_lock();
+  rcu.retire([&nof_deleted]() { nof_deleted++; });
+  TESTASSERT(rcu.reclaim() == 1 and rcu.reclaim() == 1 and nof_deleted == 1);
+
+  // Read-side sections started after the retire do not delay the deletion
+  rcu.read_unlock(token);
+  token = rcu.read_lock();
+  TESTASSERT(rcu.reclaim() == 0 and nof_deleted == 2);
+
+  // Objects retired during an ongoing grace period wait for the next one
+  rcu.retire([&nof_deleted]() { nof_deleted++; });
+  TESTASSERT(rcu.reclaim() == 1);
+  uint32_t token2 = rcu.read_lock();
+  rcu.read_unlock(token);
+  rcu.retire([&nof_deleted]() { nof_deleted++; });
+  TESTASSERT(rcu.reclaim() == 1 and nof_deleted == 3);
+  rcu.read_unlock(token2);
+  TESTASSERT(rcu.reclaim() == 0 and nof_deleted == 4);
+  return SRSRAN_SUCCESS;
+}
+
+/// Readers keep dereferencing the published object, while the writer replaces and retires it. Deleted objects are
+/// poisoned, so that a reader accessing a deleted object is detected
+int test_concurrent_readers()
+{
+  struct obj_t {
+    std::atomic<int> val{42};
+  };
+  const int             nof_updates = 10000;
+  rcu_domain            rcu;
+  std::atomic<obj_t*>   published{new obj_t{}};
+  std::atomic<bool>     running{true};
+  std::atomic<uint32_t> nof_errors{0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      while (running.load(std::memory_order_relaxed)) {
+        rcu_read_guard lock(rcu);
+        obj_t*         obj = published.load(std::memory_order_acquire);
+        if (obj->val.load(std::memory_order_relaxed) != 42) {
+          nof_errors++;
+        }
+      }
+    });
+  }
+
+  for (int i = 0; i < nof_updates; ++i) {
+    obj_t* old = published.exchange(new obj_t{}, std::memory_order_acq_rel);
+    rcu.retire([old]() {
+      old->val = -1;
+      delete old;
+    });
+    rcu.reclaim();
+  }
+  running = false;
+  for (auto& t : readers) {
+    t.join();
+  }
+  rcu.synchronize();
+  delete published.load();
+
+  TESTASSERT(nof_errors == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_deferred_reclaim() == SRSRAN_SUCCESS);
+  TESTASSERT(test_concurrent_readers() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
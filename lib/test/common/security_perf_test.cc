@@ -0,0 +1,140 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <functional>
+#include <getopt.h>
+#include <vector>
+
+using namespace srsran;
+
+static uint32_t pdu_len    = 1500;
+static uint32_t nof_pdus   = 10000;
+static uint32_t batch_size = 16;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [snb]\n", prog);
+  printf("\t-s PDU size in bytes [Default %d]\n", pdu_len);
+  printf("\t-n number of PDUs per algorithm [Default %d]\n", nof_pdus);
+  printf("\t-b number of PDUs per batch [Default %d]\n", batch_size);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "s:n:b:")) != -1) {
+    switch (opt) {
+      case 's':
+        pdu_len = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        nof_pdus = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'b':
+        batch_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/// Runs the given function once per PDU and prints the achieved throughput.
+void benchmark(const char* name, const std::function<void(uint32_t count)>& func)
+{
+  auto t_start = std::chrono::high_resolution_clock::now();
+  for (uint32_t count = 0; count < nof_pdus; ++count) {
+    func(count);
+  }
+  auto   t_end   = std::chrono::high_resolution_clock::now();
+  double elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start).count();
+  printf("%-24s %9.1f Mbps\n", name, (double)nof_pdus * pdu_len * 8 * 1000.0 / elapsed);
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  uint8_t key[16];
+  for (uint32_t i = 0; i < sizeof(key); ++i) {
+    key[i] = i * 17;
+  }
+  std::vector<uint8_t> msg(pdu_len), out(pdu_len);
+  for (uint32_t i = 0; i < pdu_len; ++i) {
+    msg[i] = i;
+  }
+  uint8_t mac[4];
+
+  printf("Security throughput with %d PDUs of %d bytes\n", nof_pdus, pdu_len);
+
+  // Ciphering, with the key schedule computed for every PDU
+  benchmark("128-EEA1", [&](uint32_t count) { security_128_eea1(key, count, 1, 0, msg.data(), pdu_len, out.data()); });
+  benchmark("128-EEA2", [&](uint32_t count) { security_128_eea2(key, count, 1, 0, msg.data(), pdu_len, out.data()); });
+  benchmark("128-EEA3", [&](uint32_t count) { security_128_eea3(key, count, 1, 0, msg.data(), pdu_len, out.data()); });
+
+  // Integrity, with the key schedule computed for every PDU
+  benchmark("128-EIA1", [&](uint32_t count) { security_128_eia1(key, count, 1, 0, msg.data(), pdu_len, mac); });
+  benchmark("128-EIA2", [&](uint32_t count) { security_128_eia2(key, count, 1, 0, msg.data(), pdu_len, mac); });
+  benchmark("128-EIA3", [&](uint32_t count) { security_128_eia3(key, count, 1, 0, msg.data(), pdu_len, mac); });
+
+  // AES based algorithms with a precomputed context, for every implementation supported by the CPU
+  security_aes_ctx_t ctx;
+  security_aes_ctx_set_key(ctx, key);
+  for (aes_impl_t impl : {aes_impl_t::generic, aes_impl_t::aesni, aes_impl_t::vaes}) {
+    if (ctx.aes.set_impl(impl) != impl) {
+      continue;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "128-EEA2 (ctx, %s)", to_string(impl));
+    benchmark(name, [&](uint32_t count) { security_128_eea2(ctx, count, 1, 0, msg.data(), pdu_len, out.data()); });
+    snprintf(name, sizeof(name), "128-EIA2 (ctx, %s)", to_string(impl));
+    benchmark(name, [&](uint32_t count) { security_128_eia2(ctx, count, 1, 0, msg.data(), pdu_len, mac); });
+  }
+
+  // SNOW 3G and ZUC based algorithms, processing batches of PDUs with the multi-buffer keystream generators
+  typedef uint8_t (*batch_func_t)(const uint8_t* key, const security_pdu_t* pdus, uint32_t nof_pdus);
+  std::vector<std::vector<uint8_t> > batch_out(batch_size, std::vector<uint8_t>(pdu_len));
+  std::vector<security_pdu_t>        batch(batch_size);
+  auto                               run_batch = [&](uint32_t count, batch_func_t func) {
+    // One call every batch_size PDUs, counting them as processed at once
+    if (count % batch_size == 0) {
+      for (uint32_t i = 0; i < batch_size; ++i) {
+        batch[i] = {count + i, (uint8_t)(i % 8), 0, msg.data(), pdu_len, batch_out[i].data()};
+      }
+      func(key, batch.data(), std::min(batch_size, nof_pdus - count));
+    }
+  };
+  char name[32];
+  snprintf(name, sizeof(name), "128-EEA1 (batch %d)", batch_size);
+  benchmark(name, [&](uint32_t count) { run_batch(count, security_128_eea1_batch); });
+  snprintf(name, sizeof(name), "128-EEA3 (batch %d)", batch_size);
+  benchmark(name, [&](uint32_t count) { run_batch(count, security_128_eea3_batch); });
+  snprintf(name, sizeof(name), "128-EIA1 (batch %d)", batch_size);
+  benchmark(name, [&](uint32_t count) { run_batch(count, security_128_eia1_batch); });
+  snprintf(name, sizeof(name), "128-EIA3 (batch %d)", batch_size);
+  benchmark(name, [&](uint32_t count) { run_batch(count, security_128_eia3_batch); });
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,158 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+#include "srsran/common/liblte_security.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+
+using namespace srsran;
+
+/*
+ * Checks the batch interfaces of the SNOW 3G and ZUC based algorithms against the single PDU reference
+ * implementations, which are covered by the conformance test vectors of test_eea1, test_eia1, test_eea3 and test_eia3.
+ */
+
+static std::mt19937 rgen(0x5eed);
+
+struct test_pdu_t {
+  uint32_t             count;
+  uint8_t              bearer;
+  uint8_t              direction;
+  std::vector<uint8_t> msg;
+  std::vector<uint8_t> ref;
+  std::vector<uint8_t> out;
+};
+
+/// Generates a batch with a mix of short and long PDUs, of all the lengths around the word and lane boundaries.
+std::vector<test_pdu_t> make_batch(uint32_t nof_pdus, bool integrity)
+{
+  std::uniform_int_distribution<uint32_t> byte_dist(0, 255);
+  std::uniform_int_distribution<uint32_t> len_dist(1, 1600);
+
+  std::vector<test_pdu_t> pdus(nof_pdus);
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    uint32_t len      = i < 40 ? i + 1 : len_dist(rgen);
+    pdus[i].count     = rgen();
+    pdus[i].bearer    = rgen() % 32;
+    pdus[i].direction = rgen() % 2;
+    pdus[i].msg.resize(len);
+    for (uint8_t& b : pdus[i].msg) {
+      b = byte_dist(rgen);
+    }
+    pdus[i].ref.resize(integrity ? 4 : len);
+    pdus[i].out.resize(integrity ? 4 : len);
+  }
+  return pdus;
+}
+
+std::vector<security_pdu_t> get_batch(std::vector<test_pdu_t>& pdus, bool in_place)
+{
+  std::vector<security_pdu_t> batch;
+  for (test_pdu_t& pdu : pdus) {
+    if (in_place) {
+      pdu.out = pdu.msg;
+    }
+    batch.push_back({pdu.count, pdu.bearer, pdu.direction, pdu.msg.data(), (uint32_t)pdu.msg.size(), pdu.out.data()});
+    if (in_place) {
+      batch.back().msg = pdu.out.data();
+    }
+  }
+  return batch;
+}
+
+int test_eea_batch(uint8_t* key, uint32_t nof_pdus, bool eea3, bool in_place)
+{
+  std::vector<test_pdu_t> pdus = make_batch(nof_pdus, false);
+  for (test_pdu_t& pdu : pdus) {
+    uint32_t len_bits = pdu.msg.size() * 8;
+    uint8_t* msg      = pdu.msg.data();
+    if (eea3) {
+      liblte_security_encryption_eea3(key, pdu.count, pdu.bearer, pdu.direction, msg, len_bits, pdu.ref.data());
+    } else {
+      liblte_security_encryption_eea1(key, pdu.count, pdu.bearer, pdu.direction, msg, len_bits, pdu.ref.data());
+    }
+  }
+
+  std::vector<security_pdu_t> batch = get_batch(pdus, in_place);
+  if (eea3) {
+    TESTASSERT(security_128_eea3_batch(key, batch.data(), batch.size()) == SRSRAN_SUCCESS);
+  } else {
+    TESTASSERT(security_128_eea1_batch(key, batch.data(), batch.size()) == SRSRAN_SUCCESS);
+  }
+  for (const test_pdu_t& pdu : pdus) {
+    TESTASSERT(pdu.out == pdu.ref);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_eia_batch(uint8_t* key, uint32_t nof_pdus, bool eia3)
+{
+  std::vector<test_pdu_t> pdus = make_batch(nof_pdus, true);
+  for (test_pdu_t& pdu : pdus) {
+    uint8_t* msg = pdu.msg.data();
+    if (eia3) {
+      liblte_security_128_eia3(key, pdu.count, pdu.bearer, pdu.direction, msg, pdu.msg.size() * 8, pdu.ref.data());
+    } else {
+      liblte_security_128_eia1(key, pdu.count, pdu.bearer, pdu.direction, msg, pdu.msg.size(), pdu.ref.data());
+    }
+  }
+
+  std::vector<security_pdu_t> batch = get_batch(pdus, false);
+  if (eia3) {
+    TESTASSERT(security_128_eia3_batch(key, batch.data(), batch.size()) == SRSRAN_SUCCESS);
+  } else {
+    TESTASSERT(security_128_eia1_batch(key, batch.data(), batch.size()) == SRSRAN_SUCCESS);
+  }
+  for (const test_pdu_t& pdu : pdus) {
+    TESTASSERT(pdu.out == pdu.ref);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  uint8_t key[16];
+  for (uint8_t& b : key) {
+    b = rgen();
+  }
+
+  // Empty batches, single PDUs, batches not filling the last group of lanes and several groups
+  for (uint32_t nof_pdus : {0, 1, 7, 16, 45, 100}) {
+    for (bool eea3 : {false, true}) {
+      TESTASSERT(test_eea_batch(key, nof_pdus, eea3, false) == SRSRAN_SUCCESS);
+      TESTASSERT(test_eea_batch(key, nof_pdus, eea3, true) == SRSRAN_SUCCESS);
+      TESTASSERT(test_eia_batch(key, nof_pdus, eea3) == SRSRAN_SUCCESS);
+    }
+  }
+
+  // Invalid inputs
+  uint8_t        mac[4];
+  security_pdu_t pdu = {0, 0, 0, nullptr, 4, mac};
+  TESTASSERT(security_128_eia3_batch(key, &pdu, 1) != SRSRAN_SUCCESS);
+  TESTASSERT(security_128_eea1_batch(nullptr, &pdu, 0) != SRSRAN_SUCCESS);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
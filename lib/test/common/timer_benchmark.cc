@@ -0,0 +1,129 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/timers.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+#include <vector>
+
+using namespace srsran;
+
+static uint32_t nof_timers   = 1000000;
+static uint32_t nof_tics     = 10000;
+static uint32_t max_duration = 2000;
+static uint32_t nof_restarts = 1000;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [ntdr]\n", prog);
+  printf("\t-n number of concurrent timers [Default %d]\n", nof_timers);
+  printf("\t-t number of tics [Default %d]\n", nof_tics);
+  printf("\t-d maximum timer duration in tics [Default %d]\n", max_duration);
+  printf("\t-r number of timers restarted per tic [Default %d]\n", nof_restarts);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:t:d:r:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_timers = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 't':
+        nof_tics = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'd':
+        max_duration = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'r':
+        nof_restarts = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+using bench_clock = std::chrono::steady_clock;
+
+static double elapsed_ns(bench_clock::time_point t_start)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - t_start).count();
+}
+
+/**
+ * Keeps nof_timers running at all times. Expired timers are restarted from their callback, as RLC/RRC timers usually
+ * are, and on every tic a few random timers are restarted before expiring, as PDCP discard timers are.
+ */
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  timer_handler                           timers(nof_timers);
+  std::vector<unique_timer>               tlist(nof_timers);
+  std::mt19937                            rgen(0);
+  std::uniform_int_distribution<uint32_t> dur_dist(1, max_duration);
+  std::uniform_int_distribution<uint32_t> timer_dist(0, nof_timers - 1);
+  uint64_t                                nof_expiries = 0;
+
+  auto t_start = bench_clock::now();
+  for (uint32_t i = 0; i < nof_timers; ++i) {
+    tlist[i] = timers.get_unique_timer();
+    tlist[i].set(dur_dist(rgen), [&tlist, &nof_expiries, i](uint32_t tid) {
+      nof_expiries++;
+      tlist[i].run();
+    });
+    tlist[i].run();
+  }
+  double setup_ns = elapsed_ns(t_start);
+  TESTASSERT(timers.nof_running_timers() == nof_timers);
+
+  double step_ns = 0, restart_ns = 0;
+  for (uint32_t tic = 0; tic < nof_tics; ++tic) {
+    t_start = bench_clock::now();
+    timers.step_all();
+    step_ns += elapsed_ns(t_start);
+
+    t_start = bench_clock::now();
+    for (uint32_t i = 0; i < nof_restarts; ++i) {
+      tlist[timer_dist(rgen)].run();
+    }
+    restart_ns += elapsed_ns(t_start);
+  }
+  TESTASSERT(timers.nof_running_timers() == nof_timers);
+
+  printf("timers=%u, tics=%u, expiries=%" PRIu64 ", handler size=%zu bytes\n",
+         nof_timers,
+         nof_tics,
+         nof_expiries,
+         sizeof(timer_handler));
+  printf("setup:   %8.1f ns/timer\n", setup_ns / nof_timers);
+  printf("step:    %8.1f us/tic, %6.1f ns/expiry\n",
+         step_ns / nof_tics / 1000.0,
+         nof_expiries > 0 ? step_ns / nof_expiries : 0.0);
+  printf("restart: %8.1f ns/timer\n", nof_restarts > 0 ? restart_ns / ((double)nof_tics * nof_restarts) : 0.0);
+
+  return SRSRAN_SUCCESS;
+}
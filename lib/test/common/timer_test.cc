@@ -21,6 +21,7 @@
 
 #include "srsran/common/timers.h"
 #include "srsran/support/srsran_test.h"
+#include <algorithm>
 #include <iostream>
 #include <random>
 #include <srsran/common/tti_sync_cv.h>
@@ -448,6 +449,117 @@ void timers_test7()
   TESTASSERT(timers.nof_running_timers() == 1 and timers.nof_timers() == 3);
 }
 
+/**
+ * Tests specific to the hierarchical wheel:
+ * - timers whose timeouts fall in upper levels expire exactly at their timeout after being cascaded down
+ * - timers restarted from an expiry callback in the same tic are correctly re-inserted
+ */
+void timers_test8()
+{
+  timer_handler timers;
+  size_t        wheel_size = timer_handler::get_wheel_size();
+
+  std::vector<uint32_t> durations = {1, 2, 63, 64, 65};
+  for (uint32_t d : {wheel_size, wheel_size * 64, wheel_size * 64 * 64}) {
+    durations.push_back(d - 1);
+    durations.push_back(d);
+    durations.push_back(d + 1);
+  }
+  std::mt19937                            rgen(0);
+  std::uniform_int_distribution<uint32_t> dist(1, wheel_size * 64 * 16);
+  for (uint32_t i = 0; i < 64; ++i) {
+    durations.push_back(dist(rgen));
+  }
+
+  std::vector<uint32_t>     expiry_tics(durations.size(), 0);
+  std::vector<unique_timer> tlist;
+  uint32_t                  tic = 0;
+  for (size_t i = 0; i < durations.size(); ++i) {
+    tlist.push_back(timers.get_unique_timer());
+    tlist.back().set(durations[i], [&expiry_tics, &tic, i](uint32_t tid) { expiry_tics[i] = tic; });
+    tlist.back().run();
+  }
+
+  // timer restarted by its own callback, always with the same period
+  unique_timer          periodic = timers.get_unique_timer();
+  std::vector<uint32_t> periodic_tics;
+  periodic.set(300, [&periodic, &periodic_tics, &tic](uint32_t tid) {
+    periodic_tics.push_back(tic);
+    periodic.run();
+  });
+  periodic.run();
+
+  uint32_t max_dur = *std::max_element(durations.begin(), durations.end());
+  for (tic = 1; tic <= max_dur; ++tic) {
+    timers.step_all();
+  }
+  for (size_t i = 0; i < durations.size(); ++i) {
+    TESTASSERT(expiry_tics[i] == durations[i]);
+    TESTASSERT(tlist[i].is_expired());
+  }
+  TESTASSERT(periodic_tics.size() == max_dur / 300);
+  for (size_t i = 0; i < periodic_tics.size(); ++i) {
+    TESTASSERT(periodic_tics[i] == 300 * (i + 1));
+  }
+  TESTASSERT(timers.nof_running_timers() == 1);
+}
+
+/**
+ * Tests a timer_handler confined to one thread, which does not lock its mutex
+ */
+void timers_test9()
+{
+  timer_handler timers(4, false);
+  bool          callback_called = false;
+
+  unique_timer t = timers.get_unique_timer();
+  t.set(3, [&callback_called](uint32_t tid) { callback_called = true; });
+  t.run();
+  timers.defer_callback(2, [&t]() { t.run(); });
+  for (uint32_t i = 0; i < 4; ++i) {
+    timers.step_all();
+  }
+  TESTASSERT(t.is_running() and not callback_called);
+  timers.step_all();
+  TESTASSERT(t.is_expired() and callback_called);
+  TESTASSERT(timers.nof_running_timers() == 0 and timers.nof_timers() == 1);
+}
+
+/**
+ * Tests that timers with a zero duration are run with a duration of one tic
+ */
+void timers_test10()
+{
+  timer_handler timers;
+  uint32_t      nof_calls = 0;
+
+  // timer that was never set
+  unique_timer t = timers.get_unique_timer();
+  t.run();
+  TESTASSERT(t.is_running() and t.duration() == 1);
+  timers.step_all();
+  TESTASSERT(t.is_expired() and not t.is_running());
+
+  // timer set with a zero duration, which can be stopped before its expiry
+  t.set(0, [&nof_calls](uint32_t tid) { nof_calls++; });
+  t.run();
+  TESTASSERT(t.is_running() and t.duration() == 1);
+  t.stop();
+  TESTASSERT(not t.is_running() and timers.nof_running_timers() == 0);
+  timers.step_all();
+  TESTASSERT(nof_calls == 0);
+  t.run();
+  timers.step_all();
+  TESTASSERT(t.is_expired() and nof_calls == 1);
+
+  // deferred callbacks with a zero delay are called in the next tic
+  timers.defer_callback(0, [&nof_calls]() { nof_calls++; });
+  TESTASSERT(nof_calls == 1);
+  timers.step_all();
+  TESTASSERT(nof_calls == 2);
+  TESTASSERT(timers.nof_running_timers() == 0 and timers.nof_timers() == 1);
+}
+
 int main()
 {
   timers_test1();
@@ -457,6 +569,9 @@ int main()
   timers_test5();
   timers_test6();
   timers_test7();
+  timers_test8();
+  timers_test9();
+  timers_test10();
   printf("Success\n");
   return 0;
 }
@@ -0,0 +1,252 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "pdcp_base_test.h"
+#include "srsran/test/ue_test_interfaces.h"
+#include "srsran/upper/pdcp_entity_lte.h"
+#include <chrono>
+#include <getopt.h>
+
+/*
+ * PDCP TX throughput, writing SDUs one by one and in batches, for every ciphering algorithm.
+ * The PDUs generated by both paths are compared before measuring.
+ */
+
+static uint32_t sdu_len    = 1500;
+static uint32_t nof_sdus   = 20000;
+static uint32_t batch_size = 32;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [snb]\n", prog);
+  printf("\t-s SDU size in bytes [Default %d]\n", sdu_len);
+  printf("\t-n number of SDUs per test [Default %d]\n", nof_sdus);
+  printf("\t-b number of SDUs per batch [Default %d]\n", batch_size);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "s:n:b:")) != -1) {
+    switch (opt) {
+      case 's':
+        sdu_len = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        nof_sdus = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'b':
+        batch_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// RLC sink, optionally keeping the PDUs and limiting the number of PDUs it accepts
+class rlc_sink : public srsue::rlc_interface_pdcp
+{
+public:
+  void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) override
+  {
+    TESTASSERT(not sdu_queue_is_full(lcid));
+    nof_bytes += sdu->N_bytes;
+    nof_pdus++;
+    if (keep_pdus) {
+      pdus.push_back(std::move(sdu));
+    }
+  }
+  void     discard_sdu(uint32_t lcid, uint32_t discard_sn) override {}
+  bool     rb_is_um(uint32_t lcid) override { return is_um; }
+  bool     sdu_queue_is_full(uint32_t lcid) override { return nof_pdus >= queue_size; }
+  uint32_t sdu_queue_free_space(uint32_t lcid) override { return queue_size - std::min(nof_pdus, queue_size); }
+  bool     is_suspended(uint32_t lcid) override { return false; }
+
+  bool                                      is_um      = true;
+  bool                                      keep_pdus  = false;
+  uint32_t                                  queue_size = std::numeric_limits<uint32_t>::max();
+  uint32_t                                  nof_pdus   = 0;
+  uint64_t                                  nof_bytes  = 0;
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+};
+
+struct pdcp_tx_helper {
+  pdcp_tx_helper(srsran::pdcp_rb_type_t       rb_type,
+                 srsran::as_security_config_t sec_cfg,
+                 srslog::basic_logger&        logger,
+                 bool                         is_um = true) :
+    rrc(logger), gw(logger), pdcp(&rlc, &rrc, &gw, &stack.task_sched, logger, rb_type == srsran::PDCP_RB_IS_SRB ? 1 : 3)
+  {
+    rlc.is_um = is_um;
+    srsran::pdcp_config_t cfg = {1,
+                                 rb_type,
+                                 srsran::SECURITY_DIRECTION_DOWNLINK,
+                                 srsran::SECURITY_DIRECTION_UPLINK,
+                                 rb_type == srsran::PDCP_RB_IS_SRB ? srsran::PDCP_SN_LEN_5 : srsran::PDCP_SN_LEN_12,
+                                 srsran::pdcp_t_reordering_t::ms500,
+                                 srsran::pdcp_discard_timer_t::infinity,
+                                 false,
+                                 srsran::srsran_rat_t::lte};
+    pdcp.configure(cfg);
+    pdcp.config_security(sec_cfg);
+    pdcp.enable_integrity(srsran::DIRECTION_TXRX);
+    pdcp.enable_encryption(srsran::DIRECTION_TXRX);
+  }
+
+  rlc_sink                rlc;
+  rrc_dummy               rrc;
+  gw_dummy                gw;
+  srsue::stack_test_dummy stack;
+  srsran::pdcp_entity_lte pdcp;
+};
+
+srsran::unique_byte_buffer_t make_sdu(uint32_t len, uint32_t seed)
+{
+  srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+  for (uint32_t i = 0; i < len; i++) {
+    sdu->msg[i] = (uint8_t)(seed + i * 7);
+  }
+  sdu->N_bytes = len;
+  return sdu;
+}
+
+/// Writes nof SDUs of len bytes, either one by one or in batches of batch_size SDUs.
+void write_sdus(pdcp_tx_helper& hlp, uint32_t nof, uint32_t len, bool batch)
+{
+  std::vector<srsran::unique_byte_buffer_t> sdus;
+  for (uint32_t n = 0; n < nof; n++) {
+    if (not batch) {
+      hlp.pdcp.write_sdu(make_sdu(len, n));
+      continue;
+    }
+    sdus.push_back(make_sdu(len, n));
+    if (sdus.size() == batch_size or n == nof - 1) {
+      hlp.pdcp.write_sdu_batch(sdus);
+      sdus.clear();
+    }
+  }
+}
+
+int test_batch_equals_single(srsran::pdcp_rb_type_t rb_type, srsran::as_security_config_t sec_cfg)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("PDCP", false);
+  pdcp_tx_helper        single(rb_type, sec_cfg, logger);
+  pdcp_tx_helper        batch(rb_type, sec_cfg, logger);
+  single.rlc.keep_pdus = true;
+  batch.rlc.keep_pdus  = true;
+
+  // SDUs of different lengths, around the SIMD word and lane boundaries
+  for (uint32_t len = 1; len <= 80; len++) {
+    write_sdus(single, 20, len, false);
+    write_sdus(batch, 20, len, true);
+  }
+
+  TESTASSERT(single.rlc.pdus.size() == batch.rlc.pdus.size());
+  for (uint32_t i = 0; i < single.rlc.pdus.size(); i++) {
+    TESTASSERT(compare_two_packets(single.rlc.pdus[i], batch.rlc.pdus[i]) == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// Writes a batch larger than the free space of the RLC queue. The SDUs that do not fit must be dropped before they
+/// consume a SN or get stored for retransmission.
+int test_batch_full_queue(bool is_um)
+{
+  srslog::basic_logger&        logger = srslog::fetch_basic_logger("PDCP", false);
+  srsran::as_security_config_t sec_cfg = {};
+  pdcp_tx_helper               hlp(srsran::PDCP_RB_IS_DRB, sec_cfg, logger, is_um);
+  hlp.rlc.queue_size = 40;
+
+  // First batch fits, the second one only partially
+  write_sdus(hlp, 30, 100, true);
+  TESTASSERT(hlp.rlc.nof_pdus == 30);
+  write_sdus(hlp, 30, 100, true);
+  TESTASSERT(hlp.rlc.nof_pdus == 40);
+
+  srsran::pdcp_lte_state_t st = {};
+  hlp.pdcp.get_bearer_state(&st);
+  TESTASSERT(st.next_pdcp_tx_sn == 40);
+  if (not is_um) {
+    TESTASSERT(hlp.pdcp.get_buffered_pdus().size() == 40);
+  }
+
+  // Nothing gets through a full queue
+  write_sdus(hlp, 5, 100, true);
+  hlp.pdcp.get_bearer_state(&st);
+  TESTASSERT(hlp.rlc.nof_pdus == 40);
+  TESTASSERT(st.next_pdcp_tx_sn == 40);
+  return SRSRAN_SUCCESS;
+}
+
+double benchmark(srsran::pdcp_rb_type_t rb_type, srsran::as_security_config_t sec_cfg, bool batch)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("PDCP", false);
+  pdcp_tx_helper        hlp(rb_type, sec_cfg, logger);
+
+  auto t_start = std::chrono::high_resolution_clock::now();
+  write_sdus(hlp, nof_sdus, sdu_len, batch);
+  auto   t_end   = std::chrono::high_resolution_clock::now();
+  double elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start).count();
+  return hlp.rlc.nof_bytes * 8 * 1000.0 / elapsed;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::fetch_basic_logger("PDCP", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  srsran::as_key_t key;
+  for (uint32_t i = 0; i < key.size(); i++) {
+    key[i] = i * 13;
+  }
+
+  TESTASSERT(test_batch_full_queue(true) == SRSRAN_SUCCESS);
+  TESTASSERT(test_batch_full_queue(false) == SRSRAN_SUCCESS);
+
+  printf("PDCP TX throughput with %d SDUs of %d bytes, batches of %d SDUs\n", nof_sdus, sdu_len, batch_size);
+  printf("%-12s %14s %14s\n", "", "single", "batch");
+  for (uint32_t algo = 0; algo < 4; algo++) {
+    srsran::as_security_config_t sec_cfg = {key,
+                                            key,
+                                            key,
+                                            key,
+                                            (srsran::INTEGRITY_ALGORITHM_ID_ENUM)algo,
+                                            (srsran::CIPHERING_ALGORITHM_ID_ENUM)algo};
+
+    for (srsran::pdcp_rb_type_t rb_type : {srsran::PDCP_RB_IS_DRB, srsran::PDCP_RB_IS_SRB}) {
+      TESTASSERT(test_batch_equals_single(rb_type, sec_cfg) == SRSRAN_SUCCESS);
+
+      double single = benchmark(rb_type, sec_cfg, false);
+      double batch  = benchmark(rb_type, sec_cfg, true);
+      printf("%-8s %-3s %9.1f Mbps %9.1f Mbps\n",
+             srsran::ciphering_algorithm_id_text[algo],
+             rb_type == srsran::PDCP_RB_IS_DRB ? "DRB" : "SRB",
+             single,
+             batch);
+    }
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
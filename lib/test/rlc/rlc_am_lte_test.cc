@@ -236,6 +236,55 @@ int concat_test()
   return SRSRAN_SUCCESS;
 }
 
+// A PDU carries more SDUs than it keeps slices, the SDU segments beyond the last slice are copied into it
+int concat_many_sdus_test()
+{
+  rlc_am_tester         tester(true, nullptr);
+  srsran::timer_handler timers(8);
+
+  rlc_am rlc1(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am rlc2(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  if (not rlc2.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  // Push 3 times as many 10 byte SDUs as a PDU has slices into RLC1
+  const uint32_t nof_sdus = 3 * RLC_MAX_SLICES;
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    memset(sdu->msg, i, 10);
+    sdu->N_bytes    = 10;
+    sdu->md.pdcp_sn = i;
+    rlc1.write_sdu(std::move(sdu));
+  }
+
+  // Read 1 PDU from RLC1 containing all SDUs
+  uint32_t      buffer_state = rlc1.get_buffer_state();
+  byte_buffer_t pdu_buf;
+  int           len = rlc1.read_pdu(pdu_buf.msg, buffer_state);
+  pdu_buf.N_bytes   = len;
+  TESTASSERT(len == (int)buffer_state);
+  TESTASSERT(0 == rlc1.get_buffer_state());
+
+  // Write PDU into RLC2
+  rlc2.write_pdu(pdu_buf.msg, pdu_buf.N_bytes);
+
+  TESTASSERT(tester.sdus.size() == nof_sdus);
+  for (uint32_t i = 0; i < tester.sdus.size(); i++) {
+    TESTASSERT(tester.sdus[i]->N_bytes == 10);
+    for (uint32_t j = 0; j < 10; j++) {
+      TESTASSERT(tester.sdus[i]->msg[j] == i);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int segment_test(bool in_seq_rx)
 {
   rlc_am_tester         tester(true, nullptr);
@@ -4117,6 +4166,11 @@ int main(int argc, char** argv)
     exit(-1);
   };
 
+  if (concat_many_sdus_test()) {
+    printf("concat_many_sdus_test failed\n");
+    exit(-1);
+  };
+
   if (segment_test(true)) {
     printf("segment_test with in-order PDU reception failed\n");
     exit(-1);
@@ -3435,6 +3435,87 @@ int full_rx_window_t_reassembly_expiry(rlc_am_nr_sn_size_t sn_size)
   return SRSRAN_SUCCESS;
 }
 
+// This tests correct reassembly of an SDU whose retransmitted segments partially overlap the ones received before:
+// - Receive the first segment and a middle segment of an SDU
+// - Receive a retransmission resegmented differently, overlapping the first segment but leaving a gap
+// - Check that the status PDU only NACKs the missing bytes
+// - Receive the missing bytes in segments that overlap the ones before and check the SDU content
+int overlapping_segments_test(rlc_am_nr_sn_size_t sn_size)
+{
+  rlc_am_tester       tester(true, nullptr);
+  timer_handler       timers(8);
+  test_delimit_logger delimiter("overlapping segments ({} bit SN)", to_number(sn_size));
+  rlc_am              rlc(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+
+  const uint16_t so_end_of_sdu = rlc_status_nack_t::so_end_of_sdu;
+
+  rlc_config_t config = rlc_config_t::default_rlc_am_nr_config(to_number(sn_size));
+  if (not rlc.configure(config)) {
+    return -1;
+  }
+
+  // Segments of a 10 byte SDU as {SO, length}, in reception order. Byte 5 is only in the fourth one
+  constexpr uint32_t sdu_size      = 10;
+  const uint32_t     segments[][2] = {{0, 4}, {6, 2}, {2, 3}, {4, 4}, {7, 3}};
+  constexpr uint32_t nof_segments  = sizeof(segments) / sizeof(segments[0]);
+  uint8_t            sdu[sdu_size] = {};
+  for (uint32_t i = 0; i < sdu_size; i++) {
+    sdu[i] = i;
+  }
+
+  for (uint32_t i = 0; i < nof_segments; i++) {
+    uint32_t so  = segments[i][0];
+    uint32_t len = segments[i][1];
+
+    rlc_am_nr_pdu_header_t header = {};
+    header.dc                     = RLC_DC_FIELD_DATA_PDU;
+    header.sn_size                = sn_size;
+    header.sn                     = 0;
+    header.so                     = so;
+    if (so == 0) {
+      header.si = rlc_nr_si_field_t::first_segment;
+    } else if (so + len == sdu_size) {
+      header.si = rlc_nr_si_field_t::last_segment;
+    } else {
+      header.si = rlc_nr_si_field_t::neither_first_nor_last_segment;
+    }
+
+    unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    TESTASSERT(nullptr != pdu);
+    memcpy(pdu->msg, &sdu[so], len);
+    pdu->N_bytes = len;
+    rlc_am_nr_write_data_pdu_header(header, pdu.get());
+    rlc.write_pdu(pdu->msg, pdu->N_bytes);
+
+    if (i == 2) {
+      // Byte 5 and the end of the SDU are missing. Let t-Reassembly expire to report them
+      TESTASSERT_EQ(0, tester.sdus.size());
+      for (uint32_t cnt = 0; cnt < config.am_nr.t_reassembly; cnt++) {
+        timers.step_all();
+      }
+      rlc_am_nr_status_pdu_t status(sn_size);
+      rlc_am_nr_rx*          rx = dynamic_cast<rlc_am_nr_rx*>(rlc.get_rx());
+      TESTASSERT(rx->get_status_pdu(&status, 100) > 0);
+      TESTASSERT_EQ(2, status.nacks.size());
+      TESTASSERT_EQ(0, status.nacks[0].nack_sn);
+      TESTASSERT_EQ(true, status.nacks[0].has_so);
+      TESTASSERT_EQ(5, status.nacks[0].so_start);
+      TESTASSERT_EQ(5, status.nacks[0].so_end);
+      TESTASSERT_EQ(0, status.nacks[1].nack_sn);
+      TESTASSERT_EQ(true, status.nacks[1].has_so);
+      TESTASSERT_EQ(8, status.nacks[1].so_start);
+      TESTASSERT_EQ(so_end_of_sdu, status.nacks[1].so_end);
+    }
+  }
+
+  // The SDU is delivered once, without duplicate bytes
+  TESTASSERT_EQ(1, tester.sdus.size());
+  TESTASSERT_EQ(sdu_size, tester.sdus[0]->N_bytes);
+  TESTASSERT(memcmp(tester.sdus[0]->msg, sdu, sdu_size) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   // Setup the log message spy to intercept error and warning log entries from RLC
@@ -3473,6 +3554,7 @@ int main()
     TESTASSERT(segment_retx_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(segment_retx_and_loose_segments_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(retx_segment_test(sn_size) == SRSRAN_SUCCESS);
+    TESTASSERT(overlapping_segments_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(handle_status_of_non_tx_last_segment(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(max_retx_lost_sdu_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(max_retx_lost_segments_test(sn_size) == SRSRAN_SUCCESS);
@@ -0,0 +1,233 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
+#include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/rlc/rlc_am_lte.h"
+#include "srsran/rlc/rlc_um_lte.h"
+#include "srsran/rlc/rlc_um_nr.h"
+#include <chrono>
+#include <getopt.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace srsran;
+
+static std::string mode     = "AM";
+static uint32_t    sdu_size = 1500;
+static uint32_t    tb_size  = 9422;
+static uint32_t    nof_sdus = 100000;
+static float       loss     = 0.0;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [mstnl]\n", prog);
+  printf("\t-m RLC mode, AM, UM, AMNR or UMNR [Default %s]\n", mode.c_str());
+  printf("\t-s SDU size in bytes [Default %d]\n", sdu_size);
+  printf("\t-t MAC grant size in bytes [Default %d]\n", tb_size);
+  printf("\t-n number of SDUs [Default %d]\n", nof_sdus);
+  printf("\t-l data PDU loss rate, AM only. Grants get random sizes to force resegmentation [Default %.2f]\n", loss);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "m:s:t:n:l:")) != -1) {
+    switch (opt) {
+      case 'm':
+        mode = optarg;
+        break;
+      case 's':
+        sdu_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 't':
+        tb_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        nof_sdus = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'l':
+        loss = strtof(optarg, NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if ((mode != "AM" && mode != "UM" && mode != "AMNR" && mode != "UMNR") || sdu_size == 0 || sdu_size > SRSRAN_MAX_BUFFER_SIZE_BYTES ||
+      tb_size > byte_buffer_large_payload_size || loss < 0 || loss >= 1 || (loss > 0 && mode[0] == 'U')) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+using bench_clock = std::chrono::steady_clock;
+
+static double elapsed_ns(bench_clock::time_point t_start)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - t_start).count();
+}
+
+// Checks that the SDUs are received complete. All bytes of an SDU carry its count, and LTE RLC delivers them in order.
+class sdu_sink : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
+{
+public:
+  // PDCP interface
+  void write_pdu(uint32_t lcid, unique_byte_buffer_t sdu) final
+  {
+    bool in_order = mode != "AMNR";
+    if (sdu->N_bytes != sdu_size || sdu->msg[0] != sdu->msg[sdu->N_bytes - 1] ||
+        (in_order && sdu->msg[0] != (uint8_t)nof_rx_sdus)) {
+      nof_errors++;
+    }
+    nof_rx_sdus++;
+  }
+  void write_pdu_bcch_bch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_bcch_dlsch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_pcch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_mch(uint32_t lcid, unique_byte_buffer_t sdu) final {}
+  void notify_delivery(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+  void notify_failure(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+
+  // RRC interface
+  void        max_retx_attempted() final {}
+  void        protocol_failure() final {}
+  const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
+
+  uint32_t nof_rx_sdus = 0;
+  uint32_t nof_errors  = 0;
+};
+
+static std::unique_ptr<rlc_common> make_rlc(const char* name, sdu_sink* sink, timer_handler* timers)
+{
+  srslog::fetch_basic_logger(name).set_level(srslog::basic_levels::error);
+  std::unique_ptr<rlc_common> rlc;
+  if (mode == "AM") {
+    rlc.reset(new rlc_am(srsran_rat_t::lte, srslog::fetch_basic_logger(name), 1, sink, sink, timers));
+    rlc->configure(rlc_config_t::default_rlc_am_config());
+  } else if (mode == "AMNR") {
+    rlc.reset(new rlc_am(srsran_rat_t::nr, srslog::fetch_basic_logger(name), 1, sink, sink, timers));
+    rlc->configure(rlc_config_t::default_rlc_am_nr_config());
+  } else if (mode == "UMNR") {
+    rlc.reset(new rlc_um_nr(srslog::fetch_basic_logger(name), 1, sink, sink, timers));
+    rlc->configure(rlc_config_t::default_rlc_um_nr_config(12));
+  } else {
+    rlc.reset(new rlc_um_lte(srslog::fetch_basic_logger(name), 1, sink, sink, timers));
+    rlc->configure(rlc_config_t::default_rlc_um_config(10));
+  }
+  return rlc;
+}
+
+/**
+ * Sends nof_sdus SDUs from one RLC entity to its peer, with one MAC grant of tb_size bytes per TTI. The PDU
+ * construction (read_pdu) and the reassembly (write_pdu) are timed separately. In AM, the status PDUs of the receiver
+ * are looped back to the transmitter outside of the timed sections. With a loss rate, data PDUs are dropped at random
+ * and the grants are sized at random, so that the retransmissions are resegmented and the receiver reassembles them.
+ */
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::init();
+
+  sdu_sink                    tx_sink, rx_sink;
+  timer_handler               timers(8);
+  std::unique_ptr<rlc_common> rlc1 = make_rlc("RLC_1", &tx_sink, &timers);
+  std::unique_ptr<rlc_common> rlc2 = make_rlc("RLC_2", &rx_sink, &timers);
+
+  std::vector<uint8_t> tb(byte_buffer_large_payload_size);
+  uint32_t             nof_tx_sdus = 0, nof_tti = 0, nof_pdus = 0, nof_lost = 0;
+  uint64_t             nof_bytes = 0;
+  double               tx_ns = 0, rx_ns = 0;
+  // Generous bound on the TTIs needed, in case the bearer stalls. NR carries one SDU (segment) per PDU.
+  uint64_t max_tti = 100 + nof_sdus + 10 * ((uint64_t)nof_sdus * (sdu_size + 4) / SRSRAN_MAX(tb_size, 1u) + 1);
+
+  std::mt19937                            rgen(0);
+  std::uniform_real_distribution<float>   loss_dist(0, 1);
+  std::uniform_int_distribution<uint32_t> grant_dist(tb_size / 8, tb_size);
+
+  while (rx_sink.nof_rx_sdus < nof_sdus && nof_tti < max_tti) {
+    while (nof_tx_sdus < nof_sdus && not rlc1->sdu_queue_is_full()) {
+      unique_byte_buffer_t sdu = make_byte_buffer();
+      TESTASSERT(sdu != nullptr);
+      memset(sdu->msg, (uint8_t)nof_tx_sdus, sdu_size);
+      sdu->N_bytes    = sdu_size;
+      sdu->md.pdcp_sn = nof_tx_sdus % 4096;
+      rlc1->write_sdu(std::move(sdu));
+      nof_tx_sdus++;
+    }
+
+    uint32_t grant   = loss > 0 ? grant_dist(rgen) : tb_size;
+    auto     t_start = bench_clock::now();
+    uint32_t len     = rlc1->read_pdu(tb.data(), grant);
+    tx_ns += elapsed_ns(t_start);
+
+    if (len > 0 && loss > 0 && loss_dist(rgen) < loss) {
+      nof_lost++;
+    } else if (len > 0) {
+      t_start = bench_clock::now();
+      rlc2->write_pdu(tb.data(), len);
+      rx_ns += elapsed_ns(t_start);
+      nof_pdus++;
+      nof_bytes += len;
+    }
+
+    if (rlc2->get_buffer_state() > 0) {
+      len = rlc2->read_pdu(tb.data(), tb_size);
+      rlc1->write_pdu(tb.data(), len);
+    }
+
+    timers.step_all();
+    nof_tti++;
+  }
+
+  double sdu_bits = 8.0 * sdu_size * rx_sink.nof_rx_sdus;
+  printf("mode=%s, sdu_size=%u, tb_size=%u, loss=%.2f, sdus=%u, pdus=%u, lost=%u, ttis=%u, bytes=%" PRIu64 "\n",
+         mode.c_str(),
+         sdu_size,
+         tb_size,
+         loss,
+         rx_sink.nof_rx_sdus,
+         nof_pdus,
+         nof_lost,
+         nof_tti,
+         nof_bytes);
+  printf("tx: %8.1f ns/pdu, %8.1f ns/sdu, %8.1f Mbit/s\n",
+         nof_pdus > 0 ? tx_ns / nof_pdus : 0.0,
+         rx_sink.nof_rx_sdus > 0 ? tx_ns / rx_sink.nof_rx_sdus : 0.0,
+         tx_ns > 0 ? sdu_bits / tx_ns * 1000.0 : 0.0);
+  printf("rx: %8.1f ns/pdu, %8.1f ns/sdu, %8.1f Mbit/s\n",
+         nof_pdus > 0 ? rx_ns / nof_pdus : 0.0,
+         rx_sink.nof_rx_sdus > 0 ? rx_ns / rx_sink.nof_rx_sdus : 0.0,
+         rx_ns > 0 ? sdu_bits / rx_ns * 1000.0 : 0.0);
+
+  rlc1->stop();
+  rlc2->stop();
+
+  TESTASSERT(rx_sink.nof_rx_sdus == nof_sdus);
+  TESTASSERT(rx_sink.nof_errors == 0);
+
+  return SRSRAN_SUCCESS;
+}
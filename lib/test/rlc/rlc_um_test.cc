@@ -433,6 +433,40 @@ int pdu_pack_no_space_test()
   return SRSRAN_SUCCESS;
 }
 
+// A PDU carries more SDUs than it keeps slices, the SDU segments beyond the last slice are copied into it
+int concat_many_sdus_test()
+{
+  rlc_um_lte_test_context1 ctxt;
+  ctxt.tester.set_expected_sdu_len(10);
+
+  // Push 3 times as many 10 byte SDUs as a PDU has slices into RLC1
+  const uint32_t nof_sdus = 3 * RLC_MAX_SLICES;
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    memset(sdu->msg, i, 10);
+    sdu->N_bytes = 10;
+    ctxt.rlc1.write_sdu(std::move(sdu));
+  }
+
+  // Read 1 PDU from RLC1 containing all SDUs
+  uint32_t      buffer_state = ctxt.rlc1.get_buffer_state();
+  byte_buffer_t pdu_buf;
+  int           len = ctxt.rlc1.read_pdu(pdu_buf.msg, buffer_state);
+  pdu_buf.N_bytes   = len;
+  TESTASSERT(len > 0 && len <= (int)buffer_state);
+  TESTASSERT(0 == ctxt.rlc1.get_buffer_state());
+
+  // Write PDU into RLC2
+  ctxt.rlc2.write_pdu(pdu_buf.msg, pdu_buf.N_bytes);
+
+  TESTASSERT(nof_sdus == ctxt.tester.sdus.size());
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    TESTASSERT(ctxt.tester.sdus[i]->msg[0] == i);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srslog::init();
@@ -458,4 +492,5 @@ int main(int argc, char** argv)
   }
 
   TESTASSERT(pdu_pack_no_space_test() == 0);
+  TESTASSERT(concat_many_sdus_test() == 0);
 }
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_RCU_RNTI_MAP_H
+#define SRSENB_RCU_RNTI_MAP_H
+
+#include "common_enb.h"
+#include "rnti_pool.h"
+#include "srsran/common/rcu.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace srsenb {
+
+/**
+ * Map of UE objects indexed by RNTI, with the same placement as rnti_map_t, that can be read concurrently with
+ * insertions and removals. Lookups and iterations must happen inside a read-side section of the RCU domain passed in
+ * the constructor, and never block. Removed objects are retired to the RCU domain, so that they are only deleted once
+ * no reader can hold a reference to them.
+ * @tparam T UE object type, which must provide "uint16_t get_rnti() const"
+ */
+template <typename T, size_t N = SRSENB_MAX_UES>
+class rcu_rnti_map
+{
+public:
+  explicit rcu_rnti_map(srsran::rcu_domain& rcu_) : rcu(rcu_) {}
+  rcu_rnti_map(const rcu_rnti_map&) = delete;
+  rcu_rnti_map& operator=(const rcu_rnti_map&) = delete;
+  ~rcu_rnti_map() { clear(); }
+
+  /******* Read-side. Must be called from within a read-side section *******/
+
+  T* find(uint16_t rnti) const
+  {
+    T* obj = slots[rnti % N].load(std::memory_order_acquire);
+    return (obj != nullptr and obj->get_rnti() == rnti) ? obj : nullptr;
+  }
+
+  template <typename F>
+  void for_each(F&& f) const
+  {
+    for (const std::atomic<T*>& slot : slots) {
+      T* obj = slot.load(std::memory_order_acquire);
+      if (obj != nullptr) {
+        f(*obj);
+      }
+    }
+  }
+
+  size_t size() const { return count.load(std::memory_order_relaxed); }
+  bool   full() const { return size() == N; }
+  bool   has_space(uint16_t rnti) const { return slots[rnti % N].load(std::memory_order_relaxed) == nullptr; }
+
+  /******* Write-side. Writers are serialized internally *******/
+
+  /// Publishes a new object. Returns the inserted object, or nullptr if the RNTI slot is already taken
+  T* insert(uint16_t rnti, unique_rnti_ptr<T> obj)
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    size_t                      idx = rnti % N;
+    if (owners[idx] != nullptr) {
+      return nullptr;
+    }
+    owners[idx] = std::move(obj);
+    count.fetch_add(1, std::memory_order_relaxed);
+    slots[idx].store(owners[idx].get(), std::memory_order_release);
+    return owners[idx].get();
+  }
+
+  /// Unpublishes an object. The object is deleted once the ongoing read-side sections finish
+  bool erase(uint16_t rnti)
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    return erase_unprotected(rnti % N, rnti);
+  }
+
+  /// Unpublishes all objects, and waits until they are deleted
+  void clear()
+  {
+    {
+      std::lock_guard<std::mutex> lock(writer_mutex);
+      for (size_t idx = 0; idx < N; ++idx) {
+        if (owners[idx] != nullptr) {
+          erase_unprotected(idx, owners[idx]->get_rnti());
+        }
+      }
+    }
+    rcu.synchronize();
+  }
+
+private:
+  bool erase_unprotected(size_t idx, uint16_t rnti)
+  {
+    if (owners[idx] == nullptr or owners[idx]->get_rnti() != rnti) {
+      return false;
+    }
+    slots[idx].store(nullptr, std::memory_order_release);
+    count.fetch_sub(1, std::memory_order_relaxed);
+    unique_rnti_ptr<T> obj = std::move(owners[idx]);
+    rcu.retire([obj = std::move(obj)]() mutable { obj.reset(); });
+    return true;
+  }
+
+  srsran::rcu_domain& rcu;
+
+  std::array<std::atomic<T*>, N> slots = {};
+  std::atomic<size_t>            count{0};
+
+  // writer-side state
+  std::mutex                        writer_mutex;
+  std::array<unique_rnti_ptr<T>, N> owners;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_RCU_RNTI_MAP_H
@@ -37,7 +37,7 @@ class cc_worker
 public:
   cc_worker(srslog::basic_logger& logger);
   ~cc_worker();
-  void init(phy_common* phy, uint32_t cc_idx);
+  void init(phy_common* phy, uint32_t cc_idx, cc_worker* primary = nullptr);
   void reset();
 
   cf_t* get_buffer_rx(uint32_t antenna_idx);
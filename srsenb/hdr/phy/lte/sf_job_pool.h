@@ -0,0 +1,124 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_LTE_SF_JOB_POOL_H
+#define SRSENB_LTE_SF_JOB_POOL_H
+
+#include "srsenb/hdr/phy/phy_metrics.h"
+#include "srsran/adt/move_callback.h"
+#include "srsran/common/common.h"
+#include "srsran/common/threads.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace srsenb {
+namespace lte {
+
+/**
+ * Executes the independent jobs a subframe is split into (e.g. the UL and DL processing of each carrier) in order of
+ * their TX deadline. Jobs are run by a set of helper threads and by the subframe workers while they wait for the
+ * jobs of their own subframe, so any idle thread can take over the jobs of a late subframe.
+ */
+class sf_job_pool
+{
+public:
+  using sf_clock = std::chrono::steady_clock;
+  using task_t  = srsran::move_callback<void(), srsran::default_move_callback_buffer_size, true>;
+
+  /// Processing time available from the reception of a subframe until its transmission is due
+  static constexpr std::chrono::microseconds tx_budget{(FDD_HARQ_DELAY_UL_MS - 1) * 1000};
+
+  /// Jobs of one subframe, waited for together
+  class job_group
+  {
+  public:
+    job_group(uint32_t tti_, sf_clock::time_point deadline_) : tti(tti_), deadline(deadline_) {}
+    uint32_t            get_tti() const { return tti; }
+    sf_clock::time_point get_deadline() const { return deadline; }
+
+  private:
+    friend class sf_job_pool;
+    uint32_t            tti;
+    sf_clock::time_point deadline;
+    uint32_t            nof_pending = 0;
+  };
+
+  explicit sf_job_pool(srslog::basic_logger& logger_) : logger(logger_) {}
+  ~sf_job_pool();
+
+  void init(uint32_t nof_threads, int32_t prio);
+  void stop();
+
+  /// Queues a job of the group, to be executed by any thread of the pool
+  void push_job(job_group& group, task_t&& task);
+
+  /// Runs queued jobs, earliest deadline first, until all the jobs of the group have finished. Jobs of subframes with a
+  /// later deadline are left to the other threads, so that the caller returns as soon as its subframe is done
+  void wait(job_group& group);
+
+  /// Accounts a finished subframe in the metrics, given the time its processing started
+  void tti_finished(const job_group& group, sf_clock::time_point t_start);
+
+  void get_metrics(phy_sched_metrics_t& metrics);
+
+private:
+  struct job_t {
+    job_group* group;
+    uint64_t   seq;
+    task_t     task;
+  };
+
+  class helper_thread : public srsran::thread
+  {
+  public:
+    helper_thread(sf_job_pool* parent_, uint32_t id, int32_t prio);
+    void stop() { wait_thread_finish(); }
+
+  private:
+    void         run_thread() override;
+    sf_job_pool* parent;
+  };
+
+  static bool job_later(const job_t& a, const job_t& b);
+
+  /// Takes the most urgent job out of the queue, if its deadline is not later than the one of the limit group. Must be
+  /// called with the mutex locked
+  bool pop_job(job_t& job, const job_group* limit = nullptr);
+  void run_job(job_t& job, const job_group* owner);
+
+  srslog::basic_logger&                       logger;
+  std::vector<std::unique_ptr<helper_thread>> helpers;
+  std::vector<job_t>                          queue; ///< Min-heap on the group deadline, then on the push order
+  uint64_t                                    seq     = 0;
+  bool                                        running = false;
+  std::mutex                                  mutex;
+  std::condition_variable                     cvar_jobs;
+  std::condition_variable                     cvar_done;
+  phy_sched_metrics_t                         metrics = {};
+};
+
+} // namespace lte
+} // namespace srsenb
+
+#endif // SRSENB_LTE_SF_JOB_POOL_H
@@ -27,6 +27,7 @@
 
 #include "../phy_common.h"
 #include "cc_worker.h"
+#include "sf_job_pool.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
 
@@ -38,7 +39,7 @@ class sf_worker : public srsran::thread_pool::worker
 public:
   sf_worker(srslog::basic_logger& logger) : logger(logger) {}
   ~sf_worker();
-  void init(phy_common* phy);
+  void init(phy_common* phy, sf_job_pool* job_pool);
 
   cf_t* get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx);
   void  set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
@@ -60,6 +61,8 @@ public:
 
 private:
   void work_imp() final;
+  void work_ul_cc(uint32_t cc);
+  void work_dl_cc(uint32_t cc);
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -70,7 +73,17 @@ private:
 
   uint32_t                                       tti_rx = 0, tti_tx_dl = 0, tti_tx_ul = 0;
   std::vector<std::unique_ptr<cc_worker> >       cc_workers;
-  srsran::phy_common_interface::worker_context_t context = {};
+  srsran::phy_common_interface::worker_context_t context  = {};
+  sf_job_pool*                                   job_pool = nullptr;
+  sf_job_pool::sf_clock::time_point              t_start;
+
+  // Subframe configuration and grants, shared by the carrier jobs of the subframe
+  srsran_ul_sf_cfg_t                       ul_sf                      = {};
+  srsran_dl_sf_cfg_t                       dl_sf[SRSRAN_MAX_CARRIERS] = {};
+  srsran_mbsfn_cfg_t                       mbsfn_cfg                  = {};
+  stack_interface_phy_lte::ul_sched_list_t ul_grants;
+  stack_interface_phy_lte::ul_sched_list_t ul_grants_tx;
+  stack_interface_phy_lte::dl_sched_list_t dl_grants;
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
 };
@@ -22,6 +22,7 @@
 #ifndef SRSENB_LTE_WORKER_POOL_H
 #define SRSENB_LTE_WORKER_POOL_H
 
+#include "sf_job_pool.h"
 #include "sf_worker.h"
 #include "srsran/common/thread_pool.h"
 
@@ -32,17 +33,19 @@ class worker_pool
 {
   srsran::thread_pool                      pool;
   std::vector<std::unique_ptr<sf_worker> > workers;
+  sf_job_pool                              job_pool;
 
 public:
   sf_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
   uint32_t   get_nof_workers() { return (uint32_t)workers.size(); }
 
-  worker_pool(uint32_t max_workers);
+  worker_pool(uint32_t max_workers, srslog::basic_logger& logger);
   bool       init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio);
   sf_worker* wait_worker(uint32_t tti);
   sf_worker* wait_worker_id(uint32_t id);
   void       start_worker(sf_worker* w);
   void       stop();
+  void       get_sched_metrics(phy_sched_metrics_t& metrics);
 };
 
 } // namespace lte
@@ -63,9 +63,12 @@ struct phy_args_t {
   float                   max_prach_offset_us = 10;
   uint32_t                pusch_max_its       = 10;
   uint32_t                nr_pusch_max_its    = 10;
+  uint32_t                nr_pusch_cb_threads = 1;
   bool                    pusch_8bit_decoder  = false;
+  uint32_t                pusch_cb_threads    = 1;
   float                   tx_amplitude        = 1.0f;
   uint32_t                nof_phy_threads     = 1;
+  uint32_t                nof_phy_job_threads = 0;
   std::string             equalizer_mode      = "mmse";
   float                   estimator_fil_w     = 1.0f;
   bool                    pusch_meas_epre     = true;
@@ -74,6 +77,7 @@ struct phy_args_t {
   bool                    pucch_meas_ta       = true;
   bool                    use_cedron_alg      = false;
   uint32_t                nof_prach_threads   = 1;
+  uint32_t                nof_prach_buffers   = 8;
   bool                    extended_cp         = false;
   srsran::channel::args_t dl_channel_args;
   srsran::channel::args_t ul_channel_args;
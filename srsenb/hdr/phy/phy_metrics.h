@@ -22,7 +22,9 @@
 #ifndef SRSENB_PHY_METRICS_H
 #define SRSENB_PHY_METRICS_H
 
+#include <array>
 #include <limits>
+#include <stdint.h>
 
 namespace srsenb {
 
@@ -53,6 +55,22 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// PHY subframe processing metrics, since the last report
+
+struct phy_sched_metrics_t {
+  static const uint32_t nof_latency_bins = 8;   ///< Number of bins of the subframe latency histogram
+  static const uint32_t latency_bin_us   = 500; ///< Width of each latency bin, the last one collects the rest
+
+  uint32_t nof_ttis;        ///< Processed subframes
+  uint32_t nof_late_ttis;   ///< Subframes that finished after their TX deadline
+  uint32_t nof_jobs;        ///< Processed subframe jobs
+  uint32_t nof_late_jobs;   ///< Jobs that finished after the TX deadline of their subframe
+  uint32_t nof_stolen_jobs; ///< Jobs executed by the worker of another subframe
+  float    min_slack_us;    ///< Smallest time left to the TX deadline when a subframe finished, negative if late
+
+  std::array<uint32_t, nof_latency_bins> latency_hist; ///< Histogram of the subframe processing latency
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
@@ -23,9 +23,12 @@
 #define SRSENB_PHY_UE_DB_H_
 
 #include "phy_interfaces.h"
+#include "srsenb/hdr/common/rcu_rnti_map.h"
+#include "srsran/common/rcu.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
-#include <map>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <srsran/adt/circular_array.h>
 
@@ -81,37 +84,66 @@ private:
   } cell_state_t;
 
   /**
-   * Cell information for the UE database
+   * Cell configuration for the UE database
    */
   struct cell_info_t {
-    cell_state_t state      = cell_state_none; ///< Configuration state
-    uint32_t     enb_cc_idx = 0;               ///< Corresponding eNb cell/carrier index
-    uint8_t      last_ri    = 0;               ///< Last reported rank indicator
+    cell_state_t      state                   = cell_state_none; ///< Configuration state
+    uint32_t          enb_cc_idx              = 0;               ///< Corresponding eNb cell/carrier index
+    bool              stash_use_tbs_index_alt = false;
+    srsran::phy_cfg_t phy_cfg; ///< Configuration, it has a default constructor
+  };
+
+  /**
+   * UE configuration. A published configuration is never modified: the stack replaces it with an updated copy, and the
+   * previous copy is deleted once no PHY worker can be reading it anymore
+   */
+  struct ue_cfg_t {
+    bool                                         stashed_multiple_csi_request_enabled = false;
+    std::array<cell_info_t, SRSRAN_MAX_CARRIERS> cell_info = {}; ///< Cell configurations, indexed by ue_cc_idx
+  };
+
+  /**
+   * Cell state updated by the PHY workers
+   */
+  struct cell_ctxt_t {
+    uint8_t last_ri = 0; ///< Last reported rank indicator
     srsran::circular_array<srsran_ra_tb_t, SRSRAN_MAX_HARQ_PROC> last_tb =
         {}; ///< Stores last PUSCH Resource allocation
-    bool                                    stash_use_tbs_index_alt = false;
-    srsran::phy_cfg_t                       phy_cfg;            ///< Configuration, it has a default constructor
-    srsran::circular_array<bool, TTIMOD_SZ> is_grant_available; ///< Indicates whether there is an available grant
+    srsran::circular_array<bool, TTIMOD_SZ> is_grant_available = {}; ///< Indicates whether there is an available grant
   };
 
   /**
    * UE object stored in the PHY common database
    */
   struct common_ue {
-    bool                                                  stashed_multiple_csi_request_enabled = false;
+    explicit common_ue(uint16_t rnti_) : rnti(rnti_) {}
+    common_ue(const common_ue&) = delete;
+    common_ue& operator=(const common_ue&) = delete;
+    ~common_ue() { delete cfg.load(std::memory_order_relaxed); }
+    uint16_t get_rnti() const { return rnti; }
+
+    const uint16_t               rnti;
+    std::atomic<const ue_cfg_t*> cfg{nullptr}; ///< Current configuration, replaced by the stack
+
+    /// Protects the state below, which is only accessed by the PHY workers. Workers processing different subframes only
+    /// contend if they access the same UE at the same time
+    std::mutex                                            mutex;
     srsran::circular_array<srsran_pdsch_ack_t, TTIMOD_SZ> pdsch_ack = {}; ///< Pending acknowledgements for this Cell
-    std::array<cell_info_t, SRSRAN_MAX_CARRIERS>          cell_info = {}; ///< Cell information, indexed by ue_cell_idx
+    std::array<cell_ctxt_t, SRSRAN_MAX_CARRIERS>          cell_ctxt = {}; ///< Cell state, indexed by ue_cc_idx
   };
 
   /**
-   * UE database indexed by RNTI
+   * UE database indexed by RNTI. PHY workers look up UEs and read their configuration within read-side sections of
+   * ue_rcu, which never block. UEs and configurations removed by the stack are deleted once the ongoing read-side
+   * sections finish.
    */
-  std::map<uint16_t, common_ue> ue_db;
+  mutable srsran::rcu_domain ue_rcu;
+  rcu_rnti_map<common_ue>    ue_db{ue_rcu};
 
   /**
-   * Concurrency protection mutex, allowed modifications from const methods.
+   * Serializes the configuration changes from the stack
    */
-  mutable std::mutex mutex;
+  std::mutex cfg_mutex;
 
   /**
    * Stack interface
@@ -129,20 +161,30 @@ private:
   const phy_cell_cfg_list_t* cell_cfg_list = nullptr;
 
   /**
-   * Internal RNTI addition, it is not thread safe protected
+   * Internal RNTI addition, it must be called with cfg_mutex locked
    *
    * @param rnti identifier of the UE
-   * @return SRSRAN_SUCCESS if the RNTI is not duplicated and is added successfully, SRSRAN_ERROR code if it exists
+   * @return the added UE, nullptr if the RNTI position in the database is taken
    */
-  inline int _add_rnti(uint16_t rnti);
+  inline common_ue* _add_rnti(uint16_t rnti);
 
   /**
-   * Internal pending ACK clear for a given RNTI and TTI, it is not thread safe protected
+   * Internal publication of a new UE configuration, it must be called with cfg_mutex locked. The previous
+   * configuration is deleted once the PHY workers stop reading it.
+   *
+   * @param ue the UE to configure
+   * @param cfg the new configuration
+   */
+  inline void _publish_cfg(common_ue& ue, std::unique_ptr<ue_cfg_t> cfg);
+
+  /**
+   * Internal pending ACK clear for a given UE and TTI, it must be called with the UE mutex locked
    *
    * @param tti is the given TTI (requires assertion prior to call)
-   * @param rnti identifier of the UE (requires assertion prior to call)
+   * @param ue the UE whose pending ACK are cleared
+   * @param cfg the current UE configuration
    */
-  inline void _clear_tti_pending_rnti(uint32_t tti, uint16_t rnti);
+  static inline void _clear_tti_pending_rnti(uint32_t tti, common_ue& ue, const ue_cfg_t& cfg);
 
   /**
    * Helper method to set the constant attributes of a given RNTI after the configuration is set, it does not modify
@@ -154,65 +196,68 @@ private:
   inline void _set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t& phy_cfg) const;
 
   /**
-   * Gets the SCell index for a given RNTI and a eNb cell/carrier. It returns the SCell index (0 if PCell) if the cc_idx
-   * is found among the configured cells/carriers. Otherwise, it returns SRSRAN_MAX_CARRIERS.
+   * Gets the current configuration of a UE. It must be called within a read-side section of ue_rcu, or with cfg_mutex
+   * locked.
    *
-   * @param rnti identifier of the UE (requires assertion prior to call)
+   * @param ue the UE, it can be nullptr
+   * @return the UE configuration, or nullptr if the UE does not exist
+   */
+  static inline const ue_cfg_t* _get_ue_cfg(const common_ue* ue);
+
+  /**
+   * Gets the SCell index for a given UE configuration and a eNb cell/carrier. It returns the SCell index (0 if PCell)
+   * if the cc_idx is found among the configured cells/carriers. Otherwise, it returns SRSRAN_MAX_CARRIERS.
+   *
+   * @param cfg the UE configuration, if nullptr it returns SRSRAN_MAX_CARRIERS
    * @param enb_cc_idx the eNb cell/carrier index to look for in the RNTI.
    * @return the SCell index as described above.
    */
-  inline uint32_t _get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline uint32_t _get_ue_cc_idx(const ue_cfg_t* cfg, uint32_t enb_cc_idx);
 
   /**
    * Gets the eNb Cell/Carrier index in which the UCI shall be carried. This corresponds to the serving cell with lowest
-   * index that has an UL grant available.
+   * index that has an UL grant available. It must be called with the UE mutex locked.
    *
    * If no grant is available in the indicated TTI, it returns the number of the eNb Cells/Carriers.
    *
    * @param tti The UL processing TTI
-   * @param rnti Temporal UE ID
+   * @param ue the UE
+   * @param cfg the current UE configuration
    * @return the eNb Cell/Carrier with lowest serving cell index that has an UL grant
    */
-  uint32_t _get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const;
-
-  /**
-   * Checks if a given RNTI exists in the database
-   * @param rnti provides UE identifier
-   * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
-   */
-  inline int _assert_rnti(uint16_t rnti) const;
+  uint32_t _get_uci_enb_cc_idx(uint32_t tti, const common_ue& ue, const ue_cfg_t& cfg) const;
 
   /**
-   * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell
-   * @param rnti provides UE identifier
+   * Checks if a UE is configured to use an specified eNb cell/carrier as PCell or SCell
+   * @param cfg provides the UE configuration, it can be nullptr
    * @param enb_cc_idx provides eNb cell/carrier
    * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_enb_cc(const ue_cfg_t* cfg, uint32_t enb_cc_idx);
 
   /**
-   * Checks if an RNTI uses a given eNb cell/carrier as PCell
-   * @param rnti provides UE identifier
+   * Checks if a UE uses a given eNb cell/carrier as PCell
+   * @param cfg provides the UE configuration, it can be nullptr
    * @param enb_cc_idx provides eNb cell/carrier index
    * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier of the RNTI is a PCell, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_enb_pcell(const ue_cfg_t* cfg, uint32_t enb_cc_idx);
 
   /**
-   * Checks if an RNTI is configured to use an specified UE cell/carrier as PCell or SCell
-   * @param rnti provides UE identifier
+   * Checks if a UE is configured to use an specified UE cell/carrier as PCell or SCell
+   * @param cfg provides the UE configuration, it can be nullptr
    * @param ue_cc_idx UE cell/carrier index that is asserted
    * @return SRSRAN_SUCCESS if the indicated cell/carrier index is valid, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const;
+  static inline int _assert_ue_cc(const ue_cfg_t* cfg, uint32_t ue_cc_idx);
 
   /**
-   * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell and it is active
-   * @param rnti provides UE identifier
+   * Checks if a UE is configured to use an specified eNb cell/carrier as PCell or SCell and it is active
+   * @param cfg provides the UE configuration, it can be nullptr
    * @param enb_cc_idx UE cell/carrier index that is asserted
    * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier is active, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_active_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_active_enb_cc(const ue_cfg_t* cfg, uint32_t enb_cc_idx);
 
   /**
    * Internal eNb stack assertion
@@ -227,22 +272,31 @@ private:
   inline int _assert_cell_list_cfg() const;
 
   /**
-   * Internal eNb general configuration getter, returns default configuration if the UE does not exist in the given cell
+   * Internal eNb general configuration getter, it must be called within a read-side section of ue_rcu
    *
    * @param rnti provides UE identifier
    * @param enb_cc_idx eNb cell index
-   * @param[out] phy_cfg The PHY configuration of the indicated UE for the indicated eNb carrier/call index.
-   * @return SRSRAN_SUCCESS if provided context is correct, SRSRAN_ERROR code otherwise
+   * @param[out] ue_cc_idx The UE cell/carrier index of the indicated eNb cell/carrier
+   * @return the configuration of the indicated UE, nullptr if the UE does not exist or does not use the eNb
+   * cell/carrier
+   */
+  inline const ue_cfg_t* _get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, uint32_t& ue_cc_idx) const;
+
+  /**
+   * Internal getter of the default configuration, used for non-user RNTIs
+   *
+   * @param rnti provides the RNTI
+   * @return the default PHY configuration for the indicated RNTI
    */
-  inline int _get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const;
+  static inline srsran::phy_cfg_t _get_default_config(uint16_t rnti);
 
   /**
    * Count number of configured secondary serving cells
    *
-   * @param rnti provides UE identifier
+   * @param cfg provides the UE configuration
    * @return The number of configured secondary cells
    */
-  inline uint32_t _count_nof_configured_scell(uint16_t rnti);
+  static inline uint32_t _count_nof_configured_scell(const ue_cfg_t& cfg);
 
 public:
   /**
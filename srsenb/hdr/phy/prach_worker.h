@@ -24,10 +24,13 @@
 
 #include "srsran/common/block_queue.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 // Setting ENABLE_PRACH_GUI to non zero enables a GUI showing signal received in the PRACH window.
 #define ENABLE_PRACH_GUI 0
@@ -43,8 +46,8 @@ class stack_interface_phy_lte;
 class prach_worker : srsran::thread
 {
 public:
-  prach_worker(uint32_t cc_idx_, srslog::basic_logger& logger) :
-    buffer_pool(8), thread("PRACH_WORKER"), logger(logger), running(false)
+  prach_worker(uint32_t cc_idx_, uint32_t nof_buffers, srslog::basic_logger& logger) :
+    buffer_pool(nof_buffers), thread("PRACH_WORKER"), logger(logger), running(false)
   {
     cc_idx = cc_idx_;
   }
@@ -104,8 +107,30 @@ private:
   uint32_t                 sf_cnt      = 0;
   uint32_t                 nof_workers = 0;
 
+  /// Search of a contiguous range of the PRACH roots, run by one of the detection workers
+  struct root_search_t {
+    srsran_prach_t prach        = {};
+    uint32_t       root_begin   = 0;
+    uint32_t       root_end     = 0;
+    uint32_t       nof_det      = 0;
+    uint32_t       indices[165] = {};
+    float          offsets[165] = {};
+    float          p2avg[165]   = {};
+  };
+
+  // When more than one worker is configured, the roots are split between the PRACH thread, which searches the first
+  // range, and the detection workers, which search the remaining ones
+  std::unique_ptr<srsran::task_thread_pool>    detect_workers;
+  std::vector<std::unique_ptr<root_search_t> > root_searches;
+  uint32_t                                     root_split_end       = 0;
+  uint32_t                                     nof_pending_searches = 0;
+  std::mutex                                   detect_mutex;
+  std::condition_variable                      detect_cvar;
+
   void run_thread() final;
   int  run_tti(sf_buffer* b);
+  int  init_root_searches(int priority);
+  int  detect(sf_buffer* b, uint32_t* nof_det);
 };
 
 class prach_worker_pool
@@ -123,11 +148,12 @@ public:
             stack_interface_phy_lte*  mac,
             srslog::basic_logger&     logger,
             int                       priority,
-            uint32_t                  nof_workers_x_cc)
+            uint32_t                  nof_workers_x_cc,
+            uint32_t                  nof_buffers = 8)
   {
     // Create PRACH worker if required
     while (cc_idx >= prach_vec.size()) {
-      prach_vec.push_back(std::unique_ptr<prach_worker>(new prach_worker(prach_vec.size(), logger)));
+      prach_vec.push_back(std::unique_ptr<prach_worker>(new prach_worker(prach_vec.size(), nof_buffers, logger)));
     }
 
     prach_vec[cc_idx]->init(cell_, prach_cfg_, mac, priority, nof_workers_x_cc);
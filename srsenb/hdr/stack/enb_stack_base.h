@@ -22,6 +22,7 @@
 #ifndef SRSRAN_ENB_STACK_BASE_H
 #define SRSRAN_ENB_STACK_BASE_H
 
+#include "srsran/common/pcap_block_writer.h"
 #include "srsran/interfaces/enb_interfaces.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_s1ap_interfaces.h"
@@ -31,8 +32,9 @@
 namespace srsenb {
 
 typedef struct {
-  bool        enable;
-  std::string filename;
+  bool                       enable;
+  std::string                filename;
+  srsran::pcap_writer_args_t writer;
 } pcap_args_t;
 
 typedef struct {
@@ -71,6 +73,8 @@ typedef struct {
 typedef struct {
   uint32_t         sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
   uint32_t         gtpu_indirect_tunnel_timeout_msec;
+  uint32_t         gtpu_nof_rx_threads;
+  uint32_t         nof_ue_shards; // Threads the per-UE user-plane is sharded over, 0 to run it in the stack thread
   mac_args_t       mac;
   s1ap_args_t      s1ap;
   pcap_args_t      mac_pcap;
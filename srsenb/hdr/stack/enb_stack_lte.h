@@ -33,6 +33,7 @@
 #include "srsran/common/task_scheduler.h"
 #include "upper/gtpu.h"
 #include "upper/pdcp.h"
+#include "upper/pdcp_sharded.h"
 #include "upper/rlc.h"
 
 #include "enb_stack_base.h"
@@ -186,6 +187,10 @@ private:
   srsenb::gtpu gtpu;
   srsenb::s1ap s1ap;
 
+  // UE shards, where the PDCP of each UE runs when the user-plane is sharded. Otherwise, pdcp runs in the stack thread
+  ue_shard_pool                 ue_shards;
+  std::unique_ptr<pdcp_sharded> pdcp_shards;
+
   // RAT-specific interfaces
   phy_interface_stack_lte* phy = nullptr;
 
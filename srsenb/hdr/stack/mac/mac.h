@@ -24,12 +24,14 @@
 
 #include "sched.h"
 #include "sched_interface.h"
+#include "srsenb/hdr/common/rcu_rnti_map.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_rr.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/pool/batch_mem_pool.h"
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/mac_pcap_net.h"
+#include "srsran/common/rcu.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/threads.h"
 #include "srsran/common/tti_sync_cv.h"
@@ -115,9 +117,10 @@ public:
                   const uint8_t              mcch_payload_length) override;
 
 private:
-  bool     check_ue_active(uint16_t rnti);
+  ue*      find_active_ue(uint16_t rnti);
   uint16_t allocate_ue(uint32_t enb_cc_idx);
   bool     is_valid_rnti_unprotected(uint16_t rnti);
+  void     reclaim_removed_ues();
 
   /* helper function for PDCCH orders */
   /**
@@ -131,9 +134,9 @@ private:
 
   srslog::basic_logger& logger;
 
-  // We use a rwlock in MAC to allow multiple workers to access MAC simultaneously. No conflicts will happen since
-  // access for different TTIs
-  pthread_rwlock_t rwlock = {};
+  // PHY workers and other readers access the UE DB inside RCU read-side sections, which never block, even while UEs
+  // are being added or removed. Removed UEs are only deleted once the read-side sections that could access them end
+  srsran::rcu_domain ue_rcu;
 
   // Interaction with PHY
   phy_interface_stack_lte*      phy_h = nullptr;
@@ -147,7 +150,7 @@ private:
   // derived from args
   srsran::task_multiqueue::queue_handle stack_task_queue;
 
-  bool started = false;
+  std::atomic<bool> started{false};
 
   /* Scheduler unit */
   sched                                    scheduler;
@@ -156,9 +159,10 @@ private:
   sched_interface::dl_pdu_mch_t mch = {};
 
   /* Map of active UEs */
-  static const uint16_t            FIRST_RNTI = 0x46;
-  rnti_map_t<unique_rnti_ptr<ue> > ue_db;
-  std::atomic<uint16_t>            ue_counter{0};
+  static const uint16_t FIRST_RNTI = 0x46;
+  rcu_rnti_map<ue>      ue_db{ue_rcu};
+  std::atomic<uint16_t> ue_counter{0};
+  bool                  ue_reclaim_pending = false; ///< accessed from the stack thread only
 
   uint8_t* assemble_rar(sched_interface::dl_sched_rar_grant_t* grants,
                         uint32_t                               enb_cc_idx,
@@ -26,7 +26,9 @@
 #include "sched_interface.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/common/thread_pool.h"
 #include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 
@@ -94,6 +96,8 @@ public:
 
 protected:
   void new_tti(srsran::tti_point tti_rx);
+  void new_tti_parallel(srsran::tti_point tti_rx);
+  void generate_cc_group_results(srsran::tti_point tti_rx, uint32_t group_idx);
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
   // Helper methods
   template <typename Func>
@@ -112,6 +116,15 @@ protected:
   // Storage of past scheduling results
   sched_result_ringbuffer sched_results;
 
+  // Carriers without UEs in common are scheduled in parallel in the carrier worker pool
+  using cc_group_t = srsran::bounded_vector<uint32_t, SRSRAN_MAX_CARRIERS>;
+  std::unique_ptr<srsran::task_thread_pool>               cc_workers;
+  srsran::bounded_vector<cc_group_t, SRSRAN_MAX_CARRIERS> cc_groups;
+  uint32_t                                                nof_pending_cc_groups = 0;
+  std::mutex                                              cc_workers_mutex;
+  std::condition_variable                                 cc_workers_cvar;
+  std::mutex                                              rrc_mutex;
+
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
   bool              configured;
@@ -37,6 +37,7 @@ class sched::carrier_sched
 {
 public:
   explicit carrier_sched(rrc_interface_mac*       rrc_,
+                         std::mutex*              rrc_mutex_,
                          sched_ue_list*           ue_db_,
                          uint32_t                 enb_cc_idx_,
                          sched_result_ringbuffer* sched_results_);
@@ -66,8 +67,9 @@ private:
   // args
   const sched_cell_params_t* cc_cfg = nullptr;
   srslog::basic_logger&      logger;
-  rrc_interface_mac*         rrc   = nullptr;
-  sched_ue_list*             ue_db = nullptr;
+  rrc_interface_mac*         rrc       = nullptr;
+  std::mutex*                rrc_mutex = nullptr; ///< serializes the RRC queries of carriers scheduled in parallel
+  sched_ue_list*             ue_db     = nullptr;
   const uint32_t             enb_cc_idx;
 
   // Subframe scheduling logic
@@ -92,7 +94,7 @@ private:
 class bc_sched
 {
 public:
-  explicit bc_sched(const sched_cell_params_t& cfg_, rrc_interface_mac* rrc_);
+  explicit bc_sched(const sched_cell_params_t& cfg_, rrc_interface_mac* rrc_, std::mutex* rrc_mutex_);
   void dl_sched(sf_sched* tti_sched);
   void reset();
 
@@ -108,8 +110,9 @@ private:
   void alloc_paging(sf_sched* tti_sched);
 
   // args
-  const sched_cell_params_t* cc_cfg = nullptr;
-  rrc_interface_mac*         rrc    = nullptr;
+  const sched_cell_params_t* cc_cfg    = nullptr;
+  rrc_interface_mac*         rrc       = nullptr;
+  std::mutex*                rrc_mutex = nullptr;
   srslog::basic_logger&      logger;
 
   std::array<sched_sib_t, sched_interface::MAX_SIBS> pending_sibs;
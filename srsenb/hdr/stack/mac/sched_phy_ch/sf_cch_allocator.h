@@ -34,6 +34,8 @@ class sf_cch_allocator
 {
 public:
   const static uint32_t MAX_CFI = 3;
+  /// Number of DCIs from which the DFS is pruned. Smaller DFS trees are searched faster without the pruning overhead
+  const static uint32_t MIN_NOF_DCIS_DFS_PRUNING = 4;
   struct tree_node {
     int8_t                pucch_n_prb = -1; ///< this PUCCH resource identifier
     uint16_t              rnti        = SRSRAN_INVALID_RNTI;
@@ -70,18 +72,83 @@ public:
   std::string result_to_string(bool verbose = false) const;
 
 private:
+  /// CCE position of a DCI that does not collide with the DCI's own SR and PUCCH HARQ region restrictions
+  struct cce_candidate {
+    int8_t   pucch_n_prb = -1; ///< PUCCH resource for the HARQ-ACK, if required
+    uint32_t ncce        = 0;
+  };
+  using cce_candidate_list = srsran::bounded_vector<cce_candidate, MAX_NOF_CCE_POS>;
+
   /// DCI allocation parameters
   struct alloc_record {
     bool         pusch_uci;
     uint32_t     aggr_idx;
     alloc_type_t alloc_type;
     sched_ue*    user;
+    /// CCE candidates of the DCI for each CFI, computed on demand and reused in the DFS of following allocations
+    std::array<cce_candidate_list, MAX_CFI> candidates;
+    std::array<uint32_t, MAX_CFI>           nof_locs_checked; ///< CCE positions already checked for candidates
+    std::array<bool, MAX_CFI>               candidates_set;   ///< All the CCE positions were checked
+  };
+  /// CCE bits (first two words) and PUCCH PRB bits (last two words) of a DFS search state
+  using dfs_state_bits = std::array<uint64_t, 4>;
+  /// DFS search state, i.e. the DCIs placed so far and the CCEs and PUCCH PRBs that they occupy
+  struct dfs_state {
+    uint32_t       depth = 0;
+    uint32_t       cfix  = 0;
+    dfs_state_bits bits  = {};
+
+    bool operator==(const dfs_state& other) const
+    {
+      return depth == other.depth and cfix == other.cfix and bits == other.bits;
+    }
+  };
+  /// Fixed-size open addressing set of DFS states without solution. When the probe window of a state is full, the new
+  /// state overwrites an older one, which only costs search time. It is cleared in constant time, by moving to a new
+  /// generation of entries
+  class dfs_state_memory
+  {
+  public:
+    bool empty() const { return nof_states == 0; }
+    bool contains(const dfs_state& state) const;
+    void insert(const dfs_state& state);
+    void clear();
+
+  private:
+    const static uint32_t capacity_log2 = 10;
+    const static uint32_t capacity      = 1U << capacity_log2;
+    const static uint32_t max_probes    = 8;
+
+    static uint32_t hash(const dfs_state& state);
+
+    std::array<dfs_state, capacity> states;
+    std::array<uint32_t, capacity>  generations = {};
+    uint32_t                        generation  = 1;
+    uint32_t                        nof_states  = 0;
   };
   const cce_cfi_position_table* get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
+  const cce_candidate_list&     get_cce_candidates(uint32_t record_idx, uint32_t min_size = MAX_NOF_CCE_POS)
+  {
+    alloc_record& record = dci_record_list[record_idx];
+    if (record.candidates_set[current_cfix] or record.candidates[current_cfix].size() >= min_size) {
+      return record.candidates[current_cfix];
+    }
+    return compute_cce_candidates(record, min_size);
+  }
+  const cce_candidate_list&     compute_cce_candidates(alloc_record& record, uint32_t min_size);
+  const dfs_state_bits&         get_dfs_reach(uint32_t depth);
+  dfs_state                     make_dfs_state(uint32_t             depth,
+                                               const pdcch_mask_t&  total_mask,
+                                               const prbmask_t&     total_pucch_mask,
+                                               const cce_candidate* cand);
 
   // PDCCH allocation algorithm
-  bool alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
+  bool alloc_dfs_node(uint32_t record_idx, uint32_t start_child_idx);
   bool get_next_dfs();
+  bool fits_remaining_dcis(uint32_t             record_idx,
+                           const pdcch_mask_t&  total_mask,
+                           const prbmask_t&     total_pucch_mask,
+                           const cce_candidate& cand);
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -94,6 +161,11 @@ private:
   uint32_t                  current_max_cfix = 0;
   std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
   std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
+  /// DFS states found to have no solution in the current DCI allocation, which are not searched again when reached
+  /// through another permutation of the past DCI positions
+  dfs_state_memory            failed_dfs_states;
+  std::vector<dfs_state_bits> dfs_reach; ///< CCEs and PUCCH PRBs that the DCIs from each record onwards could take
+  uint32_t                    dfs_reach_cfix = MAX_CFI; ///< CFI index of "dfs_reach", or MAX_CFI if not computed
 };
 
 // Helper methods
@@ -173,12 +173,14 @@ public:
 
   // stack interface
   void handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
+  void handle_gtpu_s1u_rx_burst(srsran::span<srsran::rx_datagram_t> burst);
   void handle_gtpu_m1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
 
 private:
   static const int GTPU_PORT = 2152;
 
   void rem_tunnel(uint32_t teidin);
+  int  open_s1u_socket();
 
   srsran::socket_manager_itf* rx_socket_handler = nullptr;
   srsran::task_queue_handle   gtpu_queue;
@@ -228,12 +230,24 @@ private:
   // Socket file descriptor
   int fd = -1;
 
+  // Additional S1-U sockets bound to the same port, each one received by its own thread
+  std::vector<int>                                     rx_fds;
+  std::vector<std::unique_ptr<srsran::socket_manager> > rx_workers;
+
+  // SDUs of consecutive G-PDUs of the same bearer, written to PDCP at once
+  uint16_t                                  pdcp_batch_rnti          = SRSRAN_INVALID_RNTI;
+  uint32_t                                  pdcp_batch_eps_bearer_id = 0;
+  std::vector<srsran::unique_byte_buffer_t> pdcp_batch;
+
   void send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buffer_t pdu, int pdcp_sn = -1);
 
   void echo_response(in_addr_t addr, in_port_t port, uint16_t seq);
   void error_indication(in_addr_t addr, in_port_t port, uint32_t err_teid);
   bool send_end_marker(uint32_t teidin);
 
+  void handle_s1u_pdu(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
+  void write_pdcp_sdu(uint16_t rnti, uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu, uint32_t pdcp_sn);
+  void flush_pdcp_batch();
   void handle_end_marker(const gtpu_tunnel& rx_tunnel);
   void handle_msg_data_pdu(const srsran::gtpu_header_t& header,
                            const gtpu_tunnel&           rx_tunnel,
@@ -61,6 +61,19 @@ public:
       logger.warning("Can't deliver SDU for EPS bearer %d. Dropping it.", eps_bearer_id);
     }
   }
+  void write_sdu_batch(uint16_t rnti, uint32_t eps_bearer_id, std::vector<srsran::unique_byte_buffer_t>& sdus) override
+  {
+    auto bearer = bearers->get_radio_bearer(rnti, eps_bearer_id);
+    // route SDUs to PDCP entity
+    if (bearer.rat == srsran::srsran_rat_t::lte) {
+      pdcp_lte_obj->write_sdu_batch(rnti, bearer.lcid, sdus);
+    } else if (bearer.rat == srsran::srsran_rat_t::nr) {
+      pdcp_nr_obj->write_sdu_batch(rnti, bearer.lcid, sdus);
+    } else {
+      logger.warning("Can't deliver %zd SDUs for EPS bearer %d. Dropping them.", sdus.size(), eps_bearer_id);
+      sdus.clear();
+    }
+  }
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t eps_bearer_id) override
   {
     auto bearer = bearers->get_radio_bearer(rnti, eps_bearer_id);
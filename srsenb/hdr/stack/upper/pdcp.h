@@ -70,10 +70,12 @@ public:
   void reestablish(uint16_t rnti) override;
 
   // pdcp_interface_gtpu
+  void write_sdu_batch(uint16_t rnti, uint32_t lcid, std::vector<srsran::unique_byte_buffer_t>& sdus) override;
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override;
 
   // Metrics
   void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
+  void get_metrics(std::map<uint16_t, srsran::pdcp_metrics_t>& ues, const uint32_t nof_tti);
 
 private:
   class user_interface_rlc : public srsue::rlc_interface_pdcp
@@ -82,11 +84,12 @@ private:
     uint16_t                    rnti;
     srsenb::rlc_interface_pdcp* rlc;
     // rlc_interface_pdcp
-    void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu);
-    void discard_sdu(uint32_t lcid, uint32_t discard_sn);
-    bool rb_is_um(uint32_t lcid);
-    bool sdu_queue_is_full(uint32_t lcid);
-    bool is_suspended(uint32_t lcid);
+    void     write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu);
+    void     discard_sdu(uint32_t lcid, uint32_t discard_sn);
+    bool     rb_is_um(uint32_t lcid);
+    bool     sdu_queue_is_full(uint32_t lcid);
+    uint32_t sdu_queue_free_space(uint32_t lcid);
+    bool     is_suspended(uint32_t lcid);
   };
 
   class user_interface_gtpu : public srsue::gw_interface_pdcp
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_PDCP_SHARDED_H
+#define SRSENB_PDCP_SHARDED_H
+
+#include "srsenb/hdr/stack/upper/pdcp.h"
+#include "srsenb/hdr/stack/upper/ue_shard_pool.h"
+#include "srsran/interfaces/enb_gtpu_interfaces.h"
+#include "srsran/interfaces/enb_rrc_interface_pdcp.h"
+#include <deque>
+#include <mutex>
+
+namespace srsenb {
+
+/**
+ * PDCP split across the UE shards of the stack. Each shard runs its own PDCP instance, with the timers of the shard,
+ * and every call for a UE is executed in the shard of its RNTI. Calls returning a value block until the shard has
+ * handled them. The PDUs and notifications the PDCP entities send towards RRC and GTP-U are handed back to the stack
+ * thread, which keeps the control plane single-threaded. RLC is called directly from the shards.
+ * The shards never block on the stack thread, which may be waiting for one of them. The UL data towards GTP-U goes
+ * through a bounded queue and is dropped when the stack thread falls behind, whereas the messages towards RRC are
+ * kept in an unbounded list and are never dropped.
+ */
+class pdcp_sharded final : public pdcp_interface_rlc, public pdcp_interface_gtpu, public pdcp_interface_rrc
+{
+public:
+  pdcp_sharded(ue_shard_pool&            shards_,
+               srsran::task_sched_handle stack_task_sched,
+               srslog::basic_logger&     logger_,
+               uint32_t                  ul_data_queue_size = MULTIQUEUE_DEFAULT_CAPACITY);
+  void init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_);
+  void stop();
+
+  // pdcp_interface_rlc
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override;
+  void notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) override;
+  void notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) override;
+
+  // pdcp_interface_rrc
+  void set_enabled(uint16_t rnti, uint32_t lcid, bool enabled) override;
+  void reset(uint16_t rnti) override;
+  void add_user(uint16_t rnti) override;
+  void rem_user(uint16_t rnti) override;
+  void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn = -1) override;
+  void add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cnfg) override;
+  void del_bearer(uint16_t rnti, uint32_t lcid) override;
+  void config_security(uint16_t rnti, uint32_t lcid, const srsran::as_security_config_t& cfg_sec) override;
+  void enable_integrity(uint16_t rnti, uint32_t lcid) override;
+  void enable_encryption(uint16_t rnti, uint32_t lcid) override;
+  bool get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state_t* state) override;
+  bool set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte_state_t& state) override;
+  void send_status_report(uint16_t rnti) override;
+  void send_status_report(uint16_t rnti, uint32_t lcid) override;
+  void reestablish(uint16_t rnti) override;
+
+  // pdcp_interface_gtpu
+  void write_sdu_batch(uint16_t rnti, uint32_t lcid, std::vector<srsran::unique_byte_buffer_t>& sdus) override;
+  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override;
+
+  // Metrics
+  void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
+
+  /// Number of UL data PDUs dropped since the start because the stack thread could not keep up
+  uint32_t get_nof_dropped_ul_pdus() const { return nof_dropped_ul_pdus.load(std::memory_order_relaxed); }
+
+private:
+  // Forwards the RRC messages received by the shards to the stack thread
+  class rrc_adapter final : public rrc_interface_pdcp
+  {
+  public:
+    void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override;
+    void notify_pdcp_integrity_error(uint16_t rnti, uint32_t lcid) override;
+
+    pdcp_sharded*       parent = nullptr;
+    rrc_interface_pdcp* rrc    = nullptr;
+  };
+
+  // Forwards the UL data received by the shards to the stack thread, where the GTP-U tunnels are handled
+  class gtpu_adapter final : public gtpu_interface_pdcp
+  {
+  public:
+    void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override;
+
+    pdcp_sharded*        parent = nullptr;
+    gtpu_interface_pdcp* gtpu   = nullptr;
+  };
+
+  pdcp& shard_pdcp(uint16_t rnti) { return *pdcps[shards.shard_idx(rnti)]; }
+  void  push(uint16_t rnti, srsran::move_task_t task) { shards.push(shards.shard_idx(rnti), std::move(task)); }
+  void  run_sync(uint16_t rnti, srsran::move_task_t task) { shards.run_sync(shards.shard_idx(rnti), std::move(task)); }
+  void  push_stack_data_task(srsran::move_task_t task);
+  void  push_stack_ctrl_task(srsran::move_task_t task);
+  void  run_stack_ctrl_tasks();
+
+  ue_shard_pool&                     shards;
+  srslog::basic_logger&              logger;
+  srsran::task_queue_handle          stack_data_queue;
+  srsran::task_queue_handle          stack_ctrl_queue; ///< Holds at most one task, which runs all the ctrl_tasks
+  std::mutex                         ctrl_mutex;
+  std::deque<srsran::move_task_t>    ctrl_tasks;
+  bool                               ctrl_run_pending = false;
+  std::atomic<uint32_t>              nof_dropped_ul_pdus{0};
+  rrc_adapter                        rrc_itf;
+  gtpu_adapter                       gtpu_itf;
+  std::vector<std::unique_ptr<pdcp>> pdcps;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_PDCP_SHARDED_H
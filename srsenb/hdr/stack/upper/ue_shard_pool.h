@@ -0,0 +1,87 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_UE_SHARD_POOL_H
+#define SRSENB_UE_SHARD_POOL_H
+
+#include "srsran/common/rwlock_guard.h"
+#include "srsran/common/task_scheduler.h"
+#include "srsran/common/threads.h"
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace srsenb {
+
+/**
+ * Set of stack threads the per-UE user-plane processing is distributed over. Every UE is pinned to one shard, given by
+ * its RNTI, so that all the tasks of a UE run in order in the same thread. Each shard has its own task queues and
+ * timer domain, the timers being stepped by the stack TTI clock.
+ */
+class ue_shard_pool
+{
+public:
+  explicit ue_shard_pool(srslog::basic_logger& logger_) : logger(logger_) { pthread_rwlock_init(&rwlock, nullptr); }
+  ~ue_shard_pool();
+
+  void init(uint32_t nof_shards, int32_t prio, uint32_t sync_queue_size);
+  void stop();
+
+  uint32_t size() const { return shards.size(); }
+  uint32_t shard_idx(uint16_t rnti) const { return rnti % shards.size(); }
+
+  /// Task scheduler of a shard, whose timers and deferred tasks run in the shard thread
+  srsran::task_sched_handle get_task_sched(uint32_t idx) { return &shards[idx]->task_sched; }
+
+  /// Queues a task in a shard. Once the pool is stopped, the task is run by the caller
+  void push(uint32_t idx, srsran::move_task_t task);
+
+  /// Runs a task in a shard and waits for it to finish. Must not be called from a shard thread
+  void run_sync(uint32_t idx, srsran::move_task_t task);
+
+  /// Steps the timers of all the shards
+  void tti_clock();
+
+private:
+  class shard : public srsran::thread
+  {
+  public:
+    shard(uint32_t id, uint32_t sync_queue_size);
+    void stop();
+
+    srsran::task_scheduler    task_sched;
+    srsran::task_queue_handle task_queue, sync_queue;
+    std::atomic<bool>         running = {true};
+
+  private:
+    void run_thread() override;
+  };
+
+  srslog::basic_logger&               logger;
+  std::vector<std::unique_ptr<shard>> shards;
+  pthread_rwlock_t                    rwlock; ///< Held for writing by stop(), so that no task is pushed past the drain
+  bool                                running = false;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_UE_SHARD_POOL_H
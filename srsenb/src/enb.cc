@@ -25,6 +25,7 @@
 #include "srsenb/src/enb_cfg_parser.h"
 #include "srsgnb/hdr/stack/gnb_stack_nr.h"
 #include "srsran/build_info.h"
+#include "srsran/common/buffer_pool.h"
 #include "srsran/common/enb_events.h"
 #include "srsran/radio/radio_null.h"
 #include <iostream>
@@ -231,6 +232,7 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   radio->get_metrics(&m->rf);
   phy->get_metrics(m->phy);
+  phy->get_sched_metrics(m->phy_sched);
   if (eutra_stack) {
     eutra_stack->get_metrics(&m->stack);
   }
@@ -239,6 +241,7 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   m->running = true;
   m->sys     = sys_proc.get_metrics();
+  srsran::get_byte_buffer_pool_metrics(m->sys);
   return true;
 }
 
@@ -66,8 +66,11 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string mcc;
   string mnc;
   string enb_id;
-  string cfr_mode;
-  bool   use_standard_lte_rates = false;
+  string   cfr_mode;
+  string   pcap_format;
+  uint32_t pcap_max_file_size_mb  = 0;
+  uint32_t pcap_buffer_size_kb    = 0;
+  bool     use_standard_lte_rates = false;
 
   // Command line only options
   bpo::options_description general("General options");
@@ -155,6 +158,11 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("pcap.bind_port", bpo::value<uint16_t>(&args->stack.mac_pcap_net.bind_port)->default_value(5687),        "Bind port for MAC network trace")
     ("pcap.client_ip", bpo::value<string>(&args->stack.mac_pcap_net.client_ip)->default_value("127.0.0.1"),     "Client IP address for MAC network trace")
     ("pcap.client_port", bpo::value<uint16_t>(&args->stack.mac_pcap_net.client_port)->default_value(5847),    "Enable MAC network captures")
+    ("pcap.format", bpo::value<string>(&pcap_format)->default_value("pcap"), "Capture file format for MAC and S1AP captures (pcap or pcapng)")
+    ("pcap.max_file_size", bpo::value<uint32_t>(&pcap_max_file_size_mb)->default_value(0), "Start a new capture file once this size (in megabytes) is reached. Default 0 (single file)")
+    ("pcap.rotation_period", bpo::value<uint32_t>(&args->stack.mac_pcap.writer.rotation_period_s)->default_value(0), "Start a new capture file after this period (in seconds). Default 0 (single file)")
+    ("pcap.nof_buffers", bpo::value<uint32_t>(&args->stack.mac_pcap.writer.nof_blocks)->default_value(8), "Number of write buffers of each capture file writer")
+    ("pcap.buffer_size", bpo::value<uint32_t>(&pcap_buffer_size_kb)->default_value(128), "Size (in kilobytes) of each write buffer of the capture file writers")
 
     /* Scheduling section */
     ("scheduler.policy", bpo::value<string>(&args->stack.mac.sched.sched_policy)->default_value("time_pf"), "DL and UL data scheduling policy (E.g. time_rr, time_pf)")
@@ -181,6 +189,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.init_dl_cqi", bpo::value<int>(&args->stack.mac.sched.init_dl_cqi)->default_value(5), "DL CQI value used before any CQI report is available to the eNB")
     ("scheduler.max_sib_coderate", bpo::value<float>(&args->stack.mac.sched.max_sib_coderate)->default_value(0.8), "Upper bound on SIB and RAR grants coderate")
     ("scheduler.pdcch_cqi_offset", bpo::value<int>(&args->stack.mac.sched.pdcch_cqi_offset)->default_value(0), "CQI offset in derivation of PDCCH aggregation level")
+    ("scheduler.nof_cc_workers", bpo::value<uint32_t>(&args->stack.mac.sched.nof_cc_workers)->default_value(0), "Number of threads used to schedule independent carriers in parallel (0 schedules them sequentially)")
 
     /*Slicing conifguration*/
     ("slicing.enable_eMBB", bpo::value<bool>(&args->nr_stack.ngap.nssai[0].active)->default_value(true), "Enables enhanced mobile broadband (eMBB) slice in the gNodeB")
@@ -192,6 +201,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),               "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_threads",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_threads)->default_value(1),          "Number of threads processing the channels in parallel")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),          "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),         "Target SNR in dB")
     ("channel.dl.fading.enable",     bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false),        "Enable/Disable Fading model")
@@ -211,6 +221,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_threads",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_threads)->default_value(1),             "Number of threads processing the channels in parallel")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Received signal power in decibels full scale (dBfs)")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
@@ -252,10 +263,13 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.metrics_csv_filename", bpo::value<string>(&args->general.metrics_csv_filename)->default_value("/tmp/enb_metrics.csv"), "Metrics CSV filename.")
     ("expert.pusch_max_its", bpo::value<uint32_t>(&args->phy.pusch_max_its)->default_value(8), "Maximum number of turbo decoder iterations for LTE.")
     ("expert.pusch_8bit_decoder", bpo::value<bool>(&args->phy.pusch_8bit_decoder)->default_value(false), "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental).")
+    ("expert.pusch_cb_threads", bpo::value<uint32_t>(&args->phy.pusch_cb_threads)->default_value(1), "Number of threads decoding the turbo code blocks of each PUSCH transport block (1 for serial decoding).")
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
-    ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
+    ("expert.nof_phy_job_threads", bpo::value<uint32_t>(&args->phy.nof_phy_job_threads)->default_value(2), "Number of threads helping the PHY threads with the UL and DL jobs of each carrier, earliest TX deadline first. 0 runs the jobs in the PHY threads only.")
+    ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. 0 detects inline, more than 1 splits the preamble roots between the workers.")
+    ("expert.nof_prach_buffers", bpo::value<uint32_t>(&args->phy.nof_prach_buffers)->default_value(8), "Number of PRACH occasions per carrier that can be buffered while waiting for detection.")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
     ("expert.estimator_fil_w", bpo::value<float>(&args->phy.estimator_fil_w)->default_value(0.1), "Chooses the coefficients for the 3-tap channel estimator centered filter.")
@@ -278,6 +292,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.max_mac_dl_kos", bpo::value<uint32_t>(&args->general.max_mac_dl_kos)->default_value(100), "Maximum number of consecutive KOs in DL before triggering the UE's release (default 100).")
     ("expert.max_mac_ul_kos", bpo::value<uint32_t>(&args->general.max_mac_ul_kos)->default_value(100), "Maximum number of consecutive KOs in UL before triggering the UE's release (default 100).")
     ("expert.gtpu_tunnel_timeout", bpo::value<uint32_t>(&args->stack.gtpu_indirect_tunnel_timeout_msec)->default_value(0), "Maximum time that GTPU takes to release indirect forwarding tunnel since the last received GTPU PDU (0 for infinity).")
+    ("expert.gtpu_rx_threads", bpo::value<uint32_t>(&args->stack.gtpu_nof_rx_threads)->default_value(1), "Number of threads receiving S1-U packets, each one with its own socket bound with SO_REUSEPORT.")
+    ("expert.ue_shards", bpo::value<uint32_t>(&args->stack.nof_ue_shards)->default_value(0), "Number of stack threads the PDCP of the UEs is sharded over, by RNTI (0 to run it in the stack thread).")
     ("expert.rlf_release_timer_ms", bpo::value<uint32_t>(&args->general.rlf_release_timer_ms)->default_value(4000), "Time taken by eNB to release UE context after it detects an RLF.")
     ("expert.extended_cp", bpo::value<bool>(&args->phy.extended_cp)->default_value(false), "Use extended cyclic prefix")
     ("expert.ts1_reloc_prep_timeout", bpo::value<uint32_t>(&args->stack.s1ap.ts1_reloc_prep_timeout)->default_value(10000), "S1AP TS 36.413 TS1RelocPrep Expiry Timeout value in milliseconds.")
@@ -304,6 +320,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
+    ("expert.nr_pusch_cb_threads", bpo::value<uint32_t>(&args->phy.nr_pusch_cb_threads)->default_value(1), "Number of threads decoding the LDPC code blocks of a NR PUSCH transport block, per PHY worker.")
   ;
 
   // Positional options - config file location
@@ -391,11 +408,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     }
   }
 
-  // Check PRACH workers
-  if (args->phy.nof_prach_threads > 1) {
-    fprintf(stderr,
-            "nof_prach_workers = %d. Value is not supported, only 0 or 1 are allowed\n",
-            args->phy.nof_prach_threads);
+  // Check PRACH buffers
+  if (args->phy.nof_prach_buffers == 0) {
+    fprintf(stderr, "nof_prach_buffers = %d. At least one buffer is required\n", args->phy.nof_prach_buffers);
     exit(1);
   }
 
@@ -419,6 +434,17 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     exit(1);
   }
 
+  // parse the PCAP writer options, shared by the MAC and S1AP captures
+  if (pcap_format == "pcapng") {
+    args->stack.mac_pcap.writer.format = srsran::pcap_format_t::pcapng;
+  } else if (pcap_format != "pcap") {
+    cout << "Error, invalid PCAP format: " << pcap_format << endl;
+    exit(1);
+  }
+  args->stack.mac_pcap.writer.max_file_size = (uint64_t)pcap_max_file_size_mb * 1024 * 1024;
+  args->stack.mac_pcap.writer.block_size    = pcap_buffer_size_kb * 1024;
+  args->stack.s1ap_pcap.writer              = args->stack.mac_pcap.writer;
+
   // Apply all_level to any unset layers
   if (vm.count("log.all_level")) {
     if (!vm.count("log.rf_level")) {
@@ -682,6 +708,7 @@ int main(int argc, char* argv[])
     enb->stop();
     return SRSRAN_ERROR;
   }
+  srsran::log_dft_metrics("ENB");
 
   // Set metrics
   metricshub.init(enb.get(), args.general.metrics_period_secs);
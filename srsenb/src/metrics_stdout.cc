@@ -188,6 +188,15 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
     fmt::print("RF status: O={}, U={}, L={}\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  if (metrics.phy_sched.nof_late_ttis > 0) {
+    fmt::print("PHY status: late TTIs={}/{}, late jobs={}/{}, min slack={:.0f}us\n",
+               metrics.phy_sched.nof_late_ttis,
+               metrics.phy_sched.nof_ttis,
+               metrics.phy_sched.nof_late_jobs,
+               metrics.phy_sched.nof_jobs,
+               metrics.phy_sched.min_slack_us);
+  }
+
   if (metrics.stack.rrc.ues.size() == 0 && metrics.nr_stack.mac.ues.size() == 0) {
     return;
   }
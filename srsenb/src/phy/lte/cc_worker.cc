@@ -86,7 +86,7 @@ cc_worker::~cc_worker()
 FILE* f;
 #endif
 
-void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
+void cc_worker::init(phy_common* phy_, uint32_t cc_idx_, cc_worker* primary)
 {
   phy                         = phy_;
   cc_idx                      = cc_idx_;
@@ -156,6 +156,13 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     enb_ul.pusch.llr_is_8bit        = true;
     enb_ul.pusch.ul_sch.llr_is_8bit = true;
   }
+  if (primary != nullptr) {
+    // All carriers of the subframe decode their code blocks through the pool of the primary carrier
+    srsran_sch_share_cb_threads(&enb_ul.pusch.ul_sch, &primary->enb_ul.pusch.ul_sch);
+  } else if (srsran_sch_set_cb_threads(&enb_ul.pusch.ul_sch, phy->params.pusch_cb_threads)) {
+    ERROR("Error creating PUSCH code block decoder threads");
+    return;
+  }
   initiated = true;
 
 #ifdef DEBUG_WRITE_FILE
@@ -216,7 +223,6 @@ void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy
 {
   std::lock_guard<std::mutex> lock(mutex);
   ul_sf = ul_sf_cfg;
-  logger.set_context(ul_sf.tti);
 
   // Process UL signal
   srsran_enb_ul_fft(&enb_ul);
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/lte/sf_job_pool.h"
+#include <algorithm>
+
+namespace srsenb {
+namespace lte {
+
+constexpr std::chrono::microseconds sf_job_pool::tx_budget;
+
+// Heap ordering, the job with the earliest deadline is on top and jobs with the same deadline keep their push order
+bool sf_job_pool::job_later(const job_t& a, const job_t& b)
+{
+  if (a.group->deadline != b.group->deadline) {
+    return a.group->deadline > b.group->deadline;
+  }
+  return a.seq > b.seq;
+}
+
+sf_job_pool::~sf_job_pool()
+{
+  stop();
+}
+
+void sf_job_pool::init(uint32_t nof_threads, int32_t prio)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  running = true;
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    helpers.emplace_back(new helper_thread(this, i, prio));
+  }
+}
+
+void sf_job_pool::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  cvar_jobs.notify_all();
+  for (auto& h : helpers) {
+    h->stop();
+  }
+  helpers.clear();
+
+  // Run the jobs left behind, so that no subframe worker waits forever
+  std::unique_lock<std::mutex> lock(mutex);
+  job_t                        job;
+  while (pop_job(job)) {
+    lock.unlock();
+    run_job(job, nullptr);
+    lock.lock();
+  }
+}
+
+void sf_job_pool::push_job(job_group& group, task_t&& task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    group.nof_pending++;
+    queue.push_back(job_t{&group, seq++, std::move(task)});
+    std::push_heap(queue.begin(), queue.end(), job_later);
+  }
+  cvar_jobs.notify_one();
+}
+
+bool sf_job_pool::pop_job(job_t& job, const job_group* limit)
+{
+  if (queue.empty()) {
+    return false;
+  }
+  if (limit != nullptr and queue.front().group->deadline > limit->deadline) {
+    return false;
+  }
+  std::pop_heap(queue.begin(), queue.end(), job_later);
+  job = std::move(queue.back());
+  queue.pop_back();
+  return true;
+}
+
+void sf_job_pool::run_job(job_t& job, const job_group* owner)
+{
+  job.task();
+  sf_clock::time_point now = sf_clock::now();
+
+  bool notify = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    metrics.nof_jobs++;
+    if (now > job.group->deadline) {
+      metrics.nof_late_jobs++;
+    }
+    if (owner != nullptr and owner != job.group) {
+      metrics.nof_stolen_jobs++;
+    }
+    // The group may be destroyed by its owner as soon as the counter reaches zero
+    notify = (--job.group->nof_pending == 0);
+  }
+  if (notify) {
+    cvar_done.notify_all();
+  }
+}
+
+void sf_job_pool::wait(job_group& group)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  job_t                        job;
+  while (group.nof_pending > 0) {
+    // Help with the most urgent job, which might belong to a more urgent subframe but never to a later one
+    if (not pop_job(job, &group)) {
+      cvar_done.wait(lock);
+      continue;
+    }
+    lock.unlock();
+    run_job(job, &group);
+    lock.lock();
+  }
+}
+
+void sf_job_pool::tti_finished(const job_group& group, sf_clock::time_point t_start)
+{
+  sf_clock::time_point now      = sf_clock::now();
+  float               slack_us = std::chrono::duration<float, std::micro>(group.deadline - now).count();
+  uint32_t            latency_us =
+      (uint32_t)std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(now - t_start).count());
+  uint32_t bin = std::min(latency_us / phy_sched_metrics_t::latency_bin_us, phy_sched_metrics_t::nof_latency_bins - 1);
+
+  if (slack_us < 0) {
+    logger.warning("Subframe tti_rx=%d finished %.0f us after its TX deadline", group.tti, -slack_us);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  metrics.min_slack_us = (metrics.nof_ttis == 0) ? slack_us : std::min(metrics.min_slack_us, slack_us);
+  metrics.nof_ttis++;
+  metrics.nof_late_ttis += (slack_us < 0) ? 1 : 0;
+  metrics.latency_hist[bin]++;
+}
+
+void sf_job_pool::get_metrics(phy_sched_metrics_t& m)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  m       = metrics;
+  metrics = {};
+}
+
+sf_job_pool::helper_thread::helper_thread(sf_job_pool* parent_, uint32_t id, int32_t prio) :
+  thread("PHY_JOB" + std::to_string(id)), parent(parent_)
+{
+  start(prio);
+}
+
+void sf_job_pool::helper_thread::run_thread()
+{
+  std::unique_lock<std::mutex> lock(parent->mutex);
+  job_t                        job;
+  while (parent->running) {
+    if (not parent->pop_job(job)) {
+      parent->cvar_jobs.wait(lock);
+      continue;
+    }
+    lock.unlock();
+    parent->run_job(job, nullptr);
+    lock.lock();
+  }
+}
+
+} // namespace lte
+} // namespace srsenb
@@ -72,17 +72,18 @@ namespace lte {
 FILE* f;
 #endif
 
-void sf_worker::init(phy_common* phy_)
+void sf_worker::init(phy_common* phy_, sf_job_pool* job_pool_)
 {
-  phy = phy_;
+  phy      = phy_;
+  job_pool = job_pool_;
 
   // Initialise each component carrier workers
   for (uint32_t i = 0; i < phy->get_nof_carriers_lte(); i++) {
     // Create pointer
     auto q = new cc_worker(logger);
 
-    // Initialise
-    q->init(phy, i);
+    // Initialise, the secondary carriers share the code block decoder threads of the primary one
+    q->init(phy, i, cc_workers.empty() ? nullptr : cc_workers[0].get());
 
     // Create unique pointer
     cc_workers.push_back(std::unique_ptr<cc_worker>(q));
@@ -117,6 +118,7 @@ void sf_worker::set_context(const srsran::phy_common_interface::worker_context_t
   tti_tx_ul = TTI_RX_ACK(tti_rx);
 
   context.copy(w_ctx);
+  t_start = sf_job_pool::sf_clock::now();
 
   for (auto& w : cc_workers) {
     w->set_tti(w_ctx.sf_idx);
@@ -147,13 +149,20 @@ uint32_t sf_worker::get_nof_rnti()
   return cc_workers[0]->get_nof_rnti();
 }
 
+void sf_worker::work_ul_cc(uint32_t cc)
+{
+  cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
+}
+
+void sf_worker::work_dl_cc(uint32_t cc)
+{
+  cc_workers[cc]->work_dl(dl_sf[cc], dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+}
+
 void sf_worker::work_imp()
 {
   std::lock_guard<std::mutex> lock(work_mutex);
 
-  srsran_ul_sf_cfg_t ul_sf = {};
-  srsran_dl_sf_cfg_t dl_sf = {};
-
   // Get Transmission buffers
   srsran::rf_buffer_t tx_buffer = {};
   tx_buffer.set_nof_samples(SRSRAN_SF_LEN_PRB(phy->get_nof_prb(0)));
@@ -163,16 +172,20 @@ void sf_worker::work_imp()
     return;
   }
 
-  srsran_mbsfn_cfg_t mbsfn_cfg;
-  srsran_sf_t        sf_type = phy->is_mbsfn_sf(&mbsfn_cfg, tti_tx_dl) ? SRSRAN_SF_MBSFN : SRSRAN_SF_NORM;
+  // The carriers are processed as independent jobs, which must finish before the subframe transmission is due
+  sf_job_pool::job_group jobs(tti_rx, t_start + sf_job_pool::tx_budget);
+
+  mbsfn_cfg           = {};
+  srsran_sf_t sf_type = phy->is_mbsfn_sf(&mbsfn_cfg, tti_tx_dl) ? SRSRAN_SF_MBSFN : SRSRAN_SF_NORM;
 
   // Uplink grants to receive this TTI
-  stack_interface_phy_lte::ul_sched_list_t ul_grants = phy->get_ul_grants(tti_rx);
+  ul_grants = phy->get_ul_grants(tti_rx);
   // Uplink grants to transmit this tti and receive in the future
-  stack_interface_phy_lte::ul_sched_list_t ul_grants_tx = phy->get_ul_grants(tti_tx_ul);
+  ul_grants_tx = phy->get_ul_grants(tti_tx_ul);
 
   // Downlink grants to transmit this TTI
-  stack_interface_phy_lte::dl_sched_list_t dl_grants(phy->get_nof_carriers_lte());
+  dl_grants.clear();
+  dl_grants.resize(phy->get_nof_carriers_lte());
 
   stack_interface_phy_lte* stack = phy->stack;
 
@@ -181,6 +194,7 @@ void sf_worker::work_imp()
   Debug("Worker %d running", get_id());
 
   // Configure UL subframe
+  ul_sf     = {};
   ul_sf.tti = tti_rx;
 
   // Set UL grant availability prior to any UL processing
@@ -188,10 +202,11 @@ void sf_worker::work_imp()
     Info("Failed setting UL grants. Some grant's RNTI does not exist.");
   }
 
-  // Process UL
+  // Process UL. It must finish before the DL scheduling, which depends on the received HARQ feedback
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
+    job_pool->push_job(jobs, [this, cc]() { work_ul_cc(cc); });
   }
+  job_pool->wait(jobs);
 
   // Get DL scheduling for the TX TTI from MAC
   if (sf_type == SRSRAN_SF_NORM) {
@@ -216,23 +231,21 @@ void sf_worker::work_imp()
     return;
   }
 
-  // Configure DL subframe
-  dl_sf.tti              = tti_tx_dl;
-  dl_sf.sf_type          = sf_type;
-  dl_sf.non_mbsfn_region = mbsfn_cfg.non_mbsfn_region_length;
-
   // Prepare for receive ACK for DL grants in t_tx_dl+4
   phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
 
   // Process DL
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    // Select CFI and make sure it is in the right range
-    dl_sf.cfi = dl_grants[cc].cfi;
-    dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
-    dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
-
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+    // Configure DL subframe, selecting a CFI in the right range
+    dl_sf[cc]                  = {};
+    dl_sf[cc].tti              = tti_tx_dl;
+    dl_sf[cc].sf_type          = sf_type;
+    dl_sf[cc].non_mbsfn_region = mbsfn_cfg.non_mbsfn_region_length;
+    dl_sf[cc].cfi              = SRSRAN_MIN(SRSRAN_MAX(dl_grants[cc].cfi, 1), 3);
+
+    job_pool->push_job(jobs, [this, cc]() { work_dl_cc(cc); });
   }
+  job_pool->wait(jobs);
 
   // Save grants
   phy->set_ul_grants(tti_tx_ul, ul_grants_tx);
@@ -246,6 +259,7 @@ void sf_worker::work_imp()
 
   Debug("Sending to radio");
   phy->worker_end(context, true, tx_buffer);
+  job_pool->tti_finished(jobs, t_start);
 
 #ifdef DEBUG_WRITE_FILE
   fwrite(signal_buffer_tx, SRSRAN_SF_LEN_PRB(phy->cell.nof_prb) * sizeof(cf_t), 1, f);
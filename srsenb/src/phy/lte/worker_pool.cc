@@ -23,19 +23,23 @@
 namespace srsenb {
 namespace lte {
 
-worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers) {}
+worker_pool::worker_pool(uint32_t max_workers, srslog::basic_logger& logger) : pool(max_workers), job_pool(logger) {}
 
 bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio)
 {
   // Add workers to workers pool and start threads.
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
+
+  // Start the helper threads of the subframe jobs, with the same priority as the workers
+  job_pool.init(args.nof_phy_job_threads, prio);
+
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i), log_sink);
     log.set_level(log_level);
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
     auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
+    w->init(common, &job_pool);
     pool.init_worker(i, w.get(), prio);
     workers.push_back(std::move(w));
   }
@@ -61,6 +65,12 @@ sf_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+  job_pool.stop();
+}
+
+void worker_pool::get_sched_metrics(phy_sched_metrics_t& metrics)
+{
+  job_pool.get_metrics(metrics);
 }
 
 }; // namespace lte
@@ -89,14 +89,15 @@ bool slot_worker::init(const args_t& args)
   }
 
   // Prepare UL arguments
-  srsran_gnb_ul_args_t ul_args   = {};
-  ul_args.pusch.measure_time     = true;
-  ul_args.pusch.measure_evm      = true;
-  ul_args.pusch.max_layers       = args.nof_rx_ports;
-  ul_args.pusch.sch.max_nof_iter = args.pusch_max_its;
-  ul_args.pusch.max_prb          = args.nof_max_prb;
-  ul_args.nof_max_prb            = args.nof_max_prb;
-  ul_args.pusch_min_snr_dB       = args.pusch_min_snr_dB;
+  srsran_gnb_ul_args_t ul_args     = {};
+  ul_args.pusch.measure_time       = true;
+  ul_args.pusch.measure_evm        = true;
+  ul_args.pusch.max_layers         = args.nof_rx_ports;
+  ul_args.pusch.sch.max_nof_iter   = args.pusch_max_its;
+  ul_args.pusch.sch.nof_cb_threads = args.pusch_cb_threads;
+  ul_args.pusch.max_prb            = args.nof_max_prb;
+  ul_args.nof_max_prb              = args.nof_max_prb;
+  ul_args.pusch_min_snr_dB         = args.pusch_min_snr_dB;
 
   // Initialise UL
   if (srsran_gnb_ul_init(&gnb_ul, rx_buffer[0], &ul_args) < SRSRAN_SUCCESS) {
@@ -75,7 +75,7 @@ phy::phy(srslog::sink& log_sink) :
   log_sink(log_sink),
   phy_log(srslog::fetch_basic_logger("PHY", log_sink)),
   phy_lib_log(srslog::fetch_basic_logger("PHY_LIB", log_sink)),
-  lte_workers(MAX_WORKERS),
+  lte_workers(MAX_WORKERS, phy_log),
   workers_common(),
   nof_workers(0),
   tx_rx(phy_log)
@@ -194,7 +194,8 @@ int phy::init_lte(const phy_args_t&            args,
                stack_lte_,
                phy_log,
                PRACH_WORKER_THREAD_PRIO,
-               args.nof_prach_threads);
+               args.nof_prach_threads,
+               args.nof_prach_buffers);
   }
   prach.set_max_prach_offset_us(args.max_prach_offset_us);
 
@@ -286,6 +287,11 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
   }
 }
 
+void phy::get_sched_metrics(phy_sched_metrics_t& metrics)
+{
+  lte_workers.get_sched_metrics(metrics);
+}
+
 void phy::cmd_cell_gain(uint32_t cell_id, float gain_db)
 {
   Info("set_cell_gain: cell_id=%d, gain_db=%.2f", cell_id, gain_db);
@@ -376,6 +382,7 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.pusch_cb_threads        = args.nr_pusch_cb_threads;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
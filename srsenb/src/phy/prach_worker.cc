@@ -51,6 +51,10 @@ int prach_worker::init(const srsran_cell_t&      cell_,
 
   nof_sf = (uint32_t)ceilf(prach.T_tot * 1000);
 
+  if (nof_workers > 1 && init_root_searches(priority)) {
+    return -1;
+  }
+
   if (nof_workers > 0) {
     start(priority);
   }
@@ -78,6 +82,33 @@ int prach_worker::init(const srsran_cell_t&      cell_,
   return 0;
 }
 
+int prach_worker::init_root_searches(int priority)
+{
+  // Split the roots in contiguous ranges, the first one is searched by the PRACH thread itself
+  uint32_t nof_ranges = SRSRAN_MIN(nof_workers, prach.num_ra_preambles);
+  root_split_end      = prach.num_ra_preambles / nof_ranges;
+  for (uint32_t i = 1; i < nof_ranges; i++) {
+    std::unique_ptr<root_search_t> search(new root_search_t);
+    if (srsran_prach_init(&search->prach, srsran_symbol_sz(cell.nof_prb))) {
+      return SRSRAN_ERROR;
+    }
+    if (srsran_prach_set_cfg(&search->prach, &prach_cfg, cell.nof_prb)) {
+      ERROR("Error initiating PRACH");
+      srsran_prach_free(&search->prach);
+      return SRSRAN_ERROR;
+    }
+    srsran_prach_set_detect_factor(&search->prach, 60);
+    search->root_begin = i * prach.num_ra_preambles / nof_ranges;
+    search->root_end   = (i + 1) * prach.num_ra_preambles / nof_ranges;
+    root_searches.push_back(std::move(search));
+  }
+
+  if (not root_searches.empty()) {
+    detect_workers.reset(new srsran::task_thread_pool(root_searches.size(), false, priority));
+  }
+  return SRSRAN_SUCCESS;
+}
+
 void prach_worker::stop()
 {
   running      = false;
@@ -88,6 +119,14 @@ void prach_worker::stop()
     wait_thread_finish();
   }
 
+  if (detect_workers != nullptr) {
+    detect_workers->stop();
+  }
+  for (auto& search : root_searches) {
+    srsran_prach_free(&search->prach);
+  }
+  root_searches.clear();
+
   srsran_prach_free(&prach);
 }
 
@@ -138,19 +177,69 @@ int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
   return 0;
 }
 
+int prach_worker::detect(sf_buffer* b, uint32_t* nof_det)
+{
+  cf_t*    signal  = &b->samples[prach.N_cp];
+  uint32_t sig_len = nof_sf * SRSRAN_SF_LEN_PRB(cell.nof_prb) - prach.N_cp;
+
+  // Successive cancellation subtracts the strongest preamble of all the roots, so it can not be split
+  if (root_searches.empty() || prach.successive_cancellation) {
+    return srsran_prach_detect_offset(
+        &prach, prach_cfg.freq_offset, signal, sig_len, prach_indices, prach_offsets, prach_p2avg, nof_det);
+  }
+
+  if (srsran_prach_extract_bins(&prach, prach_cfg.freq_offset, signal, sig_len)) {
+    return SRSRAN_ERROR;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(detect_mutex);
+    nof_pending_searches = root_searches.size();
+  }
+  for (auto& s : root_searches) {
+    root_search_t* search = s.get();
+    detect_workers->push_task([this, search]() {
+      if (srsran_prach_detect_roots(&search->prach,
+                                    prach.prach_bins,
+                                    search->root_begin,
+                                    search->root_end,
+                                    search->indices,
+                                    search->offsets,
+                                    search->p2avg,
+                                    &search->nof_det)) {
+        search->nof_det = 0;
+      }
+      std::lock_guard<std::mutex> lock(detect_mutex);
+      if (--nof_pending_searches == 0) {
+        detect_cvar.notify_one();
+      }
+    });
+  }
+  int ret = srsran_prach_detect_roots(
+      &prach, prach.prach_bins, 0, root_split_end, prach_indices, prach_offsets, prach_p2avg, nof_det);
+
+  std::unique_lock<std::mutex> lock(detect_mutex);
+  while (nof_pending_searches > 0) {
+    detect_cvar.wait(lock);
+  }
+
+  // Merge the detections in root order
+  for (auto& search : root_searches) {
+    uint32_t n = SRSRAN_MIN(search->nof_det, 165 - *nof_det);
+    std::copy(search->indices, search->indices + n, &prach_indices[*nof_det]);
+    std::copy(search->offsets, search->offsets + n, &prach_offsets[*nof_det]);
+    std::copy(search->p2avg, search->p2avg + n, &prach_p2avg[*nof_det]);
+    *nof_det += n;
+  }
+  return ret;
+}
+
 int prach_worker::run_tti(sf_buffer* b)
 {
   uint32_t prach_nof_det = 0;
   if (srsran_prach_tti_opportunity(&prach, b->tti, -1)) {
     // Detect possible PRACHs
-    if (srsran_prach_detect_offset(&prach,
-                                   prach_cfg.freq_offset,
-                                   &b->samples[prach.N_cp],
-                                   nof_sf * SRSRAN_SF_LEN_PRB(cell.nof_prb) - prach.N_cp,
-                                   prach_indices,
-                                   prach_offsets,
-                                   prach_p2avg,
-                                   &prach_nof_det)) {
+    if (detect(b, &prach_nof_det)) {
       logger.error("Error detecting PRACH");
       return SRSRAN_ERROR;
     }
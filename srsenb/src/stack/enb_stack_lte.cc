@@ -48,6 +48,7 @@ enb_stack_lte::enb_stack_lte(srslog::sink& log_sink) :
   gtpu(&task_sched, gtpu_logger, srsran::srsran_rat_t::lte, &get_rx_io_manager()),
   s1ap(&task_sched, s1ap_logger, &get_rx_io_manager()),
   rrc(&task_sched, bearers),
+  ue_shards(stack_logger),
   mac_pcap(),
   pending_stack_metrics(64)
 {
@@ -100,7 +101,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   // Set up pcap and trace
   if (args.mac_pcap.enable) {
-    mac_pcap.open(args.mac_pcap.filename);
+    mac_pcap.open(args.mac_pcap.filename, 0, args.mac_pcap.writer);
     mac.start_pcap(&mac_pcap);
   }
 
@@ -113,7 +114,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   }
 
   if (args.s1ap_pcap.enable) {
-    s1ap_pcap.open(args.s1ap_pcap.filename.c_str());
+    s1ap_pcap.open(args.s1ap_pcap.filename.c_str(), args.s1ap_pcap.writer);
     s1ap.start_pcap(&s1ap_pcap);
   }
 
@@ -125,17 +126,33 @@ int enb_stack_lte::init(const stack_args_t&      args_,
     x2_task_queue = task_sched.make_task_queue();
   }
 
+  // With UE shards, the PDCP of each UE runs in the shard of its RNTI
+  pdcp_interface_rlc*  pdcp_rlc  = &pdcp;
+  pdcp_interface_rrc*  pdcp_rrc  = &pdcp;
+  pdcp_interface_gtpu* pdcp_gtpu = &pdcp;
+  if (args.nof_ue_shards > 0) {
+    ue_shards.init(args.nof_ue_shards, STACK_MAIN_THREAD_PRIO, args.sync_queue_size);
+    pdcp_shards.reset(new pdcp_sharded(ue_shards, &task_sched, pdcp_logger));
+    pdcp_rlc  = pdcp_shards.get();
+    pdcp_rrc  = pdcp_shards.get();
+    pdcp_gtpu = pdcp_shards.get();
+  }
+
   // setup bearer managers
-  gtpu_adapter.reset(new gtpu_pdcp_adapter(stack_logger, &pdcp, x2_, &gtpu, bearers));
+  gtpu_adapter.reset(new gtpu_pdcp_adapter(stack_logger, pdcp_gtpu, x2_, &gtpu, bearers));
 
   // Init all LTE layers
   if (!mac.init(args.mac, rrc_cfg.cell_list, phy, &rlc, &rrc)) {
     stack_logger.error("Couldn't initialize MAC");
     return SRSRAN_ERROR;
   }
-  rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler());
-  pdcp.init(&rlc, &rrc, gtpu_adapter.get());
-  if (rrc.init(rrc_cfg, phy, &mac, &rlc, &pdcp, &s1ap, &gtpu, x2_) != SRSRAN_SUCCESS) {
+  rlc.init(pdcp_rlc, &rrc, &mac, task_sched.get_timer_handler());
+  if (pdcp_shards != nullptr) {
+    pdcp_shards->init(&rlc, &rrc, gtpu_adapter.get());
+  } else {
+    pdcp.init(&rlc, &rrc, gtpu_adapter.get());
+  }
+  if (rrc.init(rrc_cfg, phy, &mac, &rlc, pdcp_rrc, &s1ap, &gtpu, x2_) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize RRC");
     return SRSRAN_ERROR;
   }
@@ -151,6 +168,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   gtpu_args.mme_addr                     = args.s1ap.mme_addr;
   gtpu_args.gtp_bind_addr                = args.s1ap.gtp_bind_addr;
   gtpu_args.indirect_tunnel_timeout_msec = args.gtpu_indirect_tunnel_timeout_msec;
+  gtpu_args.nof_rx_threads               = args.gtpu_nof_rx_threads;
   if (gtpu.init(gtpu_args, gtpu_adapter.get()) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize GTPU");
     return SRSRAN_ERROR;
@@ -172,6 +190,7 @@ void enb_stack_lte::tti_clock()
 void enb_stack_lte::tti_clock_impl()
 {
   task_sched.tic();
+  ue_shards.tti_clock();
   rrc.tti_clock();
 }
 
@@ -190,6 +209,11 @@ void enb_stack_lte::stop_impl()
   s1ap.stop();
   gtpu.stop();
   mac.stop();
+  // The UE shards call RLC directly, so they are stopped first
+  if (pdcp_shards != nullptr) {
+    pdcp_shards->stop();
+    ue_shards.stop();
+  }
   rlc.stop();
   pdcp.stop();
   rrc.stop();
@@ -220,10 +244,16 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
     mac.get_metrics(metrics.mac);
     if (not metrics.mac.ues.empty()) {
       rlc.get_metrics(metrics.rlc, metrics.mac.ues[0].nof_tti);
-      pdcp.get_metrics(metrics.pdcp, metrics.mac.ues[0].nof_tti);
+      if (pdcp_shards != nullptr) {
+        pdcp_shards->get_metrics(metrics.pdcp, metrics.mac.ues[0].nof_tti);
+      } else {
+        pdcp.get_metrics(metrics.pdcp, metrics.mac.ues[0].nof_tti);
+      }
     }
     rrc.get_metrics(metrics.rrc);
     s1ap.get_metrics(metrics.s1ap);
+    metrics.pcap.mac  = mac_pcap.get_metrics();
+    metrics.pcap.s1ap = s1ap_pcap.get_metrics();
     if (not pending_stack_metrics.try_push(metrics)) {
       stack_logger.error("Unable to push metrics to queue");
     }
@@ -24,7 +24,6 @@
 
 #include "srsenb/hdr/stack/mac/mac.h"
 #include "srsran/adt/pool/obj_pool.h"
-#include "srsran/common/rwlock_guard.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/time_prof.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
@@ -40,14 +39,12 @@ namespace srsenb {
 mac::mac(srsran::ext_task_sched_handle task_sched_, srslog::basic_logger& logger) :
   logger(logger), rar_payload(), common_buffers(SRSRAN_MAX_CARRIERS), task_sched(task_sched_)
 {
-  pthread_rwlock_init(&rwlock, nullptr);
   stack_task_queue = task_sched.make_task_queue();
 }
 
 mac::~mac()
 {
   stop();
-  pthread_rwlock_destroy(&rwlock);
 }
 
 bool mac::init(const mac_args_t&        args_,
@@ -96,10 +93,8 @@ bool mac::init(const mac_args_t&        args_,
 
 void mac::stop()
 {
-  srsran::rwlock_write_guard lock(rwlock);
-  if (started) {
-    started = false;
-
+  if (started.exchange(false)) {
+    // Waits for the readers to leave the MAC before deleting the UEs and the common buffers
     ue_db.clear();
     for (auto& cc : common_buffers) {
       for (int i = 0; i < NOF_BCCH_DLSCH_MSG; i++) {
@@ -113,22 +108,18 @@ void mac::stop()
 
 void mac::start_pcap(srsran::mac_pcap* pcap_)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::rcu_read_guard lock(ue_rcu);
   pcap = pcap_;
   // Set pcap in all UEs for UL messages
-  for (auto& u : ue_db) {
-    u.second->start_pcap(pcap);
-  }
+  ue_db.for_each([this](ue& u) { u.start_pcap(pcap); });
 }
 
 void mac::start_pcap_net(srsran::mac_pcap_net* pcap_net_)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::rcu_read_guard lock(ue_rcu);
   pcap_net = pcap_net_;
   // Set pcap in all UEs for UL messages
-  for (auto& u : ue_db) {
-    u.second->start_pcap_net(pcap_net);
-  }
+  ue_db.for_each([this](ue& u) { u.start_pcap_net(pcap_net); });
 }
 
 /********************************************************
@@ -139,14 +130,13 @@ void mac::start_pcap_net(srsran::mac_pcap_net* pcap_net_)
 
 int mac::rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t retx_queue)
 {
-  int                       ret = -1;
-  if (check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  int                    ret = -1;
+  if (find_active_ue(rnti) != nullptr) {
     if (rnti != SRSRAN_MRNTI) {
-      srsran::rwlock_read_guard lock(rwlock);
       ret = scheduler.dl_rlc_buffer_state(rnti, lc_id, tx_queue, retx_queue);
     } else {
       task_sched.defer_callback(0, [this, tx_queue, lc_id]() {
-        srsran::rwlock_read_guard lock(rwlock);
         for (uint32_t i = 0; i < mch.num_mtch_sched; i++) {
           if (lc_id == mch.mtch_sched[i].lcid) {
             mch.mtch_sched[i].lcid_buffer_size = tx_queue;
@@ -161,14 +151,14 @@ int mac::rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint
 
 int mac::bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, mac_lc_ch_cfg_t* cfg)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  return check_ue_active(rnti) ? scheduler.bearer_ue_cfg(rnti, lc_id, *cfg) : -1;
+  srsran::rcu_read_guard lock(ue_rcu);
+  return find_active_ue(rnti) != nullptr ? scheduler.bearer_ue_cfg(rnti, lc_id, *cfg) : -1;
 }
 
 int mac::bearer_ue_rem(uint16_t rnti, uint32_t lc_id)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  return check_ue_active(rnti) ? scheduler.bearer_ue_rem(rnti, lc_id) : -1;
+  srsran::rcu_read_guard lock(ue_rcu);
+  return find_active_ue(rnti) != nullptr ? scheduler.bearer_ue_rem(rnti, lc_id) : -1;
 }
 
 void mac::phy_config_enabled(uint16_t rnti, bool enabled)
@@ -179,11 +169,11 @@ void mac::phy_config_enabled(uint16_t rnti, bool enabled)
 // Update UE configuration
 int mac::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t* cfg)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  if (not check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  ue*                    ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
-  ue* ue_ptr = ue_db[rnti].get();
 
   // Start TA FSM in UE entity
   ue_ptr->start_ta();
@@ -205,9 +195,10 @@ int mac::ue_rem(uint16_t rnti)
 {
   // Remove UE from the perspective of L2/L3
   {
-    srsran::rwlock_read_guard lock(rwlock);
-    if (check_ue_active(rnti)) {
-      ue_db[rnti]->set_active(false);
+    srsran::rcu_read_guard lock(ue_rcu);
+    ue*                    ue_ptr = find_active_ue(rnti);
+    if (ue_ptr != nullptr) {
+      ue_ptr->set_active(false);
     } else {
       logger.error("User rnti=0x%x not found", rnti);
       return SRSRAN_ERROR;
@@ -219,17 +210,28 @@ int mac::ue_rem(uint16_t rnti)
   // Note: Let any pending retx ACK to arrive, so that PHY recognizes rnti
   task_sched.defer_callback(FDD_HARQ_DELAY_DL_MS + FDD_HARQ_DELAY_UL_MS, [this, rnti]() {
     phy_h->rem_rnti(rnti);
-    srsran::rwlock_write_guard lock(rwlock);
     ue_db.erase(rnti);
     logger.info("User rnti=0x%x removed from MAC/PHY", rnti);
+    reclaim_removed_ues();
   });
   return SRSRAN_SUCCESS;
 }
 
+// Deletes the removed UEs that PHY workers can no longer access. Retries every TTI until all are deleted
+void mac::reclaim_removed_ues()
+{
+  if (ue_rcu.reclaim() > 0 and not ue_reclaim_pending) {
+    ue_reclaim_pending = true;
+    task_sched.defer_callback(1, [this]() {
+      ue_reclaim_pending = false;
+      reclaim_removed_ues();
+    });
+  }
+}
+
 // Called after Msg3
 int mac::ue_set_crnti(uint16_t temp_crnti, uint16_t crnti, const sched_interface::ue_cfg_t& cfg)
 {
-  srsran::rwlock_read_guard lock(rwlock);
   if (temp_crnti == crnti) {
     // Schedule ConRes Msg4
     scheduler.dl_mac_buffer_state(crnti, (uint32_t)srsran::dl_sch_lcid::CON_RES_ID);
@@ -239,26 +241,26 @@ int mac::ue_set_crnti(uint16_t temp_crnti, uint16_t crnti, const sched_interface
 
 int mac::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg_)
 {
-  srsran::rwlock_write_guard lock(rwlock);
+  // Note: The cell configuration is set by RRC before the PHY workers start calling MAC
   cell_config = cell_cfg_;
   return scheduler.cell_cfg(cell_config);
 }
 
 void mac::get_metrics(mac_metrics_t& metrics)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::rcu_read_guard lock(ue_rcu);
   metrics.ues.reserve(ue_db.size());
-  for (auto& u : ue_db) {
-    if (not scheduler.ue_exists(u.first)) {
-      continue;
+  ue_db.for_each([this, &metrics](ue& u) {
+    if (not scheduler.ue_exists(u.get_rnti())) {
+      return;
     }
     metrics.ues.emplace_back();
     auto& ue_metrics = metrics.ues.back();
 
-    u.second->metrics_read(&ue_metrics);
-    scheduler.metrics_read(u.first, ue_metrics);
+    u.metrics_read(&ue_metrics);
+    scheduler.metrics_read(u.get_rnti(), ue_metrics);
     ue_metrics.pci = (ue_metrics.cc_idx < cell_config.size()) ? cell_config[ue_metrics.cc_idx].cell.id : 0;
-  }
+  });
   metrics.cc_info.resize(detected_rachs.size());
   for (unsigned cc = 0, e = detected_rachs.size(); cc != e; ++cc) {
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
@@ -273,13 +275,11 @@ void mac::toggle_padding()
 
 void mac::add_padding()
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  for (auto it = ue_db.begin(); it != ue_db.end(); ++it) {
-    uint16_t cur_rnti = it->first;
-    auto     ue       = it;
-    scheduler.dl_rlc_buffer_state(ue->first, args.lcid_padding, 20e6, 0);
-    ue->second->trigger_padding(args.lcid_padding);
-  }
+  srsran::rcu_read_guard lock(ue_rcu);
+  ue_db.for_each([this](ue& u) {
+    scheduler.dl_rlc_buffer_state(u.get_rnti(), args.lcid_padding, 20e6, 0);
+    u.trigger_padding(args.lcid_padding);
+  });
 }
 
 /********************************************************
@@ -291,14 +291,14 @@ void mac::add_padding()
 int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
   logger.set_context(tti_rx);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  ue*                    ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   int nof_bytes = scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
-  ue_db[rnti]->metrics_tx(ack, nof_bytes);
+  ue_ptr->metrics_tx(ack, nof_bytes);
 
   rrc_h->set_radiolink_dl_state(rnti, ack);
 
@@ -308,14 +308,14 @@ int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
 int mac::crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t nof_bytes, bool crc)
 {
   logger.set_context(tti_rx);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  ue*                    ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
-  ue_db[rnti]->set_tti(tti_rx);
-  ue_db[rnti]->metrics_rx(crc, nof_bytes);
+  ue_ptr->set_tti(tti_rx);
+  ue_ptr->metrics_rx(crc, nof_bytes);
 
   rrc_h->set_radiolink_ul_state(rnti, crc);
 
@@ -330,13 +330,13 @@ int mac::push_pdu(uint32_t tti_rx,
                   bool     crc,
                   uint32_t ul_nof_prbs)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  ue*                    ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
-  srsran::unique_byte_buffer_t pdu = ue_db[rnti]->release_pdu(tti_rx, enb_cc_idx);
+  srsran::unique_byte_buffer_t pdu = ue_ptr->release_pdu(tti_rx, enb_cc_idx);
   if (pdu == nullptr) {
     logger.warning("Could not find MAC UL PDU for rnti=0x%x, cc=%d, tti=%d", rnti, enb_cc_idx, tti_rx);
     return SRSRAN_ERROR;
@@ -352,9 +352,10 @@ int mac::push_pdu(uint32_t tti_rx,
                   nof_bytes,
                   (int)pdu->size());
     auto process_pdu_task = [this, rnti, enb_cc_idx, ul_nof_prbs](srsran::unique_byte_buffer_t& pdu) {
-      srsran::rwlock_read_guard lock(rwlock);
-      if (check_ue_active(rnti)) {
-        ue_db[rnti]->process_pdu(std::move(pdu), enb_cc_idx, ul_nof_prbs);
+      srsran::rcu_read_guard lock(ue_rcu);
+      ue*                    ue_ptr = find_active_ue(rnti);
+      if (ue_ptr != nullptr) {
+        ue_ptr->process_pdu(std::move(pdu), enb_cc_idx, ul_nof_prbs);
       } else {
         logger.debug("Discarding PDU rnti=0x%x", rnti);
       }
@@ -369,14 +370,14 @@ int mac::push_pdu(uint32_t tti_rx,
 int mac::ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  ue*                    ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   scheduler.dl_ri_info(tti, rnti, enb_cc_idx, ri_value);
-  ue_db[rnti]->metrics_dl_ri(ri_value);
+  ue_ptr->metrics_dl_ri(ri_value);
 
   return SRSRAN_SUCCESS;
 }
@@ -384,14 +385,14 @@ int mac::ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_v
 int mac::pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  ue*                    ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   scheduler.dl_pmi_info(tti, rnti, enb_cc_idx, pmi_value);
-  ue_db[rnti]->metrics_dl_pmi(pmi_value);
+  ue_ptr->metrics_dl_pmi(pmi_value);
 
   return SRSRAN_SUCCESS;
 }
@@ -399,14 +400,14 @@ int mac::pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi
 int mac::cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  ue*                    ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   scheduler.dl_cqi_info(tti, rnti, enb_cc_idx, cqi_value);
-  ue_db[rnti]->metrics_dl_cqi(cqi_value);
+  ue_ptr->metrics_dl_cqi(cqi_value);
 
   return SRSRAN_SUCCESS;
 }
@@ -414,9 +415,8 @@ int mac::cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi
 int mac::sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  if (find_active_ue(rnti) == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -427,9 +427,8 @@ int mac::sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
 int mac::snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr, ul_channel_t ch)
 {
   logger.set_context(tti_rx);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  if (find_active_ue(rnti) == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -440,13 +439,13 @@ int mac::snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr
 
 int mac::ta_info(uint32_t tti, uint16_t rnti, float ta_us)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  ue*                    ue_ptr = find_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
-  uint32_t nof_ta_count = ue_db[rnti]->set_ta_us(ta_us);
+  uint32_t nof_ta_count = ue_ptr->set_ta_us(ta_us);
   if (nof_ta_count > 0) {
     return scheduler.dl_mac_buffer_state(rnti, (uint32_t)srsran::dl_sch_lcid::TA_CMD, nof_ta_count);
   }
@@ -456,9 +455,8 @@ int mac::ta_info(uint32_t tti, uint16_t rnti, float ta_us)
 int mac::sr_detected(uint32_t tti, uint16_t rnti)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
-
-  if (not check_ue_active(rnti)) {
+  srsran::rcu_read_guard lock(ue_rcu);
+  if (find_active_ue(rnti) == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -488,30 +486,21 @@ uint16_t mac::allocate_ue(uint32_t enb_cc_idx)
     rnti = FIRST_RNTI + (ue_counter.fetch_add(1, std::memory_order_relaxed) % 60000);
 
     // Pre-check if rnti is valid
-    {
-      srsran::rwlock_read_guard read_lock(rwlock);
-      if (ue_db.full()) {
-        logger.warning("Maximum number of connected UEs %zd connected to the eNB. Ignoring PRACH", SRSENB_MAX_UES);
-        return SRSRAN_INVALID_RNTI;
-      }
-      if (not is_valid_rnti_unprotected(rnti)) {
-        continue;
-      }
+    if (ue_db.full()) {
+      logger.warning("Maximum number of connected UEs %zd connected to the eNB. Ignoring PRACH", SRSENB_MAX_UES);
+      return SRSRAN_INVALID_RNTI;
+    }
+    if (not is_valid_rnti_unprotected(rnti)) {
+      continue;
     }
 
     // Allocate and initialize UE object
     unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
         rnti, rnti, enb_cc_idx, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
 
-    // Add UE to rnti map
-    srsran::rwlock_write_guard rw_lock(rwlock);
-    if (not is_valid_rnti_unprotected(rnti)) {
-      continue;
-    }
-    auto ret = ue_db.insert(rnti, std::move(ue_ptr));
-    if (ret.has_value()) {
-      inserted_ue = ret.value()->second.get();
-    } else {
+    // Add UE to rnti map. Fails if another UE took the rnti meanwhile
+    inserted_ue = ue_db.insert(rnti, std::move(ue_ptr));
+    if (inserted_ue == nullptr) {
       logger.info("Failed to allocate rnti=0x%x. Attempting a different rnti.", rnti);
     }
   } while (inserted_ue == nullptr);
@@ -612,11 +601,7 @@ void mac::rach_detected(uint32_t tti, uint32_t enb_cc_idx, uint32_t preamble_idx
       return;
     }
 
-    auto get_pci = [this, enb_cc_idx]() {
-      srsran::rwlock_read_guard lock(rwlock);
-      return (enb_cc_idx < cell_config.size()) ? cell_config[enb_cc_idx].cell.id : 0;
-    };
-    uint32_t pci = get_pci();
+    uint32_t pci = (enb_cc_idx < cell_config.size()) ? cell_config[enb_cc_idx].cell.id : 0;
     logger.info("%sRACH:  tti=%d, cc=%d, pci=%d, preamble=%d, offset=%d, temp_crnti=0x%x",
                 (is_po_prach) ? "PDCCH order " : "",
                 tti,
@@ -638,6 +623,7 @@ void mac::rach_detected(uint32_t tti, uint32_t enb_cc_idx, uint32_t preamble_idx
 
 int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 {
+  srsran::rcu_read_guard lock(ue_rcu);
   if (!started) {
     return 0;
   }
@@ -648,8 +634,6 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
     add_padding();
   }
 
-  srsran::rwlock_read_guard lock(rwlock);
-
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < cell_config.size(); enb_cc_idx++) {
     // Run scheduler with current info
     sched_interface::dl_sched_res_t sched_result = {};
@@ -668,13 +652,14 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
       // Get UE
       uint16_t rnti = sched_result.data[i].dci.rnti;
 
-      if (ue_db.contains(rnti)) {
+      ue* ue_ptr = ue_db.find(rnti);
+      if (ue_ptr != nullptr) {
         // Copy dci info
         dl_sched_res->pdsch[n].dci = sched_result.data[i].dci;
 
         for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
           dl_sched_res->pdsch[n].softbuffer_tx[tb] =
-              ue_db[rnti]->get_tx_softbuffer(enb_cc_idx, sched_result.data[i].dci.pid, tb);
+              ue_ptr->get_tx_softbuffer(enb_cc_idx, sched_result.data[i].dci.pid, tb);
 
           // If the Rx soft-buffer is not given, abort transmission
           if (dl_sched_res->pdsch[n].softbuffer_tx[tb] == nullptr) {
@@ -683,12 +668,12 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 
           if (sched_result.data[i].nof_pdu_elems[tb] > 0) {
             /* Get PDU if it's a new transmission */
-            dl_sched_res->pdsch[n].data[tb] = ue_db[rnti]->generate_pdu(enb_cc_idx,
-                                                                        sched_result.data[i].dci.pid,
-                                                                        tb,
-                                                                        sched_result.data[i].pdu[tb],
-                                                                        sched_result.data[i].nof_pdu_elems[tb],
-                                                                        sched_result.data[i].tbs[tb]);
+            dl_sched_res->pdsch[n].data[tb] = ue_ptr->generate_pdu(enb_cc_idx,
+                                                                   sched_result.data[i].dci.pid,
+                                                                   tb,
+                                                                   sched_result.data[i].pdu[tb],
+                                                                   sched_result.data[i].nof_pdu_elems[tb],
+                                                                   sched_result.data[i].tbs[tb]);
 
             if (!dl_sched_res->pdsch[n].data[tb]) {
               logger.error("Error! PDU was not generated (rnti=0x%04x, tb=%d)", rnti, tb);
@@ -792,7 +777,7 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
     // Copy PDCCH order grants
     for (uint32_t i = 0; i < sched_result.po.size(); i++) {
       uint16_t rnti = sched_result.po[i].dci.rnti;
-      if (ue_db.contains(rnti)) {
+      if (ue_db.find(rnti) != nullptr) {
         // Copy dci info
         dl_sched_res->pdsch[n].dci = sched_result.po[i].dci;
         if (pcap) {
@@ -814,9 +799,7 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
   }
 
   // Count number of TTIs for all active users
-  for (auto& u : ue_db) {
-    u.second->metrics_cnt();
-  }
+  ue_db.for_each([](ue& u) { u.metrics_cnt(); });
 
   return SRSRAN_SUCCESS;
 }
@@ -856,8 +839,12 @@ void mac::build_mch_sched(uint32_t tbs)
 
 int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res_list)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  dl_sched_t*               dl_sched_res = &dl_sched_res_list[0];
+  srsran::rcu_read_guard lock(ue_rcu);
+  ue*                    mch_ue = ue_db.find(SRSRAN_MRNTI);
+  if (mch_ue == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  dl_sched_t* dl_sched_res = &dl_sched_res_list[0];
   logger.set_context(tti);
   srsran_ra_tb_t mcs      = {};
   srsran_ra_tb_t mcs_data = {};
@@ -884,9 +871,9 @@ int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res
     dl_sched_res->pdsch[0].dci.rnti    = SRSRAN_MRNTI;
 
     // we use TTI % HARQ to make sure we use different buffers for consecutive TTIs to avoid races between PHY workers
-    ue_db[SRSRAN_MRNTI]->metrics_tx(true, mcs.tbs);
+    mch_ue->metrics_tx(true, mcs.tbs);
     dl_sched_res->pdsch[0].data[0] =
-        ue_db[SRSRAN_MRNTI]->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, mch.num_mtch_sched + 1, mcs.tbs / 8);
+        mch_ue->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, mch.num_mtch_sched + 1, mcs.tbs / 8);
   } else {
     uint32_t current_lcid = 1;
     uint32_t mtch_index   = 0;
@@ -903,15 +890,15 @@ int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res
       int requested_bytes = (mcs_data.tbs / 8 > (int)mch.mtch_sched[mtch_index].lcid_buffer_size)
                                 ? (mch.mtch_sched[mtch_index].lcid_buffer_size)
                                 : ((mcs_data.tbs / 8) - 2);
-      int bytes_received = ue_db[SRSRAN_MRNTI]->read_pdu(current_lcid, mtch_payload_buffer, requested_bytes);
+      int bytes_received = mch_ue->read_pdu(current_lcid, mtch_payload_buffer, requested_bytes);
       mch.pdu[0].lcid    = current_lcid;
       mch.pdu[0].nbytes  = bytes_received;
       mch.mtch_sched[0].mtch_payload  = mtch_payload_buffer;
       dl_sched_res->pdsch[0].dci.rnti = SRSRAN_MRNTI;
       if (bytes_received) {
-        ue_db[SRSRAN_MRNTI]->metrics_tx(true, mcs.tbs);
+        mch_ue->metrics_tx(true, mcs.tbs);
         dl_sched_res->pdsch[0].data[0] =
-            ue_db[SRSRAN_MRNTI]->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, 1, mcs_data.tbs / 8);
+            mch_ue->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, 1, mcs_data.tbs / 8);
       }
     } else {
       dl_sched_res->pdsch[0].dci.rnti = 0;
@@ -921,9 +908,7 @@ int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res
   }
 
   // Count number of TTIs for all active users
-  for (auto& u : ue_db) {
-    u.second->metrics_cnt();
-  }
+  ue_db.for_each([](ue& u) { u.metrics_cnt(); });
   return SRSRAN_SUCCESS;
 }
 
@@ -966,18 +951,15 @@ uint8_t* mac::assemble_rar(sched_interface::dl_sched_rar_grant_t* grants,
 
 int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
 {
+  srsran::rcu_read_guard lock(ue_rcu);
   if (!started) {
     return SRSRAN_SUCCESS;
   }
 
   logger.set_context(TTI_SUB(tti_tx_ul, FDD_HARQ_DELAY_UL_MS + FDD_HARQ_DELAY_DL_MS));
 
-  srsran::rwlock_read_guard lock(rwlock);
-
   // Execute UE FSMs (e.g. TA)
-  for (auto& ue : ue_db) {
-    ue.second->tic();
-  }
+  ue_db.for_each([](ue& u) { u.tic(); });
 
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < cell_config.size(); enb_cc_idx++) {
     ul_sched_t* phy_ul_sched_res = &ul_sched_res_list[enb_cc_idx];
@@ -997,13 +979,14 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
         // Get UE
         uint16_t rnti = sched_result.pusch[i].dci.rnti;
 
-        if (ue_db.contains(rnti)) {
+        ue* ue_ptr = ue_db.find(rnti);
+        if (ue_ptr != nullptr) {
           // Copy grant info
           phy_ul_sched_res->pusch[n].current_tx_nb = sched_result.pusch[i].current_tx_nb;
           phy_ul_sched_res->pusch[n].pid           = TTI_RX(tti_tx_ul) % SRSRAN_FDD_NOF_HARQ;
           phy_ul_sched_res->pusch[n].needs_pdcch   = sched_result.pusch[i].needs_pdcch;
           phy_ul_sched_res->pusch[n].dci           = sched_result.pusch[i].dci;
-          phy_ul_sched_res->pusch[n].softbuffer_rx = ue_db[rnti]->get_rx_softbuffer(enb_cc_idx, tti_tx_ul);
+          phy_ul_sched_res->pusch[n].softbuffer_rx = ue_ptr->get_rx_softbuffer(enb_cc_idx, tti_tx_ul);
 
           // If the Rx soft-buffer is not given, abort reception
           if (phy_ul_sched_res->pusch[n].softbuffer_rx == nullptr) {
@@ -1014,8 +997,7 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
           if (sched_result.pusch[n].current_tx_nb == 0) {
             srsran_softbuffer_rx_reset_tbs(phy_ul_sched_res->pusch[n].softbuffer_rx, sched_result.pusch[i].tbs * 8);
           }
-          phy_ul_sched_res->pusch[n].data =
-              ue_db[rnti]->request_buffer(tti_tx_ul, enb_cc_idx, sched_result.pusch[i].tbs);
+          phy_ul_sched_res->pusch[n].data = ue_ptr->request_buffer(tti_tx_ul, enb_cc_idx, sched_result.pusch[i].tbs);
           if (phy_ul_sched_res->pusch[n].data) {
             phy_ul_sched_res->nof_grants++;
           } else {
@@ -1038,9 +1020,7 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
     phy_ul_sched_res->nof_phich = sched_result.phich.size();
   }
   // clear old buffers from all users
-  for (auto& u : ue_db) {
-    u.second->clear_old_buffers(tti_tx_ul);
-  }
+  ue_db.for_each([tti_tx_ul](ue& u) { u.clear_old_buffers(tti_tx_ul); });
   return SRSRAN_SUCCESS;
 }
 
@@ -1050,7 +1030,7 @@ void mac::write_mcch(const srsran::sib2_mbms_t* sib2_,
                      const uint8_t*             mcch_payload,
                      const uint8_t              mcch_payload_length)
 {
-  srsran::rwlock_write_guard lock(rwlock);
+  // Note: The MCCH is configured by RRC before the PHY workers start calling MAC
   mcch               = *mcch_;
   mch.num_mtch_sched = this->mcch.pmch_info_list[0].nof_mbms_session_info;
   for (uint32_t i = 0; i < mch.num_mtch_sched; ++i) {
@@ -1064,20 +1044,20 @@ void mac::write_mcch(const srsran::sib2_mbms_t* sib2_,
   unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
       SRSRAN_MRNTI, SRSRAN_MRNTI, 0, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
 
-  auto ret = ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr));
-  if (!ret) {
+  if (ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr)) == nullptr) {
     logger.info("Failed to allocate rnti=0x%x.for eMBMS", SRSRAN_MRNTI);
   }
 }
 
-// Internal helper function, caller must hold UE DB rwlock
-bool mac::check_ue_active(uint16_t rnti)
+// Internal helper function, caller must be inside a UE DB read-side section
+ue* mac::find_active_ue(uint16_t rnti)
 {
-  if (not ue_db.contains(rnti)) {
+  ue* ue_ptr = ue_db.find(rnti);
+  if (ue_ptr == nullptr) {
     logger.error("User rnti=0x%x not found", rnti);
-    return false;
+    return nullptr;
   }
-  return ue_db[rnti]->is_active();
+  return ue_ptr->is_active() ? ue_ptr : nullptr;
 }
 
 } // namespace srsenb
@@ -50,7 +50,11 @@ void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
   sched_cfg = sched_cfg_;
 
   // Initialize first carrier scheduler
-  carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0, &sched_results});
+  carrier_schedulers.emplace_back(new carrier_sched{rrc, &rrc_mutex, &ue_db, 0, &sched_results});
+
+  if (sched_cfg.nof_cc_workers > 0) {
+    cc_workers.reset(new srsran::task_thread_pool(sched_cfg.nof_cc_workers));
+  }
 
   reset();
 }
@@ -83,7 +87,7 @@ int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
   uint32_t prev_size = carrier_schedulers.size();
   carrier_schedulers.resize(sched_cell_params.size());
   for (uint32_t i = prev_size; i < sched_cell_params.size(); ++i) {
-    carrier_schedulers[i].reset(new carrier_sched{rrc, &ue_db, i, &sched_results});
+    carrier_schedulers[i].reset(new carrier_sched{rrc, &rrc_mutex, &ue_db, i, &sched_results});
   }
 
   // setup all carriers cfg params
@@ -361,6 +365,11 @@ void sched::new_tti(tti_point tti_rx)
 {
   last_tti = std::max(last_tti, tti_rx);
 
+  if (cc_workers != nullptr and carrier_schedulers.size() > 1) {
+    new_tti_parallel(tti_rx);
+    return;
+  }
+
   // Generate sched results for all CCs, if not yet generated
   for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
@@ -370,6 +379,86 @@ void sched::new_tti(tti_point tti_rx)
   }
 }
 
+/// Generate scheduling decision for tti_rx, scheduling in parallel the groups of carriers that have no UEs in common.
+/// The carriers of a group are scheduled in ascending order, as in the sequential case, so the decisions are the same.
+void sched::new_tti_parallel(tti_point tti_rx)
+{
+  // Group the carriers that are linked by the configured carriers of a UE (e.g. PCell and SCells)
+  std::array<uint32_t, SRSRAN_MAX_CARRIERS> group_id;
+  for (uint32_t cc = 0; cc < carrier_schedulers.size(); ++cc) {
+    group_id[cc] = cc;
+  }
+  for (auto& ue_pair : ue_db) {
+    const auto& cc_list = ue_pair.second->get_ue_cfg().supported_cc_list;
+    for (uint32_t i = 1; i < cc_list.size(); ++i) {
+      if (cc_list[0].enb_cc_idx >= carrier_schedulers.size() or cc_list[i].enb_cc_idx >= carrier_schedulers.size()) {
+        continue;
+      }
+      uint32_t old_id = group_id[cc_list[i].enb_cc_idx], new_id = group_id[cc_list[0].enb_cc_idx];
+      for (uint32_t cc = 0; cc < carrier_schedulers.size(); ++cc) {
+        if (group_id[cc] == old_id) {
+          group_id[cc] = new_id;
+        }
+      }
+    }
+  }
+  cc_groups.clear();
+  for (uint32_t cc = 0; cc < carrier_schedulers.size(); ++cc) {
+    if (is_generated(tti_rx, cc)) {
+      continue;
+    }
+    uint32_t i = 0;
+    while (i < cc_groups.size() and group_id[cc_groups[i][0]] != group_id[cc]) {
+      ++i;
+    }
+    if (i == cc_groups.size()) {
+      cc_groups.emplace_back();
+    }
+    cc_groups[i].push_back(cc);
+  }
+  if (cc_groups.empty()) {
+    return;
+  }
+
+  // Steps shared by all carriers, that would be otherwise done by the first carrier to be scheduled
+  if (not sched_results.has_sf(tti_rx)) {
+    sched_results.new_tti(tti_rx);
+  }
+  if (not sched_results.has_sf(tti_rx + MSG3_DELAY_MS)) {
+    sched_results.new_tti(tti_rx + MSG3_DELAY_MS);
+  }
+  for (auto& ue_pair : ue_db) {
+    ue_pair.second->new_subframe(tti_rx, cc_groups[0][0]);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(cc_workers_mutex);
+    nof_pending_cc_groups = cc_groups.size() - 1;
+  }
+  for (uint32_t i = 1; i < cc_groups.size(); ++i) {
+    cc_workers->push_task([this, tti_rx, i]() {
+      generate_cc_group_results(tti_rx, i);
+      std::lock_guard<std::mutex> lock(cc_workers_mutex);
+      if (--nof_pending_cc_groups == 0) {
+        cc_workers_cvar.notify_one();
+      }
+    });
+  }
+  generate_cc_group_results(tti_rx, 0);
+
+  std::unique_lock<std::mutex> lock(cc_workers_mutex);
+  while (nof_pending_cc_groups > 0) {
+    cc_workers_cvar.wait(lock);
+  }
+}
+
+void sched::generate_cc_group_results(tti_point tti_rx, uint32_t group_idx)
+{
+  for (uint32_t cc : cc_groups[group_idx]) {
+    carrier_schedulers[cc]->generate_tti_result(tti_rx);
+  }
+}
+
 /// Check if TTI result is generated
 bool sched::is_generated(srsran::tti_point tti_rx, uint32_t enb_cc_idx) const
 {
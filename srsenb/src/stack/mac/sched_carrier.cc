@@ -35,8 +35,8 @@ using srsran::tti_point;
  *        Broadcast (SIB+Paging) scheduling
  *******************************************************/
 
-bc_sched::bc_sched(const sched_cell_params_t& cfg_, srsenb::rrc_interface_mac* rrc_) :
-  cc_cfg(&cfg_), rrc(rrc_), logger(srslog::fetch_basic_logger("MAC"))
+bc_sched::bc_sched(const sched_cell_params_t& cfg_, srsenb::rrc_interface_mac* rrc_, std::mutex* rrc_mutex_) :
+  cc_cfg(&cfg_), rrc(rrc_), rrc_mutex(rrc_mutex_), logger(srslog::fetch_basic_logger("MAC"))
 {
 }
 
@@ -146,9 +146,13 @@ void bc_sched::alloc_paging(sf_sched* tti_sched)
 {
   uint32_t paging_payload = 0;
 
-  // Check if pending Paging message
-  if (not rrc->is_paging_opportunity(tti_sched->get_tti_tx_dl().to_uint(), &paging_payload) or paging_payload == 0) {
-    return;
+  // Check if pending Paging message. The RRC only try-locks the paging context, so the carriers scheduled in parallel
+  // must not query it at the same time, or some of them could miss the paging opportunity
+  {
+    std::lock_guard<std::mutex> lock(*rrc_mutex);
+    if (not rrc->is_paging_opportunity(tti_sched->get_tti_tx_dl().to_uint(), &paging_payload) or paging_payload == 0) {
+      return;
+    }
   }
 
   alloc_result ret = alloc_result::invalid_coderate;
@@ -343,10 +347,12 @@ void ra_sched::reset()
  *******************************************************/
 
 sched::carrier_sched::carrier_sched(rrc_interface_mac*       rrc_,
+                                    std::mutex*              rrc_mutex_,
                                     sched_ue_list*           ue_db_,
                                     uint32_t                 enb_cc_idx_,
                                     sched_result_ringbuffer* sched_results_) :
   rrc(rrc_),
+  rrc_mutex(rrc_mutex_),
   ue_db(ue_db_),
   logger(srslog::fetch_basic_logger("MAC")),
   enb_cc_idx(enb_cc_idx_),
@@ -370,7 +376,7 @@ void sched::carrier_sched::carrier_cfg(const sched_cell_params_t& cell_params_)
   cc_cfg = &cell_params_;
 
   // init Broadcast/RA schedulers
-  bc_sched_ptr.reset(new bc_sched{*cc_cfg, rrc});
+  bc_sched_ptr.reset(new bc_sched{*cc_cfg, rrc, rrc_mutex});
   ra_sched_ptr.reset(new ra_sched{*cc_cfg, *ue_db});
 
   // Setup data scheduling algorithms
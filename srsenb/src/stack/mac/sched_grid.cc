@@ -499,6 +499,23 @@ bool is_periodic_cqi_expected(const sched_interface::ue_cfg_t& ue_cfg, tti_point
   return false;
 }
 
+/// Checks if the UE has a PUSCH grant in any of its carriers. The carriers not configured for the UE are not visited,
+/// as they may be scheduled concurrently
+bool is_ue_ul_alloc(const sf_sched_result& cc_results, const sched_ue& user)
+{
+  for (const sched_interface::ue_cfg_t::cc_cfg_t& cc : user.get_ue_cfg().supported_cc_list) {
+    if (cc.enb_cc_idx >= cc_results.enb_cc_list.size()) {
+      continue;
+    }
+    for (const auto& pusch : cc_results.enb_cc_list[cc.enb_cc_idx].ul_sched_result.pusch) {
+      if (pusch.dci.rnti == user.get_rnti()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask, uint32_t pid)
 {
   if (data_allocs.full()) {
@@ -538,7 +555,7 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
     }
   }
 
-  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or cc_results->is_ul_alloc(user->get_rnti());
+  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or is_ue_ul_alloc(*cc_results, *user);
 
   // Check if there is space in the PUCCH for HARQ ACKs
   const sched_interface::ue_cfg_t& ue_cfg    = user->get_ue_cfg();
@@ -822,15 +839,18 @@ uci_pusch_t is_uci_included(const sf_sched*        sf_sched,
   }
 
   for (uint32_t enbccidx = 0; enbccidx < other_cc_results.enb_cc_list.size(); ++enbccidx) {
+    // Only the UE active carriers are visited, as the other carriers may be scheduled concurrently
+    auto p = user->get_active_cell_index(enbccidx);
+    if (not p.first or p.second >= ue_cc_idx) {
+      continue;
+    }
     for (uint32_t j = 0; j < other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch.size(); ++j) {
       // Checks all the UL grants already allocated for the given rnti
       if (other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch[j].dci.rnti == user->get_rnti()) {
-        auto p = user->get_active_cell_index(enbccidx);
-        // If the UE CC Idx is the lowest so far
-        if (p.first and p.second < ue_cc_idx) {
-          ue_cc_idx      = p.second;
-          sel_enb_cc_idx = enbccidx;
-        }
+        // The UE CC Idx is the lowest so far
+        ue_cc_idx      = p.second;
+        sel_enb_cc_idx = enbccidx;
+        break;
       }
     }
   }
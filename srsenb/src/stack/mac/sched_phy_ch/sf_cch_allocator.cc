@@ -22,6 +22,7 @@
 #include "srsenb/hdr/stack/mac/sched_phy_ch/sf_cch_allocator.h"
 #include "srsenb/hdr/stack/mac/sched_grid.h"
 #include "srsran/srslog/bundled/fmt/format.h"
+#include <algorithm>
 
 namespace srsenb {
 
@@ -38,6 +39,7 @@ void sf_cch_allocator::init(const sched_cell_params_t& cell_params_)
   cc_cfg           = &cell_params_;
   pucch_cfg_common = cc_cfg->pucch_cfg_common;
   dci_record_list.reserve(16);
+  dfs_reach.reserve(17);
   last_dci_dfs.reserve(16);
   temp_dci_dfs.reserve(16);
 }
@@ -77,13 +79,18 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
   temp_dci_dfs.clear();
   uint32_t start_cfix = current_cfix;
 
-  alloc_record record;
-  record.user       = user;
-  record.aggr_idx   = aggr_idx;
-  record.alloc_type = alloc_type;
-  record.pusch_uci  = has_pusch_grant;
+  dci_record_list.emplace_back();
+  alloc_record& record = dci_record_list.back();
+  record.user          = user;
+  record.aggr_idx      = aggr_idx;
+  record.alloc_type    = alloc_type;
+  record.pusch_uci     = has_pusch_grant;
+  record.candidates_set.fill(false);
+  record.nof_locs_checked.fill(0);
+  failed_dfs_states.clear();
+  dfs_reach_cfix = MAX_CFI;
 
-  if (is_dl_ctrl_alloc(alloc_type) and nof_allocs() == 0 and cc_cfg->nof_prb() <= 25 and
+  if (is_dl_ctrl_alloc(alloc_type) and nof_allocs() == 1 and cc_cfg->nof_prb() <= 25 and
       current_max_cfix > current_cfix) {
     // Given that CFI is not currently dynamic for ctrl allocs, in case of SIB/RAR alloc and a low number of PRBs,
     // start with an CFI that maximizes nof potential CCE locs
@@ -101,24 +108,21 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
 
   // Try to allocate grant. If it fails, attempt the same grant, but using a different permutation of past grant DCI
   // positions
-  do {
-    bool success = alloc_dfs_node(record, 0);
-    if (success) {
-      // DCI record allocation successful
-      dci_record_list.push_back(record);
-
-      if (is_dl_ctrl_alloc(alloc_type)) {
-        // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
-        current_max_cfix = current_cfix;
-      }
-      return true;
-    }
-    if (temp_dci_dfs.empty()) {
-      temp_dci_dfs = last_dci_dfs;
+  bool success = alloc_dfs_node(dci_record_list.size() - 1, 0);
+  if (not success) {
+    temp_dci_dfs = last_dci_dfs;
+    success      = get_next_dfs();
+  }
+  if (success) {
+    if (is_dl_ctrl_alloc(alloc_type)) {
+      // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
+      current_max_cfix = current_cfix;
     }
-  } while (get_next_dfs());
+    return true;
+  }
 
   // Revert steps to initial state, before dci record allocation was attempted
+  dci_record_list.pop_back();
   last_dci_dfs.swap(temp_dci_dfs);
   current_cfix = start_cfix;
   return false;
@@ -139,8 +143,7 @@ bool sf_cch_allocator::get_next_dfs()
       start_child_idx = last_dci_dfs.back().dci_pos_idx + 1;
       last_dci_dfs.pop_back();
     }
-    while (last_dci_dfs.size() < dci_record_list.size() and
-           alloc_dfs_node(dci_record_list[last_dci_dfs.size()], start_child_idx)) {
+    while (last_dci_dfs.size() < dci_record_list.size() and alloc_dfs_node(last_dci_dfs.size(), start_child_idx)) {
       start_child_idx = 0;
     }
   } while (last_dci_dfs.size() < dci_record_list.size());
@@ -149,76 +152,266 @@ bool sf_cch_allocator::get_next_dfs()
   return true;
 }
 
-bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
+/// Computes the CCE candidates of a DCI for the current CFI, until "min_size" candidates or all of them are found, so
+/// that a DCI placed in one of its first positions does not pay for the remaining ones
+const sf_cch_allocator::cce_candidate_list& sf_cch_allocator::compute_cce_candidates(alloc_record& record,
+                                                                                      uint32_t      min_size)
 {
+  cce_candidate_list& candidates = record.candidates[current_cfix];
+
   // Get DCI Location Table
   const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
-  if (dci_locs == nullptr or (*dci_locs)[record.aggr_idx].empty()) {
-    return false;
-  }
-  const cce_position_list& dci_pos_list = (*dci_locs)[record.aggr_idx];
-  if (start_dci_idx >= dci_pos_list.size()) {
-    return false;
+  if (dci_locs == nullptr) {
+    record.candidates_set[current_cfix] = true;
+    return candidates;
   }
+  const cce_position_list& locs    = (*dci_locs)[record.aggr_idx];
+  uint32_t&                loc_idx = record.nof_locs_checked[current_cfix];
 
-  tree_node node;
-  node.dci_pos_idx = start_dci_idx;
-  node.dci_pos.L   = record.aggr_idx;
-  node.rnti        = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
-  node.current_mask.resize(nof_cces());
-  // get cumulative pdcch & pucch masks
-  if (not last_dci_dfs.empty()) {
-    node.total_mask       = last_dci_dfs.back().total_mask;
-    node.total_pucch_mask = last_dci_dfs.back().total_pucch_mask;
-  } else {
-    node.total_mask.resize(nof_cces());
-    node.total_pucch_mask.resize(cc_cfg->nof_prb());
-  }
-
-  for (; node.dci_pos_idx < dci_pos_list.size(); ++node.dci_pos_idx) {
-    node.dci_pos.ncce = dci_pos_list[node.dci_pos_idx];
+  for (; loc_idx < locs.size() and candidates.size() < min_size; ++loc_idx) {
+    cce_candidate cand;
+    cand.ncce = locs[loc_idx];
 
     if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
       // The UE needs to allocate space in PUCCH for HARQ-ACK
-      pucch_cfg_common.n_pucch = node.dci_pos.ncce + pucch_cfg_common.N_pucch_1;
+      pucch_cfg_common.n_pucch = cand.ncce + pucch_cfg_common.N_pucch_1;
 
       if (is_pucch_sr_collision(record.user->get_ue_cfg().pucch_cfg, to_tx_dl_ack(tti_rx), pucch_cfg_common.n_pucch)) {
         // avoid collision of HARQ-ACK with own SR n(1)_pucch
         continue;
       }
 
-      node.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
-      if (not cc_cfg->sched_cfg->pucch_mux_enabled and node.total_pucch_mask.test(node.pucch_n_prb)) {
-        // PUCCH allocation would collide with other PUCCH/PUSCH grants. Try another CCE position
-        continue;
-      }
-      int low_rb = node.pucch_n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2
-                       ? node.pucch_n_prb
-                       : cc_cfg->cfg.cell.nof_prb - node.pucch_n_prb - 1;
+      cand.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
+      int low_rb       = cand.pucch_n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2
+                             ? cand.pucch_n_prb
+                             : cc_cfg->cfg.cell.nof_prb - cand.pucch_n_prb - 1;
       if (cc_cfg->sched_cfg->pucch_harq_max_rb > 0 && low_rb >= cc_cfg->sched_cfg->pucch_harq_max_rb) {
         // PUCCH allocation would fall outside the maximum allowed PUCCH HARQ region. Try another CCE position
-        logger.info("Skipping PDCCH allocation for CCE=%d due to PUCCH HARQ falling outside region\n",
-                    node.dci_pos.ncce);
+        logger.info("Skipping PDCCH allocation for CCE=%d due to PUCCH HARQ falling outside region\n", cand.ncce);
         continue;
       }
     }
 
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
+    candidates.push_back(cand);
+  }
+  record.candidates_set[current_cfix] = loc_idx == locs.size();
+  return candidates;
+}
+
+uint32_t sf_cch_allocator::dfs_state_memory::hash(const dfs_state& state)
+{
+  // Fibonacci hashing, which keeps the upper bits of the product
+  uint64_t h = state.depth * MAX_CFI + state.cfix;
+  for (uint64_t w : state.bits) {
+    h = (h ^ w) * 0x9e3779b97f4a7c15ULL;
+  }
+  return (uint32_t)(h >> (64U - capacity_log2));
+}
+
+bool sf_cch_allocator::dfs_state_memory::contains(const dfs_state& state) const
+{
+  uint32_t idx = hash(state);
+  for (uint32_t n = 0; n < max_probes and generations[idx] == generation; ++n, idx = (idx + 1) % capacity) {
+    if (states[idx] == state) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void sf_cch_allocator::dfs_state_memory::insert(const dfs_state& state)
+{
+  uint32_t home = hash(state), idx = home;
+  for (uint32_t n = 0; n < max_probes; ++n, idx = (idx + 1) % capacity) {
+    if (generations[idx] != generation) {
+      generations[idx] = generation;
+      states[idx]      = state;
+      nof_states++;
+      return;
+    }
+    if (states[idx] == state) {
+      return;
+    }
+  }
+  // The probe window is full. The new state replaces the one at its hash position
+  states[home] = state;
+}
+
+void sf_cch_allocator::dfs_state_memory::clear()
+{
+  if (nof_states == 0) {
+    return;
+  }
+  nof_states = 0;
+  if (++generation == 0) {
+    generations.fill(0);
+    generation = 1;
+  }
+}
+
+/// Sets the bits [start, stop) of a bit array made of 64-bit words
+static void fill_words(uint32_t start, uint32_t stop, uint64_t* words)
+{
+  while (start < stop) {
+    uint32_t end = std::min(stop, (start / 64U + 1U) * 64U);
+    words[start / 64U] |= (~0ULL >> (64U - (end - start))) << (start % 64U);
+    start = end;
+  }
+}
+
+template <typename Bitset>
+static void bitset_to_words(const Bitset& mask, uint64_t* words)
+{
+  // The masks are made of a few CCE/PRB intervals, so they are copied one interval at a time
+  int pos = mask.find_lowest(0, mask.size(), true);
+  while (pos >= 0) {
+    int end = mask.find_lowest(pos, mask.size(), false);
+    end     = end < 0 ? mask.size() : end;
+    fill_words(pos, end, words);
+    pos = end < (int)mask.size() ? mask.find_lowest(end, mask.size(), true) : -1;
+  }
+}
+
+/// Gets the CCEs and PUCCH PRBs that the DCIs from "depth" onwards could take, which are computed once per DCI
+/// allocation and CFI
+const sf_cch_allocator::dfs_state_bits& sf_cch_allocator::get_dfs_reach(uint32_t depth)
+{
+  if (dfs_reach_cfix != current_cfix) {
+    dfs_reach_cfix = current_cfix;
+    dfs_reach.assign(dci_record_list.size() + 1, {});
+    for (uint32_t i = dci_record_list.size(); i > 0; --i) {
+      dfs_state_bits& reach = dfs_reach[i - 1];
+      uint32_t        L     = 1U << dci_record_list[i - 1].aggr_idx;
+      reach                 = dfs_reach[i];
+      for (const cce_candidate& c : get_cce_candidates(i - 1)) {
+        fill_words(c.ncce, c.ncce + L, &reach[0]);
+        if (c.pucch_n_prb >= 0) {
+          fill_words(c.pucch_n_prb, c.pucch_n_prb + 1, &reach[2]);
+        }
+      }
+    }
+  }
+  return dfs_reach[depth];
+}
+
+/// Creates the DFS state reached when placing the DCI "cand" (if not null) on top of the occupied CCEs and PRBs
+sf_cch_allocator::dfs_state sf_cch_allocator::make_dfs_state(uint32_t             depth,
+                                                             const pdcch_mask_t&  total_mask,
+                                                             const prbmask_t&     total_pucch_mask,
+                                                             const cce_candidate* cand)
+{
+  // Only the CCEs and PRBs that the remaining DCIs could take are relevant to the outcome of the search
+  const dfs_state_bits& reach = get_dfs_reach(depth);
+  dfs_state state;
+  state.depth = depth;
+  state.cfix  = current_cfix;
+  bitset_to_words(total_mask, &state.bits[0]);
+  bitset_to_words(total_pucch_mask, &state.bits[2]);
+  if (cand != nullptr) {
+    fill_words(cand->ncce, cand->ncce + (1U << dci_record_list[depth - 1].aggr_idx), &state.bits[0]);
+    if (cand->pucch_n_prb >= 0) {
+      fill_words(cand->pucch_n_prb, cand->pucch_n_prb + 1, &state.bits[2]);
+    }
+  }
+  for (uint32_t i = 0; i < state.bits.size(); ++i) {
+    state.bits[i] &= reach[i];
+  }
+  return state;
+}
+
+/// Checks whether the DCIs after record_idx, which are not yet placed in the current DFS path, have at least one free
+/// CCE candidate each once "cand" is placed for record_idx. If not, the DFS subtree has no solution and can be skipped
+bool sf_cch_allocator::fits_remaining_dcis(uint32_t             record_idx,
+                                           const pdcch_mask_t&  total_mask,
+                                           const prbmask_t&     total_pucch_mask,
+                                           const cce_candidate& cand)
+{
+  bool     pucch_mux = cc_cfg->sched_cfg->pucch_mux_enabled;
+  uint32_t cand_end  = cand.ncce + (1U << dci_record_list[record_idx].aggr_idx);
+  for (uint32_t i = record_idx + 1; i < dci_record_list.size(); ++i) {
+    const cce_candidate_list& candidates = get_cce_candidates(i);
+    uint32_t                  L          = 1U << dci_record_list[i].aggr_idx;
+    if (std::none_of(candidates.begin(), candidates.end(), [&](const cce_candidate& c) {
+          if (c.ncce < cand_end and cand.ncce < c.ncce + L) {
+            return false;
+          }
+          if (c.pucch_n_prb >= 0 and not pucch_mux and
+              (c.pucch_n_prb == cand.pucch_n_prb or total_pucch_mask.test(c.pucch_n_prb))) {
+            return false;
+          }
+          return not total_mask.any(c.ncce, c.ncce + L);
+        })) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool sf_cch_allocator::alloc_dfs_node(uint32_t record_idx, uint32_t start_dci_idx)
+{
+  const cce_candidate_list& candidates = get_cce_candidates(record_idx, start_dci_idx + 1);
+  if (start_dci_idx >= candidates.size()) {
+    return false;
+  }
+  const alloc_record& record  = dci_record_list[record_idx];
+  uint32_t            L       = 1U << record.aggr_idx;
+  bool                is_leaf = record_idx + 1 == dci_record_list.size();
+  bool                prune   = dci_record_list.size() >= MIN_NOF_DCIS_DFS_PRUNING;
+
+  tree_node node;
+  node.record_idx = record_idx;
+  node.dci_pos.L  = record.aggr_idx;
+  node.rnti       = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
+  // get cumulative pdcch & pucch masks
+  if (not last_dci_dfs.empty()) {
+    node.total_mask       = last_dci_dfs.back().total_mask;
+    node.total_pucch_mask = last_dci_dfs.back().total_pucch_mask;
+  } else {
+    node.total_mask.resize(nof_cces());
+    node.total_pucch_mask.resize(cc_cfg->nof_prb());
+  }
+
+  for (uint32_t idx = start_dci_idx; idx < get_cce_candidates(record_idx, idx + 1).size(); ++idx) {
+    const cce_candidate& cand = candidates[idx];
+    if (cand.pucch_n_prb >= 0 and not cc_cfg->sched_cfg->pucch_mux_enabled and
+        node.total_pucch_mask.test(cand.pucch_n_prb)) {
+      // PUCCH allocation would collide with other PUCCH/PUSCH grants. Try another CCE position
+      continue;
+    }
+    if (node.total_mask.any(cand.ncce, cand.ncce + L)) {
       // there is a PDCCH collision. Try another CCE position
       continue;
     }
+    if (prune and not is_leaf) {
+      if (not fits_remaining_dcis(record_idx, node.total_mask, node.total_pucch_mask, cand)) {
+        // One of the following DCIs would not find space. Try another CCE position
+        continue;
+      }
+      if (not failed_dfs_states.empty() and
+          failed_dfs_states.contains(make_dfs_state(record_idx + 1, node.total_mask, node.total_pucch_mask, &cand))) {
+        // The same CCEs were already taken by another permutation of the past DCIs, without solution
+        continue;
+      }
+    }
 
     // Allocation successful
-    node.total_mask |= node.current_mask;
-    if (node.pucch_n_prb >= 0) {
-      node.total_pucch_mask.set(node.pucch_n_prb);
+    node.dci_pos_idx  = idx;
+    node.dci_pos.ncce = cand.ncce;
+    node.pucch_n_prb  = cand.pucch_n_prb;
+    node.current_mask.resize(nof_cces());
+    node.current_mask.fill(cand.ncce, cand.ncce + L);
+    node.total_mask.fill(cand.ncce, cand.ncce + L);
+    if (cand.pucch_n_prb >= 0) {
+      node.total_pucch_mask.set(cand.pucch_n_prb);
     }
     last_dci_dfs.push_back(node);
     return true;
   }
 
+  // All the positions of this DCI were already tried for the current DFS path
+  if (prune) {
+    failed_dfs_states.insert(make_dfs_state(record_idx, node.total_mask, node.total_pucch_mask, nullptr));
+  }
   return false;
 }
 
@@ -399,50 +399,77 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
 
   tunnels.init(args, pdcp);
 
-  char errbuf[128] = {};
-
   // Set up socket
-  fd = socket(AF_INET, SOCK_DGRAM, 0);
+  fd = open_s1u_socket();
   if (fd < 0) {
-    logger.error("Failed to create socket");
     return SRSRAN_ERROR;
   }
+
+  // Assign a handler to rx S1U packets
+  auto rx_callback = [this](srsran::span<srsran::rx_datagram_t> burst) { handle_gtpu_s1u_rx_burst(burst); };
+  rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_burst_handler(logger, gtpu_queue, rx_callback));
+
+  // Additional rx threads, each one with its own socket bound to the same port. The kernel spreads the incoming flows
+  // over them, and all of them hand the received packets over to the stack thread
+  for (uint32_t i = 1; i < args.nof_rx_threads; ++i) {
+    int rx_fd = open_s1u_socket();
+    if (rx_fd < 0) {
+      return SRSRAN_ERROR;
+    }
+    rx_fds.push_back(rx_fd);
+    rx_workers.emplace_back(new srsran::socket_manager("GTPU_RX" + std::to_string(i)));
+    rx_workers.back()->add_socket_handler(rx_fd, srsran::make_sdu_burst_handler(logger, gtpu_queue, rx_callback));
+  }
+
+  // Start MCH socket if enabled
+  if (args.embms_enable) {
+    if (not m1u.init(args.embms_m1u_multiaddr, args.embms_m1u_if_addr)) {
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int gtpu::open_s1u_socket()
+{
+  char errbuf[128] = {};
+
+  int sock_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (sock_fd < 0) {
+    logger.error("Failed to create socket");
+    return -1;
+  }
   int enable = 1;
 #if defined(SO_REUSEADDR)
-  if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int)) < 0)
+  if (setsockopt(sock_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int)) < 0)
     logger.error("setsockopt(SO_REUSEADDR) failed");
 #endif
 #if defined(SO_REUSEPORT)
-  if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(int)) < 0)
+  if (setsockopt(sock_fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(int)) < 0)
     logger.error("setsockopt(SO_REUSEPORT) failed");
 #endif
 
   struct sockaddr_in bindaddr;
   bzero(&bindaddr, sizeof(struct sockaddr_in));
   // Bind socket
-  if (not net_utils::bind_addr(fd, gtp_bind_addr.c_str(), GTPU_PORT, &bindaddr)) {
+  if (not net_utils::bind_addr(sock_fd, gtp_bind_addr.c_str(), GTPU_PORT, &bindaddr)) {
     snprintf(errbuf, sizeof(errbuf), "%s", strerror(errno));
     srsran::console("Failed to bind on address %s, port %d: %s\n", gtp_bind_addr.c_str(), int(GTPU_PORT), errbuf);
-    return SRSRAN_ERROR;
-  }
-
-  // Assign a handler to rx S1U packets
-  auto rx_callback = [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
-    handle_gtpu_s1u_rx_packet(std::move(pdu), from);
-  };
-  rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_handler(logger, gtpu_queue, rx_callback));
-
-  // Start MCH socket if enabled
-  if (args.embms_enable) {
-    if (not m1u.init(args.embms_m1u_multiaddr, args.embms_m1u_if_addr)) {
-      return SRSRAN_ERROR;
-    }
+    close(sock_fd);
+    return -1;
   }
-  return SRSRAN_SUCCESS;
+  return sock_fd;
 }
 
 void gtpu::stop()
 {
+  // Join the additional rx threads before closing their sockets
+  rx_workers.clear();
+  for (int rx_fd : rx_fds) {
+    close(rx_fd);
+  }
+  rx_fds.clear();
+
   if (fd > 0) {
     close(fd);
     fd = -1;
@@ -627,6 +654,20 @@ void gtpu::handle_end_marker(const gtpu_tunnel& rx_tunnel)
 }
 
 void gtpu::handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr)
+{
+  handle_s1u_pdu(std::move(pdu), addr);
+  flush_pdcp_batch();
+}
+
+void gtpu::handle_gtpu_s1u_rx_burst(srsran::span<srsran::rx_datagram_t> burst)
+{
+  for (srsran::rx_datagram_t& datagram : burst) {
+    handle_s1u_pdu(std::move(datagram.pdu), datagram.from);
+  }
+  flush_pdcp_batch();
+}
+
+void gtpu::handle_s1u_pdu(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr)
 {
   srsran_assert(pdu != nullptr, "Called with null PDU");
 
@@ -666,6 +707,8 @@ void gtpu::handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const soc
       handle_msg_data_pdu(header, *tun_ptr, std::move(pdu));
     } break;
     case GTPU_MSG_END_MARKER:
+      // SDUs received before the End Marker must reach PDCP before the buffered ones of the target tunnel
+      flush_pdcp_batch();
       handle_end_marker(*tun_ptr);
       break;
     default:
@@ -697,6 +740,10 @@ void gtpu::handle_msg_data_pdu(const gtpu_header_t&         header,
 
   tunnels.handle_rx_pdcp_sdu(rx_tunnel.teid_in);
 
+  if (rx_tunnel.state != gtpu_tunnel_manager::tunnel_state::pdcp_active) {
+    flush_pdcp_batch();
+  }
+
   switch (rx_tunnel.state) {
     case gtpu_tunnel_manager::tunnel_state::forward_to: {
       // Forward SDU to direct/indirect tunnel during Handover
@@ -708,7 +755,7 @@ void gtpu::handle_msg_data_pdu(const gtpu_header_t&         header,
       break;
     }
     case gtpu_tunnel_manager::tunnel_state::pdcp_active: {
-      pdcp->write_sdu(rnti, eps_bearer_id, std::move(pdu), pdcp_sn == undefined_pdcp_sn ? -1 : (int)pdcp_sn);
+      write_pdcp_sdu(rnti, eps_bearer_id, std::move(pdu), pdcp_sn);
       break;
     }
     case gtpu_tunnel_manager::tunnel_state::forwarded_from:
@@ -718,6 +765,31 @@ void gtpu::handle_msg_data_pdu(const gtpu_header_t&         header,
   }
 }
 
+void gtpu::write_pdcp_sdu(uint16_t rnti, uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu, uint32_t pdcp_sn)
+{
+  if (pdcp_sn != undefined_pdcp_sn) {
+    // SDUs with a PDCP SN set by the peer (e.g. forwarded during handover) are written one by one
+    flush_pdcp_batch();
+    pdcp->write_sdu(rnti, eps_bearer_id, std::move(sdu), (int)pdcp_sn);
+    return;
+  }
+  if (rnti != pdcp_batch_rnti or eps_bearer_id != pdcp_batch_eps_bearer_id) {
+    flush_pdcp_batch();
+    pdcp_batch_rnti          = rnti;
+    pdcp_batch_eps_bearer_id = eps_bearer_id;
+  }
+  pdcp_batch.push_back(std::move(sdu));
+}
+
+void gtpu::flush_pdcp_batch()
+{
+  if (pdcp_batch.empty()) {
+    return;
+  }
+  pdcp->write_sdu_batch(pdcp_batch_rnti, pdcp_batch_eps_bearer_id, pdcp_batch);
+  pdcp_batch.clear();
+}
+
 void gtpu::handle_gtpu_m1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr)
 {
   m1u.handle_rx_packet(std::move(pdu), addr);
@@ -184,6 +184,14 @@ void pdcp::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t
   }
 }
 
+void pdcp::write_sdu_batch(uint16_t rnti, uint32_t lcid, std::vector<srsran::unique_byte_buffer_t>& sdus)
+{
+  if (users.count(rnti) and rnti != SRSRAN_MRNTI) {
+    users[rnti].pdcp->write_sdu_batch(lcid, sdus);
+  }
+  sdus.clear();
+}
+
 void pdcp::send_status_report(uint16_t rnti, uint32_t lcid)
 {
   if (users.count(rnti)) {
@@ -236,6 +244,11 @@ bool pdcp::user_interface_rlc::sdu_queue_is_full(uint32_t lcid)
   return rlc->sdu_queue_is_full(rnti, lcid);
 }
 
+uint32_t pdcp::user_interface_rlc::sdu_queue_free_space(uint32_t lcid)
+{
+  return rlc->sdu_queue_free_space(rnti, lcid);
+}
+
 void pdcp::user_interface_rrc::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
   rrc->write_pdu(rnti, lcid, std::move(pdu));
@@ -276,4 +289,11 @@ void pdcp::get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti)
   }
 }
 
+void pdcp::get_metrics(std::map<uint16_t, srsran::pdcp_metrics_t>& ues, const uint32_t nof_tti)
+{
+  for (auto& user : users) {
+    user.second.pdcp->get_metrics(ues[user.first], nof_tti);
+  }
+}
+
 } // namespace srsenb
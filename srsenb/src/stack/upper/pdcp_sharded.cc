@@ -0,0 +1,253 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/upper/pdcp_sharded.h"
+
+namespace srsenb {
+
+pdcp_sharded::pdcp_sharded(ue_shard_pool&            shards_,
+                           srsran::task_sched_handle stack_task_sched,
+                           srslog::basic_logger&     logger_,
+                           uint32_t                  ul_data_queue_size) :
+  shards(shards_), logger(logger_)
+{
+  stack_data_queue = stack_task_sched.make_task_queue(ul_data_queue_size);
+  stack_ctrl_queue = stack_task_sched.make_task_queue();
+  for (uint32_t i = 0; i < shards.size(); i++) {
+    pdcps.emplace_back(new pdcp(shards.get_task_sched(i), logger));
+  }
+}
+
+void pdcp_sharded::init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_)
+{
+  rrc_itf.parent  = this;
+  rrc_itf.rrc     = rrc_;
+  gtpu_itf.parent = this;
+  gtpu_itf.gtpu   = gtpu_;
+  for (auto& p : pdcps) {
+    p->init(rlc_, &rrc_itf, &gtpu_itf);
+  }
+}
+
+void pdcp_sharded::stop()
+{
+  for (uint32_t i = 0; i < pdcps.size(); i++) {
+    pdcp* p = pdcps[i].get();
+    shards.run_sync(i, [p]() { p->stop(); });
+  }
+}
+
+/*******************************************************************************
+ *  Calls from the stack thread and the lower layers, executed in the UE shard
+ *******************************************************************************/
+
+void pdcp_sharded::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu)
+{
+  auto task = [this, rnti, lcid](srsran::unique_byte_buffer_t& pdu) {
+    shard_pdcp(rnti).write_pdu(rnti, lcid, std::move(pdu));
+  };
+  push(rnti, std::bind(task, std::move(pdu)));
+}
+
+void pdcp_sharded::notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
+{
+  push(rnti, [this, rnti, lcid, pdcp_sns]() { shard_pdcp(rnti).notify_delivery(rnti, lcid, pdcp_sns); });
+}
+
+void pdcp_sharded::notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
+{
+  push(rnti, [this, rnti, lcid, pdcp_sns]() { shard_pdcp(rnti).notify_failure(rnti, lcid, pdcp_sns); });
+}
+
+void pdcp_sharded::set_enabled(uint16_t rnti, uint32_t lcid, bool enabled)
+{
+  push(rnti, [this, rnti, lcid, enabled]() { shard_pdcp(rnti).set_enabled(rnti, lcid, enabled); });
+}
+
+void pdcp_sharded::reset(uint16_t rnti)
+{
+  push(rnti, [this, rnti]() { shard_pdcp(rnti).reset(rnti); });
+}
+
+void pdcp_sharded::add_user(uint16_t rnti)
+{
+  push(rnti, [this, rnti]() { shard_pdcp(rnti).add_user(rnti); });
+}
+
+void pdcp_sharded::rem_user(uint16_t rnti)
+{
+  push(rnti, [this, rnti]() { shard_pdcp(rnti).rem_user(rnti); });
+}
+
+void pdcp_sharded::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn)
+{
+  auto task = [this, rnti, lcid, pdcp_sn](srsran::unique_byte_buffer_t& sdu) {
+    shard_pdcp(rnti).write_sdu(rnti, lcid, std::move(sdu), pdcp_sn);
+  };
+  push(rnti, std::bind(task, std::move(sdu)));
+}
+
+void pdcp_sharded::write_sdu_batch(uint16_t rnti, uint32_t lcid, std::vector<srsran::unique_byte_buffer_t>& sdus)
+{
+  auto task = [this, rnti, lcid](std::vector<srsran::unique_byte_buffer_t>& batch) {
+    shard_pdcp(rnti).write_sdu_batch(rnti, lcid, batch);
+  };
+  push(rnti, std::bind(task, std::move(sdus)));
+  sdus.clear();
+}
+
+void pdcp_sharded::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cfg)
+{
+  push(rnti, [this, rnti, lcid, cfg]() { shard_pdcp(rnti).add_bearer(rnti, lcid, cfg); });
+}
+
+void pdcp_sharded::del_bearer(uint16_t rnti, uint32_t lcid)
+{
+  push(rnti, [this, rnti, lcid]() { shard_pdcp(rnti).del_bearer(rnti, lcid); });
+}
+
+void pdcp_sharded::config_security(uint16_t rnti, uint32_t lcid, const srsran::as_security_config_t& sec_cfg)
+{
+  push(rnti, [this, rnti, lcid, sec_cfg]() { shard_pdcp(rnti).config_security(rnti, lcid, sec_cfg); });
+}
+
+void pdcp_sharded::enable_integrity(uint16_t rnti, uint32_t lcid)
+{
+  push(rnti, [this, rnti, lcid]() { shard_pdcp(rnti).enable_integrity(rnti, lcid); });
+}
+
+void pdcp_sharded::enable_encryption(uint16_t rnti, uint32_t lcid)
+{
+  push(rnti, [this, rnti, lcid]() { shard_pdcp(rnti).enable_encryption(rnti, lcid); });
+}
+
+void pdcp_sharded::send_status_report(uint16_t rnti)
+{
+  push(rnti, [this, rnti]() { shard_pdcp(rnti).send_status_report(rnti); });
+}
+
+void pdcp_sharded::send_status_report(uint16_t rnti, uint32_t lcid)
+{
+  push(rnti, [this, rnti, lcid]() { shard_pdcp(rnti).send_status_report(rnti, lcid); });
+}
+
+void pdcp_sharded::reestablish(uint16_t rnti)
+{
+  push(rnti, [this, rnti]() { shard_pdcp(rnti).reestablish(rnti); });
+}
+
+bool pdcp_sharded::get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state_t* state)
+{
+  bool ret = false;
+  run_sync(rnti, [this, rnti, lcid, state, &ret]() { ret = shard_pdcp(rnti).get_bearer_state(rnti, lcid, state); });
+  return ret;
+}
+
+bool pdcp_sharded::set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte_state_t& state)
+{
+  bool ret = false;
+  run_sync(rnti, [this, rnti, lcid, &state, &ret]() { ret = shard_pdcp(rnti).set_bearer_state(rnti, lcid, state); });
+  return ret;
+}
+
+std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp_sharded::get_buffered_pdus(uint16_t rnti, uint32_t lcid)
+{
+  std::map<uint32_t, srsran::unique_byte_buffer_t> ret;
+  run_sync(rnti, [this, rnti, lcid, &ret]() { ret = shard_pdcp(rnti).get_buffered_pdus(rnti, lcid); });
+  return ret;
+}
+
+void pdcp_sharded::get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti)
+{
+  // The UEs are reported in RNTI order, like the metrics of the other layers
+  std::map<uint16_t, srsran::pdcp_metrics_t> ues;
+  for (uint32_t i = 0; i < pdcps.size(); i++) {
+    pdcp* p = pdcps[i].get();
+    shards.run_sync(i, [p, &ues, nof_tti]() { p->get_metrics(ues, nof_tti); });
+  }
+  m.ues.clear();
+  m.ues.reserve(ues.size());
+  for (auto& ue : ues) {
+    m.ues.push_back(ue.second);
+  }
+}
+
+/*******************************************************************************
+ *  Calls from the UE shards, executed in the stack thread
+ *******************************************************************************/
+
+void pdcp_sharded::push_stack_data_task(srsran::move_task_t task)
+{
+  if (not stack_data_queue.try_push(std::move(task))) {
+    uint32_t nof_dropped = nof_dropped_ul_pdus.fetch_add(1, std::memory_order_relaxed) + 1;
+    logger.warning("Stack task queue is full. Dropping UL data PDU (%d dropped so far)", nof_dropped);
+  }
+}
+
+void pdcp_sharded::push_stack_ctrl_task(srsran::move_task_t task)
+{
+  bool schedule_run = false;
+  {
+    std::lock_guard<std::mutex> lock(ctrl_mutex);
+    ctrl_tasks.push_back(std::move(task));
+    schedule_run     = not ctrl_run_pending;
+    ctrl_run_pending = true;
+  }
+  // At most one run is ever queued, so the push cannot find the queue full
+  if (schedule_run and not stack_ctrl_queue.try_push([this]() { run_stack_ctrl_tasks(); })) {
+    srsran_terminate("Failed to schedule the PDCP control tasks in the stack thread");
+  }
+}
+
+void pdcp_sharded::run_stack_ctrl_tasks()
+{
+  std::deque<srsran::move_task_t> tasks;
+  {
+    std::lock_guard<std::mutex> lock(ctrl_mutex);
+    tasks.swap(ctrl_tasks);
+    ctrl_run_pending = false;
+  }
+  for (srsran::move_task_t& task : tasks) {
+    task();
+  }
+}
+
+void pdcp_sharded::rrc_adapter::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu)
+{
+  rrc_interface_pdcp* rrc_ = rrc;
+  auto task = [rrc_, rnti, lcid](srsran::unique_byte_buffer_t& pdu) { rrc_->write_pdu(rnti, lcid, std::move(pdu)); };
+  parent->push_stack_ctrl_task(std::bind(task, std::move(pdu)));
+}
+
+void pdcp_sharded::rrc_adapter::notify_pdcp_integrity_error(uint16_t rnti, uint32_t lcid)
+{
+  rrc_interface_pdcp* rrc_ = rrc;
+  parent->push_stack_ctrl_task([rrc_, rnti, lcid]() { rrc_->notify_pdcp_integrity_error(rnti, lcid); });
+}
+
+void pdcp_sharded::gtpu_adapter::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu)
+{
+  gtpu_interface_pdcp* gtpu_ = gtpu;
+  auto task = [gtpu_, rnti, lcid](srsran::unique_byte_buffer_t& pdu) { gtpu_->write_pdu(rnti, lcid, std::move(pdu)); };
+  parent->push_stack_data_task(std::bind(task, std::move(pdu)));
+}
+
+} // namespace srsenb
@@ -273,6 +273,17 @@ bool rlc::sdu_queue_is_full(uint16_t rnti, uint32_t lcid)
   return ret;
 }
 
+uint32_t rlc::sdu_queue_free_space(uint16_t rnti, uint32_t lcid)
+{
+  uint32_t ret = 0;
+  pthread_rwlock_rdlock(&rwlock);
+  if (users.count(rnti)) {
+    ret = users[rnti].rlc->sdu_queue_free_space(lcid);
+  }
+  pthread_rwlock_unlock(&rwlock);
+  return ret;
+}
+
 void rlc::user_interface::max_retx_attempted()
 {
   rrc->max_retx_attempted(rnti);
@@ -0,0 +1,119 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/upper/ue_shard_pool.h"
+#include <future>
+
+namespace srsenb {
+
+ue_shard_pool::~ue_shard_pool()
+{
+  stop();
+  pthread_rwlock_destroy(&rwlock);
+}
+
+void ue_shard_pool::init(uint32_t nof_shards, int32_t prio, uint32_t sync_queue_size)
+{
+  for (uint32_t i = 0; i < nof_shards; i++) {
+    shards.emplace_back(new shard(i, sync_queue_size));
+  }
+  {
+    srsran::rwlock_write_guard lock(rwlock);
+    running = true;
+  }
+  for (auto& s : shards) {
+    s->start(prio);
+  }
+  logger.info("Started %d UE stack shards", nof_shards);
+}
+
+void ue_shard_pool::stop()
+{
+  {
+    // Once released, no other task can reach the shard queues, so the final drain of each shard misses none
+    srsran::rwlock_write_guard lock(rwlock);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  for (auto& s : shards) {
+    s->stop();
+  }
+}
+
+void ue_shard_pool::push(uint32_t idx, srsran::move_task_t task)
+{
+  {
+    srsran::rwlock_read_guard lock(rwlock);
+    if (running) {
+      shards[idx]->task_queue.push(std::move(task));
+      return;
+    }
+  }
+  task();
+}
+
+void ue_shard_pool::run_sync(uint32_t idx, srsran::move_task_t task)
+{
+  std::promise<void> done;
+  push(idx, [&task, &done]() {
+    task();
+    done.set_value();
+  });
+  done.get_future().wait();
+}
+
+void ue_shard_pool::tti_clock()
+{
+  srsran::rwlock_read_guard lock(rwlock);
+  if (not running) {
+    return;
+  }
+  for (auto& s : shards) {
+    srsran::task_scheduler* sched = &s->task_sched;
+    s->sync_queue.push([sched]() { sched->tic(); });
+  }
+}
+
+ue_shard_pool::shard::shard(uint32_t id, uint32_t sync_queue_size) : thread("STACK_UE" + std::to_string(id))
+{
+  task_queue = task_sched.make_task_queue();
+  sync_queue = task_sched.make_task_queue(sync_queue_size);
+}
+
+void ue_shard_pool::shard::stop()
+{
+  task_queue.push([this]() { running = false; });
+  wait_thread_finish();
+  // Tasks pushed before the pool was stopped might be left behind, e.g. a synchronous call waiting for its result
+  task_sched.run_pending_tasks();
+  task_sched.stop();
+}
+
+void ue_shard_pool::shard::run_thread()
+{
+  while (running.load(std::memory_order_relaxed)) {
+    task_sched.run_next_task();
+  }
+}
+
+} // namespace srsenb
@@ -0,0 +1,260 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "sched_test_utils.h"
+#include "srsenb/hdr/stack/mac/mac.h"
+#include "srsenb/test/common/rlc_test_dummy.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/enb_phy_interfaces.h"
+#include <algorithm>
+#include <chrono>
+#include <getopt.h>
+#include <thread>
+
+using namespace srsenb;
+
+static uint32_t nof_workers      = 2;
+static uint32_t nof_ttis         = 2000;
+static uint32_t max_ues          = 24;
+static uint32_t attaches_per_tti = 2;
+static uint32_t deadline_us      = 1000;
+static uint32_t tti_offset       = 0;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [wtuad]\n", prog);
+  printf("\t-w number of PHY workers [Default %d]\n", nof_workers);
+  printf("\t-t number of TTIs per phase [Default %d]\n", nof_ttis);
+  printf("\t-u maximum number of attached UEs [Default %d]\n", max_ues);
+  printf("\t-a number of UE attaches per TTI during the attach storm [Default %d]\n", attaches_per_tti);
+  printf("\t-d PHY worker deadline per TTI in microseconds [Default %d]\n", deadline_us);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "w:t:u:a:d:")) != -1) {
+    switch (opt) {
+      case 'w':
+        nof_workers = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 't':
+        nof_ttis = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'u':
+        max_ues = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'a':
+        attaches_per_tti = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'd':
+        deadline_us = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+class phy_dummy : public phy_interface_stack_lte
+{
+public:
+  void rem_rnti(uint16_t rnti) override {}
+  void set_mch_period_stop(uint32_t stop) override {}
+  void set_activation_deactivation_scell(uint16_t                                     rnti,
+                                         const std::array<bool, SRSRAN_MAX_CARRIERS>& activation) override
+  {}
+  void configure_mbsfn(srsran::sib2_mbms_t* sib2, srsran::sib13_t* sib13, const srsran::mcch_msg_t& mcch) override {}
+  void set_config(uint16_t rnti, const phy_rrc_cfg_list_t& dedicated_list) override {}
+  void complete_config(uint16_t rnti) override {}
+};
+
+using bench_clock = std::chrono::steady_clock;
+
+struct phase_stats {
+  std::vector<double> latencies_us;
+  uint32_t            nof_misses = 0;
+};
+
+/// Attached RNTIs, written by the stack thread and sampled by the PHY workers to generate UE feedback
+static std::vector<std::atomic<uint16_t> > attached_rntis(SRSENB_MAX_UES);
+
+/**
+ * PHY worker. TTIs are released every millisecond, and each worker takes the next released TTI, as the PHY workers
+ * of the eNB do. The latency is measured from the TTI release until the worker has obtained the DL/UL scheduling
+ * results and delivered the UE feedback to MAC.
+ */
+void phy_worker(mac&                   mac_obj,
+                bench_clock::time_point t_start,
+                std::atomic<uint32_t>& next_tti,
+                uint32_t               last_tti,
+                std::mutex&            stats_mutex,
+                phase_stats&           stats)
+{
+  mac_interface_phy_lte::dl_sched_list_t dl_res(1);
+  mac_interface_phy_lte::ul_sched_list_t ul_res(1);
+  std::vector<double>                    latencies;
+  uint32_t                               nof_misses = 0;
+
+  for (uint32_t tti = next_tti.fetch_add(1); tti < last_tti; tti = next_tti.fetch_add(1)) {
+    auto t_release = t_start + std::chrono::milliseconds(tti);
+    std::this_thread::sleep_until(t_release);
+
+    uint32_t tti_rx = (tti_offset + tti) % 10240;
+    mac_obj.get_dl_sched(TTI_ADD(tti_rx, FDD_HARQ_DELAY_UL_MS), dl_res);
+    mac_obj.get_ul_sched(TTI_ADD(tti_rx, FDD_HARQ_DELAY_UL_MS + FDD_HARQ_DELAY_DL_MS), ul_res);
+    for (uint32_t i = 0; i < dl_res[0].nof_grants; ++i) {
+      mac_obj.ack_info(tti_rx, dl_res[0].pdsch[i].dci.rnti, 0, 0, true);
+    }
+    for (uint32_t i = 0; i < ul_res[0].nof_grants; ++i) {
+      mac_obj.crc_info(tti_rx, ul_res[0].pusch[i].dci.rnti, 0, 0, false);
+    }
+    uint16_t rnti = attached_rntis[tti % attached_rntis.size()].load(std::memory_order_relaxed);
+    if (rnti != SRSRAN_INVALID_RNTI) {
+      mac_obj.cqi_info(tti_rx, rnti, 0, 10);
+      mac_obj.snr_info(tti_rx, rnti, 0, 20.0, mac_interface_phy_lte::PUSCH);
+    }
+
+    double latency_us =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - t_release).count() / 1000.0;
+    latencies.push_back(latency_us);
+    nof_misses += latency_us > deadline_us ? 1 : 0;
+  }
+
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  stats.latencies_us.insert(stats.latencies_us.end(), latencies.begin(), latencies.end());
+  stats.nof_misses += nof_misses;
+}
+
+/**
+ * Runs the PHY workers for nof_ttis, while the stack thread attaches (and detaches) "attaches_per_tti" UEs every TTI.
+ * @return latency statistics of the PHY workers
+ */
+phase_stats run_phase(mac& mac_obj, srsran::task_scheduler& task_sched, uint32_t attach_rate)
+{
+  phase_stats             stats;
+  std::mutex              stats_mutex;
+  std::atomic<uint32_t>   next_tti{0};
+  bench_clock::time_point t_start = bench_clock::now() + std::chrono::milliseconds(1);
+  std::vector<uint16_t>   rnti_fifo;
+  uint32_t                nof_attaches = 0, nof_rejects = 0;
+
+  std::vector<std::thread> workers;
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    workers.emplace_back(
+        phy_worker, std::ref(mac_obj), t_start, std::ref(next_tti), nof_ttis, std::ref(stats_mutex), std::ref(stats));
+  }
+
+  // Stack thread
+  sched_interface::ue_cfg_t ue_cfg = generate_default_ue_cfg();
+  for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+    std::this_thread::sleep_until(t_start + std::chrono::milliseconds(tti));
+    for (uint32_t i = 0; i < attach_rate; ++i) {
+      if (rnti_fifo.size() >= max_ues) {
+        uint16_t old_rnti = rnti_fifo.front();
+        rnti_fifo.erase(rnti_fifo.begin());
+        attached_rntis[old_rnti % attached_rntis.size()].store(SRSRAN_INVALID_RNTI, std::memory_order_relaxed);
+        TESTASSERT(mac_obj.ue_rem(old_rnti) == SRSRAN_SUCCESS);
+      }
+      uint16_t rnti = mac_obj.reserve_new_crnti(ue_cfg);
+      if (rnti == SRSRAN_INVALID_RNTI) {
+        // All the RNTI slots are still taken by UEs pending removal
+        nof_rejects++;
+        continue;
+      }
+      nof_attaches++;
+      rnti_fifo.push_back(rnti);
+      attached_rntis[rnti % attached_rntis.size()].store(rnti, std::memory_order_relaxed);
+    }
+    task_sched.tic();
+    task_sched.run_pending_tasks();
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+
+  // Detach remaining UEs and let the deferred removals complete
+  for (uint16_t rnti : rnti_fifo) {
+    attached_rntis[rnti % attached_rntis.size()].store(SRSRAN_INVALID_RNTI, std::memory_order_relaxed);
+    TESTASSERT(mac_obj.ue_rem(rnti) == SRSRAN_SUCCESS);
+  }
+  for (uint32_t i = 0; i < 2 * (FDD_HARQ_DELAY_UL_MS + FDD_HARQ_DELAY_DL_MS); ++i) {
+    task_sched.tic();
+    task_sched.run_pending_tasks();
+  }
+  tti_offset += nof_ttis;
+
+  TESTASSERT(stats.latencies_us.size() == nof_ttis);
+  std::sort(stats.latencies_us.begin(), stats.latencies_us.end());
+  auto percentile = [&stats](double p) {
+    return stats.latencies_us[std::min(stats.latencies_us.size() - 1, (size_t)(p * stats.latencies_us.size() / 100.0))];
+  };
+  printf("%-12s attaches=%5u, rejected=%4u: p50=%7.1f us, p99=%8.1f us, max=%8.1f us, deadline misses=%u (%.2f%%)\n",
+         attach_rate > 0 ? "attach storm" : "no attaches",
+         nof_attaches,
+         nof_rejects,
+         percentile(50),
+         percentile(99),
+         stats.latencies_us.back(),
+         stats.nof_misses,
+         100.0 * stats.nof_misses / nof_ttis);
+  return stats;
+}
+
+/**
+ * Measures the PHY worker TTI latencies and deadline misses with and without a UE attach storm, where the stack thread
+ * keeps adding and removing UEs while the PHY workers access the MAC UE DB.
+ */
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  max_ues = std::min(max_ues, (uint32_t)SRSENB_MAX_UES / 2);
+
+  srslog::fetch_basic_logger("MAC").set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  srsran::task_scheduler task_sched;
+  phy_dummy              phy;
+  rlc_dummy              rlc;
+  rrc_dummy              rrc;
+
+  mac_args_t args       = {};
+  args.nof_prb          = 25;
+  args.nof_prealloc_ues = max_ues;
+  cell_list_t cells(1);
+  mac         mac_obj(srsran::ext_task_sched_handle(&task_sched), srslog::fetch_basic_logger("MAC"));
+  TESTASSERT(mac_obj.init(args, cells, &phy, &rlc, &rrc));
+  std::vector<sched_interface::cell_cfg_t> cell_cfg = {generate_default_cell_cfg(args.nof_prb)};
+  TESTASSERT(mac_obj.cell_cfg(cell_cfg) == SRSRAN_SUCCESS);
+  for (auto& rnti : attached_rntis) {
+    rnti.store(SRSRAN_INVALID_RNTI, std::memory_order_relaxed);
+  }
+
+  printf("workers=%u, ttis=%u, max_ues=%u, deadline=%u us\n", nof_workers, nof_ttis, max_ues, deadline_us);
+  run_phase(mac_obj, task_sched, 0);
+  run_phase(mac_obj, task_sched, attaches_per_tti);
+
+  mac_obj.stop();
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
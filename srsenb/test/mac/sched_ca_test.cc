@@ -241,6 +241,146 @@ int test_scell_activation(uint32_t sim_number, test_scell_activation_params para
   return SRSRAN_SUCCESS;
 }
 
+/// Tester that stores a digest of the scheduling results of every TTI and carrier
+class sched_result_recorder : public common_sched_tester
+{
+public:
+  std::vector<std::vector<uint32_t> > tti_results;
+
+private:
+  int process_results() override
+  {
+    tti_results.emplace_back();
+    std::vector<uint32_t>& d = tti_results.back();
+    for (uint32_t cc = 0; cc < tti_info.dl_sched_result.size(); ++cc) {
+      const sched_interface::dl_sched_res_t& dl = tti_info.dl_sched_result[cc];
+      const sched_interface::ul_sched_res_t& ul = tti_info.ul_sched_result[cc];
+      d.insert(d.end(), {cc, dl.cfi, (uint32_t)dl.bc.size(), (uint32_t)dl.rar.size(), (uint32_t)dl.po.size()});
+      for (const auto& data : dl.data) {
+        d.insert(d.end(),
+                 {data.dci.rnti,
+                  data.dci.pid,
+                  data.dci.location.L,
+                  data.dci.location.ncce,
+                  data.dci.type0_alloc.rbg_bitmask,
+                  data.tbs[0],
+                  data.tbs[1],
+                  data.nof_pdu_elems[0]});
+      }
+      for (const auto& pusch : ul.pusch) {
+        d.insert(d.end(),
+                 {pusch.dci.rnti,
+                  pusch.dci.location.L,
+                  pusch.dci.location.ncce,
+                  pusch.dci.type2_alloc.riv,
+                  pusch.tbs,
+                  pusch.current_tx_nb,
+                  (uint32_t)pusch.needs_pdcch});
+      }
+      for (const auto& phich : ul.phich) {
+        d.insert(d.end(), {phich.rnti, (uint32_t)phich.phich});
+      }
+    }
+    return common_sched_tester::process_results();
+  }
+};
+
+/// Schedules 4 carriers, where carriers 0 and 1 are aggregated by some UEs and carriers 2 and 3 only have UEs of their
+/// own. Returns the digest of the scheduling results of every TTI
+int run_parallel_cc_sim(uint32_t nof_cc_workers, std::vector<std::vector<uint32_t> >& tti_results)
+{
+  const uint32_t nof_ccs = 4, nof_ues = 6, duration = 1000;
+  const uint32_t pcells[] = {0, 2, 3};
+
+  uint32_t       nof_prb  = srsran::lte_cell_nof_prbs[std::uniform_int_distribution<uint32_t>{0, 5}(get_rand_gen())];
+  sim_sched_args sim_args = generate_default_sim_args(nof_prb, nof_ccs);
+  sim_args.cell_cfg[2].cell.id       = 3;
+  sim_args.cell_cfg[3].cell.id       = 4;
+  sim_args.sched_args.nof_cc_workers = nof_cc_workers;
+  sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list.resize(1);
+
+  sched_sim_event_generator generator;
+  sched_result_recorder     tester;
+  tester.sim_cfg(sim_args);
+
+  // Event: PRACH of each UE in one of the carriers {0, 2, 3}
+  std::vector<uint16_t> rntis;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    do {
+      generator.step_tti();
+    } while (not srsran_prach_tti_opportunity_config_fdd(
+        sim_args.cell_cfg[pcells[i % 3]].prach_config, generator.tti_counter, -1));
+    ue_ctxt_test_cfg ue_sim_cfg                       = sim_args.default_ue_sim_cfg;
+    ue_sim_cfg.ue_cfg.supported_cc_list[0].enb_cc_idx = pcells[i % 3];
+    rntis.push_back(generator.add_new_default_user(duration, ue_sim_cfg)->rnti);
+  }
+  TESTASSERT(tester.test_next_ttis(generator.tti_events) == SRSRAN_SUCCESS);
+
+  // Event: Msg4 of every UE
+  for (uint16_t rnti : rntis) {
+    generator.add_dl_data(rnti, 40);
+  }
+  for (uint32_t i = 0; i < 200; ++i) {
+    generator.step_tti();
+    TESTASSERT(tester.test_next_ttis(generator.tti_events) == SRSRAN_SUCCESS);
+  }
+  for (uint16_t rnti : rntis) {
+    TESTASSERT(tester.sched_sim->find_rnti(rnti)->get_ctxt().conres_rx);
+  }
+
+  // Event: The UEs with PCell=0 get the carrier 1 as SCell
+  generator.step_tti();
+  for (uint32_t i = 0; i < nof_ues; i += 3) {
+    tti_ev::user_cfg_ev* user = generator.user_reconf(rntis[i]);
+    user->ue_sim_cfg->ue_cfg  = *tester.get_current_ue_cfg(rntis[i]);
+    user->ue_sim_cfg->ue_cfg.supported_cc_list.resize(2);
+    user->ue_sim_cfg->ue_cfg.supported_cc_list[1].active     = true;
+    user->ue_sim_cfg->ue_cfg.supported_cc_list[1].enb_cc_idx = 1;
+  }
+  TESTASSERT(tester.test_next_ttis(generator.tti_events) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < nof_ues; i += 3) {
+    tester.dl_cqi_info(tester.tti_rx.to_uint(), rntis[i], 1, 14);
+  }
+
+  // Event: Random DL and UL traffic
+  for (uint32_t i = 0; i < 500; ++i) {
+    generator.step_tti();
+    for (uint16_t rnti : rntis) {
+      if (randf() < 0.5) {
+        generator.add_dl_data(rnti, pow(10, 1 + 3 * randf()));
+      }
+      if (randf() < 0.3) {
+        generator.add_ul_data(rnti, pow(10, 1 + 3 * randf()));
+      }
+    }
+    TESTASSERT(tester.test_next_ttis(generator.tti_events) == SRSRAN_SUCCESS);
+  }
+
+  tti_results = std::move(tester.tti_results);
+  return SRSRAN_SUCCESS;
+}
+
+/// The carriers scheduled in parallel must reach the same decisions as the sequential scheduler
+int test_parallel_cc_sched(uint32_t sim_number)
+{
+  uint32_t                            sim_seed = seed + sim_number;
+  std::vector<std::vector<uint32_t> > seq_results, par_results;
+
+  set_randseed(sim_seed);
+  TESTASSERT(run_parallel_cc_sim(0, seq_results) == SRSRAN_SUCCESS);
+  set_randseed(sim_seed);
+  TESTASSERT(run_parallel_cc_sim(2, par_results) == SRSRAN_SUCCESS);
+
+  TESTASSERT(seq_results.size() == par_results.size());
+  for (uint32_t i = 0; i < seq_results.size(); ++i) {
+    TESTASSERT(seq_results[i] == par_results[i]);
+  }
+
+  srslog::flush();
+  printf("[TESTER] Sim%d finished successfully\n\n", sim_number);
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   // Setup rand seed
@@ -282,6 +422,11 @@ int main()
     TESTASSERT(test_scell_activation(n * 2 + 1, p) == SRSRAN_SUCCESS);
   }
 
+  for (uint32_t n = 0; n < 5; ++n) {
+    printf("[TESTER] Parallel CC sim run number: %u\n", n);
+    TESTASSERT(test_parallel_cc_sched(n) == SRSRAN_SUCCESS);
+  }
+
   srslog::flush();
 
   return 0;
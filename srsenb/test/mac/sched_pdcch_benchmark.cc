@@ -0,0 +1,123 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "srsenb/hdr/stack/mac/sched_grid.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+
+using namespace srsenb;
+
+static uint32_t nof_prb  = 100;
+static uint32_t nof_ues  = 32;
+static uint32_t nof_ttis = 10000;
+static uint32_t max_dcis = 16;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [pudt]\n", prog);
+  printf("\t-p number of PRBs [Default %d]\n", nof_prb);
+  printf("\t-u number of UEs [Default %d]\n", nof_ues);
+  printf("\t-d maximum number of DCIs per TTI [Default %d]\n", max_dcis);
+  printf("\t-t number of TTIs per number of DCIs [Default %d]\n", nof_ttis);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "p:u:d:t:")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'u':
+        nof_ues = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'd':
+        max_dcis = std::min((uint32_t)strtol(optarg, NULL, 10), 16U);
+        break;
+      case 't':
+        nof_ttis = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/**
+ * Measures the PDCCH allocation rate as the number of DCIs per TTI grows. Every TTI, "nof_dcis" DL/UL DCIs of random
+ * UEs and aggregation levels are allocated, letting the CFI grow from 1 to 3 when the CCEs run out.
+ */
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::cell_cfg_t      cell_cfg   = generate_default_cell_cfg(nof_prb);
+  sched_interface::sched_args_t    sched_args = {};
+  TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+  std::vector<std::unique_ptr<sched_ue> > ues;
+  sched_interface::ue_cfg_t               ue_cfg = generate_default_ue_cfg();
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    ues.emplace_back(new sched_ue(0x46 + i, cell_params, ue_cfg));
+  }
+
+  sf_cch_allocator                        pdcch;
+  std::mt19937                            rgen(0);
+  std::uniform_int_distribution<uint32_t> ue_dist(0, nof_ues - 1), aggr_dist(0, 2), coin(0, 1);
+  pdcch.init(cell_params[0]);
+
+  printf("nof_prb=%u, nof_ues=%u, nof_ttis=%u\n", nof_prb, nof_ues, nof_ttis);
+  for (uint32_t nof_dcis = 1; nof_dcis <= max_dcis; ++nof_dcis) {
+    uint64_t nof_success = 0, nof_cfi = 0;
+    auto     t_start     = std::chrono::steady_clock::now();
+    for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+      pdcch.new_tti(tti_point{tti % 10240});
+      for (uint32_t i = 0; i < nof_dcis; ++i) {
+        sched_ue*    user = ues[ue_dist(rgen)].get();
+        alloc_type_t type = coin(rgen) == 0 ? alloc_type_t::DL_DATA : alloc_type_t::UL_DATA;
+        nof_success += pdcch.alloc_dci(type, aggr_dist(rgen), user, coin(rgen) == 0) ? 1 : 0;
+      }
+      nof_cfi += pdcch.get_cfi();
+    }
+    double elapsed_us =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t_start).count() /
+        1000.0;
+
+    printf("nof_dcis=%2u: %7.3f allocs/us, %5.2f DCIs allocated/TTI, avg CFI=%.2f\n",
+           nof_dcis,
+           (double)nof_ttis * nof_dcis / elapsed_us,
+           (double)nof_success / nof_ttis,
+           (double)nof_cfi / nof_ttis);
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
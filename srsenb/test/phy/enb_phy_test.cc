@@ -1175,6 +1175,7 @@ public:
     uint32_t              period_pcell_rotate = 0;
     srsran_tm_t           tm                  = SRSRAN_TM1;
     bool                  extended_cp         = false;
+    uint32_t              nof_job_threads     = 0;
     args_t()
     {
       cell.nof_prb   = 6;
@@ -1242,7 +1243,8 @@ public:
 
     // PHY arguments
     phy_args.log.phy_level   = args.log_level;
-    phy_args.nof_phy_threads = 1; ///< Set number of phy threads to 1 for avoiding concurrency issues
+    phy_args.nof_phy_threads     = 1; ///< Set number of phy threads to 1 for avoiding concurrency issues
+    phy_args.nof_phy_job_threads = args.nof_job_threads;
 
     // Create cell configuration
     phy_cfg.phy_cell_cfg.resize(args.nof_enb_cells);
@@ -1462,6 +1464,7 @@ int parse_args(int argc, char** argv, phy_test_bench::args_t& args)
       ("cell.cp",        bpo::value<bool>(&args.extended_cp)->default_value(false),                      "use extended CP")
       ("tm", bpo::value<uint32_t>(&args.tm_u32)->default_value(args.tm_u32),                             "Transmission mode")
       ("rotation", bpo::value<uint32_t>(&args.period_pcell_rotate),                      "Serving cells rotation period in ms, set to zero to disable")
+      ("job_threads", bpo::value<uint32_t>(&args.nof_job_threads),                       "Number of threads helping with the carrier jobs of each subframe")
       ;
   options.add(common).add_options()("help", "Show this message");
   // clang-format on
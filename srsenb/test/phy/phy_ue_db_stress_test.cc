@@ -0,0 +1,379 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/phy_ue_db.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <thread>
+
+using namespace srsenb;
+
+static uint32_t nof_workers      = 4;
+static uint32_t nof_ttis         = 4000;
+static uint32_t nof_ues          = 32;
+static uint32_t reconf_period_us = 100;
+
+static const uint32_t nof_cells  = 2;
+static const uint16_t first_rnti = 0x46;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [wtur]\n", prog);
+  printf("\t-w number of PHY workers [Default %d]\n", nof_workers);
+  printf("\t-t number of TTIs [Default %d]\n", nof_ttis);
+  printf("\t-u number of UEs [Default %d]\n", nof_ues);
+  printf("\t-r period of the UE reconfigurations by the stack in microseconds [Default %d]\n", reconf_period_us);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "w:t:u:r:")) != -1) {
+    switch (opt) {
+      case 'w':
+        nof_workers = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 't':
+        nof_ttis = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'u':
+        nof_ues = std::min((uint32_t)strtol(optarg, NULL, 10), 48U);
+        break;
+      case 'r':
+        reconf_period_us = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+class stack_dummy : public stack_interface_phy_lte
+{
+public:
+  int  sr_detected(uint32_t tti, uint16_t rnti) override { return SRSRAN_SUCCESS; }
+  void rach_detected(uint32_t tti, uint32_t primary_cc_idx, uint32_t preamble_idx, uint32_t time_adv) override {}
+  int  ri_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t ri_value) override { return SRSRAN_SUCCESS; }
+  int  pmi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t pmi_value) override { return SRSRAN_SUCCESS; }
+  int  cqi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t cqi_value) override
+  {
+    nof_cqis++;
+    return SRSRAN_SUCCESS;
+  }
+  int sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value) override
+  {
+    nof_cqis++;
+    return SRSRAN_SUCCESS;
+  }
+  int snr_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, float snr_db, ul_channel_t ch) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override { return SRSRAN_SUCCESS; }
+  int ack_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t tb_idx, bool ack) override
+  {
+    nof_acks++;
+    return SRSRAN_SUCCESS;
+  }
+  int crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int push_pdu(uint32_t tti_rx,
+               uint16_t rnti,
+               uint32_t enb_cc_idx,
+               uint32_t nof_bytes,
+               bool     crc_res,
+               uint32_t ul_nof_prbs) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int  get_dl_sched(uint32_t tti, dl_sched_list_t& dl_sched_res) override { return SRSRAN_SUCCESS; }
+  int  get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res) override { return SRSRAN_SUCCESS; }
+  int  get_ul_sched(uint32_t tti, ul_sched_list_t& ul_sched_res) override { return SRSRAN_SUCCESS; }
+  void set_sched_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs) override {}
+
+  std::atomic<uint32_t> nof_acks{0};
+  std::atomic<uint32_t> nof_cqis{0};
+};
+
+using bench_clock = std::chrono::steady_clock;
+
+/// Latencies of the calls to the PHY UE database, which include the time waiting for and holding its locks
+struct call_stats {
+  const char*         name;
+  std::vector<double> latencies_us;
+
+  template <typename F>
+  auto measure(F&& f) -> decltype(f())
+  {
+    auto t_start = bench_clock::now();
+    auto ret     = f();
+    latencies_us.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - t_start).count() / 1000.0);
+    return ret;
+  }
+
+  void merge(const call_stats& other)
+  {
+    latencies_us.insert(latencies_us.end(), other.latencies_us.begin(), other.latencies_us.end());
+  }
+
+  void print()
+  {
+    if (latencies_us.empty()) {
+      return;
+    }
+    std::sort(latencies_us.begin(), latencies_us.end());
+    auto percentile = [this](double p) {
+      return latencies_us[std::min(latencies_us.size() - 1, (size_t)(p * latencies_us.size() / 100.0))];
+    };
+    printf("%-16s calls=%8zu: p50=%6.2f us, p99=%7.2f us, p99.9=%8.2f us, max=%8.1f us\n",
+           name,
+           latencies_us.size(),
+           percentile(50),
+           percentile(99),
+           percentile(99.9),
+           latencies_us.back());
+  }
+};
+
+struct worker_stats {
+  call_stats config{"config getters"};
+  call_stats uci{"UCI fill/send"};
+  call_stats ack{"ACK pending"};
+  call_stats grants{"UL grants/TB"};
+
+  void merge(const worker_stats& other)
+  {
+    config.merge(other.config);
+    uci.merge(other.uci);
+    ack.merge(other.ack);
+    grants.merge(other.grants);
+  }
+};
+
+phy_interface_rrc_lte::phy_rrc_cfg_list_t make_ue_cfg(uint32_t pcell_idx)
+{
+  srsran::phy_cfg_t dedicated = {};
+  dedicated.set_defaults();
+  dedicated.dl_cfg.tm                             = SRSRAN_TM1;
+  dedicated.dl_cfg.cqi_report.periodic_configured = true;
+  dedicated.dl_cfg.cqi_report.pmi_idx             = 25;
+  dedicated.dl_cfg.cqi_report.periodic_mode       = SRSRAN_CQI_MODE_20;
+  dedicated.ul_cfg.pucch.ack_nack_feedback_mode   = SRSRAN_PUCCH_ACK_NACK_FEEDBACK_MODE_CS;
+  dedicated.ul_cfg.pucch.n_rb_2                   = 2;
+  dedicated.ul_cfg.pucch.n_pucch_2                = 5;
+  dedicated.ul_cfg.pucch.simul_cqi_ack            = true;
+  dedicated.ul_cfg.pucch.sr_configured            = true;
+  dedicated.ul_cfg.pucch.I_sr                     = 5;
+
+  phy_interface_rrc_lte::phy_rrc_cfg_list_t cfg_list(nof_cells);
+  for (uint32_t i = 0; i < nof_cells; ++i) {
+    cfg_list[i].configured = true;
+    cfg_list[i].enb_cc_idx = (pcell_idx + i) % nof_cells;
+    cfg_list[i].phy_cfg    = dedicated;
+    cfg_list[i].phy_cfg.dl_cfg.cqi_report.pmi_idx += i;
+    cfg_list[i].phy_cfg.ul_cfg.pucch.sr_configured = (i == 0);
+  }
+  return cfg_list;
+}
+
+/// Emulates the accesses of a sf_worker and its cc_workers to the PHY UE database for one TTI
+void process_tti(phy_ue_db& ue_db, uint32_t tti_rx, worker_stats& stats)
+{
+  uint32_t tti_tx_ul = TTI_RX_ACK(tti_rx);
+
+  // Every UE gets an UL grant every other TTI in one of its cells
+  stack_interface_phy_lte::ul_sched_list_t ul_grants(nof_cells);
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    if ((i + tti_rx) % 2 == 0) {
+      auto& ul_sched                                 = ul_grants[(i + tti_rx / 2) % nof_cells];
+      ul_sched.pusch[ul_sched.nof_grants++].dci.rnti = first_rnti + i;
+    }
+  }
+  stats.grants.measure([&]() { return ue_db.set_ul_grant_available(tti_rx, ul_grants); });
+
+  srsran_uci_value_t uci_value = {};
+  std::fill(std::begin(uci_value.ack.ack_value), std::end(uci_value.ack.ack_value), 1);
+  uci_value.cqi.data_crc = true;
+
+  // UL processing
+  for (uint32_t cc = 0; cc < nof_cells; ++cc) {
+    for (uint32_t i = 0; i < ul_grants[cc].nof_grants; ++i) {
+      uint16_t        rnti   = ul_grants[cc].pusch[i].dci.rnti;
+      uint32_t        pid    = tti_rx % SRSRAN_FDD_NOF_HARQ;
+      srsran_ul_cfg_t ul_cfg = {};
+      srsran_ra_tb_t  tb     = {};
+      if (stats.config.measure([&]() { return ue_db.get_ul_config(rnti, cc, ul_cfg); }) < SRSRAN_SUCCESS) {
+        continue;
+      }
+      int ret = stats.uci.measure(
+          [&]() { return ue_db.fill_uci_cfg(tti_rx, cc, rnti, false, true, ul_cfg.pusch.uci_cfg); });
+      stats.grants.measure([&]() { return ue_db.get_last_ul_tb(rnti, cc, pid, tb); });
+      stats.grants.measure([&]() { return ue_db.set_last_ul_tb(rnti, cc, pid, tb); });
+      if (ret > 0) {
+        stats.uci.measure(
+            [&]() { return ue_db.send_uci_data(tti_rx, rnti, cc, ul_cfg.pusch.uci_cfg, uci_value); });
+      }
+    }
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      uint16_t rnti = first_rnti + i;
+      if (not stats.config.measure([&]() { return ue_db.is_pcell(rnti, cc); })) {
+        continue;
+      }
+      srsran_ul_cfg_t ul_cfg = {};
+      if (stats.config.measure([&]() { return ue_db.get_ul_config(rnti, cc, ul_cfg); }) < SRSRAN_SUCCESS) {
+        continue;
+      }
+      int ret = stats.uci.measure(
+          [&]() { return ue_db.fill_uci_cfg(tti_rx, cc, rnti, false, false, ul_cfg.pucch.uci_cfg); });
+      if (ret > 0) {
+        stats.uci.measure(
+            [&]() { return ue_db.send_uci_data(tti_rx, rnti, cc, ul_cfg.pucch.uci_cfg, uci_value); });
+      }
+    }
+  }
+
+  // DL processing. Every UE gets a DL grant every other TTI in each of its cells
+  stats.ack.measure([&]() {
+    ue_db.clear_tti_pending_ack(tti_tx_ul);
+    return 0;
+  });
+  for (uint32_t cc = 0; cc < nof_cells; ++cc) {
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      if ((i + tti_rx) % 2 != 0) {
+        continue;
+      }
+      srsran_dci_dl_t dci = {};
+      dci.rnti            = first_rnti + i;
+      dci.format          = SRSRAN_DCI_FORMAT1;
+      dci.location.ncce   = i % 8;
+
+      srsran_dci_cfg_t dci_cfg = {};
+      srsran_dl_cfg_t  dl_cfg  = {};
+      if (stats.config.measure([&]() { return ue_db.get_dci_dl_config(dci.rnti, cc, dci_cfg); }) < SRSRAN_SUCCESS or
+          stats.config.measure([&]() { return ue_db.get_dl_config(dci.rnti, cc, dl_cfg); }) < SRSRAN_SUCCESS) {
+        continue;
+      }
+      stats.ack.measure([&]() { return ue_db.set_ack_pending(tti_tx_ul, cc, dci); });
+    }
+  }
+}
+
+void phy_worker(phy_ue_db& ue_db, std::atomic<uint32_t>& next_tti, worker_stats& stats)
+{
+  for (uint32_t tti = next_tti.fetch_add(1); tti < nof_ttis; tti = next_tti.fetch_add(1)) {
+    process_tti(ue_db, tti % 10240, stats);
+  }
+}
+
+/**
+ * Stresses the PHY UE database with several PHY workers processing consecutive TTIs in parallel, while the stack
+ * thread keeps reconfiguring and re-attaching UEs. Prints the latencies of the calls to the database, which account
+ * for the time spent waiting for and holding its locks.
+ */
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::fetch_basic_logger("PHY").set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  stack_dummy         stack;
+  phy_args_t          phy_args = {};
+  phy_cell_cfg_list_t cell_list(nof_cells);
+  for (uint32_t i = 0; i < nof_cells; ++i) {
+    cell_list[i].cell           = {};
+    cell_list[i].cell.nof_prb   = 25;
+    cell_list[i].cell.nof_ports = 1;
+    cell_list[i].cell.id        = i;
+    cell_list[i].cell.cp        = SRSRAN_CP_NORM;
+  }
+
+  phy_ue_db ue_db;
+  ue_db.init(&stack, phy_args, cell_list);
+  std::array<bool, SRSRAN_MAX_CARRIERS> activation = {};
+  activation.fill(true);
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    ue_db.addmod_rnti(first_rnti + i, make_ue_cfg(i % nof_cells));
+    TESTASSERT(ue_db.complete_config(first_rnti + i) == SRSRAN_SUCCESS);
+    TESTASSERT(ue_db.activate_deactivate_scell(first_rnti + i, 1, true) == SRSRAN_SUCCESS);
+  }
+
+  std::atomic<uint32_t>     next_tti{0};
+  std::vector<worker_stats> stats(nof_workers);
+  std::vector<std::thread>  workers;
+  auto                      t_start = bench_clock::now();
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    workers.emplace_back(phy_worker, std::ref(ue_db), std::ref(next_tti), std::ref(stats[i]));
+  }
+
+  // Stack thread: reconfigures UEs, and re-attaches one UE every 10 reconfigurations
+  call_stats stack_stats{"stack reconfig"};
+  uint32_t   nof_reconfs = 0;
+  while (next_tti.load(std::memory_order_relaxed) < nof_ttis) {
+    std::this_thread::sleep_for(std::chrono::microseconds(reconf_period_us));
+    uint16_t rnti = first_rnti + nof_reconfs % nof_ues;
+    stack_stats.measure([&]() {
+      if (nof_reconfs % 10 == 0) {
+        ue_db.rem_rnti(rnti);
+      }
+      ue_db.addmod_rnti(rnti, make_ue_cfg(nof_reconfs % nof_cells));
+      ue_db.complete_config(rnti);
+      return ue_db.activate_deactivate_scell(rnti, 1, true);
+    });
+    nof_reconfs++;
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  double elapsed_ms =
+      std::chrono::duration_cast<std::chrono::microseconds>(bench_clock::now() - t_start).count() / 1000.0;
+
+  for (uint32_t i = 1; i < nof_workers; ++i) {
+    stats[0].merge(stats[i]);
+  }
+  printf("workers=%u, ttis=%u, ues=%u, reconfigs=%u: %.1f TTIs/ms\n",
+         nof_workers,
+         nof_ttis,
+         nof_ues,
+         nof_reconfs,
+         nof_ttis / elapsed_ms);
+  stats[0].config.print();
+  stats[0].uci.print();
+  stats[0].ack.print();
+  stats[0].grants.print();
+  stack_stats.print();
+
+  // All UEs must still be attached and configured, and their UCI must have been reported to the stack
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    TESTASSERT(ue_db.ue_has_cell(first_rnti + i, 0) and ue_db.ue_has_cell(first_rnti + i, 1));
+  }
+  TESTASSERT(stack.nof_acks > 0);
+  TESTASSERT(stack.nof_cqis > 0);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
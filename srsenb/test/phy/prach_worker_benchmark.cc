@@ -0,0 +1,216 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/prach_worker.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/enb_mac_interfaces.h"
+#include "srsran/phy/utils/vector.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <getopt.h>
+#include <mutex>
+
+using namespace srsenb;
+
+static uint32_t nof_prb       = 25;
+static uint32_t nof_workers   = 4;
+static uint32_t nof_occasions = 20;
+
+// Preambles transmitted in every PRACH occasion. With 64 preambles, they belong to different roots unless only one
+// root is used
+static const std::vector<uint32_t> tx_preambles = {5, 37, 63};
+
+void usage(char* prog)
+{
+  printf("Usage: %s [pwn]\n", prog);
+  printf("\t-p number of PRB [Default %d]\n", nof_prb);
+  printf("\t-w number of PRACH workers compared against a single worker [Default %d]\n", nof_workers);
+  printf("\t-n number of PRACH occasions [Default %d]\n", nof_occasions);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "p:w:n:")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'w':
+        nof_workers = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        nof_occasions = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+class stack_dummy : public stack_interface_phy_lte
+{
+public:
+  int  sr_detected(uint32_t tti, uint16_t rnti) override { return SRSRAN_SUCCESS; }
+  void rach_detected(uint32_t tti, uint32_t primary_cc_idx, uint32_t preamble_idx, uint32_t time_adv) override
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    preambles.push_back(preamble_idx);
+    cvar.notify_one();
+  }
+  int ri_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t ri_value) override { return SRSRAN_SUCCESS; }
+  int pmi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t pmi_value) override { return SRSRAN_SUCCESS; }
+  int cqi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t cqi_value) override { return SRSRAN_SUCCESS; }
+  int sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int snr_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, float snr_db, ul_channel_t ch) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override { return SRSRAN_SUCCESS; }
+  int ack_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t tb_idx, bool ack) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int push_pdu(uint32_t tti_rx,
+               uint16_t rnti,
+               uint32_t enb_cc_idx,
+               uint32_t nof_bytes,
+               bool     crc_res,
+               uint32_t ul_nof_prbs) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int  get_dl_sched(uint32_t tti, dl_sched_list_t& dl_sched_res) override { return SRSRAN_SUCCESS; }
+  int  get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res) override { return SRSRAN_SUCCESS; }
+  int  get_ul_sched(uint32_t tti, ul_sched_list_t& ul_sched_res) override { return SRSRAN_SUCCESS; }
+  void set_sched_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs) override {}
+
+  /// Waits for the detection of a number of preambles and returns them
+  std::vector<uint32_t> wait_preambles(uint32_t nof_preambles)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cvar.wait_for(lock, std::chrono::seconds(1), [this, nof_preambles]() { return preambles.size() >= nof_preambles; });
+    std::vector<uint32_t> ret;
+    std::swap(ret, preambles);
+    return ret;
+  }
+
+private:
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  std::vector<uint32_t>   preambles;
+};
+
+using bench_clock = std::chrono::steady_clock;
+
+/// Feeds PRACH occasions to a worker and measures the time until all the transmitted preambles are reported
+static int run_benchmark(srsran_cell_t&      cell,
+                         srsran_prach_cfg_t& prach_cfg,
+                         uint32_t            workers,
+                         uint32_t&           nof_roots,
+                         double&             latency_us)
+{
+  srsran_prach_t prach = {};
+  TESTASSERT(srsran_prach_init(&prach, srsran_symbol_sz(nof_prb)) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_prach_set_cfg(&prach, &prach_cfg, nof_prb) == SRSRAN_SUCCESS);
+  nof_roots = prach.num_ra_preambles;
+
+  // Build the received subframe, with all the preambles aligned
+  uint32_t          sf_len = SRSRAN_SF_LEN_PRB(nof_prb);
+  std::vector<cf_t> sf_buffer(sf_len);
+  std::vector<cf_t> preamble(sf_len);
+  for (uint32_t idx : tx_preambles) {
+    TESTASSERT(srsran_prach_gen(&prach, idx, prach_cfg.freq_offset, preamble.data()) == SRSRAN_SUCCESS);
+    srsran_vec_sum_ccc(sf_buffer.data(), preamble.data(), sf_buffer.data(), prach.N_cp + prach.N_seq);
+  }
+
+  stack_dummy  stack;
+  prach_worker worker(0, 8, srslog::fetch_basic_logger("PHY"));
+  TESTASSERT(worker.init(cell, prach_cfg, &stack, -1, workers) == SRSRAN_SUCCESS);
+
+  double   total_us = 0;
+  uint32_t count    = 0;
+  for (uint32_t tti = 0; count < nof_occasions; tti++) {
+    if (not srsran_prach_tti_opportunity(&prach, tti, -1)) {
+      continue;
+    }
+    bench_clock::time_point t_start = bench_clock::now();
+    TESTASSERT(worker.new_tti(tti, sf_buffer.data()) == SRSRAN_SUCCESS);
+    std::vector<uint32_t> preambles = stack.wait_preambles(tx_preambles.size());
+    total_us += std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - t_start).count() / 1000.0;
+
+    // The detections must not depend on the number of workers
+    std::sort(preambles.begin(), preambles.end());
+    TESTASSERT(preambles == tx_preambles);
+    count++;
+  }
+  latency_us = total_us / nof_occasions;
+
+  worker.stop();
+  srsran_prach_free(&prach);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::fetch_basic_logger("PHY").set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  srsran_cell_t cell = {};
+  cell.nof_prb       = nof_prb;
+  cell.nof_ports     = 1;
+  cell.cp            = SRSRAN_CP_NORM;
+
+  srsran_prach_cfg_t prach_cfg = {};
+  prach_cfg.config_idx         = 0;
+  prach_cfg.root_seq_idx       = 3;
+  prach_cfg.freq_offset        = 4;
+  prach_cfg.num_ra_preambles   = 64;
+
+  // The zero correlation zone configuration sets the number of roots needed for the 64 preambles
+  printf("-- PRACH worker benchmark. nof_prb=%d; occasions=%d\n", nof_prb, nof_occasions);
+  for (uint32_t zczc : {1, 8, 12, 15, 0}) {
+    prach_cfg.zero_corr_zone = zczc;
+    for (uint32_t workers : {1U, nof_workers}) {
+      uint32_t nof_roots  = 0;
+      double   latency_us = 0;
+      TESTASSERT(run_benchmark(cell, prach_cfg, workers, nof_roots, latency_us) == SRSRAN_SUCCESS);
+      printf("zczc=%-2d roots=%-2d workers=%d: detection latency %7.1f us\n", zczc, nof_roots, workers, latency_us);
+      if (nof_workers == 1) {
+        break;
+      }
+    }
+  }
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
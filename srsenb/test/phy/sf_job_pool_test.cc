@@ -0,0 +1,169 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/lte/sf_job_pool.h"
+#include "srsran/common/test_common.h"
+#include <atomic>
+#include <thread>
+
+using namespace srsenb::lte;
+
+using sf_clock = sf_job_pool::sf_clock;
+
+// Without helper threads, a waiting worker runs the queued jobs itself, the most urgent subframe first
+int test_deadline_order()
+{
+  sf_job_pool pool(srslog::fetch_basic_logger("PHY"));
+  pool.init(0, -1);
+
+  sf_clock::time_point   now = sf_clock::now();
+  sf_job_pool::job_group late_sf(1, now + std::chrono::milliseconds(2));
+  sf_job_pool::job_group urgent_sf(0, now + std::chrono::milliseconds(1));
+
+  std::vector<uint32_t> order;
+  for (uint32_t i = 0; i < 3; i++) {
+    pool.push_job(late_sf, [&order, i]() { order.push_back(10 + i); });
+  }
+  for (uint32_t i = 0; i < 3; i++) {
+    pool.push_job(urgent_sf, [&order, i]() { order.push_back(i); });
+  }
+  pool.wait(late_sf);
+  TESTASSERT(order == std::vector<uint32_t>({0, 1, 2, 10, 11, 12}));
+
+  // The jobs of the urgent subframe were executed by the owner of the other subframe
+  pool.wait(urgent_sf);
+  srsenb::phy_sched_metrics_t metrics = {};
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_jobs == 6);
+  TESTASSERT(metrics.nof_stolen_jobs == 3);
+  TESTASSERT(metrics.nof_late_jobs == 0);
+
+  pool.stop();
+  return SRSRAN_SUCCESS;
+}
+
+// A waiting worker does not run the jobs of subframes with a later deadline than its own
+int test_no_later_jobs()
+{
+  sf_job_pool pool(srslog::fetch_basic_logger("PHY"));
+  pool.init(0, -1);
+
+  sf_clock::time_point   now = sf_clock::now();
+  sf_job_pool::job_group late_sf(1, now + std::chrono::milliseconds(2));
+  sf_job_pool::job_group urgent_sf(0, now + std::chrono::milliseconds(1));
+
+  std::vector<uint32_t> order;
+  for (uint32_t i = 0; i < 3; i++) {
+    pool.push_job(late_sf, [&order, i]() { order.push_back(10 + i); });
+    pool.push_job(urgent_sf, [&order, i]() { order.push_back(i); });
+  }
+  pool.wait(urgent_sf);
+  TESTASSERT(order == std::vector<uint32_t>({0, 1, 2}));
+  pool.wait(late_sf);
+  TESTASSERT(order == std::vector<uint32_t>({0, 1, 2, 10, 11, 12}));
+
+  // Every subframe was processed by its own worker
+  srsenb::phy_sched_metrics_t metrics = {};
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_jobs == 6);
+  TESTASSERT(metrics.nof_stolen_jobs == 0);
+
+  pool.stop();
+  return SRSRAN_SUCCESS;
+}
+
+// Helper threads run the jobs concurrently with the subframe owner
+int test_helpers()
+{
+  const uint32_t nof_jobs = 16;
+
+  sf_job_pool pool(srslog::fetch_basic_logger("PHY"));
+  pool.init(3, -1);
+
+  std::atomic<uint32_t>  count = {0};
+  sf_job_pool::job_group sf(0, sf_clock::now() + sf_job_pool::tx_budget);
+  for (uint32_t i = 0; i < nof_jobs; i++) {
+    pool.push_job(sf, [&count]() {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      count++;
+    });
+  }
+  pool.wait(sf);
+  TESTASSERT(count == nof_jobs);
+
+  // Jobs run by the helpers do not count as stolen
+  srsenb::phy_sched_metrics_t metrics = {};
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_jobs == nof_jobs);
+  TESTASSERT(metrics.nof_stolen_jobs == 0);
+
+  pool.stop();
+  return SRSRAN_SUCCESS;
+}
+
+// Subframes finishing after their deadline are counted as late and their latency is accounted in the histogram
+int test_late_ttis()
+{
+  sf_job_pool pool(srslog::fetch_basic_logger("PHY"));
+  pool.init(1, -1);
+
+  sf_clock::time_point now = sf_clock::now();
+  for (uint32_t i = 0; i < 4; i++) {
+    sf_job_pool::job_group sf(i, now + sf_job_pool::tx_budget);
+    pool.push_job(sf, []() {});
+    pool.wait(sf);
+    pool.tti_finished(sf, now);
+  }
+  sf_job_pool::job_group late_sf(4, now - std::chrono::milliseconds(1));
+  pool.push_job(late_sf, []() {});
+  pool.wait(late_sf);
+  pool.tti_finished(late_sf, now - std::chrono::milliseconds(4));
+
+  srsenb::phy_sched_metrics_t metrics = {};
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_ttis == 5);
+  TESTASSERT(metrics.nof_late_ttis == 1);
+  TESTASSERT(metrics.nof_late_jobs == 1);
+  TESTASSERT(metrics.min_slack_us < -1000);
+  TESTASSERT(metrics.latency_hist[0] == 4);
+  TESTASSERT(metrics.latency_hist[srsenb::phy_sched_metrics_t::nof_latency_bins - 1] == 1);
+
+  // Metrics are reset after being read
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_ttis == 0 and metrics.nof_jobs == 0);
+
+  pool.stop();
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_deadline_order() == SRSRAN_SUCCESS);
+  TESTASSERT(test_no_later_jobs() == SRSRAN_SUCCESS);
+  TESTASSERT(test_helpers() == SRSRAN_SUCCESS);
+  TESTASSERT(test_late_ttis() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,428 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/upper/pdcp_sharded.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/enb_rlc_interfaces.h"
+#include <chrono>
+#include <getopt.h>
+#include <limits>
+#include <thread>
+
+using namespace srsenb;
+
+static uint32_t nof_ues     = 16;
+static uint32_t nof_sdus    = 500;
+static uint32_t sdu_len     = 1500;
+static uint32_t nof_shards  = 4;
+static uint16_t first_rnti  = 0x46;
+static uint32_t drb_lcid    = 3;
+static uint32_t max_nof_ues = 256;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [unsw]\n", prog);
+  printf("\t-u number of UEs [Default %d]\n", nof_ues);
+  printf("\t-n number of DL SDUs per UE [Default %d]\n", nof_sdus);
+  printf("\t-s SDU size in bytes [Default %d]\n", sdu_len);
+  printf("\t-w maximum number of UE shards the load is measured with [Default %d]\n", nof_shards);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "u:n:s:w:")) != -1) {
+    switch (opt) {
+      case 'u':
+        nof_ues = std::min((uint32_t)strtol(optarg, NULL, 10), max_nof_ues);
+        break;
+      case 'n':
+        nof_sdus = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        sdu_len = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'w':
+        nof_shards = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// RLC sink checking that the PDUs of each UE are generated in order and always by the same thread
+class rlc_dummy : public rlc_interface_pdcp
+{
+public:
+  rlc_dummy() : ues(max_nof_ues) {}
+
+  void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) override
+  {
+    ue_ctxt& ue = ues[rnti - first_rnti];
+    uint32_t sn = ((sdu->msg[0] & 0x0fu) << 8u) | sdu->msg[1];
+    if (ue.nof_pdus == 0) {
+      ue.thread_id = std::this_thread::get_id();
+    }
+    ue.in_order &= (sn == (ue.nof_pdus % 4096)) and (ue.thread_id == std::this_thread::get_id());
+    ue.nof_pdus++;
+  }
+  void     discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t sn) override {}
+  bool     rb_is_um(uint16_t rnti, uint32_t lcid) override { return true; }
+  bool     sdu_queue_is_full(uint16_t rnti, uint32_t lcid) override { return false; }
+  uint32_t sdu_queue_free_space(uint16_t rnti, uint32_t lcid) override { return std::numeric_limits<uint32_t>::max(); }
+  bool     is_suspended(uint16_t rnti, uint32_t lcid) override { return false; }
+
+  // Each UE is only accessed by the thread of its shard
+  struct ue_ctxt {
+    uint32_t        nof_pdus = 0;
+    bool            in_order = true;
+    std::thread::id thread_id;
+  };
+  std::vector<ue_ctxt> ues;
+};
+
+class rrc_dummy : public rrc_interface_pdcp
+{
+public:
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override
+  {
+    stack_thread_only &= (std::this_thread::get_id() == stack_thread_id);
+    nof_pdus++;
+  }
+  void notify_pdcp_integrity_error(uint16_t rnti, uint32_t lcid) override {}
+
+  std::thread::id stack_thread_id   = std::this_thread::get_id();
+  bool            stack_thread_only = true;
+  uint32_t        nof_pdus          = 0;
+};
+
+class gtpu_dummy : public gtpu_interface_pdcp
+{
+public:
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override
+  {
+    stack_thread_only &= (std::this_thread::get_id() == stack_thread_id);
+    nof_pdus++;
+  }
+
+  std::thread::id stack_thread_id   = std::this_thread::get_id();
+  bool            stack_thread_only = true;
+  uint32_t        nof_pdus          = 0;
+};
+
+srsran::as_security_config_t make_sec_cfg()
+{
+  srsran::as_security_config_t sec_cfg = {};
+  for (uint32_t i = 0; i < sec_cfg.k_up_enc.size(); i++) {
+    sec_cfg.k_up_enc[i]  = (uint8_t)i;
+    sec_cfg.k_rrc_enc[i] = (uint8_t)i;
+  }
+  sec_cfg.integ_algo  = srsran::INTEGRITY_ALGORITHM_ID_EIA0;
+  sec_cfg.cipher_algo = srsran::CIPHERING_ALGORITHM_ID_128_EEA2;
+  return sec_cfg;
+}
+
+srsran::pdcp_config_t make_drb_cfg()
+{
+  return {1,
+          srsran::PDCP_RB_IS_DRB,
+          srsran::SECURITY_DIRECTION_DOWNLINK,
+          srsran::SECURITY_DIRECTION_UPLINK,
+          srsran::PDCP_SN_LEN_12,
+          srsran::pdcp_t_reordering_t::ms500,
+          srsran::pdcp_discard_timer_t::infinity,
+          false,
+          srsran::srsran_rat_t::lte};
+}
+
+srsran::pdcp_config_t make_srb_cfg()
+{
+  return {1,
+          srsran::PDCP_RB_IS_SRB,
+          srsran::SECURITY_DIRECTION_DOWNLINK,
+          srsran::SECURITY_DIRECTION_UPLINK,
+          srsran::PDCP_SN_LEN_5,
+          srsran::pdcp_t_reordering_t::ms500,
+          srsran::pdcp_discard_timer_t::infinity,
+          false,
+          srsran::srsran_rat_t::lte};
+}
+
+srsran::unique_byte_buffer_t make_sdu(uint32_t len)
+{
+  srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+  if (sdu != nullptr) {
+    for (uint32_t i = 0; i < len; i++) {
+      sdu->msg[i] = (uint8_t)i;
+    }
+    sdu->N_bytes = len;
+  }
+  return sdu;
+}
+
+/// Sets up the UEs of the test, each one with a ciphered DRB
+void add_ues(pdcp_sharded& pdcp, uint32_t nof_ues_)
+{
+  for (uint32_t i = 0; i < nof_ues_; i++) {
+    uint16_t rnti = first_rnti + i;
+    pdcp.add_user(rnti);
+    pdcp.add_bearer(rnti, drb_lcid, make_drb_cfg());
+    pdcp.config_security(rnti, drb_lcid, make_sec_cfg());
+    pdcp.enable_encryption(rnti, drb_lcid);
+  }
+}
+
+/// Waits for the shards to handle all the tasks pushed so far
+void wait_shards(ue_shard_pool& shards)
+{
+  for (uint32_t i = 0; i < shards.size(); i++) {
+    shards.run_sync(i, []() {});
+  }
+}
+
+// The calls for a UE are executed in order by the thread of its shard, and the output towards RRC and GTP-U is handled
+// by the stack thread
+int test_ue_sharding()
+{
+  srsran::task_scheduler stack_sched;
+  ue_shard_pool          shards(srslog::fetch_basic_logger("STCK"));
+  shards.init(3, -1, 16);
+
+  rlc_dummy    rlc;
+  rrc_dummy    rrc;
+  gtpu_dummy   gtpu;
+  pdcp_sharded pdcp(shards, &stack_sched, srslog::fetch_basic_logger("PDCP"));
+  pdcp.init(&rlc, &rrc, &gtpu);
+  add_ues(pdcp, 6);
+
+  // DL
+  for (uint32_t n = 0; n < 20; n++) {
+    for (uint32_t i = 0; i < 6; i++) {
+      pdcp.write_sdu(first_rnti + i, drb_lcid, make_sdu(100));
+    }
+  }
+  std::vector<srsran::unique_byte_buffer_t> batch;
+  for (uint32_t n = 0; n < 5; n++) {
+    batch.push_back(make_sdu(100));
+  }
+  pdcp.write_sdu_batch(first_rnti, drb_lcid, batch);
+  TESTASSERT(batch.empty());
+
+  srsran::pdcp_lte_state_t state = {};
+  TESTASSERT(pdcp.get_bearer_state(first_rnti, drb_lcid, &state));
+  TESTASSERT(state.next_pdcp_tx_sn == 25);
+  TESTASSERT(not pdcp.get_bearer_state(first_rnti + 10, drb_lcid, &state));
+
+  wait_shards(shards);
+  for (uint32_t i = 0; i < 6; i++) {
+    TESTASSERT(rlc.ues[i].nof_pdus == (i == 0 ? 25 : 20));
+    TESTASSERT(rlc.ues[i].in_order);
+  }
+  TESTASSERT(rlc.ues[0].thread_id != rlc.ues[1].thread_id);
+  TESTASSERT(rlc.ues[0].thread_id == rlc.ues[3].thread_id);
+
+  // UL, for a UE without security. The PDUs reach GTP-U and RRC in the stack thread
+  uint16_t rnti = first_rnti + 7;
+  pdcp.add_user(rnti);
+  pdcp.add_bearer(rnti, drb_lcid, make_drb_cfg());
+  pdcp.add_bearer(rnti, 1, make_srb_cfg());
+  for (uint32_t sn = 0; sn < 4; sn++) {
+    srsran::unique_byte_buffer_t pdu = make_sdu(50);
+    pdu->msg[0]                      = 0x80;
+    pdu->msg[1]                      = (uint8_t)sn;
+    pdcp.write_pdu(rnti, drb_lcid, std::move(pdu));
+  }
+  srsran::unique_byte_buffer_t srb_pdu = make_sdu(20);
+  srb_pdu->msg[0]                      = 0;
+  pdcp.write_pdu(rnti, 1, std::move(srb_pdu));
+  wait_shards(shards);
+  stack_sched.run_pending_tasks();
+  TESTASSERT(gtpu.nof_pdus == 4);
+  TESTASSERT(gtpu.stack_thread_only);
+  TESTASSERT(rrc.nof_pdus == 1);
+  TESTASSERT(rrc.stack_thread_only);
+
+  // Metrics are reported for every UE, in RNTI order
+  pdcp_metrics_t metrics;
+  pdcp.get_metrics(metrics, 1000);
+  TESTASSERT(metrics.ues.size() == 7);
+  TESTASSERT(metrics.ues[0].bearer[drb_lcid].num_tx_pdus == 25);
+  TESTASSERT(metrics.ues[6].bearer[drb_lcid].num_rx_pdus == 4);
+
+  pdcp.stop();
+  shards.stop();
+  return SRSRAN_SUCCESS;
+}
+
+// When the stack thread falls behind, the UL data is dropped and counted, but the messages towards RRC are all delivered
+int test_ul_overload()
+{
+  const uint32_t ul_queue_size = 4, nof_drb_pdus = 10, nof_srb_pdus = 3;
+
+  srsran::task_scheduler stack_sched;
+  ue_shard_pool          shards(srslog::fetch_basic_logger("STCK"));
+  shards.init(2, -1, 16);
+
+  rlc_dummy    rlc;
+  rrc_dummy    rrc;
+  gtpu_dummy   gtpu;
+  pdcp_sharded pdcp(shards, &stack_sched, srslog::fetch_basic_logger("PDCP"), ul_queue_size);
+  pdcp.init(&rlc, &rrc, &gtpu);
+
+  uint16_t rnti = first_rnti;
+  pdcp.add_user(rnti);
+  pdcp.add_bearer(rnti, drb_lcid, make_drb_cfg());
+  pdcp.add_bearer(rnti, 1, make_srb_cfg());
+  for (uint32_t sn = 0; sn < nof_drb_pdus; sn++) {
+    srsran::unique_byte_buffer_t pdu = make_sdu(50);
+    pdu->msg[0]                      = 0x80;
+    pdu->msg[1]                      = (uint8_t)sn;
+    pdcp.write_pdu(rnti, drb_lcid, std::move(pdu));
+  }
+  for (uint32_t sn = 0; sn < nof_srb_pdus; sn++) {
+    srsran::unique_byte_buffer_t pdu = make_sdu(20);
+    pdu->msg[0]                      = (uint8_t)sn;
+    pdcp.write_pdu(rnti, 1, std::move(pdu));
+  }
+  wait_shards(shards);
+  stack_sched.run_pending_tasks();
+  TESTASSERT(gtpu.nof_pdus == ul_queue_size);
+  TESTASSERT(pdcp.get_nof_dropped_ul_pdus() == nof_drb_pdus - ul_queue_size);
+  TESTASSERT(rrc.nof_pdus == nof_srb_pdus);
+  TESTASSERT(rrc.stack_thread_only);
+
+  pdcp.stop();
+  shards.stop();
+  return SRSRAN_SUCCESS;
+}
+
+// Tasks pushed while the pool is stopped are never lost, they run either in the shard or in the caller
+int test_push_during_stop()
+{
+  for (uint32_t n = 0; n < 20; n++) {
+    ue_shard_pool shards(srslog::fetch_basic_logger("STCK"));
+    shards.init(2, -1, 16);
+
+    std::atomic<uint32_t> nof_done = {0};
+    std::thread           pusher([&shards, &nof_done]() {
+      for (uint32_t i = 0; i < 1000; i++) {
+        shards.run_sync(i % 2, [&nof_done]() { nof_done++; });
+      }
+    });
+    shards.stop();
+    pusher.join();
+    TESTASSERT(nof_done == 1000);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// Each shard steps its own timers, in its own thread
+int test_shard_timers()
+{
+  ue_shard_pool shards(srslog::fetch_basic_logger("STCK"));
+  shards.init(2, -1, 16);
+
+  std::thread::id expired_thread[2];
+  std::thread::id shard_thread[2];
+  for (uint32_t i = 0; i < 2; i++) {
+    srsran::task_sched_handle sched = shards.get_task_sched(i);
+    std::thread::id*          id    = &expired_thread[i];
+    shards.run_sync(i, [sched, id]() mutable { sched.defer_callback(2, [id]() { *id = std::this_thread::get_id(); }); });
+    shards.run_sync(i, [&shard_thread, i]() { shard_thread[i] = std::this_thread::get_id(); });
+  }
+
+  shards.tti_clock();
+  wait_shards(shards);
+  TESTASSERT(expired_thread[0] == std::thread::id() and expired_thread[1] == std::thread::id());
+  shards.tti_clock();
+  wait_shards(shards);
+  TESTASSERT(expired_thread[0] == shard_thread[0]);
+  TESTASSERT(expired_thread[1] == shard_thread[1]);
+  TESTASSERT(shard_thread[0] != shard_thread[1]);
+
+  shards.stop();
+  return SRSRAN_SUCCESS;
+}
+
+using bench_clock = std::chrono::steady_clock;
+
+/// Pushes the DL traffic of all the UEs from the stack thread and measures the time until the shards have processed it
+int run_load(uint32_t shards_, double& rate_mbps)
+{
+  srsran::task_scheduler stack_sched;
+  ue_shard_pool          shards(srslog::fetch_basic_logger("STCK"));
+  shards.init(shards_, -1, 16);
+
+  rlc_dummy    rlc;
+  rrc_dummy    rrc;
+  gtpu_dummy   gtpu;
+  pdcp_sharded pdcp(shards, &stack_sched, srslog::fetch_basic_logger("PDCP"));
+  pdcp.init(&rlc, &rrc, &gtpu);
+  add_ues(pdcp, nof_ues);
+  wait_shards(shards);
+
+  bench_clock::time_point t_start = bench_clock::now();
+  for (uint32_t n = 0; n < nof_sdus; n++) {
+    for (uint32_t i = 0; i < nof_ues; i++) {
+      srsran::unique_byte_buffer_t sdu = make_sdu(sdu_len);
+      TESTASSERT(sdu != nullptr);
+      pdcp.write_sdu(first_rnti + i, drb_lcid, std::move(sdu));
+    }
+  }
+  wait_shards(shards);
+  double elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(bench_clock::now() - t_start).count();
+  rate_mbps         = (8.0 * sdu_len * nof_sdus * nof_ues) / elapsed_us;
+
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    TESTASSERT(rlc.ues[i].nof_pdus == nof_sdus);
+    TESTASSERT(rlc.ues[i].in_order);
+  }
+
+  pdcp.stop();
+  shards.stop();
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::fetch_basic_logger("PDCP").set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("STCK").set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  TESTASSERT(test_ue_sharding() == SRSRAN_SUCCESS);
+  TESTASSERT(test_ul_overload() == SRSRAN_SUCCESS);
+  TESTASSERT(test_push_during_stop() == SRSRAN_SUCCESS);
+  TESTASSERT(test_shard_timers() == SRSRAN_SUCCESS);
+
+  printf("-- UE shard load. UEs=%d; SDUs per UE=%d; SDU size=%d\n", nof_ues, nof_sdus, sdu_len);
+  for (uint32_t shards = 1; shards <= nof_shards; shards *= 2) {
+    double rate_mbps = 0;
+    TESTASSERT(run_load(shards, rate_mbps) == SRSRAN_SUCCESS);
+    printf("shards=%d: DL PDCP throughput %8.1f Mbps\n", shards, rate_mbps);
+  }
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -23,13 +23,20 @@
 #define SRSEPC_GTPU_H
 
 #include "srsepc/hdr/spgw/spgw.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
 #include <queue>
+#include <sys/socket.h>
 
 namespace srsepc {
 
@@ -46,6 +53,16 @@ public:
   int get_sgi();
   int get_s1u();
 
+  // Data plane. S1-U and SGi are each drained by a dedicated thread
+  int  start_data_plane();
+  void stop_data_plane();
+  void handle_s1u_burst();
+  void handle_sgi_burst();
+
+  // SGi PDUs that the data plane cannot forward (e.g. UE in ECM-IDLE) are handed over to the control plane thread
+  int  get_sgi_ctrl_fd();
+  void handle_sgi_ctrl_pdus();
+
   void handle_sgi_pdu(srsran::unique_byte_buffer_t msg);
   void handle_s1u_pdu(srsran::byte_buffer_t* msg);
   void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
@@ -68,10 +85,38 @@ public:
   int         m_s1u;
   sockaddr_in m_s1u_addr;
 
-  std::map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
-  std::map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
-                                                             // UE is attached without an active user-plane
-                                                             // for downlink notifications.
+  // Tunnels of an UE IP. The control TEID is important to check if the UE is attached without an active user-plane
+  // for downlink notifications.
+  struct ue_tunnel_t {
+    bool                usr_found = false;
+    srsran::gtp_fteid_t usr_fteid = {}; // User-plane F-TEID of the eNB for downlink traffic
+    bool                ctr_found = false;
+    uint32_t            ctr_teid  = 0;
+  };
+  std::mutex                                    m_tunnel_mutex; // protects the tunnel table, shared with the data plane
+  srsran::flat_hash_map<in_addr_t, ue_tunnel_t> m_ue_tunnels;
+
+  // Maximum number of PDUs read from S1-U or SGi in one go
+  static const uint32_t max_burst = 32;
+
+  class dp_worker;
+  std::atomic<bool>                        m_dp_running = {false};
+  int                                      m_dp_stop_fd = -1;
+  std::vector<std::unique_ptr<dp_worker> > m_dp_workers;
+
+  // Burst buffers, each set only accessed by its data plane thread
+  std::array<srsran::unique_byte_buffer_t, max_burst> m_s1u_bufs;
+  std::array<mmsghdr, max_burst>                      m_s1u_msgs;
+  std::array<iovec, max_burst>                        m_s1u_iovs;
+  std::array<srsran::unique_byte_buffer_t, max_burst> m_sgi_bufs;
+  std::array<mmsghdr, max_burst>                      m_sgi_msgs;
+  std::array<iovec, max_burst>                        m_sgi_iovs;
+  std::array<sockaddr_in, max_burst>                  m_sgi_dst;
+
+  // SGi PDUs pending to be handled by the control plane thread
+  std::mutex                               m_sgi_ctrl_mutex;
+  std::queue<srsran::unique_byte_buffer_t> m_sgi_ctrl_pdus;
+  int                                      m_sgi_ctrl_fd = -1;
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
 };
@@ -86,6 +131,11 @@ inline int spgw::gtpu::get_s1u()
   return m_s1u;
 }
 
+inline int spgw::gtpu::get_sgi_ctrl_fd()
+{
+  return m_sgi_ctrl_fd;
+}
+
 inline in_addr_t spgw::gtpu::get_s1u_addr()
 {
   return m_s1u_addr.sin_addr.s_addr;
@@ -32,6 +32,8 @@
 #include <linux/if_tun.h>
 #include <linux/ip.h>
 #include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 
@@ -76,6 +78,13 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
     return err;
   }
 
+  // Start S1-U and SGi threads
+  err = start_data_plane();
+  if (err != SRSRAN_SUCCESS) {
+    srsran::console("Could not start the SPGW's user-plane.\n");
+    return err;
+  }
+
   m_logger.info("SPGW GTP-U Initialized.");
   srsran::console("SPGW GTP-U Initialized.\n");
   return SRSRAN_SUCCESS;
@@ -83,6 +92,8 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
 
 void spgw::gtpu::stop()
 {
+  stop_data_plane();
+
   // Clean up SGi interface
   if (m_sgi_up) {
     close(m_sgi);
@@ -203,16 +214,262 @@ int spgw::gtpu::init_s1u(spgw_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
+/*
+ * Data plane
+ */
+class spgw::gtpu::dp_worker final : public srsran::thread
+{
+public:
+  dp_worker(gtpu* parent_, int fd_, void (gtpu::*handler_)(), const std::string& name) :
+    thread(name), parent(parent_), fd(fd_), handler(handler_)
+  {}
+
+  void run_thread() override
+  {
+    std::array<pollfd, 2> pfds = {};
+    pfds[0].fd                 = fd;
+    pfds[0].events             = POLLIN;
+    pfds[1].fd                 = parent->m_dp_stop_fd;
+    pfds[1].events             = POLLIN;
+    while (parent->m_dp_running.load(std::memory_order_relaxed)) {
+      int n = poll(pfds.data(), pfds.size(), -1);
+      if (n == -1) {
+        if (errno != EINTR) {
+          parent->m_logger.error("Error from poll: %s", strerror(errno));
+        }
+        continue;
+      }
+      if (pfds[1].revents != 0) {
+        return;
+      }
+      if (pfds[0].revents != 0) {
+        (parent->*handler)();
+      }
+    }
+  }
+
+private:
+  gtpu* parent;
+  int   fd;
+  void (gtpu::*handler)();
+};
+
+int spgw::gtpu::start_data_plane()
+{
+  if (m_dp_running) {
+    return SRSRAN_ERROR_ALREADY_STARTED;
+  }
+
+  // The TUN device is drained with non-blocking reads until it is empty or a burst is complete
+  int flags = fcntl(m_sgi, F_GETFL, 0);
+  if (flags == -1 or fcntl(m_sgi, F_SETFL, flags | O_NONBLOCK) == -1) {
+    m_logger.error("Failed to set SGi interface as non-blocking: %s", strerror(errno));
+    return SRSRAN_ERROR_CANT_START;
+  }
+
+  m_dp_stop_fd  = eventfd(0, EFD_CLOEXEC);
+  m_sgi_ctrl_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (m_dp_stop_fd == -1 or m_sgi_ctrl_fd == -1) {
+    m_logger.error("Failed to create eventfd: %s", strerror(errno));
+    return SRSRAN_ERROR_CANT_START;
+  }
+
+  m_dp_running = true;
+  m_dp_workers.emplace_back(new dp_worker(this, m_s1u, &gtpu::handle_s1u_burst, "SPGW_S1U"));
+  m_dp_workers.emplace_back(new dp_worker(this, m_sgi, &gtpu::handle_sgi_burst, "SPGW_SGI"));
+  for (auto& worker : m_dp_workers) {
+    worker->start();
+  }
+  m_logger.info("Started SPGW user-plane threads");
+  return SRSRAN_SUCCESS;
+}
+
+void spgw::gtpu::stop_data_plane()
+{
+  if (m_dp_running) {
+    m_dp_running = false;
+    uint64_t one = 1;
+    if (write(m_dp_stop_fd, &one, sizeof(one)) != sizeof(one)) {
+      m_logger.error("Failed to signal user-plane threads to stop");
+    }
+    for (auto& worker : m_dp_workers) {
+      worker->wait_thread_finish();
+    }
+    m_dp_workers.clear();
+  }
+  if (m_dp_stop_fd != -1) {
+    close(m_dp_stop_fd);
+    m_dp_stop_fd = -1;
+  }
+  if (m_sgi_ctrl_fd != -1) {
+    close(m_sgi_ctrl_fd);
+    m_sgi_ctrl_fd = -1;
+  }
+}
+
+void spgw::gtpu::handle_s1u_burst()
+{
+  uint32_t nof_bufs = 0;
+  for (; nof_bufs < max_burst; ++nof_bufs) {
+    srsran::unique_byte_buffer_t& buf = m_s1u_bufs[nof_bufs];
+    if (buf == nullptr) {
+      buf = srsran::make_byte_buffer("spgw::gtpu::handle_s1u_burst");
+      if (buf == nullptr) {
+        break;
+      }
+    }
+    buf->clear();
+    m_s1u_iovs[nof_bufs].iov_base           = buf->msg;
+    m_s1u_iovs[nof_bufs].iov_len            = buf->get_tailroom();
+    m_s1u_msgs[nof_bufs].msg_hdr            = {};
+    m_s1u_msgs[nof_bufs].msg_hdr.msg_iov    = &m_s1u_iovs[nof_bufs];
+    m_s1u_msgs[nof_bufs].msg_hdr.msg_iovlen = 1;
+  }
+  if (nof_bufs == 0) {
+    m_logger.error("Unable to allocate byte buffer for S1-U PDUs");
+    return;
+  }
+
+  int n = recvmmsg(m_s1u, m_s1u_msgs.data(), nof_bufs, MSG_DONTWAIT, nullptr);
+  if (n == -1) {
+    if (errno != EAGAIN) {
+      m_logger.error("Error reading from S1-U socket: %s", strerror(errno));
+    }
+    return;
+  }
+  m_logger.debug("Received %d PDUs from S1-U", n);
+
+  // The TUN device does not support batched writes, so each IP packet is written separately
+  for (int i = 0; i < n; ++i) {
+    m_s1u_bufs[i]->N_bytes = m_s1u_msgs[i].msg_len;
+    handle_s1u_pdu(m_s1u_bufs[i].get());
+  }
+}
+
+void spgw::gtpu::handle_sgi_burst()
+{
+  uint32_t nof_pdus = 0;
+  for (; nof_pdus < max_burst; ++nof_pdus) {
+    srsran::unique_byte_buffer_t& buf = m_sgi_bufs[nof_pdus];
+    if (buf == nullptr) {
+      /*
+       * SGi PDUs handed over to the control plane may be queued while waiting for the UE Paging procedure.
+       * Their buffers are replaced here, and deallocated at the gtpu::send_s1u_pdu() when the PDU is sent, at
+       * handle_sgi_pdu() when the PDU is dropped or at gtpc::free_all_queued_packets.
+       */
+      buf = srsran::make_byte_buffer("spgw::gtpu::handle_sgi_burst");
+      if (buf == nullptr) {
+        m_logger.error("Unable to allocate byte buffer for SGi PDUs");
+        break;
+      }
+    }
+    buf->clear();
+    ssize_t n = read(m_sgi, buf->msg, buf->get_tailroom());
+    if (n <= 0) {
+      if (n == -1 and errno != EAGAIN) {
+        m_logger.error("Error reading from SGi interface: %s", strerror(errno));
+      }
+      break;
+    }
+    buf->N_bytes = n;
+  }
+  if (nof_pdus == 0) {
+    return;
+  }
+
+  // Forward the PDUs of UEs with an active user-plane, and hand over the rest to the control plane
+  uint32_t nof_fwd  = 0;
+  uint32_t nof_ctrl = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_tunnel_mutex);
+    for (uint32_t i = 0; i < nof_pdus; ++i) {
+      srsran::unique_byte_buffer_t& msg = m_sgi_bufs[i];
+      struct iphdr*                 iph = (struct iphdr*)msg->msg;
+      const ue_tunnel_t*            tun = nullptr;
+      if (msg->N_bytes >= sizeof(struct iphdr) and iph->version == 4 and ntohs(iph->tot_len) >= 20) {
+        tun = m_ue_tunnels.find_value(iph->daddr);
+      }
+      if (tun == nullptr or not tun->usr_found or not tun->ctr_found) {
+        std::lock_guard<std::mutex> ctrl_lock(m_sgi_ctrl_mutex);
+        m_sgi_ctrl_pdus.push(std::move(msg));
+        nof_ctrl++;
+        continue;
+      }
+
+      // Setup GTP-U header
+      srsran::gtpu_header_t header;
+      header.flags        = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+      header.message_type = GTPU_MSG_DATA_PDU;
+      header.length       = msg->N_bytes;
+      header.teid         = tun->usr_fteid.teid;
+      if (!srsran::gtpu_write_header(&header, msg.get(), m_logger)) {
+        m_logger.error("Error writing GTP-U header on PDU");
+        continue;
+      }
+
+      // Set eNB destination address
+      sockaddr_in& enb_addr    = m_sgi_dst[nof_fwd];
+      enb_addr                 = {};
+      enb_addr.sin_family      = AF_INET;
+      enb_addr.sin_port        = htons(GTPU_RX_PORT);
+      enb_addr.sin_addr.s_addr = tun->usr_fteid.ipv4;
+
+      m_sgi_iovs[nof_fwd].iov_base            = msg->msg;
+      m_sgi_iovs[nof_fwd].iov_len             = msg->N_bytes;
+      m_sgi_msgs[nof_fwd].msg_hdr             = {};
+      m_sgi_msgs[nof_fwd].msg_hdr.msg_name    = &enb_addr;
+      m_sgi_msgs[nof_fwd].msg_hdr.msg_namelen = sizeof(enb_addr);
+      m_sgi_msgs[nof_fwd].msg_hdr.msg_iov     = &m_sgi_iovs[nof_fwd];
+      m_sgi_msgs[nof_fwd].msg_hdr.msg_iovlen  = 1;
+      nof_fwd++;
+    }
+  }
+
+  // Send packets to destination
+  for (uint32_t nof_sent = 0; nof_sent < nof_fwd;) {
+    int n = sendmmsg(m_s1u, &m_sgi_msgs[nof_sent], nof_fwd - nof_sent, 0);
+    if (n < 0) {
+      m_logger.error("Error sending packets to eNB: %s", strerror(errno));
+      break;
+    }
+    nof_sent += n;
+  }
+  m_logger.debug("Forwarded %d/%d SGi PDUs to S1-U", nof_fwd, nof_pdus);
+
+  // Wake up the control plane thread
+  if (nof_ctrl > 0) {
+    uint64_t one = 1;
+    if (write(m_sgi_ctrl_fd, &one, sizeof(one)) != sizeof(one)) {
+      m_logger.error("Failed to notify the SPGW control plane of pending SGi PDUs");
+    }
+  }
+}
+
+void spgw::gtpu::handle_sgi_ctrl_pdus()
+{
+  uint64_t count;
+  if (read(m_sgi_ctrl_fd, &count, sizeof(count)) != sizeof(count)) {
+    return;
+  }
+  std::queue<srsran::unique_byte_buffer_t> pdus;
+  {
+    std::lock_guard<std::mutex> lock(m_sgi_ctrl_mutex);
+    std::swap(pdus, m_sgi_ctrl_pdus);
+  }
+  while (not pdus.empty()) {
+    handle_sgi_pdu(std::move(pdus.front()));
+    pdus.pop();
+  }
+}
+
 void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
 {
   bool usr_found = false;
   bool ctr_found = false;
 
-  std::map<uint32_t, srsran::gtpc_f_teid_ie>::iterator gtpu_fteid_it;
-  std::map<in_addr_t, uint32_t>::iterator              gtpc_teid_it;
-  srsran::gtpc_f_teid_ie                               enb_fteid;
-  uint32_t                                             spgw_teid;
-  struct iphdr*                                        iph = (struct iphdr*)msg->msg;
+  srsran::gtpc_f_teid_ie enb_fteid;
+  uint32_t               spgw_teid;
+  struct iphdr*          iph = (struct iphdr*)msg->msg;
   m_logger.debug("Received SGi PDU. Bytes %d", msg->N_bytes);
 
   if (iph->version != 4) {
@@ -234,15 +491,15 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
 
   // Find user and control tunnel
-  gtpu_fteid_it = m_ip_to_usr_teid.find(iph->daddr);
-  if (gtpu_fteid_it != m_ip_to_usr_teid.end()) {
-    usr_found = true;
-    enb_fteid = gtpu_fteid_it->second;
-  }
-  gtpc_teid_it = m_ip_to_ctr_teid.find(iph->daddr);
-  if (gtpc_teid_it != m_ip_to_ctr_teid.end()) {
-    ctr_found = true;
-    spgw_teid = gtpc_teid_it->second;
+  {
+    std::lock_guard<std::mutex> lock(m_tunnel_mutex);
+    const ue_tunnel_t*          tun = m_ue_tunnels.find_value(iph->daddr);
+    if (tun != nullptr) {
+      usr_found = tun->usr_found;
+      enb_fteid = tun->usr_fteid;
+      ctr_found = tun->ctr_found;
+      spgw_teid = tun->ctr_teid;
+    }
   }
 
   // Handle SGi packet
@@ -264,7 +521,10 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
 void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
 {
   srsran::gtpu_header_t header;
-  srsran::gtpu_read_header(msg, &header, m_logger);
+  if (not srsran::gtpu_read_header(msg, &header, m_logger) or header.message_type != GTPU_MSG_DATA_PDU) {
+    m_logger.warning("Discarding S1-U PDU that is not a G-PDU. Bytes=%d", msg->N_bytes);
+    return;
+  }
 
   m_logger.debug("Received PDU from S1-U. Bytes=%d", msg->N_bytes);
   m_logger.debug("TEID 0x%x. Bytes=%d", header.teid, msg->N_bytes);
@@ -340,32 +600,44 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
   srsran::gtpu_ntoa(buffer, dw_user_fteid.ipv4);
   m_logger.info("Downlink eNB addr %s, U-TEID 0x%x", srsran::to_c_str(buffer), dw_user_fteid.teid);
   m_logger.info("Uplink C-TEID: 0x%x", up_ctrl_teid);
-  m_ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
-  m_ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
+  std::lock_guard<std::mutex> lock(m_tunnel_mutex);
+  ue_tunnel_t&                tun = m_ue_tunnels[ue_ipv4];
+  tun.usr_found                   = true;
+  tun.usr_fteid                   = dw_user_fteid;
+  tun.ctr_found                   = true;
+  tun.ctr_teid                    = up_ctrl_teid;
   return true;
 }
 
 bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 {
   // Remove GTP-U connections, if any.
-  if (m_ip_to_usr_teid.count(ue_ipv4)) {
-    m_ip_to_usr_teid.erase(ue_ipv4);
-  } else {
+  std::lock_guard<std::mutex> lock(m_tunnel_mutex);
+  ue_tunnel_t*                tun = m_ue_tunnels.find_value(ue_ipv4);
+  if (tun == nullptr or not tun->usr_found) {
     m_logger.error("Could not find GTP-U Tunnel to delete.");
     return false;
   }
+  tun->usr_found = false;
+  if (not tun->ctr_found) {
+    m_ue_tunnels.erase(ue_ipv4);
+  }
   return true;
 }
 
 bool spgw::gtpu::delete_gtpc_tunnel(in_addr_t ue_ipv4)
 {
   // Remove Ctrl TEID from IP mapping.
-  if (m_ip_to_ctr_teid.count(ue_ipv4)) {
-    m_ip_to_ctr_teid.erase(ue_ipv4);
-  } else {
+  std::lock_guard<std::mutex> lock(m_tunnel_mutex);
+  ue_tunnel_t*                tun = m_ue_tunnels.find_value(ue_ipv4);
+  if (tun == nullptr or not tun->ctr_found) {
     m_logger.error("Could not find GTP-C Tunnel info to delete.");
     return false;
   }
+  tun->ctr_found = false;
+  if (not tun->usr_found) {
+    m_ue_tunnels.erase(ue_ipv4);
+  }
   return true;
 }
 
@@ -0,0 +1,220 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Loopback packet-rate benchmark of the SPGW user-plane. A SOCK_DGRAM socketpair stands in for the SGi TUN device,
+ * and an UDP socket bound to 127.0.0.2 plays the eNB.
+ */
+
+#include "srsepc/hdr/spgw/gtpu.h"
+#include "srsran/common/test_common.h"
+#include "srsran/upper/gtpu.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <getopt.h>
+#include <linux/ip.h>
+#include <thread>
+
+using namespace srsepc;
+
+static uint32_t pdu_len  = 1400;
+static uint32_t nof_pdus = 100000;
+static uint32_t nof_ues  = 16;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [snu]\n", prog);
+  printf("\t-s IP packet size in bytes [Default %d]\n", pdu_len);
+  printf("\t-n number of packets per direction [Default %d]\n", nof_pdus);
+  printf("\t-u number of UEs [Default %d]\n", nof_ues);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "s:n:u:")) != -1) {
+    switch (opt) {
+      case 's':
+        pdu_len = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        nof_pdus = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'u':
+        nof_ues = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+class dummy_gtpc : public gtpc_interface_gtpu
+{
+public:
+  bool queue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg) override { return false; }
+  bool send_downlink_data_notification(uint32_t spgw_ctr_teid) override { return false; }
+};
+
+in_addr_t ue_ipv4(uint32_t ue_idx)
+{
+  return htonl(0xac100002 + ue_idx); // 172.16.0.2 onwards
+}
+
+/// Receives datagrams until nof_pdus are received or no datagram arrives for a while. Returns the number received
+uint32_t recv_all(int fd)
+{
+  timeval tv = {0, 200000};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+  std::vector<uint8_t>    bufs(32 * 2048);
+  std::array<mmsghdr, 32> msgs;
+  std::array<iovec, 32>   iovs;
+  uint32_t                count = 0;
+  while (count < nof_pdus) {
+    for (uint32_t i = 0; i < msgs.size(); ++i) {
+      iovs[i]                    = {&bufs[i * 2048], 2048};
+      msgs[i].msg_hdr            = {};
+      msgs[i].msg_hdr.msg_iov    = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int n = recvmmsg(fd, msgs.data(), msgs.size(), MSG_WAITFORONE, nullptr);
+    if (n <= 0) {
+      break;
+    }
+    count += n;
+  }
+  return count;
+}
+
+void print_rate(const char* name, uint32_t nof_rx, std::chrono::high_resolution_clock::time_point t_start)
+{
+  auto   t_end   = std::chrono::high_resolution_clock::now();
+  double elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start).count();
+  printf("%-4s %u/%u packets, %7.3f Mpps, %9.1f Mbps\n",
+         name,
+         nof_rx,
+         nof_pdus,
+         nof_rx * 1000.0 / elapsed,
+         (double)nof_rx * pdu_len * 8 * 1000.0 / elapsed);
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::fetch_basic_logger("GTPU", false).set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  // SGi side
+  int sgi_pair[2];
+  TESTASSERT(socketpair(AF_UNIX, SOCK_DGRAM, 0, sgi_pair) == 0);
+
+  // eNB side
+  int         enb_fd   = socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in enb_addr = {};
+  enb_addr.sin_family  = AF_INET;
+  enb_addr.sin_port    = htons(GTPU_RX_PORT);
+  TESTASSERT(inet_pton(AF_INET, "127.0.0.2", &enb_addr.sin_addr) == 1);
+  TESTASSERT(enb_fd >= 0 and bind(enb_fd, (sockaddr*)&enb_addr, sizeof(enb_addr)) == 0);
+
+  dummy_gtpc  gtpc;
+  spgw::gtpu  gtpu;
+  spgw_args_t args    = {};
+  args.gtpu_bind_addr = "127.0.0.1";
+  gtpu.m_gtpc         = &gtpc;
+  gtpu.m_sgi          = sgi_pair[0];
+  TESTASSERT(gtpu.init_s1u(&args) == SRSRAN_SUCCESS);
+  TESTASSERT(gtpu.start_data_plane() == SRSRAN_SUCCESS);
+
+  for (uint32_t ue = 0; ue < nof_ues; ++ue) {
+    srsran::gtp_fteid_t fteid = {};
+    fteid.ipv4                = enb_addr.sin_addr.s_addr;
+    fteid.teid                = 0x100 + ue;
+    TESTASSERT(gtpu.modify_gtpu_tunnel(ue_ipv4(ue), fteid, 0x200 + ue));
+  }
+
+  // IP packet template
+  std::vector<uint8_t> ip_pkt(pdu_len);
+  struct iphdr*        iph = (struct iphdr*)ip_pkt.data();
+  iph->version             = 4;
+  iph->ihl                 = 5;
+  iph->tot_len             = htons(pdu_len);
+  iph->saddr               = htonl(0x08080808);
+
+  // Downlink: SGi -> S1-U
+  auto        t_start = std::chrono::high_resolution_clock::now();
+  std::thread sgi_tx([&]() {
+    for (uint32_t i = 0; i < nof_pdus; ++i) {
+      iph->daddr = ue_ipv4(i % nof_ues);
+      if (write(sgi_pair[1], ip_pkt.data(), ip_pkt.size()) < 0) {
+        break;
+      }
+    }
+  });
+  uint32_t nof_dl = recv_all(enb_fd);
+  sgi_tx.join();
+  print_rate("DL", nof_dl, t_start);
+
+  // Uplink: S1-U -> SGi
+  srsran::unique_byte_buffer_t gtpu_pdu = srsran::make_byte_buffer();
+  TESTASSERT(gtpu_pdu != nullptr);
+  memcpy(gtpu_pdu->msg, ip_pkt.data(), ip_pkt.size());
+  gtpu_pdu->N_bytes            = ip_pkt.size();
+  srsran::gtpu_header_t header = {};
+  header.flags                 = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+  header.message_type          = GTPU_MSG_DATA_PDU;
+  header.length                = gtpu_pdu->N_bytes;
+  header.teid                  = 0x200;
+  TESTASSERT(srsran::gtpu_write_header(&header, gtpu_pdu.get(), srslog::fetch_basic_logger("GTPU")));
+
+  t_start = std::chrono::high_resolution_clock::now();
+  std::thread s1u_tx([&]() {
+    std::array<mmsghdr, 32> msgs = {};
+    iovec                   iov  = {gtpu_pdu->msg, gtpu_pdu->N_bytes};
+    for (mmsghdr& msg : msgs) {
+      msg.msg_hdr.msg_name    = &gtpu.m_s1u_addr;
+      msg.msg_hdr.msg_namelen = sizeof(gtpu.m_s1u_addr);
+      msg.msg_hdr.msg_iov     = &iov;
+      msg.msg_hdr.msg_iovlen  = 1;
+    }
+    for (uint32_t nof_sent = 0; nof_sent < nof_pdus;) {
+      int n = sendmmsg(enb_fd, msgs.data(), std::min<uint32_t>(msgs.size(), nof_pdus - nof_sent), 0);
+      if (n < 0) {
+        break;
+      }
+      nof_sent += n;
+    }
+  });
+  uint32_t nof_ul = recv_all(sgi_pair[1]);
+  s1u_tx.join();
+  print_rate("UL", nof_ul, t_start);
+
+  gtpu.stop();
+  close(sgi_pair[0]);
+  close(sgi_pair[1]);
+  close(enb_fd);
+
+  // Packets may be dropped by the loopback sockets under load, but most of them must make it through
+  TESTASSERT(nof_dl > 0 and nof_ul > 0);
+
+  return SRSRAN_SUCCESS;
+}
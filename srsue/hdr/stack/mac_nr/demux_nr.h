@@ -23,7 +23,7 @@
 #define SRSRAN_DEMUX_NR_H
 
 #include "mac_nr_interfaces.h"
-#include "srsran/common/block_queue.h"
+#include "srsran/common/lockfree_queue.h"
 #include "srsran/interfaces/ue_nr_interfaces.h"
 #include "srsran/interfaces/ue_rlc_interfaces.h"
 
@@ -72,9 +72,10 @@ private:
 
   bool is_uecrid_successful = false;
 
-  ///< currently only DCH & BCH PDUs supported (add PCH, etc)
-  srsran::block_queue<srsran::unique_byte_buffer_t> pdu_queue;
-  srsran::block_queue<srsran::unique_byte_buffer_t> bcch_queue;
+  ///< currently only DCH & BCH PDUs supported (add PCH, etc). Pushed by the PHY workers, popped by the stack
+  static const uint32_t                                                       pdu_queue_capacity = 1024;
+  srsran::blocking_queue<srsran::mpsc_queue<srsran::unique_byte_buffer_t> > pdu_queue;
+  srsran::blocking_queue<srsran::mpsc_queue<srsran::unique_byte_buffer_t> > bcch_queue;
 
   srsran::mac_sch_pdu_nr rx_pdu;
   srsran::mac_sch_pdu_nr rx_pdu_tcrnti;
@@ -20,6 +20,7 @@
  */
 
 #include "srsue/hdr/metrics_json.h"
+#include "srsran/common/byte_buffer.h"
 #include "srsran/srslog/context.h"
 
 using namespace srsue;
@@ -121,6 +122,23 @@ DECLARE_METRIC_SET("sys_cpu_container",
                    metric_thread_count,
                    mlist_cpu_core_list);
 
+/// Byte buffer pool container.
+DECLARE_METRIC("size_class", metric_pool_size_class, std::string, "");
+DECLARE_METRIC("payload_size", metric_pool_payload_size, uint32_t, "");
+DECLARE_METRIC("block_size", metric_pool_block_size, uint32_t, "");
+DECLARE_METRIC("nof_used", metric_pool_nof_used, uint32_t, "");
+DECLARE_METRIC("max_used", metric_pool_max_used, uint32_t, "");
+DECLARE_METRIC("alloc_failures", metric_pool_alloc_failures, uint32_t, "");
+DECLARE_METRIC_SET("buffer_pool_container",
+                   mset_buffer_pool_container,
+                   metric_pool_size_class,
+                   metric_pool_payload_size,
+                   metric_pool_block_size,
+                   metric_pool_nof_used,
+                   metric_pool_max_used,
+                   metric_pool_alloc_failures);
+DECLARE_METRIC_LIST("buffer_pool_list", mlist_buffer_pool, std::vector<mset_buffer_pool_container>);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
@@ -135,7 +153,8 @@ using metric_context_t = srslog::build_context_type<metric_type_tag,
                                                     mset_nas_container,
                                                     mset_rf_container,
                                                     mset_sys_mem_container,
-                                                    mset_sys_cpu_container>;
+                                                    mset_sys_cpu_container,
+                                                    mlist_buffer_pool>;
 
 } // namespace
 
@@ -238,6 +257,19 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
     core_list[i].write<metric_proc_core_usage>(metrics.sys.cpu_load[i]);
   }
 
+  // Fill byte buffer pool list.
+  auto& pool_list = ctx.get<mlist_buffer_pool>();
+  pool_list.resize(srsran::nof_byte_buffer_size_classes);
+  for (uint32_t i = 0, e = pool_list.size(); i != e; ++i) {
+    const srsran::byte_buffer_pool_class_metrics_t& pool = metrics.sys.buffer_pool[i];
+    pool_list[i].write<metric_pool_size_class>(srsran::to_string(static_cast<srsran::byte_buffer_size_class>(i)));
+    pool_list[i].write<metric_pool_payload_size>(pool.payload_size);
+    pool_list[i].write<metric_pool_block_size>(pool.block_size);
+    pool_list[i].write<metric_pool_nof_used>(pool.nof_used);
+    pool_list[i].write<metric_pool_max_used>(pool.max_used);
+    pool_list[i].write<metric_pool_alloc_failures>(pool.nof_alloc_failures);
+  }
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
@@ -109,6 +109,9 @@ cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_
     ue_dl.pdsch.llr_is_8bit        = true;
     ue_dl.pdsch.dl_sch.llr_is_8bit = true;
   }
+  if (srsran_pdsch_set_cb_threads(&ue_dl.pdsch, phy->args->pdsch_cb_threads)) {
+    Error("Error creating PDSCH code block decoder threads");
+  }
 }
 
 cc_worker::~cc_worker()
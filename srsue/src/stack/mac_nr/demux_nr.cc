@@ -26,7 +26,9 @@
 
 namespace srsue {
 
-demux_nr::demux_nr(srslog::basic_logger& logger_) : logger(logger_) {}
+demux_nr::demux_nr(srslog::basic_logger& logger_) :
+  logger(logger_), pdu_queue(pdu_queue_capacity), bcch_queue(pdu_queue_capacity)
+{}
 
 demux_nr::~demux_nr() {}
 
@@ -72,14 +74,13 @@ void demux_nr::push_pdu_temp_crnti(srsran::unique_byte_buffer_t pdu, uint32_t tt
 void demux_nr::process_pdus()
 {
   // Handle first BCCH
-  while (not bcch_queue.empty()) {
-    srsran::unique_byte_buffer_t pdu = bcch_queue.wait_pop();
+  srsran::unique_byte_buffer_t pdu;
+  while (bcch_queue.try_pop(pdu)) {
     logger.debug(pdu->msg, pdu->N_bytes, "Handling MAC BCCH PDU (%d B)", pdu->N_bytes);
     rlc->write_pdu_bcch_dlsch(pdu->msg, pdu->N_bytes);
   }
   // Then user PDUs
-  while (not pdu_queue.empty()) {
-    srsran::unique_byte_buffer_t pdu = pdu_queue.wait_pop();
+  while (pdu_queue.try_pop(pdu)) {
     handle_pdu(rx_pdu, std::move(pdu));
   }
 }
@@ -38,9 +38,9 @@ static_assert(alignof(LIBLTE_BYTE_MSG_STRUCT) == alignof(byte_buffer_t),
               "liblte buffer and byte buffer members misaligned");
 static_assert(offsetof(LIBLTE_BYTE_MSG_STRUCT, N_bytes) == offsetof(byte_buffer_t, N_bytes),
               "liblte buffer and byte buffer members misaligned");
-static_assert(offsetof(LIBLTE_BYTE_MSG_STRUCT, header) == offsetof(byte_buffer_t, buffer),
+static_assert(offsetof(LIBLTE_BYTE_MSG_STRUCT, msg) == sizeof(byte_buffer_t) + byte_buffer_t::headroom,
               "liblte buffer and byte buffer members misaligned");
-static_assert(sizeof(LIBLTE_BYTE_MSG_STRUCT) <= offsetof(byte_buffer_t, msg),
+static_assert(sizeof(LIBLTE_BYTE_MSG_STRUCT) <= byte_buffer_block_size(byte_buffer_size_class::large),
               "liblte buffer and byte buffer members misaligned");
 
 int mme_attach_request_test()
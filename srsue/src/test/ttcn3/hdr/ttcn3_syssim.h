@@ -179,6 +179,8 @@ public:
 
   bool sdu_queue_is_full(uint32_t lcid);
 
+  uint32_t sdu_queue_free_space(uint32_t lcid);
+
   bool is_suspended(uint32_t lcid);
 
   void set_as_security(const ttcn3_helpers::timing_info_t        timing,
@@ -21,6 +21,7 @@
 
 #include "srsue/hdr/ue.h"
 #include "srsran/build_info.h"
+#include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/radio/radio.h"
@@ -391,6 +392,7 @@ bool ue::get_metrics(ue_metrics_t* m)
   stack->get_metrics(&m->stack);
   gw_inst->get_metrics(m->gw, m->stack.mac[0].nof_tti);
   m->sys = sys_proc.get_metrics();
+  srsran::get_byte_buffer_pool_metrics(m->sys);
   return true;
 }
 